@@ -102,12 +102,14 @@ typedef struct EbSvtAv1DecConfiguration {
 
     // Application Specific parameters
 
-    /* Number of threads used by decoder.
+    /* Number of threads used by decoder. Forced to 1 when num_p_frames
+     * is greater than 1.
      * Default is 1. */
     uint32_t threads;
 
     /* Number of frames that can be processed
-       in parallel. Default is 1 */
+       in parallel, up to 4. Each frame is decoded on its own thread
+       and waits on the rows of its reference frames. Default is 1 */
     uint32_t num_p_frames;
 
     // Application Specific parameters
@@ -218,11 +220,31 @@ EB_API EbErrorType eb_svt_decode_tu(EbComponentType *svt_dec_component, const ui
      *
      *  Returns EB_ErrorNone if the picture has been returned successfully.
      *  Returns EB_DecNoOutputPicture if the next output picture has not
-     *  been generated yet. Calling a decoding function is needed to generate more pictures. */
+     *  been generated yet. Calling a decoding function is needed to generate more pictures.
+     *  When frames are decoded in parallel, the output lags up to num_p_frames - 1
+     *  pictures behind the decoding calls, and waits for the oldest picture once
+     *  num_p_frames pictures are pending. Call eb_dec_flush() at the end of the stream
+     *  to get the remaining pictures.
+     *
+     *  When frame buffer callbacks are set, the picture is not copied: the planes of the
+     *  EbSvtIOFormat in p_buffer are pointed at the decoder's own frame buffer, which
+     *  stays valid until eb_svt_dec_release_picture() is called on p_buffer. */
 EB_API EbErrorType eb_svt_dec_get_picture(EbComponentType *   svt_dec_component,
                                           EbBufferHeaderType *p_buffer,
                                           EbAV1StreamInfo *stream_info, EbAV1FrameInfo *frame_info);
 
+/* Release a picture returned by eb_svt_dec_get_picture() when frame buffer
+     * callbacks are set. Every such picture must be released, at most 4 of
+     * them can be held at the same time: eb_svt_dec_get_picture() returns
+     * EB_ErrorInsufficientResources while 4 are held. May be called from any
+     * thread. Does nothing for copied pictures.
+     *
+     * Parameter:
+     * @ *svt_dec_component     Decoder handle.
+     * @ *p_buffer              Header the picture was returned in. */
+EB_API EbErrorType eb_svt_dec_release_picture(EbComponentType *   svt_dec_component,
+                                              EbBufferHeaderType *p_buffer);
+
 /* STEP 7: Deinitialize decoder library.
      *
      * Parameter:
@@ -237,7 +259,8 @@ EB_API EbErrorType eb_dec_deinit_handle(EbComponentType *svt_dec_component);
 
 /*  Flush a decoder
      *
-     *  Clears the decoder frame buffers.
+     *  Waits for the frames being decoded in parallel. Their pictures stay
+     *  pending for output and are returned by eb_svt_dec_get_picture().
      *  The decoder is ready to parse a new sequence header.
      *
      *  Parameter:
@@ -248,6 +271,12 @@ EB_API EbErrorType eb_dec_deinit_handle(EbComponentType *svt_dec_component);
 EB_API EbErrorType eb_dec_flush(EbComponentType *svt_dec_component);
 
 /* Initialize callback functions.
+     *
+     * The reconstructed and reference frames of the decoder are then allocated
+     * with allocate_buffer, one buffer per frame, and handed back to release_buffer
+     * in eb_deinit_decoder(). Output pictures reference these buffers directly.
+     * Must be called before the first frame is decoded, with both callbacks
+     * set or both NULL. allocate_buffer returns a negative value on failure.
      *
      * Parameter:
      * @ *svt_dec_component     Decoder handle
@@ -260,6 +289,28 @@ EB_API EbErrorType eb_dec_set_frame_buffer_callbacks(EbComponentType *     svt_d
                                                      EbReleaseFrameBuffer  release_buffer,
                                                      void *                priv_data);
 
+/* Picture pool usage of the decoder */
+typedef struct EbDecPicPoolStats {
+    /* Pictures holding frame buffers, now and at most */
+    uint32_t num_pics;
+    uint32_t max_num_pics;
+    /* Bytes held by these pictures, now and at most */
+    uint64_t pool_bytes;
+    uint64_t max_pool_bytes;
+} EbDecPicPoolStats;
+
+/* Returns the picture pool usage and its high-water marks.
+     *
+     * Buffers are sized for the frames being decoded. Free buffers of a
+     * resolution no longer decoded are reclaimed, so after a resolution
+     * change pool_bytes follows the new size.
+     *
+     * Parameter:
+     * @ *svt_dec_component     Decoder handle.
+     * @ *stats                 Pool usage */
+EB_API EbErrorType eb_dec_get_pic_pool_stats(EbComponentType *  svt_dec_component,
+                                             EbDecPicPoolStats *stats);
+
 /* Returns information about the bitstream and
      * the last decoded frame.
      *
@@ -30,6 +30,10 @@ extern "C" {
 #define EB_BUFFERFLAG_ERROR_MASK \
     0xFFFFFFF0 // mask for signalling error assuming top flags fit in 4 bits. To be changed, if more flags are added.
 
+/* Returns a zero-copy input picture to the application, see zero_copy_input.
+ * Called from an encoder thread, it must not call back into the encoder. */
+typedef void (*EbInputReleaseCallback)(void *release_data, void *p_app_private);
+
 // Will contain the EbEncApi which will live in the EncHandle class
 // Only modifiable during config-time.
 typedef struct EbSvtAv1EncConfiguration {
@@ -514,6 +518,118 @@ typedef struct EbSvtAv1EncConfiguration {
      * Default is -1. */
     int32_t target_socket;
 
+    /* Run the multi-threaded encoder stages as jobs on one pool of
+     * logical_processors worker threads, instead of giving each stage its
+     * own set of threads. The pool uses the lock-free pipeline queues.
+     *
+     * 0 = OFF, one thread array per stage.
+     * 1 = ON.
+     *
+     * Default is 0. */
+    uint32_t thread_pool;
+
+    /* Spread the encoder over the NUMA nodes of the system: the threads of
+     * each stage are bound to the nodes in equal shares, the picture and
+     * reference pools are placed round robin on the nodes, and EncDec tasks
+     * go to a thread of the node holding their picture when one is idle.
+     * Linux only, ignored on single node systems. Not supported with
+     * thread_pool or target_socket.
+     *
+     * 0 = OFF, placement left to the OS.
+     * 1 = ON.
+     *
+     * Default is 0. */
+    uint32_t numa_mode;
+
+    /* Allocate the picture buffers of the encoder pools (input, reference and
+     * picture control set pictures) on 2MB huge pages, to cut the TLB misses
+     * of motion estimation and compensation. Explicit huge pages are used
+     * when the system has some reserved, transparent huge pages otherwise,
+     * and regular pages when neither can be mapped. The bytes backed by huge
+     * pages are reported when the encoder is deinitialized. Linux only.
+     *
+     * 0 = OFF.
+     * 1 = ON.
+     *
+     * Default is 0. */
+    uint32_t huge_pages;
+
+    /* Collect per-stage pipeline statistics, read back with
+     * eb_svt_enc_get_stats().
+     *
+     * 0 = OFF.
+     * 1 = Counters: tasks, busy, blocked and idle time, queue depth.
+     * 2 = Counters and one trace event per task, written out with
+     *     eb_svt_enc_dump_trace().
+     *
+     * Default is 0. */
+    uint32_t pipeline_stats;
+
+    /* Encode the input pictures in place instead of copying them. The planes
+     * passed to eb_svt_enc_send_picture() must have the padding and strides
+     * given by eb_svt_enc_get_input_layout(), and are owned by the encoder
+     * until input_release_callback returns them. The encoder only writes
+     * their padding: the pictures it temporally filters or denoises are
+     * first copied to buffers of its own. 8-bit input only.
+     *
+     * 0 = OFF, the pictures are copied.
+     * 1 = ON.
+     *
+     * Default is 0. */
+    uint32_t zero_copy_input;
+    /* Called with input_release_data and the p_app_private of the buffer
+     * header once the encoder no longer reads a zero-copy input picture.
+     * Required when zero_copy_input is on. */
+    EbInputReleaseCallback input_release_callback;
+    void *                 input_release_data;
+
+    /* Memory budget in MB of the parent and child picture control set,
+     * reference and PA reference picture pools. With a budget, the pools start
+     * with the fewest pictures the pipeline needs, grow when a stage finds all
+     * of them in use and the budget allows one more, and free the pictures
+     * left idle. They never grow past the sizes used without a budget. The
+     * starting pools are always allocated, even past the budget.
+     *
+     * 0 = No budget, the pools are fully allocated at init.
+     *
+     * Default is 0. */
+    uint32_t pool_memory_budget;
+
+    /* Real-time mode. Each picture goes through the pipeline as soon as it is
+     * sent: no mini-GOP reordering (low delay P), no look ahead, altref, overlay
+     * or scene change detection, and the pools and FIFOs are sized for two
+     * pictures in flight. The end of sequence packet is returned once the
+     * packets of all the pictures sent are out. Not supported with rate control
+     * modes 2 and 3.
+     *
+     * 0 = OFF.
+     * 1 = ON.
+     *
+     * Default is 0. */
+    uint32_t low_latency;
+    /* Time in ms eb_svt_get_packet() waits for a packet before returning
+     * EB_NoErrorEmptyQueue, when the end of sequence has not been sent yet.
+     * Only applies when low_latency is 1, it is ignored otherwise.
+     *
+     * 0 = No wait.
+     *
+     * Default is 0. */
+    uint32_t latency_budget;
+    /* Inter-frame wavefront. A picture is sent to mode decision as soon as the
+     * loop filter, CDEF and restoration decisions of its references are made,
+     * while the Rest threads finish filtering and padding them. The overlap
+     * needs frame_end_cdf_update off: with it on, a picture still waits for the
+     * entropy coding of its references and the mode changes nothing. With it
+     * off, each SB row waits once for the reference rows it may read, and the
+     * motion of its blocks stays within 256 luma rows below it, so the
+     * bitstream may differ from the mode off. Not supported with thread_pool.
+     *
+     * 0 = OFF.
+     * 1 = ON.
+     *
+     * Default is 0. */
+    uint32_t inter_frame_wavefront;
+
     // Debug tools
 
     /* Output reconstructed yuv used for debug purposes. The value is set through
@@ -526,6 +642,13 @@ typedef struct EbSvtAv1EncConfiguration {
         * Default is 0. */
     int32_t tile_columns;
     int32_t tile_rows;
+    /* Mode decide and encode the tiles of a picture as independent work units
+     * spread over the EncDec threads, instead of one wavefront over the whole
+     * picture. Only takes effect with more than one tile. The output does not
+     * change, as each tile always has its own neighbor arrays.
+     *
+     * Default is 0. */
+    uint32_t tile_parallel;
 
     /* To be deprecated.
  * Encoder configuration parameters below this line are to be deprecated. */
@@ -581,6 +704,54 @@ typedef struct EbSvtAv1EncConfiguration {
 
 } EbSvtAv1EncConfiguration;
 
+#define EB_MAX_PIPELINE_STAGES 16
+
+/* Statistics of one encoder pipeline stage, a stage being a kernel and the
+ * queue feeding it. Times are in nanoseconds, summed over the threads of the
+ * stage. */
+typedef struct EbSvtStageStats {
+    const char *name;
+    // Threads running the stage, 0 when it runs on the thread pool
+    uint32_t thread_count;
+    // Inputs processed
+    uint64_t task_count;
+    // Time spent processing inputs
+    uint64_t busy_ns;
+    // Part of busy_ns spent waiting for an empty output object
+    uint64_t blocked_ns;
+    // Time spent waiting for an input
+    uint64_t idle_ns;
+    // Most inputs queued at once
+    uint32_t max_queue_depth;
+} EbSvtStageStats;
+
+typedef struct EbSvtEncStats {
+    // Time since eb_init_encoder()
+    uint64_t elapsed_ns;
+    uint32_t stage_count;
+    EbSvtStageStats stage[EB_MAX_PIPELINE_STAGES];
+    // Time the thread pool workers spent waiting for a job
+    uint64_t pool_idle_ns;
+    // Trace events recorded, and the ones lost to a full trace buffer
+    uint64_t trace_event_count;
+    uint64_t trace_dropped_count;
+} EbSvtEncStats;
+
+/* Layout of the input pictures the encoder works on, in samples. A zero-copy
+ * input plane must be preceded and followed by its padding, the chroma
+ * paddings being the luma ones subsampled. */
+typedef struct EbSvtInputLayout {
+    uint32_t left_padding;
+    uint32_t right_padding;
+    uint32_t top_padding;
+    uint32_t bottom_padding;
+    uint32_t y_stride;
+    uint32_t cb_stride;
+    uint32_t cr_stride;
+    // Alignment of the padded planes, in bytes
+    uint32_t alignment;
+} EbSvtInputLayout;
+
 /* STEP 1: Call the library to construct a Component Handle.
      *
      * Parameter:
@@ -632,6 +803,15 @@ EB_API EbErrorType eb_svt_release_enc_stream_header(EbBufferHeaderType *stream_h
 EB_API EbErrorType eb_svt_enc_eos_nal(EbComponentType *    svt_enc_component,
                                       EbBufferHeaderType **output_stream_ptr);
 
+/* OPTIONAL: Get the layout the zero-copy input pictures must have, once the
+     * parameters are set with eb_svt_enc_set_parameter().
+     *
+     * Parameter:
+     * @ *svt_enc_component  Encoder handler.
+     * @ *layout             Paddings, strides and alignment of the planes. */
+EB_API EbErrorType eb_svt_enc_get_input_layout(EbComponentType * svt_enc_component,
+                                               EbSvtInputLayout *layout);
+
 /* STEP 4: Send the picture.
      *
      * Parameter:
@@ -655,6 +835,24 @@ EB_API EbErrorType eb_svt_get_packet(EbComponentType *    svt_enc_component,
      * @ **p_buffer          Header pointer that contains the output packet to be released. */
 EB_API void eb_svt_release_out_buffer(EbBufferHeaderType **p_buffer);
 
+/* OPTIONAL: Give the encoder a buffer to write one output packet into, e.g.
+     * a slot of a muxer ring, instead of one of its own buffers. The buffers
+     * are used in the order they are registered, one per packet, and p_buffer
+     * of that packet points into it. The buffer must stay valid until the
+     * packet is released, after which the encoder no longer touches it. A
+     * packet larger than size is reported as an encode error, as it is with
+     * the encoder's own buffers. Can be called at any time after
+     * eb_init_encoder(), from any thread.
+     *
+     * Parameter:
+     * @ *svt_enc_component  Encoder handler.
+     * @ *buffer             Packet buffer.
+     * @ size                Bytes available in buffer.
+     * Returns EB_ErrorInsufficientResources when as many buffers as the
+     * encoder has packets are waiting already. */
+EB_API EbErrorType eb_svt_enc_register_out_buffer(EbComponentType *svt_enc_component,
+                                                  uint8_t *buffer, uint32_t size);
+
 /* OPTIONAL: Fill buffer with reconstructed picture.
      *
      * Parameter:
@@ -663,6 +861,24 @@ EB_API void eb_svt_release_out_buffer(EbBufferHeaderType **p_buffer);
 EB_API EbErrorType eb_svt_get_recon(EbComponentType *   svt_enc_component,
                                     EbBufferHeaderType *p_buffer);
 
+/* OPTIONAL: Read the pipeline statistics, pipeline_stats must be on.
+     *
+     * Parameter:
+     * @ *svt_enc_component  Encoder handler.
+     * @ *stats              Statistics accumulated since eb_init_encoder(). */
+EB_API EbErrorType eb_svt_enc_get_stats(EbComponentType *svt_enc_component,
+                                        EbSvtEncStats *  stats);
+
+/* OPTIONAL: Write the trace events as Chrome trace JSON (chrome://tracing),
+     * pipeline_stats must be 2. Call once the encoder has returned the last
+     * packet.
+     *
+     * Parameter:
+     * @ *svt_enc_component  Encoder handler.
+     * @ *file_name          Output file. */
+EB_API EbErrorType eb_svt_enc_dump_trace(EbComponentType *svt_enc_component,
+                                         const char *     file_name);
+
 /* STEP 6: Deinitialize encoder library.
      *
      * Parameter:
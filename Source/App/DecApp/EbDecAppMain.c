@@ -219,14 +219,16 @@ int32_t main(int32_t argc, char *argv[]) {
 
                     return_error |=
                         eb_svt_decode_frame(p_handle, buf, bytes_in_buffer, obu_ctx.is_annexb);
+                    /* Waits for the picture when frames are decoded in parallel */
+                    EbErrorType out_error =
+                        eb_svt_dec_get_picture(p_handle, recon_buffer, stream_info, frame_info);
 
                     dec_timer_mark(&timer);
                     dx_time += dec_timer_elapsed(&timer);
 
                     in_frame++;
 
-                    if (eb_svt_dec_get_picture(p_handle, recon_buffer, stream_info, frame_info) !=
-                        EB_DecNoOutputPicture) {
+                    if (out_error != EB_DecNoOutputPicture) {
                         if (fps_frm) show_progress(in_frame, dx_time);
 
                         if (enable_md5) write_md5(recon_buffer, &md5_ctx);
@@ -235,6 +237,13 @@ int32_t main(int32_t argc, char *argv[]) {
                 } else
                     break;
             }
+            /* Frames still decoding in parallel are output at the end of the stream */
+            return_error |= eb_dec_flush(p_handle);
+            while (eb_svt_dec_get_picture(p_handle, recon_buffer, stream_info, frame_info) ==
+                   EB_ErrorNone) {
+                if (enable_md5) write_md5(recon_buffer, &md5_ctx);
+                if (cli.out_file != NULL) write_frame(recon_buffer, &cli);
+            }
             if (fps_summary || fps_frm) {
                 show_progress(in_frame, dx_time);
                 fprintf(stderr, "\n");
@@ -44,12 +44,6 @@ static void set_num_thread(const char *value, EbSvtAv1DecConfiguration *cfg) {
 };
 static void set_num_pframes(const char *value, EbSvtAv1DecConfiguration *cfg) {
     cfg->num_p_frames = strtoul(value, NULL, 0);
-    if (cfg->num_p_frames != 1) {
-        fprintf(
-            stderr,
-            "Warning : Multi frame parallelism not supported. Setting parallel frames to 1. \n");
-        cfg->num_p_frames = 1;
-    }
 };
 
 /**********************************
@@ -82,7 +76,7 @@ static void show_help() {
     H0(" -h <arg>                  Input picture height \n");
     H0(" -colour-space <arg>       Input picture colour space. [400, 420, 422, 444]\n");
     H0(" -threads <arg>            Number of threads to be launched \n");
-    H0(" -parallel-frames <arg>    Number of frames to be processed in parallel \n");
+    H0(" -parallel-frames <arg>    Number of frames to be processed in parallel, up to 4 \n");
     H0(" -enable-row-mt            Enable row level parallelism \n");
     H0(" -md5                      MD5 support flag \n");
     H0(" -fps-frm                  Show fps after each frame decoded\n");
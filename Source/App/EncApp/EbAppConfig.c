@@ -11,6 +11,7 @@
 #include "EbAppString.h"
 #include "EbAppConfig.h"
 #include "EbAppInputy4m.h"
+#include "EbAppInputReader.h"
 
 #ifdef _WIN32
 #include <windows.h>
@@ -37,6 +38,8 @@
 #define HEIGHT_TOKEN "-h"
 #define NUMBER_OF_PICTURES_TOKEN "-n"
 #define BUFFERED_INPUT_TOKEN "-nb"
+#define MMAP_INPUT_TOKEN "-mmap-input"
+#define READ_AHEAD_TOKEN "-read-ahead"
 #define BASE_LAYER_SWITCH_MODE_TOKEN "-base-layer-switch-mode" // no Eval
 #define QP_TOKEN "-q"
 #define USE_QP_FILE_TOKEN "-use-q-file"
@@ -123,6 +126,7 @@
 #define SUPER_BLOCK_SIZE_TOKEN "-sb-size"
 #define TILE_ROW_TOKEN "-tile-rows"
 #define TILE_COL_TOKEN "-tile-columns"
+#define TILE_PARALLEL_TOKEN "-tile-parallel"
 
 #define SQ_WEIGHT_TOKEN "-sqw"
 #define ENABLE_AMP_TOKEN "-enable-amp"
@@ -136,6 +140,15 @@
 #define THREAD_MGMNT "-lp"
 #define UNPIN_LP1_TOKEN "-unpin-lp1"
 #define TARGET_SOCKET "-ss"
+#define THREAD_POOL_TOKEN "-thread-pool"
+#define NUMA_MODE_TOKEN "-numa"
+#define HUGE_PAGES_TOKEN "-huge-pages"
+#define PIPELINE_STATS_TOKEN "-pipeline-stats"
+#define POOL_MEMORY_BUDGET_TOKEN "-pool-mem"
+#define LOW_LATENCY_TOKEN "-low-latency"
+#define LATENCY_BUDGET_TOKEN "-latency-budget"
+#define INTER_FRAME_WAVEFRONT_TOKEN "-inter-frame-wavefront"
+#define TRACE_FILE_TOKEN "-trace-file"
 #define UNRESTRICTED_MOTION_VECTOR "-umv"
 #define CONFIG_FILE_COMMENT_CHAR '#'
 #define CONFIG_FILE_NEWLINE_CHAR '\n'
@@ -233,6 +246,12 @@ static void set_cfg_frames_to_be_encoded(const char *value, EbConfig *cfg) {
 static void set_buffered_input(const char *value, EbConfig *cfg) {
     cfg->buffered_input = strtol(value, NULL, 0);
 };
+static void set_mmap_input(const char *value, EbConfig *cfg) {
+    cfg->mmap_input = (uint32_t)strtoul(value, NULL, 0);
+};
+static void set_read_ahead(const char *value, EbConfig *cfg) {
+    cfg->read_ahead = (uint32_t)strtoul(value, NULL, 0);
+};
 static void set_frame_rate(const char *value, EbConfig *cfg) {
     cfg->frame_rate = strtoul(value, NULL, 0);
     if (cfg->frame_rate > 1000)
@@ -374,6 +393,9 @@ static void set_tile_row(const char *value, EbConfig *cfg) {
 static void set_tile_col(const char *value, EbConfig *cfg) {
     cfg->tile_columns = strtoul(value, NULL, 0);
 };
+static void set_tile_parallel(const char *value, EbConfig *cfg) {
+    cfg->tile_parallel = (uint32_t)strtoul(value, NULL, 0);
+};
 static void set_scene_change_detection(const char *value, EbConfig *cfg) {
     cfg->scene_change_detection = strtoul(value, NULL, 0);
 };
@@ -558,6 +580,36 @@ static void set_unpin_single_core_execution(const char *value, EbConfig *cfg) {
 static void set_target_socket(const char *value, EbConfig *cfg) {
     cfg->target_socket = (int32_t)strtol(value, NULL, 0);
 };
+static void set_thread_pool(const char *value, EbConfig *cfg) {
+    cfg->thread_pool = (uint32_t)strtoul(value, NULL, 0);
+};
+static void set_numa_mode(const char *value, EbConfig *cfg) {
+    cfg->numa_mode = (uint32_t)strtoul(value, NULL, 0);
+};
+static void set_huge_pages(const char *value, EbConfig *cfg) {
+    cfg->huge_pages = (uint32_t)strtoul(value, NULL, 0);
+};
+static void set_pipeline_stats(const char *value, EbConfig *cfg) {
+    cfg->pipeline_stats = (uint32_t)strtoul(value, NULL, 0);
+};
+static void set_pool_memory_budget(const char *value, EbConfig *cfg) {
+    cfg->pool_memory_budget = (uint32_t)strtoul(value, NULL, 0);
+};
+static void set_low_latency(const char *value, EbConfig *cfg) {
+    cfg->low_latency = (uint32_t)strtoul(value, NULL, 0);
+};
+static void set_latency_budget(const char *value, EbConfig *cfg) {
+    cfg->latency_budget = (uint32_t)strtoul(value, NULL, 0);
+};
+static void set_inter_frame_wavefront(const char *value, EbConfig *cfg) {
+    cfg->inter_frame_wavefront = (uint32_t)strtoul(value, NULL, 0);
+};
+static void set_trace_file(const char *value, EbConfig *cfg) {
+    size_t size = strlen(value) + 1;
+    free(cfg->trace_file_name);
+    cfg->trace_file_name = (char *)malloc(size);
+    if (cfg->trace_file_name) EB_STRCPY(cfg->trace_file_name, size, value);
+};
 static void set_unrestricted_motion_vector(const char *value, EbConfig *cfg) {
     cfg->unrestricted_motion_vector = (EbBool)strtol(value, NULL, 0);
 };
@@ -622,6 +674,8 @@ ConfigEntry config_entry[] = {
     // Prediction Structure
     {SINGLE_INPUT, NUMBER_OF_PICTURES_TOKEN, "FrameToBeEncoded", set_cfg_frames_to_be_encoded},
     {SINGLE_INPUT, BUFFERED_INPUT_TOKEN, "BufferedInput", set_buffered_input},
+    {SINGLE_INPUT, MMAP_INPUT_TOKEN, "MmapInput", set_mmap_input},
+    {SINGLE_INPUT, READ_AHEAD_TOKEN, "ReadAhead", set_read_ahead},
     {SINGLE_INPUT, BASE_LAYER_SWITCH_MODE_TOKEN, "BaseLayerSwitchMode", set_base_layer_switch_mode},
     {SINGLE_INPUT, ENCMODE_TOKEN, "EncoderMode", set_enc_mode},
     {SINGLE_INPUT, ENCMODE2P_TOKEN, "EncoderMode2p", set_snd_pass_enc_mode},
@@ -640,6 +694,7 @@ ConfigEntry config_entry[] = {
     {SINGLE_INPUT, PRED_STRUCT_TOKEN, "PredStructure", set_cfg_pred_structure},
     {SINGLE_INPUT, TILE_ROW_TOKEN, "TileRow", set_tile_row},
     {SINGLE_INPUT, TILE_COL_TOKEN, "TileCol", set_tile_col},
+    {SINGLE_INPUT, TILE_PARALLEL_TOKEN, "TileParallel", set_tile_parallel},
     // Rate Control
     {SINGLE_INPUT,
      SCENE_CHANGE_DETECTION_TOKEN,
@@ -758,6 +813,18 @@ ConfigEntry config_entry[] = {
     {SINGLE_INPUT, THREAD_MGMNT, "LogicalProcessors", set_logical_processors},
     {SINGLE_INPUT, UNPIN_LP1_TOKEN, "UnpinSingleCoreExecution", set_unpin_single_core_execution},
     {SINGLE_INPUT, TARGET_SOCKET, "TargetSocket", set_target_socket},
+    {SINGLE_INPUT, THREAD_POOL_TOKEN, "ThreadPool", set_thread_pool},
+    {SINGLE_INPUT, NUMA_MODE_TOKEN, "NumaMode", set_numa_mode},
+    {SINGLE_INPUT, HUGE_PAGES_TOKEN, "HugePages", set_huge_pages},
+    {SINGLE_INPUT, PIPELINE_STATS_TOKEN, "PipelineStats", set_pipeline_stats},
+    {SINGLE_INPUT, TRACE_FILE_TOKEN, "TraceFile", set_trace_file},
+    {SINGLE_INPUT, POOL_MEMORY_BUDGET_TOKEN, "PoolMemoryBudget", set_pool_memory_budget},
+    {SINGLE_INPUT, LOW_LATENCY_TOKEN, "LowLatency", set_low_latency},
+    {SINGLE_INPUT, LATENCY_BUDGET_TOKEN, "LatencyBudget", set_latency_budget},
+    {SINGLE_INPUT,
+     INTER_FRAME_WAVEFRONT_TOKEN,
+     "InterFrameWavefront",
+     set_inter_frame_wavefront},
     // Optional Features
     {SINGLE_INPUT,
      UNRESTRICTED_MOTION_VECTOR,
@@ -901,8 +968,18 @@ void eb_config_ctor(EbConfig *config_ptr) {
     // ASM Type
     config_ptr->cpu_flags_limit = CPU_FLAGS_ALL;
 
-    config_ptr->unpin_lp1     = 1;
-    config_ptr->target_socket = -1;
+    config_ptr->unpin_lp1          = 1;
+    config_ptr->target_socket      = -1;
+    config_ptr->thread_pool        = 0;
+    config_ptr->numa_mode          = 0;
+    config_ptr->huge_pages         = 0;
+    config_ptr->pipeline_stats     = 0;
+    config_ptr->trace_file_name    = NULL;
+    config_ptr->pool_memory_budget = 0;
+    config_ptr->low_latency        = 0;
+    config_ptr->tile_parallel      = 0;
+    config_ptr->latency_budget     = 0;
+    config_ptr->inter_frame_wavefront = 0;
 
     config_ptr->unrestricted_motion_vector = EB_TRUE;
 
@@ -933,6 +1010,8 @@ void eb_config_dtor(EbConfig *config_ptr) {
         config_ptr->config_file = (FILE *)NULL;
     }
 
+    // Stops the reader thread before its file is closed
+    input_reader_close(config_ptr);
     if (config_ptr->input_file) {
         if (!config_ptr->input_file_is_fifo) fclose(config_ptr->input_file);
         config_ptr->input_file = (FILE *)NULL;
@@ -970,6 +1049,8 @@ void eb_config_dtor(EbConfig *config_ptr) {
         fclose(config_ptr->output_stat_file);
         config_ptr->output_stat_file = (FILE *)NULL;
     }
+    free(config_ptr->trace_file_name);
+    config_ptr->trace_file_name = NULL;
     return;
 }
 
@@ -1199,6 +1280,23 @@ static EbErrorType verify_settings(EbConfig *config, uint32_t channel_number) {
         return_error = EB_ErrorBadParameter;
     }
 
+    if (config->mmap_input > 1) {
+        fprintf(config->error_log_file,
+                "Error instance %u: Invalid MmapInput flag [0 - 1], your input: %u\n",
+                channel_number + 1,
+                config->mmap_input);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->read_ahead > MAX_READ_AHEAD) {
+        fprintf(config->error_log_file,
+                "Error instance %u: Invalid ReadAhead [0 - %d], your input: %u\n",
+                channel_number + 1,
+                MAX_READ_AHEAD,
+                config->read_ahead);
+        return_error = EB_ErrorBadParameter;
+    }
+
     if (config->use_qp_file == EB_TRUE && config->qp_file == NULL) {
         fprintf(config->error_log_file,
                 "Error instance %u: Could not find QP file, UseQpFile is set to 1\n",
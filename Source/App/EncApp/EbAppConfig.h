@@ -104,6 +104,7 @@ extern uint32_t          app_malloc_count;
 
 #define MAX_CHANNEL_NUMBER 6
 #define MAX_NUM_TOKENS 200
+#define MAX_READ_AHEAD 256 // Maximum number of frames read ahead of the encoder
 
 #ifdef _WIN32
 #define FOPEN(f, s, m) fopen_s(&f, s, m)
@@ -123,6 +124,7 @@ typedef struct EbPerformanceContext {
 
     uint64_t total_latency;
     uint32_t max_latency;
+    uint64_t late_frame_count; // frames over the latency budget
 
     uint64_t starts_time;
     uint64_t startu_time;
@@ -184,6 +186,10 @@ typedef struct EbConfig {
     int32_t   frames_encoded;
     int32_t   buffered_input;
     uint8_t **sequence_buffer;
+    uint32_t  mmap_input;
+    uint32_t  read_ahead;
+    // input_reader - frame reads off the sending thread, NULL when not used
+    struct EbAppInputReader *input_reader;
 
     uint8_t latency_mode;
 
@@ -373,6 +379,7 @@ typedef struct EbConfig {
     int32_t enable_palette;
     int32_t tile_columns;
     int32_t tile_rows;
+    uint32_t tile_parallel;
     int32_t olpd_refinement; // Open Loop Partitioning Decision Refinement
 
     /****************************************
@@ -426,6 +433,15 @@ typedef struct EbConfig {
     uint32_t logical_processors;
     uint32_t unpin_lp1;
     int32_t  target_socket;
+    uint32_t thread_pool;
+    uint32_t numa_mode;
+    uint32_t huge_pages;
+    uint32_t pipeline_stats;
+    char *   trace_file_name;
+    uint32_t pool_memory_budget;
+    uint32_t low_latency;
+    uint32_t latency_budget;
+    uint32_t inter_frame_wavefront;
     EbBool   stop_encoder; // to signal CTRL+C Event, need to stop encoding.
 
     uint64_t processed_frame_count;
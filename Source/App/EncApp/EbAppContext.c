@@ -11,6 +11,7 @@
 
 #include "EbAppContext.h"
 #include "EbAppConfig.h"
+#include "EbAppInputReader.h"
 
 #define INPUT_SIZE_576p_TH 0x90000 // 0.58 Million
 #define INPUT_SIZE_1080i_TH 0xB71B0 // 0.75 Million
@@ -161,6 +162,7 @@ EbErrorType copy_configuration_parameters(EbConfig *config, EbAppContext *callba
     callback_data->eb_enc_parameters.ext_block_flag         = config->ext_block_flag;
     callback_data->eb_enc_parameters.tile_rows              = config->tile_rows;
     callback_data->eb_enc_parameters.tile_columns           = config->tile_columns;
+    callback_data->eb_enc_parameters.tile_parallel          = config->tile_parallel;
     callback_data->eb_enc_parameters.scene_change_detection = config->scene_change_detection;
     callback_data->eb_enc_parameters.look_ahead_distance    = config->look_ahead_distance;
     callback_data->eb_enc_parameters.rate_control_mode      = config->rate_control_mode;
@@ -242,6 +244,16 @@ EbErrorType copy_configuration_parameters(EbConfig *config, EbAppContext *callba
     callback_data->eb_enc_parameters.logical_processors        = config->logical_processors;
     callback_data->eb_enc_parameters.unpin_lp1                 = config->unpin_lp1;
     callback_data->eb_enc_parameters.target_socket             = config->target_socket;
+    callback_data->eb_enc_parameters.thread_pool               = config->thread_pool;
+    callback_data->eb_enc_parameters.numa_mode                 = config->numa_mode;
+    callback_data->eb_enc_parameters.huge_pages                = config->huge_pages;
+    // The trace needs the per task events
+    callback_data->eb_enc_parameters.pipeline_stats =
+        config->trace_file_name ? 2 : config->pipeline_stats;
+    callback_data->eb_enc_parameters.pool_memory_budget = config->pool_memory_budget;
+    callback_data->eb_enc_parameters.low_latency        = config->low_latency;
+    callback_data->eb_enc_parameters.latency_budget     = config->latency_budget;
+    callback_data->eb_enc_parameters.inter_frame_wavefront = config->inter_frame_wavefront;
     callback_data->eb_enc_parameters.unrestricted_motion_vector =
         config->unrestricted_motion_vector;
     callback_data->eb_enc_parameters.recon_enabled = config->recon_file ? EB_TRUE : EB_FALSE;
@@ -381,8 +393,8 @@ EbErrorType allocate_input_buffers(EbConfig *config, EbAppContext *callback_data
                   EB_N_PTR,
                   EB_ErrorInsufficientResources);
 
-    // Allocate frame buffer for the p_buffer
-    if (config->buffered_input == -1)
+    // Allocate frame buffer for the p_buffer, the input reader passes its own
+    if (config->buffered_input == -1 && !config->input_reader)
         allocate_frame_buffer(config, callback_data->input_buffer_pool->p_buffer);
 
     // Assign the variables
@@ -534,7 +546,10 @@ EbErrorType init_encoder(EbConfig *config, EbAppContext *callback_data, uint32_t
 
     ///********************** APPLICATION INIT [START] ******************///
 
-    // STEP 6: Allocate input buffers carrying the yuv frames in
+    // STEP 6: Start the input reader, and allocate input buffers carrying the yuv frames in
+    return_error = input_reader_open(config);
+
+    if (return_error != EB_ErrorNone) return return_error;
     return_error = allocate_input_buffers(config, callback_data);
 
     if (return_error != EB_ErrorNone) return return_error;
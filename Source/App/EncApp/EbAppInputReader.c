@@ -0,0 +1,378 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "EbAppInputReader.h"
+#include "EbAppInputy4m.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#else
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define Y4M_FRAME_DELIMITER "FRAME\n"
+#define Y4M_FRAME_DELIMITER_SIZE 6
+
+struct EbAppInputReader {
+    uint64_t frame_size;
+    // delimiter_size - size of the y4m "FRAME" line before each frame
+    uint32_t delimiter_size;
+    uint64_t first_frame_offset;
+
+    // Memory map
+    uint8_t *map_ptr;
+    uint64_t map_size;
+    uint64_t file_frame_count;
+    uint64_t frame_index;
+    // advise_count - frames the kernel is asked to read ahead of the encoder
+    uint32_t advise_count;
+#ifdef _WIN32
+    HANDLE map_handle;
+#endif
+
+    // Read ahead
+    uint32_t  buffer_count;
+    uint8_t **buffer_array;
+    uint32_t *filled_len_array;
+    // read_count - frames read by the reader thread, take_count - frames
+    //   taken by the sending thread, the buffers in between are full
+    uint64_t read_count;
+    uint64_t take_count;
+    // frame_held - the last frame taken is still read by the encoder
+    EbBool frame_held;
+    EbBool end_of_input;
+    EbBool stop;
+    EbBool thread_started;
+#ifdef _WIN32
+    CRITICAL_SECTION   mutex;
+    CONDITION_VARIABLE cond;
+    HANDLE             thread_handle;
+#else
+    pthread_mutex_t mutex;
+    pthread_cond_t  cond;
+    pthread_t       thread_handle;
+#endif
+};
+
+static uint64_t input_frame_size(const EbConfig *config) {
+    uint64_t frame_size = (uint64_t)config->input_padded_width * config->input_padded_height;
+
+    frame_size += 2 * (frame_size >> (3 - config->encoder_color_format));
+    if (config->encoder_bit_depth == 10 && config->compressed_ten_bit_format == 1)
+        frame_size += frame_size / 4;
+    else
+        frame_size <<= (config->encoder_bit_depth > 8);
+    return frame_size;
+}
+
+/***************************************
+ * Memory Map
+ ***************************************/
+static void advise_frame(EbAppInputReader *reader, uint64_t frame_index) {
+#ifdef _WIN32
+    // PrefetchVirtualMemory is not available before Windows 8, the page
+    // faults are left to the encoder copy
+    (void)reader;
+    (void)frame_index;
+#else
+    const uint64_t page_mask   = (uint64_t)sysconf(_SC_PAGESIZE) - 1;
+    const uint64_t frame_pitch = reader->delimiter_size + reader->frame_size;
+    uint64_t       offset =
+        reader->first_frame_offset + (frame_index % reader->file_frame_count) * frame_pitch;
+    uint64_t end = offset + frame_pitch;
+
+    offset &= ~page_mask;
+    posix_madvise(reader->map_ptr + offset, (size_t)(end - offset), POSIX_MADV_WILLNEED);
+#endif
+}
+
+static void unmap_input_file(EbAppInputReader *reader) {
+    if (reader->map_ptr == NULL) return;
+#ifdef _WIN32
+    UnmapViewOfFile(reader->map_ptr);
+    CloseHandle(reader->map_handle);
+#else
+    munmap(reader->map_ptr, (size_t)reader->map_size);
+#endif
+    reader->map_ptr = NULL;
+}
+
+static EbBool map_input_file(EbConfig *config, EbAppInputReader *reader) {
+    const uint64_t frame_pitch = reader->delimiter_size + reader->frame_size;
+#ifdef _WIN32
+    HANDLE        file_handle = (HANDLE)_get_osfhandle(_fileno(config->input_file));
+    LARGE_INTEGER file_size;
+
+    if (!GetFileSizeEx(file_handle, &file_size) || file_size.QuadPart == 0) return EB_FALSE;
+    reader->map_size   = (uint64_t)file_size.QuadPart;
+    reader->map_handle = CreateFileMapping(file_handle, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (reader->map_handle == NULL) return EB_FALSE;
+    reader->map_ptr = (uint8_t *)MapViewOfFile(reader->map_handle, FILE_MAP_READ, 0, 0, 0);
+    if (reader->map_ptr == NULL) {
+        CloseHandle(reader->map_handle);
+        return EB_FALSE;
+    }
+#else
+    struct stat statbuf;
+    void *      map_ptr;
+
+    if (fstat(fileno(config->input_file), &statbuf) || statbuf.st_size <= 0 ||
+        (uint64_t)statbuf.st_size > SIZE_MAX)
+        return EB_FALSE;
+    reader->map_size = (uint64_t)statbuf.st_size;
+    map_ptr          = mmap(
+        NULL, (size_t)reader->map_size, PROT_READ, MAP_PRIVATE, fileno(config->input_file), 0);
+    if (map_ptr == MAP_FAILED) return EB_FALSE;
+    reader->map_ptr = (uint8_t *)map_ptr;
+    posix_madvise(map_ptr, (size_t)reader->map_size, POSIX_MADV_SEQUENTIAL);
+#endif
+
+    reader->file_frame_count = reader->map_size > reader->first_frame_offset
+                                   ? (reader->map_size - reader->first_frame_offset) / frame_pitch
+                                   : 0;
+    if (reader->file_frame_count == 0) {
+        unmap_input_file(reader);
+        return EB_FALSE;
+    }
+    reader->advise_count = config->read_ahead ? config->read_ahead : 1;
+    for (uint32_t frame_index = 0; frame_index < reader->advise_count; ++frame_index)
+        advise_frame(reader, frame_index);
+    return EB_TRUE;
+}
+
+// Frames past the end of the file loop over to the first one, as the file reads do
+static uint8_t *get_mapped_frame(EbConfig *config, EbAppInputReader *reader,
+                                 uint32_t *filled_len) {
+    const uint64_t frame_pitch = reader->delimiter_size + reader->frame_size;
+    uint8_t *      frame_ptr   = reader->map_ptr + reader->first_frame_offset +
+                          (reader->frame_index % reader->file_frame_count) * frame_pitch;
+
+    if (reader->delimiter_size &&
+        memcmp(frame_ptr, Y4M_FRAME_DELIMITER, Y4M_FRAME_DELIMITER_SIZE) != 0)
+        fprintf(config->error_log_file,
+                "Failed to read proper y4m frame delimeter. Read broken.\n");
+    advise_frame(reader, reader->frame_index + reader->advise_count);
+    reader->frame_index++;
+
+    *filled_len = (uint32_t)reader->frame_size;
+    return frame_ptr + reader->delimiter_size;
+}
+
+/***************************************
+ * Read Ahead
+ ***************************************/
+#ifdef _WIN32
+#define READER_LOCK(r) EnterCriticalSection(&(r)->mutex)
+#define READER_UNLOCK(r) LeaveCriticalSection(&(r)->mutex)
+#define READER_WAIT(r) SleepConditionVariableCS(&(r)->cond, &(r)->mutex, INFINITE)
+#define READER_WAKE(r) WakeAllConditionVariable(&(r)->cond)
+#else
+#define READER_LOCK(r) pthread_mutex_lock(&(r)->mutex)
+#define READER_UNLOCK(r) pthread_mutex_unlock(&(r)->mutex)
+#define READER_WAIT(r) pthread_cond_wait(&(r)->cond, &(r)->mutex)
+#define READER_WAKE(r) pthread_cond_broadcast(&(r)->cond)
+#endif
+
+static uint32_t read_frame(EbConfig *config, EbAppInputReader *reader, uint8_t *frame_ptr) {
+    FILE *   input_file = config->input_file;
+    uint64_t filled_len = 0;
+
+    if (config->y4m_input == EB_TRUE) read_y4m_frame_delimiter(config);
+    if (!config->y4m_input && reader->read_count == 0 &&
+        (input_file == stdin || config->input_file_is_fifo)) {
+        /* the first bytes were already buffered during the the YUV4MPEG2 header probe */
+        memcpy(frame_ptr, config->y4m_buf, sizeof(config->y4m_buf));
+        filled_len = sizeof(config->y4m_buf);
+    }
+    filled_len +=
+        fread(frame_ptr + filled_len, 1, (size_t)(reader->frame_size - filled_len), input_file);
+    return (uint32_t)filled_len;
+}
+
+static void read_ahead_loop(EbConfig *config) {
+    EbAppInputReader *reader = config->input_reader;
+    const EbBool      piped  = config->input_file == stdin || config->input_file_is_fifo;
+
+    for (;;) {
+        uint32_t buffer_index, filled_len;
+        EbBool   stop;
+
+        READER_LOCK(reader);
+        while (!reader->stop && reader->read_count - reader->take_count == reader->buffer_count)
+            READER_WAIT(reader);
+        stop = reader->stop;
+        READER_UNLOCK(reader);
+        if (stop) break;
+
+        // The sending thread does not touch the buffers past take_count
+        buffer_index = (uint32_t)(reader->read_count % reader->buffer_count);
+        filled_len   = read_frame(config, reader, reader->buffer_array[buffer_index]);
+        if (filled_len != reader->frame_size && !piped) {
+            // If we reached the end of file, loop over again
+            fseeko(config->input_file, (int64_t)reader->first_frame_offset, SEEK_SET);
+            filled_len = read_frame(config, reader, reader->buffer_array[buffer_index]);
+        }
+
+        READER_LOCK(reader);
+        if (filled_len == reader->frame_size) {
+            reader->filled_len_array[buffer_index] = filled_len;
+            reader->read_count++;
+        } else
+            // An incomplete frame ends the input
+            reader->end_of_input = EB_TRUE;
+        READER_WAKE(reader);
+        READER_UNLOCK(reader);
+        if (reader->end_of_input) break;
+    }
+}
+
+#ifdef _WIN32
+static DWORD WINAPI read_ahead_kernel(LPVOID input_ptr) {
+    read_ahead_loop((EbConfig *)input_ptr);
+    return 0;
+}
+#else
+static void *read_ahead_kernel(void *input_ptr) {
+    read_ahead_loop((EbConfig *)input_ptr);
+    return NULL;
+}
+#endif
+
+static EbErrorType start_read_ahead(EbConfig *config, EbAppInputReader *reader) {
+    reader->buffer_count     = config->read_ahead;
+    reader->buffer_array     = (uint8_t **)calloc(reader->buffer_count, sizeof(uint8_t *));
+    reader->filled_len_array = (uint32_t *)calloc(reader->buffer_count, sizeof(uint32_t));
+    if (reader->buffer_array == NULL || reader->filled_len_array == NULL)
+        return EB_ErrorInsufficientResources;
+    for (uint32_t buffer_index = 0; buffer_index < reader->buffer_count; ++buffer_index) {
+        reader->buffer_array[buffer_index] = (uint8_t *)malloc((size_t)reader->frame_size);
+        if (reader->buffer_array[buffer_index] == NULL) return EB_ErrorInsufficientResources;
+    }
+
+#ifdef _WIN32
+    InitializeCriticalSection(&reader->mutex);
+    InitializeConditionVariable(&reader->cond);
+    reader->thread_handle = CreateThread(NULL, 0, read_ahead_kernel, config, 0, NULL);
+    if (reader->thread_handle == NULL) {
+        DeleteCriticalSection(&reader->mutex);
+        return EB_ErrorInsufficientResources;
+    }
+#else
+    pthread_mutex_init(&reader->mutex, NULL);
+    pthread_cond_init(&reader->cond, NULL);
+    if (pthread_create(&reader->thread_handle, NULL, read_ahead_kernel, config)) {
+        pthread_cond_destroy(&reader->cond);
+        pthread_mutex_destroy(&reader->mutex);
+        return EB_ErrorInsufficientResources;
+    }
+#endif
+    reader->thread_started = EB_TRUE;
+    return EB_ErrorNone;
+}
+
+static void stop_read_ahead(EbAppInputReader *reader) {
+    READER_LOCK(reader);
+    reader->stop = EB_TRUE;
+    READER_WAKE(reader);
+    READER_UNLOCK(reader);
+#ifdef _WIN32
+    WaitForSingleObject(reader->thread_handle, INFINITE);
+    CloseHandle(reader->thread_handle);
+    DeleteCriticalSection(&reader->mutex);
+#else
+    pthread_join(reader->thread_handle, NULL);
+    pthread_cond_destroy(&reader->cond);
+    pthread_mutex_destroy(&reader->mutex);
+#endif
+    reader->thread_started = EB_FALSE;
+}
+
+static uint8_t *get_read_ahead_frame(EbAppInputReader *reader, uint32_t *filled_len) {
+    uint32_t buffer_index;
+
+    READER_LOCK(reader);
+    // The encoder copied the previous frame, its buffer goes back to the reader
+    if (reader->frame_held) {
+        reader->take_count++;
+        reader->frame_held = EB_FALSE;
+        READER_WAKE(reader);
+    }
+    while (reader->take_count == reader->read_count && !reader->end_of_input) READER_WAIT(reader);
+    if (reader->take_count == reader->read_count) {
+        READER_UNLOCK(reader);
+        *filled_len = 0;
+        return NULL;
+    }
+    reader->frame_held = EB_TRUE;
+    READER_UNLOCK(reader);
+
+    buffer_index = (uint32_t)(reader->take_count % reader->buffer_count);
+    *filled_len  = reader->filled_len_array[buffer_index];
+    return reader->buffer_array[buffer_index];
+}
+
+/***************************************
+ * Input Reader
+ ***************************************/
+EbErrorType input_reader_open(EbConfig *config) {
+    const EbBool      piped = config->input_file == stdin || config->input_file_is_fifo;
+    EbAppInputReader *reader;
+    EbErrorType       return_error;
+
+    config->input_reader = NULL;
+    // Preloaded frames are read before the encode starts
+    if (config->input_file == NULL || config->buffered_input != -1) return EB_ErrorNone;
+    if (!(config->mmap_input && !piped) && !config->read_ahead) return EB_ErrorNone;
+
+    reader = (EbAppInputReader *)calloc(1, sizeof(EbAppInputReader));
+    if (reader == NULL) return EB_ErrorInsufficientResources;
+    reader->frame_size         = input_frame_size(config);
+    reader->delimiter_size     = config->y4m_input ? Y4M_FRAME_DELIMITER_SIZE : 0;
+    reader->first_frame_offset = piped ? 0 : (uint64_t)ftello(config->input_file);
+    config->input_reader       = reader;
+
+    if (config->mmap_input && !piped && map_input_file(config, reader)) return EB_ErrorNone;
+
+    // Pipes, and files that can not be mapped, are read ahead if asked for
+    if (!config->read_ahead) {
+        input_reader_close(config);
+        return EB_ErrorNone;
+    }
+    return_error = start_read_ahead(config, reader);
+    if (return_error != EB_ErrorNone) input_reader_close(config);
+    return return_error;
+}
+
+uint8_t *input_reader_get_frame(EbConfig *config, uint32_t *filled_len) {
+    EbAppInputReader *reader = config->input_reader;
+
+    return reader->map_ptr ? get_mapped_frame(config, reader, filled_len)
+                           : get_read_ahead_frame(reader, filled_len);
+}
+
+void input_reader_close(EbConfig *config) {
+    EbAppInputReader *reader = config->input_reader;
+
+    if (reader == NULL) return;
+    if (reader->thread_started) stop_read_ahead(reader);
+    if (reader->buffer_array) {
+        for (uint32_t buffer_index = 0; buffer_index < reader->buffer_count; ++buffer_index)
+            free(reader->buffer_array[buffer_index]);
+        free(reader->buffer_array);
+    }
+    free(reader->filled_len_array);
+    unmap_input_file(reader);
+    free(reader);
+    config->input_reader = NULL;
+}
@@ -0,0 +1,32 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifndef EbAppInputReader_h
+#define EbAppInputReader_h
+
+#include "EbAppConfig.h"
+
+/***************************************
+ * Input Reader
+ *   Takes the frame reads off the thread sending the pictures:
+ *   - MmapInput maps a regular input file, the frames are passed to the
+ *     encoder in place,
+ *   - ReadAhead reads whole frames on a background thread into a bounded
+ *     pool of frame buffers.
+ *   The frame returned stays valid until the next call, the encoder
+ *   copies it in eb_svt_enc_send_picture.
+ ***************************************/
+typedef struct EbAppInputReader EbAppInputReader;
+
+// Sets config->input_reader, left NULL when neither mode applies to the input
+extern EbErrorType input_reader_open(EbConfig *config);
+
+// Returns the next frame with its planes back to back, NULL at the end of
+// a piped input
+extern uint8_t *input_reader_get_frame(EbConfig *config, uint32_t *filled_len);
+
+extern void input_reader_close(EbConfig *config);
+
+#endif // EbAppInputReader_h
@@ -71,6 +71,64 @@ void assign_app_thread_group(uint8_t target_socket) {
 
 double get_psnr(double sse, double max);
 
+/***************************************
+ * Pipeline Statistics
+ *   Prints the per stage counters and writes the trace file, once the
+ *   channel returned its last packet.
+ ***************************************/
+static void print_pipeline_stats(EbConfig *config, EbAppContext *app_callback, uint32_t channel) {
+    EbSvtEncStats stats;
+
+    if (!config->pipeline_stats && !config->trace_file_name) return;
+    if (eb_svt_enc_get_stats(app_callback->svt_encoder_handle, &stats) != EB_ErrorNone) return;
+
+    fprintf(stderr,
+            "\nChannel %u Pipeline Stats\n%-26s %7s %8s %10s %10s %10s %9s %5s\n",
+            channel + 1,
+            "Stage",
+            "Threads",
+            "Tasks",
+            "Busy ms",
+            "Blocked ms",
+            "Idle ms",
+            "Busy thr",
+            "Queue");
+    for (uint32_t stage_index = 0; stage_index < stats.stage_count; ++stage_index) {
+        EbSvtStageStats *stage = &stats.stage[stage_index];
+        char             threads[16];
+
+        if (stage->thread_count)
+            snprintf(threads, sizeof(threads), "%u", stage->thread_count);
+        else
+            snprintf(threads, sizeof(threads), "pool");
+        // Busy thr - threads busy with the stage on average
+        fprintf(stderr,
+                "%-26s %7s %8llu %10.1f %10.1f %10.1f %9.2f %5u\n",
+                stage->name,
+                threads,
+                (unsigned long long)stage->task_count,
+                stage->busy_ns / 1e6,
+                stage->blocked_ns / 1e6,
+                stage->idle_ns / 1e6,
+                (double)stage->busy_ns / stats.elapsed_ns,
+                stage->max_queue_depth);
+    }
+    if (config->thread_pool)
+        fprintf(stderr, "Thread pool idle:\t%.1f ms\n", stats.pool_idle_ns / 1e6);
+
+    if (config->trace_file_name) {
+        if (eb_svt_enc_dump_trace(app_callback->svt_encoder_handle, config->trace_file_name) !=
+            EB_ErrorNone)
+            fprintf(stderr, "Could not write the trace file %s\n", config->trace_file_name);
+        else
+            fprintf(stderr,
+                    "Trace file:\t\t%s, %llu events, %llu dropped\n",
+                    config->trace_file_name,
+                    (unsigned long long)stats.trace_event_count,
+                    (unsigned long long)stats.trace_dropped_count);
+    }
+}
+
 /***************************************
  * Encoder App Main
  ***************************************/
@@ -379,6 +437,13 @@ int32_t main(int32_t argc, char *argv[]) {
                             configs[inst_cnt]->performance_context.total_execution_time * 1000,
                             configs[inst_cnt]->performance_context.average_latency,
                             (uint32_t)(configs[inst_cnt]->performance_context.max_latency));
+                        if (configs[inst_cnt]->latency_budget)
+                            fprintf(stderr,
+                                    "Frames Over Budget:\t%llu (%u ms)\n",
+                                    (unsigned long long)configs[inst_cnt]
+                                        ->performance_context.late_frame_count,
+                                    configs[inst_cnt]->latency_budget);
+                        print_pipeline_stats(configs[inst_cnt], app_callbacks[inst_cnt], inst_cnt);
                     } else
                         fprintf(stderr,
                                 "\nChannel %u Encoding Interrupted\n",
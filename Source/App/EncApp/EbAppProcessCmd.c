@@ -14,6 +14,7 @@
 #include "EbAppConfig.h"
 #include "EbSvtAv1ErrorCodes.h"
 #include "EbAppInputy4m.h"
+#include "EbAppInputReader.h"
 #include "EbTime.h"
 /***************************************
  * Macros
@@ -755,6 +756,46 @@ int32_t get_next_qp_from_qp_file(EbConfig *config) {
     return qp;
 }
 
+/******************************************************
+* Point the planes of the input buffer to a frame stored
+* with its planes back to back, returns the frame size
+******************************************************/
+static uint32_t set_frame_planes(EbConfig *config, uint8_t is_16bit, EbSvtIOFormat *input_ptr,
+                                 uint8_t *frame_ptr) {
+    const uint32_t input_padded_width  = config->input_padded_width;
+    const uint32_t input_padded_height = config->input_padded_height;
+    const uint8_t  color_format        = config->encoder_color_format;
+
+    if (is_16bit && config->compressed_ten_bit_format == 1) {
+        // Determine size of each plane
+        const size_t luma_8bit_size   = input_padded_width * input_padded_height;
+        const size_t chroma_8bit_size = luma_8bit_size >> (3 - color_format);
+        const size_t luma_2bit_size   = luma_8bit_size / 4; //4-2bit pixels into 1 byte
+        const size_t chroma_2bit_size = luma_2bit_size >> (3 - color_format);
+
+        input_ptr->luma     = frame_ptr;
+        input_ptr->cb       = frame_ptr + luma_8bit_size;
+        input_ptr->cr       = frame_ptr + luma_8bit_size + chroma_8bit_size;
+        input_ptr->luma_ext = frame_ptr + luma_8bit_size + 2 * chroma_8bit_size;
+        input_ptr->cb_ext   = frame_ptr + luma_8bit_size + 2 * chroma_8bit_size + luma_2bit_size;
+        input_ptr->cr_ext   = frame_ptr + luma_8bit_size + 2 * chroma_8bit_size + luma_2bit_size +
+                            chroma_2bit_size;
+
+        return (uint32_t)(luma_8bit_size + luma_2bit_size +
+                          2 * (chroma_8bit_size + chroma_2bit_size));
+    } else {
+        //Normal unpacked mode:yuv420p10le yuv422p10le yuv444p10le
+        const size_t luma_size   = (input_padded_width * input_padded_height) << is_16bit;
+        const size_t chroma_size = luma_size >> (3 - color_format);
+
+        input_ptr->luma = frame_ptr;
+        input_ptr->cb   = frame_ptr + luma_size;
+        input_ptr->cr   = frame_ptr + luma_size + chroma_size;
+
+        return (uint32_t)(luma_size + 2 * chroma_size);
+    }
+}
+
 void read_input_frames(EbConfig *config, uint8_t is_16bit, EbBufferHeaderType *header_ptr) {
     uint64_t       read_size;
     const uint32_t input_padded_width  = config->input_padded_width;
@@ -770,7 +811,17 @@ void read_input_frames(EbConfig *config, uint8_t is_16bit, EbBufferHeaderType *h
     input_ptr->cr_stride = input_padded_width >> subsampling_x;
     input_ptr->cb_stride = input_padded_width >> subsampling_x;
 
-    if (config->buffered_input == -1) {
+    if (config->input_reader) {
+        uint32_t filled_len;
+        uint8_t *frame_ptr = input_reader_get_frame(config, &filled_len);
+
+        if (frame_ptr)
+            set_frame_planes(config, is_16bit, input_ptr, frame_ptr);
+        else
+            //for a fifo, we only know this when we reach eof
+            config->frames_to_be_encoded = config->frames_encoded;
+        header_ptr->n_filled_len = filled_len;
+    } else if (config->buffered_input == -1) {
         if (is_16bit == 0 || (is_16bit == 1 && config->compressed_ten_bit_format == 0)) {
             read_size = (uint64_t)SIZE_OF_ONE_FRAME_IN_BYTES(
                 input_padded_width, input_padded_height, color_format, is_16bit);
@@ -866,63 +917,12 @@ void read_input_frames(EbConfig *config, uint8_t is_16bit, EbBufferHeaderType *h
             }
         }
 
-    } else {
-        if (is_16bit && config->compressed_ten_bit_format == 1) {
-            // Determine size of each plane
-            const size_t luma_8bit_size   = input_padded_width * input_padded_height;
-            const size_t chroma_8bit_size = luma_8bit_size >> (3 - color_format);
-            const size_t luma_2bit_size   = luma_8bit_size / 4; //4-2bit pixels into 1 byte
-            const size_t chroma_2bit_size = luma_2bit_size >> (3 - color_format);
-
-            EbSvtIOFormat *input_ptr = (EbSvtIOFormat *)header_ptr->p_buffer;
-            input_ptr->y_stride      = input_padded_width;
-            input_ptr->cr_stride     = input_padded_width >> subsampling_x;
-            input_ptr->cb_stride     = input_padded_width >> subsampling_x;
-
-            input_ptr->luma =
-                config->sequence_buffer[config->processed_frame_count % config->buffered_input];
-            input_ptr->cb =
-                config->sequence_buffer[config->processed_frame_count % config->buffered_input] +
-                luma_8bit_size;
-            input_ptr->cr =
-                config->sequence_buffer[config->processed_frame_count % config->buffered_input] +
-                luma_8bit_size + chroma_8bit_size;
-
-            input_ptr->luma_ext =
-                config->sequence_buffer[config->processed_frame_count % config->buffered_input] +
-                luma_8bit_size + 2 * chroma_8bit_size;
-            input_ptr->cb_ext =
-                config->sequence_buffer[config->processed_frame_count % config->buffered_input] +
-                luma_8bit_size + 2 * chroma_8bit_size + luma_2bit_size;
-            input_ptr->cr_ext =
-                config->sequence_buffer[config->processed_frame_count % config->buffered_input] +
-                luma_8bit_size + 2 * chroma_8bit_size + luma_2bit_size + chroma_2bit_size;
-
-            header_ptr->n_filled_len = (uint32_t)(luma_8bit_size + luma_2bit_size +
-                                                  2 * (chroma_8bit_size + chroma_2bit_size));
-        } else {
-            //Normal unpacked mode:yuv420p10le yuv422p10le yuv444p10le
-            const size_t luma_size   = (input_padded_width * input_padded_height) << is_16bit;
-            const size_t chroma_size = luma_size >> (3 - color_format);
-
-            EbSvtIOFormat *input_ptr = (EbSvtIOFormat *)header_ptr->p_buffer;
-
-            input_ptr->y_stride  = input_padded_width;
-            input_ptr->cr_stride = input_padded_width >> subsampling_x;
-            input_ptr->cb_stride = input_padded_width >> subsampling_x;
-
-            input_ptr->luma =
-                config->sequence_buffer[config->processed_frame_count % config->buffered_input];
-            input_ptr->cb =
-                config->sequence_buffer[config->processed_frame_count % config->buffered_input] +
-                luma_size;
-            input_ptr->cr =
-                config->sequence_buffer[config->processed_frame_count % config->buffered_input] +
-                luma_size + chroma_size;
-
-            header_ptr->n_filled_len = (uint32_t)(luma_size + 2 * chroma_size);
-        }
-    }
+    } else
+        header_ptr->n_filled_len = set_frame_planes(
+            config,
+            is_16bit,
+            input_ptr,
+            config->sequence_buffer[config->processed_frame_count % config->buffered_input]);
 
     return;
 }
@@ -1223,6 +1223,12 @@ AppExitConditionType process_output_stream_buffer(EbConfig *config, EbAppContext
             fprintf(stderr, "\n");
             log_error_output(config->error_log_file, header_ptr->flags);
             return APP_ExitConditionError;
+        } else if (stream_status != EB_NoErrorEmptyQueue && !header_ptr->p_buffer &&
+                   (header_ptr->flags & EB_BUFFERFLAG_EOS)) {
+            // Low latency end of sequence, the packet carries no picture
+            *port_state  = APP_PortInactive;
+            return_value = APP_ExitConditionFinished;
+            eb_svt_release_out_buffer(&header_ptr);
         } else if (stream_status != EB_NoErrorEmptyQueue) {
             is_alt_ref        = (header_ptr->flags & EB_BUFFERFLAG_IS_ALT_REF);
             EbBool  has_tiles = (EbBool)(app_call_back->eb_enc_parameters.tile_columns ||
@@ -1234,6 +1240,8 @@ AppExitConditionType process_output_stream_buffer(EbConfig *config, EbAppContext
             *total_latency += (uint64_t)header_ptr->n_tick_count;
             *max_latency =
                 (header_ptr->n_tick_count > *max_latency) ? header_ptr->n_tick_count : *max_latency;
+            if (config->latency_budget && header_ptr->n_tick_count > config->latency_budget)
+                ++(config->performance_context.late_frame_count);
 
             finish_time((uint64_t *)&finish_s_time, (uint64_t *)&finish_u_time);
 
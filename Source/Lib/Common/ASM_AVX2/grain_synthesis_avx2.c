@@ -0,0 +1,191 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <immintrin.h>
+#include "EbDefinitions.h"
+#include "common_dsp_rtcd.h"
+#include "grainSynthesis.h"
+
+// Scaling function of 8 indices, interpolated between the 256 entries of the
+// lut above 8 bits
+static INLINE __m256i scale_lut_avx2(const FgnBlendParams *p, __m256i index) {
+    if (p->bit_depth == 8) return _mm256_i32gather_epi32(p->scaling_lut, index, 4);
+
+    const __m128i shift = _mm_cvtsi32_si128(p->bit_depth - 8);
+    const __m256i x     = _mm256_srl_epi32(index, shift);
+    const __m256i x1    = _mm256_min_epi32(_mm256_add_epi32(x, _mm256_set1_epi32(1)),
+                                        _mm256_set1_epi32(255));
+    const __m256i frac =
+        _mm256_and_si256(index, _mm256_set1_epi32((1 << (p->bit_depth - 8)) - 1));
+    const __m256i s0    = _mm256_i32gather_epi32(p->scaling_lut, x, 4);
+    const __m256i s1    = _mm256_i32gather_epi32(p->scaling_lut, x1, 4);
+    const __m256i delta = _mm256_add_epi32(_mm256_mullo_epi32(_mm256_sub_epi32(s1, s0), frac),
+                                           _mm256_set1_epi32(1 << (p->bit_depth - 9)));
+    return _mm256_add_epi32(s0, _mm256_sra_epi32(delta, shift));
+}
+
+static INLINE __m256i blend_avx2(const FgnBlendParams *p, __m256i sample, __m256i index,
+                                 __m256i grain) {
+    const __m256i noise = _mm256_sra_epi32(
+        _mm256_add_epi32(_mm256_mullo_epi32(scale_lut_avx2(p, index), grain),
+                         _mm256_set1_epi32(1 << (p->scaling_shift - 1))),
+        _mm_cvtsi32_si128(p->scaling_shift));
+    return _mm256_min_epi32(
+        _mm256_max_epi32(_mm256_add_epi32(sample, noise), _mm256_set1_epi32(p->min_value)),
+        _mm256_set1_epi32(p->max_value));
+}
+
+static INLINE __m256i chroma_index_avx2(const FgnBlendParams *p, __m256i average_luma,
+                                        __m256i sample) {
+    const __m256i index = _mm256_add_epi32(
+        _mm256_srai_epi32(
+            _mm256_add_epi32(_mm256_mullo_epi32(average_luma, _mm256_set1_epi32(p->luma_mult)),
+                             _mm256_mullo_epi32(sample, _mm256_set1_epi32(p->mult))),
+            6),
+        _mm256_set1_epi32(p->offset));
+    return _mm256_min_epi32(_mm256_max_epi32(index, _mm256_setzero_si256()),
+                            _mm256_set1_epi32((256 << (p->bit_depth - 8)) - 1));
+}
+
+// 8 samples of 32 bits packed to 16 bits with unsigned saturation
+static INLINE __m128i pack_epi32_avx2(__m256i v) {
+    return _mm_packus_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+}
+
+// Average of 8 pairs of horizontally adjacent 16-bit luma samples
+static INLINE __m256i average_luma_pairs_avx2(__m256i luma16) {
+    const __m256i sum = _mm256_madd_epi16(luma16, _mm256_set1_epi16(1));
+    return _mm256_srli_epi32(_mm256_add_epi32(sum, _mm256_set1_epi32(1)), 1);
+}
+
+void eb_fgn_blend_luma_avx2(uint8_t *luma, int32_t luma_stride, const int32_t *grain,
+                            int32_t grain_stride, int32_t width, int32_t height,
+                            const FgnBlendParams *p) {
+    const int32_t w8 = width & ~7;
+
+    for (int32_t i = 0; i < height; i++) {
+        uint8_t *      l = luma + i * luma_stride;
+        const int32_t *g = grain + i * grain_stride;
+        for (int32_t j = 0; j < w8; j += 8) {
+            const __m256i s = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(l + j)));
+            const __m128i d = pack_epi32_avx2(
+                blend_avx2(p, s, s, _mm256_loadu_si256((const __m256i *)(g + j))));
+            _mm_storel_epi64((__m128i *)(l + j), _mm_packus_epi16(d, d));
+        }
+    }
+
+    if (width > w8)
+        eb_fgn_blend_luma_c(luma + w8,
+                            luma_stride,
+                            grain + w8,
+                            grain_stride,
+                            width - w8,
+                            height,
+                            p);
+}
+
+void eb_fgn_blend_luma_hbd_avx2(uint16_t *luma, int32_t luma_stride, const int32_t *grain,
+                                int32_t grain_stride, int32_t width, int32_t height,
+                                const FgnBlendParams *p) {
+    const int32_t w8 = width & ~7;
+
+    for (int32_t i = 0; i < height; i++) {
+        uint16_t *     l = luma + i * luma_stride;
+        const int32_t *g = grain + i * grain_stride;
+        for (int32_t j = 0; j < w8; j += 8) {
+            const __m256i s = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(l + j)));
+            _mm_storeu_si128(
+                (__m128i *)(l + j),
+                pack_epi32_avx2(
+                    blend_avx2(p, s, s, _mm256_loadu_si256((const __m256i *)(g + j)))));
+        }
+    }
+
+    if (width > w8)
+        eb_fgn_blend_luma_hbd_c(luma + w8,
+                                luma_stride,
+                                grain + w8,
+                                grain_stride,
+                                width - w8,
+                                height,
+                                p);
+}
+
+void eb_fgn_blend_chroma_avx2(uint8_t *chroma, int32_t chroma_stride, const uint8_t *luma,
+                              int32_t luma_stride, const int32_t *grain, int32_t grain_stride,
+                              int32_t width, int32_t height, const FgnBlendParams *p) {
+    const int32_t w8 = width & ~7;
+
+    for (int32_t i = 0; i < height; i++) {
+        const uint8_t *luma_row = luma + (i << p->subsamp_y) * luma_stride;
+        uint8_t *      c        = chroma + i * chroma_stride;
+        const int32_t *g        = grain + i * grain_stride;
+        for (int32_t j = 0; j < w8; j += 8) {
+            __m256i average_luma;
+            if (p->subsamp_x)
+                average_luma = average_luma_pairs_avx2(
+                    _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(luma_row + 2 * j))));
+            else
+                average_luma =
+                    _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(luma_row + j)));
+            const __m256i s = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(c + j)));
+            const __m256i d = blend_avx2(p,
+                                         s,
+                                         chroma_index_avx2(p, average_luma, s),
+                                         _mm256_loadu_si256((const __m256i *)(g + j)));
+            const __m128i d16 = pack_epi32_avx2(d);
+            _mm_storel_epi64((__m128i *)(c + j), _mm_packus_epi16(d16, d16));
+        }
+    }
+
+    if (width > w8)
+        eb_fgn_blend_chroma_c(chroma + w8,
+                              chroma_stride,
+                              luma + (w8 << p->subsamp_x),
+                              luma_stride,
+                              grain + w8,
+                              grain_stride,
+                              width - w8,
+                              height,
+                              p);
+}
+
+void eb_fgn_blend_chroma_hbd_avx2(uint16_t *chroma, int32_t chroma_stride, const uint16_t *luma,
+                                  int32_t luma_stride, const int32_t *grain, int32_t grain_stride,
+                                  int32_t width, int32_t height, const FgnBlendParams *p) {
+    const int32_t w8 = width & ~7;
+
+    for (int32_t i = 0; i < height; i++) {
+        const uint16_t *luma_row = luma + (i << p->subsamp_y) * luma_stride;
+        uint16_t *      c        = chroma + i * chroma_stride;
+        const int32_t * g        = grain + i * grain_stride;
+        for (int32_t j = 0; j < w8; j += 8) {
+            __m256i average_luma;
+            if (p->subsamp_x)
+                average_luma = average_luma_pairs_avx2(
+                    _mm256_loadu_si256((const __m256i *)(luma_row + 2 * j)));
+            else
+                average_luma =
+                    _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(luma_row + j)));
+            const __m256i s = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(c + j)));
+            const __m256i d = blend_avx2(p,
+                                         s,
+                                         chroma_index_avx2(p, average_luma, s),
+                                         _mm256_loadu_si256((const __m256i *)(g + j)));
+            _mm_storeu_si128((__m128i *)(c + j), pack_epi32_avx2(d));
+        }
+    }
+
+    if (width > w8)
+        eb_fgn_blend_chroma_hbd_c(chroma + w8,
+                                  chroma_stride,
+                                  luma + (w8 << p->subsamp_x),
+                                  luma_stride,
+                                  grain + w8,
+                                  grain_stride,
+                                  width - w8,
+                                  height,
+                                  p);
+}
@@ -96,9 +96,10 @@ EbErrorType output_bitstream_rbsp_to_payload(OutputBitstreamUnit *bitstream_ptr,
 /********************************************************************************************************************************/
 /********************************************************************************************************************************/
 // daalaboolwriter.c
-void eb_aom_daala_start_encode(DaalaWriter *br, uint8_t *source) {
-    br->buffer = source;
-    br->pos    = 0;
+void eb_aom_daala_start_encode(DaalaWriter *br, uint8_t *source, uint32_t buffer_size) {
+    br->buffer      = source;
+    br->buffer_size = buffer_size;
+    br->pos         = 0;
     eb_od_ec_enc_init(&br->ec, 62025);
 }
 
@@ -108,6 +109,11 @@ int32_t eb_aom_daala_stop_encode(DaalaWriter *br) {
     uint8_t *daala_data;
     daala_data = eb_od_ec_enc_done(&br->ec, &daala_bytes);
     nb_bits    = eb_od_ec_enc_tell(&br->ec);
+    if (daala_bytes > br->buffer_size) {
+        br->pos = 0;
+        eb_od_ec_enc_clear(&br->ec);
+        return -1;
+    }
     memcpy(br->buffer, daala_data, daala_bytes);
     br->pos = daala_bytes;
     eb_od_ec_enc_clear(&br->ec);
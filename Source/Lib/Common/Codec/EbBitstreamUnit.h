@@ -231,13 +231,15 @@ OD_WARN_UNUSED_RESULT int32_t eb_od_ec_enc_tell(const OdEcEnc *enc) OD_ARG_NONNU
 struct DaalaWriter {
     uint32_t pos;
     uint8_t *buffer;
+    uint32_t buffer_size;
     OdEcEnc  ec;
     uint8_t  allow_update_cdf;
 };
 
 typedef struct DaalaWriter DaalaWriter;
 
-void    eb_aom_daala_start_encode(DaalaWriter *w, uint8_t *buffer);
+void eb_aom_daala_start_encode(DaalaWriter *w, uint8_t *buffer, uint32_t buffer_size);
+// Returns the coded bits, or -1 when they do not fit in the buffer
 int32_t eb_aom_daala_stop_encode(DaalaWriter *w);
 
 static INLINE void aom_daala_write(DaalaWriter *w, int32_t bit, int32_t prob) {
@@ -261,8 +263,8 @@ static INLINE void daala_write_symbol(DaalaWriter *w, int32_t symb, const AomCdf
 // bitwriter.h
 typedef struct DaalaWriter AomWriter;
 
-static INLINE void aom_start_encode(AomWriter *bc, uint8_t *buffer) {
-    eb_aom_daala_start_encode(bc, buffer);
+static INLINE void aom_start_encode(AomWriter *bc, uint8_t *buffer, uint32_t buffer_size) {
+    eb_aom_daala_start_encode(bc, buffer, buffer_size);
 }
 
 static INLINE int32_t aom_stop_encode(AomWriter *bc) { return eb_aom_daala_stop_encode(bc); }
@@ -10,6 +10,12 @@
 #define LOG_TAG "SvtMalloc"
 #include "EbLog.h"
 
+static EB_THREAD_LOCAL size_t mem_meter_bytes;
+
+void eb_mem_meter_add(size_t size) { mem_meter_bytes += size; }
+
+size_t eb_mem_meter_read(void) { return mem_meter_bytes; }
+
 #ifdef DEBUG_MEMORY_USAGE
 
 static EbHandle g_malloc_mutex;
@@ -361,3 +367,199 @@ void eb_decrease_component_count() {
     eb_release_mutex(m);
 #endif
 }
+
+/**************************************
+ * Huge pages
+ **************************************/
+static EB_THREAD_LOCAL EbBool huge_page_enabled;
+
+void eb_huge_page_set_enabled(EbBool enable) { huge_page_enabled = enable; }
+
+EbBool eb_huge_page_get_enabled(void) { return huge_page_enabled; }
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sys/mman.h>
+
+#define HUGE_PAGE_ALIGN(size) (((size) + EB_HUGE_PAGE_SIZE - 1) & ~(size_t)(EB_HUGE_PAGE_SIZE - 1))
+
+// Explicit huge pages are used when rounding the buffer up to whole huge
+// pages wastes less than 1/HUGE_PAGE_MAX_WASTE of it
+#define HUGE_PAGE_MAX_WASTE 8
+
+typedef struct HugePageMapping {
+    void*                   ptr;
+    size_t                  size;
+    EbBool                  hugetlb;
+    struct HugePageMapping* next;
+} HugePageMapping;
+
+static pthread_mutex_t  huge_page_mutex = PTHREAD_MUTEX_INITIALIZER;
+static HugePageMapping* huge_page_mappings;
+static uint64_t         huge_page_hugetlb_bytes;
+static uint64_t         huge_page_thp_bytes;
+static uint64_t         huge_page_fallback_bytes;
+
+EbBool eb_huge_page_supported(void) { return EB_TRUE; }
+
+// Maps size bytes aligned on a huge page and asks for transparent huge pages
+static void* huge_page_map_thp(size_t size) {
+    const size_t map_size = size + EB_HUGE_PAGE_SIZE;
+    uint8_t*     map =
+        (uint8_t*)mmap(NULL, map_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (map == MAP_FAILED) return NULL;
+    // trim the mapping to the aligned range
+    uint8_t* ptr  = (uint8_t*)(((uintptr_t)map + EB_HUGE_PAGE_SIZE - 1) &
+                              ~(uintptr_t)(EB_HUGE_PAGE_SIZE - 1));
+    size_t   head = (size_t)(ptr - map);
+    if (head) munmap(map, head);
+    munmap(ptr + size, map_size - head - size);
+#ifdef MADV_HUGEPAGE
+    madvise(ptr, size, MADV_HUGEPAGE);
+#endif
+    return ptr;
+}
+
+void* eb_huge_page_calloc(size_t size) {
+    if (!huge_page_enabled || size < EB_HUGE_PAGE_SIZE) return NULL;
+
+    HugePageMapping* mapping = (HugePageMapping*)malloc(sizeof(*mapping));
+    if (!mapping) return NULL;
+    // anonymous mappings come zeroed
+    mapping->ptr     = NULL;
+    mapping->hugetlb = EB_FALSE;
+#ifdef MAP_HUGETLB
+    if ((HUGE_PAGE_ALIGN(size) - size) * HUGE_PAGE_MAX_WASTE < size) {
+        mapping->size = HUGE_PAGE_ALIGN(size);
+        void* ptr     = mmap(NULL,
+                         mapping->size,
+                         PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+                         -1,
+                         0);
+        if (ptr != MAP_FAILED) {
+            mapping->ptr     = ptr;
+            mapping->hugetlb = EB_TRUE;
+        }
+    }
+#endif
+    if (!mapping->ptr) {
+        // explicit huge pages not reserved or exhausted
+        mapping->size = (size + 4095) & ~(size_t)4095;
+        mapping->ptr  = huge_page_map_thp(mapping->size);
+    }
+
+    pthread_mutex_lock(&huge_page_mutex);
+    if (mapping->ptr) {
+        if (mapping->hugetlb)
+            huge_page_hugetlb_bytes += mapping->size;
+        else
+            huge_page_thp_bytes += mapping->size;
+        mapping->next      = huge_page_mappings;
+        huge_page_mappings = mapping;
+    } else
+        huge_page_fallback_bytes += size;
+    pthread_mutex_unlock(&huge_page_mutex);
+
+    if (!mapping->ptr) {
+        free(mapping);
+        return NULL;
+    }
+    return mapping->ptr;
+}
+
+EbBool eb_huge_page_free(void* ptr) {
+    HugePageMapping** link;
+    HugePageMapping*  mapping = NULL;
+
+    if (!ptr) return EB_FALSE;
+    pthread_mutex_lock(&huge_page_mutex);
+    for (link = &huge_page_mappings; *link; link = &(*link)->next) {
+        if ((*link)->ptr == ptr) {
+            mapping = *link;
+            *link   = mapping->next;
+            if (mapping->hugetlb)
+                huge_page_hugetlb_bytes -= mapping->size;
+            else
+                huge_page_thp_bytes -= mapping->size;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&huge_page_mutex);
+    if (!mapping) return EB_FALSE;
+
+    munmap(mapping->ptr, mapping->size);
+    free(mapping);
+    return EB_TRUE;
+}
+
+// Bytes of the transparent huge page mappings the kernel actually backs
+// with huge pages, summed from the AnonHugePages of their VMAs
+static uint64_t huge_page_thp_backed_bytes(void) {
+    uint64_t backed = 0;
+    char     line[256];
+    EbBool   ours   = EB_FALSE;
+    FILE*    smaps  = fopen("/proc/self/smaps", "r");
+    if (!smaps) return 0;
+    while (fgets(line, sizeof(line), smaps)) {
+        unsigned long start, end, kb;
+        if (sscanf(line, "%lx-%lx ", &start, &end) == 2) {
+            ours = EB_FALSE;
+            for (HugePageMapping* m = huge_page_mappings; m; m = m->next) {
+                if (!m->hugetlb && (uintptr_t)m->ptr <= start &&
+                    start < (uintptr_t)m->ptr + m->size) {
+                    ours = EB_TRUE;
+                    break;
+                }
+            }
+        } else if (ours && sscanf(line, "AnonHugePages: %lu kB", &kb) == 1)
+            backed += (uint64_t)kb << 10;
+    }
+    fclose(smaps);
+    return backed;
+}
+
+uint64_t eb_huge_page_backed_bytes(void) {
+    pthread_mutex_lock(&huge_page_mutex);
+    const uint64_t backed = huge_page_hugetlb_bytes + huge_page_thp_backed_bytes();
+    pthread_mutex_unlock(&huge_page_mutex);
+    return backed;
+}
+
+void eb_print_huge_page_usage(void) {
+    pthread_mutex_lock(&huge_page_mutex);
+    const uint64_t thp_backed = huge_page_thp_backed_bytes();
+    const uint64_t total      = huge_page_hugetlb_bytes + huge_page_thp_bytes;
+    SVT_INFO("SVT Huge Page Usage:\r\n");
+    SVT_INFO("    huge page backed:             %.2lf MB of %.2lf MB\r\n",
+             (double)(huge_page_hugetlb_bytes + thp_backed) / (1 << 20),
+             (double)total / (1 << 20));
+    SVT_INFO("        explicit huge pages:      %.2lf MB\r\n",
+             (double)huge_page_hugetlb_bytes / (1 << 20));
+    SVT_INFO("        transparent huge pages:   %.2lf MB of %.2lf MB advised\r\n",
+             (double)thp_backed / (1 << 20),
+             (double)huge_page_thp_bytes / (1 << 20));
+    SVT_INFO("    regular pages (map failed):   %.2lf MB\r\n",
+             (double)huge_page_fallback_bytes / (1 << 20));
+    pthread_mutex_unlock(&huge_page_mutex);
+}
+
+#else
+
+EbBool eb_huge_page_supported(void) { return EB_FALSE; }
+
+void* eb_huge_page_calloc(size_t size) {
+    (void)size;
+    return NULL;
+}
+
+EbBool eb_huge_page_free(void* ptr) {
+    (void)ptr;
+    return EB_FALSE;
+}
+
+uint64_t eb_huge_page_backed_bytes(void) { return 0; }
+
+void eb_print_huge_page_usage(void) {}
+
+#endif // __linux__
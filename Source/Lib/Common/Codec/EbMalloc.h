@@ -9,6 +9,11 @@
 
 #include "EbSvtAv1Enc.h"
 #include "EbDefinitions.h"
+#include "EbNuma.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
 
 #ifndef NDEBUG
 #define DEBUG_MEMORY_USAGE
@@ -29,12 +34,19 @@ void eb_remove_mem_entry(void* ptr, EbPtrType type);
 
 #endif //DEBUG_MEMORY_USAGE
 
+/* Per-thread count of the bytes allocated through the EB_*ALLOC* macros.
+ * Diff two reads around a constructor to get the size of the object. */
+void   eb_mem_meter_add(size_t size);
+size_t eb_mem_meter_read(void);
+
 #define EB_NO_THROW_ADD_MEM(p, size, type)                                               \
     do {                                                                                 \
         if (!p) {                                                                        \
             fprintf(stderr, "allocate memory failed, at %s, L%d\n", __FILE__, __LINE__); \
         } else {                                                                         \
             EB_ADD_MEM_ENTRY(p, type, size);                                             \
+            eb_mem_meter_add(size);                                                      \
+            eb_numa_place(p, size);                                                      \
         }                                                                                \
     } while (0)
 
@@ -172,8 +184,51 @@ void eb_remove_mem_entry(void* ptr, EbPtrType type);
 
 #define EB_FREE_ALIGNED_ARRAY(pa) EB_FREE_ALIGNED(pa)
 
+/* Huge page backed allocation of picture sized buffers. While enabled on
+ * the calling thread, eb_huge_page_calloc() maps buffers of at least
+ * EB_HUGE_PAGE_SIZE bytes on explicit huge pages (MAP_HUGETLB) when the
+ * system has some reserved, or on huge page aligned memory advised for
+ * transparent huge pages otherwise. It returns NULL when disabled, for
+ * smaller buffers, on other systems than Linux or when the mapping
+ * fails, the caller then falls back to regular pages. */
+#define EB_HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
+void     eb_huge_page_set_enabled(EbBool enable);
+EbBool   eb_huge_page_get_enabled(void);
+EbBool   eb_huge_page_supported(void);
+void*    eb_huge_page_calloc(size_t size);
+// Returns EB_FALSE when ptr was not allocated by eb_huge_page_calloc()
+EbBool   eb_huge_page_free(void* ptr);
+// Bytes of the live huge page allocations the kernel backs with huge pages
+uint64_t eb_huge_page_backed_bytes(void);
+void     eb_print_huge_page_usage(void);
+
+#define EB_CALLOC_PICTURE_ARRAY(pa, count)             \
+    do {                                               \
+        size_t size = sizeof(*(pa)) * (count);         \
+        void*  p    = eb_huge_page_calloc(size);       \
+        if (p) {                                       \
+            EB_ADD_MEM(p, size, EB_A_PTR);             \
+            *(void**)&(pa) = p;                        \
+        } else                                         \
+            EB_CALLOC_ALIGNED_ARRAY(pa, count);        \
+    } while (0)
+
+#define EB_FREE_PICTURE_ARRAY(pa)                      \
+    do {                                               \
+        if (eb_huge_page_free(pa)) {                   \
+            EB_REMOVE_MEM_ENTRY(pa, EB_A_PTR);         \
+            pa = NULL;                                 \
+        } else                                         \
+            EB_FREE_ALIGNED_ARRAY(pa);                 \
+    } while (0)
+
 void eb_print_memory_usage();
 void eb_increase_component_count();
 void eb_decrease_component_count();
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif //EbMalloc_h
@@ -0,0 +1,212 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+#ifdef __linux__
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "EbNuma.h"
+#include "EbThreads.h"
+#define LOG_TAG "SvtNuma"
+#include "EbLog.h"
+
+static EB_THREAD_LOCAL int32_t      alloc_node = EB_NUMA_NODE_ANY;
+static EB_THREAD_LOCAL EbNumaStats *alloc_stats;
+
+#ifdef __linux__
+
+#define NUMA_MAX_CPUS 1024
+
+static const char *numa_stat_names[EB_NUMA_STAT_COUNT] = {"numa_miss", "numa_foreign", "other_node"};
+
+static pthread_once_t numa_once = PTHREAD_ONCE_INIT;
+static uint32_t       numa_nodes = 1;
+static int8_t         cpu_node[NUMA_MAX_CPUS];
+static cpu_set_t      node_cpus[EB_NUMA_MAX_NODES];
+static unsigned long  page_size;
+
+// Parses a sysfs cpu list such as "0-7,16-23"
+static void parse_cpu_list(const char *list, int32_t node) {
+    const char *p = list;
+    while (*p >= '0' && *p <= '9') {
+        char *end;
+        long  first = strtol(p, &end, 10);
+        long  last  = first;
+        if (*end == '-') last = strtol(end + 1, &end, 10);
+        for (long cpu = first; cpu <= last && cpu < NUMA_MAX_CPUS; cpu++) {
+            cpu_node[cpu] = (int8_t)node;
+            CPU_SET(cpu, &node_cpus[node]);
+        }
+        p = *end == ',' ? end + 1 : end;
+    }
+}
+
+static void read_numa_stats(uint32_t node, uint64_t stats[EB_NUMA_STAT_COUNT]) {
+    char path[64];
+    char line[128];
+    memset(stats, 0, EB_NUMA_STAT_COUNT * sizeof(stats[0]));
+    snprintf(path, sizeof(path), "/sys/devices/system/node/node%u/numastat", node);
+    FILE *fin = fopen(path, "r");
+    if (!fin) return;
+    while (fgets(line, sizeof(line), fin)) {
+        for (int i = 0; i < EB_NUMA_STAT_COUNT; i++) {
+            size_t len = strlen(numa_stat_names[i]);
+            if (!strncmp(line, numa_stat_names[i], len) && line[len] == ' ')
+                stats[i] = strtoull(line + len, NULL, 10);
+        }
+    }
+    fclose(fin);
+}
+
+static void numa_read_topology(void) {
+    char path[64];
+    char list[4096];
+    page_size = (unsigned long)sysconf(_SC_PAGESIZE);
+    memset(cpu_node, 0, sizeof(cpu_node));
+    // nodes are numbered contiguously from 0, stop at the first gap
+    uint32_t nodes = 0;
+    for (uint32_t node = 0; node < EB_NUMA_MAX_NODES; node++) {
+        snprintf(path, sizeof(path), "/sys/devices/system/node/node%u/cpulist", node);
+        FILE *fin = fopen(path, "r");
+        if (!fin) break;
+        CPU_ZERO(&node_cpus[node]);
+        if (fgets(list, sizeof(list), fin)) parse_cpu_list(list, (int32_t)node);
+        fclose(fin);
+        nodes++;
+    }
+    numa_nodes = nodes ? nodes : 1;
+}
+
+uint32_t eb_numa_init(void) {
+    pthread_once(&numa_once, numa_read_topology);
+    return numa_nodes;
+}
+
+uint32_t eb_numa_node_count(void) { return eb_numa_init(); }
+
+int32_t eb_numa_current_node(void) {
+    int cpu = sched_getcpu();
+    if (cpu < 0 || cpu >= NUMA_MAX_CPUS) return 0;
+    return cpu_node[cpu];
+}
+
+void eb_numa_bind_thread(EbHandle thread_handle, int32_t node) {
+    if (!thread_handle || node < 0 || (uint32_t)node >= eb_numa_init() ||
+        !CPU_COUNT(&node_cpus[node]))
+        return;
+    pthread_setaffinity_np(*((pthread_t *)thread_handle), sizeof(cpu_set_t), &node_cpus[node]);
+}
+
+void eb_numa_place(void *ptr, size_t size) {
+    const int32_t node  = alloc_node;
+    EbNumaStats * stats = alloc_stats;
+    if (node < 0 || size < EB_NUMA_MIN_PLACE_SIZE || numa_nodes < 2) return;
+    // only the pages that belong to this allocation alone
+    uintptr_t begin = ((uintptr_t)ptr + page_size - 1) & ~(uintptr_t)(page_size - 1);
+    uintptr_t end   = ((uintptr_t)ptr + size) & ~(uintptr_t)(page_size - 1);
+    if (end <= begin) return;
+    unsigned long mask[EB_NUMA_MAX_NODES / (8 * sizeof(unsigned long))] = {0};
+    mask[node / (8 * sizeof(unsigned long))] = 1UL << (node % (8 * sizeof(unsigned long)));
+    if (!syscall(__NR_mbind,
+                 (void *)begin,
+                 (unsigned long)(end - begin),
+                 MPOL_PREFERRED,
+                 mask,
+                 (unsigned long)EB_NUMA_MAX_NODES + 1,
+                 MPOL_MF_MOVE) &&
+        stats)
+        eb_atomic_fetch_add64(&stats->placed_bytes[node], (int64_t)(end - begin));
+}
+
+void eb_numa_reset_stats(EbNumaStats *stats) {
+    for (uint32_t node = 0; node < eb_numa_init(); node++)
+        read_numa_stats(node, stats->numa_stat_start[node]);
+    stats->local_tasks  = 0;
+    stats->remote_tasks = 0;
+}
+
+void eb_numa_count_task(EbNumaStats *stats, int32_t data_node) {
+    if (data_node < 0 || numa_nodes < 2) return;
+    if (eb_numa_current_node() == data_node)
+        eb_atomic_fetch_add64(&stats->local_tasks, 1);
+    else
+        eb_atomic_fetch_add64(&stats->remote_tasks, 1);
+}
+
+void eb_numa_print_stats(const EbNumaStats *stats) {
+    if (eb_numa_init() < 2) return;
+    SVT_INFO("NUMA placement over %u nodes\n", numa_nodes);
+    for (uint32_t node = 0; node < numa_nodes; node++) {
+        uint64_t node_stats[EB_NUMA_STAT_COUNT];
+        read_numa_stats(node, node_stats);
+        SVT_INFO("node %u: %8.2f MB placed, %" PRIu64 " numa_miss, %" PRIu64
+                 " numa_foreign, %" PRIu64 " other_node\n",
+                 node,
+                 (double)stats->placed_bytes[node] / (1024 * 1024),
+                 node_stats[0] - stats->numa_stat_start[node][0],
+                 node_stats[1] - stats->numa_stat_start[node][1],
+                 node_stats[2] - stats->numa_stat_start[node][2]);
+    }
+    const int64_t tasks = stats->local_tasks + stats->remote_tasks;
+    if (tasks)
+        SVT_INFO("EncDec tasks on the node of their picture: %" PRId64 " of %" PRId64
+                 " (%.1f%%)\n",
+                 stats->local_tasks,
+                 tasks,
+                 100.0 * stats->local_tasks / tasks);
+}
+
+#else
+
+uint32_t eb_numa_init(void) { return 1; }
+
+uint32_t eb_numa_node_count(void) { return 1; }
+
+int32_t eb_numa_current_node(void) { return 0; }
+
+void eb_numa_bind_thread(EbHandle thread_handle, int32_t node) {
+    (void)thread_handle;
+    (void)node;
+}
+
+void eb_numa_place(void *ptr, size_t size) {
+    (void)ptr;
+    (void)size;
+}
+
+void eb_numa_reset_stats(EbNumaStats *stats) { (void)stats; }
+
+void eb_numa_count_task(EbNumaStats *stats, int32_t data_node) {
+    (void)stats;
+    (void)data_node;
+}
+
+void eb_numa_print_stats(const EbNumaStats *stats) { (void)stats; }
+
+#endif // __linux__
+
+int32_t eb_numa_spread_node(uint32_t index, uint32_t count) {
+    const uint32_t nodes = eb_numa_node_count();
+    if (nodes < 2 || !count) return 0;
+    return (int32_t)((uint64_t)index * nodes / count);
+}
+
+void eb_numa_set_alloc_node(int32_t node) { alloc_node = node; }
+
+int32_t eb_numa_get_alloc_node(void) { return alloc_node; }
+
+void eb_numa_set_alloc_stats(EbNumaStats *stats) { alloc_stats = stats; }
+
+EbNumaStats *eb_numa_get_alloc_stats(void) { return alloc_stats; }
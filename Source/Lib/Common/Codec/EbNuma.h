@@ -0,0 +1,75 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifndef EbNuma_h
+#define EbNuma_h
+
+#include <stddef.h>
+#include "EbDefinitions.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**************************************
+ * NUMA placement
+ *   Node topology, binding of threads to the cpus of a node and
+ *   placement of allocations on a node. Linux only: elsewhere, or
+ *   when the topology cannot be read, there is a single node and the
+ *   functions do nothing. The topology is process wide, the allocation
+ *   node and statistics are set per thread.
+ **************************************/
+#define EB_NUMA_MAX_NODES 64
+#define EB_NUMA_NODE_ANY -1
+// Allocations below this size are left to first touch, they share
+// pages with their neighbours
+#define EB_NUMA_MIN_PLACE_SIZE (64 * 1024)
+#define EB_NUMA_STAT_COUNT 3
+
+/**************************************
+ * NUMA statistics
+ *   Placement and task traffic of one encoder. The numastat counters
+ *   of the nodes are system wide, only their difference since
+ *   eb_numa_reset_stats() is reported.
+ **************************************/
+typedef struct EbNumaStats {
+    volatile int64_t placed_bytes[EB_NUMA_MAX_NODES];
+    volatile int64_t local_tasks;
+    volatile int64_t remote_tasks;
+    uint64_t         numa_stat_start[EB_NUMA_MAX_NODES][EB_NUMA_STAT_COUNT];
+} EbNumaStats;
+
+// Reads the node topology once, returns the number of nodes
+extern uint32_t eb_numa_init(void);
+extern uint32_t eb_numa_node_count(void);
+// Node of thread index out of count when the threads are spread in
+// contiguous blocks over the nodes
+extern int32_t eb_numa_spread_node(uint32_t index, uint32_t count);
+// Node of the cpu the calling thread runs on
+extern int32_t eb_numa_current_node(void);
+// Restricts a thread created with EB_CREATE_THREAD to the cpus of node
+extern void eb_numa_bind_thread(EbHandle thread_handle, int32_t node);
+
+// Node the EB_*ALLOC* macros of the calling thread place their large
+// allocations on, EB_NUMA_NODE_ANY to leave them to first touch
+extern void    eb_numa_set_alloc_node(int32_t node);
+extern int32_t eb_numa_get_alloc_node(void);
+// Statistics the placements of the calling thread are accounted in,
+// NULL for none
+extern void         eb_numa_set_alloc_stats(EbNumaStats *stats);
+extern EbNumaStats *eb_numa_get_alloc_stats(void);
+// Called by the EB_*ALLOC* macros on each allocation
+extern void eb_numa_place(void *ptr, size_t size);
+
+// Accounts one task of the calling thread on data placed on data_node
+extern void eb_numa_count_task(EbNumaStats *stats, int32_t data_node);
+// Starts the traffic statistics, eb_numa_print_stats() reports them
+extern void eb_numa_reset_stats(EbNumaStats *stats);
+extern void eb_numa_print_stats(const EbNumaStats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbNuma_h
@@ -21,16 +21,16 @@
 static void eb_picture_buffer_desc_dctor(EbPtr p) {
     EbPictureBufferDesc *obj = (EbPictureBufferDesc *)p;
     if (obj->buffer_enable_mask & PICTURE_BUFFER_DESC_Y_FLAG) {
-        EB_FREE_ALIGNED_ARRAY(obj->buffer_y);
-        EB_FREE_ALIGNED_ARRAY(obj->buffer_bit_inc_y);
+        EB_FREE_PICTURE_ARRAY(obj->buffer_y);
+        EB_FREE_PICTURE_ARRAY(obj->buffer_bit_inc_y);
     }
     if (obj->buffer_enable_mask & PICTURE_BUFFER_DESC_Cb_FLAG) {
-        EB_FREE_ALIGNED_ARRAY(obj->buffer_cb);
-        EB_FREE_ALIGNED_ARRAY(obj->buffer_bit_inc_cb);
+        EB_FREE_PICTURE_ARRAY(obj->buffer_cb);
+        EB_FREE_PICTURE_ARRAY(obj->buffer_bit_inc_cb);
     }
     if (obj->buffer_enable_mask & PICTURE_BUFFER_DESC_Cb_FLAG) {
-        EB_FREE_ALIGNED_ARRAY(obj->buffer_cr);
-        EB_FREE_ALIGNED_ARRAY(obj->buffer_bit_inc_cr);
+        EB_FREE_PICTURE_ARRAY(obj->buffer_cr);
+        EB_FREE_PICTURE_ARRAY(obj->buffer_bit_inc_cr);
     }
 }
 
@@ -95,31 +95,31 @@ EbErrorType eb_picture_buffer_desc_ctor(EbPictureBufferDesc *pictureBufferDescPt
 
     // Allocate the Picture Buffers (luma & chroma)
     if (picture_buffer_desc_init_data_ptr->buffer_enable_mask & PICTURE_BUFFER_DESC_Y_FLAG) {
-        EB_CALLOC_ALIGNED_ARRAY(pictureBufferDescPtr->buffer_y,
+        EB_CALLOC_PICTURE_ARRAY(pictureBufferDescPtr->buffer_y,
                                 pictureBufferDescPtr->luma_size * bytes_per_pixel);
         pictureBufferDescPtr->buffer_bit_inc_y = 0;
         if (picture_buffer_desc_init_data_ptr->split_mode == EB_TRUE) {
-            EB_CALLOC_ALIGNED_ARRAY(pictureBufferDescPtr->buffer_bit_inc_y,
+            EB_CALLOC_PICTURE_ARRAY(pictureBufferDescPtr->buffer_bit_inc_y,
                                     pictureBufferDescPtr->luma_size * bytes_per_pixel);
         }
     }
 
     if (picture_buffer_desc_init_data_ptr->buffer_enable_mask & PICTURE_BUFFER_DESC_Cb_FLAG) {
-        EB_CALLOC_ALIGNED_ARRAY(pictureBufferDescPtr->buffer_cb,
+        EB_CALLOC_PICTURE_ARRAY(pictureBufferDescPtr->buffer_cb,
                                 pictureBufferDescPtr->chroma_size * bytes_per_pixel);
         pictureBufferDescPtr->buffer_bit_inc_cb = 0;
         if (picture_buffer_desc_init_data_ptr->split_mode == EB_TRUE) {
-            EB_CALLOC_ALIGNED_ARRAY(pictureBufferDescPtr->buffer_bit_inc_cb,
+            EB_CALLOC_PICTURE_ARRAY(pictureBufferDescPtr->buffer_bit_inc_cb,
                                     pictureBufferDescPtr->chroma_size * bytes_per_pixel);
         }
     }
 
     if (picture_buffer_desc_init_data_ptr->buffer_enable_mask & PICTURE_BUFFER_DESC_Cr_FLAG) {
-        EB_CALLOC_ALIGNED_ARRAY(pictureBufferDescPtr->buffer_cr,
+        EB_CALLOC_PICTURE_ARRAY(pictureBufferDescPtr->buffer_cr,
                                 pictureBufferDescPtr->chroma_size * bytes_per_pixel);
         pictureBufferDescPtr->buffer_bit_inc_cr = 0;
         if (picture_buffer_desc_init_data_ptr->split_mode == EB_TRUE) {
-            EB_CALLOC_ALIGNED_ARRAY(pictureBufferDescPtr->buffer_bit_inc_cr,
+            EB_CALLOC_PICTURE_ARRAY(pictureBufferDescPtr->buffer_bit_inc_cr,
                                     pictureBufferDescPtr->chroma_size * bytes_per_pixel);
         }
     }
@@ -127,13 +127,37 @@ EbErrorType eb_picture_buffer_desc_ctor(EbPictureBufferDesc *pictureBufferDescPt
     return EB_ErrorNone;
 }
 
+/*****************************************
+ * eb_picture_buffer_desc_own_planes
+ *  Copies the 8-bit planes the descriptor points at into planes
+ *  of its own, freed with the descriptor. Does nothing when the
+ *  descriptor already owns its planes.
+ *****************************************/
+EbErrorType eb_picture_buffer_desc_own_planes(EbPictureBufferDesc *pic_ptr) {
+    EbByte buffer_y, buffer_cb, buffer_cr;
+
+    if (pic_ptr->buffer_enable_mask) return EB_ErrorNone;
+    EB_CALLOC_PICTURE_ARRAY(buffer_y, pic_ptr->luma_size);
+    EB_CALLOC_PICTURE_ARRAY(buffer_cb, pic_ptr->chroma_size);
+    EB_CALLOC_PICTURE_ARRAY(buffer_cr, pic_ptr->chroma_size);
+    eb_memcpy(buffer_y, pic_ptr->buffer_y, pic_ptr->luma_size);
+    eb_memcpy(buffer_cb, pic_ptr->buffer_cb, pic_ptr->chroma_size);
+    eb_memcpy(buffer_cr, pic_ptr->buffer_cr, pic_ptr->chroma_size);
+    pic_ptr->buffer_y           = buffer_y;
+    pic_ptr->buffer_cb          = buffer_cb;
+    pic_ptr->buffer_cr          = buffer_cr;
+    pic_ptr->buffer_enable_mask = PICTURE_BUFFER_DESC_FULL_MASK;
+
+    return EB_ErrorNone;
+}
+
 void eb_recon_picture_buffer_desc_dctor(EbPtr p) {
     EbPictureBufferDesc *obj = (EbPictureBufferDesc *)p;
-    if (obj->buffer_enable_mask & PICTURE_BUFFER_DESC_Y_FLAG) EB_FREE_ALIGNED_ARRAY(obj->buffer_y);
+    if (obj->buffer_enable_mask & PICTURE_BUFFER_DESC_Y_FLAG) EB_FREE_PICTURE_ARRAY(obj->buffer_y);
     if (obj->buffer_enable_mask & PICTURE_BUFFER_DESC_Cb_FLAG)
-        EB_FREE_ALIGNED_ARRAY(obj->buffer_cb);
+        EB_FREE_PICTURE_ARRAY(obj->buffer_cb);
     if (obj->buffer_enable_mask & PICTURE_BUFFER_DESC_Cb_FLAG)
-        EB_FREE_ALIGNED_ARRAY(obj->buffer_cr);
+        EB_FREE_PICTURE_ARRAY(obj->buffer_cr);
 }
 /*****************************************
  * eb_recon_picture_buffer_desc_ctor
@@ -181,15 +205,15 @@ EbErrorType eb_recon_picture_buffer_desc_ctor(EbPictureBufferDesc *pictureBuffer
 
     // Allocate the Picture Buffers (luma & chroma)
     if (picture_buffer_desc_init_data_ptr->buffer_enable_mask & PICTURE_BUFFER_DESC_Y_FLAG) {
-        EB_CALLOC_ALIGNED_ARRAY(pictureBufferDescPtr->buffer_y,
+        EB_CALLOC_PICTURE_ARRAY(pictureBufferDescPtr->buffer_y,
                                 pictureBufferDescPtr->luma_size * bytes_per_pixel);
     }
     if (picture_buffer_desc_init_data_ptr->buffer_enable_mask & PICTURE_BUFFER_DESC_Cb_FLAG) {
-        EB_CALLOC_ALIGNED_ARRAY(pictureBufferDescPtr->buffer_cb,
+        EB_CALLOC_PICTURE_ARRAY(pictureBufferDescPtr->buffer_cb,
                                 pictureBufferDescPtr->chroma_size * bytes_per_pixel);
     }
     if (picture_buffer_desc_init_data_ptr->buffer_enable_mask & PICTURE_BUFFER_DESC_Cr_FLAG) {
-        EB_CALLOC_ALIGNED_ARRAY(pictureBufferDescPtr->buffer_cr,
+        EB_CALLOC_PICTURE_ARRAY(pictureBufferDescPtr->buffer_cr,
                                 pictureBufferDescPtr->chroma_size * bytes_per_pixel);
     }
     return EB_ErrorNone;
@@ -293,6 +293,9 @@ extern EbErrorType eb_picture_buffer_desc_ctor(EbPictureBufferDesc *object_ptr,
 extern EbErrorType eb_recon_picture_buffer_desc_ctor(EbPictureBufferDesc *object_ptr,
                                                      EbPtr                object_init_data_ptr);
 
+// Copies the planes of a descriptor pointing at 8-bit planes it does not own
+extern EbErrorType eb_picture_buffer_desc_own_planes(EbPictureBufferDesc *pic_ptr);
+
 #ifdef __cplusplus
 }
 #endif
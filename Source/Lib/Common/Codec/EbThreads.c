@@ -25,6 +25,7 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <pthread.h>
+#include <sched.h>
 #include <semaphore.h>
 #include <unistd.h>
 #endif // _WIN32
@@ -286,12 +287,19 @@ EbHandle eb_create_mutex(void) {
     return mutex_handle;
 }
 
+// Mutexes the current thread holds
+static EB_THREAD_LOCAL uint32_t mutex_held_count;
+
+uint32_t eb_mutex_held_count(void) { return mutex_held_count; }
+
 /***************************************
  * EbPostMutex
  ***************************************/
 EbErrorType eb_release_mutex(EbHandle mutex_handle) {
     EbErrorType return_error = EB_ErrorNone;
 
+    mutex_held_count--;
+
 #ifdef _WIN32
     return_error = !ReleaseMutex((HANDLE)mutex_handle) ? EB_ErrorCreateMutexFailed : EB_ErrorNone;
 #else
@@ -315,6 +323,7 @@ EbErrorType eb_block_on_mutex(EbHandle mutex_handle) {
     return_error = pthread_mutex_lock((pthread_mutex_t *)mutex_handle) ? EB_ErrorMutexUnresponsive
                                                                        : EB_ErrorNone;
 #endif // _WIN32
+    if (return_error == EB_ErrorNone) mutex_held_count++;
 
     return return_error;
 }
@@ -332,6 +341,7 @@ EbErrorType eb_block_on_mutex_timeout(EbHandle mutex_handle, uint32_t timeout) {
                                                                        : EB_ErrorNone;
     (void)timeout;
 #endif // _WIN32
+    if (return_error == EB_ErrorNone) mutex_held_count++;
 
     return return_error;
 }
@@ -353,3 +363,28 @@ EbErrorType eb_destroy_mutex(EbHandle mutex_handle) {
 
     return return_error;
 }
+
+/***************************************
+ * eb_yield_thread
+ ***************************************/
+void eb_yield_thread(void) {
+#ifdef _WIN32
+    SwitchToThread();
+#else
+    sched_yield();
+#endif // _WIN32
+}
+
+/***************************************
+ * eb_get_num_online_processors
+ ***************************************/
+uint32_t eb_get_num_online_processors(void) {
+#ifdef _WIN32
+    SYSTEM_INFO sysinfo;
+    GetSystemInfo(&sysinfo);
+    return sysinfo.dwNumberOfProcessors;
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (uint32_t)count : 1;
+#endif // _WIN32
+}
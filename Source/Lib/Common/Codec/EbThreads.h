@@ -54,6 +54,109 @@ extern EbErrorType eb_block_on_mutex_timeout(EbHandle mutex_handle, uint32_t tim
 
 extern EbErrorType eb_destroy_mutex(EbHandle mutex_handle);
 
+// Number of mutexes the calling thread holds
+extern uint32_t eb_mutex_held_count(void);
+
+/**************************************
+     * Scheduling
+     **************************************/
+extern void eb_yield_thread(void);
+
+extern uint32_t eb_get_num_online_processors(void);
+
+/**************************************
+     * Atomics
+     *   Sequentially consistent read-modify-write, acquire load and
+     *   release store on 32-bit words, 64-bit add and acquire load for
+     *   counters, plus a spin-wait hint.
+     **************************************/
+#ifdef _WIN32
+#define EB_THREAD_LOCAL __declspec(thread)
+
+static INLINE int32_t eb_atomic_fetch_add32(volatile int32_t *ptr, int32_t value) {
+    return (int32_t)InterlockedExchangeAdd((volatile LONG *)ptr, (LONG)value);
+}
+
+static INLINE int64_t eb_atomic_fetch_add64(volatile int64_t *ptr, int64_t value) {
+    return (int64_t)InterlockedExchangeAdd64((volatile LONG64 *)ptr, (LONG64)value);
+}
+
+static INLINE EbBool eb_atomic_cas32(volatile int32_t *ptr, int32_t expected, int32_t desired) {
+    return InterlockedCompareExchange((volatile LONG *)ptr, (LONG)desired, (LONG)expected) ==
+                   (LONG)expected
+               ? EB_TRUE
+               : EB_FALSE;
+}
+
+static INLINE int32_t eb_atomic_load32(volatile int32_t *ptr) {
+    int32_t value = *ptr;
+    _ReadWriteBarrier();
+    return value;
+}
+
+static INLINE void eb_atomic_store32(volatile int32_t *ptr, int32_t value) {
+    _ReadWriteBarrier();
+    *ptr = value;
+}
+
+static INLINE int64_t eb_atomic_load64(volatile int64_t *ptr) {
+    // A plain 64-bit read may tear on 32-bit targets
+    return (int64_t)InterlockedCompareExchange64((volatile LONG64 *)ptr, 0, 0);
+}
+
+static INLINE void eb_cpu_pause(void) { YieldProcessor(); }
+#else
+#define EB_THREAD_LOCAL __thread
+
+static INLINE int32_t eb_atomic_fetch_add32(volatile int32_t *ptr, int32_t value) {
+    return __atomic_fetch_add(ptr, value, __ATOMIC_SEQ_CST);
+}
+
+static INLINE int64_t eb_atomic_fetch_add64(volatile int64_t *ptr, int64_t value) {
+    return __atomic_fetch_add(ptr, value, __ATOMIC_SEQ_CST);
+}
+
+static INLINE EbBool eb_atomic_cas32(volatile int32_t *ptr, int32_t expected, int32_t desired) {
+    return __atomic_compare_exchange_n(
+               ptr, &expected, desired, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)
+               ? EB_TRUE
+               : EB_FALSE;
+}
+
+static INLINE int32_t eb_atomic_load32(volatile int32_t *ptr) {
+    return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+}
+
+static INLINE void eb_atomic_store32(volatile int32_t *ptr, int32_t value) {
+    __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+}
+
+static INLINE int64_t eb_atomic_load64(volatile int64_t *ptr) {
+    return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+}
+
+static INLINE void eb_cpu_pause(void) {
+#if defined(__i386__) || defined(__x86_64__)
+    __builtin_ia32_pause();
+#endif
+}
+#endif
+
+/**************************************
+     * Spin-Wait Backoff
+     *   One round of a spin wait on a flag another thread sets: pauses the
+     *   first EB_SPIN_YIELD_COUNT rounds, then gives the core away. spin
+     *   counts the rounds, start it at 0.
+     **************************************/
+#define EB_SPIN_YIELD_COUNT 64
+
+static INLINE void eb_spin_backoff(int32_t *spin) {
+    if (++*spin < EB_SPIN_YIELD_COUNT)
+        eb_cpu_pause();
+    else
+        eb_yield_thread();
+}
+
 extern EbMemoryMapEntry *memory_map; // library Memory table
 extern uint32_t *        memory_map_index; // library memory index
 extern uint64_t *        total_lib_memory; // library Memory malloc'd
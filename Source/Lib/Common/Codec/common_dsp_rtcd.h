@@ -0,0 +1,133 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifndef COMMON_DSP_RTCD_H_
+#define COMMON_DSP_RTCD_H_
+
+#include "EbDefinitions.h"
+
+/*
+ * DSP deprecated flags
+ */
+#define HAS_MMX CPU_FLAGS_MMX
+#define HAS_SSE CPU_FLAGS_SSE
+#define HAS_SSE2 CPU_FLAGS_SSE2
+#define HAS_SSE3 CPU_FLAGS_SSE3
+#define HAS_SSSE3 CPU_FLAGS_SSSE3
+#define HAS_SSE4_1 CPU_FLAGS_SSE4_1
+#define HAS_SSE4_2 CPU_FLAGS_SSE4_2
+#define HAS_AVX CPU_FLAGS_AVX
+#define HAS_AVX2 CPU_FLAGS_AVX2
+#define HAS_AVX512F CPU_FLAGS_AVX512F
+#define HAS_AVX512CD CPU_FLAGS_AVX512CD
+#define HAS_AVX512DQ CPU_FLAGS_AVX512DQ
+#define HAS_AVX512ER CPU_FLAGS_AVX512ER
+#define HAS_AVX512PF CPU_FLAGS_AVX512PF
+#define HAS_AVX512BW CPU_FLAGS_AVX512BW
+#define HAS_AVX512VL CPU_FLAGS_AVX512VL
+
+#ifndef NON_AVX512_SUPPORT
+#define SET_FUNCTIONS(ptr, c, mmx, sse, sse2, sse3, ssse3, sse4_1, sse4_2, avx, avx2, avx512) \
+    do {                                                                                      \
+        ptr = c;                                                                              \
+        if (((uintptr_t)NULL != (uintptr_t)mmx) && (flags & HAS_MMX)) ptr = mmx;              \
+        if (((uintptr_t)NULL != (uintptr_t)sse) && (flags & HAS_SSE)) ptr = sse;              \
+        if (((uintptr_t)NULL != (uintptr_t)sse2) && (flags & HAS_SSE2)) ptr = sse2;           \
+        if (((uintptr_t)NULL != (uintptr_t)sse3) && (flags & HAS_SSE3)) ptr = sse3;           \
+        if (((uintptr_t)NULL != (uintptr_t)ssse3) && (flags & HAS_SSSE3)) ptr = ssse3;        \
+        if (((uintptr_t)NULL != (uintptr_t)sse4_1) && (flags & HAS_SSE4_1)) ptr = sse4_1;     \
+        if (((uintptr_t)NULL != (uintptr_t)sse4_2) && (flags & HAS_SSE4_2)) ptr = sse4_2;     \
+        if (((uintptr_t)NULL != (uintptr_t)avx) && (flags & HAS_AVX)) ptr = avx;              \
+        if (((uintptr_t)NULL != (uintptr_t)avx2) && (flags & HAS_AVX2)) ptr = avx2;           \
+        if (((uintptr_t)NULL != (uintptr_t)avx512) && (flags & HAS_AVX512F)) ptr = avx512;    \
+    } while (0)
+#else
+#define SET_FUNCTIONS(ptr, c, mmx, sse, sse2, sse3, ssse3, sse4_1, sse4_2, avx, avx2, avx512) \
+    do {                                                                                      \
+        ptr = c;                                                                              \
+        if (((uintptr_t)NULL != (uintptr_t)mmx) && (flags & HAS_MMX)) ptr = mmx;              \
+        if (((uintptr_t)NULL != (uintptr_t)sse) && (flags & HAS_SSE)) ptr = sse;              \
+        if (((uintptr_t)NULL != (uintptr_t)sse2) && (flags & HAS_SSE2)) ptr = sse2;           \
+        if (((uintptr_t)NULL != (uintptr_t)sse3) && (flags & HAS_SSE3)) ptr = sse3;           \
+        if (((uintptr_t)NULL != (uintptr_t)ssse3) && (flags & HAS_SSSE3)) ptr = ssse3;        \
+        if (((uintptr_t)NULL != (uintptr_t)sse4_1) && (flags & HAS_SSE4_1)) ptr = sse4_1;     \
+        if (((uintptr_t)NULL != (uintptr_t)sse4_2) && (flags & HAS_SSE4_2)) ptr = sse4_2;     \
+        if (((uintptr_t)NULL != (uintptr_t)avx) && (flags & HAS_AVX)) ptr = avx;              \
+        if (((uintptr_t)NULL != (uintptr_t)avx2) && (flags & HAS_AVX2)) ptr = avx2;           \
+    } while (0)
+#endif
+
+#define SET_SSE2(ptr, c, sse2) SET_FUNCTIONS(ptr, c, 0, 0, sse2, 0, 0, 0, 0, 0, 0, 0)
+#define SET_SSE2_AVX2(ptr, c, sse2, avx2) SET_FUNCTIONS(ptr, c, 0, 0, sse2, 0, 0, 0, 0, 0, avx2, 0)
+#define SET_SSSE3(ptr, c, ssse3) SET_FUNCTIONS(ptr, c, 0, 0, 0, 0, ssse3, 0, 0, 0, 0, 0)
+#define SET_SSE41(ptr, c, sse4_1) SET_FUNCTIONS(ptr, c, 0, 0, 0, 0, 0, sse4_1, 0, 0, 0, 0)
+#define SET_SSE41(ptr, c, sse4_1) SET_FUNCTIONS(ptr, c, 0, 0, 0, 0, 0, sse4_1, 0, 0, 0, 0)
+#define SET_SSE41_AVX2(ptr, c, sse4_1, avx2) \
+    SET_FUNCTIONS(ptr, c, 0, 0, 0, 0, 0, sse4_1, 0, 0, avx2, 0)
+#define SET_SSE41_AVX2_AVX512(ptr, c, sse4_1, avx2, avx512) \
+    SET_FUNCTIONS(ptr, c, 0, 0, 0, 0, 0, sse4_1, 0, 0, avx2, avx512)
+#define SET_AVX2(ptr, c, avx2) SET_FUNCTIONS(ptr, c, 0, 0, 0, 0, 0, 0, 0, 0, avx2, 0)
+#define SET_AVX2_AVX512(ptr, c, avx2, avx512) \
+    SET_FUNCTIONS(ptr, c, 0, 0, 0, 0, 0, 0, 0, 0, avx2, avx512)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    struct FgnBlendParams;
+
+    // Film grain noise blending of one block, see FgnBlendParams
+    void eb_fgn_blend_luma_c(uint8_t *luma, int32_t luma_stride, const int32_t *grain,
+                             int32_t grain_stride, int32_t width, int32_t height,
+                             const struct FgnBlendParams *p);
+    void eb_fgn_blend_luma_avx2(uint8_t *luma, int32_t luma_stride, const int32_t *grain,
+                                int32_t grain_stride, int32_t width, int32_t height,
+                                const struct FgnBlendParams *p);
+    extern void (*eb_fgn_blend_luma)(uint8_t *luma, int32_t luma_stride, const int32_t *grain,
+                                     int32_t grain_stride, int32_t width, int32_t height,
+                                     const struct FgnBlendParams *p);
+    void eb_fgn_blend_luma_hbd_c(uint16_t *luma, int32_t luma_stride, const int32_t *grain,
+                                 int32_t grain_stride, int32_t width, int32_t height,
+                                 const struct FgnBlendParams *p);
+    void eb_fgn_blend_luma_hbd_avx2(uint16_t *luma, int32_t luma_stride, const int32_t *grain,
+                                    int32_t grain_stride, int32_t width, int32_t height,
+                                    const struct FgnBlendParams *p);
+    extern void (*eb_fgn_blend_luma_hbd)(uint16_t *luma, int32_t luma_stride,
+                                         const int32_t *grain, int32_t grain_stride,
+                                         int32_t width, int32_t height,
+                                         const struct FgnBlendParams *p);
+    void eb_fgn_blend_chroma_c(uint8_t *chroma, int32_t chroma_stride, const uint8_t *luma,
+                               int32_t luma_stride, const int32_t *grain, int32_t grain_stride,
+                               int32_t width, int32_t height, const struct FgnBlendParams *p);
+    void eb_fgn_blend_chroma_avx2(uint8_t *chroma, int32_t chroma_stride, const uint8_t *luma,
+                                  int32_t luma_stride, const int32_t *grain, int32_t grain_stride,
+                                  int32_t width, int32_t height, const struct FgnBlendParams *p);
+    extern void (*eb_fgn_blend_chroma)(uint8_t *chroma, int32_t chroma_stride, const uint8_t *luma,
+                                       int32_t luma_stride, const int32_t *grain,
+                                       int32_t grain_stride, int32_t width, int32_t height,
+                                       const struct FgnBlendParams *p);
+    void eb_fgn_blend_chroma_hbd_c(uint16_t *chroma, int32_t chroma_stride, const uint16_t *luma,
+                                   int32_t luma_stride, const int32_t *grain,
+                                   int32_t grain_stride, int32_t width, int32_t height,
+                                   const struct FgnBlendParams *p);
+    void eb_fgn_blend_chroma_hbd_avx2(uint16_t *chroma, int32_t chroma_stride,
+                                      const uint16_t *luma, int32_t luma_stride,
+                                      const int32_t *grain, int32_t grain_stride, int32_t width,
+                                      int32_t height, const struct FgnBlendParams *p);
+    extern void (*eb_fgn_blend_chroma_hbd)(uint16_t *chroma, int32_t chroma_stride,
+                                           const uint16_t *luma, int32_t luma_stride,
+                                           const int32_t *grain, int32_t grain_stride,
+                                           int32_t width, int32_t height,
+                                           const struct FgnBlendParams *p);
+
+    // Sets up the kernels of the reconstruction path shared by the encoder
+    // and the decoder: inverse transforms, convolve, intra prediction,
+    // blending, CDEF, loop restoration and film grain.
+    void setup_common_rtcd_internal(CPU_FLAGS flags);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // COMMON_DSP_RTCD_H_
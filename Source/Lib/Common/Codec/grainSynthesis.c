@@ -18,6 +18,7 @@
 #include <string.h>
 #include <stdlib.h>
 #include "grainSynthesis.h"
+#include "common_dsp_rtcd.h"
 #include "EbLog.h"
 
 // Samples with Gaussian distribution in the range of [-2048, 2047] (12 bits)
@@ -185,11 +186,8 @@ static const int32_t gaussian_sequence[2048] = {
 
 static const int32_t gauss_bits = 11;
 
-static int32_t luma_subblock_size_y = 32;
-static int32_t luma_subblock_size_x = 32;
-
-static int32_t chroma_subblock_size_y = 16;
-static int32_t chroma_subblock_size_x = 16;
+static const int32_t luma_subblock_size_y = 32;
+static const int32_t luma_subblock_size_x = 32;
 
 static const int32_t min_luma_legal_range = 16;
 static const int32_t max_luma_legal_range = 235;
@@ -197,15 +195,15 @@ static const int32_t max_luma_legal_range = 235;
 static const int32_t min_chroma_legal_range = 16;
 static const int32_t max_chroma_legal_range = 240;
 
-static int32_t scaling_lut_y[256];
-static int32_t scaling_lut_cb[256];
-static int32_t scaling_lut_cr[256];
+static const int32_t left_pad   = 3;
+static const int32_t right_pad  = 3; // padding to offset for AR coefficients
+static const int32_t top_pad    = 3;
+static const int32_t bottom_pad = 0;
 
-static int32_t grain_center;
-static int32_t grain_min;
-static int32_t grain_max;
+static const int32_t ar_padding = 3; // maximum lag used for stabilization of AR coefficients
 
-static uint16_t random_register = 0; // random number generator register
+// at most 2 * 3 * (3 + 1) positions for luma, plus the luma one for chroma
+#define MAX_AR_POSITIONS 25
 
 //----------------------------------------------------------------------
 // todo: aomlib memory functions (to be replaced by Eb functions)
@@ -270,39 +268,8 @@ void eb_aom_free(void *memblk) {
 */
 //--------------------------------------------------------------------
 
-static void init_arrays(AomFilmGrain *params, int32_t luma_stride, int32_t chroma_stride,
-                        int32_t ***pred_pos_luma_p, int32_t ***pred_pos_chroma_p,
-                        int32_t **luma_grain_block, int32_t **cb_grain_block,
-                        int32_t **cr_grain_block, int32_t **y_line_buf, int32_t **cb_line_buf,
-                        int32_t **cr_line_buf, int32_t **y_col_buf, int32_t **cb_col_buf,
-                        int32_t **cr_col_buf, int32_t luma_grain_samples,
-                        int32_t chroma_grain_samples, int32_t chroma_subsamp_y,
-                        int32_t chroma_subsamp_x) {
-    memset(scaling_lut_y, 0, sizeof(*scaling_lut_y) * 256);
-    memset(scaling_lut_cb, 0, sizeof(*scaling_lut_cb) * 256);
-    memset(scaling_lut_cr, 0, sizeof(*scaling_lut_cr) * 256);
-
-    int32_t num_pos_luma   = 2 * params->ar_coeff_lag * (params->ar_coeff_lag + 1);
-    int32_t num_pos_chroma = num_pos_luma;
-    if (params->num_y_points > 0) ++num_pos_chroma;
-
-    int32_t **pred_pos_luma;
-    int32_t **pred_pos_chroma;
-
-    pred_pos_luma = (int32_t **)malloc(sizeof(*pred_pos_luma) * num_pos_luma);
-    ASSERT(pred_pos_luma != NULL);
-    for (int32_t row = 0; row < num_pos_luma; row++) {
-        pred_pos_luma[row] = (int32_t *)malloc(sizeof(**pred_pos_luma) * 3);
-        ASSERT(pred_pos_luma[row]);
-    }
-
-    pred_pos_chroma = (int32_t **)malloc(sizeof(*pred_pos_chroma) * num_pos_chroma);
-    ASSERT(pred_pos_chroma != NULL);
-    for (int32_t row = 0; row < num_pos_chroma; row++) {
-        pred_pos_chroma[row] = (int32_t *)malloc(sizeof(**pred_pos_chroma) * 3);
-        ASSERT(pred_pos_chroma[row]);
-    }
-
+static void init_pred_pos(AomFilmGrain *params, int32_t pred_pos_luma[][3],
+                          int32_t pred_pos_chroma[][3]) {
     int32_t pos_ar_index = 0;
 
     for (int32_t row = -params->ar_coeff_lag; row < 0; row++) {
@@ -335,92 +302,37 @@ static void init_arrays(AomFilmGrain *params, int32_t luma_stride, int32_t chrom
         pred_pos_chroma[pos_ar_index][1] = 0;
         pred_pos_chroma[pos_ar_index][2] = 1;
     }
-
-    *pred_pos_luma_p   = pred_pos_luma;
-    *pred_pos_chroma_p = pred_pos_chroma;
-
-    *y_line_buf = (int32_t *)malloc(sizeof(**y_line_buf) * luma_stride * 2);
-    *cb_line_buf =
-        (int32_t *)malloc(sizeof(**cb_line_buf) * chroma_stride * (2 >> chroma_subsamp_y));
-    *cr_line_buf =
-        (int32_t *)malloc(sizeof(**cr_line_buf) * chroma_stride * (2 >> chroma_subsamp_y));
-
-    *y_col_buf  = (int32_t *)malloc(sizeof(**y_col_buf) * (luma_subblock_size_y + 2) * 2);
-    *cb_col_buf = (int32_t *)malloc(sizeof(**cb_col_buf) *
-                                    (chroma_subblock_size_y + (2 >> chroma_subsamp_y)) *
-                                    (2 >> chroma_subsamp_x));
-    *cr_col_buf = (int32_t *)malloc(sizeof(**cr_col_buf) *
-                                    (chroma_subblock_size_y + (2 >> chroma_subsamp_y)) *
-                                    (2 >> chroma_subsamp_x));
-
-    *luma_grain_block = (int32_t *)malloc(sizeof(**luma_grain_block) * luma_grain_samples);
-    *cb_grain_block   = (int32_t *)malloc(sizeof(**cb_grain_block) * chroma_grain_samples);
-    *cr_grain_block   = (int32_t *)malloc(sizeof(**cr_grain_block) * chroma_grain_samples);
-}
-
-static void dealloc_arrays(AomFilmGrain *params, int32_t ***pred_pos_luma,
-                           int32_t ***pred_pos_chroma, int32_t **luma_grain_block,
-                           int32_t **cb_grain_block, int32_t **cr_grain_block, int32_t **y_line_buf,
-                           int32_t **cb_line_buf, int32_t **cr_line_buf, int32_t **y_col_buf,
-                           int32_t **cb_col_buf, int32_t **cr_col_buf) {
-    int32_t num_pos_luma   = 2 * params->ar_coeff_lag * (params->ar_coeff_lag + 1);
-    int32_t num_pos_chroma = num_pos_luma + 1;
-
-    for (int32_t row = 0; row < num_pos_luma; row++) free((*pred_pos_luma)[row]);
-    free(*pred_pos_luma);
-
-    for (int32_t row = 0; row < num_pos_chroma; row++) free((*pred_pos_chroma)[row]);
-    free((*pred_pos_chroma));
-
-    free(*y_line_buf);
-
-    free(*cb_line_buf);
-
-    free(*cr_line_buf);
-
-    free(*y_col_buf);
-
-    free(*cb_col_buf);
-
-    free(*cr_col_buf);
-
-    free(*luma_grain_block);
-
-    free(*cb_grain_block);
-
-    free(*cr_grain_block);
 }
 
 // get a number between 0 and 2^bits - 1
-static INLINE int32_t get_random_number(int32_t bits) {
+static INLINE int32_t get_random_number(uint16_t *random_register, int32_t bits) {
     uint16_t bit;
-    bit = ((random_register >> 0) ^ (random_register >> 1) ^ (random_register >> 3) ^
-           (random_register >> 12)) &
+    bit = ((*random_register >> 0) ^ (*random_register >> 1) ^ (*random_register >> 3) ^
+           (*random_register >> 12)) &
           1;
-    random_register = (random_register >> 1) | (bit << 15);
-    return (random_register >> (16 - bits)) & ((1 << bits) - 1);
+    *random_register = (*random_register >> 1) | (bit << 15);
+    return (*random_register >> (16 - bits)) & ((1 << bits) - 1);
 }
 
-static void init_random_generator(int32_t luma_line, uint16_t seed) {
+static void init_random_generator(uint16_t *random_register, int32_t luma_line, uint16_t seed) {
     // same for the picture
 
     uint16_t msb = (seed >> 8) & 255;
     uint16_t lsb = seed & 255;
 
-    random_register = (msb << 8) + lsb;
+    *random_register = (msb << 8) + lsb;
 
     //  changes for each row
     int32_t luma_num = luma_line >> 5;
 
-    random_register ^= ((luma_num * 37 + 178) & 255) << 8;
-    random_register ^= ((luma_num * 173 + 105) & 255);
+    *random_register ^= ((luma_num * 37 + 178) & 255) << 8;
+    *random_register ^= ((luma_num * 173 + 105) & 255);
 }
 
-static void generate_luma_grain_block(AomFilmGrain *params, int32_t **pred_pos_luma,
+static void generate_luma_grain_block(FilmGrainCtxt *ctxt, int32_t pred_pos_luma[][3],
                                       int32_t *luma_grain_block, int32_t luma_block_size_y,
-                                      int32_t luma_block_size_x, int32_t luma_grain_stride,
-                                      int32_t left_pad, int32_t top_pad, int32_t right_pad,
-                                      int32_t bottom_pad) {
+                                      int32_t luma_block_size_x, int32_t luma_grain_stride) {
+    AomFilmGrain *params = &ctxt->params;
     if (params->num_y_points == 0) return;
 
     int32_t bit_depth       = params->bit_depth;
@@ -429,10 +341,12 @@ static void generate_luma_grain_block(AomFilmGrain *params, int32_t **pred_pos_l
     int32_t num_pos_luma    = 2 * params->ar_coeff_lag * (params->ar_coeff_lag + 1);
     int32_t rounding_offset = (1 << (params->ar_coeff_shift - 1));
 
+    uint16_t random_register = params->random_seed;
+
     for (int32_t i = 0; i < luma_block_size_y; i++)
         for (int32_t j = 0; j < luma_block_size_x; j++)
             luma_grain_block[i * luma_grain_stride + j] =
-                (gaussian_sequence[get_random_number(gauss_bits)] +
+                (gaussian_sequence[get_random_number(&random_register, gauss_bits)] +
                  ((1 << gauss_sec_shift) >> 1)) >>
                 gauss_sec_shift;
 
@@ -447,42 +361,45 @@ static void generate_luma_grain_block(AomFilmGrain *params, int32_t **pred_pos_l
             luma_grain_block[i * luma_grain_stride + j] =
                 clamp(luma_grain_block[i * luma_grain_stride + j] +
                           ((wsum + rounding_offset) >> params->ar_coeff_shift),
-                      grain_min,
-                      grain_max);
+                      ctxt->grain_min,
+                      ctxt->grain_max);
         }
 }
 
-static void generate_chroma_grain_blocks(
-    AomFilmGrain *params,
-    //                                  int32_t** pred_pos_luma,
-    int32_t **pred_pos_chroma, int32_t *luma_grain_block, int32_t *cb_grain_block,
-    int32_t *cr_grain_block, int32_t luma_grain_stride, int32_t chroma_block_size_y,
-    int32_t chroma_block_size_x, int32_t chroma_grain_stride, int32_t left_pad, int32_t top_pad,
-    int32_t right_pad, int32_t bottom_pad, int32_t chroma_subsamp_y, int32_t chroma_subsamp_x) {
-    int32_t bit_depth       = params->bit_depth;
-    int32_t gauss_sec_shift = 12 - bit_depth + params->grain_scale_shift;
+static void generate_chroma_grain_blocks(FilmGrainCtxt *ctxt, int32_t pred_pos_chroma[][3],
+                                         int32_t *luma_grain_block, int32_t *cb_grain_block,
+                                         int32_t *cr_grain_block, int32_t luma_grain_stride,
+                                         int32_t chroma_block_size_y, int32_t chroma_block_size_x,
+                                         int32_t chroma_grain_stride) {
+    AomFilmGrain *params           = &ctxt->params;
+    int32_t       chroma_subsamp_y = ctxt->chroma_subsamp_y;
+    int32_t       chroma_subsamp_x = ctxt->chroma_subsamp_x;
+    int32_t       bit_depth        = params->bit_depth;
+    int32_t       gauss_sec_shift  = 12 - bit_depth + params->grain_scale_shift;
 
     int32_t num_pos_chroma = 2 * params->ar_coeff_lag * (params->ar_coeff_lag + 1);
     if (params->num_y_points > 0) ++num_pos_chroma;
     int32_t rounding_offset = (1 << (params->ar_coeff_shift - 1));
 
+    uint16_t random_register;
+
     if (params->num_cb_points) {
-        init_random_generator(7 << 5, params->random_seed);
+        init_random_generator(&random_register, 7 << 5, params->random_seed);
 
         for (int32_t i = 0; i < chroma_block_size_y; i++)
             for (int32_t j = 0; j < chroma_block_size_x; j++)
                 cb_grain_block[i * chroma_grain_stride + j] =
-                    (gaussian_sequence[get_random_number(gauss_bits)] +
+                    (gaussian_sequence[get_random_number(&random_register, gauss_bits)] +
                      ((1 << gauss_sec_shift) >> 1)) >>
                     gauss_sec_shift;
     }
     if (params->num_cr_points) {
-        init_random_generator(11 << 5, params->random_seed);
+        init_random_generator(&random_register, 11 << 5, params->random_seed);
 
         for (int32_t i = 0; i < chroma_block_size_y; i++)
             for (int32_t j = 0; j < chroma_block_size_x; j++)
                 cr_grain_block[i * chroma_grain_stride + j] =
-                    (gaussian_sequence[get_random_number(gauss_bits)] +
+                    (gaussian_sequence[get_random_number(&random_register, gauss_bits)] +
                      ((1 << gauss_sec_shift) >> 1)) >>
                     gauss_sec_shift;
     }
@@ -528,14 +445,14 @@ static void generate_chroma_grain_blocks(
                 cb_grain_block[i * chroma_grain_stride + j] =
                     clamp(cb_grain_block[i * chroma_grain_stride + j] +
                               ((wsum_cb + rounding_offset) >> params->ar_coeff_shift),
-                          grain_min,
-                          grain_max);
+                          ctxt->grain_min,
+                          ctxt->grain_max);
             if (params->num_cr_points)
                 cr_grain_block[i * chroma_grain_stride + j] =
                     clamp(cr_grain_block[i * chroma_grain_stride + j] +
                               ((wsum_cr + rounding_offset) >> params->ar_coeff_shift),
-                          grain_min,
-                          grain_max);
+                          ctxt->grain_min,
+                          ctxt->grain_max);
         }
 }
 
@@ -563,7 +480,7 @@ static void init_scaling_function(int32_t scaling_points[][2], int32_t num_point
 
 // function that extracts samples from a lut (and interpolates intemediate
 // frames for 10- and 12-bit video)
-static int32_t scale_lut(int32_t *scaling_lut, int32_t index, int32_t bit_depth) {
+static INLINE int32_t scale_lut(const int32_t *scaling_lut, int32_t index, int32_t bit_depth) {
     int32_t x = index >> (bit_depth - 8);
 
     if (!(bit_depth - 8) || x == 255)
@@ -575,145 +492,87 @@ static int32_t scale_lut(int32_t *scaling_lut, int32_t index, int32_t bit_depth)
                 (bit_depth - 8));
 }
 
-static void add_noise_to_block(AomFilmGrain *params, uint8_t *luma, uint8_t *cb, uint8_t *cr,
-                               int32_t luma_stride, int32_t chroma_stride, int32_t *luma_grain,
-                               int32_t *cb_grain, int32_t *cr_grain, int32_t luma_grain_stride,
-                               int32_t chroma_grain_stride, int32_t half_luma_height,
-                               int32_t half_luma_width, int32_t bit_depth, int32_t chroma_subsamp_y,
-                               int32_t chroma_subsamp_x) {
-    int32_t cb_mult      = params->cb_mult - 128; // fixed scale
-    int32_t cb_luma_mult = params->cb_luma_mult - 128; // fixed scale
-    int32_t cb_offset    = params->cb_offset - 256;
-
-    int32_t cr_mult      = params->cr_mult - 128; // fixed scale
-    int32_t cr_luma_mult = params->cr_luma_mult - 128; // fixed scale
-    int32_t cr_offset    = params->cr_offset - 256;
-
-    int32_t rounding_offset = (1 << (params->scaling_shift - 1));
-
-    int32_t apply_y  = params->num_y_points > 0 ? 1 : 0;
-    int32_t apply_cb = params->num_cb_points > 0 ? 1 : 0;
-    int32_t apply_cr = params->num_cr_points > 0 ? 1 : 0;
+static INLINE int32_t blend_sample(int32_t sample, int32_t index, int32_t grain,
+                                   const FgnBlendParams *p) {
+    const int32_t rounding_offset = 1 << (p->scaling_shift - 1);
+    return clamp(sample + ((scale_lut(p->scaling_lut, index, p->bit_depth) * grain +
+                            rounding_offset) >>
+                           p->scaling_shift),
+                 p->min_value,
+                 p->max_value);
+}
 
-    if (params->chroma_scaling_from_luma) {
-        cb_mult      = 0; // fixed scale
-        cb_luma_mult = 64; // fixed scale
-        cb_offset    = 0;
+static INLINE int32_t chroma_scaling_index(int32_t average_luma, int32_t sample,
+                                           const FgnBlendParams *p) {
+    return clamp(((average_luma * p->luma_mult + p->mult * sample) >> 6) + p->offset,
+                 0,
+                 (256 << (p->bit_depth - 8)) - 1);
+}
 
-        cr_mult      = 0; // fixed scale
-        cr_luma_mult = 64; // fixed scale
-        cr_offset    = 0;
+void eb_fgn_blend_luma_c(uint8_t *luma, int32_t luma_stride, const int32_t *grain,
+                         int32_t grain_stride, int32_t width, int32_t height,
+                         const FgnBlendParams *p) {
+    for (int32_t i = 0; i < height; i++) {
+        for (int32_t j = 0; j < width; j++)
+            luma[j] = (uint8_t)blend_sample(luma[j], luma[j], grain[j], p);
+        luma += luma_stride;
+        grain += grain_stride;
     }
+}
 
-    int32_t min_luma, max_luma, min_chroma, max_chroma;
-
-    if (params->clip_to_restricted_range) {
-        min_luma = min_luma_legal_range;
-        max_luma = max_luma_legal_range;
-
-        min_chroma = min_chroma_legal_range;
-        max_chroma = max_chroma_legal_range;
-    } else {
-        min_luma = min_chroma = 0;
-        max_luma = max_chroma = 255;
+void eb_fgn_blend_luma_hbd_c(uint16_t *luma, int32_t luma_stride, const int32_t *grain,
+                             int32_t grain_stride, int32_t width, int32_t height,
+                             const FgnBlendParams *p) {
+    for (int32_t i = 0; i < height; i++) {
+        for (int32_t j = 0; j < width; j++)
+            luma[j] = (uint16_t)blend_sample(luma[j], luma[j], grain[j], p);
+        luma += luma_stride;
+        grain += grain_stride;
     }
+}
 
-    for (int32_t i = 0; i < (half_luma_height << (1 - chroma_subsamp_y)); i++) {
-        for (int32_t j = 0; j < (half_luma_width << (1 - chroma_subsamp_x)); j++) {
-            int32_t average_luma = 0;
-            if (chroma_subsamp_x) {
-                average_luma =
-                    (luma[(i << chroma_subsamp_y) * luma_stride + (j << chroma_subsamp_x)] +
-                     luma[(i << chroma_subsamp_y) * luma_stride + (j << chroma_subsamp_x) + 1] +
-                     1) >>
-                    1;
-            } else
-                average_luma = luma[(i << chroma_subsamp_y) * luma_stride + j];
-            if (apply_cb) {
-                cb[i * chroma_stride + j] =
-                    clamp(cb[i * chroma_stride + j] +
-                              ((scale_lut(scaling_lut_cb,
-                                          clamp(((average_luma * cb_luma_mult +
-                                                  cb_mult * cb[i * chroma_stride + j]) >>
-                                                 6) +
-                                                    cb_offset,
-                                                0,
-                                                (256 << (bit_depth - 8)) - 1),
-                                          8) *
-                                    cb_grain[i * chroma_grain_stride + j] +
-                                rounding_offset) >>
-                               params->scaling_shift),
-                          min_chroma,
-                          max_chroma);
-            }
-
-            if (apply_cr) {
-                cr[i * chroma_stride + j] =
-                    clamp(cr[i * chroma_stride + j] +
-                              ((scale_lut(scaling_lut_cr,
-                                          clamp(((average_luma * cr_luma_mult +
-                                                  cr_mult * cr[i * chroma_stride + j]) >>
-                                                 6) +
-                                                    cr_offset,
-                                                0,
-                                                (256 << (bit_depth - 8)) - 1),
-                                          8) *
-                                    cr_grain[i * chroma_grain_stride + j] +
-                                rounding_offset) >>
-                               params->scaling_shift),
-                          min_chroma,
-                          max_chroma);
-            }
+void eb_fgn_blend_chroma_c(uint8_t *chroma, int32_t chroma_stride, const uint8_t *luma,
+                           int32_t luma_stride, const int32_t *grain, int32_t grain_stride,
+                           int32_t width, int32_t height, const FgnBlendParams *p) {
+    for (int32_t i = 0; i < height; i++) {
+        const uint8_t *luma_row = luma + (i << p->subsamp_y) * luma_stride;
+        for (int32_t j = 0; j < width; j++) {
+            int32_t average_luma;
+            if (p->subsamp_x)
+                average_luma = (luma_row[j << 1] + luma_row[(j << 1) + 1] + 1) >> 1;
+            else
+                average_luma = luma_row[j];
+            chroma[j] = (uint8_t)blend_sample(
+                chroma[j], chroma_scaling_index(average_luma, chroma[j], p), grain[j], p);
         }
+        chroma += chroma_stride;
+        grain += grain_stride;
     }
+}
 
-    if (apply_y) {
-        for (int32_t i = 0; i < (half_luma_height << 1); i++) {
-            for (int32_t j = 0; j < (half_luma_width << 1); j++) {
-                luma[i * luma_stride + j] =
-                    clamp(luma[i * luma_stride + j] +
-                              ((scale_lut(scaling_lut_y, luma[i * luma_stride + j], 8) *
-                                    luma_grain[i * luma_grain_stride + j] +
-                                rounding_offset) >>
-                               params->scaling_shift),
-                          min_luma,
-                          max_luma);
-            }
+void eb_fgn_blend_chroma_hbd_c(uint16_t *chroma, int32_t chroma_stride, const uint16_t *luma,
+                               int32_t luma_stride, const int32_t *grain, int32_t grain_stride,
+                               int32_t width, int32_t height, const FgnBlendParams *p) {
+    for (int32_t i = 0; i < height; i++) {
+        const uint16_t *luma_row = luma + (i << p->subsamp_y) * luma_stride;
+        for (int32_t j = 0; j < width; j++) {
+            int32_t average_luma;
+            if (p->subsamp_x)
+                average_luma = (luma_row[j << 1] + luma_row[(j << 1) + 1] + 1) >> 1;
+            else
+                average_luma = luma_row[j];
+            chroma[j] = (uint16_t)blend_sample(
+                chroma[j], chroma_scaling_index(average_luma, chroma[j], p), grain[j], p);
         }
+        chroma += chroma_stride;
+        grain += grain_stride;
     }
 }
 
-static void add_noise_to_block_hbd(AomFilmGrain *params, uint16_t *luma, uint16_t *cb, uint16_t *cr,
-                                   int32_t luma_stride, int32_t chroma_stride, int32_t *luma_grain,
-                                   int32_t *cb_grain, int32_t *cr_grain, int32_t luma_grain_stride,
-                                   int32_t chroma_grain_stride, int32_t half_luma_height,
-                                   int32_t half_luma_width, int32_t bit_depth,
-                                   int32_t chroma_subsamp_y, int32_t chroma_subsamp_x) {
-    int32_t cb_mult      = params->cb_mult - 128; // fixed scale
-    int32_t cb_luma_mult = params->cb_luma_mult - 128; // fixed scale
-    // offset value depends on the bit depth
-    int32_t cb_offset = (params->cb_offset << (bit_depth - 8)) - (1 << bit_depth);
-
-    int32_t cr_mult      = params->cr_mult - 128; // fixed scale
-    int32_t cr_luma_mult = params->cr_luma_mult - 128; // fixed scale
-    // offset value depends on the bit depth
-    int32_t cr_offset = (params->cr_offset << (bit_depth - 8)) - (1 << bit_depth);
-
-    int32_t rounding_offset = (1 << (params->scaling_shift - 1));
-
-    int32_t apply_y  = params->num_y_points > 0 ? 1 : 0;
-    int32_t apply_cb = params->num_cb_points > 0 ? 1 : 0;
-    int32_t apply_cr = params->num_cr_points > 0 ? 1 : 0;
-
-    if (params->chroma_scaling_from_luma) {
-        cb_mult      = 0; // fixed scale
-        cb_luma_mult = 64; // fixed scale
-        cb_offset    = 0;
-
-        cr_mult      = 0; // fixed scale
-        cr_luma_mult = 64; // fixed scale
-        cr_offset    = 0;
-    }
+static void init_blend_params(FilmGrainCtxt *ctxt) {
+    AomFilmGrain *params = &ctxt->params;
+    // the 8-bit output path blends with 8-bit ranges
+    const int32_t bit_depth = ctxt->use_high_bit_depth ? params->bit_depth : 8;
 
     int32_t min_luma, max_luma, min_chroma, max_chroma;
 
@@ -728,67 +587,109 @@ static void add_noise_to_block_hbd(AomFilmGrain *params, uint16_t *luma, uint16_
         max_luma = max_chroma = (256 << (bit_depth - 8)) - 1;
     }
 
-    for (int32_t i = 0; i < (half_luma_height << (1 - chroma_subsamp_y)); i++) {
-        for (int32_t j = 0; j < (half_luma_width << (1 - chroma_subsamp_x)); j++) {
-            int32_t average_luma = 0;
-            if (chroma_subsamp_x) {
-                average_luma =
-                    (luma[(i << chroma_subsamp_y) * luma_stride + (j << chroma_subsamp_x)] +
-                     luma[(i << chroma_subsamp_y) * luma_stride + (j << chroma_subsamp_x) + 1] +
-                     1) >>
-                    1;
-            } else
-                average_luma = luma[(i << chroma_subsamp_y) * luma_stride + j];
-            if (apply_cb) {
-                cb[i * chroma_stride + j] =
-                    clamp(cb[i * chroma_stride + j] +
-                              ((scale_lut(scaling_lut_cb,
-                                          clamp(((average_luma * cb_luma_mult +
-                                                  cb_mult * cb[i * chroma_stride + j]) >>
-                                                 6) +
-                                                    cb_offset,
-                                                0,
-                                                (256 << (bit_depth - 8)) - 1),
-                                          bit_depth) *
-                                    cb_grain[i * chroma_grain_stride + j] +
-                                rounding_offset) >>
-                               params->scaling_shift),
-                          min_chroma,
-                          max_chroma);
-            }
-            if (apply_cr) {
-                cr[i * chroma_stride + j] =
-                    clamp(cr[i * chroma_stride + j] +
-                              ((scale_lut(scaling_lut_cr,
-                                          clamp(((average_luma * cr_luma_mult +
-                                                  cr_mult * cr[i * chroma_stride + j]) >>
-                                                 6) +
-                                                    cr_offset,
-                                                0,
-                                                (256 << (bit_depth - 8)) - 1),
-                                          bit_depth) *
-                                    cr_grain[i * chroma_grain_stride + j] +
-                                rounding_offset) >>
-                               params->scaling_shift),
-                          min_chroma,
-                          max_chroma);
-            }
-        }
+    FgnBlendParams *blend[3] = {&ctxt->blend_y, &ctxt->blend_cb, &ctxt->blend_cr};
+    const int32_t * scaling_lut[3] = {
+        ctxt->scaling_lut_y, ctxt->scaling_lut_cb, ctxt->scaling_lut_cr};
+    for (int32_t plane = 0; plane < 3; plane++) {
+        blend[plane]->scaling_lut   = scaling_lut[plane];
+        blend[plane]->scaling_shift = params->scaling_shift;
+        blend[plane]->bit_depth     = bit_depth;
+        blend[plane]->min_value     = plane ? min_chroma : min_luma;
+        blend[plane]->max_value     = plane ? max_chroma : max_luma;
+        blend[plane]->subsamp_x     = ctxt->chroma_subsamp_x;
+        blend[plane]->subsamp_y     = ctxt->chroma_subsamp_y;
     }
 
-    if (apply_y) {
-        for (int32_t i = 0; i < (half_luma_height << 1); i++) {
-            for (int32_t j = 0; j < (half_luma_width << 1); j++) {
-                luma[i * luma_stride + j] =
-                    clamp(luma[i * luma_stride + j] +
-                              ((scale_lut(scaling_lut_y, luma[i * luma_stride + j], bit_depth) *
-                                    luma_grain[i * luma_grain_stride + j] +
-                                rounding_offset) >>
-                               params->scaling_shift),
-                          min_luma,
-                          max_luma);
-            }
-        }
+    ctxt->blend_y.luma_mult = ctxt->blend_y.mult = ctxt->blend_y.offset = 0;
+    if (params->chroma_scaling_from_luma) {
+        ctxt->blend_cb.mult      = 0; // fixed scale
+        ctxt->blend_cb.luma_mult = 64; // fixed scale
+        ctxt->blend_cb.offset    = 0;
+
+        ctxt->blend_cr.mult      = 0; // fixed scale
+        ctxt->blend_cr.luma_mult = 64; // fixed scale
+        ctxt->blend_cr.offset    = 0;
+    } else {
+        ctxt->blend_cb.mult      = params->cb_mult - 128; // fixed scale
+        ctxt->blend_cb.luma_mult = params->cb_luma_mult - 128; // fixed scale
+        // offset value depends on the bit depth
+        ctxt->blend_cb.offset = (params->cb_offset << (bit_depth - 8)) - (1 << bit_depth);
+
+        ctxt->blend_cr.mult      = params->cr_mult - 128; // fixed scale
+        ctxt->blend_cr.luma_mult = params->cr_luma_mult - 128; // fixed scale
+        // offset value depends on the bit depth
+        ctxt->blend_cr.offset = (params->cr_offset << (bit_depth - 8)) - (1 << bit_depth);
+    }
+}
+
+// luma, cb and cr point at the top left sample of the block
+static void add_noise_to_block(FilmGrainCtxt *ctxt, uint8_t *luma, uint8_t *cb, uint8_t *cr,
+                               int32_t *luma_grain, int32_t *cb_grain, int32_t *cr_grain,
+                               int32_t luma_grain_stride, int32_t chroma_grain_stride,
+                               int32_t half_luma_height, int32_t half_luma_width) {
+    AomFilmGrain *params        = &ctxt->params;
+    int32_t       chroma_height = half_luma_height << (1 - ctxt->chroma_subsamp_y);
+    int32_t       chroma_width  = half_luma_width << (1 - ctxt->chroma_subsamp_x);
+
+    // chroma first, its scaling depends on the luma without grain
+    if (ctxt->use_high_bit_depth) {
+        if (params->num_cb_points > 0)
+            eb_fgn_blend_chroma_hbd((uint16_t *)cb,
+                                    ctxt->chroma_stride,
+                                    (uint16_t *)luma,
+                                    ctxt->luma_stride,
+                                    cb_grain,
+                                    chroma_grain_stride,
+                                    chroma_width,
+                                    chroma_height,
+                                    &ctxt->blend_cb);
+        if (params->num_cr_points > 0)
+            eb_fgn_blend_chroma_hbd((uint16_t *)cr,
+                                    ctxt->chroma_stride,
+                                    (uint16_t *)luma,
+                                    ctxt->luma_stride,
+                                    cr_grain,
+                                    chroma_grain_stride,
+                                    chroma_width,
+                                    chroma_height,
+                                    &ctxt->blend_cr);
+        if (params->num_y_points > 0)
+            eb_fgn_blend_luma_hbd((uint16_t *)luma,
+                                  ctxt->luma_stride,
+                                  luma_grain,
+                                  luma_grain_stride,
+                                  half_luma_width << 1,
+                                  half_luma_height << 1,
+                                  &ctxt->blend_y);
+    } else {
+        if (params->num_cb_points > 0)
+            eb_fgn_blend_chroma(cb,
+                                ctxt->chroma_stride,
+                                luma,
+                                ctxt->luma_stride,
+                                cb_grain,
+                                chroma_grain_stride,
+                                chroma_width,
+                                chroma_height,
+                                &ctxt->blend_cb);
+        if (params->num_cr_points > 0)
+            eb_fgn_blend_chroma(cr,
+                                ctxt->chroma_stride,
+                                luma,
+                                ctxt->luma_stride,
+                                cr_grain,
+                                chroma_grain_stride,
+                                chroma_width,
+                                chroma_height,
+                                &ctxt->blend_cr);
+        if (params->num_y_points > 0)
+            eb_fgn_blend_luma(luma,
+                              ctxt->luma_stride,
+                              luma_grain,
+                              luma_grain_stride,
+                              half_luma_width << 1,
+                              half_luma_height << 1,
+                              &ctxt->blend_y);
     }
 }
 
@@ -863,7 +764,8 @@ static void copy_area(int32_t *src, int32_t src_stride, int32_t *dst, int32_t ds
 
 static void ver_boundary_overlap(int32_t *left_block, int32_t left_stride, int32_t *right_block,
                                  int32_t right_stride, int32_t *dst_block, int32_t dst_stride,
-                                 int32_t width, int32_t height) {
+                                 int32_t width, int32_t height, int32_t grain_min,
+                                 int32_t grain_max) {
     if (width == 1) {
         while (height) {
             *dst_block =
@@ -891,7 +793,8 @@ static void ver_boundary_overlap(int32_t *left_block, int32_t left_stride, int32
 
 static void hor_boundary_overlap(int32_t *top_block, int32_t top_stride, int32_t *bottom_block,
                                  int32_t bottom_stride, int32_t *dst_block, int32_t dst_stride,
-                                 int32_t width, int32_t height) {
+                                 int32_t width, int32_t height, int32_t grain_min,
+                                 int32_t grain_max) {
     if (height == 1) {
         while (width) {
             *dst_block =
@@ -919,478 +822,502 @@ static void hor_boundary_overlap(int32_t *top_block, int32_t top_stride, int32_t
     }
 }
 
-void eb_av1_add_film_grain_run(AomFilmGrain *params, uint8_t *luma, uint8_t *cb, uint8_t *cr,
-                               int32_t height, int32_t width, int32_t luma_stride,
-                               int32_t chroma_stride, int32_t use_high_bit_depth,
-                               int32_t chroma_subsamp_y, int32_t chroma_subsamp_x) {
-    int32_t **pred_pos_luma;
-    int32_t **pred_pos_chroma;
-    int32_t * luma_grain_block;
-    int32_t * cb_grain_block;
-    int32_t * cr_grain_block;
-
-    int32_t *y_line_buf;
-    int32_t *cb_line_buf;
-    int32_t *cr_line_buf;
-
-    int32_t *y_col_buf;
-    int32_t *cb_col_buf;
-    int32_t *cr_col_buf;
-
-    random_register = params->random_seed;
-
-    int32_t left_pad   = 3;
-    int32_t right_pad  = 3; // padding to offset for AR coefficients
-    int32_t top_pad    = 3;
-    int32_t bottom_pad = 0;
-
-    int32_t ar_padding = 3; // maximum lag used for stabilization of AR coefficients
+FilmGrainCtxt *eb_av1_film_grain_ctxt_alloc(uint32_t num_slots) {
+    FilmGrainCtxt *ctxt = (FilmGrainCtxt *)calloc(1, sizeof(*ctxt));
+    if (ctxt == NULL) return NULL;
+    ctxt->slots = (FgnStripeBufs *)calloc(num_slots, sizeof(*ctxt->slots));
+    if (ctxt->slots == NULL) {
+        free(ctxt);
+        return NULL;
+    }
+    ctxt->num_slots = num_slots;
+    return ctxt;
+}
 
-    luma_subblock_size_y = 32;
-    luma_subblock_size_x = 32;
+static void free_line_bufs(FilmGrainCtxt *ctxt) {
+    for (uint32_t slot = 0; slot < ctxt->num_slots; slot++) {
+        FgnStripeBufs *bufs = &ctxt->slots[slot];
+        free(bufs->y_line_buf);
+        free(bufs->cb_line_buf);
+        free(bufs->cr_line_buf);
+        bufs->y_line_buf  = NULL;
+        bufs->cb_line_buf = NULL;
+        bufs->cr_line_buf = NULL;
+    }
+    ctxt->luma_line_stride   = 0;
+    ctxt->chroma_line_stride = 0;
+}
 
-    chroma_subblock_size_y = luma_subblock_size_y >> chroma_subsamp_y;
-    chroma_subblock_size_x = luma_subblock_size_x >> chroma_subsamp_x;
+void eb_av1_film_grain_ctxt_free(FilmGrainCtxt *ctxt) {
+    if (ctxt == NULL) return;
+    free_line_bufs(ctxt);
+    free(ctxt->slots);
+    free(ctxt);
+}
 
-    // Initial padding is only needed for generation of
-    // film grain templates (to stabilize the AR process)
-    // Only a 64x64 luma and 32x32 chroma part of a template
-    // is used later for adding grain, padding can be discarded
+EbErrorType eb_av1_film_grain_prepare(FilmGrainCtxt *ctxt, AomFilmGrain *params, int32_t width,
+                                      int32_t height, int32_t luma_stride, int32_t chroma_stride,
+                                      int32_t use_high_bit_depth, int32_t chroma_subsamp_y,
+                                      int32_t chroma_subsamp_x) {
+    if (luma_stride > ctxt->luma_line_stride || chroma_stride > ctxt->chroma_line_stride) {
+        free_line_bufs(ctxt);
+        for (uint32_t slot = 0; slot < ctxt->num_slots; slot++) {
+            FgnStripeBufs *bufs = &ctxt->slots[slot];
+            bufs->y_line_buf    = (int32_t *)malloc(sizeof(*bufs->y_line_buf) * luma_stride * 2);
+            bufs->cb_line_buf = (int32_t *)malloc(sizeof(*bufs->cb_line_buf) * chroma_stride * 2);
+            bufs->cr_line_buf = (int32_t *)malloc(sizeof(*bufs->cr_line_buf) * chroma_stride * 2);
+            bufs->frame_id    = 0;
+            if (!bufs->y_line_buf || !bufs->cb_line_buf || !bufs->cr_line_buf) {
+                free_line_bufs(ctxt);
+                return EB_ErrorInsufficientResources;
+            }
+        }
+        ctxt->luma_line_stride   = luma_stride;
+        ctxt->chroma_line_stride = chroma_stride;
+    }
 
-    int32_t luma_block_size_y = top_pad + 2 * ar_padding + luma_subblock_size_y * 2 + bottom_pad;
-    int32_t luma_block_size_x =
-        left_pad + 2 * ar_padding + luma_subblock_size_x * 2 + 2 * ar_padding + right_pad;
+    if (!ctxt->templates_valid || !film_grain_params_equal(&ctxt->params, params) ||
+        ctxt->params.random_seed != params->random_seed ||
+        ctxt->params.bit_depth != params->bit_depth ||
+        ctxt->chroma_subsamp_y != chroma_subsamp_y || ctxt->chroma_subsamp_x != chroma_subsamp_x) {
+        int32_t pred_pos_luma[MAX_AR_POSITIONS][3];
+        int32_t pred_pos_chroma[MAX_AR_POSITIONS][3];
+
+        ctxt->params           = *params;
+        ctxt->chroma_subsamp_y = chroma_subsamp_y;
+        ctxt->chroma_subsamp_x = chroma_subsamp_x;
+
+        int32_t grain_center = 128 << (params->bit_depth - 8);
+        ctxt->grain_min      = 0 - grain_center;
+        ctxt->grain_max      = (256 << (params->bit_depth - 8)) - 1 - grain_center;
+
+        // Initial padding is only needed for generation of
+        // film grain templates (to stabilize the AR process)
+        // Only a 64x64 luma and 32x32 chroma part of a template
+        // is used later for adding grain, padding can be discarded
+        int32_t chroma_block_size_y = top_pad + (2 >> chroma_subsamp_y) * ar_padding +
+                                      (luma_subblock_size_y >> chroma_subsamp_y) * 2 + bottom_pad;
+        int32_t chroma_block_size_x = left_pad + (2 >> chroma_subsamp_x) * ar_padding +
+                                      (luma_subblock_size_x >> chroma_subsamp_x) * 2 +
+                                      (2 >> chroma_subsamp_x) * ar_padding + right_pad;
+        ctxt->chroma_grain_stride = chroma_block_size_x;
+
+        init_pred_pos(&ctxt->params, pred_pos_luma, pred_pos_chroma);
+
+        generate_luma_grain_block(
+            ctxt, pred_pos_luma, ctxt->luma_grain_block, FGN_BLOCK_SIZE_Y, FGN_BLOCK_SIZE_X,
+            FGN_BLOCK_SIZE_X);
+
+        generate_chroma_grain_blocks(ctxt,
+                                     pred_pos_chroma,
+                                     ctxt->luma_grain_block,
+                                     ctxt->cb_grain_block,
+                                     ctxt->cr_grain_block,
+                                     FGN_BLOCK_SIZE_X,
+                                     chroma_block_size_y,
+                                     chroma_block_size_x,
+                                     ctxt->chroma_grain_stride);
+
+        memset(ctxt->scaling_lut_y, 0, sizeof(ctxt->scaling_lut_y));
+        memset(ctxt->scaling_lut_cb, 0, sizeof(ctxt->scaling_lut_cb));
+        memset(ctxt->scaling_lut_cr, 0, sizeof(ctxt->scaling_lut_cr));
+
+        init_scaling_function(params->scaling_points_y, params->num_y_points, ctxt->scaling_lut_y);
+
+        if (params->chroma_scaling_from_luma) {
+            memcpy(ctxt->scaling_lut_cb, ctxt->scaling_lut_y, sizeof(ctxt->scaling_lut_y));
+            memcpy(ctxt->scaling_lut_cr, ctxt->scaling_lut_y, sizeof(ctxt->scaling_lut_y));
+        } else {
+            init_scaling_function(
+                params->scaling_points_cb, params->num_cb_points, ctxt->scaling_lut_cb);
+            init_scaling_function(
+                params->scaling_points_cr, params->num_cr_points, ctxt->scaling_lut_cr);
+        }
+        ctxt->templates_valid = EB_TRUE;
+    }
 
-    int32_t chroma_block_size_y =
-        top_pad + (2 >> chroma_subsamp_y) * ar_padding + chroma_subblock_size_y * 2 + bottom_pad;
-    int32_t chroma_block_size_x = left_pad + (2 >> chroma_subsamp_x) * ar_padding +
-                                  chroma_subblock_size_x * 2 +
-                                  (2 >> chroma_subsamp_x) * ar_padding + right_pad;
+    ctxt->width              = width;
+    ctxt->height             = height;
+    ctxt->luma_stride        = luma_stride;
+    ctxt->chroma_stride      = chroma_stride;
+    ctxt->use_high_bit_depth = use_high_bit_depth;
+    init_blend_params(ctxt);
+    // the line buffers of every slot are stale now
+    if (++ctxt->frame_id == 0) ++ctxt->frame_id;
 
-    int32_t luma_grain_stride   = luma_block_size_x;
-    int32_t chroma_grain_stride = chroma_block_size_x;
+    return EB_ErrorNone;
+}
 
-    int32_t overlap   = params->overlap_flag;
-    int32_t bit_depth = params->bit_depth;
+int32_t eb_av1_film_grain_stripe_count(const FilmGrainCtxt *ctxt) {
+    const int32_t stripe_height = luma_subblock_size_y >> 1;
+    return (ctxt->height / 2 + stripe_height - 1) / stripe_height;
+}
 
-    grain_center = 128 << (bit_depth - 8);
-    grain_min    = 0 - grain_center;
-    grain_max    = (256 << (bit_depth - 8)) - 1 - grain_center;
+// Address of the sample at offset in a plane of 8-bit or 16-bit samples
+static INLINE uint8_t *sample_ptr(uint8_t *plane, int32_t offset, int32_t use_high_bit_depth) {
+    return plane + ((intptr_t)offset << use_high_bit_depth);
+}
 
-    init_arrays(params,
-                luma_stride,
-                chroma_stride,
-                &pred_pos_luma,
-                &pred_pos_chroma,
-                &luma_grain_block,
-                &cb_grain_block,
-                &cr_grain_block,
-                &y_line_buf,
-                &cb_line_buf,
-                &cr_line_buf,
-                &y_col_buf,
-                &cb_col_buf,
-                &cr_col_buf,
-                luma_block_size_y * luma_block_size_x,
-                chroma_block_size_y * chroma_block_size_x,
-                chroma_subsamp_y,
-                chroma_subsamp_x);
-
-    generate_luma_grain_block(params,
-                              pred_pos_luma,
-                              luma_grain_block,
-                              luma_block_size_y,
-                              luma_block_size_x,
-                              luma_grain_stride,
-                              left_pad,
-                              top_pad,
-                              right_pad,
-                              bottom_pad);
-
-    generate_chroma_grain_blocks(params,
-                                 //                               pred_pos_luma,
-                                 pred_pos_chroma,
-                                 luma_grain_block,
-                                 cb_grain_block,
-                                 cr_grain_block,
+/* Adds the grain of the stripe at half luma row y. The line buffers hold the
+ * bottom rows of the stripe above on entry, and of this stripe on exit. With
+ * apply 0 only the buffers are updated, the planes are left untouched. */
+static void add_film_grain_rows(FilmGrainCtxt *ctxt, FgnStripeBufs *bufs, int32_t y,
+                                uint8_t *luma, uint8_t *cb, uint8_t *cr, int32_t apply) {
+    AomFilmGrain *params              = &ctxt->params;
+    int32_t       height              = ctxt->height;
+    int32_t       width               = ctxt->width;
+    int32_t       luma_stride         = ctxt->luma_stride;
+    int32_t       chroma_stride       = ctxt->chroma_stride;
+    int32_t       use_high_bit_depth  = ctxt->use_high_bit_depth;
+    int32_t       chroma_subsamp_y    = ctxt->chroma_subsamp_y;
+    int32_t       chroma_subsamp_x    = ctxt->chroma_subsamp_x;
+    int32_t       grain_min           = ctxt->grain_min;
+    int32_t       grain_max           = ctxt->grain_max;
+    int32_t       luma_grain_stride   = FGN_BLOCK_SIZE_X;
+    int32_t       chroma_grain_stride = ctxt->chroma_grain_stride;
+
+    int32_t chroma_subblock_size_y = luma_subblock_size_y >> chroma_subsamp_y;
+    int32_t chroma_subblock_size_x = luma_subblock_size_x >> chroma_subsamp_x;
+
+    int32_t *luma_grain_block = ctxt->luma_grain_block;
+    int32_t *cb_grain_block   = ctxt->cb_grain_block;
+    int32_t *cr_grain_block   = ctxt->cr_grain_block;
+
+    int32_t *y_line_buf  = bufs->y_line_buf;
+    int32_t *cb_line_buf = bufs->cb_line_buf;
+    int32_t *cr_line_buf = bufs->cr_line_buf;
+    int32_t *y_col_buf   = bufs->y_col_buf;
+    int32_t *cb_col_buf  = bufs->cb_col_buf;
+    int32_t *cr_col_buf  = bufs->cr_col_buf;
+
+    int32_t  overlap = params->overlap_flag;
+    uint16_t random_register;
+
+    init_random_generator(&random_register, y * 2, params->random_seed);
+
+    for (int32_t x = 0; x < width / 2; x += (luma_subblock_size_x >> 1)) {
+        int32_t offset_y = get_random_number(&random_register, 8);
+        int32_t offset_x = (offset_y >> 4) & 15;
+        offset_y &= 15;
+
+        int32_t luma_offset_y = left_pad + 2 * ar_padding + (offset_y << 1);
+        int32_t luma_offset_x = top_pad + 2 * ar_padding + (offset_x << 1);
+
+        int32_t chroma_offset_y =
+            top_pad + (2 >> chroma_subsamp_y) * ar_padding + offset_y * (2 >> chroma_subsamp_y);
+        int32_t chroma_offset_x =
+            left_pad + (2 >> chroma_subsamp_x) * ar_padding + offset_x * (2 >> chroma_subsamp_x);
+
+        if (overlap && x) {
+            ver_boundary_overlap(y_col_buf,
+                                 2,
+                                 luma_grain_block + luma_offset_y * luma_grain_stride +
+                                     luma_offset_x,
                                  luma_grain_stride,
-                                 chroma_block_size_y,
-                                 chroma_block_size_x,
-                                 chroma_grain_stride,
-                                 left_pad,
-                                 top_pad,
-                                 right_pad,
-                                 bottom_pad,
-                                 chroma_subsamp_y,
-                                 chroma_subsamp_x);
-
-    init_scaling_function(params->scaling_points_y, params->num_y_points, scaling_lut_y);
-
-    if (params->chroma_scaling_from_luma) {
-        memcpy(scaling_lut_cb, scaling_lut_y, sizeof(*scaling_lut_y) * 256);
-        memcpy(scaling_lut_cr, scaling_lut_y, sizeof(*scaling_lut_y) * 256);
-    } else {
-        init_scaling_function(params->scaling_points_cb, params->num_cb_points, scaling_lut_cb);
-        init_scaling_function(params->scaling_points_cr, params->num_cr_points, scaling_lut_cr);
-    }
-    for (int32_t y = 0; y < height / 2; y += (luma_subblock_size_y >> 1)) {
-        init_random_generator(y * 2, params->random_seed);
-
-        for (int32_t x = 0; x < width / 2; x += (luma_subblock_size_x >> 1)) {
-            int32_t offset_y = get_random_number(8);
-            int32_t offset_x = (offset_y >> 4) & 15;
-            offset_y &= 15;
-
-            int32_t luma_offset_y = left_pad + 2 * ar_padding + (offset_y << 1);
-            int32_t luma_offset_x = top_pad + 2 * ar_padding + (offset_x << 1);
-
-            int32_t chroma_offset_y =
-                top_pad + (2 >> chroma_subsamp_y) * ar_padding + offset_y * (2 >> chroma_subsamp_y);
-            int32_t chroma_offset_x = left_pad + (2 >> chroma_subsamp_x) * ar_padding +
-                                      offset_x * (2 >> chroma_subsamp_x);
-
-            if (overlap && x) {
-                ver_boundary_overlap(
-                    y_col_buf,
-                    2,
-                    luma_grain_block + luma_offset_y * luma_grain_stride + luma_offset_x,
-                    luma_grain_stride,
-                    y_col_buf,
-                    2,
+                                 y_col_buf,
+                                 2,
+                                 2,
+                                 AOMMIN(luma_subblock_size_y + 2, height - (y << 1)),
+                                 grain_min,
+                                 grain_max);
+
+            ver_boundary_overlap(
+                cb_col_buf,
+                2 >> chroma_subsamp_x,
+                cb_grain_block + chroma_offset_y * chroma_grain_stride + chroma_offset_x,
+                chroma_grain_stride,
+                cb_col_buf,
+                2 >> chroma_subsamp_x,
+                2 >> chroma_subsamp_x,
+                AOMMIN(chroma_subblock_size_y + (2 >> chroma_subsamp_y),
+                       (height - (y << 1)) >> chroma_subsamp_y),
+                grain_min,
+                grain_max);
+
+            ver_boundary_overlap(
+                cr_col_buf,
+                2 >> chroma_subsamp_x,
+                cr_grain_block + chroma_offset_y * chroma_grain_stride + chroma_offset_x,
+                chroma_grain_stride,
+                cr_col_buf,
+                2 >> chroma_subsamp_x,
+                2 >> chroma_subsamp_x,
+                AOMMIN(chroma_subblock_size_y + (2 >> chroma_subsamp_y),
+                       (height - (y << 1)) >> chroma_subsamp_y),
+                grain_min,
+                grain_max);
+
+            int32_t i = y ? 1 : 0;
+
+            if (apply) {
+                int32_t chroma_pos = ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
+                                     (x << (1 - chroma_subsamp_x));
+                add_noise_to_block(
+                    ctxt,
+                    sample_ptr(luma, ((y + i) << 1) * luma_stride + (x << 1), use_high_bit_depth),
+                    sample_ptr(cb, chroma_pos, use_high_bit_depth),
+                    sample_ptr(cr, chroma_pos, use_high_bit_depth),
+                    y_col_buf + i * 4,
+                    cb_col_buf + i * (2 - chroma_subsamp_y) * (2 - chroma_subsamp_x),
+                    cr_col_buf + i * (2 - chroma_subsamp_y) * (2 - chroma_subsamp_x),
                     2,
-                    AOMMIN(luma_subblock_size_y + 2, height - (y << 1)));
-
-                ver_boundary_overlap(
-                    cb_col_buf,
-                    2 >> chroma_subsamp_x,
-                    cb_grain_block + chroma_offset_y * chroma_grain_stride + chroma_offset_x,
-                    chroma_grain_stride,
-                    cb_col_buf,
-                    2 >> chroma_subsamp_x,
-                    2 >> chroma_subsamp_x,
-                    AOMMIN(chroma_subblock_size_y + (2 >> chroma_subsamp_y),
-                           (height - (y << 1)) >> chroma_subsamp_y));
-
-                ver_boundary_overlap(
-                    cr_col_buf,
-                    2 >> chroma_subsamp_x,
-                    cr_grain_block + chroma_offset_y * chroma_grain_stride + chroma_offset_x,
-                    chroma_grain_stride,
-                    cr_col_buf,
-                    2 >> chroma_subsamp_x,
-                    2 >> chroma_subsamp_x,
-                    AOMMIN(chroma_subblock_size_y + (2 >> chroma_subsamp_y),
-                           (height - (y << 1)) >> chroma_subsamp_y));
-
-                int32_t i = y ? 1 : 0;
-
-                if (use_high_bit_depth) {
-                    add_noise_to_block_hbd(
-                        params,
-                        (uint16_t *)luma + ((y + i) << 1) * luma_stride + (x << 1),
-                        (uint16_t *)cb + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                            (x << (1 - chroma_subsamp_x)),
-                        (uint16_t *)cr + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                            (x << (1 - chroma_subsamp_x)),
-                        luma_stride,
-                        chroma_stride,
-                        y_col_buf + i * 4,
-                        cb_col_buf + i * (2 - chroma_subsamp_y) * (2 - chroma_subsamp_x),
-                        cr_col_buf + i * (2 - chroma_subsamp_y) * (2 - chroma_subsamp_x),
-                        2,
-                        (2 - chroma_subsamp_x),
-                        AOMMIN(luma_subblock_size_y >> 1, height / 2 - y) - i,
-                        1,
-                        bit_depth,
-                        chroma_subsamp_y,
-                        chroma_subsamp_x);
-                } else {
-                    add_noise_to_block(
-                        params,
-                        luma + ((y + i) << 1) * luma_stride + (x << 1),
-                        cb + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                            (x << (1 - chroma_subsamp_x)),
-                        cr + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                            (x << (1 - chroma_subsamp_x)),
-                        luma_stride,
-                        chroma_stride,
-                        y_col_buf + i * 4,
-                        cb_col_buf + i * (2 - chroma_subsamp_y) * (2 - chroma_subsamp_x),
-                        cr_col_buf + i * (2 - chroma_subsamp_y) * (2 - chroma_subsamp_x),
-                        2,
-                        (2 - chroma_subsamp_x),
-                        AOMMIN(luma_subblock_size_y >> 1, height / 2 - y) - i,
-                        1,
-                        bit_depth,
-                        chroma_subsamp_y,
-                        chroma_subsamp_x);
-                }
+                    (2 - chroma_subsamp_x),
+                    AOMMIN(luma_subblock_size_y >> 1, height / 2 - y) - i,
+                    1);
             }
+        }
 
-            if (overlap && y) {
-                if (x) {
-                    ASSERT(y_col_buf != NULL);
-                    hor_boundary_overlap(y_line_buf + (x << 1),
-                                         luma_stride,
-                                         y_col_buf,
-                                         2,
-                                         y_line_buf + (x << 1),
-                                         luma_stride,
-                                         2,
-                                         2);
-
-                    hor_boundary_overlap(cb_line_buf + x * (2 >> chroma_subsamp_x),
-                                         chroma_stride,
-                                         cb_col_buf,
-                                         2 >> chroma_subsamp_x,
-                                         cb_line_buf + x * (2 >> chroma_subsamp_x),
-                                         chroma_stride,
-                                         2 >> chroma_subsamp_x,
-                                         2 >> chroma_subsamp_y);
-
-                    hor_boundary_overlap(cr_line_buf + x * (2 >> chroma_subsamp_x),
-                                         chroma_stride,
-                                         cr_col_buf,
-                                         2 >> chroma_subsamp_x,
-                                         cr_line_buf + x * (2 >> chroma_subsamp_x),
-                                         chroma_stride,
-                                         2 >> chroma_subsamp_x,
-                                         2 >> chroma_subsamp_y);
-                }
-
-                hor_boundary_overlap(y_line_buf + ((x ? x + 1 : 0) << 1),
+        if (overlap && y && apply) {
+            if (x) {
+                hor_boundary_overlap(y_line_buf + (x << 1),
                                      luma_stride,
-                                     luma_grain_block + luma_offset_y * luma_grain_stride +
-                                         luma_offset_x + (x ? 2 : 0),
-                                     luma_grain_stride,
-                                     y_line_buf + ((x ? x + 1 : 0) << 1),
+                                     y_col_buf,
+                                     2,
+                                     y_line_buf + (x << 1),
                                      luma_stride,
-                                     AOMMIN(luma_subblock_size_x - ((x ? 1 : 0) << 1),
-                                            width - ((x ? x + 1 : 0) << 1)),
-                                     2);
-
-                hor_boundary_overlap(
-                    cb_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
-                    chroma_stride,
-                    cb_grain_block + chroma_offset_y * chroma_grain_stride + chroma_offset_x +
-                        ((x ? 1 : 0) << (1 - chroma_subsamp_x)),
-                    chroma_grain_stride,
-                    cb_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
-                    chroma_stride,
-                    AOMMIN(chroma_subblock_size_x - ((x ? 1 : 0) << (1 - chroma_subsamp_x)),
-                           (width - ((x ? x + 1 : 0) << 1)) >> chroma_subsamp_x),
-                    2 >> chroma_subsamp_y);
-
-                hor_boundary_overlap(
-                    cr_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
-                    chroma_stride,
-                    cr_grain_block + chroma_offset_y * chroma_grain_stride + chroma_offset_x +
-                        ((x ? 1 : 0) << (1 - chroma_subsamp_x)),
-                    chroma_grain_stride,
-                    cr_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
-                    chroma_stride,
-                    AOMMIN(chroma_subblock_size_x - ((x ? 1 : 0) << (1 - chroma_subsamp_x)),
-                           (width - ((x ? x + 1 : 0) << 1)) >> chroma_subsamp_x),
-                    2 >> chroma_subsamp_y);
-
-                if (use_high_bit_depth) {
-                    add_noise_to_block_hbd(
-                        params,
-                        (uint16_t *)luma + (y << 1) * luma_stride + (x << 1),
-                        (uint16_t *)cb + (y << (1 - chroma_subsamp_y)) * chroma_stride +
-                            (x << ((1 - chroma_subsamp_x))),
-                        (uint16_t *)cr + (y << (1 - chroma_subsamp_y)) * chroma_stride +
-                            (x << ((1 - chroma_subsamp_x))),
-                        luma_stride,
-                        chroma_stride,
-                        y_line_buf + (x << 1),
-                        cb_line_buf + (x << (1 - chroma_subsamp_x)),
-                        cr_line_buf + (x << (1 - chroma_subsamp_x)),
-                        luma_stride,
-                        chroma_stride,
-                        1,
-                        AOMMIN(luma_subblock_size_x >> 1, width / 2 - x),
-                        bit_depth,
-                        chroma_subsamp_y,
-                        chroma_subsamp_x);
-                } else {
-                    add_noise_to_block(params,
-                                       luma + (y << 1) * luma_stride + (x << 1),
-                                       cb + (y << (1 - chroma_subsamp_y)) * chroma_stride +
-                                           (x << ((1 - chroma_subsamp_x))),
-                                       cr + (y << (1 - chroma_subsamp_y)) * chroma_stride +
-                                           (x << ((1 - chroma_subsamp_x))),
-                                       luma_stride,
-                                       chroma_stride,
-                                       y_line_buf + (x << 1),
-                                       cb_line_buf + (x << (1 - chroma_subsamp_x)),
-                                       cr_line_buf + (x << (1 - chroma_subsamp_x)),
-                                       luma_stride,
-                                       chroma_stride,
-                                       1,
-                                       AOMMIN(luma_subblock_size_x >> 1, width / 2 - x),
-                                       bit_depth,
-                                       chroma_subsamp_y,
-                                       chroma_subsamp_x);
-                }
+                                     2,
+                                     2,
+                                     grain_min,
+                                     grain_max);
+
+                hor_boundary_overlap(cb_line_buf + x * (2 >> chroma_subsamp_x),
+                                     chroma_stride,
+                                     cb_col_buf,
+                                     2 >> chroma_subsamp_x,
+                                     cb_line_buf + x * (2 >> chroma_subsamp_x),
+                                     chroma_stride,
+                                     2 >> chroma_subsamp_x,
+                                     2 >> chroma_subsamp_y,
+                                     grain_min,
+                                     grain_max);
+
+                hor_boundary_overlap(cr_line_buf + x * (2 >> chroma_subsamp_x),
+                                     chroma_stride,
+                                     cr_col_buf,
+                                     2 >> chroma_subsamp_x,
+                                     cr_line_buf + x * (2 >> chroma_subsamp_x),
+                                     chroma_stride,
+                                     2 >> chroma_subsamp_x,
+                                     2 >> chroma_subsamp_y,
+                                     grain_min,
+                                     grain_max);
             }
 
+            hor_boundary_overlap(y_line_buf + ((x ? x + 1 : 0) << 1),
+                                 luma_stride,
+                                 luma_grain_block + luma_offset_y * luma_grain_stride +
+                                     luma_offset_x + (x ? 2 : 0),
+                                 luma_grain_stride,
+                                 y_line_buf + ((x ? x + 1 : 0) << 1),
+                                 luma_stride,
+                                 AOMMIN(luma_subblock_size_x - ((x ? 1 : 0) << 1),
+                                        width - ((x ? x + 1 : 0) << 1)),
+                                 2,
+                                 grain_min,
+                                 grain_max);
+
+            hor_boundary_overlap(
+                cb_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
+                chroma_stride,
+                cb_grain_block + chroma_offset_y * chroma_grain_stride + chroma_offset_x +
+                    ((x ? 1 : 0) << (1 - chroma_subsamp_x)),
+                chroma_grain_stride,
+                cb_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
+                chroma_stride,
+                AOMMIN(chroma_subblock_size_x - ((x ? 1 : 0) << (1 - chroma_subsamp_x)),
+                       (width - ((x ? x + 1 : 0) << 1)) >> chroma_subsamp_x),
+                2 >> chroma_subsamp_y,
+                grain_min,
+                grain_max);
+
+            hor_boundary_overlap(
+                cr_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
+                chroma_stride,
+                cr_grain_block + chroma_offset_y * chroma_grain_stride + chroma_offset_x +
+                    ((x ? 1 : 0) << (1 - chroma_subsamp_x)),
+                chroma_grain_stride,
+                cr_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
+                chroma_stride,
+                AOMMIN(chroma_subblock_size_x - ((x ? 1 : 0) << (1 - chroma_subsamp_x)),
+                       (width - ((x ? x + 1 : 0) << 1)) >> chroma_subsamp_x),
+                2 >> chroma_subsamp_y,
+                grain_min,
+                grain_max);
+
+            int32_t chroma_pos =
+                (y << (1 - chroma_subsamp_y)) * chroma_stride + (x << (1 - chroma_subsamp_x));
+            add_noise_to_block(
+                ctxt,
+                sample_ptr(luma, (y << 1) * luma_stride + (x << 1), use_high_bit_depth),
+                sample_ptr(cb, chroma_pos, use_high_bit_depth),
+                sample_ptr(cr, chroma_pos, use_high_bit_depth),
+                y_line_buf + (x << 1),
+                cb_line_buf + (x << (1 - chroma_subsamp_x)),
+                cr_line_buf + (x << (1 - chroma_subsamp_x)),
+                luma_stride,
+                chroma_stride,
+                1,
+                AOMMIN(luma_subblock_size_x >> 1, width / 2 - x));
+        }
+
+        if (apply) {
             int32_t i = overlap && y ? 1 : 0;
             int32_t j = overlap && x ? 1 : 0;
 
-            if (use_high_bit_depth) {
-                add_noise_to_block_hbd(
-                    params,
-                    (uint16_t *)luma + ((y + i) << 1) * luma_stride + ((x + j) << 1),
-                    (uint16_t *)cb + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                        ((x + j) << (1 - chroma_subsamp_x)),
-                    (uint16_t *)cr + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                        ((x + j) << (1 - chroma_subsamp_x)),
-                    luma_stride,
-                    chroma_stride,
-                    luma_grain_block + (luma_offset_y + (i << 1)) * luma_grain_stride +
-                        luma_offset_x + (j << 1),
-                    cb_grain_block +
-                        (chroma_offset_y + (i << (1 - chroma_subsamp_y))) * chroma_grain_stride +
-                        chroma_offset_x + (j << (1 - chroma_subsamp_x)),
-                    cr_grain_block +
-                        (chroma_offset_y + (i << (1 - chroma_subsamp_y))) * chroma_grain_stride +
-                        chroma_offset_x + (j << (1 - chroma_subsamp_x)),
-                    luma_grain_stride,
-                    chroma_grain_stride,
-                    AOMMIN(luma_subblock_size_y >> 1, height / 2 - y) - i,
-                    AOMMIN(luma_subblock_size_x >> 1, width / 2 - x) - j,
-                    bit_depth,
-                    chroma_subsamp_y,
-                    chroma_subsamp_x);
-            } else {
-                add_noise_to_block(
-                    params,
-                    luma + ((y + i) << 1) * luma_stride + ((x + j) << 1),
-                    cb + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                        ((x + j) << (1 - chroma_subsamp_x)),
-                    cr + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                        ((x + j) << (1 - chroma_subsamp_x)),
-                    luma_stride,
-                    chroma_stride,
-                    luma_grain_block + (luma_offset_y + (i << 1)) * luma_grain_stride +
-                        luma_offset_x + (j << 1),
-                    cb_grain_block +
-                        (chroma_offset_y + (i << (1 - chroma_subsamp_y))) * chroma_grain_stride +
-                        chroma_offset_x + (j << (1 - chroma_subsamp_x)),
-                    cr_grain_block +
-                        (chroma_offset_y + (i << (1 - chroma_subsamp_y))) * chroma_grain_stride +
-                        chroma_offset_x + (j << (1 - chroma_subsamp_x)),
-                    luma_grain_stride,
-                    chroma_grain_stride,
-                    AOMMIN(luma_subblock_size_y >> 1, height / 2 - y) - i,
-                    AOMMIN(luma_subblock_size_x >> 1, width / 2 - x) - j,
-                    bit_depth,
-                    chroma_subsamp_y,
-                    chroma_subsamp_x);
-            }
-
-            if (overlap) {
-                if (x) {
-                    // Copy overlapped column bufer to line buffer
-                    copy_area(y_col_buf + (luma_subblock_size_y << 1),
-                              2,
-                              y_line_buf + (x << 1),
-                              luma_stride,
-                              2,
-                              2);
-
-                    copy_area(cb_col_buf + (chroma_subblock_size_y << (1 - chroma_subsamp_x)),
-                              2 >> chroma_subsamp_x,
-                              cb_line_buf + (x << (1 - chroma_subsamp_x)),
-                              chroma_stride,
-                              2 >> chroma_subsamp_x,
-                              2 >> chroma_subsamp_y);
-
-                    copy_area(cr_col_buf + (chroma_subblock_size_y << (1 - chroma_subsamp_x)),
-                              2 >> chroma_subsamp_x,
-                              cr_line_buf + (x << (1 - chroma_subsamp_x)),
-                              chroma_stride,
-                              2 >> chroma_subsamp_x,
-                              2 >> chroma_subsamp_y);
-                }
+            int32_t chroma_pos = ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
+                                 ((x + j) << (1 - chroma_subsamp_x));
+            add_noise_to_block(
+                ctxt,
+                sample_ptr(luma,
+                           ((y + i) << 1) * luma_stride + ((x + j) << 1),
+                           use_high_bit_depth),
+                sample_ptr(cb, chroma_pos, use_high_bit_depth),
+                sample_ptr(cr, chroma_pos, use_high_bit_depth),
+                luma_grain_block + (luma_offset_y + (i << 1)) * luma_grain_stride +
+                    luma_offset_x + (j << 1),
+                cb_grain_block +
+                    (chroma_offset_y + (i << (1 - chroma_subsamp_y))) * chroma_grain_stride +
+                    chroma_offset_x + (j << (1 - chroma_subsamp_x)),
+                cr_grain_block +
+                    (chroma_offset_y + (i << (1 - chroma_subsamp_y))) * chroma_grain_stride +
+                    chroma_offset_x + (j << (1 - chroma_subsamp_x)),
+                luma_grain_stride,
+                chroma_grain_stride,
+                AOMMIN(luma_subblock_size_y >> 1, height / 2 - y) - i,
+                AOMMIN(luma_subblock_size_x >> 1, width / 2 - x) - j);
+        }
 
-                // Copy grain to the line buffer for overlap with a bottom block
-                copy_area(luma_grain_block +
-                              (luma_offset_y + luma_subblock_size_y) * luma_grain_stride +
-                              luma_offset_x + ((x ? 2 : 0)),
-                          luma_grain_stride,
-                          y_line_buf + ((x ? x + 1 : 0) << 1),
+        if (overlap) {
+            if (x) {
+                // Copy overlapped column bufer to line buffer
+                copy_area(y_col_buf + (luma_subblock_size_y << 1),
+                          2,
+                          y_line_buf + (x << 1),
                           luma_stride,
-                          AOMMIN(luma_subblock_size_x, width - (x << 1)) - (x ? 2 : 0),
+                          2,
                           2);
 
-                copy_area(cb_grain_block +
-                              (chroma_offset_y + chroma_subblock_size_y) * chroma_grain_stride +
-                              chroma_offset_x + (x ? 2 >> chroma_subsamp_x : 0),
-                          chroma_grain_stride,
-                          cb_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
+                copy_area(cb_col_buf + (chroma_subblock_size_y << (1 - chroma_subsamp_x)),
+                          2 >> chroma_subsamp_x,
+                          cb_line_buf + (x << (1 - chroma_subsamp_x)),
                           chroma_stride,
-                          AOMMIN(chroma_subblock_size_x, ((width - (x << 1)) >> chroma_subsamp_x)) -
-                              (x ? 2 >> chroma_subsamp_x : 0),
+                          2 >> chroma_subsamp_x,
                           2 >> chroma_subsamp_y);
 
-                copy_area(cr_grain_block +
-                              (chroma_offset_y + chroma_subblock_size_y) * chroma_grain_stride +
-                              chroma_offset_x + (x ? 2 >> chroma_subsamp_x : 0),
-                          chroma_grain_stride,
-                          cr_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
+                copy_area(cr_col_buf + (chroma_subblock_size_y << (1 - chroma_subsamp_x)),
+                          2 >> chroma_subsamp_x,
+                          cr_line_buf + (x << (1 - chroma_subsamp_x)),
                           chroma_stride,
-                          AOMMIN(chroma_subblock_size_x, ((width - (x << 1)) >> chroma_subsamp_x)) -
-                              (x ? 2 >> chroma_subsamp_x : 0),
+                          2 >> chroma_subsamp_x,
                           2 >> chroma_subsamp_y);
+            }
+
+            // Copy grain to the line buffer for overlap with a bottom block
+            copy_area(luma_grain_block +
+                          (luma_offset_y + luma_subblock_size_y) * luma_grain_stride +
+                          luma_offset_x + ((x ? 2 : 0)),
+                      luma_grain_stride,
+                      y_line_buf + ((x ? x + 1 : 0) << 1),
+                      luma_stride,
+                      AOMMIN(luma_subblock_size_x, width - (x << 1)) - (x ? 2 : 0),
+                      2);
+
+            copy_area(cb_grain_block +
+                          (chroma_offset_y + chroma_subblock_size_y) * chroma_grain_stride +
+                          chroma_offset_x + (x ? 2 >> chroma_subsamp_x : 0),
+                      chroma_grain_stride,
+                      cb_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
+                      chroma_stride,
+                      AOMMIN(chroma_subblock_size_x, ((width - (x << 1)) >> chroma_subsamp_x)) -
+                          (x ? 2 >> chroma_subsamp_x : 0),
+                      2 >> chroma_subsamp_y);
+
+            copy_area(cr_grain_block +
+                          (chroma_offset_y + chroma_subblock_size_y) * chroma_grain_stride +
+                          chroma_offset_x + (x ? 2 >> chroma_subsamp_x : 0),
+                      chroma_grain_stride,
+                      cr_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
+                      chroma_stride,
+                      AOMMIN(chroma_subblock_size_x, ((width - (x << 1)) >> chroma_subsamp_x)) -
+                          (x ? 2 >> chroma_subsamp_x : 0),
+                      2 >> chroma_subsamp_y);
+
+            // Copy grain to the column buffer for overlap with the next block to
+            // the right
+
+            copy_area(luma_grain_block + luma_offset_y * luma_grain_stride + luma_offset_x +
+                          luma_subblock_size_x,
+                      luma_grain_stride,
+                      y_col_buf,
+                      2,
+                      2,
+                      AOMMIN(luma_subblock_size_y + 2, height - (y << 1)));
+
+            copy_area(cb_grain_block + chroma_offset_y * chroma_grain_stride + chroma_offset_x +
+                          chroma_subblock_size_x,
+                      chroma_grain_stride,
+                      cb_col_buf,
+                      2 >> chroma_subsamp_x,
+                      2 >> chroma_subsamp_x,
+                      AOMMIN(chroma_subblock_size_y + (2 >> chroma_subsamp_y),
+                             (height - (y << 1)) >> chroma_subsamp_y));
+
+            copy_area(cr_grain_block + chroma_offset_y * chroma_grain_stride + chroma_offset_x +
+                          chroma_subblock_size_x,
+                      chroma_grain_stride,
+                      cr_col_buf,
+                      2 >> chroma_subsamp_x,
+                      2 >> chroma_subsamp_x,
+                      AOMMIN(chroma_subblock_size_y + (2 >> chroma_subsamp_y),
+                             (height - (y << 1)) >> chroma_subsamp_y));
+        }
+    }
+}
 
-                // Copy grain to the column buffer for overlap with the next block to
-                // the right
+void eb_av1_add_film_grain_stripe(FilmGrainCtxt *ctxt, uint32_t slot, int32_t stripe,
+                                  uint8_t *luma, uint8_t *cb, uint8_t *cr) {
+    FgnStripeBufs *bufs          = &ctxt->slots[slot];
+    const int32_t  stripe_height = luma_subblock_size_y >> 1;
 
-                copy_area(luma_grain_block + luma_offset_y * luma_grain_stride + luma_offset_x +
-                              luma_subblock_size_x,
-                          luma_grain_stride,
-                          y_col_buf,
-                          2,
-                          2,
-                          AOMMIN(luma_subblock_size_y + 2, height - (y << 1)));
+    // rebuild the bottom rows of the stripe above when another slot ran it
+    if (ctxt->params.overlap_flag && stripe &&
+        (bufs->frame_id != ctxt->frame_id || bufs->last_stripe != stripe - 1))
+        add_film_grain_rows(ctxt, bufs, (stripe - 1) * stripe_height, luma, cb, cr, 0);
 
-                copy_area(cb_grain_block + chroma_offset_y * chroma_grain_stride + chroma_offset_x +
-                              chroma_subblock_size_x,
-                          chroma_grain_stride,
-                          cb_col_buf,
-                          2 >> chroma_subsamp_x,
-                          2 >> chroma_subsamp_x,
-                          AOMMIN(chroma_subblock_size_y + (2 >> chroma_subsamp_y),
-                                 (height - (y << 1)) >> chroma_subsamp_y));
+    add_film_grain_rows(ctxt, bufs, stripe * stripe_height, luma, cb, cr, 1);
 
-                copy_area(cr_grain_block + chroma_offset_y * chroma_grain_stride + chroma_offset_x +
-                              chroma_subblock_size_x,
-                          chroma_grain_stride,
-                          cr_col_buf,
-                          2 >> chroma_subsamp_x,
-                          2 >> chroma_subsamp_x,
-                          AOMMIN(chroma_subblock_size_y + (2 >> chroma_subsamp_y),
-                                 (height - (y << 1)) >> chroma_subsamp_y));
-            }
-        }
+    bufs->frame_id    = ctxt->frame_id;
+    bufs->last_stripe = stripe;
+}
+
+void eb_av1_add_film_grain_run(AomFilmGrain *params, uint8_t *luma, uint8_t *cb, uint8_t *cr,
+                               int32_t height, int32_t width, int32_t luma_stride,
+                               int32_t chroma_stride, int32_t use_high_bit_depth,
+                               int32_t chroma_subsamp_y, int32_t chroma_subsamp_x) {
+    FilmGrainCtxt *ctxt = eb_av1_film_grain_ctxt_alloc(1);
+
+    if (ctxt == NULL || eb_av1_film_grain_prepare(ctxt,
+                                                  params,
+                                                  width,
+                                                  height,
+                                                  luma_stride,
+                                                  chroma_stride,
+                                                  use_high_bit_depth,
+                                                  chroma_subsamp_y,
+                                                  chroma_subsamp_x) != EB_ErrorNone) {
+        SVT_LOG("Film grain synthesis: out of memory, the grain is not added\n");
+        eb_av1_film_grain_ctxt_free(ctxt);
+        return;
     }
 
-    dealloc_arrays(params,
-                   &pred_pos_luma,
-                   &pred_pos_chroma,
-                   &luma_grain_block,
-                   &cb_grain_block,
-                   &cr_grain_block,
-                   &y_line_buf,
-                   &cb_line_buf,
-                   &cr_line_buf,
-                   &y_col_buf,
-                   &cb_col_buf,
-                   &cr_col_buf);
+    const int32_t num_stripes = eb_av1_film_grain_stripe_count(ctxt);
+    for (int32_t stripe = 0; stripe < num_stripes; stripe++)
+        eb_av1_add_film_grain_stripe(ctxt, 0, stripe, luma, cb, cr);
+
+    eb_av1_film_grain_ctxt_free(ctxt);
 }
 
+
 /*
 void av1_film_grain_write_updated(const AomFilmGrain *pars,
                                   int32_t monochrome,
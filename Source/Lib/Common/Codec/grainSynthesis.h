@@ -84,6 +84,122 @@ typedef struct {
 
 int32_t film_grain_params_equal(AomFilmGrain *pars_a, AomFilmGrain *pars_b);
 
+// Grain templates are generated with padding for the AR filter:
+// 73x82 samples for luma, as much at most for 4:4:4 chroma
+#define FGN_BLOCK_SIZE_Y 73
+#define FGN_BLOCK_SIZE_X 82
+// Column overlap buffer: two 34-sample columns
+#define FGN_COL_BUF_SIZE 68
+
+/*!\brief Noise blending constants of one plane
+     *
+     * The blended sample is clamp(s + ((scale * grain + round) >> scaling_shift),
+     * min_value, max_value), scale is read from scaling_lut, interpolated above
+     * 8 bits. For chroma, the scaling function is indexed by
+     * ((average_luma * luma_mult + mult * s) >> 6) + offset.
+     */
+typedef struct FgnBlendParams {
+    const int32_t *scaling_lut;
+    int32_t        scaling_shift;
+    int32_t        bit_depth;
+    int32_t        min_value;
+    int32_t        max_value;
+    int32_t        luma_mult;
+    int32_t        mult;
+    int32_t        offset;
+    int32_t        subsamp_x;
+    int32_t        subsamp_y;
+} FgnBlendParams;
+
+/*!\brief Overlap buffers of one thread adding film grain
+     *
+     * The line buffers carry the bottom grain rows of a stripe to the next one.
+     * When the previous stripe was not run on the same buffers, its rows are
+     * rebuilt first, so that stripes can be processed in any order.
+     */
+typedef struct FgnStripeBufs {
+    int32_t *y_line_buf;
+    int32_t *cb_line_buf;
+    int32_t *cr_line_buf;
+    int32_t  y_col_buf[FGN_COL_BUF_SIZE];
+    int32_t  cb_col_buf[FGN_COL_BUF_SIZE];
+    int32_t  cr_col_buf[FGN_COL_BUF_SIZE];
+    // Last stripe run on these buffers, and the frame it belonged to
+    uint32_t frame_id;
+    int32_t  last_stripe;
+} FgnStripeBufs;
+
+/*!\brief Film grain synthesis state, reused across frames
+     *
+     * The grain templates and scaling functions are regenerated only when the
+     * parameters change. A frame is split in stripes of 32 luma rows that can
+     * run concurrently, each thread on its own slot of overlap buffers.
+     */
+typedef struct FilmGrainCtxt {
+    // Parameters the templates were generated for
+    AomFilmGrain params;
+    EbBool       templates_valid;
+    int32_t      chroma_subsamp_y;
+    int32_t      chroma_subsamp_x;
+    int32_t      chroma_grain_stride;
+    int32_t      grain_min;
+    int32_t      grain_max;
+    int32_t      scaling_lut_y[256];
+    int32_t      scaling_lut_cb[256];
+    int32_t      scaling_lut_cr[256];
+    int32_t      luma_grain_block[FGN_BLOCK_SIZE_Y * FGN_BLOCK_SIZE_X];
+    int32_t      cb_grain_block[FGN_BLOCK_SIZE_Y * FGN_BLOCK_SIZE_X];
+    int32_t      cr_grain_block[FGN_BLOCK_SIZE_Y * FGN_BLOCK_SIZE_X];
+
+    // Current frame
+    uint32_t       frame_id;
+    int32_t        width;
+    int32_t        height;
+    int32_t        luma_stride;
+    int32_t        chroma_stride;
+    int32_t        use_high_bit_depth;
+    FgnBlendParams blend_y;
+    FgnBlendParams blend_cb;
+    FgnBlendParams blend_cr;
+
+    // Overlap buffers, the line buffers hold line_stride samples per row
+    uint32_t       num_slots;
+    int32_t        luma_line_stride;
+    int32_t        chroma_line_stride;
+    FgnStripeBufs *slots;
+} FilmGrainCtxt;
+
+/*!\brief Allocate a film grain context with num_slots overlap buffers */
+FilmGrainCtxt *eb_av1_film_grain_ctxt_alloc(uint32_t num_slots);
+void           eb_av1_film_grain_ctxt_free(FilmGrainCtxt *ctxt);
+
+/*!\brief Set up a frame of film grain
+     *
+     * Regenerates the grain templates when the parameters differ from the
+     * previous frame, and grows the overlap buffers to the strides.
+     *
+     * \param[in]    ctxt             Film grain context
+     * \param[in]    grain_params     Grain parameters of the frame
+     * \param[in]    width            luma plane width
+     * \param[in]    height           luma plane height
+     * \param[in]    luma_stride      luma plane stride
+     * \param[in]    chroma_stride    chroma plane stride
+     */
+EbErrorType eb_av1_film_grain_prepare(FilmGrainCtxt *ctxt, AomFilmGrain *grain_params,
+                                      int32_t width, int32_t height, int32_t luma_stride,
+                                      int32_t chroma_stride, int32_t use_high_bit_depth,
+                                      int32_t chroma_subsamp_y, int32_t chroma_subsamp_x);
+
+/*!\brief Number of stripes of the frame set up by eb_av1_film_grain_prepare() */
+int32_t eb_av1_film_grain_stripe_count(const FilmGrainCtxt *ctxt);
+
+/*!\brief Add film grain to one stripe of the frame set up by
+     * eb_av1_film_grain_prepare(), using the overlap buffers of slot. Stripes
+     * may run in any order, concurrently on distinct slots.
+     */
+void eb_av1_add_film_grain_stripe(FilmGrainCtxt *ctxt, uint32_t slot, int32_t stripe,
+                                  uint8_t *luma, uint8_t *cb, uint8_t *cr);
+
 /*!\brief Add film grain
      *
      * Add film grain to an image
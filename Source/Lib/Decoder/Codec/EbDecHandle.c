@@ -32,6 +32,7 @@
 #endif
 
 #include "../../Encoder/Codec/aom_dsp_rtcd.h"
+#include "common_dsp_rtcd.h"
 
 #include "EbLog.h"
 
@@ -73,9 +74,17 @@ void        asm_set_convolve_hbd_asm_table(void);
 void        init_intra_predictors_internal(void);
 extern void av1_init_wedge_masks(void);
 void        dec_sync_all_threads(EbDecHandle *dec_handle_ptr);
+EbErrorType dec_add_film_grain(EbDecHandle *dec_handle_ptr, AomFilmGrain *film_grain_ptr,
+                               uint8_t *luma, uint8_t *cb, uint8_t *cr, int32_t height,
+                               int32_t width, int32_t luma_stride, int32_t chroma_stride,
+                               int32_t use_high_bit_depth, int32_t chroma_subsamp_y,
+                               int32_t chroma_subsamp_x);
 
 EbErrorType decode_multiple_obu(EbDecHandle *dec_handle_ptr, uint8_t **data, size_t data_size,
                                 uint32_t is_annexb);
+EbErrorType dec_frame_slots_init(EbDecHandle *dec_handle_ptr);
+void        dec_frame_slots_drain(EbDecHandle *dec_handle_ptr);
+void        dec_frame_slots_deinit(EbDecHandle *dec_handle_ptr);
 
 void switch_to_real_time() {
 #ifndef _WIN32
@@ -111,28 +120,112 @@ static EbErrorType eb_dec_handle_ctor(EbDecHandle **decHandleDblPtr, EbComponent
     svt_dec_lib_malloc_count = 0;
 
     dec_handle_ptr->start_thread_process = EB_FALSE;
+    dec_handle_ptr->film_grain_ctxt      = NULL;
+    dec_handle_ptr->frame_slots          = NULL;
+    dec_handle_ptr->num_out_pics         = 0;
+    dec_handle_ptr->progress_semaphore   = NULL;
+    dec_handle_ptr->pv_pic_mgr           = NULL;
+    dec_handle_ptr->ext_fb_alloc         = NULL;
+    dec_handle_ptr->ext_fb_release       = NULL;
+    dec_handle_ptr->ext_fb_priv          = NULL;
 
     return return_error;
 }
 
+/* Copies ht rows of wd samples */
+static void dec_copy_plane(uint8_t *dst, uint32_t dst_stride, const uint8_t *src,
+                           uint32_t src_stride, uint32_t wd, uint32_t ht,
+                           int32_t use_high_bit_depth) {
+    for (uint32_t i = 0; i < ht; i++) {
+        memcpy(dst, src, wd << use_high_bit_depth);
+        dst += dst_stride << use_high_bit_depth;
+        src += src_stride << use_high_bit_depth;
+    }
+}
+
+static void dec_out_subsampling(EbColorFormat color_format, uint32_t *sx, uint32_t *sy) {
+    switch (color_format) {
+    case EB_YUV400:
+        *sx = -1;
+        *sy = -1;
+        break;
+    case EB_YUV420:
+        *sx = 1;
+        *sy = 1;
+        break;
+    case EB_YUV422:
+        *sx = 1;
+        *sy = 0;
+        break;
+    case EB_YUV444:
+        *sx = 0;
+        *sy = 0;
+        break;
+    default: assert(0);
+    }
+}
+
+/* Top left visible sample of each plane of a picture buffer */
+static void dec_pic_origin(EbPictureBufferDesc *pic, uint32_t sx, uint32_t sy,
+                           int32_t use_high_bit_depth, uint8_t **luma, uint8_t **cb,
+                           uint8_t **cr) {
+    *luma = pic->buffer_y +
+            ((pic->origin_x + pic->origin_y * pic->stride_y) << use_high_bit_depth);
+    if (pic->color_format == EB_YUV400) {
+        *cb = NULL;
+        *cr = NULL;
+        return;
+    }
+    *cb = pic->buffer_cb +
+          (((pic->origin_x >> sx) + (pic->origin_y >> sy) * pic->stride_cb) << use_high_bit_depth);
+    *cr = pic->buffer_cr +
+          (((pic->origin_x >> sx) + (pic->origin_y >> sy) * pic->stride_cr) << use_high_bit_depth);
+}
+
+static int dec_out_has_film_grain(EbDecHandle *dec_handle_ptr, DecOutPic *out_pic) {
+    return !dec_handle_ptr->dec_config.skip_film_grain && out_pic->film_grain_params.apply_grain;
+}
+
+/* Adds the film grain of the output picture to its planes */
+static void dec_out_film_grain(EbDecHandle *dec_handle_ptr, DecOutPic *out_pic,
+                               EbBitDepthEnum bit_depth, uint8_t *luma, uint8_t *cb, uint8_t *cr,
+                               uint32_t ht, uint32_t wd, uint32_t luma_stride,
+                               uint32_t chroma_stride, uint32_t sy, uint32_t sx) {
+    AomFilmGrain *film_grain_ptr = &out_pic->film_grain_params;
+    switch (bit_depth) {
+    case EB_8BIT: film_grain_ptr->bit_depth = 8; break;
+    case EB_10BIT: film_grain_ptr->bit_depth = 10; break;
+    default: assert(0);
+    }
+
+    if (dec_add_film_grain(dec_handle_ptr,
+                           film_grain_ptr,
+                           luma,
+                           cb,
+                           cr,
+                           ht,
+                           wd,
+                           luma_stride,
+                           chroma_stride,
+                           bit_depth == EB_8BIT ? 0 : 1,
+                           sy,
+                           sx) != EB_ErrorNone)
+        SVT_LOG("Film grain synthesis: out of memory, the grain is not added\n");
+}
+
 /* Copy from recon buffer to out buffer! */
-int svt_dec_out_buf(EbDecHandle *dec_handle_ptr, EbBufferHeaderType *p_buffer) {
-    EbPictureBufferDesc *recon_picture_buf = dec_handle_ptr->cur_pic_buf[0]->ps_pic_buf;
+static int svt_dec_out_buf(EbDecHandle *dec_handle_ptr, DecOutPic *out_pic,
+                           EbBufferHeaderType *p_buffer) {
+    EbPictureBufferDesc *recon_picture_buf = out_pic->pic_buf->ps_pic_buf;
     EbSvtIOFormat *      out_img           = (EbSvtIOFormat *)p_buffer->p_buffer;
 
     uint8_t *luma = NULL;
     uint8_t *cb   = NULL;
     uint8_t *cr   = NULL;
 
-    /* TODO: Should add logic for show_existing_frame */
-    if (0 == dec_handle_ptr->show_frame) {
-        assert(0 == dec_handle_ptr->show_existing_frame);
-        return 0;
-    }
-
-    uint32_t wd = dec_handle_ptr->frame_header.frame_size.superres_upscaled_width;
-    uint32_t ht = dec_handle_ptr->frame_header.frame_size.frame_height;
-    uint32_t i, sx = 0, sy = 0;
+    uint32_t wd = out_pic->pic_buf->superres_upscaled_width;
+    uint32_t ht = out_pic->pic_buf->frame_height;
+    uint32_t sx = 0, sy = 0;
 
     if (out_img->height != ht || out_img->width != wd ||
         out_img->color_fmt != recon_picture_buf->color_format ||
@@ -190,25 +283,7 @@ int svt_dec_out_buf(EbDecHandle *dec_handle_ptr, EbBufferHeaderType *p_buffer) {
         }
     }
 
-    switch (recon_picture_buf->color_format) {
-    case EB_YUV400:
-        sx = -1;
-        sy = -1;
-        break;
-    case EB_YUV420:
-        sx = 1;
-        sy = 1;
-        break;
-    case EB_YUV422:
-        sx = 1;
-        sy = 0;
-        break;
-    case EB_YUV444:
-        sx = 0;
-        sy = 0;
-        break;
-    default: assert(0);
-    }
+    dec_out_subsampling(recon_picture_buf->color_format, &sx, &sy);
 
     int32_t use_high_bit_depth = recon_picture_buf->bit_depth == EB_8BIT ? 0 : 1;
 
@@ -224,112 +299,157 @@ int svt_dec_out_buf(EbDecHandle *dec_handle_ptr, EbBufferHeaderType *p_buffer) {
     }
 
     /* Memcpy to dst buffer */
-    {
-        if (recon_picture_buf->bit_depth == EB_8BIT) {
-            uint8_t *src, *dst;
-            dst = luma;
-            src = recon_picture_buf->buffer_y + recon_picture_buf->origin_x +
-                  (recon_picture_buf->origin_y * recon_picture_buf->stride_y);
-
-            for (i = 0; i < ht; i++) {
-                memcpy(dst, src, wd);
-                dst += out_img->y_stride;
-                src += recon_picture_buf->stride_y;
-            }
+    uint8_t *src_luma, *src_cb, *src_cr;
+    dec_pic_origin(recon_picture_buf, sx, sy, use_high_bit_depth, &src_luma, &src_cb, &src_cr);
+    dec_copy_plane(
+        luma, out_img->y_stride, src_luma, recon_picture_buf->stride_y, wd, ht, use_high_bit_depth);
+    if (recon_picture_buf->color_format != EB_YUV400) {
+        dec_copy_plane(cb,
+                       out_img->cb_stride,
+                       src_cb,
+                       recon_picture_buf->stride_cb,
+                       (wd + sx) >> sx,
+                       (ht + sy) >> sy,
+                       use_high_bit_depth);
+        dec_copy_plane(cr,
+                       out_img->cr_stride,
+                       src_cr,
+                       recon_picture_buf->stride_cr,
+                       (wd + sx) >> sx,
+                       (ht + sy) >> sy,
+                       use_high_bit_depth);
+    }
 
-            if (recon_picture_buf->color_format != EB_YUV400) {
-                /* Cb */
-                dst = cb;
-                src = recon_picture_buf->buffer_cb + (recon_picture_buf->origin_x >> sx) +
-                      ((recon_picture_buf->origin_y >> sy) * recon_picture_buf->stride_cb);
-
-                for (i = 0; i < ((ht + sy) >> sy); i++) {
-                    memcpy(dst, src, ((wd + sx) >> sx));
-                    dst += out_img->cb_stride;
-                    src += recon_picture_buf->stride_cb;
-                }
-
-                /* Cr */
-                dst = cr;
-                src = recon_picture_buf->buffer_cr + (recon_picture_buf->origin_x >> sx) +
-                      ((recon_picture_buf->origin_y >> sy) * recon_picture_buf->stride_cr);
-
-                for (i = 0; i < ((ht + sy) >> sy); i++) {
-                    memcpy(dst, src, ((wd + sx) >> sx));
-                    dst += out_img->cr_stride;
-                    src += recon_picture_buf->stride_cr;
-                }
-            }
-        } else {
-            uint16_t *pu2_dst;
-            uint16_t *pu2_src;
-
-            /* Luma */
-            pu2_dst = (uint16_t *)luma;
-            pu2_src = (uint16_t *)recon_picture_buf->buffer_y + recon_picture_buf->origin_x +
-                      (recon_picture_buf->origin_y * recon_picture_buf->stride_y);
-
-            for (i = 0; i < ht; i++) {
-                memcpy(pu2_dst, pu2_src, sizeof(uint16_t) * wd);
-                pu2_dst += out_img->y_stride;
-                pu2_src += recon_picture_buf->stride_y;
-            }
+    /* Need to fill the dst buf with recon data before calling film_grain */
+    if (dec_out_has_film_grain(dec_handle_ptr, out_pic))
+        dec_out_film_grain(dec_handle_ptr,
+                           out_pic,
+                           recon_picture_buf->bit_depth,
+                           luma,
+                           cb,
+                           cr,
+                           ht,
+                           wd,
+                           out_img->y_stride,
+                           out_img->cb_stride,
+                           sy,
+                           sx);
 
-            if (recon_picture_buf->color_format != EB_YUV400) {
-                /* Cb */
-                pu2_dst = (uint16_t *)cb;
-                pu2_src = (uint16_t *)recon_picture_buf->buffer_cb +
-                          (recon_picture_buf->origin_x >> sx) +
-                          ((recon_picture_buf->origin_y >> sy) * recon_picture_buf->stride_cb);
-
-                for (i = 0; i < ((ht + sy) >> sy); i++) {
-                    memcpy(pu2_dst, pu2_src, sizeof(uint16_t) * ((wd + sx) >> sx));
-                    pu2_dst += out_img->cb_stride;
-                    pu2_src += recon_picture_buf->stride_cb;
-                }
-
-                /* Cr */
-                pu2_dst = (uint16_t *)cr;
-                pu2_src = (uint16_t *)recon_picture_buf->buffer_cr +
-                          (recon_picture_buf->origin_x >> sx) +
-                          ((recon_picture_buf->origin_y >> sy) * recon_picture_buf->stride_cr);
-
-                for (i = 0; i < ((ht + sy) >> sy); i++) {
-                    memcpy(pu2_dst, pu2_src, sizeof(uint16_t) * ((wd + sx) >> sx));
-                    pu2_dst += out_img->cr_stride;
-                    pu2_src += recon_picture_buf->stride_cr;
-                }
-            }
-        }
-    }
+    return 1;
+}
 
-    if (!dec_handle_ptr->dec_config.skip_film_grain) {
-        /* Need to fill the dst buf with recon data before calling film_grain */
-        AomFilmGrain *film_grain_ptr = &dec_handle_ptr->cur_pic_buf[0]->film_grain_params;
-        if (film_grain_ptr->apply_grain) {
-            switch (recon_picture_buf->bit_depth) {
-            case EB_8BIT: film_grain_ptr->bit_depth = 8; break;
-            case EB_10BIT: film_grain_ptr->bit_depth = 10; break;
-            default: assert(0);
+/* Hands out the recon buffer itself, without a copy. The picture stays
+ * referenced until eb_svt_dec_release_picture is called on p_buffer. A
+ * shown existing frame hands out the buffer of the reference it shows.
+ * Returns -1 when the application holds DEC_MAX_OUT_PIC_REFS pictures */
+static int svt_dec_ref_out_buf(EbDecHandle *dec_handle_ptr, DecOutPic *dec_out_pic,
+                               EbBufferHeaderType *p_buffer) {
+    EbDecPicMgr *        ps_pic_mgr = (EbDecPicMgr *)dec_handle_ptr->pv_pic_mgr;
+    EbDecPicBuf *        pic_buf    = dec_out_pic->pic_buf;
+    EbPictureBufferDesc *out_pic    = pic_buf->ps_pic_buf;
+    EbSvtIOFormat *      out_img    = (EbSvtIOFormat *)p_buffer->p_buffer;
+
+    uint32_t wd = pic_buf->superres_upscaled_width;
+    uint32_t ht = pic_buf->frame_height;
+    uint32_t sx = 0, sy = 0;
+    dec_out_subsampling(out_pic->color_format, &sx, &sy);
+
+    if (dec_pic_mgr_add_ref(ps_pic_mgr, pic_buf) != EB_ErrorNone) return -1;
+    p_buffer->wrapper_ptr = pic_buf;
+
+    int32_t  use_high_bit_depth = out_pic->bit_depth == EB_8BIT ? 0 : 1;
+    uint8_t *luma, *cb, *cr;
+    dec_pic_origin(out_pic, sx, sy, use_high_bit_depth, &luma, &cb, &cr);
+
+    if (dec_out_has_film_grain(dec_handle_ptr, dec_out_pic)) {
+        /* The grain must not reach the reference, so it is added to a copy */
+        EbPictureBufferDesc *fg_pic = dec_pic_mgr_get_fg_pic(ps_pic_mgr, pic_buf);
+        if (fg_pic == NULL)
+            SVT_LOG("Film grain synthesis: out of memory, the grain is not added\n");
+        else {
+            uint8_t *fg_luma, *fg_cb, *fg_cr;
+            dec_pic_origin(fg_pic, sx, sy, use_high_bit_depth, &fg_luma, &fg_cb, &fg_cr);
+            dec_copy_plane(
+                fg_luma, fg_pic->stride_y, luma, out_pic->stride_y, wd, ht, use_high_bit_depth);
+            if (out_pic->color_format != EB_YUV400) {
+                dec_copy_plane(fg_cb,
+                               fg_pic->stride_cb,
+                               cb,
+                               out_pic->stride_cb,
+                               (wd + sx) >> sx,
+                               (ht + sy) >> sy,
+                               use_high_bit_depth);
+                dec_copy_plane(fg_cr,
+                               fg_pic->stride_cr,
+                               cr,
+                               out_pic->stride_cr,
+                               (wd + sx) >> sx,
+                               (ht + sy) >> sy,
+                               use_high_bit_depth);
             }
-
-            eb_av1_add_film_grain_run(film_grain_ptr,
-                                      luma,
-                                      cb,
-                                      cr,
-                                      ht,
-                                      wd,
-                                      out_img->y_stride,
-                                      out_img->cb_stride,
-                                      use_high_bit_depth,
-                                      sy,
-                                      sx);
+            out_pic = fg_pic;
+            luma    = fg_luma;
+            cb      = fg_cb;
+            cr      = fg_cr;
+            dec_out_film_grain(dec_handle_ptr,
+                               dec_out_pic,
+                               out_pic->bit_depth,
+                               luma,
+                               cb,
+                               cr,
+                               ht,
+                               wd,
+                               out_pic->stride_y,
+                               out_pic->stride_cb,
+                               sy,
+                               sx);
         }
     }
 
+    out_img->luma      = luma;
+    out_img->cb        = cb;
+    out_img->cr        = cr;
+    out_img->luma_ext  = NULL;
+    out_img->cb_ext    = NULL;
+    out_img->cr_ext    = NULL;
+    out_img->y_stride  = out_pic->stride_y;
+    out_img->cb_stride = out_pic->color_format == EB_YUV400 ? INT32_MAX : out_pic->stride_cb;
+    out_img->cr_stride = out_pic->color_format == EB_YUV400 ? INT32_MAX : out_pic->stride_cr;
+    out_img->width     = wd;
+    out_img->height    = ht;
+    out_img->origin_x  = 0;
+    out_img->origin_y  = 0;
+    out_img->color_fmt = out_pic->color_format;
+    out_img->bit_depth = (EbBitDepth)out_pic->bit_depth;
+
     return 1;
 }
 
+/* Drops the oldest picture waiting for output */
+static void dec_out_pic_pop(EbDecHandle *dec_handle_ptr) {
+    DecOutPic *out_pic = &dec_handle_ptr->out_pics[dec_handle_ptr->out_pic_head];
+    dec_pic_mgr_unref_pics((EbDecPicMgr *)dec_handle_ptr->pv_pic_mgr, &out_pic->pic_buf, 1);
+    out_pic->pic_buf             = NULL;
+    dec_handle_ptr->out_pic_head = (dec_handle_ptr->out_pic_head + 1) % dec_handle_ptr->num_frms_prll;
+    dec_handle_ptr->num_out_pics--;
+}
+
+/* Queues the picture shown by the frame just parsed, it may still be
+ * decoding. Up to one picture per frame thread waits for output, beyond
+ * that the oldest one was not taken by the application and is dropped */
+static void dec_out_pic_push(EbDecHandle *dec_handle_ptr) {
+    if (dec_handle_ptr->num_out_pics == dec_handle_ptr->num_frms_prll)
+        dec_out_pic_pop(dec_handle_ptr);
+
+    int32_t idx = (dec_handle_ptr->out_pic_head + dec_handle_ptr->num_out_pics) %
+                  dec_handle_ptr->num_frms_prll;
+    DecOutPic *out_pic         = &dec_handle_ptr->out_pics[idx];
+    out_pic->pic_buf           = dec_handle_ptr->cur_pic_buf[0];
+    out_pic->film_grain_params = out_pic->pic_buf->film_grain_params;
+    dec_pic_mgr_ref_pics((EbDecPicMgr *)dec_handle_ptr->pv_pic_mgr, &out_pic->pic_buf, 1);
+    dec_handle_ptr->num_out_pics++;
+}
+
 /**********************************
 Set Default Library Params
 **********************************/
@@ -464,9 +584,21 @@ eb_init_decoder(EbComponentType *svt_dec_component) {
     CPU_FLAGS    cpu_flags      = get_cpu_flags_to_use();
 
     dec_handle_ptr->dec_cnt       = -1;
-    dec_handle_ptr->num_frms_prll = 1;
-    if (dec_handle_ptr->num_frms_prll > DEC_MAX_NUM_FRM_PRLL)
+    dec_handle_ptr->num_frms_prll =
+        dec_handle_ptr->dec_config.num_p_frames ? (int32_t)dec_handle_ptr->dec_config.num_p_frames
+                                                : 1;
+    if (dec_handle_ptr->num_frms_prll > DEC_MAX_NUM_FRM_PRLL) {
+        SVT_LOG("Warning : At most %d frames are decoded in parallel.\n", DEC_MAX_NUM_FRM_PRLL);
         dec_handle_ptr->num_frms_prll = DEC_MAX_NUM_FRM_PRLL;
+    }
+    if (dec_handle_ptr->num_frms_prll > 1 && dec_handle_ptr->dec_config.threads > 1) {
+        SVT_LOG(
+            "Warning : Tile threads not supported with frame parallel decoding."
+            " Decoding frames in parallel on 1 thread each. \n");
+        dec_handle_ptr->dec_config.threads = 1;
+    }
+    dec_handle_ptr->num_out_pics = 0;
+    dec_handle_ptr->out_pic_head = 0;
     dec_handle_ptr->seq_header_done = 0;
     dec_handle_ptr->mem_init_done   = 0;
 
@@ -475,7 +607,7 @@ eb_init_decoder(EbComponentType *svt_dec_component) {
     dec_handle_ptr->show_frame          = 0;
     dec_handle_ptr->showable_frame      = 0;
 
-    setup_rtcd_internal(cpu_flags);
+    setup_common_rtcd_internal(cpu_flags);
     asm_set_convolve_asm_table();
 
     init_intra_dc_predictors_c_internal();
@@ -486,6 +618,13 @@ eb_init_decoder(EbComponentType *svt_dec_component) {
 
     av1_init_wedge_masks();
 
+    dec_handle_ptr->progress_semaphore = eb_create_semaphore(0, 1);
+    if (dec_handle_ptr->progress_semaphore == NULL) return EB_ErrorInsufficientResources;
+    if (dec_handle_ptr->num_frms_prll > 1) {
+        return_error = dec_frame_slots_init(dec_handle_ptr);
+        if (return_error != EB_ErrorNone) return return_error;
+    }
+
     /************************************
     * Decoder Memory Init
     ************************************/
@@ -516,10 +655,23 @@ eb_svt_decode_frame(EbComponentType *svt_dec_component, const uint8_t *data, con
 
         uint64_t frame_size = 0;
         frame_size          = data_end - data_start;
+        /* Set again by the frame header, if any */
+        dec_handle_ptr->show_existing_frame = 0;
+        dec_handle_ptr->show_frame          = 0;
         return_error = decode_multiple_obu(dec_handle_ptr, &data_start, frame_size, is_annexb);
 
         if (return_error != EB_ErrorNone) assert(0);
 
+        EbDecPicBuf *cur_pic = dec_handle_ptr->cur_pic_buf[0];
+        if (cur_pic != NULL && !dec_handle_ptr->show_existing_frame &&
+            (dec_handle_ptr->frame_slots == NULL || dec_handle_ptr->seen_frame_header)) {
+            /* Decoded here, or not handed to a frame thread for lack of
+               tiles: the next frames must not wait for it */
+            dec_pic_mgr_set_progress(
+                (EbDecPicMgr *)dec_handle_ptr->pv_pic_mgr, cur_pic, cur_pic->num_sb_rows);
+        }
+        if (dec_handle_ptr->show_frame) dec_out_pic_push(dec_handle_ptr);
+
         dec_pic_mgr_update_ref_pic(dec_handle_ptr,
                                    (EB_ErrorNone == return_error) ? 1 : 0,
                                    dec_handle_ptr->frame_header.refresh_frame_flags);
@@ -554,11 +706,65 @@ eb_svt_dec_get_picture(EbComponentType *svt_dec_component, EbBufferHeaderType *p
     if (svt_dec_component == NULL) return EB_ErrorBadParameter;
 
     EbDecHandle *dec_handle_ptr = (EbDecHandle *)svt_dec_component->p_component_private;
-    /* Copy from recon pointer and return! TODO: Should remove the memcpy! */
-    if (0 == svt_dec_out_buf(dec_handle_ptr, p_buffer)) return_error = EB_DecNoOutputPicture;
+    if (dec_handle_ptr->num_out_pics == 0) return EB_DecNoOutputPicture;
+
+    DecOutPic *  out_pic = &dec_handle_ptr->out_pics[dec_handle_ptr->out_pic_head];
+    EbDecPicBuf *pic_buf = out_pic->pic_buf;
+    if (eb_atomic_load32(&pic_buf->sb_rows_done) < pic_buf->num_sb_rows) {
+        /* Frames decoded in parallel are output once a picture waits for
+         * each frame thread */
+        if (dec_handle_ptr->num_out_pics < dec_handle_ptr->num_frms_prll)
+            return EB_DecNoOutputPicture;
+        dec_pic_mgr_wait_progress((EbDecPicMgr *)dec_handle_ptr->pv_pic_mgr,
+                                  pic_buf,
+                                  pic_buf->num_sb_rows,
+                                  dec_handle_ptr->progress_semaphore);
+    }
+
+    /* With application frame buffers the recon picture is handed out as is,
+     * otherwise it is copied to the application's planes */
+    int out;
+    if (dec_handle_ptr->ext_fb_alloc != NULL)
+        out = svt_dec_ref_out_buf(dec_handle_ptr, out_pic, p_buffer);
+    else
+        out = svt_dec_out_buf(dec_handle_ptr, out_pic, p_buffer);
+    /* The picture stays queued until the application can hold it */
+    if (out < 0) return EB_ErrorInsufficientResources;
+    if (out == 0) return_error = EB_DecNoOutputPicture;
+    dec_out_pic_pop(dec_handle_ptr);
     return return_error;
 }
 
+#ifdef __GNUC__
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType
+eb_svt_dec_release_picture(EbComponentType *svt_dec_component, EbBufferHeaderType *p_buffer) {
+    if (svt_dec_component == NULL || p_buffer == NULL) return EB_ErrorBadParameter;
+
+    EbDecHandle *dec_handle_ptr = (EbDecHandle *)svt_dec_component->p_component_private;
+    /* Copied pictures hold no reference */
+    if (p_buffer->wrapper_ptr == NULL) return EB_ErrorNone;
+
+    dec_pic_mgr_release((EbDecPicMgr *)dec_handle_ptr->pv_pic_mgr,
+                        (EbDecPicBuf *)p_buffer->wrapper_ptr);
+    p_buffer->wrapper_ptr = NULL;
+    return EB_ErrorNone;
+}
+
+#ifdef __GNUC__
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType
+eb_dec_flush(EbComponentType *svt_dec_component) {
+    if (svt_dec_component == NULL) return EB_ErrorBadParameter;
+
+    EbDecHandle *dec_handle_ptr = (EbDecHandle *)svt_dec_component->p_component_private;
+    /* The pictures of the frames in flight stay queued for output */
+    dec_frame_slots_drain(dec_handle_ptr);
+    return EB_ErrorNone;
+}
+
 #ifdef __GNUC__
 __attribute__((visibility("default")))
 #endif
@@ -570,6 +776,16 @@ eb_deinit_decoder(EbComponentType *svt_dec_component) {
 
     if (dec_handle_ptr) {
         if (dec_handle_ptr->dec_config.threads > 1) dec_sync_all_threads(dec_handle_ptr);
+        dec_frame_slots_deinit(dec_handle_ptr);
+        while (dec_handle_ptr->num_out_pics) dec_out_pic_pop(dec_handle_ptr);
+        if (dec_handle_ptr->progress_semaphore != NULL) {
+            eb_destroy_semaphore(dec_handle_ptr->progress_semaphore);
+            dec_handle_ptr->progress_semaphore = NULL;
+        }
+        eb_av1_film_grain_ctxt_free(dec_handle_ptr->film_grain_ctxt);
+        dec_handle_ptr->film_grain_ctxt = NULL;
+        if (dec_handle_ptr->pv_pic_mgr)
+            dec_pic_mgr_free_bufs((EbDecPicMgr *)dec_handle_ptr->pv_pic_mgr);
         if (svt_dec_memory_map) {
             // Loop through the ptr table and free all malloc'd pointers per channel
             EbMemoryMapEntry *memory_entry = svt_dec_memory_map;
@@ -637,10 +853,43 @@ EB_API EbErrorType
 eb_dec_set_frame_buffer_callbacks(EbComponentType *     svt_dec_component,
                                   EbAllocateFrameBuffer allocate_buffer,
                                   EbReleaseFrameBuffer release_buffer, void *priv_data) {
-    (void)svt_dec_component;
-    (void)allocate_buffer;
-    (void)release_buffer;
-    (void)priv_data;
+    if (svt_dec_component == NULL) return EB_ErrorBadParameter;
+    if ((allocate_buffer == NULL) != (release_buffer == NULL)) return EB_ErrorBadParameter;
+
+    EbDecHandle *dec_handle_ptr = (EbDecHandle *)svt_dec_component->p_component_private;
+    /* Buffers are bound to their allocator, so it can't change once decoding started */
+    if (dec_handle_ptr->pv_pic_mgr != NULL) return EB_ErrorBadParameter;
+
+    dec_handle_ptr->ext_fb_alloc   = allocate_buffer;
+    dec_handle_ptr->ext_fb_release = release_buffer;
+    dec_handle_ptr->ext_fb_priv    = priv_data;
+
+    return EB_ErrorNone;
+}
+
+#ifdef __GNUC__
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType
+eb_dec_get_pic_pool_stats(EbComponentType *svt_dec_component, EbDecPicPoolStats *stats) {
+    if (svt_dec_component == NULL || stats == NULL) return EB_ErrorBadParameter;
+
+    EbDecHandle *dec_handle_ptr = (EbDecHandle *)svt_dec_component->p_component_private;
+    EbDecPicMgr *ps_pic_mgr     = (EbDecPicMgr *)dec_handle_ptr->pv_pic_mgr;
+
+    if (ps_pic_mgr == NULL) {
+        stats->num_pics       = 0;
+        stats->max_num_pics   = 0;
+        stats->pool_bytes     = 0;
+        stats->max_pool_bytes = 0;
+        return EB_ErrorNone;
+    }
 
+    eb_block_on_mutex(ps_pic_mgr->pic_mgr_mutex);
+    stats->num_pics       = ps_pic_mgr->num_pic_bufs;
+    stats->max_num_pics   = ps_pic_mgr->max_pic_bufs;
+    stats->pool_bytes     = ps_pic_mgr->pool_bytes;
+    stats->max_pool_bytes = ps_pic_mgr->max_pool_bytes;
+    eb_release_mutex(ps_pic_mgr->pic_mgr_mutex);
     return EB_ErrorNone;
 }
@@ -26,9 +26,12 @@ extern "C" {
 #include "EbDecProcess.h"
 
 /* Maximum number of frames in parallel */
-#define DEC_MAX_NUM_FRM_PRLL 1
-/** Maximum picture buffers needed **/
-#define MAX_PIC_BUFS (REF_FRAMES + 1 + DEC_MAX_NUM_FRM_PRLL)
+#define DEC_MAX_NUM_FRM_PRLL 4
+/* Maximum number of output pictures the application can hold in zero-copy mode */
+#define DEC_MAX_OUT_PIC_REFS 4
+/** Maximum picture buffers needed: the references, the frames being decoded,
+ * as many decoded pictures waiting for output and the application's ones **/
+#define MAX_PIC_BUFS (REF_FRAMES + 2 * DEC_MAX_NUM_FRM_PRLL + DEC_MAX_OUT_PIC_REFS)
 
 /*Optimisation of Coeff Buffer in Single Thread*/
 #define SINGLE_THRD_COEFF_BUF_OPT 0
@@ -36,11 +39,20 @@ extern "C" {
 typedef struct EbDecPicBuf {
     uint8_t is_free;
 
-    size_t size;
+    /* Free list of the pool holding the buffers of this picture,
+     * -1 when it has no buffers */
+    int8_t size_idx;
+    /* Next picture in the free list */
+    int8_t next_free;
 
     /* Number of reference for this frame */
     uint8_t ref_count;
 
+    /* Decode progress, read by the frames decoded in parallel: -1 until the
+     * frame is parsed, then the number of SB rows final for prediction */
+    volatile int32_t sb_rows_done;
+    int32_t          num_sb_rows;
+
     uint32_t  order_hint;
     uint32_t  ref_order_hints[INTER_REFS_PER_FRAME];
     FrameType frame_type;
@@ -58,12 +70,20 @@ typedef struct EbDecPicBuf {
     uint16_t superres_upscaled_width;
 
     EbPictureBufferDesc *ps_pic_buf;
+    /* Frame buffer holding the planes of ps_pic_buf, from the
+     * application's allocator or the library's */
+    EbExtFrameBuf fb;
+
+    /* Film grain applied copy handed out in zero-copy output mode,
+     * valid when fg_fb has a buffer */
+    EbPictureBufferDesc *ps_fg_pic_buf;
+    EbExtFrameBuf        fg_fb;
 
     FRAME_CONTEXT final_frm_ctx;
 
     GlobalMotionParams global_motion[REF_FRAMES];
 
-    /* MV at 8x8 lvl */
+    /* MV at 8x8 lvl, the start of the allocation shared with segment_maps */
     TemporalMvRef *mvs;
 
     /* seg map */
@@ -141,6 +161,44 @@ typedef struct MasterFrameBuf {
 
 } MasterFrameBuf;
 
+/* Picture waiting for output */
+typedef struct DecOutPic {
+    EbDecPicBuf *pic_buf;
+    /* Grain of this output, a shown existing frame can change the one of the picture */
+    AomFilmGrain film_grain_params;
+} DecOutPic;
+
+/* Tile group OBU of a frame decoded on a frame thread */
+typedef struct DecTileGroupObu {
+    ObuType obu_type;
+    /* Payload in DecFrameSlot::tg_data */
+    size_t offset;
+    size_t size;
+} DecTileGroupObu;
+
+/* Frame thread of frame parallel decoding. The frame headers are parsed in
+ * order by the decoding call, which hands each frame to the next slot */
+typedef struct DecFrameSlot {
+    /* State the frame is decoded with: its headers and references, and the
+     * parse, reconstruction and filter contexts of the slot */
+    struct EbDecHandle *dec_handle_ptr;
+
+    EbHandle thread;
+    EbHandle start_semaphore;
+    EbHandle done_semaphore;
+    /* A frame was handed to the thread and its end not waited for yet */
+    EbBool busy;
+    EbBool exit;
+
+    /* Tile group OBUs of the frame, copied out of the caller's data */
+    uint8_t *        tg_data;
+    size_t           tg_data_size;
+    size_t           tg_data_alloc;
+    DecTileGroupObu *tg_obus;
+    int32_t          num_tg_obus;
+    int32_t          max_tg_obus;
+} DecFrameSlot;
+
 /**************************************
  * Component Private Data
  **************************************/
@@ -214,6 +272,11 @@ typedef struct EbDecHandle {
     EbDecPicBuf *cur_pic_buf[DEC_MAX_NUM_FRM_PRLL];
 
     // Callbacks
+    /* Application frame buffer allocator, NULL when the library allocates.
+     * Pictures are then output without a copy, see eb_svt_dec_release_picture */
+    EbAllocateFrameBuffer ext_fb_alloc;
+    EbReleaseFrameBuffer  ext_fb_release;
+    void *                ext_fb_priv;
 
     //DPB + MV, ... buf
 
@@ -236,6 +299,21 @@ typedef struct EbDecHandle {
     EbBool                start_thread_process;
     EbHandle              thread_semaphore;
     struct DecThreadCtxt *thread_ctxt_pa;
+
+    /* Film grain state, one overlap buffer slot per thread */
+    struct FilmGrainCtxt *film_grain_ctxt;
+
+    /* Frame threads when frames are decoded in parallel, used round robin */
+    DecFrameSlot *frame_slots;
+    int32_t       cur_slot;
+
+    /* Shown pictures waiting for eb_svt_dec_get_picture, in decode order */
+    DecOutPic out_pics[DEC_MAX_NUM_FRM_PRLL];
+    int32_t   out_pic_head;
+    int32_t   num_out_pics;
+
+    /* Posted when the decode progress the thread of this handle waits for is reached */
+    EbHandle progress_semaphore;
 } EbDecHandle;
 
 /* Thread level context data */
@@ -251,6 +329,11 @@ typedef struct DecThreadCtxt {
 
     /* Loop filter information */
     LoopFilterInfoN lf_info;
+
+    /* Scratch for the MT super-res and LR row jobs */
+    RestorationLineBuffers *rlbs;
+    int32_t *               rst_tmpbuf;
+    uint8_t *               lr_scratch;
 } DecThreadCtxt;
 
 #ifdef __cplusplus
@@ -410,6 +410,21 @@ void av1_build_interintra_predictors(DecModCtxt *dec_mod_ctxt, PartitionInfo *pa
     }
 }
 
+/* Waits for the SB rows of the reference the block is predicted from, when
+ * the reference is decoded in parallel with the current frame. Warped and
+ * scaled prediction can read anywhere, so they wait for the whole frame */
+static void dec_wait_ref_rows(EbDecHandle *dec_hdl, EbDecPicBuf *ref_buf,
+                              const struct ScaleFactors *sf, int32_t do_warp, const MV *mv,
+                              int32_t pre_y, int32_t bh, int32_t ss_y) {
+    int32_t sb_rows = ref_buf->num_sb_rows;
+    if (!do_warp && !av1_is_scaled(sf)) {
+        /* Last luma row read by the interpolation filter */
+        int32_t bottom = ((pre_y + bh) << ss_y) + (mv->row >> 3) + (AOM_INTERP_EXTEND << ss_y);
+        sb_rows = clamp((bottom >> dec_hdl->seq_header.sb_size_log2) + 1, 1, ref_buf->num_sb_rows);
+    }
+    dec_pic_mgr_wait_progress(dec_hdl->pv_pic_mgr, ref_buf, sb_rows, dec_hdl->progress_semaphore);
+}
+
 void svtav1_predict_inter_block_plane(DecModCtxt *dec_mod_ctx, EbDecHandle *dec_hdl,
                                       PartitionInfo *part_info, int32_t plane,
                                       int32_t build_for_obmc, int32_t mi_x, int32_t mi_y, void *dst,
@@ -507,6 +522,16 @@ void svtav1_predict_inter_block_plane(DecModCtxt *dec_mod_ctx, EbDecHandle *dec_
                    (wm_global->wmtype > TRANSLATION)) ||
                   (mi->motion_mode == WARPED_CAUSAL)));
 
+            if (!is_intrabc)
+                dec_wait_ref_rows(dec_hdl,
+                                  ref_buf,
+                                  part_info->block_ref_sf[ref],
+                                  do_warp,
+                                  &mi->mv[ref].as_mv,
+                                  pre_y,
+                                  bh,
+                                  ss_y);
+
             void *  src;
             int32_t src_stride;
 
@@ -36,20 +36,10 @@
  *  values that are fixed for the life of
  *  the descriptor.
  *****************************************/
-EbErrorType dec_eb_recon_picture_buffer_desc_ctor(
-    EbPtr  *object_dbl_ptr,
-    EbPtr   object_init_data_ptr)
+static void dec_recon_picture_buffer_desc_init(
+    EbPictureBufferDesc          *picture_buffer_desc_ptr,
+    EbPictureBufferDescInitData  *picture_buffer_desc_init_data_ptr)
 {
-    EbPictureBufferDesc          *picture_buffer_desc_ptr;
-    EbPictureBufferDescInitData  *picture_buffer_desc_init_data_ptr = (EbPictureBufferDescInitData*)object_init_data_ptr;
-
-    uint32_t bytes_per_pixel = (picture_buffer_desc_init_data_ptr->bit_depth == EB_8BIT) ? 1 : 2;
-
-    EB_MALLOC_DEC(EbPictureBufferDesc*, picture_buffer_desc_ptr, sizeof(EbPictureBufferDesc), EB_N_PTR);
-
-    // Allocate the PictureBufferDesc Object
-    *object_dbl_ptr = (EbPtr)picture_buffer_desc_ptr;
-
     // Set the Picture Buffer Static variables
     picture_buffer_desc_ptr->max_width = picture_buffer_desc_init_data_ptr->max_width;
     picture_buffer_desc_ptr->max_height = picture_buffer_desc_init_data_ptr->max_height;
@@ -87,6 +77,23 @@ EbErrorType dec_eb_recon_picture_buffer_desc_ctor(
     picture_buffer_desc_ptr->stride_bit_inc_y = 0;
     picture_buffer_desc_ptr->stride_bit_inc_cb = 0;
     picture_buffer_desc_ptr->stride_bit_inc_cr = 0;
+}
+
+EbErrorType dec_eb_recon_picture_buffer_desc_ctor(
+    EbPtr  *object_dbl_ptr,
+    EbPtr   object_init_data_ptr)
+{
+    EbPictureBufferDesc          *picture_buffer_desc_ptr;
+    EbPictureBufferDescInitData  *picture_buffer_desc_init_data_ptr = (EbPictureBufferDescInitData*)object_init_data_ptr;
+
+    uint32_t bytes_per_pixel = (picture_buffer_desc_init_data_ptr->bit_depth == EB_8BIT) ? 1 : 2;
+
+    EB_MALLOC_DEC(EbPictureBufferDesc*, picture_buffer_desc_ptr, sizeof(EbPictureBufferDesc), EB_N_PTR);
+
+    // Allocate the PictureBufferDesc Object
+    *object_dbl_ptr = (EbPtr)picture_buffer_desc_ptr;
+
+    dec_recon_picture_buffer_desc_init(picture_buffer_desc_ptr, picture_buffer_desc_init_data_ptr);
 
     // Allocate the Picture Buffers (luma & chroma)
     if (picture_buffer_desc_init_data_ptr->buffer_enable_mask & PICTURE_BUFFER_DESC_Y_FLAG) {
@@ -110,6 +117,54 @@ EbErrorType dec_eb_recon_picture_buffer_desc_ctor(
     return EB_ErrorNone;
 }
 
+/*****************************************
+ * dec_eb_fb_recon_picture_buffer_desc_init
+ *  Same layout as the recon buffer of
+ *  dec_eb_recon_picture_buffer_desc_ctor,
+ *  with all the planes carved out of one
+ *  frame buffer from allocate_buffer.
+ *  fb keeps the buffer for its release.
+ *****************************************/
+EbErrorType dec_eb_fb_recon_picture_buffer_desc_init(
+    EbPictureBufferDesc    *picture_buffer_desc_ptr,
+    EbPtr                   object_init_data_ptr,
+    EbExtFrameBuf          *fb,
+    EbAllocateFrameBuffer   allocate_buffer,
+    void                   *priv_data)
+{
+    EbPictureBufferDescInitData  *picture_buffer_desc_init_data_ptr = (EbPictureBufferDescInitData*)object_init_data_ptr;
+
+    uint32_t bytes_per_pixel = (picture_buffer_desc_init_data_ptr->bit_depth == EB_8BIT) ? 1 : 2;
+    uint16_t mask = picture_buffer_desc_init_data_ptr->buffer_enable_mask;
+
+    dec_recon_picture_buffer_desc_init(picture_buffer_desc_ptr, picture_buffer_desc_init_data_ptr);
+
+    // Each plane starts ALVALUE aligned, as with EB_ALLIGN_MALLOC_DEC
+    size_t luma_bytes = (mask & PICTURE_BUFFER_DESC_Y_FLAG) ?
+        ALIGN_POWER_OF_TWO((size_t)picture_buffer_desc_ptr->luma_size * bytes_per_pixel, 6) : 0;
+    size_t cb_bytes = (mask & PICTURE_BUFFER_DESC_Cb_FLAG) ?
+        ALIGN_POWER_OF_TWO((size_t)picture_buffer_desc_ptr->chroma_size * bytes_per_pixel, 6) : 0;
+    size_t cr_bytes = (mask & PICTURE_BUFFER_DESC_Cr_FLAG) ?
+        ALIGN_POWER_OF_TWO((size_t)picture_buffer_desc_ptr->chroma_size * bytes_per_pixel, 6) : 0;
+    size_t min_size = luma_bytes + cb_bytes + cr_bytes + ALVALUE - 1;
+
+    fb->buffer = NULL;
+    fb->buffer_size = 0;
+    fb->private_data = NULL;
+    if (min_size > UINT32_MAX ||
+        allocate_buffer(fb, (uint32_t)min_size, priv_data) < 0 ||
+        fb->buffer == NULL || fb->buffer_size < min_size)
+        return EB_ErrorInsufficientResources;
+
+    EbByte base = (EbByte)(((uintptr_t)fb->buffer + ALVALUE - 1) & ~(uintptr_t)(ALVALUE - 1));
+    memset(base, 0, luma_bytes + cb_bytes + cr_bytes);
+
+    picture_buffer_desc_ptr->buffer_y = luma_bytes ? base : 0;
+    picture_buffer_desc_ptr->buffer_cb = cb_bytes ? base + luma_bytes : 0;
+    picture_buffer_desc_ptr->buffer_cr = cr_bytes ? base + luma_bytes + cb_bytes : 0;
+    return EB_ErrorNone;
+}
+
 /**********************************
 * Master Frame Buf containing all frame level bufs like ModeInfo
 for all the frames in parallel
@@ -420,15 +475,10 @@ static EbErrorType init_lr_ctxt(EbDecHandle  *dec_handle_ptr)
     return return_error;
 }
 
-EbErrorType dec_mem_init(EbDecHandle  *dec_handle_ptr) {
+/* Contexts a frame is parsed, reconstructed and filtered with */
+static EbErrorType init_frame_ctxts(EbDecHandle  *dec_handle_ptr) {
     EbErrorType return_error = EB_ErrorNone;
 
-    if (0 == dec_handle_ptr->seq_header_done)
-        return EB_ErrorNone;
-
-    /* init module ctxts */
-    return_error |= dec_pic_mgr_init(dec_handle_ptr);
-
     return_error |= init_parse_context(dec_handle_ptr);
 
     return_error |= init_dec_mod_ctxt(dec_handle_ptr,
@@ -441,6 +491,33 @@ EbErrorType dec_mem_init(EbDecHandle  *dec_handle_ptr) {
     /* init frame buffers */
     return_error |= init_master_frame_ctxt(dec_handle_ptr);
 
+    return return_error;
+}
+
+EbErrorType dec_mem_init(EbDecHandle  *dec_handle_ptr) {
+    EbErrorType return_error = EB_ErrorNone;
+
+    if (0 == dec_handle_ptr->seq_header_done)
+        return EB_ErrorNone;
+
+    /* init module ctxts */
+    return_error |= dec_pic_mgr_init(dec_handle_ptr);
+
+    /* Frames decoded in parallel have their own contexts, the decoding
+       call only parses the headers */
+    if (dec_handle_ptr->frame_slots == NULL)
+        return_error |= init_frame_ctxts(dec_handle_ptr);
+    else {
+        for (int32_t i = 0; i < dec_handle_ptr->num_frms_prll; i++) {
+            EbDecHandle *frm_handle = dec_handle_ptr->frame_slots[i].dec_handle_ptr;
+            frm_handle->seq_header = dec_handle_ptr->seq_header;
+            frm_handle->seq_header_done = 1;
+            frm_handle->pv_pic_mgr = dec_handle_ptr->pv_pic_mgr;
+            return_error |= init_frame_ctxts(frm_handle);
+            frm_handle->mem_init_done = 1;
+        }
+    }
+
     /* Initialize the references to NULL */
     for (int i = 0; i < REF_FRAMES; i++) {
         dec_handle_ptr->ref_frame_map[i] = NULL;
@@ -78,6 +78,11 @@ extern uint32_t          svt_dec_lib_malloc_count;
 
 EbErrorType dec_eb_recon_picture_buffer_desc_ctor(EbPtr *object_dbl_ptr,
                                                   EbPtr  object_init_data_ptr);
+EbErrorType dec_eb_fb_recon_picture_buffer_desc_init(EbPictureBufferDesc *picture_buffer_desc_ptr,
+                                                     EbPtr                object_init_data_ptr,
+                                                     EbExtFrameBuf *      fb,
+                                                     EbAllocateFrameBuffer allocate_buffer,
+                                                     void *               priv_data);
 
 EbErrorType dec_mem_init(EbDecHandle *dec_handle_ptr);
 
@@ -993,6 +993,8 @@ void motion_field_projections_row(EbDecHandle *dec_handle, int sb_row, const EbD
         motion_field_projection_row(dec_handle, LAST2_FRAME, sb_row, num_blk_mv_rows, 2);
 }
 
+void dec_film_grain_stripes_mt(EbDecHandle *dec_handle_ptr, DecThreadCtxt *thread_ctxt);
+
 void svt_setup_motion_field(EbDecHandle *dec_handle, DecThreadCtxt *thread_ctxt) {
     DecMtFrameData *dec_mt_frame_data =
         &dec_handle->master_frame_buf.cur_frame_bufs[0].dec_mt_frame_data;
@@ -1000,9 +1002,12 @@ void svt_setup_motion_field(EbDecHandle *dec_handle, DecThreadCtxt *thread_ctxt)
 
     if (is_mt) {
         volatile EbBool *start_motion_proj = &dec_mt_frame_data->start_motion_proj;
-        while (*start_motion_proj != EB_TRUE)
+        while (*start_motion_proj != EB_TRUE) {
             eb_block_on_semaphore(NULL == thread_ctxt ? dec_handle->thread_semaphore
                                                       : thread_ctxt->thread_semaphore);
+            /* Film grain of the output picture is shared out between frames */
+            if (NULL != thread_ctxt) dec_film_grain_stripes_mt(dec_handle, thread_ctxt);
+        }
     }
 
     EbBool no_proj_flag = (dec_handle->frame_header.show_existing_frame ||
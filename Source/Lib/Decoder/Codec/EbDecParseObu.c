@@ -58,6 +58,15 @@ void decode_frame_tiles(EbDecHandle *dec_handle_ptr, DecThreadCtxt *thread_ctxt)
 void svt_av1_queue_lf_jobs(EbDecHandle *dec_handle_ptr);
 void svt_av1_queue_cdef_jobs(EbDecHandle *dec_handle_ptr);
 void svt_cdef_frame_mt(EbDecHandle *dec_handle_ptr, DecThreadCtxt *thread_ctxt);
+void svt_av1_queue_sr_lr_jobs(EbDecHandle *dec_handle_ptr);
+void svt_superres_frame_mt(EbDecHandle *dec_handle_ptr, DecThreadCtxt *thread_ctxt);
+void dec_av1_loop_restoration_filter_frame_mt(EbDecHandle *  dec_handle_ptr,
+                                              DecThreadCtxt *thread_ctxt);
+void        dec_frame_slots_drain(EbDecHandle *dec_handle_ptr);
+void        dec_frame_slot_acquire(EbDecHandle *dec_handle_ptr);
+EbErrorType dec_frame_slot_add_tg(EbDecHandle *dec_handle_ptr, ObuType obu_type,
+                                  const uint8_t *data, size_t size);
+void        dec_frame_slot_submit(EbDecHandle *dec_handle_ptr);
 
 #define CONFIG_MAX_DECODE_PROFILE 2
 #define INT_MAX 2147483647 // maximum (signed) int value
@@ -1663,6 +1672,54 @@ static void check_mt_support(EbDecHandle *dec_handle_ptr) {
     }
 }
 
+/* Frame buffers and contexts sized by the frame header. Allocation goes
+ * through the memory map, so it stays on the thread of the decoding call */
+void dec_frame_alloc(EbDecHandle *dec_handle_ptr) {
+    MasterParseCtxt *master_parse_ctx = (MasterParseCtxt *)dec_handle_ptr->pv_master_parse_ctxt;
+
+    /*Temporal MVs allocation */
+    check_add_tplmv_buf(dec_handle_ptr);
+
+    if (dec_handle_ptr->dec_config.threads > 1) check_mt_support(dec_handle_ptr);
+
+    TilesInfo tiles_info    = dec_handle_ptr->frame_header.tiles_info;
+    int       num_tiles     = tiles_info.tile_cols * tiles_info.tile_rows;
+    int       num_instances = MIN((int32_t)dec_handle_ptr->dec_config.threads, num_tiles);
+    if (num_instances != master_parse_ctx->context_count) {
+        if (dec_handle_ptr->dec_config.threads == 1) {
+            /* For single thread case, allocate memory for one
+               frame row above and one sb column for the left context. */
+            reallocate_parse_context_memory(dec_handle_ptr, master_parse_ctx, 1);
+        } else {
+            reallocate_parse_context_memory(dec_handle_ptr, master_parse_ctx, num_instances);
+        }
+    }
+    if (num_tiles != master_parse_ctx->num_tiles)
+        reallocate_parse_tile_data(master_parse_ctx, num_tiles);
+}
+
+/* Frame state loaded from the references: the CDFs of the primary one and
+ * the projected MVs. They must be parsed before this is called */
+void dec_frame_setup(EbDecHandle *dec_handle_ptr) {
+    FrameHeader *frame_info = &dec_handle_ptr->frame_header;
+
+    setup_segmentation_dequant((DecModCtxt *)dec_handle_ptr->pv_dec_mod_ctxt);
+
+    MasterParseCtxt *master_parse_ctx = (MasterParseCtxt *)dec_handle_ptr->pv_master_parse_ctxt;
+    if (frame_info->primary_ref_frame == PRIMARY_REF_NONE)
+        reset_parse_ctx(&master_parse_ctx->init_frm_ctx,
+                        frame_info->quantization_params.base_q_idx);
+    else
+        /* Load CDF */
+        master_parse_ctx->init_frm_ctx =
+            get_ref_frame_buf(dec_handle_ptr, frame_info->primary_ref_frame + 1)->final_frm_ctx;
+
+    /* TODO: Should be moved to caller */
+    if (dec_handle_ptr->dec_config.threads == 1) {
+        if (!frame_info->show_existing_frame) svt_setup_motion_field(dec_handle_ptr, NULL);
+    }
+}
+
 void read_uncompressed_header(Bitstrm *bs, EbDecHandle *dec_handle_ptr, ObuHeader *obu_header,
                               int num_planes) {
     SeqHeader *  seq_header = &dec_handle_ptr->seq_header;
@@ -1969,17 +2026,19 @@ void read_uncompressed_header(Bitstrm *bs, EbDecHandle *dec_handle_ptr, ObuHeade
              seq_header->color_config.subsampling_y == 0)
         dec_handle_ptr->dec_config.max_color_format = EB_YUV444;
 
-    dec_handle_ptr->cur_pic_buf[0] =
-        dec_pic_mgr_get_cur_pic(dec_handle_ptr->pv_pic_mgr,
-                                &dec_handle_ptr->seq_header,
-                                &dec_handle_ptr->frame_header,
-                                dec_handle_ptr->seq_header.color_config.mono_chrome
-                                    ? EB_YUV400
-                                    : dec_handle_ptr->dec_config.max_color_format);
+    EbColorFormat color_format = dec_handle_ptr->seq_header.color_config.mono_chrome
+                                     ? EB_YUV400
+                                     : dec_handle_ptr->dec_config.max_color_format;
+    dec_handle_ptr->cur_pic_buf[0] = dec_pic_mgr_get_cur_pic(
+        dec_handle_ptr->pv_pic_mgr, &dec_handle_ptr->seq_header, frame_info, color_format);
+    if (dec_handle_ptr->cur_pic_buf[0] == NULL && dec_handle_ptr->frame_slots != NULL) {
+        /* Frames in flight hold references dropped from the map already */
+        dec_frame_slots_drain(dec_handle_ptr);
+        dec_handle_ptr->cur_pic_buf[0] = dec_pic_mgr_get_cur_pic(
+            dec_handle_ptr->pv_pic_mgr, &dec_handle_ptr->seq_header, frame_info, color_format);
+    }
 
     svt_setup_frame_buf_refs(dec_handle_ptr);
-    /*Temporal MVs allocation */
-    check_add_tplmv_buf(dec_handle_ptr);
 
     setup_frame_sign_bias(dec_handle_ptr);
 
@@ -2003,34 +2062,6 @@ void read_uncompressed_header(Bitstrm *bs, EbDecHandle *dec_handle_ptr, ObuHeade
     read_segmentation_params(bs, dec_handle_ptr, frame_info);
     read_frame_delta_q_params(bs, frame_info);
     read_frame_delta_lf_params(bs, frame_info);
-    setup_segmentation_dequant((DecModCtxt *)dec_handle_ptr->pv_dec_mod_ctxt);
-
-    MasterParseCtxt *master_parse_ctx = (MasterParseCtxt *)dec_handle_ptr->pv_master_parse_ctxt;
-    if (frame_info->primary_ref_frame == PRIMARY_REF_NONE)
-        reset_parse_ctx(&master_parse_ctx->init_frm_ctx,
-                        frame_info->quantization_params.base_q_idx);
-    else
-        /* Load CDF */
-        master_parse_ctx->init_frm_ctx =
-            get_ref_frame_buf(dec_handle_ptr, frame_info->primary_ref_frame + 1)->final_frm_ctx;
-
-    if (dec_handle_ptr->dec_config.threads > 1) check_mt_support(dec_handle_ptr);
-
-    TilesInfo tiles_info    = dec_handle_ptr->frame_header.tiles_info;
-    int       num_tiles     = tiles_info.tile_cols * tiles_info.tile_rows;
-    int       num_instances = MIN((int32_t)dec_handle_ptr->dec_config.threads, num_tiles);
-    if (num_instances != master_parse_ctx->context_count) {
-        if (dec_handle_ptr->dec_config.threads == 1) {
-            /* For single thread case, allocate memory for one
-               frame row above and one sb column for the left context. */
-            reallocate_parse_context_memory(dec_handle_ptr, master_parse_ctx, 1);
-        } else {
-            reallocate_parse_context_memory(dec_handle_ptr, master_parse_ctx, num_instances);
-        }
-    }
-    if (num_tiles != master_parse_ctx->num_tiles)
-        reallocate_parse_tile_data(master_parse_ctx, num_tiles);
-
     frame_info->coded_lossless = 1;
     for (int i = 0; i < MAX_SEGMENTS; ++i) {
         int qindex = get_qindex(
@@ -2092,9 +2123,10 @@ void read_uncompressed_header(Bitstrm *bs, EbDecHandle *dec_handle_ptr, ObuHeade
     dec_handle_ptr->show_frame          = frame_info->show_frame;
     dec_handle_ptr->showable_frame      = frame_info->showable_frame;
 
-    /* TODO: Should be moved to caller */
-    if (dec_handle_ptr->dec_config.threads == 1) {
-        if (!frame_info->show_existing_frame) svt_setup_motion_field(dec_handle_ptr, NULL);
+    /* A frame decoded in parallel gets them on its frame thread */
+    if (dec_handle_ptr->num_frms_prll == 1) {
+        dec_frame_alloc(dec_handle_ptr);
+        dec_frame_setup(dec_handle_ptr);
     }
 }
 
@@ -2137,6 +2169,19 @@ void clear_loop_restoration(int num_planes, PartitionInfo *part_info) {
     }
 }
 
+/* Peeks at the tile range of a tile group OBU */
+static int is_last_tile_group(const Bitstrm *bs, TilesInfo *tiles_info) {
+    Bitstrm tg_bs     = *bs;
+    int     num_tiles = tiles_info->tile_cols * tiles_info->tile_rows;
+    int     tg_end    = num_tiles - 1;
+    if (num_tiles > 1 && dec_get_bits(&tg_bs, 1)) {
+        int tile_bits = tiles_info->tile_cols_log2 + tiles_info->tile_rows_log2;
+        dec_get_bits(&tg_bs, tile_bits);
+        tg_end = dec_get_bits(&tg_bs, tile_bits);
+    }
+    return (tg_end + 1) == num_tiles;
+}
+
 // Read Tile group information
 EbErrorType read_tile_group_obu(Bitstrm *bs, EbDecHandle *dec_handle_ptr, TilesInfo *tiles_info,
                                 ObuHeader *obu_header, int *is_last_tg) {
@@ -2265,6 +2310,7 @@ EbErrorType read_tile_group_obu(Bitstrm *bs, EbDecHandle *dec_handle_ptr, TilesI
         {
             svt_av1_queue_lf_jobs(dec_handle_ptr);
             svt_av1_queue_cdef_jobs(dec_handle_ptr);
+            svt_av1_queue_sr_lr_jobs(dec_handle_ptr);
             eb_block_on_mutex(dec_mt_frame_data->temp_mutex);
 
             dec_mt_frame_data->start_lf_frame = EB_TRUE;
@@ -2275,6 +2321,16 @@ EbErrorType read_tile_group_obu(Bitstrm *bs, EbDecHandle *dec_handle_ptr, TilesI
                 eb_post_semaphore(dec_handle_ptr->thread_ctxt_pa[lib_thrd].thread_semaphore);
             dec_mt_frame_data->start_cdef_frame = EB_TRUE;
             eb_post_semaphore(dec_handle_ptr->thread_semaphore);
+            for (uint32_t lib_thrd = 0; lib_thrd < dec_handle_ptr->dec_config.threads - 1;
+                 lib_thrd++)
+                eb_post_semaphore(dec_handle_ptr->thread_ctxt_pa[lib_thrd].thread_semaphore);
+            dec_mt_frame_data->start_sr_frame = EB_TRUE;
+            eb_post_semaphore(dec_handle_ptr->thread_semaphore);
+            for (uint32_t lib_thrd = 0; lib_thrd < dec_handle_ptr->dec_config.threads - 1;
+                 lib_thrd++)
+                eb_post_semaphore(dec_handle_ptr->thread_ctxt_pa[lib_thrd].thread_semaphore);
+            dec_mt_frame_data->start_lr_frame = EB_TRUE;
+            eb_post_semaphore(dec_handle_ptr->thread_semaphore);
             for (uint32_t lib_thrd = 0; lib_thrd < dec_handle_ptr->dec_config.threads - 1;
                  lib_thrd++)
                 eb_post_semaphore(dec_handle_ptr->thread_ctxt_pa[lib_thrd].thread_semaphore);
@@ -2314,6 +2370,12 @@ EbErrorType read_tile_group_obu(Bitstrm *bs, EbDecHandle *dec_handle_ptr, TilesI
 
     if ((tg_end + 1) != num_tiles) return 0;
 
+    /* Save CDF */
+    if (frame_header->disable_frame_end_update_cdf)
+        dec_handle_ptr->cur_pic_buf[0]->final_frm_ctx = master_parse_ctxt->init_frm_ctx;
+    /* The CDFs, MVs and segment map of the frame can be read by the next ones */
+    dec_pic_mgr_set_progress(dec_handle_ptr->pv_pic_mgr, dec_handle_ptr->cur_pic_buf[0], 0);
+
     /* PPF flags derivation */
     EbBool no_ibc = !dec_handle_ptr->frame_header.allow_intrabc;
     /* LF */
@@ -2356,28 +2418,37 @@ EbErrorType read_tile_group_obu(Bitstrm *bs, EbDecHandle *dec_handle_ptr, TilesI
     if (!is_mt) dec_av1_loop_restoration_save_boundary_lines(dec_handle_ptr, 0, do_lr_non_opt);
 
     if (is_mt) {
+        /* CDEF, super-res and LR run as row jobs pipelined on the thread
+           pool. The after-CDEF boundary lines are not saved: inside the
+           frame LR stripes only read the deblocked lines saved by LF. */
         svt_cdef_frame_mt(dec_handle_ptr, NULL);
-    } else
+        svt_superres_frame_mt(dec_handle_ptr, NULL);
+        dec_av1_loop_restoration_filter_frame_mt(dec_handle_ptr, NULL);
+        if (do_upscale)
+            dec_handle_ptr->cur_pic_buf[0]->ps_pic_buf->width =
+                dec_handle_ptr->frame_header.frame_size.superres_upscaled_width;
+    } else {
         svt_cdef_frame(dec_handle_ptr, do_cdef);
 
-    av1_superres_upscale(&dec_handle_ptr->cm,
-                         &dec_handle_ptr->frame_header,
-                         &dec_handle_ptr->seq_header,
-                         dec_handle_ptr->cur_pic_buf[0]->ps_pic_buf,
-                         do_upscale);
+        av1_superres_upscale(&dec_handle_ptr->cm,
+                             &dec_handle_ptr->frame_header,
+                             &dec_handle_ptr->seq_header,
+                             dec_handle_ptr->cur_pic_buf[0]->ps_pic_buf,
+                             do_upscale);
+
+        dec_av1_loop_restoration_save_boundary_lines(dec_handle_ptr, 1, do_lr_non_opt);
+
+        dec_av1_loop_restoration_filter_frame(dec_handle_ptr, opt_lr, do_lr);
+    }
 
     if (do_upscale)
         dec_handle_ptr->cm.frm_size.frame_width =
             dec_handle_ptr->frame_header.frame_size.frame_width;
 
-    dec_av1_loop_restoration_save_boundary_lines(dec_handle_ptr, 1, do_lr_non_opt);
-
-    dec_av1_loop_restoration_filter_frame(dec_handle_ptr, opt_lr, do_lr);
-    /* Save CDF */
-    if (frame_header->disable_frame_end_update_cdf)
-        dec_handle_ptr->cur_pic_buf[0]->final_frm_ctx = master_parse_ctxt->init_frm_ctx;
-
     pad_pic(dec_handle_ptr->cur_pic_buf[0]->ps_pic_buf, &dec_handle_ptr->frame_header, 1);
+    dec_pic_mgr_set_progress(dec_handle_ptr->pv_pic_mgr,
+                             dec_handle_ptr->cur_pic_buf[0],
+                             dec_handle_ptr->cur_pic_buf[0]->num_sb_rows);
     return status;
 }
 
@@ -2413,8 +2484,11 @@ EbErrorType decode_multiple_obu(EbDecHandle *dec_handle_ptr, uint8_t **data, siz
         size_t payload_size = 0, length_size = 0;
 
         /* Decoder memory init if not done */
-        if (0 == dec_handle_ptr->mem_init_done && 1 == dec_handle_ptr->seq_header_done)
+        if (0 == dec_handle_ptr->mem_init_done && 1 == dec_handle_ptr->seq_header_done) {
+            /* The frames in flight use the contexts of the previous sequence */
+            dec_frame_slots_drain(dec_handle_ptr);
             status = dec_mem_init(dec_handle_ptr);
+        }
         if (status != EB_ErrorNone) return status;
 
         dec_bits_init(&bs, *data, data_size);
@@ -2483,7 +2557,8 @@ EbErrorType decode_multiple_obu(EbDecHandle *dec_handle_ptr, uint8_t **data, siz
 
             if (!dec_handle_ptr->seen_frame_header) {
                 dec_handle_ptr->seen_frame_header = 1;
-                status                            = read_frame_header_obu(
+                if (dec_handle_ptr->frame_slots != NULL) dec_frame_slot_acquire(dec_handle_ptr);
+                status = read_frame_header_obu(
                     &bs, dec_handle_ptr, &obu_header, obu_header.obu_type != OBU_FRAME);
             }
             /*else {
@@ -2498,12 +2573,24 @@ EbErrorType decode_multiple_obu(EbDecHandle *dec_handle_ptr, uint8_t **data, siz
         TITLE_GROUP:
             PRINT_NAME("**************OBU_TILE_GROUP*******************");
             if (!dec_handle_ptr->seen_frame_header) return EB_Corrupt_Frame;
-            status = read_tile_group_obu(&bs,
-                                         dec_handle_ptr,
-                                         &dec_handle_ptr->frame_header.tiles_info,
-                                         &obu_header,
-                                         &frame_decoding_finished);
-            if (status != EB_ErrorNone) return status;
+            if (dec_handle_ptr->frame_slots != NULL) {
+                /* The tiles are decoded on a frame thread */
+                frame_decoding_finished =
+                    is_last_tile_group(&bs, &dec_handle_ptr->frame_header.tiles_info);
+                status = dec_frame_slot_add_tg(dec_handle_ptr,
+                                               obu_header.obu_type,
+                                               get_bitsteam_buf(&bs),
+                                               obu_header.payload_size);
+                if (status != EB_ErrorNone) return status;
+                if (frame_decoding_finished) dec_frame_slot_submit(dec_handle_ptr);
+            } else {
+                status = read_tile_group_obu(&bs,
+                                             dec_handle_ptr,
+                                             &dec_handle_ptr->frame_header.tiles_info,
+                                             &obu_header,
+                                             &frame_decoding_finished);
+                if (status != EB_ErrorNone) return status;
+            }
             if (frame_decoding_finished) dec_handle_ptr->seen_frame_header = 0;
             break;
 
@@ -34,6 +34,285 @@
 
 #define NUM_REF_FRAMES 8 // TODO: remove (reuse EbObuParse.h macro)
 
+/* Library frame buffer allocator, used without application callbacks */
+static int dec_pic_mgr_alloc_fb(EbExtFrameBuf *fb, uint32_t min_size, void *priv_data) {
+    (void)priv_data;
+    fb->buffer       = (uint8_t *)malloc(min_size);
+    fb->buffer_size  = fb->buffer ? min_size : 0;
+    fb->private_data = NULL;
+    return fb->buffer ? 0 : -1;
+}
+
+static int dec_pic_mgr_release_fb(EbExtFrameBuf *fb, void *priv_data) {
+    (void)priv_data;
+    free(fb->buffer);
+    return 0;
+}
+
+static INLINE int32_t dec_pic_size_equal(const EbDecPicSize *a, const EbDecPicSize *b) {
+    return a->width == b->width && a->height == b->height && a->bit_depth == b->bit_depth &&
+           a->color_format == b->color_format;
+}
+
+static INLINE int8_t dec_pic_idx(EbDecPicMgr *ps_pic_mgr, EbDecPicBuf *ps_pic_buf) {
+    return (int8_t)(ps_pic_buf - ps_pic_mgr->as_dec_pic);
+}
+
+static INLINE int32_t dec_pic_size_idle(EbDecPicMgr *ps_pic_mgr, int8_t size_idx) {
+    return ps_pic_mgr->num_get_pic - ps_pic_mgr->free_lists[size_idx].last_get >
+           DEC_PIC_IDLE_FRAMES;
+}
+
+static void dec_pic_init_data(EbPictureBufferDescInitData *init_data, const EbDecPicSize *size) {
+    init_data->max_width          = size->width;
+    init_data->max_height         = size->height;
+    init_data->bit_depth          = size->bit_depth;
+    init_data->color_format       = size->color_format;
+    init_data->buffer_enable_mask = size->color_format == EB_YUV400
+                                        ? PICTURE_BUFFER_DESC_LUMA_MASK
+                                        : PICTURE_BUFFER_DESC_FULL_MASK;
+    init_data->left_padding       = PAD_VALUE;
+    init_data->right_padding      = PAD_VALUE;
+    init_data->top_padding        = PAD_VALUE;
+    init_data->bot_padding        = PAD_VALUE;
+    init_data->split_mode         = EB_FALSE;
+}
+
+static void dec_pic_mgr_add_bytes(EbDecPicMgr *ps_pic_mgr, uint64_t bytes) {
+    ps_pic_mgr->pool_bytes += bytes;
+    if (ps_pic_mgr->pool_bytes > ps_pic_mgr->max_pool_bytes)
+        ps_pic_mgr->max_pool_bytes = ps_pic_mgr->pool_bytes;
+}
+
+/* Gives all buffers of a picture back, the picture moves to no size */
+static void dec_pic_free_bufs(EbDecPicMgr *ps_pic_mgr, EbDecPicBuf *ps_pic_buf) {
+    if (ps_pic_buf->size_idx < 0) return;
+
+    EbDecPicSize *size     = &ps_pic_mgr->free_lists[ps_pic_buf->size_idx].size;
+    int32_t       mi_cols  = 2 * ((size->width + 7) >> 3);
+    int32_t       mi_rows  = 2 * ((size->height + 7) >> 3);
+    uint64_t      mvs_size = ROUND_POWER_OF_TWO(mi_cols, 1) * ROUND_POWER_OF_TWO(mi_rows, 1) *
+                        sizeof(TemporalMvRef);
+
+    ps_pic_mgr->pool_bytes -= ps_pic_buf->fb.buffer_size + mvs_size + mi_cols * mi_rows;
+    ps_pic_mgr->fb_release(&ps_pic_buf->fb, ps_pic_mgr->fb_priv);
+    ps_pic_buf->fb.buffer = NULL;
+    if (ps_pic_buf->fg_fb.buffer != NULL) {
+        ps_pic_mgr->pool_bytes -= ps_pic_buf->fg_fb.buffer_size;
+        ps_pic_mgr->fb_release(&ps_pic_buf->fg_fb, ps_pic_mgr->fb_priv);
+        ps_pic_buf->fg_fb.buffer = NULL;
+    }
+    free(ps_pic_buf->mvs);
+    ps_pic_buf->mvs          = NULL;
+    ps_pic_buf->segment_maps = NULL;
+
+    ps_pic_mgr->free_lists[ps_pic_buf->size_idx].num_pics--;
+    ps_pic_buf->size_idx = -1;
+    ps_pic_mgr->num_pic_bufs--;
+}
+
+/* Allocates the planes, MVs and segment map of a picture for a size */
+static EbErrorType dec_pic_alloc_bufs(EbDecPicMgr *ps_pic_mgr, EbDecPicBuf *ps_pic_buf,
+                                      int8_t size_idx) {
+    EbDecPicSize *              size = &ps_pic_mgr->free_lists[size_idx].size;
+    EbPictureBufferDescInitData init_data;
+    dec_pic_init_data(&init_data, size);
+
+    EbErrorType return_error = dec_eb_fb_recon_picture_buffer_desc_init(ps_pic_buf->ps_pic_buf,
+                                                                        (EbPtr)&init_data,
+                                                                        &ps_pic_buf->fb,
+                                                                        ps_pic_mgr->fb_alloc,
+                                                                        ps_pic_mgr->fb_priv);
+    if (return_error != EB_ErrorNone) {
+        if (ps_pic_buf->fb.buffer != NULL) {
+            ps_pic_mgr->fb_release(&ps_pic_buf->fb, ps_pic_mgr->fb_priv);
+            ps_pic_buf->fb.buffer = NULL;
+        }
+        return return_error;
+    }
+
+    /* MVs at 8x8 and the segment map share one allocation. Sized for the
+     * upscaled width, which covers the coded width of a super-res frame */
+    int32_t mi_cols  = 2 * ((size->width + 7) >> 3);
+    int32_t mi_rows  = 2 * ((size->height + 7) >> 3);
+    size_t  mvs_size = ROUND_POWER_OF_TWO(mi_cols, 1) * ROUND_POWER_OF_TWO(mi_rows, 1) *
+                      sizeof(TemporalMvRef);
+    ps_pic_buf->mvs = (TemporalMvRef *)malloc(mvs_size + mi_cols * mi_rows);
+    if (ps_pic_buf->mvs == NULL) {
+        ps_pic_mgr->fb_release(&ps_pic_buf->fb, ps_pic_mgr->fb_priv);
+        ps_pic_buf->fb.buffer = NULL;
+        return EB_ErrorInsufficientResources;
+    }
+    ps_pic_buf->segment_maps = (uint8_t *)ps_pic_buf->mvs + mvs_size;
+    memset(ps_pic_buf->segment_maps, 0, mi_cols * mi_rows);
+
+    ps_pic_buf->size_idx = size_idx;
+    ps_pic_mgr->free_lists[size_idx].num_pics++;
+    ps_pic_mgr->num_pic_bufs++;
+    if (ps_pic_mgr->num_pic_bufs > ps_pic_mgr->max_pic_bufs)
+        ps_pic_mgr->max_pic_bufs = ps_pic_mgr->num_pic_bufs;
+    dec_pic_mgr_add_bytes(ps_pic_mgr, ps_pic_buf->fb.buffer_size + mvs_size + mi_cols * mi_rows);
+    return EB_ErrorNone;
+}
+
+static INLINE void dec_pic_push_empty(EbDecPicMgr *ps_pic_mgr, EbDecPicBuf *ps_pic_buf) {
+    ps_pic_buf->next_free  = ps_pic_mgr->empty_head;
+    ps_pic_mgr->empty_head = dec_pic_idx(ps_pic_mgr, ps_pic_buf);
+}
+
+static INLINE EbDecPicBuf *dec_pic_pop(EbDecPicMgr *ps_pic_mgr, int8_t *head) {
+    if (*head < 0) return NULL;
+    EbDecPicBuf *ps_pic_buf = &ps_pic_mgr->as_dec_pic[*head];
+    *head                   = ps_pic_buf->next_free;
+    ps_pic_buf->next_free   = -1;
+    return ps_pic_buf;
+}
+
+/* Returns a picture whose last reference is gone to the pool. Pictures of
+ * a size no longer decoded give their buffers back right away */
+static void dec_pic_put(EbDecPicMgr *ps_pic_mgr, EbDecPicBuf *ps_pic_buf) {
+    ps_pic_buf->is_free = 1;
+    if (ps_pic_buf->size_idx >= 0 && !dec_pic_size_idle(ps_pic_mgr, ps_pic_buf->size_idx)) {
+        EbDecPicFreeList *free_list = &ps_pic_mgr->free_lists[ps_pic_buf->size_idx];
+        ps_pic_buf->next_free       = free_list->head;
+        free_list->head             = dec_pic_idx(ps_pic_mgr, ps_pic_buf);
+    } else {
+        dec_pic_free_bufs(ps_pic_mgr, ps_pic_buf);
+        dec_pic_push_empty(ps_pic_mgr, ps_pic_buf);
+    }
+}
+
+/* Takes a free picture back out of its list */
+static void dec_pic_unlink(EbDecPicMgr *ps_pic_mgr, EbDecPicBuf *ps_pic_buf) {
+    int8_t *link = ps_pic_buf->size_idx >= 0
+                       ? &ps_pic_mgr->free_lists[ps_pic_buf->size_idx].head
+                       : &ps_pic_mgr->empty_head;
+    int8_t  idx  = dec_pic_idx(ps_pic_mgr, ps_pic_buf);
+    while (*link >= 0 && *link != idx) link = &ps_pic_mgr->as_dec_pic[*link].next_free;
+    if (*link == idx) *link = ps_pic_buf->next_free;
+    ps_pic_buf->next_free = -1;
+}
+
+static int8_t dec_pic_find_size(EbDecPicMgr *ps_pic_mgr, const EbDecPicSize *size) {
+    for (int8_t i = 0; i < MAX_PIC_BUFS; i++) {
+        if (ps_pic_mgr->free_lists[i].num_pics &&
+            dec_pic_size_equal(&ps_pic_mgr->free_lists[i].size, size))
+            return i;
+    }
+    return -1;
+}
+
+/* Free list of a size, set up when new. Needs a picture without buffers,
+ * so that at most MAX_PIC_BUFS - 1 sizes are in use */
+static int8_t dec_pic_size_list(EbDecPicMgr *ps_pic_mgr, const EbDecPicSize *size) {
+    int8_t size_idx = dec_pic_find_size(ps_pic_mgr, size);
+    if (size_idx >= 0) return size_idx;
+
+    for (size_idx = 0; size_idx < MAX_PIC_BUFS && ps_pic_mgr->free_lists[size_idx].num_pics;
+         size_idx++)
+        ;
+    assert(size_idx < MAX_PIC_BUFS);
+    ps_pic_mgr->free_lists[size_idx].size     = *size;
+    ps_pic_mgr->free_lists[size_idx].head     = -1;
+    ps_pic_mgr->free_lists[size_idx].last_get = ps_pic_mgr->num_get_pic;
+    return size_idx;
+}
+
+/* Reclaims the free pictures of the sizes idle for DEC_PIC_IDLE_FRAMES */
+static void dec_pic_trim(EbDecPicMgr *ps_pic_mgr) {
+    for (int8_t i = 0; i < MAX_PIC_BUFS; i++) {
+        if (!ps_pic_mgr->free_lists[i].num_pics || !dec_pic_size_idle(ps_pic_mgr, i)) continue;
+        EbDecPicBuf *ps_pic_buf;
+        while ((ps_pic_buf = dec_pic_pop(ps_pic_mgr, &ps_pic_mgr->free_lists[i].head)) != NULL) {
+            dec_pic_free_bufs(ps_pic_mgr, ps_pic_buf);
+            dec_pic_push_empty(ps_pic_mgr, ps_pic_buf);
+        }
+    }
+}
+
+/* Takes a free picture with buffers of the given size: a pooled one when
+ * there is one, else an empty picture or the free picture of the least
+ * recently requested other size, (re)allocated. NULL when all are in use */
+static EbDecPicBuf *dec_pic_take(EbDecPicMgr *ps_pic_mgr, const EbDecPicSize *size) {
+    int8_t       size_idx   = dec_pic_find_size(ps_pic_mgr, size);
+    EbDecPicBuf *ps_pic_buf = NULL;
+
+    if (size_idx >= 0) {
+        ps_pic_buf = dec_pic_pop(ps_pic_mgr, &ps_pic_mgr->free_lists[size_idx].head);
+        if (ps_pic_buf != NULL) return ps_pic_buf;
+    }
+
+    ps_pic_buf = dec_pic_pop(ps_pic_mgr, &ps_pic_mgr->empty_head);
+    if (ps_pic_buf == NULL) {
+        int8_t lru_idx = -1;
+        for (int8_t i = 0; i < MAX_PIC_BUFS; i++) {
+            if (i == size_idx || ps_pic_mgr->free_lists[i].head < 0) continue;
+            if (lru_idx < 0 ||
+                ps_pic_mgr->free_lists[i].last_get < ps_pic_mgr->free_lists[lru_idx].last_get)
+                lru_idx = i;
+        }
+        if (lru_idx < 0) return NULL;
+        ps_pic_buf = dec_pic_pop(ps_pic_mgr, &ps_pic_mgr->free_lists[lru_idx].head);
+        dec_pic_free_bufs(ps_pic_mgr, ps_pic_buf);
+    }
+
+    if (dec_pic_alloc_bufs(ps_pic_mgr, ps_pic_buf, dec_pic_size_list(ps_pic_mgr, size)) !=
+        EB_ErrorNone) {
+        dec_pic_push_empty(ps_pic_mgr, ps_pic_buf);
+        return NULL;
+    }
+    return ps_pic_buf;
+}
+
+/* Fills the pool with pictures of the sequence size ahead of the first frame */
+static void dec_pic_mgr_prewarm(EbDecPicMgr *ps_pic_mgr, SeqHeader *seq_header,
+                                int32_t num_frms_prll) {
+    EbColorConfig *cc = &seq_header->color_config;
+    EbDecPicSize   size;
+    size.width     = seq_header->max_frame_width;
+    size.height    = seq_header->max_frame_height;
+    size.bit_depth = (EbBitDepthEnum)cc->bit_depth;
+    if (cc->mono_chrome)
+        size.color_format = EB_YUV400;
+    else if (cc->subsampling_x && cc->subsampling_y)
+        size.color_format = EB_YUV420;
+    else if (cc->subsampling_x)
+        size.color_format = EB_YUV422;
+    else
+        size.color_format = EB_YUV444;
+
+    /* A still picture needs a single buffer, other streams
+     * all references plus the frames being decoded */
+    int32_t num_pics = seq_header->still_picture ? 1 : REF_FRAMES + num_frms_prll;
+
+    eb_block_on_mutex(ps_pic_mgr->pic_mgr_mutex);
+    ps_pic_mgr->num_get_pic++;
+    int8_t size_idx = dec_pic_find_size(ps_pic_mgr, &size);
+    if (size_idx >= 0) {
+        ps_pic_mgr->free_lists[size_idx].last_get = ps_pic_mgr->num_get_pic;
+        num_pics -= ps_pic_mgr->free_lists[size_idx].num_pics;
+    }
+    for (; num_pics > 0 && ps_pic_mgr->empty_head >= 0; num_pics--) {
+        EbDecPicBuf *ps_pic_buf = dec_pic_pop(ps_pic_mgr, &ps_pic_mgr->empty_head);
+        if (dec_pic_alloc_bufs(ps_pic_mgr, ps_pic_buf, dec_pic_size_list(ps_pic_mgr, &size)) !=
+            EB_ErrorNone) {
+            dec_pic_push_empty(ps_pic_mgr, ps_pic_buf);
+            break;
+        }
+        dec_pic_put(ps_pic_mgr, ps_pic_buf);
+    }
+    eb_release_mutex(ps_pic_mgr->pic_mgr_mutex);
+}
+
+static INLINE void dec_ref_count_and_rel(EbDecPicMgr *ps_pic_mgr, EbDecPicBuf *ps_pic_buf) {
+    if (ps_pic_buf != NULL) {
+        assert(ps_pic_buf->ref_count > 0);
+        ps_pic_buf->ref_count--;
+
+        if (ps_pic_buf->ref_count == 0) dec_pic_put(ps_pic_mgr, ps_pic_buf);
+    }
+}
+
 /**
 *******************************************************************************
 *
@@ -41,7 +320,10 @@
 *  Picture manager initializer
 *
 * @par Description:
-*  Initialises the Picture manager structure
+*  Initialises the Picture manager structure and prewarms the pool for the
+*  sequence. On a new sequence the existing pool is kept: the references of
+*  the previous sequence are dropped and its free pictures are reclaimed
+*  once their size goes idle.
 *
 * @param[in] ps_pic_mgr
 *  Pointer to the Picture manager structure
@@ -55,41 +337,72 @@
 
 EbErrorType dec_pic_mgr_init(EbDecHandle *dec_handle_ptr) {
     EbDecPicMgr **pps_pic_mgr = (EbDecPicMgr **)&dec_handle_ptr->pv_pic_mgr;
-    uint32_t      mi_cols     = 2 * ((dec_handle_ptr->seq_header.max_frame_width + 7) >> 3);
-    uint32_t      mi_rows     = 2 * ((dec_handle_ptr->seq_header.max_frame_height + 7) >> 3);
-    int           size        = mi_cols * mi_rows;
 
     EbErrorType return_error = EB_ErrorNone;
     int32_t     i;
 
+    if (*pps_pic_mgr != NULL) {
+        EbDecPicMgr *ps_pic_mgr = *pps_pic_mgr;
+        eb_block_on_mutex(ps_pic_mgr->pic_mgr_mutex);
+        for (i = 0; i < REF_FRAMES; i++) {
+            dec_ref_count_and_rel(ps_pic_mgr, dec_handle_ptr->ref_frame_map[i]);
+            dec_handle_ptr->ref_frame_map[i] = NULL;
+        }
+        eb_release_mutex(ps_pic_mgr->pic_mgr_mutex);
+        dec_pic_mgr_prewarm(
+            ps_pic_mgr, &dec_handle_ptr->seq_header, dec_handle_ptr->num_frms_prll);
+        return return_error;
+    }
+
     EB_MALLOC_DEC(void *, *pps_pic_mgr, sizeof(EbDecPicMgr), EB_N_PTR);
 
     EbDecPicMgr *ps_pic_mgr = *pps_pic_mgr;
 
-    for (i = 0; i < MAX_PIC_BUFS; i++) {
-        ps_pic_mgr->as_dec_pic[i].ps_pic_buf = NULL;
-        ps_pic_mgr->as_dec_pic[i].is_free    = 1;
-        ps_pic_mgr->as_dec_pic[i].size       = 0;
-        ps_pic_mgr->as_dec_pic[i].ref_count  = 0;
-        ps_pic_mgr->as_dec_pic[i].mvs        = NULL;
+    ps_pic_mgr->empty_head = -1;
+    for (i = MAX_PIC_BUFS - 1; i >= 0; i--) {
+        EbDecPicBuf *ps_pic_buf = &ps_pic_mgr->as_dec_pic[i];
         EB_MALLOC_DEC(
-            uint8_t *, ps_pic_mgr->as_dec_pic[i].segment_maps, size * sizeof(uint8_t), EB_N_PTR);
-        memset(ps_pic_mgr->as_dec_pic[i].segment_maps, 0, size);
+            EbPictureBufferDesc *, ps_pic_buf->ps_pic_buf, sizeof(EbPictureBufferDesc), EB_N_PTR);
+        EB_MALLOC_DEC(EbPictureBufferDesc *,
+                      ps_pic_buf->ps_fg_pic_buf,
+                      sizeof(EbPictureBufferDesc),
+                      EB_N_PTR);
+        ps_pic_buf->fb.buffer    = NULL;
+        ps_pic_buf->fg_fb.buffer = NULL;
+        ps_pic_buf->is_free      = 1;
+        ps_pic_buf->size_idx     = -1;
+        ps_pic_buf->ref_count    = 0;
+        ps_pic_buf->mvs          = NULL;
+        ps_pic_buf->segment_maps = NULL;
+        dec_pic_push_empty(ps_pic_mgr, ps_pic_buf);
+
+        ps_pic_mgr->free_lists[i].head     = -1;
+        ps_pic_mgr->free_lists[i].num_pics = 0;
     }
 
-    ps_pic_mgr->num_pic_bufs = 0;
+    ps_pic_mgr->num_pic_bufs   = 0;
+    ps_pic_mgr->max_pic_bufs   = 0;
+    ps_pic_mgr->num_get_pic    = 0;
+    ps_pic_mgr->num_out_refs   = 0;
+    ps_pic_mgr->waiters        = NULL;
+    ps_pic_mgr->pool_bytes     = 0;
+    ps_pic_mgr->max_pool_bytes = 0;
 
-    return return_error;
-}
+    EB_CREATE_MUTEX(ps_pic_mgr->pic_mgr_mutex);
 
-static INLINE EbErrorType mvs_8x8_memory_alloc(TemporalMvRef **mvs, FrameHeader *frame_info) {
-    const int frame_mvs_stride = ROUND_POWER_OF_TWO(frame_info->mi_cols, 1);
-    const int frame_mvs_rows   = ROUND_POWER_OF_TWO(frame_info->mi_rows, 1);
-    const int mvs_buff_size    = frame_mvs_stride * frame_mvs_rows;
+    if (dec_handle_ptr->ext_fb_alloc != NULL) {
+        ps_pic_mgr->fb_alloc   = dec_handle_ptr->ext_fb_alloc;
+        ps_pic_mgr->fb_release = dec_handle_ptr->ext_fb_release;
+        ps_pic_mgr->fb_priv    = dec_handle_ptr->ext_fb_priv;
+    } else {
+        ps_pic_mgr->fb_alloc   = dec_pic_mgr_alloc_fb;
+        ps_pic_mgr->fb_release = dec_pic_mgr_release_fb;
+        ps_pic_mgr->fb_priv    = NULL;
+    }
 
-    EB_MALLOC_DEC(TemporalMvRef *, *mvs, mvs_buff_size * sizeof(*mvs), EB_N_PTR);
+    dec_pic_mgr_prewarm(ps_pic_mgr, &dec_handle_ptr->seq_header, dec_handle_ptr->num_frms_prll);
 
-    return EB_ErrorNone;
+    return return_error;
 }
 
 /**
@@ -99,12 +412,14 @@ static INLINE EbErrorType mvs_8x8_memory_alloc(TemporalMvRef **mvs, FrameHeader
 *  Get current Picture buffer
 *
 * @par Description:
-*  Give the free buffer from pool or dynamically allocate if nothing is free
+*  Give a free buffer of the frame size from the pool, or allocate one,
+*  reclaiming a free buffer of another size if the pool is full
 *
 * @param[in] ps_pic_mgr
 *  Pointer to the Picture manager structure
 *
 * @returns
+*  NULL if all the pictures are in use or the allocation failed
 *
 * @remarks
 *
@@ -112,76 +427,36 @@ static INLINE EbErrorType mvs_8x8_memory_alloc(TemporalMvRef **mvs, FrameHeader
 */
 EbDecPicBuf *dec_pic_mgr_get_cur_pic(EbDecPicMgr *ps_pic_mgr, SeqHeader *seq_header,
                                      FrameHeader *frame_info, EbColorFormat color_format) {
-    int32_t      i;
-    EbDecPicBuf *pic_buf = NULL;
-    /* TODO: Add lock and unlock for MT */
-    // Find a free buffer.
-    for (i = 0; i < MAX_PIC_BUFS; i++) {
-        if (ps_pic_mgr->as_dec_pic[i].is_free == 1) break;
-    }
-
-    if (i >= MAX_PIC_BUFS) return NULL;
-
-    uint16_t       frame_width  = frame_info->frame_size.frame_width;
-    uint16_t       frame_height = frame_info->frame_size.frame_height;
-    EbColorConfig *cc           = &seq_header->color_config;
-    size_t         y_size       = (frame_width + 2 * PAD_VALUE) * (frame_height + 2 * PAD_VALUE);
-    size_t         uv_size      = cc->mono_chrome ? 0
-                                     : (((frame_width + 2 * PAD_VALUE) >> cc->subsampling_x) *
-                                        ((frame_height + 2 * PAD_VALUE) >> cc->subsampling_y));
-    size_t frame_size = y_size + uv_size;
-
-    if (ps_pic_mgr->as_dec_pic[i].size < frame_size) {
-        /* allocate the buffer. TODO: Should add free and allocate logic */
-
-        EbPictureBufferDescInitData input_pic_buf_desc_init_data;
-        // Init Picture Init data
-        input_pic_buf_desc_init_data.max_width  = seq_header->max_frame_width;
-        input_pic_buf_desc_init_data.max_height = seq_header->max_frame_height;
-        input_pic_buf_desc_init_data.bit_depth  = (EbBitDepthEnum)cc->bit_depth;
-        assert(IMPLIES(cc->mono_chrome, color_format == EB_YUV400));
-        input_pic_buf_desc_init_data.color_format = cc->mono_chrome ? EB_YUV400 : color_format;
-        input_pic_buf_desc_init_data.buffer_enable_mask =
-            cc->mono_chrome ? PICTURE_BUFFER_DESC_LUMA_MASK : PICTURE_BUFFER_DESC_FULL_MASK;
-
-        input_pic_buf_desc_init_data.left_padding  = PAD_VALUE;
-        input_pic_buf_desc_init_data.right_padding = PAD_VALUE;
-        input_pic_buf_desc_init_data.top_padding   = PAD_VALUE;
-        input_pic_buf_desc_init_data.bot_padding   = PAD_VALUE;
-
-        input_pic_buf_desc_init_data.split_mode = EB_FALSE;
-
-        EbErrorType return_error = dec_eb_recon_picture_buffer_desc_ctor(
-            (EbPtr *)&(ps_pic_mgr->as_dec_pic[i].ps_pic_buf), (EbPtr)&input_pic_buf_desc_init_data);
-        if (return_error != EB_ErrorNone) return NULL;
-
-        ps_pic_mgr->as_dec_pic[i].size = frame_size;
-
-        /* Memory for storing MV's at 8x8 lvl*/
-        EbErrorType ret_err = mvs_8x8_memory_alloc(&ps_pic_mgr->as_dec_pic[i].mvs, frame_info);
-        if (ret_err != EB_ErrorNone) return NULL;
-
-        ps_pic_mgr->num_pic_bufs++;
-    } else
-        assert(ps_pic_mgr->as_dec_pic[i].ps_pic_buf != NULL);
-
-    ps_pic_mgr->as_dec_pic[i].is_free   = 0;
-    ps_pic_mgr->as_dec_pic[i].ref_count = 1;
+    EbColorConfig *cc = &seq_header->color_config;
+    EbDecPicSize   size;
+    size.width     = frame_info->frame_size.superres_upscaled_width;
+    size.height    = frame_info->frame_size.frame_height;
+    size.bit_depth = (EbBitDepthEnum)cc->bit_depth;
+    assert(IMPLIES(cc->mono_chrome, color_format == EB_YUV400));
+    size.color_format = cc->mono_chrome ? EB_YUV400 : color_format;
+
+    eb_block_on_mutex(ps_pic_mgr->pic_mgr_mutex);
+    ps_pic_mgr->num_get_pic++;
+    int8_t size_idx = dec_pic_find_size(ps_pic_mgr, &size);
+    if (size_idx >= 0) ps_pic_mgr->free_lists[size_idx].last_get = ps_pic_mgr->num_get_pic;
+    dec_pic_trim(ps_pic_mgr);
+
+    EbDecPicBuf *pic_buf = dec_pic_take(ps_pic_mgr, &size);
+    if (pic_buf != NULL) {
+        ps_pic_mgr->free_lists[pic_buf->size_idx].last_get = ps_pic_mgr->num_get_pic;
+        pic_buf->is_free                                   = 0;
+        pic_buf->ref_count                                 = 1;
+        pic_buf->sb_rows_done                              = -1;
+        pic_buf->num_sb_rows = ALIGN_POWER_OF_TWO(size.height, seq_header->sb_size_log2) >>
+                               seq_header->sb_size_log2;
+    }
+    eb_release_mutex(ps_pic_mgr->pic_mgr_mutex);
 
-    pic_buf = &ps_pic_mgr->as_dec_pic[i];
+    if (pic_buf == NULL) return NULL;
 
     return pic_buf;
 }
 
-static INLINE void dec_ref_count_and_rel(EbDecPicBuf *ps_pic_buf) {
-    if (ps_pic_buf != NULL) {
-        ps_pic_buf->ref_count--;
-        assert(ps_pic_buf->ref_count >= 0);
-
-        if (ps_pic_buf->ref_count == 0) ps_pic_buf->is_free = 1;
-    }
-}
-
 /**
 *******************************************************************************
 *
@@ -203,12 +478,13 @@ static INLINE void dec_ref_count_and_rel(EbDecPicBuf *ps_pic_buf) {
 */
 void dec_pic_mgr_update_ref_pic(EbDecHandle *dec_handle_ptr, int32_t frame_decoded,
                                 int32_t refresh_frame_flags) {
-    int32_t ref_index = 0, mask;
+    int32_t      ref_index  = 0, mask;
+    EbDecPicMgr *ps_pic_mgr = (EbDecPicMgr *)dec_handle_ptr->pv_pic_mgr;
 
-    /* TODO: Add lock and unlock for MT */
+    eb_block_on_mutex(ps_pic_mgr->pic_mgr_mutex);
     if (frame_decoded) {
         for (mask = refresh_frame_flags; mask; mask >>= 1) {
-            dec_ref_count_and_rel(dec_handle_ptr->ref_frame_map[ref_index]);
+            dec_ref_count_and_rel(ps_pic_mgr, dec_handle_ptr->ref_frame_map[ref_index]);
             dec_handle_ptr->ref_frame_map[ref_index] =
                 dec_handle_ptr->next_ref_frame_map[ref_index];
             dec_handle_ptr->next_ref_frame_map[ref_index] = NULL;
@@ -216,21 +492,21 @@ void dec_pic_mgr_update_ref_pic(EbDecHandle *dec_handle_ptr, int32_t frame_decod
         }
 
         for (; ref_index < REF_FRAMES; ++ref_index) {
-            dec_ref_count_and_rel(dec_handle_ptr->ref_frame_map[ref_index]);
+            dec_ref_count_and_rel(ps_pic_mgr, dec_handle_ptr->ref_frame_map[ref_index]);
             dec_handle_ptr->ref_frame_map[ref_index] =
                 dec_handle_ptr->next_ref_frame_map[ref_index];
             dec_handle_ptr->next_ref_frame_map[ref_index] = NULL;
         }
 
-        if (dec_handle_ptr->frame_header.show_existing_frame) {
-            //TODO: Add output Q logic
-            //assert(0);
-        } else
-            dec_ref_count_and_rel(dec_handle_ptr->cur_pic_buf[0]);
+        /* A shown existing frame is a buffer of ref_frame_map, not a new one:
+           its output holds its own reference, taken by dec_out_pic_push() */
+        if (!dec_handle_ptr->frame_header.show_existing_frame)
+            dec_ref_count_and_rel(ps_pic_mgr, dec_handle_ptr->cur_pic_buf[0]);
     } else {
         // Nothing was decoded, so just drop this frame buffer
-        dec_ref_count_and_rel(dec_handle_ptr->cur_pic_buf[0]);
+        dec_ref_count_and_rel(ps_pic_mgr, dec_handle_ptr->cur_pic_buf[0]);
     }
+    eb_release_mutex(ps_pic_mgr->pic_mgr_mutex);
 
     /* Invalidate these references until the next frame starts. */
     for (ref_index = 0; ref_index < INTER_REFS_PER_FRAME; ref_index++) {
@@ -244,12 +520,13 @@ void dec_pic_mgr_update_ref_pic(EbDecHandle *dec_handle_ptr, int32_t frame_decod
 
 // Generate next_ref_frame_map.
 void generate_next_ref_frame_map(EbDecHandle *dec_handle_ptr) {
-    /* TODO: Add lock and unlock for MT */
+    EbDecPicMgr *ps_pic_mgr = (EbDecPicMgr *)dec_handle_ptr->pv_pic_mgr;
 
     // next_ref_frame_map holds references to frame buffers. After storing a
     // frame buffer index in next_ref_frame_map, we need to increase the
     // frame buffer's ref_count.
     int32_t ref_index = 0;
+    eb_block_on_mutex(ps_pic_mgr->pic_mgr_mutex);
     for (int32_t mask = dec_handle_ptr->frame_header.refresh_frame_flags; mask; mask >>= 1) {
         if (mask & 1)
             dec_handle_ptr->next_ref_frame_map[ref_index] = dec_handle_ptr->cur_pic_buf[0];
@@ -267,6 +544,205 @@ void generate_next_ref_frame_map(EbDecHandle *dec_handle_ptr) {
         if (dec_handle_ptr->next_ref_frame_map[ref_index] != NULL)
             ++dec_handle_ptr->next_ref_frame_map[ref_index]->ref_count;
     }
+    eb_release_mutex(ps_pic_mgr->pic_mgr_mutex);
+}
+
+/**
+*******************************************************************************
+*
+* @brief
+*  Reference an output picture
+*
+* @par Description:
+*  Keeps the picture out of the pool while the application holds it.
+*  Called once the frame is decoded: the picture of a non reference frame
+*  is back in the pool by then, but not handed to another frame yet.
+*
+* @returns
+*  EB_ErrorInsufficientResources if the application holds
+*  DEC_MAX_OUT_PIC_REFS pictures already, the pool has no room for more
+*
+*******************************************************************************
+*/
+EbErrorType dec_pic_mgr_add_ref(EbDecPicMgr *ps_pic_mgr, EbDecPicBuf *ps_pic_buf) {
+    EbErrorType return_error = EB_ErrorNone;
+
+    eb_block_on_mutex(ps_pic_mgr->pic_mgr_mutex);
+    if (ps_pic_mgr->num_out_refs < DEC_MAX_OUT_PIC_REFS) {
+        if (ps_pic_buf->ref_count == 0) dec_pic_unlink(ps_pic_mgr, ps_pic_buf);
+        ps_pic_buf->ref_count++;
+        ps_pic_buf->is_free = 0;
+        ps_pic_mgr->num_out_refs++;
+    } else
+        return_error = EB_ErrorInsufficientResources;
+    eb_release_mutex(ps_pic_mgr->pic_mgr_mutex);
+
+    return return_error;
+}
+
+/**
+*******************************************************************************
+*
+* @brief
+*  Release an output picture
+*
+* @par Description:
+*  Drops the reference taken by dec_pic_mgr_add_ref. Safe to call from any
+*  thread, the picture goes back to the pool on its last reference.
+*
+*******************************************************************************
+*/
+void dec_pic_mgr_release(EbDecPicMgr *ps_pic_mgr, EbDecPicBuf *ps_pic_buf) {
+    eb_block_on_mutex(ps_pic_mgr->pic_mgr_mutex);
+    assert(ps_pic_mgr->num_out_refs > 0);
+    ps_pic_mgr->num_out_refs--;
+    dec_ref_count_and_rel(ps_pic_mgr, ps_pic_buf);
+    eb_release_mutex(ps_pic_mgr->pic_mgr_mutex);
+}
+
+/**
+*******************************************************************************
+*
+* @brief
+*  Reference pictures inside the library
+*
+* @par Description:
+*  Keeps the pictures of a frame decoded on a frame thread, or waiting for
+*  output, out of the pool. NULL entries are skipped.
+*
+*******************************************************************************
+*/
+void dec_pic_mgr_ref_pics(EbDecPicMgr *ps_pic_mgr, EbDecPicBuf **pic_bufs, int32_t num_pics) {
+    eb_block_on_mutex(ps_pic_mgr->pic_mgr_mutex);
+    for (int32_t i = 0; i < num_pics; i++) {
+        if (pic_bufs[i] == NULL) continue;
+        assert(pic_bufs[i]->ref_count > 0);
+        pic_bufs[i]->ref_count++;
+    }
+    eb_release_mutex(ps_pic_mgr->pic_mgr_mutex);
+}
+
+void dec_pic_mgr_unref_pics(EbDecPicMgr *ps_pic_mgr, EbDecPicBuf **pic_bufs, int32_t num_pics) {
+    eb_block_on_mutex(ps_pic_mgr->pic_mgr_mutex);
+    for (int32_t i = 0; i < num_pics; i++) dec_ref_count_and_rel(ps_pic_mgr, pic_bufs[i]);
+    eb_release_mutex(ps_pic_mgr->pic_mgr_mutex);
+}
+
+/**
+*******************************************************************************
+*
+* @brief
+*  Publish decode progress
+*
+* @par Description:
+*  0 once the frame is parsed: its CDFs, MVs and segment map are final.
+*  Then the number of SB rows final for prediction, num_sb_rows once the
+*  frame is filtered and padded. Wakes the threads waiting for it.
+*
+*******************************************************************************
+*/
+void dec_pic_mgr_set_progress(EbDecPicMgr *ps_pic_mgr, EbDecPicBuf *ps_pic_buf, int32_t sb_rows) {
+    eb_block_on_mutex(ps_pic_mgr->pic_mgr_mutex);
+    eb_atomic_store32(&ps_pic_buf->sb_rows_done, sb_rows);
+    DecPicWaiter **link = &ps_pic_mgr->waiters;
+    while (*link != NULL) {
+        DecPicWaiter *waiter = *link;
+        if (waiter->pic_buf == ps_pic_buf && waiter->sb_rows <= sb_rows) {
+            *link = waiter->next;
+            eb_post_semaphore(waiter->semaphore);
+        } else
+            link = &waiter->next;
+    }
+    eb_release_mutex(ps_pic_mgr->pic_mgr_mutex);
+}
+
+/**
+*******************************************************************************
+*
+* @brief
+*  Wait on decode progress
+*
+* @par Description:
+*  Blocks on the semaphore of the calling thread until sb_rows is published
+*  for the picture. Returns at once for a picture decoded already, which is
+*  always the case when frames are decoded one at a time.
+*
+*******************************************************************************
+*/
+void dec_pic_mgr_wait_progress(EbDecPicMgr *ps_pic_mgr, EbDecPicBuf *ps_pic_buf, int32_t sb_rows,
+                               EbHandle semaphore) {
+    if (eb_atomic_load32(&ps_pic_buf->sb_rows_done) >= sb_rows) return;
+
+    DecPicWaiter waiter;
+    eb_block_on_mutex(ps_pic_mgr->pic_mgr_mutex);
+    if (ps_pic_buf->sb_rows_done >= sb_rows) {
+        eb_release_mutex(ps_pic_mgr->pic_mgr_mutex);
+        return;
+    }
+    waiter.pic_buf      = ps_pic_buf;
+    waiter.sb_rows      = sb_rows;
+    waiter.semaphore    = semaphore;
+    waiter.next         = ps_pic_mgr->waiters;
+    ps_pic_mgr->waiters = &waiter;
+    eb_release_mutex(ps_pic_mgr->pic_mgr_mutex);
+
+    eb_block_on_semaphore(semaphore);
+}
+
+/**
+*******************************************************************************
+*
+* @brief
+*  Get the film grain picture buffer
+*
+* @par Description:
+*  Film grain is not part of the reference, so in zero-copy output mode the
+*  grain is added to a copy laid out like the recon buffer. The copy is
+*  allocated on first use and lives as long as the recon buffer.
+*
+* @returns
+*  NULL if the allocation failed
+*
+*******************************************************************************
+*/
+EbPictureBufferDesc *dec_pic_mgr_get_fg_pic(EbDecPicMgr *ps_pic_mgr, EbDecPicBuf *ps_pic_buf) {
+    if (ps_pic_buf->fg_fb.buffer != NULL) return ps_pic_buf->ps_fg_pic_buf;
+
+    EbPictureBufferDescInitData init_data;
+    dec_pic_init_data(&init_data, &ps_pic_mgr->free_lists[ps_pic_buf->size_idx].size);
+
+    EbErrorType return_error = dec_eb_fb_recon_picture_buffer_desc_init(ps_pic_buf->ps_fg_pic_buf,
+                                                                        (EbPtr)&init_data,
+                                                                        &ps_pic_buf->fg_fb,
+                                                                        ps_pic_mgr->fb_alloc,
+                                                                        ps_pic_mgr->fb_priv);
+    eb_block_on_mutex(ps_pic_mgr->pic_mgr_mutex);
+    if (return_error == EB_ErrorNone)
+        dec_pic_mgr_add_bytes(ps_pic_mgr, ps_pic_buf->fg_fb.buffer_size);
+    else if (ps_pic_buf->fg_fb.buffer != NULL) {
+        ps_pic_mgr->fb_release(&ps_pic_buf->fg_fb, ps_pic_mgr->fb_priv);
+        ps_pic_buf->fg_fb.buffer = NULL;
+    }
+    eb_release_mutex(ps_pic_mgr->pic_mgr_mutex);
+    return return_error == EB_ErrorNone ? ps_pic_buf->ps_fg_pic_buf : NULL;
+}
+
+/**
+*******************************************************************************
+*
+* @brief
+*  Free the picture buffers
+*
+* @par Description:
+*  Gives the buffers of every picture back, the frame buffers through the
+*  release callback. Called at deinit, before the picture manager itself
+*  is freed.
+*
+*******************************************************************************
+*/
+void dec_pic_mgr_free_bufs(EbDecPicMgr *ps_pic_mgr) {
+    for (int32_t i = 0; i < MAX_PIC_BUFS; i++)
+        dec_pic_free_bufs(ps_pic_mgr, &ps_pic_mgr->as_dec_pic[i]);
 }
 
 // These functions take a reference frame label between LAST_FRAME and
@@ -10,6 +10,37 @@
 extern "C" {
 #endif
 
+/* Free pictures of a size not requested for this many frames are reclaimed */
+#define DEC_PIC_IDLE_FRAMES (2 * REF_FRAMES)
+
+/** Geometry of a picture buffer, buffers are only reused for the same one **/
+typedef struct EbDecPicSize {
+    uint16_t       width;
+    uint16_t       height;
+    EbBitDepthEnum bit_depth;
+    EbColorFormat  color_format;
+} EbDecPicSize;
+
+/** Free pictures of one size **/
+typedef struct EbDecPicFreeList {
+    EbDecPicSize size;
+    /* First free picture, -1 when empty */
+    int8_t head;
+    /* Pictures with buffers of this size, free or not.
+     * The list is unused when 0 */
+    uint8_t num_pics;
+    /* num_get_pic when this size was last requested */
+    uint64_t last_get;
+} EbDecPicFreeList;
+
+/** Thread waiting on the decode progress of a picture **/
+typedef struct DecPicWaiter {
+    EbDecPicBuf *        pic_buf;
+    int32_t              sb_rows;
+    EbHandle             semaphore;
+    struct DecPicWaiter *next;
+} DecPicWaiter;
+
 /** Decoder Picture Manager **/
 typedef struct EbDecPicMgr {
     /* Array of picture buffers */
@@ -18,6 +49,34 @@ typedef struct EbDecPicMgr {
     /* number of picture buffers */
     uint8_t num_pic_bufs;
 
+    /* Guards the pool and the ref_count of the pictures, output
+     * pictures are released from application threads */
+    EbHandle pic_mgr_mutex;
+
+    /* Free pictures with buffers, keyed by size */
+    EbDecPicFreeList free_lists[MAX_PIC_BUFS];
+    /* Free pictures without buffers */
+    int8_t empty_head;
+
+    /* Number of pictures requested so far */
+    uint64_t num_get_pic;
+
+    /* References held by the application on output pictures */
+    uint8_t num_out_refs;
+
+    /* Threads waiting on the progress of a picture being decoded */
+    DecPicWaiter *waiters;
+
+    /* Bytes held by the pool, and high-water marks */
+    uint64_t pool_bytes;
+    uint64_t max_pool_bytes;
+    uint8_t  max_pic_bufs;
+
+    /* Frame buffer allocator, the application's callbacks or the library's */
+    EbAllocateFrameBuffer fb_alloc;
+    EbReleaseFrameBuffer  fb_release;
+    void *                fb_priv;
+
 } EbDecPicMgr;
 
 typedef struct RefFrameInfo {
@@ -35,6 +94,18 @@ EbDecPicBuf *dec_pic_mgr_get_cur_pic(EbDecPicMgr *ps_pic_mgr, SeqHeader *seq_hea
 void dec_pic_mgr_update_ref_pic(EbDecHandle *dec_handle_ptr, int32_t frame_decoded,
                                 int32_t refresh_frame_flags);
 
+EbErrorType          dec_pic_mgr_add_ref(EbDecPicMgr *ps_pic_mgr, EbDecPicBuf *ps_pic_buf);
+void                 dec_pic_mgr_release(EbDecPicMgr *ps_pic_mgr, EbDecPicBuf *ps_pic_buf);
+void                 dec_pic_mgr_ref_pics(EbDecPicMgr *ps_pic_mgr, EbDecPicBuf **pic_bufs,
+                                          int32_t num_pics);
+void                 dec_pic_mgr_unref_pics(EbDecPicMgr *ps_pic_mgr, EbDecPicBuf **pic_bufs,
+                                            int32_t num_pics);
+void dec_pic_mgr_set_progress(EbDecPicMgr *ps_pic_mgr, EbDecPicBuf *ps_pic_buf, int32_t sb_rows);
+void dec_pic_mgr_wait_progress(EbDecPicMgr *ps_pic_mgr, EbDecPicBuf *ps_pic_buf, int32_t sb_rows,
+                               EbHandle semaphore);
+EbPictureBufferDesc *dec_pic_mgr_get_fg_pic(EbDecPicMgr *ps_pic_mgr, EbDecPicBuf *ps_pic_buf);
+void                 dec_pic_mgr_free_bufs(EbDecPicMgr *ps_pic_mgr);
+
 void generate_next_ref_frame_map(EbDecHandle *dec_handle_ptr);
 
 EbDecPicBuf *get_ref_frame_buf(EbDecHandle *dec_handle_ptr, const MvReferenceFrame ref_frame);
@@ -16,18 +16,22 @@
 #include "EbSvtAv1Dec.h"
 #include "EbDecHandle.h"
 #include "EbDecMemInit.h"
+#include "EbDecPicMgr.h"
 
 #include "EbObuParse.h"
 #include "EbDecParseFrame.h"
 #include "EbDecProcessFrame.h"
 #include "EbDecLF.h"
 #include "EbDecCdef.h"
+#include "EbDecRestoration.h"
 
 #include "EbDecBitstream.h"
 #include "EbTime.h"
 
 #include "EbDecInverseQuantize.h"
+#include "grainSynthesis.h"
 #include "EbLog.h"
+#include "EbThreads.h"
 
 #include <stdlib.h>
 
@@ -42,6 +46,13 @@ void save_deblock_boundary_lines(uint8_t *src_buf, int32_t src_stride, int32_t s
                                  int32_t src_height, const Av1Common *cm, int32_t plane,
                                  int32_t row, int32_t stripe, int32_t use_highbd, int32_t is_above,
                                  RestorationStripeBoundaries *boundaries);
+void av1_superres_upscale_rows(Av1Common *cm, FrameHeader *frm_hdr, SeqHeader *seq_hdr,
+                               EbPictureBufferDesc *recon_picture_src, int32_t row_start,
+                               int32_t row_end, uint8_t *scratch, int32_t scratch_stride);
+EbErrorType read_tile_group_obu(Bitstrm *bs, EbDecHandle *dec_handle_ptr, TilesInfo *tiles_info,
+                                ObuHeader *obu_header, int *is_last_tg);
+void        dec_frame_alloc(EbDecHandle *dec_handle_ptr);
+void        dec_frame_setup(EbDecHandle *dec_handle_ptr);
 
 EbErrorType dec_dummy_ctor(DecMtNode *context_ptr, EbPtr object_init_data_ptr) {
     context_ptr->node_index = *(uint32_t *)object_init_data_ptr;
@@ -80,6 +91,10 @@ EbErrorType dec_system_resource_init(EbDecHandle *dec_handle_ptr, TilesInfo *til
     dec_mt_frame_data->motion_proj_info.num_motion_proj_rows = -1;
     EB_CREATE_MUTEX(dec_mt_frame_data->motion_proj_info.motion_proj_mutex);
 
+    /* Film Grain */
+    dec_mt_frame_data->fg_info.num_fg_stripes = 0;
+    EB_CREATE_MUTEX(dec_mt_frame_data->fg_info.fg_mutex);
+
     /* Parse Q */
     uint32_t node_idx = 0;
 
@@ -144,6 +159,35 @@ EbErrorType dec_system_resource_init(EbDecHandle *dec_handle_ptr, TilesInfo *til
         eb_system_resource_get_producer_fifo(dec_mt_frame_data->cdef_resource_ptr, 0);
     dec_mt_frame_data->cdef_row_consumer_fifo_ptr =
         eb_system_resource_get_consumer_fifo(dec_mt_frame_data->cdef_resource_ptr, 0);
+
+    /* SR queue */
+    EB_NEW(dec_mt_frame_data->sr_resource_ptr,
+           eb_system_resource_ctor,
+           picture_height_in_sb, /* object_total_count */
+           1, /* producer procs cnt : 1 Q per cnt is created inside, so kept 1*/
+           1, /* consumer prcos cnt : 1 Q per cnt is created inside, so kept 1*/
+           dec_dummy_creator,
+           &node_idx,
+           NULL);
+    dec_mt_frame_data->sr_row_producer_fifo_ptr =
+        eb_system_resource_get_producer_fifo(dec_mt_frame_data->sr_resource_ptr, 0);
+    dec_mt_frame_data->sr_row_consumer_fifo_ptr =
+        eb_system_resource_get_consumer_fifo(dec_mt_frame_data->sr_resource_ptr, 0);
+
+    /* LR queue : LR units are at least 64 luma rows high */
+    const int32_t num_planes = av1_num_planes(&dec_handle_ptr->seq_header.color_config);
+    EB_NEW(dec_mt_frame_data->lr_resource_ptr,
+           eb_system_resource_ctor,
+           num_planes * ((dec_handle_ptr->seq_header.max_frame_height + 63) >> 6),
+           1, /* producer procs cnt : 1 Q per cnt is created inside, so kept 1*/
+           1, /* consumer prcos cnt : 1 Q per cnt is created inside, so kept 1*/
+           dec_dummy_creator,
+           &node_idx,
+           NULL);
+    dec_mt_frame_data->lr_row_producer_fifo_ptr =
+        eb_system_resource_get_producer_fifo(dec_mt_frame_data->lr_resource_ptr, 0);
+    dec_mt_frame_data->lr_row_consumer_fifo_ptr =
+        eb_system_resource_get_consumer_fifo(dec_mt_frame_data->lr_resource_ptr, 0);
     /************************************
     * Contexts
     ************************************/
@@ -232,8 +276,7 @@ EbErrorType dec_system_resource_init(EbDecHandle *dec_handle_ptr, TilesInfo *til
                   EB_N_PTR);
 
     /* CDEF */
-    const int32_t num_planes = av1_num_planes(&dec_handle_ptr->seq_header.color_config);
-    uint32_t      mi_cols    = 2 * ((dec_handle_ptr->seq_header.max_frame_width + 7) >> 3);
+    uint32_t mi_cols = 2 * ((dec_handle_ptr->seq_header.max_frame_width + 7) >> 3);
 
     const int32_t nhfb = (mi_cols + MI_SIZE_64X64 - 1) / MI_SIZE_64X64;
     const int32_t nvfb =
@@ -279,6 +322,28 @@ EbErrorType dec_system_resource_init(EbDecHandle *dec_handle_ptr, TilesInfo *til
            0,
            (nvfb + 2) * //Rem here nhbf+2 u replaced with nvfb + 2
                sizeof(uint32_t));
+    EB_MALLOC_DEC(uint32_t *,
+                  dec_mt_frame_data->cdef_row_map,
+                  picture_height_in_sb * sizeof(uint32_t),
+                  EB_N_PTR);
+
+    /* SR & LR */
+    EB_MALLOC_DEC(uint32_t *,
+                  dec_mt_frame_data->sr_row_map,
+                  picture_height_in_sb * sizeof(uint32_t),
+                  EB_N_PTR);
+
+    const int32_t use_highbd = dec_handle_ptr->seq_header.color_config.bit_depth > 8;
+    dec_mt_frame_data->lr_scratch_stride =
+        ALIGN_POWER_OF_TWO(dec_handle_ptr->seq_header.max_frame_width, 4) +
+        2 * DEC_LR_SCRATCH_MARGIN;
+    const size_t lr_scratch_size =
+        (size_t)dec_mt_frame_data->lr_scratch_stride * DEC_LR_SCRATCH_ROWS << use_highbd;
+    EB_MALLOC_DEC(uint8_t *,
+                  ((LrCtxt *)dec_handle_ptr->pv_lr_ctxt)->lr_scratch,
+                  lr_scratch_size,
+                  EB_N_PTR);
+
     dec_mt_frame_data->temp_mutex = eb_create_mutex();
 
     dec_mt_frame_data->start_motion_proj  = EB_FALSE;
@@ -286,6 +351,8 @@ EbErrorType dec_system_resource_init(EbDecHandle *dec_handle_ptr, TilesInfo *til
     dec_mt_frame_data->start_decode_frame = EB_FALSE;
     dec_mt_frame_data->start_lf_frame     = EB_FALSE;
     dec_mt_frame_data->start_cdef_frame   = EB_FALSE;
+    dec_mt_frame_data->start_sr_frame     = EB_FALSE;
+    dec_mt_frame_data->start_lr_frame     = EB_FALSE;
     dec_mt_frame_data->num_threads_cdefed = 0;
     /************************************
     * Thread Handles
@@ -307,6 +374,13 @@ EbErrorType dec_system_resource_init(EbDecHandle *dec_handle_ptr, TilesInfo *til
             thread_ctxt_pa[i].thread_cnt     = i + 1;
             thread_ctxt_pa[i].dec_handle_ptr = dec_handle_ptr;
             init_dec_mod_ctxt(dec_handle_ptr, &thread_ctxt_pa[i].dec_mod_ctxt);
+            EB_MALLOC_DEC(RestorationLineBuffers *,
+                          thread_ctxt_pa[i].rlbs,
+                          sizeof(RestorationLineBuffers),
+                          EB_N_PTR);
+            EB_MALLOC_DEC(
+                int32_t *, thread_ctxt_pa[i].rst_tmpbuf, RESTORATION_TMPBUF_SIZE, EB_N_PTR);
+            EB_MALLOC_DEC(uint8_t *, thread_ctxt_pa[i].lr_scratch, lr_scratch_size, EB_N_PTR);
             EB_CREATE_SEMAPHORE(thread_ctxt_pa[i].thread_semaphore, 0, 100000);
         }
         EB_CREATE_THREAD_ARRAY(dec_handle_ptr->decode_thread_handle_array,
@@ -745,6 +819,7 @@ void svt_av1_queue_cdef_jobs(EbDecHandle *dec_handle_ptr) {
     const int32_t nvfb = (dec_handle_ptr->frame_header.mi_rows + MI_SIZE_64X64 - 1) / MI_SIZE_64X64;
 
     memset(dec_mt_frame_data->cdef_completed_in_row, 0, nvfb * sizeof(uint32_t));
+    memset(dec_mt_frame_data->cdef_row_map, 0, picture_height_in_sb * sizeof(uint32_t));
 
     for (uint32_t sb_fbr = 0; sb_fbr < picture_height_in_sb; ++sb_fbr) {
         // Get Empty LF Frame Row Job
@@ -846,6 +921,10 @@ void svt_cdef_frame_mt(EbDecHandle *dec_handle_ptr, DecThreadCtxt *thread_ctxt)
                                        &curr_blk_recon_buf[0]);
                 }
             }
+            /* Update CDEF done map */
+            eb_atomic_store32(
+                (volatile int32_t *)&dec_mt_frame_data->cdef_row_map[context_ptr->node_index], 1);
+
             // Release Parse Results
             eb_release_object(cdef_results_wrapper_ptr);
         } else
@@ -857,6 +936,195 @@ void svt_cdef_frame_mt(EbDecHandle *dec_handle_ptr, DecThreadCtxt *thread_ctxt)
         }
     } else
         for (int32_t pli = 0; pli < num_planes; pli++) { eb_aom_free(colbuf[pli]); }
+}
+
+static INLINE EbBool dec_mt_do_upscale(EbDecHandle *dec_handle_ptr) {
+    return !dec_handle_ptr->frame_header.allow_intrabc &&
+           !av1_superres_unscaled(&dec_handle_ptr->frame_header.frame_size);
+}
+
+static INLINE EbBool dec_mt_do_lr(EbDecHandle *dec_handle_ptr) {
+    LrParams *lr_param = dec_handle_ptr->frame_header.lr_params;
+    return !dec_handle_ptr->frame_header.allow_intrabc &&
+           (lr_param[AOM_PLANE_Y].frame_restoration_type != RESTORE_NONE ||
+            lr_param[AOM_PLANE_U].frame_restoration_type != RESTORE_NONE ||
+            lr_param[AOM_PLANE_V].frame_restoration_type != RESTORE_NONE);
+}
+
+void svt_av1_queue_sr_lr_jobs(EbDecHandle *dec_handle_ptr) {
+    DecMtFrameData *dec_mt_frame_data =
+        &dec_handle_ptr->master_frame_buf.cur_frame_bufs[0].dec_mt_frame_data;
+    EbObjectWrapper *wrapper_ptr;
+    EbBool           do_upscale = dec_mt_do_upscale(dec_handle_ptr);
+    EbBool           do_lr      = dec_mt_do_lr(dec_handle_ptr);
+
+    memset(dec_mt_frame_data->sr_row_map, 0, dec_mt_frame_data->sb_rows * sizeof(uint32_t));
+
+    /* SB row jobs : upscale, then pad the rows LR reads outside the frame */
+    if (do_upscale || do_lr) {
+        for (int32_t sb_row = 0; sb_row < dec_mt_frame_data->sb_rows; ++sb_row) {
+            eb_get_empty_object(dec_mt_frame_data->sr_row_producer_fifo_ptr, &wrapper_ptr);
+
+            DecMtNode *context_ptr  = (DecMtNode *)wrapper_ptr->object_ptr;
+            context_ptr->node_index = sb_row;
+
+            eb_post_full_object(wrapper_ptr);
+        }
+    }
+    if (!do_lr) return;
+
+    LrCtxt *     lr_ctxt   = (LrCtxt *)dec_handle_ptr->pv_lr_ctxt;
+    CurFrameBuf *frame_buf = &dec_handle_ptr->master_frame_buf.cur_frame_bufs[0];
+    const int    num_planes = av1_num_planes(&dec_handle_ptr->seq_header.color_config);
+
+    lr_ctxt->lr_unit[AOM_PLANE_Y] = frame_buf->lr_unit[AOM_PLANE_Y];
+    lr_ctxt->lr_unit[AOM_PLANE_U] = frame_buf->lr_unit[AOM_PLANE_U];
+    lr_ctxt->lr_unit[AOM_PLANE_V] = frame_buf->lr_unit[AOM_PLANE_V];
+
+    /* LR unit row jobs, top to bottom with the planes interleaved */
+    int32_t v_start, v_end;
+    for (int32_t unit_row = 0;; ++unit_row) {
+        EbBool posted = EB_FALSE;
+        for (int32_t plane = 0; plane < num_planes; ++plane) {
+            if (dec_handle_ptr->frame_header.lr_params[plane].frame_restoration_type ==
+                RESTORE_NONE)
+                continue;
+            if (!dec_av1_lr_unit_row_extent(dec_handle_ptr, plane, unit_row, &v_start, &v_end))
+                continue;
+            eb_get_empty_object(dec_mt_frame_data->lr_row_producer_fifo_ptr, &wrapper_ptr);
+
+            DecMtNode *context_ptr  = (DecMtNode *)wrapper_ptr->object_ptr;
+            context_ptr->node_index = (unit_row << 2) | plane;
+
+            eb_post_full_object(wrapper_ptr);
+            posted = EB_TRUE;
+        }
+        if (!posted) break;
+    }
+}
+
+/* Super-res upscale and LR padding of SB rows, behind CDEF row progress */
+void svt_superres_frame_mt(EbDecHandle *dec_handle_ptr, DecThreadCtxt *thread_ctxt) {
+    DecMtFrameData *dec_mt_frame_data =
+        &dec_handle_ptr->master_frame_buf.cur_frame_bufs[0].dec_mt_frame_data;
+    volatile EbBool *start_sr_frame = &dec_mt_frame_data->start_sr_frame;
+    while (*start_sr_frame != EB_TRUE)
+        eb_block_on_semaphore(NULL == thread_ctxt ? dec_handle_ptr->thread_semaphore
+                                                  : thread_ctxt->thread_semaphore);
+
+    EbPictureBufferDesc *recon_picture_ptr = dec_handle_ptr->cur_pic_buf[0]->ps_pic_buf;
+    FrameHeader *        frame_header      = &dec_handle_ptr->frame_header;
+    uint8_t *            scratch           = NULL == thread_ctxt
+                                ? ((LrCtxt *)dec_handle_ptr->pv_lr_ctxt)->lr_scratch
+                                : thread_ctxt->lr_scratch;
+    int32_t              sb_size_log2 = dec_handle_ptr->seq_header.sb_size_log2;
+    int32_t              sb_rows      = dec_mt_frame_data->sb_rows;
+    EbObjectWrapper *    sr_results_wrapper_ptr;
+    DecMtNode *          context_ptr;
+
+    while (1) {
+        eb_dec_get_full_object_non_blocking(dec_mt_frame_data->sr_row_consumer_fifo_ptr,
+                                            &sr_results_wrapper_ptr);
+
+        if (NULL != sr_results_wrapper_ptr) {
+            context_ptr    = (DecMtNode *)sr_results_wrapper_ptr->object_ptr;
+            int32_t sb_row = (int32_t)context_ptr->node_index;
+
+            /* Ensure CDEF is over for (row-1, row, row+1) : CDEF of the
+               neighbouring rows reads this row's pre-upscale pixels */
+            for (int32_t r = AOMMAX(sb_row - 1, 0); r <= AOMMIN(sb_row + 1, sb_rows - 1); r++) {
+                volatile int32_t *cdef_done =
+                    (volatile int32_t *)&dec_mt_frame_data->cdef_row_map[r];
+                int32_t spin = 0;
+                while (!eb_atomic_load32(cdef_done)) eb_spin_backoff(&spin);
+            }
+
+            int32_t row_start = sb_row << sb_size_log2;
+            int32_t row_end =
+                AOMMIN(row_start + (1 << sb_size_log2), frame_header->frame_size.frame_height);
+
+            if (dec_mt_do_upscale(dec_handle_ptr))
+                av1_superres_upscale_rows(&dec_handle_ptr->cm,
+                                          frame_header,
+                                          &dec_handle_ptr->seq_header,
+                                          recon_picture_ptr,
+                                          row_start,
+                                          row_end,
+                                          scratch,
+                                          dec_mt_frame_data->lr_scratch_stride);
+            if (dec_mt_do_lr(dec_handle_ptr))
+                lr_pad_pic_rows(recon_picture_ptr,
+                                frame_header,
+                                &dec_handle_ptr->seq_header.color_config,
+                                row_start,
+                                row_end);
+
+            /* Update SR done map */
+            eb_atomic_store32((volatile int32_t *)&dec_mt_frame_data->sr_row_map[sb_row], 1);
+
+            eb_release_object(sr_results_wrapper_ptr);
+        } else
+            break;
+    }
+}
+
+/* Loop restoration of LR unit rows, behind SR row progress. This is the last
+   MT stage of a frame, so the threads sync here before the next frame. */
+void dec_av1_loop_restoration_filter_frame_mt(EbDecHandle *  dec_handle_ptr,
+                                              DecThreadCtxt *thread_ctxt) {
+    DecMtFrameData *dec_mt_frame_data =
+        &dec_handle_ptr->master_frame_buf.cur_frame_bufs[0].dec_mt_frame_data;
+    volatile EbBool *start_lr_frame = &dec_mt_frame_data->start_lr_frame;
+    while (*start_lr_frame != EB_TRUE)
+        eb_block_on_semaphore(NULL == thread_ctxt ? dec_handle_ptr->thread_semaphore
+                                                  : thread_ctxt->thread_semaphore);
+
+    LrCtxt *                lr_ctxt = (LrCtxt *)dec_handle_ptr->pv_lr_ctxt;
+    RestorationLineBuffers *rlbs    = NULL == thread_ctxt ? lr_ctxt->rlbs : thread_ctxt->rlbs;
+    int32_t *rst_tmpbuf = NULL == thread_ctxt ? lr_ctxt->rst_tmpbuf : thread_ctxt->rst_tmpbuf;
+    uint8_t *scratch    = NULL == thread_ctxt ? lr_ctxt->lr_scratch : thread_ctxt->lr_scratch;
+    int32_t  sb_size_log2 = dec_handle_ptr->seq_header.sb_size_log2;
+    EbObjectWrapper *lr_results_wrapper_ptr;
+    DecMtNode *      context_ptr;
+
+    while (1) {
+        eb_dec_get_full_object_non_blocking(dec_mt_frame_data->lr_row_consumer_fifo_ptr,
+                                            &lr_results_wrapper_ptr);
+
+        if (NULL != lr_results_wrapper_ptr) {
+            context_ptr      = (DecMtNode *)lr_results_wrapper_ptr->object_ptr;
+            int32_t plane    = context_ptr->node_index & 3;
+            int32_t unit_row = context_ptr->node_index >> 2;
+            int32_t sy =
+                plane ? dec_handle_ptr->seq_header.color_config.subsampling_y : 0;
+            int32_t v_start, v_end;
+
+            dec_av1_lr_unit_row_extent(dec_handle_ptr, plane, unit_row, &v_start, &v_end);
+
+            /* Ensure SR is over for all SB rows the unit row covers */
+            int32_t sb_start = (v_start << sy) >> sb_size_log2;
+            int32_t sb_end   = AOMMIN(((v_end << sy) - 1) >> sb_size_log2,
+                                    dec_mt_frame_data->sb_rows - 1);
+            for (int32_t r = sb_start; r <= sb_end; r++) {
+                volatile int32_t *sr_done =
+                    (volatile int32_t *)&dec_mt_frame_data->sr_row_map[r];
+                int32_t spin = 0;
+                while (!eb_atomic_load32(sr_done)) eb_spin_backoff(&spin);
+            }
+
+            dec_av1_loop_restoration_filter_unit_row(dec_handle_ptr,
+                                                     plane,
+                                                     unit_row,
+                                                     rlbs,
+                                                     rst_tmpbuf,
+                                                     scratch,
+                                                     dec_mt_frame_data->lr_scratch_stride);
+
+            eb_release_object(lr_results_wrapper_ptr);
+        } else
+            break;
+    }
+
     const int32_t nvfb = (dec_handle_ptr->frame_header.mi_rows + MI_SIZE_64X64 - 1) / MI_SIZE_64X64;
 
     eb_block_on_mutex(dec_mt_frame_data->temp_mutex);
@@ -867,6 +1135,8 @@ void svt_cdef_frame_mt(EbDecHandle *dec_handle_ptr, DecThreadCtxt *thread_ctxt)
         dec_mt_frame_data->start_decode_frame = EB_FALSE;
         dec_mt_frame_data->start_lf_frame     = EB_FALSE;
         dec_mt_frame_data->start_cdef_frame   = EB_FALSE;
+        dec_mt_frame_data->start_sr_frame     = EB_FALSE;
+        dec_mt_frame_data->start_lr_frame     = EB_FALSE;
         memset(dec_mt_frame_data->cdef_completed_in_row, 0, nvfb * sizeof(uint32_t));
     }
     eb_release_mutex(dec_mt_frame_data->temp_mutex);
@@ -902,6 +1172,10 @@ void *dec_all_stage_kernel(void *input_ptr) {
                                      thread_ctxt);
         /*Frame CDEF*/
         svt_cdef_frame_mt(dec_handle_ptr, thread_ctxt);
+        /*Frame Super-res*/
+        svt_superres_frame_mt(dec_handle_ptr, thread_ctxt);
+        /*Frame LR*/
+        dec_av1_loop_restoration_filter_frame_mt(dec_handle_ptr, thread_ctxt);
         if (EB_TRUE == dec_mt_frame_data->end_flag) {
             eb_block_on_mutex(dec_mt_frame_data->temp_mutex);
             dec_mt_frame_data->num_threads_exited++;
@@ -938,8 +1212,311 @@ void dec_sync_all_threads(EbDecHandle *dec_handle_ptr) {
         eb_post_semaphore(dec_handle_ptr->thread_ctxt_pa[lib_thrd].thread_semaphore);
     dec_mt_frame_data->start_cdef_frame = EB_TRUE;
     eb_post_semaphore(dec_handle_ptr->thread_semaphore);
+    for (uint32_t lib_thrd = 0; lib_thrd < dec_handle_ptr->dec_config.threads - 1; lib_thrd++)
+        eb_post_semaphore(dec_handle_ptr->thread_ctxt_pa[lib_thrd].thread_semaphore);
+    dec_mt_frame_data->start_sr_frame = EB_TRUE;
+    eb_post_semaphore(dec_handle_ptr->thread_semaphore);
+    for (uint32_t lib_thrd = 0; lib_thrd < dec_handle_ptr->dec_config.threads - 1; lib_thrd++)
+        eb_post_semaphore(dec_handle_ptr->thread_ctxt_pa[lib_thrd].thread_semaphore);
+    dec_mt_frame_data->start_lr_frame = EB_TRUE;
+    eb_post_semaphore(dec_handle_ptr->thread_semaphore);
     for (uint32_t lib_thrd = 0; lib_thrd < dec_handle_ptr->dec_config.threads - 1; lib_thrd++)
         eb_post_semaphore(dec_handle_ptr->thread_ctxt_pa[lib_thrd].thread_semaphore);
     while (dec_mt_frame_data->num_threads_exited != dec_handle_ptr->dec_config.threads - 1)
         eb_sleep_ms(5);
 }
+
+/* Adds the grain to the stripes left in the frame, with the overlap buffers
+   of the calling thread */
+void dec_film_grain_stripes_mt(EbDecHandle *dec_handle_ptr, DecThreadCtxt *thread_ctxt) {
+    DecMtFilmGrainInfo *fg_info =
+        &dec_handle_ptr->master_frame_buf.cur_frame_bufs[0].dec_mt_frame_data.fg_info;
+    uint32_t slot = NULL == thread_ctxt ? 0 : thread_ctxt->thread_cnt;
+
+    while (1) {
+        int32_t stripe = -1;
+
+        //lock mutex
+        eb_block_on_mutex(fg_info->fg_mutex);
+
+        //pick up a stripe and increment the stripe counter
+        if (fg_info->fg_stripe_to_process < fg_info->num_fg_stripes)
+            stripe = fg_info->fg_stripe_to_process++;
+
+        //unlock mutex
+        eb_release_mutex(fg_info->fg_mutex);
+
+        if (-1 == stripe) break;
+
+        eb_av1_add_film_grain_stripe(
+            dec_handle_ptr->film_grain_ctxt, slot, stripe, fg_info->luma, fg_info->cb, fg_info->cr);
+
+        eb_block_on_mutex(fg_info->fg_mutex);
+        fg_info->num_fg_stripes_done++;
+        eb_release_mutex(fg_info->fg_mutex);
+    }
+}
+
+/* Adds the film grain to the output picture. The stripes are shared with the
+   worker threads, which wait for the next frame meanwhile */
+EbErrorType dec_add_film_grain(EbDecHandle *dec_handle_ptr, AomFilmGrain *film_grain_ptr,
+                               uint8_t *luma, uint8_t *cb, uint8_t *cr, int32_t height,
+                               int32_t width, int32_t luma_stride, int32_t chroma_stride,
+                               int32_t use_high_bit_depth, int32_t chroma_subsamp_y,
+                               int32_t chroma_subsamp_x) {
+    if (NULL == dec_handle_ptr->film_grain_ctxt) {
+        dec_handle_ptr->film_grain_ctxt =
+            eb_av1_film_grain_ctxt_alloc(dec_handle_ptr->dec_config.threads);
+        if (NULL == dec_handle_ptr->film_grain_ctxt) return EB_ErrorInsufficientResources;
+    }
+    FilmGrainCtxt *ctxt = dec_handle_ptr->film_grain_ctxt;
+
+    EbErrorType return_error = eb_av1_film_grain_prepare(ctxt,
+                                                         film_grain_ptr,
+                                                         width,
+                                                         height,
+                                                         luma_stride,
+                                                         chroma_stride,
+                                                         use_high_bit_depth,
+                                                         chroma_subsamp_y,
+                                                         chroma_subsamp_x);
+    if (return_error != EB_ErrorNone) return return_error;
+
+    const int32_t num_stripes = eb_av1_film_grain_stripe_count(ctxt);
+
+    if (dec_handle_ptr->dec_config.threads == 1 || !dec_handle_ptr->start_thread_process) {
+        for (int32_t stripe = 0; stripe < num_stripes; stripe++)
+            eb_av1_add_film_grain_stripe(ctxt, 0, stripe, luma, cb, cr);
+        return EB_ErrorNone;
+    }
+
+    DecMtFilmGrainInfo *fg_info =
+        &dec_handle_ptr->master_frame_buf.cur_frame_bufs[0].dec_mt_frame_data.fg_info;
+
+    eb_block_on_mutex(fg_info->fg_mutex);
+    fg_info->luma                 = luma;
+    fg_info->cb                   = cb;
+    fg_info->cr                   = cr;
+    fg_info->fg_stripe_to_process = 0;
+    fg_info->num_fg_stripes_done  = 0;
+    fg_info->num_fg_stripes       = num_stripes;
+    eb_release_mutex(fg_info->fg_mutex);
+
+    for (uint32_t lib_thrd = 0; lib_thrd < dec_handle_ptr->dec_config.threads - 1; lib_thrd++)
+        eb_post_semaphore(dec_handle_ptr->thread_ctxt_pa[lib_thrd].thread_semaphore);
+
+    dec_film_grain_stripes_mt(dec_handle_ptr, NULL);
+
+    /* The stripes still running on the workers are short, poll with backoff */
+    int32_t spin = 0;
+    while (eb_atomic_load32(&fg_info->num_fg_stripes_done) != num_stripes)
+        eb_spin_backoff(&spin);
+
+    return EB_ErrorNone;
+}
+
+/************************************
+* Frame Parallel Decoding
+************************************/
+
+/* Frame thread: decodes the frames handed to its slot, one at a time */
+static void *dec_frame_kernel(void *input_ptr) {
+    DecFrameSlot *slot       = (DecFrameSlot *)input_ptr;
+    EbDecHandle * frm_handle = slot->dec_handle_ptr;
+
+    while (1) {
+        eb_block_on_semaphore(slot->start_semaphore);
+        if (slot->exit) break;
+
+        EbDecPicMgr *ps_pic_mgr = (EbDecPicMgr *)frm_handle->pv_pic_mgr;
+        EbDecPicBuf *cur_pic    = frm_handle->cur_pic_buf[0];
+
+        /* CDFs, MVs and segment maps are read from the references as the
+           frame starts, their pixels only as the blocks are predicted */
+        for (int32_t i = 0; i < REF_FRAMES; i++) {
+            if (frm_handle->ref_frame_map[i] != NULL)
+                dec_pic_mgr_wait_progress(
+                    ps_pic_mgr, frm_handle->ref_frame_map[i], 0, frm_handle->progress_semaphore);
+        }
+        dec_frame_setup(frm_handle);
+
+        for (int32_t i = 0; i < slot->num_tg_obus; i++) {
+            DecTileGroupObu *tg_obu     = &slot->tg_obus[i];
+            int              is_last_tg = 0;
+            Bitstrm          bs;
+            ObuHeader        obu_header;
+            memset(&obu_header, 0, sizeof(obu_header));
+            obu_header.obu_type     = tg_obu->obu_type;
+            obu_header.payload_size = tg_obu->size;
+            dec_bits_init(&bs, slot->tg_data + tg_obu->offset, tg_obu->size);
+            if (read_tile_group_obu(&bs,
+                                    frm_handle,
+                                    &frm_handle->frame_header.tiles_info,
+                                    &obu_header,
+                                    &is_last_tg) != EB_ErrorNone)
+                break;
+        }
+        /* Even a frame that failed to decode must not be waited for any longer */
+        dec_pic_mgr_set_progress(ps_pic_mgr, cur_pic, cur_pic->num_sb_rows);
+
+        dec_pic_mgr_unref_pics(ps_pic_mgr, frm_handle->ref_frame_map, REF_FRAMES);
+        dec_pic_mgr_unref_pics(ps_pic_mgr, frm_handle->cur_pic_buf, 1);
+        eb_post_semaphore(slot->done_semaphore);
+    }
+    return EB_NULL;
+}
+
+/* Creates the frame threads, each with a handle holding the state of the
+   frame it decodes. Their contexts are allocated by dec_mem_init */
+EbErrorType dec_frame_slots_init(EbDecHandle *dec_handle_ptr) {
+    EbErrorType return_error = EB_ErrorNone;
+    int32_t     num_slots    = dec_handle_ptr->num_frms_prll;
+
+    EB_MALLOC_DEC(DecFrameSlot *,
+                  dec_handle_ptr->frame_slots,
+                  num_slots * sizeof(DecFrameSlot),
+                  EB_N_PTR);
+    memset(dec_handle_ptr->frame_slots, 0, num_slots * sizeof(DecFrameSlot));
+    dec_handle_ptr->cur_slot = 0;
+
+    for (int32_t i = 0; i < num_slots; i++) {
+        DecFrameSlot *slot = &dec_handle_ptr->frame_slots[i];
+        EB_MALLOC_DEC(EbDecHandle *, slot->dec_handle_ptr, sizeof(EbDecHandle), EB_N_PTR);
+
+        EbDecHandle *frm_handle          = slot->dec_handle_ptr;
+        *frm_handle                      = *dec_handle_ptr;
+        frm_handle->num_frms_prll        = 1;
+        frm_handle->dec_config.threads   = 1;
+        frm_handle->mem_init_done        = 0;
+        frm_handle->pv_master_parse_ctxt = NULL;
+        frm_handle->pv_dec_mod_ctxt      = NULL;
+        frm_handle->pv_lf_ctxt           = NULL;
+        frm_handle->pv_lr_ctxt           = NULL;
+        frm_handle->start_thread_process = EB_FALSE;
+        frm_handle->film_grain_ctxt      = NULL;
+        frm_handle->frame_slots          = NULL;
+        frm_handle->num_out_pics         = 0;
+        frm_handle->progress_semaphore   = eb_create_semaphore(0, 1);
+
+        slot->start_semaphore = eb_create_semaphore(0, 1);
+        slot->done_semaphore  = eb_create_semaphore(0, 1);
+        if (frm_handle->progress_semaphore == NULL || slot->start_semaphore == NULL ||
+            slot->done_semaphore == NULL)
+            return EB_ErrorInsufficientResources;
+        slot->thread = eb_create_thread(dec_frame_kernel, slot);
+        if (slot->thread == NULL) return EB_ErrorInsufficientResources;
+    }
+    return return_error;
+}
+
+/* Waits for the frames handed to the frame threads */
+void dec_frame_slots_drain(EbDecHandle *dec_handle_ptr) {
+    if (dec_handle_ptr->frame_slots == NULL) return;
+    for (int32_t i = 0; i < dec_handle_ptr->num_frms_prll; i++) {
+        DecFrameSlot *slot = &dec_handle_ptr->frame_slots[i];
+        if (slot->busy) {
+            eb_block_on_semaphore(slot->done_semaphore);
+            slot->busy = EB_FALSE;
+        }
+    }
+}
+
+void dec_frame_slots_deinit(EbDecHandle *dec_handle_ptr) {
+    if (dec_handle_ptr->frame_slots == NULL) return;
+    dec_frame_slots_drain(dec_handle_ptr);
+    for (int32_t i = 0; i < dec_handle_ptr->num_frms_prll; i++) {
+        DecFrameSlot *slot = &dec_handle_ptr->frame_slots[i];
+        if (slot->thread != NULL) {
+            slot->exit = EB_TRUE;
+            eb_post_semaphore(slot->start_semaphore);
+            eb_destroy_thread(slot->thread);
+        }
+        if (slot->start_semaphore != NULL) eb_destroy_semaphore(slot->start_semaphore);
+        if (slot->done_semaphore != NULL) eb_destroy_semaphore(slot->done_semaphore);
+        if (slot->dec_handle_ptr != NULL && slot->dec_handle_ptr->progress_semaphore != NULL)
+            eb_destroy_semaphore(slot->dec_handle_ptr->progress_semaphore);
+        free(slot->tg_data);
+        free(slot->tg_obus);
+    }
+    dec_handle_ptr->frame_slots = NULL;
+}
+
+/* Waits for the frame thread the next frame is handed to */
+void dec_frame_slot_acquire(EbDecHandle *dec_handle_ptr) {
+    DecFrameSlot *slot = &dec_handle_ptr->frame_slots[dec_handle_ptr->cur_slot];
+    if (slot->busy) {
+        eb_block_on_semaphore(slot->done_semaphore);
+        slot->busy = EB_FALSE;
+    }
+    slot->num_tg_obus  = 0;
+    slot->tg_data_size = 0;
+}
+
+/* Copies a tile group OBU of the frame, the caller's data is not kept */
+EbErrorType dec_frame_slot_add_tg(EbDecHandle *dec_handle_ptr, ObuType obu_type,
+                                  const uint8_t *data, size_t size) {
+    DecFrameSlot *slot = &dec_handle_ptr->frame_slots[dec_handle_ptr->cur_slot];
+
+    if (slot->num_tg_obus == slot->max_tg_obus) {
+        int32_t          max_tg_obus = slot->max_tg_obus ? 2 * slot->max_tg_obus : 4;
+        DecTileGroupObu *tg_obus =
+            (DecTileGroupObu *)realloc(slot->tg_obus, max_tg_obus * sizeof(DecTileGroupObu));
+        if (tg_obus == NULL) return EB_ErrorInsufficientResources;
+        slot->tg_obus     = tg_obus;
+        slot->max_tg_obus = max_tg_obus;
+    }
+    if (slot->tg_data_size + size > slot->tg_data_alloc) {
+        size_t   tg_data_alloc = AOMMAX(2 * slot->tg_data_alloc, slot->tg_data_size + size);
+        uint8_t *tg_data       = (uint8_t *)realloc(slot->tg_data, tg_data_alloc);
+        if (tg_data == NULL) return EB_ErrorInsufficientResources;
+        slot->tg_data       = tg_data;
+        slot->tg_data_alloc = tg_data_alloc;
+    }
+
+    DecTileGroupObu *tg_obu = &slot->tg_obus[slot->num_tg_obus++];
+    tg_obu->obu_type        = obu_type;
+    tg_obu->offset          = slot->tg_data_size;
+    tg_obu->size            = size;
+    memcpy(slot->tg_data + slot->tg_data_size, data, size);
+    slot->tg_data_size += size;
+    return EB_ErrorNone;
+}
+
+/* Hands the frame, whose headers were just parsed, to its frame thread */
+void dec_frame_slot_submit(EbDecHandle *dec_handle_ptr) {
+    DecFrameSlot *slot       = &dec_handle_ptr->frame_slots[dec_handle_ptr->cur_slot];
+    EbDecHandle * frm_handle = slot->dec_handle_ptr;
+    EbDecPicMgr * ps_pic_mgr = (EbDecPicMgr *)dec_handle_ptr->pv_pic_mgr;
+
+    frm_handle->dec_cnt             = dec_handle_ptr->dec_cnt;
+    frm_handle->dec_config          = dec_handle_ptr->dec_config;
+    frm_handle->seq_header          = dec_handle_ptr->seq_header;
+    frm_handle->frame_header        = dec_handle_ptr->frame_header;
+    frm_handle->show_existing_frame = dec_handle_ptr->show_existing_frame;
+    frm_handle->show_frame          = dec_handle_ptr->show_frame;
+    frm_handle->showable_frame      = dec_handle_ptr->showable_frame;
+    frm_handle->sf_identity         = dec_handle_ptr->sf_identity;
+    frm_handle->cur_pic_buf[0]      = dec_handle_ptr->cur_pic_buf[0];
+    memcpy(frm_handle->remapped_ref_idx,
+           dec_handle_ptr->remapped_ref_idx,
+           sizeof(frm_handle->remapped_ref_idx));
+    memcpy(frm_handle->ref_scale_factors,
+           dec_handle_ptr->ref_scale_factors,
+           sizeof(frm_handle->ref_scale_factors));
+    memcpy(frm_handle->ref_frame_map,
+           dec_handle_ptr->ref_frame_map,
+           sizeof(frm_handle->ref_frame_map));
+    memcpy(frm_handle->master_frame_buf.cur_frame_bufs[0].global_motion_warp,
+           dec_handle_ptr->master_frame_buf.cur_frame_bufs[0].global_motion_warp,
+           sizeof(frm_handle->master_frame_buf.cur_frame_bufs[0].global_motion_warp));
+    frm_handle->dec_config.threads = 1;
+
+    /* The frame keeps its picture and references until it is decoded */
+    dec_pic_mgr_ref_pics(ps_pic_mgr, frm_handle->ref_frame_map, REF_FRAMES);
+    dec_pic_mgr_ref_pics(ps_pic_mgr, frm_handle->cur_pic_buf, 1);
+    dec_frame_alloc(frm_handle);
+
+    slot->busy = EB_TRUE;
+    eb_post_semaphore(slot->start_semaphore);
+    dec_handle_ptr->cur_slot = (dec_handle_ptr->cur_slot + 1) % dec_handle_ptr->num_frms_prll;
+}
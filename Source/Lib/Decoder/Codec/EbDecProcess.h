@@ -36,6 +36,24 @@ typedef struct DecMtMotionProjInfo {
 
 } DecMtMotionProjInfo;
 
+typedef struct DecMtFilmGrainInfo {
+    /* Number of grain stripes in Frame : 32 luma rows each */
+    int32_t num_fg_stripes;
+
+    /* mutex handle for stripe assignment */
+    EbHandle fg_mutex;
+
+    /* Film grain stripe state context */
+    int32_t fg_stripe_to_process;
+    int32_t num_fg_stripes_done;
+
+    /* Output planes the grain is added to */
+    uint8_t *luma;
+    uint8_t *cb;
+    uint8_t *cr;
+
+} DecMtFilmGrainInfo;
+
 /* Stores the Queue & other related info needed between
    Parse and Recon for a Tile */
 typedef struct DecMtParseReconTileInfo {
@@ -115,6 +133,8 @@ typedef struct DecMtFrameData {
     EbBool   start_decode_frame;
     EbBool   start_lf_frame;
     EbBool   start_cdef_frame;
+    EbBool   start_sr_frame;
+    EbBool   start_lr_frame;
     EbHandle temp_mutex;
 
     TilesInfo *tiles_info;
@@ -123,6 +143,9 @@ typedef struct DecMtFrameData {
     DecMtMotionProjInfo motion_proj_info;
     uint32_t            num_threads_header; /*ToDo : should remove */
 
+    /* Film Grain Info, stripes of the output picture */
+    DecMtFilmGrainInfo fg_info;
+
     // System Resource Managers
     EbSystemResource *parse_tile_resource_ptr;
     /* EbFifo at Tile level : Parse Stage */
@@ -168,10 +191,24 @@ typedef struct DecMtFrameData {
     /*Siva:*/
     uint32_t cdef_map_stride;
     EbFifo * cdef_fifo_ptr;
-    /* EbFifo at Frame Row level : SR Stage */
-    EbFifo *sr_fifo_ptr;
-    /* EbFifo at Frame Row level : LR Stage */
-    EbFifo *lr_fifo_ptr;
+    /* CDEF done map at SB row level, SR stage waits on it */
+    uint32_t *cdef_row_map;
+
+    /* EbFifo at Frame Row level : SR Stage.
+       Super-res upscale and LR padding of one SB row */
+    EbSystemResource *sr_resource_ptr;
+    EbFifo *          sr_row_producer_fifo_ptr;
+    EbFifo *          sr_row_consumer_fifo_ptr;
+    /* SR done map at SB row level, LR stage waits on it */
+    uint32_t *sr_row_map;
+
+    /* EbFifo at LR unit row level : LR Stage.
+       node_index is (unit_row << 2) | plane */
+    EbSystemResource *lr_resource_ptr;
+    EbFifo *          lr_row_producer_fifo_ptr;
+    EbFifo *          lr_row_consumer_fifo_ptr;
+    /* Row scratch stride of DecThreadCtxt::lr_scratch, in pixels */
+    int32_t lr_scratch_stride;
     /* EbFifo at Frame Row level : Pad Stage */
     EbFifo *pad_fifo_ptr;
 
@@ -75,6 +75,9 @@ typedef struct LrCtxt {
 
     /* Pointer to a scratch buffer used by self-guided restoration */
     int32_t *rst_tmpbuf;
+
+    /* Main thread's row scratch for the MT super-res and LR jobs */
+    uint8_t *lr_scratch;
 } LrCtxt;
 
 void decode_super_block(DecModCtxt *dec_mod_ctxt, uint32_t mi_row, uint32_t mi_col,
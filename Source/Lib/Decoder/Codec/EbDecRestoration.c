@@ -18,6 +18,7 @@
 #include "EbDecUtils.h"
 #include "EbDecProcessFrame.h"
 #include "../../Encoder/Codec/EbRestoration.h"
+#include "EbDecRestoration.h"
 
 #define LR_PAD_SIDE 3
 #define LR_PAD_MAX (LR_PAD_SIDE << 1)
@@ -33,7 +34,9 @@ void lr_generate_padding(
     uint32_t
         original_src_width, //input paramter, the width of the source picture which excludes the padding.
     uint32_t
-        original_src_height) //input paramter, the heigth of the source picture which excludes the padding.
+             original_src_height, //input paramter, the heigth of the source picture which excludes the padding.
+    uint32_t row_start, //input paramter, first row to pad horizontally.
+    uint32_t row_end) //input paramter, row after the last one to pad horizontally.
 {
     uint32_t vertical_idx;
     EbByte   temp_src_pic0;
@@ -41,8 +44,8 @@ void lr_generate_padding(
     EbByte   temp_src_pic2;
     EbByte   temp_src_pic3;
 
-    temp_src_pic0 = src_pic;
-    for (vertical_idx = original_src_height; vertical_idx > 0; --vertical_idx) {
+    temp_src_pic0 = src_pic + row_start * src_stride;
+    for (vertical_idx = row_end - row_start; vertical_idx > 0; --vertical_idx) {
         // horizontal padding
         EB_MEMSET(temp_src_pic0 - LR_PAD_SIDE, *temp_src_pic0, LR_PAD_SIDE);
         EB_MEMSET(temp_src_pic0 + original_src_width,
@@ -60,12 +63,14 @@ void lr_generate_padding(
     for (vertical_idx = LR_PAD_SIDE; vertical_idx > 0; --vertical_idx) {
         // top part data copy
         temp_src_pic2 -= src_stride;
-        EB_MEMCPY(
-            temp_src_pic2, temp_src_pic0, sizeof(uint8_t) * (original_src_width + LR_PAD_MAX));
+        if (row_start == 0)
+            EB_MEMCPY(
+                temp_src_pic2, temp_src_pic0, sizeof(uint8_t) * (original_src_width + LR_PAD_MAX));
         // bottom part data copy
         temp_src_pic3 += src_stride;
-        EB_MEMCPY(
-            temp_src_pic3, temp_src_pic1, sizeof(uint8_t) * (original_src_width + LR_PAD_MAX));
+        if (row_end == original_src_height)
+            EB_MEMCPY(
+                temp_src_pic3, temp_src_pic1, sizeof(uint8_t) * (original_src_width + LR_PAD_MAX));
     }
     return;
 }
@@ -76,7 +81,9 @@ void lr_generate_padding16_bit(
     uint32_t
         original_src_width, //input paramter, the width of the source picture which excludes the padding.
     uint32_t
-        original_src_height) //input paramter, the height of the source picture which excludes the padding.
+             original_src_height, //input paramter, the height of the source picture which excludes the padding.
+    uint32_t row_start, //input paramter, first row to pad horizontally.
+    uint32_t row_end) //input paramter, row after the last one to pad horizontally.
 {
     uint32_t vertical_idx;
     EbByte   temp_src_pic0;
@@ -85,8 +92,8 @@ void lr_generate_padding16_bit(
     EbByte   temp_src_pic3;
     uint8_t  use_highbd = 1;
 
-    temp_src_pic0 = src_pic;
-    for (vertical_idx = original_src_height; vertical_idx > 0; --vertical_idx) {
+    temp_src_pic0 = src_pic + row_start * src_stride;
+    for (vertical_idx = row_end - row_start; vertical_idx > 0; --vertical_idx) {
         // horizontal padding
         memset16bit((uint16_t *)(temp_src_pic0 - (LR_PAD_SIDE << use_highbd)),
                     ((uint16_t *)(temp_src_pic0))[0],
@@ -105,24 +112,32 @@ void lr_generate_padding16_bit(
     for (vertical_idx = LR_PAD_SIDE; vertical_idx > 0; --vertical_idx) {
         // top part data copy
         temp_src_pic2 -= src_stride;
-        EB_MEMCPY(temp_src_pic2,
-                  temp_src_pic0,
-                  sizeof(uint8_t) * (original_src_width + (LR_PAD_MAX << use_highbd)));
+        if (row_start == 0)
+            EB_MEMCPY(temp_src_pic2,
+                      temp_src_pic0,
+                      sizeof(uint8_t) * (original_src_width + (LR_PAD_MAX << use_highbd)));
         // bottom part data copy
         temp_src_pic3 += src_stride;
-        EB_MEMCPY(temp_src_pic3,
-                  temp_src_pic1,
-                  sizeof(uint8_t) * (original_src_width + (LR_PAD_MAX << use_highbd)));
+        if (row_end == original_src_height)
+            EB_MEMCPY(temp_src_pic3,
+                      temp_src_pic1,
+                      sizeof(uint8_t) * (original_src_width + (LR_PAD_MAX << use_highbd)));
     }
 
     return;
 }
 
-void lr_pad_pic(EbPictureBufferDesc *recon_picture_buf, FrameHeader *frame_hdr,
-                EbColorConfig *color_cfg) {
+/* Pads luma rows [row_start, row_end) and the matching chroma rows for LR;
+   the rows above/below the frame are padded with the first/last row */
+void lr_pad_pic_rows(EbPictureBufferDesc *recon_picture_buf, FrameHeader *frame_hdr,
+                     EbColorConfig *color_cfg, uint32_t row_start, uint32_t row_end) {
     FrameSize *frame_size = &frame_hdr->frame_size;
     uint8_t    sx         = color_cfg->subsampling_x;
     uint8_t    sy         = color_cfg->subsampling_y;
+    uint32_t   height     = frame_size->frame_height;
+    uint32_t   uv_height  = (height + sy) >> sy;
+    uint32_t   uv_start   = row_start >> sy;
+    uint32_t   uv_end     = row_end == height ? uv_height : row_end >> sy;
 
     if (recon_picture_buf->bit_depth == EB_8BIT) {
         // Y samples
@@ -130,7 +145,9 @@ void lr_pad_pic(EbPictureBufferDesc *recon_picture_buf, FrameHeader *frame_hdr,
                                 recon_picture_buf->stride_y * recon_picture_buf->origin_y,
                             recon_picture_buf->stride_y,
                             frame_size->superres_upscaled_width,
-                            frame_size->frame_height);
+                            height,
+                            row_start,
+                            row_end);
 
         if (recon_picture_buf->color_format != EB_YUV400) {
             // Cb samples
@@ -139,7 +156,9 @@ void lr_pad_pic(EbPictureBufferDesc *recon_picture_buf, FrameHeader *frame_hdr,
                     recon_picture_buf->stride_cb * (recon_picture_buf->origin_y >> sy),
                 recon_picture_buf->stride_cb,
                 (frame_size->superres_upscaled_width + sx) >> sx,
-                (frame_size->frame_height + sy) >> sy);
+                uv_height,
+                uv_start,
+                uv_end);
 
             // Cr samples
             lr_generate_padding(
@@ -147,7 +166,9 @@ void lr_pad_pic(EbPictureBufferDesc *recon_picture_buf, FrameHeader *frame_hdr,
                     recon_picture_buf->stride_cr * (recon_picture_buf->origin_y >> sy),
                 recon_picture_buf->stride_cr,
                 (frame_size->superres_upscaled_width + sx) >> sx,
-                (frame_size->frame_height + sy) >> sy);
+                uv_height,
+                uv_start,
+                uv_end);
         }
     } else {
         // Y samples
@@ -156,7 +177,9 @@ void lr_pad_pic(EbPictureBufferDesc *recon_picture_buf, FrameHeader *frame_hdr,
                 (recon_picture_buf->stride_y << 1) * recon_picture_buf->origin_y,
             recon_picture_buf->stride_y << 1,
             frame_size->superres_upscaled_width << 1,
-            frame_size->frame_height);
+            height,
+            row_start,
+            row_end);
 
         if (recon_picture_buf->color_format != EB_YUV400) {
             // Cb samples
@@ -165,7 +188,9 @@ void lr_pad_pic(EbPictureBufferDesc *recon_picture_buf, FrameHeader *frame_hdr,
                     (recon_picture_buf->stride_cb << 1) * (recon_picture_buf->origin_y >> sy),
                 recon_picture_buf->stride_cb << 1,
                 ((frame_size->superres_upscaled_width + sx) >> sx) << 1,
-                (frame_size->frame_height + sy) >> sy);
+                uv_height,
+                uv_start,
+                uv_end);
 
             // Cr samples
             lr_generate_padding16_bit(
@@ -173,15 +198,24 @@ void lr_pad_pic(EbPictureBufferDesc *recon_picture_buf, FrameHeader *frame_hdr,
                     (recon_picture_buf->stride_cr << 1) * (recon_picture_buf->origin_y >> sy),
                 recon_picture_buf->stride_cr << 1,
                 ((frame_size->superres_upscaled_width + sx) >> sx) << 1,
-                (frame_size->frame_height + sy) >> sy);
+                uv_height,
+                uv_start,
+                uv_end);
         }
     }
 }
 
+void lr_pad_pic(EbPictureBufferDesc *recon_picture_buf, FrameHeader *frame_hdr,
+                EbColorConfig *color_cfg) {
+    lr_pad_pic_rows(
+        recon_picture_buf, frame_hdr, color_cfg, 0, frame_hdr->frame_size.frame_height);
+}
+
 void dec_av1_loop_restoration_filter_row(EbDecHandle *dec_handle, int32_t plane, int32_t row,
                                          int *h, int32_t sx, int32_t sy, int src_stride,
                                          int dst_stride, uint8_t *src, uint8_t *dst,
-                                         int optimized_lr, int unit_row) {
+                                         int optimized_lr, int unit_row,
+                                         RestorationLineBuffers *rlbs, int32_t *rst_tmpbuf) {
     Av1PixelRect          tile_rect;
     RestorationTileLimits tile_limit;
     RestorationUnitInfo * lr_unit;
@@ -224,7 +258,7 @@ void dec_av1_loop_restoration_filter_row(EbDecHandle *dec_handle, int32_t plane,
                                                 &tile_limit,
                                                 lr_unit,
                                                 &lr_ctxt->boundaries[plane],
-                                                lr_ctxt->rlbs,
+                                                rlbs,
                                                 &tile_rect,
                                                 tile_stripe0,
                                                 sx,
@@ -235,14 +269,14 @@ void dec_av1_loop_restoration_filter_row(EbDecHandle *dec_handle, int32_t plane,
                                                 src_stride,
                                                 dst,
                                                 dst_stride,
-                                                lr_ctxt->rst_tmpbuf,
+                                                rst_tmpbuf,
                                                 optimized_lr);
         else
             eb_av1_loop_restoration_filter_unit(1,
                                                 &tile_limit,
                                                 lr_unit,
                                                 &lr_ctxt->boundaries[plane],
-                                                lr_ctxt->rlbs,
+                                                rlbs,
                                                 &tile_rect,
                                                 tile_stripe0,
                                                 sx,
@@ -253,7 +287,7 @@ void dec_av1_loop_restoration_filter_row(EbDecHandle *dec_handle, int32_t plane,
                                                 src_stride,
                                                 CONVERT_TO_BYTEPTR(dst),
                                                 dst_stride,
-                                                lr_ctxt->rst_tmpbuf,
+                                                rst_tmpbuf,
                                                 optimized_lr);
     }
 }
@@ -319,7 +353,9 @@ void dec_av1_loop_restoration_filter_frame(EbDecHandle *dec_handle, int optimize
                                                 src,
                                                 dst,
                                                 optimized_lr,
-                                                unit_row);
+                                                unit_row,
+                                                lr_ctxt->rlbs,
+                                                lr_ctxt->rst_tmpbuf);
         }
         for (y = 0; y < tile_h; y++) {
             memcpy(src, dst, dst_stride * sizeof(*dst) << use_highbd);
@@ -329,6 +365,100 @@ void dec_av1_loop_restoration_filter_frame(EbDecHandle *dec_handle, int optimize
     }
 }
 
+/* Vertical extent [v_start, v_end) of an LR unit row, in plane rows, offset
+   upwards to line up with the restoration processing stripes. Returns 0 past
+   the last unit row of the plane. */
+int32_t dec_av1_lr_unit_row_extent(EbDecHandle *dec_handle, int32_t plane, int32_t unit_row,
+                                   int32_t *v_start, int32_t *v_end) {
+    LrParams *   lr_params = &dec_handle->frame_header.lr_params[plane];
+    int32_t      unit_size = lr_params->loop_restoration_size;
+    int32_t      sy        = plane ? dec_handle->seq_header.color_config.subsampling_y : 0;
+    Av1PixelRect tile_rect = whole_frame_rect(&dec_handle->frame_header.frame_size,
+                                              dec_handle->seq_header.color_config.subsampling_x,
+                                              dec_handle->seq_header.color_config.subsampling_y,
+                                              plane > 0);
+    int32_t      tile_h    = tile_rect.bottom - tile_rect.top;
+    int32_t      y = 0, h = 0;
+
+    for (int32_t i = 0; i <= unit_row; i++, y += h) {
+        if (y >= tile_h) return 0;
+        int32_t remaining_h = tile_h - y;
+        h = (remaining_h < unit_size * 3 / 2) ? remaining_h : unit_size;
+    }
+    y -= h;
+
+    const int32_t voffset = RESTORATION_UNIT_OFFSET >> sy;
+    *v_start              = AOMMAX(0, y - voffset);
+    *v_end                = (y + h < tile_h) ? y + h - voffset : tile_h;
+    return 1;
+}
+
+/* Filters one LR unit row straight into the frame. The unit row's source rows
+   are first copied to the caller's scratch, so the stripe boundary setup and
+   the filter never read rows that a neighbouring unit row job is writing.
+   Inside the frame the rows just outside the unit row always come from the
+   saved stripe boundaries; at the frame top/bottom they come from the LR
+   padding. The scratch holds DEC_LR_SCRATCH_ROWS rows of scratch_stride
+   pixels, with DEC_LR_SCRATCH_MARGIN pixels on the left. */
+void dec_av1_loop_restoration_filter_unit_row(EbDecHandle *dec_handle, int32_t plane,
+                                              int32_t unit_row, RestorationLineBuffers *rlbs,
+                                              int32_t *rst_tmpbuf, uint8_t *scratch,
+                                              int32_t scratch_stride) {
+    EbPictureBufferDesc *cur_pic_buf = dec_handle->cur_pic_buf[0]->ps_pic_buf;
+    int32_t              use_highbd  = (dec_handle->seq_header.color_config.bit_depth > 8);
+    int32_t              sx = 0, sy = 0;
+    int32_t              v_start, v_end, h;
+    int32_t              frame_stride;
+    uint8_t *            frame;
+
+    if (plane) {
+        sx = dec_handle->seq_header.color_config.subsampling_x;
+        sy = dec_handle->seq_header.color_config.subsampling_y;
+    }
+    if (!dec_av1_lr_unit_row_extent(dec_handle, plane, unit_row, &v_start, &v_end)) return;
+
+    Av1PixelRect tile_rect = whole_frame_rect(&dec_handle->frame_header.frame_size,
+                                              dec_handle->seq_header.color_config.subsampling_x,
+                                              dec_handle->seq_header.color_config.subsampling_y,
+                                              plane > 0);
+    int32_t      tile_w    = tile_rect.right - tile_rect.left;
+    int32_t      top       = v_start == 0 ? LR_PAD_SIDE : 0;
+    int32_t      bottom    = v_end == tile_rect.bottom ? LR_PAD_SIDE : 0;
+
+    derive_blk_pointers(cur_pic_buf, plane, 0, 0, (void *)&frame, &frame_stride, sx, sy);
+
+    /* scratch row RESTORATION_BORDER holds plane row v_start */
+    uint8_t *copy_src = frame + (((v_start - top) * frame_stride - LR_PAD_SIDE) << use_highbd);
+    uint8_t *copy_dst = scratch + (((RESTORATION_BORDER - top) * scratch_stride +
+                                    DEC_LR_SCRATCH_MARGIN - LR_PAD_SIDE)
+                                   << use_highbd);
+    for (int32_t y = v_start - top; y < v_end + bottom; y++) {
+        memcpy(copy_dst, copy_src, (tile_w + LR_PAD_MAX) << use_highbd);
+        copy_src += frame_stride << use_highbd;
+        copy_dst += scratch_stride << use_highbd;
+    }
+
+    uint8_t *src = scratch + (((RESTORATION_BORDER - v_start) * scratch_stride +
+                               DEC_LR_SCRATCH_MARGIN)
+                              << use_highbd);
+    dec_av1_loop_restoration_filter_row(dec_handle,
+                                        plane,
+                                        dec_handle->frame_header.lr_params[plane]
+                                                .loop_restoration_size *
+                                            unit_row,
+                                        &h,
+                                        sx,
+                                        sy,
+                                        scratch_stride,
+                                        frame_stride,
+                                        src,
+                                        frame,
+                                        0,
+                                        unit_row,
+                                        rlbs,
+                                        rst_tmpbuf);
+}
+
 void dec_av1_loop_restoration_save_boundary_lines(EbDecHandle *dec_handle, int after_cdef,
                                                   int enable_flag) {
     if (!enable_flag) return;
@@ -12,6 +12,21 @@ extern "C" {
 
 #include "EbDecHandle.h"
 
+/* Row scratch used by the MT super-res and LR jobs: one LR unit row
+   (at most 1.5 units, plus the stripe offset and the stripe borders) with a
+   left/right margin for the filter taps and the line buffer copies */
+#define DEC_LR_SCRATCH_MARGIN 32
+#define DEC_LR_SCRATCH_ROWS \
+    (RESTORATION_UNITSIZE_MAX * 3 / 2 + RESTORATION_UNIT_OFFSET + 2 * RESTORATION_BORDER)
+
+void lr_pad_pic_rows(EbPictureBufferDesc *recon_picture_buf, FrameHeader *frame_hdr,
+                     EbColorConfig *color_cfg, uint32_t row_start, uint32_t row_end);
+int32_t dec_av1_lr_unit_row_extent(EbDecHandle *dec_handle, int32_t plane, int32_t unit_row,
+                                   int32_t *v_start, int32_t *v_end);
+void    dec_av1_loop_restoration_filter_unit_row(EbDecHandle *dec_handle, int32_t plane,
+                                                 int32_t unit_row, RestorationLineBuffers *rlbs,
+                                                 int32_t *rst_tmpbuf, uint8_t *scratch,
+                                                 int32_t scratch_stride);
 void dec_av1_loop_restoration_save_boundary_lines(EbDecHandle *dec_handle, int after_cdef,
                                                   int enable_flag);
 void dec_av1_loop_restoration_filter_frame(EbDecHandle *dec_handle, int optimized_lr,
@@ -46,7 +46,7 @@ void av1_upscale_normative_and_extend_frame(struct Av1Common *cm, FrameHeader *f
                                    src_stride,
                                    dst_buf,
                                    dst_stride,
-                                   frm_hdr->frame_size.frame_height >> sub_x,
+                                   ROUND_POWER_OF_TWO(frm_hdr->frame_size.frame_height, sub_y),
                                    sub_x,
                                    src->bit_depth);
     }
@@ -163,3 +163,47 @@ void av1_superres_upscale(Av1Common *cm, FrameHeader *frm_hdr, SeqHeader *seq_hd
     av1_upscale_normative_and_extend_frame(
         cm, frm_hdr, seq_hdr, ps_recon_pic_temp, recon_picture_src);
 }
+
+/* Upscales luma rows [row_start, row_end) and the matching chroma rows in
+   place. Super-res is horizontal only, so bands of rows are independent;
+   each band is first copied to the caller's scratch (DEC_LR_SCRATCH_MARGIN
+   pixels of margin for the edge extension) since the upscaled rows are wider
+   than the source rows they replace. */
+void av1_superres_upscale_rows(Av1Common *cm, FrameHeader *frm_hdr, SeqHeader *seq_hdr,
+                               EbPictureBufferDesc *recon_picture_src, int32_t row_start,
+                               int32_t row_end, uint8_t *scratch, int32_t scratch_stride) {
+    const int num_planes = seq_hdr->color_config.mono_chrome ? 1 : MAX_MB_PLANE;
+    const int use_highbd = recon_picture_src->bit_depth != EB_8BIT;
+    const int height     = frm_hdr->frame_size.frame_height;
+
+    for (int plane = 0; plane < num_planes; ++plane) {
+        uint8_t *frame_buf;
+        int32_t  frame_stride;
+
+        int sub_x = plane ? seq_hdr->color_config.subsampling_x : 0;
+        int sub_y = plane ? seq_hdr->color_config.subsampling_y : 0;
+        derive_blk_pointers(
+            recon_picture_src, plane, 0, 0, (void *)&frame_buf, &frame_stride, sub_x, sub_y);
+
+        int y0    = row_start >> sub_y;
+        int y1    = row_end == height ? ROUND_POWER_OF_TWO(height, sub_y) : row_end >> sub_y;
+        int width = (frm_hdr->mi_cols << MI_SIZE_LOG2) >> sub_x;
+
+        uint8_t *src = frame_buf + ((y0 * frame_stride) << use_highbd);
+        uint8_t *dst = scratch + (DEC_LR_SCRATCH_MARGIN << use_highbd);
+        for (int y = y0; y < y1; y++) {
+            memcpy(dst, src, width << use_highbd);
+            src += frame_stride << use_highbd;
+            dst += scratch_stride << use_highbd;
+        }
+
+        av1_upscale_normative_rows(cm,
+                                   scratch + (DEC_LR_SCRATCH_MARGIN << use_highbd),
+                                   scratch_stride,
+                                   frame_buf + ((y0 * frame_stride) << use_highbd),
+                                   frame_stride,
+                                   y1 - y0,
+                                   sub_x,
+                                   recon_picture_src->bit_depth);
+    }
+}
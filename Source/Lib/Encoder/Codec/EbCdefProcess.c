@@ -28,6 +28,7 @@
 #include "EbSequenceControlSet.h"
 #include "EbUtility.h"
 #include "EbPictureControlSet.h"
+#include "EbPipelineStats.h"
 
 static int32_t priconv[REDUCED_PRI_STRENGTHS] = {0, 1, 2, 3, 5, 7, 10, 13};
 
@@ -489,19 +490,18 @@ void cdef_seg_search16bit(PictureControlSet *pcs_ptr, SequenceControlSet *scs_pt
 }
 
 /******************************************************
- * CDEF Kernel
+ * CDEF Job
+ *   Processes one DLF result.
  ******************************************************/
-void *cdef_kernel(void *input_ptr) {
+void cdef_job(EbThreadContext *thread_context_ptr, EbObjectWrapper *dlf_results_wrapper_ptr) {
     // Context & SCS & PCS
-    EbThreadContext *   thread_context_ptr = (EbThreadContext *)input_ptr;
-    CdefContext *       context_ptr        = (CdefContext *)thread_context_ptr->priv;
+    CdefContext *       context_ptr = (CdefContext *)thread_context_ptr->priv;
     PictureControlSet * pcs_ptr;
     SequenceControlSet *scs_ptr;
 
     FrameHeader *frm_hdr;
 
     //// Input
-    EbObjectWrapper *dlf_results_wrapper_ptr;
     DlfResults *     dlf_results_ptr;
 
     //// Output
@@ -510,101 +510,113 @@ void *cdef_kernel(void *input_ptr) {
 
     // SB Loop variables
 
-    for (;;) {
-        // Get DLF Results
-        eb_get_full_object(context_ptr->cdef_input_fifo_ptr, &dlf_results_wrapper_ptr);
-
-        dlf_results_ptr = (DlfResults *)dlf_results_wrapper_ptr->object_ptr;
-        pcs_ptr         = (PictureControlSet *)dlf_results_ptr->pcs_wrapper_ptr->object_ptr;
-        scs_ptr         = (SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr;
+    dlf_results_ptr = (DlfResults *)dlf_results_wrapper_ptr->object_ptr;
+    pcs_ptr         = (PictureControlSet *)dlf_results_ptr->pcs_wrapper_ptr->object_ptr;
+    scs_ptr         = (SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr;
+    eb_pipeline_stats_set_picture(pcs_ptr->picture_number);
+
+    EbBool     is_16bit = (EbBool)(scs_ptr->static_config.encoder_bit_depth > EB_8BIT);
+    Av1Common *cm       = pcs_ptr->parent_pcs_ptr->av1_cm;
+    frm_hdr             = &pcs_ptr->parent_pcs_ptr->frm_hdr;
+    int32_t selected_strength_cnt[64] = {0};
+
+    if (scs_ptr->seq_header.enable_cdef && pcs_ptr->parent_pcs_ptr->cdef_filter_mode) {
+        if (is_16bit)
+            cdef_seg_search16bit(pcs_ptr, scs_ptr, dlf_results_ptr->segment_index);
+        else
+            cdef_seg_search(pcs_ptr, scs_ptr, dlf_results_ptr->segment_index);
+    }
 
-        EbBool     is_16bit = (EbBool)(scs_ptr->static_config.encoder_bit_depth > EB_8BIT);
-        Av1Common *cm       = pcs_ptr->parent_pcs_ptr->av1_cm;
-        frm_hdr             = &pcs_ptr->parent_pcs_ptr->frm_hdr;
-        int32_t selected_strength_cnt[64] = {0};
+    //all seg based search is done. update total processed segments. if all done, finish the search and perfrom application.
+    eb_block_on_mutex(pcs_ptr->cdef_search_mutex);
 
+    pcs_ptr->tot_seg_searched_cdef++;
+    if (pcs_ptr->tot_seg_searched_cdef == pcs_ptr->cdef_segments_total_count) {
+        // SVT_LOG("    CDEF all seg here  %i\n", pcs_ptr->picture_number);
         if (scs_ptr->seq_header.enable_cdef && pcs_ptr->parent_pcs_ptr->cdef_filter_mode) {
-            if (is_16bit)
-                cdef_seg_search16bit(pcs_ptr, scs_ptr, dlf_results_ptr->segment_index);
-            else
-                cdef_seg_search(pcs_ptr, scs_ptr, dlf_results_ptr->segment_index);
+            finish_cdef_search(0, pcs_ptr, selected_strength_cnt);
+
+            if (scs_ptr->seq_header.enable_restoration != 0 ||
+                pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag ||
+                scs_ptr->static_config.recon_enabled) {
+                if (is_16bit)
+                    av1_cdef_frame16bit(0, scs_ptr, pcs_ptr);
+                else
+                    eb_av1_cdef_frame(0, scs_ptr, pcs_ptr);
+            }
+        } else {
+            frm_hdr->cdef_params.cdef_bits             = 0;
+            frm_hdr->cdef_params.cdef_y_strength[0]    = 0;
+            pcs_ptr->parent_pcs_ptr->nb_cdef_strengths = 1;
+            frm_hdr->cdef_params.cdef_uv_strength[0]   = 0;
         }
 
-        //all seg based search is done. update total processed segments. if all done, finish the search and perfrom application.
-        eb_block_on_mutex(pcs_ptr->cdef_search_mutex);
+        //restoration prep
+
+        if (scs_ptr->seq_header.enable_restoration) {
+            eb_av1_loop_restoration_save_boundary_lines(cm->frame_to_show, cm, 1);
+
+            //are these still needed here?/!!!
+            eb_extend_frame(cm->frame_to_show->buffers[0],
+                            cm->frame_to_show->crop_widths[0],
+                            cm->frame_to_show->crop_heights[0],
+                            cm->frame_to_show->strides[0],
+                            RESTORATION_BORDER,
+                            RESTORATION_BORDER,
+                            is_16bit);
+            eb_extend_frame(cm->frame_to_show->buffers[1],
+                            cm->frame_to_show->crop_widths[1],
+                            cm->frame_to_show->crop_heights[1],
+                            cm->frame_to_show->strides[1],
+                            RESTORATION_BORDER,
+                            RESTORATION_BORDER,
+                            is_16bit);
+            eb_extend_frame(cm->frame_to_show->buffers[2],
+                            cm->frame_to_show->crop_widths[1],
+                            cm->frame_to_show->crop_heights[1],
+                            cm->frame_to_show->strides[1],
+                            RESTORATION_BORDER,
+                            RESTORATION_BORDER,
+                            is_16bit);
+        }
 
-        pcs_ptr->tot_seg_searched_cdef++;
-        if (pcs_ptr->tot_seg_searched_cdef == pcs_ptr->cdef_segments_total_count) {
-            // SVT_LOG("    CDEF all seg here  %i\n", pcs_ptr->picture_number);
-            if (scs_ptr->seq_header.enable_cdef && pcs_ptr->parent_pcs_ptr->cdef_filter_mode) {
-                finish_cdef_search(0, pcs_ptr, selected_strength_cnt);
+        pcs_ptr->rest_segments_column_count = scs_ptr->rest_segment_column_count;
+        pcs_ptr->rest_segments_row_count    = scs_ptr->rest_segment_row_count;
+        pcs_ptr->rest_segments_total_count =
+            (uint16_t)(pcs_ptr->rest_segments_column_count * pcs_ptr->rest_segments_row_count);
+        pcs_ptr->tot_seg_searched_rest = 0;
+        uint32_t segment_index;
+        for (segment_index = 0; segment_index < pcs_ptr->rest_segments_total_count;
+             ++segment_index) {
+            // Get Empty Cdef Results to Rest
+            eb_get_empty_object(context_ptr->cdef_output_fifo_ptr, &cdef_results_wrapper_ptr);
+            cdef_results_ptr = (struct CdefResults *)cdef_results_wrapper_ptr->object_ptr;
+            cdef_results_ptr->pcs_wrapper_ptr = dlf_results_ptr->pcs_wrapper_ptr;
+            cdef_results_ptr->input_type      = REST_TASKS_CDEF_INPUT;
+            cdef_results_ptr->segment_index   = segment_index;
+            // Post Cdef Results
+            eb_post_full_object(cdef_results_wrapper_ptr);
+        }
+    }
+    eb_release_mutex(pcs_ptr->cdef_search_mutex);
 
-                if (scs_ptr->seq_header.enable_restoration != 0 ||
-                    pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag ||
-                    scs_ptr->static_config.recon_enabled) {
-                    if (is_16bit)
-                        av1_cdef_frame16bit(0, scs_ptr, pcs_ptr);
-                    else
-                        eb_av1_cdef_frame(0, scs_ptr, pcs_ptr);
-                }
-            } else {
-                frm_hdr->cdef_params.cdef_bits             = 0;
-                frm_hdr->cdef_params.cdef_y_strength[0]    = 0;
-                pcs_ptr->parent_pcs_ptr->nb_cdef_strengths = 1;
-                frm_hdr->cdef_params.cdef_uv_strength[0]   = 0;
-            }
+    // Release Dlf Results
+    eb_release_object(dlf_results_wrapper_ptr);
+}
 
-            //restoration prep
-
-            if (scs_ptr->seq_header.enable_restoration) {
-                eb_av1_loop_restoration_save_boundary_lines(cm->frame_to_show, cm, 1);
-
-                //are these still needed here?/!!!
-                eb_extend_frame(cm->frame_to_show->buffers[0],
-                                cm->frame_to_show->crop_widths[0],
-                                cm->frame_to_show->crop_heights[0],
-                                cm->frame_to_show->strides[0],
-                                RESTORATION_BORDER,
-                                RESTORATION_BORDER,
-                                is_16bit);
-                eb_extend_frame(cm->frame_to_show->buffers[1],
-                                cm->frame_to_show->crop_widths[1],
-                                cm->frame_to_show->crop_heights[1],
-                                cm->frame_to_show->strides[1],
-                                RESTORATION_BORDER,
-                                RESTORATION_BORDER,
-                                is_16bit);
-                eb_extend_frame(cm->frame_to_show->buffers[2],
-                                cm->frame_to_show->crop_widths[1],
-                                cm->frame_to_show->crop_heights[1],
-                                cm->frame_to_show->strides[1],
-                                RESTORATION_BORDER,
-                                RESTORATION_BORDER,
-                                is_16bit);
-            }
+/******************************************************
+ * CDEF Kernel
+ ******************************************************/
+void *cdef_kernel(void *input_ptr) {
+    EbThreadContext *thread_context_ptr = (EbThreadContext *)input_ptr;
+    CdefContext *    context_ptr        = (CdefContext *)thread_context_ptr->priv;
+    EbObjectWrapper *dlf_results_wrapper_ptr;
 
-            pcs_ptr->rest_segments_column_count = scs_ptr->rest_segment_column_count;
-            pcs_ptr->rest_segments_row_count    = scs_ptr->rest_segment_row_count;
-            pcs_ptr->rest_segments_total_count =
-                (uint16_t)(pcs_ptr->rest_segments_column_count * pcs_ptr->rest_segments_row_count);
-            pcs_ptr->tot_seg_searched_rest = 0;
-            uint32_t segment_index;
-            for (segment_index = 0; segment_index < pcs_ptr->rest_segments_total_count;
-                 ++segment_index) {
-                // Get Empty Cdef Results to Rest
-                eb_get_empty_object(context_ptr->cdef_output_fifo_ptr, &cdef_results_wrapper_ptr);
-                cdef_results_ptr = (struct CdefResults *)cdef_results_wrapper_ptr->object_ptr;
-                cdef_results_ptr->pcs_wrapper_ptr = dlf_results_ptr->pcs_wrapper_ptr;
-                cdef_results_ptr->segment_index   = segment_index;
-                // Post Cdef Results
-                eb_post_full_object(cdef_results_wrapper_ptr);
-            }
-        }
-        eb_release_mutex(pcs_ptr->cdef_search_mutex);
+    for (;;) {
+        // Get DLF Results
+        eb_get_full_object(context_ptr->cdef_input_fifo_ptr, &dlf_results_wrapper_ptr);
 
-        // Release Dlf Results
-        eb_release_object(dlf_results_wrapper_ptr);
+        cdef_job(thread_context_ptr, dlf_results_wrapper_ptr);
     }
-
     return EB_NULL;
 }
@@ -15,6 +15,7 @@
 extern EbErrorType cdef_context_ctor(EbThreadContext *  thread_context_ptr,
                                      const EbEncHandle *enc_handle_ptr, int index);
 
+extern void cdef_job(EbThreadContext *thread_context_ptr, EbObjectWrapper *dlf_results_wrapper_ptr);
 extern void *cdef_kernel(void *input_ptr);
 
 #endif
@@ -1427,19 +1427,22 @@ void move_blk_data(PictureControlSet *pcs, EncDecContext *context_ptr, CodingUni
 void perform_intra_coding_loop(PictureControlSet *pcs_ptr, SuperBlock *sb_ptr, uint32_t sb_addr,
                                CodingUnit *blk_ptr, PredictionUnit *pu_ptr,
                                EncDecContext *context_ptr) {
-    EbBool is_16bit = context_ptr->is_16bit;
+    EbBool   is_16bit = context_ptr->is_16bit;
+    uint16_t tile_idx = context_ptr->tile_idx;
 
     EbPictureBufferDesc *recon_buffer =
         is_16bit ? pcs_ptr->recon_picture16bit_ptr : pcs_ptr->recon_picture_ptr;
     EbPictureBufferDesc *coeff_buffer_sb = sb_ptr->quantized_coeff;
 
     NeighborArrayUnit *ep_luma_recon_neighbor_array =
-        is_16bit ? pcs_ptr->ep_luma_recon_neighbor_array16bit
-                 : pcs_ptr->ep_luma_recon_neighbor_array;
+        is_16bit ? pcs_ptr->ep_luma_recon_neighbor_array16bit[tile_idx]
+                 : pcs_ptr->ep_luma_recon_neighbor_array[tile_idx];
     NeighborArrayUnit *ep_cb_recon_neighbor_array =
-        is_16bit ? pcs_ptr->ep_cb_recon_neighbor_array16bit : pcs_ptr->ep_cb_recon_neighbor_array;
+        is_16bit ? pcs_ptr->ep_cb_recon_neighbor_array16bit[tile_idx]
+                 : pcs_ptr->ep_cb_recon_neighbor_array[tile_idx];
     NeighborArrayUnit *ep_cr_recon_neighbor_array =
-        is_16bit ? pcs_ptr->ep_cr_recon_neighbor_array16bit : pcs_ptr->ep_cr_recon_neighbor_array;
+        is_16bit ? pcs_ptr->ep_cr_recon_neighbor_array16bit[tile_idx]
+                 : pcs_ptr->ep_cr_recon_neighbor_array[tile_idx];
 
     EbPictureBufferDesc *residual_buffer           = context_ptr->residual_buffer;
     EbPictureBufferDesc *transform_buffer          = context_ptr->transform_buffer;
@@ -1482,7 +1485,7 @@ void perform_intra_coding_loop(PictureControlSet *pcs_ptr, SuperBlock *sb_ptr, u
         context_ptr->md_context->luma_dc_sign_context  = 0;
         get_txb_ctx(pcs_ptr->parent_pcs_ptr->scs_ptr,
                     COMPONENT_LUMA,
-                    pcs_ptr->ep_luma_dc_sign_level_coeff_neighbor_array,
+                    pcs_ptr->ep_luma_dc_sign_level_coeff_neighbor_array[tile_idx],
                     txb_origin_x,
                     txb_origin_y,
                     context_ptr->blk_geom->bsize,
@@ -1498,18 +1501,23 @@ void perform_intra_coding_loop(PictureControlSet *pcs_ptr, SuperBlock *sb_ptr, u
 
             if (txb_origin_y != 0)
                 memcpy(top_neigh_array + 1,
-                       (uint16_t *)(ep_luma_recon_neighbor_array->top_array) + txb_origin_x,
+                       (uint16_t *)(ep_luma_recon_neighbor_array->top_array) +
+                           get_neighbor_array_unit_top_index(
+                               ep_luma_recon_neighbor_array, txb_origin_x),
                        context_ptr->blk_geom->tx_width[blk_ptr->tx_depth][context_ptr->txb_itr] *
                            2 * sizeof(uint16_t));
             if (txb_origin_x != 0)
                 memcpy(left_neigh_array + 1,
-                       (uint16_t *)(ep_luma_recon_neighbor_array->left_array) + txb_origin_y,
+                       (uint16_t *)(ep_luma_recon_neighbor_array->left_array) +
+                           get_neighbor_array_unit_left_index(
+                               ep_luma_recon_neighbor_array, txb_origin_y),
                        context_ptr->blk_geom->tx_height[blk_ptr->tx_depth][context_ptr->txb_itr] *
                            2 * sizeof(uint16_t));
             if (txb_origin_y != 0 && txb_origin_x != 0)
                 top_neigh_array[0] = left_neigh_array[0] =
-                    ((uint16_t *)(ep_luma_recon_neighbor_array->top_left_array) +
-                     MAX_PICTURE_HEIGHT_SIZE + txb_origin_x - txb_origin_y)[0];
+                    ((uint16_t *)(ep_luma_recon_neighbor_array->top_left_array))
+                        [get_neighbor_array_unit_top_left_index(
+                            ep_luma_recon_neighbor_array, txb_origin_x, txb_origin_y)];
 
             mode = blk_ptr->pred_mode;
 
@@ -1549,19 +1557,24 @@ void perform_intra_coding_loop(PictureControlSet *pcs_ptr, SuperBlock *sb_ptr, u
             if (txb_origin_y != 0)
                 memcpy(
                     top_neigh_array + 1,
-                    ep_luma_recon_neighbor_array->top_array + txb_origin_x,
+                    ep_luma_recon_neighbor_array->top_array +
+                        get_neighbor_array_unit_top_index(
+                            ep_luma_recon_neighbor_array, txb_origin_x),
                     context_ptr->blk_geom->tx_width[blk_ptr->tx_depth][context_ptr->txb_itr] * 2);
 
             if (txb_origin_x != 0)
                 memcpy(
                     left_neigh_array + 1,
-                    ep_luma_recon_neighbor_array->left_array + txb_origin_y,
+                    ep_luma_recon_neighbor_array->left_array +
+                        get_neighbor_array_unit_left_index(
+                            ep_luma_recon_neighbor_array, txb_origin_y),
                     context_ptr->blk_geom->tx_height[blk_ptr->tx_depth][context_ptr->txb_itr] * 2);
 
             if (txb_origin_y != 0 && txb_origin_x != 0)
                 top_neigh_array[0] = left_neigh_array[0] =
                     ep_luma_recon_neighbor_array
-                        ->top_left_array[MAX_PICTURE_HEIGHT_SIZE + txb_origin_x - txb_origin_y];
+                        ->top_left_array[get_neighbor_array_unit_top_left_index(
+                            ep_luma_recon_neighbor_array, txb_origin_x, txb_origin_y)];
 
             mode = blk_ptr->pred_mode;
 
@@ -1689,7 +1702,7 @@ void perform_intra_coding_loop(PictureControlSet *pcs_ptr, SuperBlock *sb_ptr, u
             uint8_t dc_sign_level_coeff = (uint8_t)blk_ptr->quantized_dc[0][context_ptr->txb_itr];
 
             neighbor_array_unit_mode_write(
-                pcs_ptr->ep_luma_dc_sign_level_coeff_neighbor_array,
+                pcs_ptr->ep_luma_dc_sign_level_coeff_neighbor_array[tile_idx],
                 (uint8_t *)&dc_sign_level_coeff,
                 txb_origin_x,
                 txb_origin_y,
@@ -1718,7 +1731,7 @@ void perform_intra_coding_loop(PictureControlSet *pcs_ptr, SuperBlock *sb_ptr, u
         context_ptr->md_context->cb_dc_sign_context  = 0;
         get_txb_ctx(pcs_ptr->parent_pcs_ptr->scs_ptr,
                     COMPONENT_CHROMA,
-                    pcs_ptr->ep_cb_dc_sign_level_coeff_neighbor_array,
+                    pcs_ptr->ep_cb_dc_sign_level_coeff_neighbor_array[tile_idx],
                     cu_originx_uv,
                     cu_originy_uv,
                     context_ptr->blk_geom->bsize_uv,
@@ -1731,7 +1744,7 @@ void perform_intra_coding_loop(PictureControlSet *pcs_ptr, SuperBlock *sb_ptr, u
         get_txb_ctx(
             pcs_ptr->parent_pcs_ptr->scs_ptr,
             COMPONENT_CHROMA,
-            pcs_ptr->ep_cr_dc_sign_level_coeff_neighbor_array,
+            pcs_ptr->ep_cr_dc_sign_level_coeff_neighbor_array[tile_idx],
             cu_originx_uv,
             cu_originy_uv,
             context_ptr->blk_geom->bsize_uv,
@@ -1755,29 +1768,39 @@ void perform_intra_coding_loop(PictureControlSet *pcs_ptr, SuperBlock *sb_ptr, u
                 if (plane == 1) {
                     if (cu_originy_uv != 0)
                         memcpy(top_neigh_array + 1,
-                               (uint16_t *)(ep_cb_recon_neighbor_array->top_array) + cu_originx_uv,
+                               (uint16_t *)(ep_cb_recon_neighbor_array->top_array) +
+                                   get_neighbor_array_unit_top_index(
+                                       ep_cb_recon_neighbor_array, cu_originx_uv),
                                context_ptr->blk_geom->bwidth_uv * 2 * sizeof(uint16_t));
                     if (cu_originx_uv != 0)
                         memcpy(left_neigh_array + 1,
-                               (uint16_t *)(ep_cb_recon_neighbor_array->left_array) + cu_originy_uv,
+                               (uint16_t *)(ep_cb_recon_neighbor_array->left_array) +
+                                   get_neighbor_array_unit_left_index(
+                                       ep_cb_recon_neighbor_array, cu_originy_uv),
                                context_ptr->blk_geom->bheight_uv * 2 * sizeof(uint16_t));
                     if (cu_originy_uv != 0 && cu_originx_uv != 0)
                         top_neigh_array[0] = left_neigh_array[0] =
-                            ((uint16_t *)(ep_cb_recon_neighbor_array->top_left_array) +
-                             MAX_PICTURE_HEIGHT_SIZE / 2 + cu_originx_uv - cu_originy_uv)[0];
+                            ((uint16_t *)(ep_cb_recon_neighbor_array->top_left_array))
+                                [get_neighbor_array_unit_top_left_index(
+                                    ep_cb_recon_neighbor_array, cu_originx_uv, cu_originy_uv)];
                 } else if (plane == 2) {
                     if (cu_originy_uv != 0)
                         memcpy(top_neigh_array + 1,
-                               (uint16_t *)(ep_cr_recon_neighbor_array->top_array) + cu_originx_uv,
+                               (uint16_t *)(ep_cr_recon_neighbor_array->top_array) +
+                                   get_neighbor_array_unit_top_index(
+                                       ep_cr_recon_neighbor_array, cu_originx_uv),
                                context_ptr->blk_geom->bwidth_uv * 2 * sizeof(uint16_t));
                     if (cu_originx_uv != 0)
                         memcpy(left_neigh_array + 1,
-                               (uint16_t *)(ep_cr_recon_neighbor_array->left_array) + cu_originy_uv,
+                               (uint16_t *)(ep_cr_recon_neighbor_array->left_array) +
+                                   get_neighbor_array_unit_left_index(
+                                       ep_cr_recon_neighbor_array, cu_originy_uv),
                                context_ptr->blk_geom->bheight_uv * 2 * sizeof(uint16_t));
                     if (cu_originy_uv != 0 && cu_originx_uv != 0)
                         top_neigh_array[0] = left_neigh_array[0] =
-                            ((uint16_t *)(ep_cr_recon_neighbor_array->top_left_array) +
-                             MAX_PICTURE_HEIGHT_SIZE / 2 + cu_originx_uv - cu_originy_uv)[0];
+                            ((uint16_t *)(ep_cr_recon_neighbor_array->top_left_array))
+                                [get_neighbor_array_unit_top_left_index(
+                                    ep_cr_recon_neighbor_array, cu_originx_uv, cu_originy_uv)];
                 }
 
                 mode = (pu_ptr->intra_chroma_mode == UV_CFL_PRED)
@@ -1834,35 +1857,43 @@ void perform_intra_coding_loop(PictureControlSet *pcs_ptr, SuperBlock *sb_ptr, u
                 if (plane == 1) {
                     if (cu_originy_uv != 0)
                         memcpy(top_neigh_array + 1,
-                               ep_cb_recon_neighbor_array->top_array + cu_originx_uv,
+                               ep_cb_recon_neighbor_array->top_array +
+                                   get_neighbor_array_unit_top_index(
+                                       ep_cb_recon_neighbor_array, cu_originx_uv),
                                context_ptr->blk_geom->bwidth_uv * 2);
 
                     if (cu_originx_uv != 0)
                         memcpy(left_neigh_array + 1,
-                               ep_cb_recon_neighbor_array->left_array + cu_originy_uv,
+                               ep_cb_recon_neighbor_array->left_array +
+                                   get_neighbor_array_unit_left_index(
+                                       ep_cb_recon_neighbor_array, cu_originy_uv),
                                context_ptr->blk_geom->bheight_uv * 2);
 
                     if (cu_originy_uv != 0 && cu_originx_uv != 0)
                         top_neigh_array[0] = left_neigh_array[0] =
                             ep_cb_recon_neighbor_array
-                                ->top_left_array[MAX_PICTURE_HEIGHT_SIZE / 2 + cu_originx_uv -
-                                                 cu_originy_uv];
+                                ->top_left_array[get_neighbor_array_unit_top_left_index(
+                                    ep_cb_recon_neighbor_array, cu_originx_uv, cu_originy_uv)];
                 } else {
                     if (cu_originy_uv != 0)
                         memcpy(top_neigh_array + 1,
-                               ep_cr_recon_neighbor_array->top_array + cu_originx_uv,
+                               ep_cr_recon_neighbor_array->top_array +
+                                   get_neighbor_array_unit_top_index(
+                                       ep_cr_recon_neighbor_array, cu_originx_uv),
                                context_ptr->blk_geom->bwidth_uv * 2);
 
                     if (cu_originx_uv != 0)
                         memcpy(left_neigh_array + 1,
-                               ep_cr_recon_neighbor_array->left_array + cu_originy_uv,
+                               ep_cr_recon_neighbor_array->left_array +
+                                   get_neighbor_array_unit_left_index(
+                                       ep_cr_recon_neighbor_array, cu_originy_uv),
                                context_ptr->blk_geom->bheight_uv * 2);
 
                     if (cu_originy_uv != 0 && cu_originx_uv != 0)
                         top_neigh_array[0] = left_neigh_array[0] =
                             ep_cr_recon_neighbor_array
-                                ->top_left_array[MAX_PICTURE_HEIGHT_SIZE / 2 + cu_originx_uv -
-                                                 cu_originy_uv];
+                                ->top_left_array[get_neighbor_array_unit_top_left_index(
+                                    ep_cr_recon_neighbor_array, cu_originx_uv, cu_originy_uv)];
                 }
 
                 mode = (pu_ptr->intra_chroma_mode == UV_CFL_PRED)
@@ -2000,7 +2031,7 @@ void perform_intra_coding_loop(PictureControlSet *pcs_ptr, SuperBlock *sb_ptr, u
         {
             uint8_t dc_sign_level_coeff = (uint8_t)blk_ptr->quantized_dc[1][context_ptr->txb_itr];
             neighbor_array_unit_mode_write(
-                pcs_ptr->ep_cb_dc_sign_level_coeff_neighbor_array,
+                pcs_ptr->ep_cb_dc_sign_level_coeff_neighbor_array[tile_idx],
                 (uint8_t *)&dc_sign_level_coeff,
                 ROUND_UV(txb_origin_x) >> 1,
                 ROUND_UV(txb_origin_y) >> 1,
@@ -2013,7 +2044,7 @@ void perform_intra_coding_loop(PictureControlSet *pcs_ptr, SuperBlock *sb_ptr, u
         {
             uint8_t dc_sign_level_coeff = (uint8_t)blk_ptr->quantized_dc[2][context_ptr->txb_itr];
             neighbor_array_unit_mode_write(
-                pcs_ptr->ep_cr_dc_sign_level_coeff_neighbor_array,
+                pcs_ptr->ep_cr_dc_sign_level_coeff_neighbor_array[tile_idx],
                 (uint8_t *)&dc_sign_level_coeff,
                 ROUND_UV(txb_origin_x) >> 1,
                 ROUND_UV(txb_origin_y) >> 1,
@@ -2100,6 +2131,7 @@ EB_EXTERN void av1_encode_pass(SequenceControlSet *scs_ptr, PictureControlSet *p
                                SuperBlock *sb_ptr, uint32_t sb_addr, uint32_t sb_origin_x,
                                uint32_t sb_origin_y, EncDecContext *context_ptr) {
     EbBool               is_16bit = context_ptr->is_16bit;
+    uint16_t             tile_idx = context_ptr->tile_idx;
     EbPictureBufferDesc *recon_buffer =
         is_16bit ? pcs_ptr->recon_picture16bit_ptr : pcs_ptr->recon_picture_ptr;
     EbPictureBufferDesc *coeff_buffer_sb = sb_ptr->quantized_coeff;
@@ -2132,22 +2164,29 @@ EB_EXTERN void av1_encode_pass(SequenceControlSet *scs_ptr, PictureControlSet *p
     uint64_t              cr_txb_coeff_bits;
     EncodeContext *       encode_context_ptr;
     // Dereferencing early
-    NeighborArrayUnit *ep_mode_type_neighbor_array = pcs_ptr->ep_mode_type_neighbor_array;
+    NeighborArrayUnit *ep_mode_type_neighbor_array = pcs_ptr->ep_mode_type_neighbor_array[tile_idx];
     NeighborArrayUnit *ep_intra_luma_mode_neighbor_array =
-        pcs_ptr->ep_intra_luma_mode_neighbor_array;
+        pcs_ptr->ep_intra_luma_mode_neighbor_array[tile_idx];
     NeighborArrayUnit *ep_intra_chroma_mode_neighbor_array =
-        pcs_ptr->ep_intra_chroma_mode_neighbor_array;
-    NeighborArrayUnit *ep_mv_neighbor_array = pcs_ptr->ep_mv_neighbor_array;
+        pcs_ptr->ep_intra_chroma_mode_neighbor_array[tile_idx];
+    NeighborArrayUnit *ep_mv_neighbor_array = pcs_ptr->ep_mv_neighbor_array[tile_idx];
     NeighborArrayUnit *ep_luma_recon_neighbor_array =
-        is_16bit ? pcs_ptr->ep_luma_recon_neighbor_array16bit
-                 : pcs_ptr->ep_luma_recon_neighbor_array;
+        is_16bit ? pcs_ptr->ep_luma_recon_neighbor_array16bit[tile_idx]
+                 : pcs_ptr->ep_luma_recon_neighbor_array[tile_idx];
     NeighborArrayUnit *ep_cb_recon_neighbor_array =
-        is_16bit ? pcs_ptr->ep_cb_recon_neighbor_array16bit : pcs_ptr->ep_cb_recon_neighbor_array;
+        is_16bit ? pcs_ptr->ep_cb_recon_neighbor_array16bit[tile_idx]
+                 : pcs_ptr->ep_cb_recon_neighbor_array[tile_idx];
     NeighborArrayUnit *ep_cr_recon_neighbor_array =
-        is_16bit ? pcs_ptr->ep_cr_recon_neighbor_array16bit : pcs_ptr->ep_cr_recon_neighbor_array;
-    NeighborArrayUnit *ep_skip_flag_neighbor_array = pcs_ptr->ep_skip_flag_neighbor_array;
+        is_16bit ? pcs_ptr->ep_cr_recon_neighbor_array16bit[tile_idx]
+                 : pcs_ptr->ep_cr_recon_neighbor_array[tile_idx];
+    NeighborArrayUnit *ep_skip_flag_neighbor_array = pcs_ptr->ep_skip_flag_neighbor_array[tile_idx];
 
     EbBool       dlf_enable_flag = (EbBool)pcs_ptr->parent_pcs_ptr->loop_filter_mode;
+    // Mode 1 deblocks each SB here, including the edges it shares with the SBs on its left and
+    // above. When the tiles are separate EncDec units those may not be coded yet, so the DLF
+    // stage deblocks the picture instead.
+    const EbBool sb_dlf_flag = dlf_enable_flag &&
+        pcs_ptr->parent_pcs_ptr->loop_filter_mode == 1 && pcs_ptr->enc_dec_unit_count == 1;
     const EbBool is_intra_sb     = pcs_ptr->limit_intra ? EB_FALSE : EB_TRUE;
 
     EbBool do_recon =
@@ -2305,7 +2344,7 @@ EB_EXTERN void av1_encode_pass(SequenceControlSet *scs_ptr, PictureControlSet *p
     context_ptr->coded_area_sb                = 0;
     context_ptr->coded_area_sb_uv             = 0;
 
-    if (dlf_enable_flag && pcs_ptr->parent_pcs_ptr->loop_filter_mode == 1) {
+    if (sb_dlf_flag) {
         if (sb_addr == 0) {
             eb_av1_loop_filter_init(pcs_ptr);
 
@@ -2337,6 +2376,7 @@ EB_EXTERN void av1_encode_pass(SequenceControlSet *scs_ptr, PictureControlSet *p
             // Update the partition stats
             update_part_stats(pcs_ptr,
                               blk_ptr,
+                              tile_idx,
                               (sb_origin_y + blk_geom->origin_y) >> MI_SIZE_LOG2,
                               (sb_origin_x + blk_geom->origin_x) >> MI_SIZE_LOG2);
         }
@@ -2470,40 +2510,43 @@ EB_EXTERN void av1_encode_pass(SequenceControlSet *scs_ptr, PictureControlSet *p
 
                             context_ptr->md_context->luma_txb_skip_context = 0;
                             context_ptr->md_context->luma_dc_sign_context  = 0;
-                            get_txb_ctx(pcs_ptr->parent_pcs_ptr->scs_ptr,
-                                        COMPONENT_LUMA,
-                                        pcs_ptr->ep_luma_dc_sign_level_coeff_neighbor_array,
-                                        context_ptr->blk_origin_x,
-                                        context_ptr->blk_origin_y,
-                                        context_ptr->blk_geom->bsize,
-                                        context_ptr->blk_geom->txsize[0][0],
-                                        &context_ptr->md_context->luma_txb_skip_context,
-                                        &context_ptr->md_context->luma_dc_sign_context);
+                            get_txb_ctx(
+                                pcs_ptr->parent_pcs_ptr->scs_ptr,
+                                COMPONENT_LUMA,
+                                pcs_ptr->ep_luma_dc_sign_level_coeff_neighbor_array[tile_idx],
+                                context_ptr->blk_origin_x,
+                                context_ptr->blk_origin_y,
+                                context_ptr->blk_geom->bsize,
+                                context_ptr->blk_geom->txsize[0][0],
+                                &context_ptr->md_context->luma_txb_skip_context,
+                                &context_ptr->md_context->luma_dc_sign_context);
 
                             if (context_ptr->blk_geom->has_uv) {
                                 context_ptr->md_context->cb_txb_skip_context = 0;
                                 context_ptr->md_context->cb_dc_sign_context  = 0;
-                                get_txb_ctx(pcs_ptr->parent_pcs_ptr->scs_ptr,
-                                            COMPONENT_CHROMA,
-                                            pcs_ptr->ep_cb_dc_sign_level_coeff_neighbor_array,
-                                            cu_originx_uv,
-                                            cu_originy_uv,
-                                            context_ptr->blk_geom->bsize_uv,
-                                            context_ptr->blk_geom->txsize_uv[0][0],
-                                            &context_ptr->md_context->cb_txb_skip_context,
-                                            &context_ptr->md_context->cb_dc_sign_context);
+                                get_txb_ctx(
+                                    pcs_ptr->parent_pcs_ptr->scs_ptr,
+                                    COMPONENT_CHROMA,
+                                    pcs_ptr->ep_cb_dc_sign_level_coeff_neighbor_array[tile_idx],
+                                    cu_originx_uv,
+                                    cu_originy_uv,
+                                    context_ptr->blk_geom->bsize_uv,
+                                    context_ptr->blk_geom->txsize_uv[0][0],
+                                    &context_ptr->md_context->cb_txb_skip_context,
+                                    &context_ptr->md_context->cb_dc_sign_context);
 
                                 context_ptr->md_context->cr_txb_skip_context = 0;
                                 context_ptr->md_context->cr_dc_sign_context  = 0;
-                                get_txb_ctx(pcs_ptr->parent_pcs_ptr->scs_ptr,
-                                            COMPONENT_CHROMA,
-                                            pcs_ptr->ep_cr_dc_sign_level_coeff_neighbor_array,
-                                            cu_originx_uv,
-                                            cu_originy_uv,
-                                            context_ptr->blk_geom->bsize_uv,
-                                            context_ptr->blk_geom->txsize_uv[0][0],
-                                            &context_ptr->md_context->cr_txb_skip_context,
-                                            &context_ptr->md_context->cr_dc_sign_context);
+                                get_txb_ctx(
+                                    pcs_ptr->parent_pcs_ptr->scs_ptr,
+                                    COMPONENT_CHROMA,
+                                    pcs_ptr->ep_cr_dc_sign_level_coeff_neighbor_array[tile_idx],
+                                    cu_originx_uv,
+                                    cu_originy_uv,
+                                    context_ptr->blk_geom->bsize_uv,
+                                    context_ptr->blk_geom->txsize_uv[0][0],
+                                    &context_ptr->md_context->cr_txb_skip_context,
+                                    &context_ptr->md_context->cr_dc_sign_context);
                             }
                             {
                                 MvReferenceFrame ref_frame = INTRA_FRAME;
@@ -2722,7 +2765,7 @@ EB_EXTERN void av1_encode_pass(SequenceControlSet *scs_ptr, PictureControlSet *p
                                 uint8_t dc_sign_level_coeff =
                                     (uint8_t)blk_ptr->quantized_dc[0][context_ptr->txb_itr];
                                 neighbor_array_unit_mode_write(
-                                    pcs_ptr->ep_luma_dc_sign_level_coeff_neighbor_array,
+                                    pcs_ptr->ep_luma_dc_sign_level_coeff_neighbor_array[tile_idx],
                                     (uint8_t *)&dc_sign_level_coeff,
                                     context_ptr->blk_origin_x,
                                     context_ptr->blk_origin_y,
@@ -2736,7 +2779,7 @@ EB_EXTERN void av1_encode_pass(SequenceControlSet *scs_ptr, PictureControlSet *p
                                 uint8_t dc_sign_level_coeff =
                                     (uint8_t)blk_ptr->quantized_dc[1][context_ptr->txb_itr];
                                 neighbor_array_unit_mode_write(
-                                    pcs_ptr->ep_cb_dc_sign_level_coeff_neighbor_array,
+                                    pcs_ptr->ep_cb_dc_sign_level_coeff_neighbor_array[tile_idx],
                                     (uint8_t *)&dc_sign_level_coeff,
                                     ROUND_UV(context_ptr->blk_origin_x) >> 1,
                                     ROUND_UV(context_ptr->blk_origin_y) >> 1,
@@ -2750,7 +2793,7 @@ EB_EXTERN void av1_encode_pass(SequenceControlSet *scs_ptr, PictureControlSet *p
                                 uint8_t dc_sign_level_coeff =
                                     (uint8_t)blk_ptr->quantized_dc[2][context_ptr->txb_itr];
                                 neighbor_array_unit_mode_write(
-                                    pcs_ptr->ep_cr_dc_sign_level_coeff_neighbor_array,
+                                    pcs_ptr->ep_cr_dc_sign_level_coeff_neighbor_array[tile_idx],
                                     (uint8_t *)&dc_sign_level_coeff,
                                     ROUND_UV(context_ptr->blk_origin_x) >> 1,
                                     ROUND_UV(context_ptr->blk_origin_y) >> 1,
@@ -3006,16 +3049,17 @@ EB_EXTERN void av1_encode_pass(SequenceControlSet *scs_ptr, PictureControlSet *p
 
                             context_ptr->md_context->luma_txb_skip_context = 0;
                             context_ptr->md_context->luma_dc_sign_context  = 0;
-                            get_txb_ctx(pcs_ptr->parent_pcs_ptr->scs_ptr,
-                                        COMPONENT_LUMA,
-                                        pcs_ptr->ep_luma_dc_sign_level_coeff_neighbor_array,
-                                        txb_origin_x,
-                                        txb_origin_y,
-                                        context_ptr->blk_geom->bsize,
-                                        context_ptr->blk_geom
-                                            ->txsize[blk_ptr->tx_depth][context_ptr->txb_itr],
-                                        &context_ptr->md_context->luma_txb_skip_context,
-                                        &context_ptr->md_context->luma_dc_sign_context);
+                            get_txb_ctx(
+                                pcs_ptr->parent_pcs_ptr->scs_ptr,
+                                COMPONENT_LUMA,
+                                pcs_ptr->ep_luma_dc_sign_level_coeff_neighbor_array[tile_idx],
+                                txb_origin_x,
+                                txb_origin_y,
+                                context_ptr->blk_geom->bsize,
+                                context_ptr->blk_geom->txsize[blk_ptr->tx_depth]
+                                                             [context_ptr->txb_itr],
+                                &context_ptr->md_context->luma_txb_skip_context,
+                                &context_ptr->md_context->luma_dc_sign_context);
 
                             if (context_ptr->blk_geom->has_uv && uv_pass) {
                                 context_ptr->md_context->cb_txb_skip_context = 0;
@@ -3023,7 +3067,7 @@ EB_EXTERN void av1_encode_pass(SequenceControlSet *scs_ptr, PictureControlSet *p
                                 get_txb_ctx(
                                     pcs_ptr->parent_pcs_ptr->scs_ptr,
                                     COMPONENT_CHROMA,
-                                    pcs_ptr->ep_cb_dc_sign_level_coeff_neighbor_array,
+                                    pcs_ptr->ep_cb_dc_sign_level_coeff_neighbor_array[tile_idx],
                                     ROUND_UV(txb_origin_x) >> 1,
                                     ROUND_UV(txb_origin_y) >> 1,
                                     context_ptr->blk_geom->bsize_uv,
@@ -3034,16 +3078,17 @@ EB_EXTERN void av1_encode_pass(SequenceControlSet *scs_ptr, PictureControlSet *p
 
                                 context_ptr->md_context->cr_txb_skip_context = 0;
                                 context_ptr->md_context->cr_dc_sign_context  = 0;
-                                get_txb_ctx(pcs_ptr->parent_pcs_ptr->scs_ptr,
-                                            COMPONENT_CHROMA,
-                                            pcs_ptr->ep_cr_dc_sign_level_coeff_neighbor_array,
-                                            ROUND_UV(txb_origin_x) >> 1,
-                                            ROUND_UV(txb_origin_y) >> 1,
-                                            context_ptr->blk_geom->bsize_uv,
-                                            context_ptr->blk_geom->txsize_uv[blk_ptr->tx_depth]
-                                                                            [context_ptr->txb_itr],
-                                            &context_ptr->md_context->cr_txb_skip_context,
-                                            &context_ptr->md_context->cr_dc_sign_context);
+                                get_txb_ctx(
+                                    pcs_ptr->parent_pcs_ptr->scs_ptr,
+                                    COMPONENT_CHROMA,
+                                    pcs_ptr->ep_cr_dc_sign_level_coeff_neighbor_array[tile_idx],
+                                    ROUND_UV(txb_origin_x) >> 1,
+                                    ROUND_UV(txb_origin_y) >> 1,
+                                    context_ptr->blk_geom->bsize_uv,
+                                    context_ptr->blk_geom->txsize_uv[blk_ptr->tx_depth]
+                                                                    [context_ptr->txb_itr],
+                                    &context_ptr->md_context->cr_txb_skip_context,
+                                    &context_ptr->md_context->cr_dc_sign_context);
                             }
                             if (!zero_luma_cbf_md)
                                 //inter mode  1
@@ -3264,7 +3309,7 @@ EB_EXTERN void av1_encode_pass(SequenceControlSet *scs_ptr, PictureControlSet *p
                                     (uint8_t)blk_ptr->quantized_dc[0][context_ptr->txb_itr];
 
                                 neighbor_array_unit_mode_write(
-                                    pcs_ptr->ep_luma_dc_sign_level_coeff_neighbor_array,
+                                    pcs_ptr->ep_luma_dc_sign_level_coeff_neighbor_array[tile_idx],
                                     (uint8_t *)&dc_sign_level_coeff,
                                     txb_origin_x,
                                     txb_origin_y,
@@ -3280,7 +3325,7 @@ EB_EXTERN void av1_encode_pass(SequenceControlSet *scs_ptr, PictureControlSet *p
                                 uint8_t dc_sign_level_coeff =
                                     (uint8_t)blk_ptr->quantized_dc[1][context_ptr->txb_itr];
                                 neighbor_array_unit_mode_write(
-                                    pcs_ptr->ep_cb_dc_sign_level_coeff_neighbor_array,
+                                    pcs_ptr->ep_cb_dc_sign_level_coeff_neighbor_array[tile_idx],
                                     (uint8_t *)&dc_sign_level_coeff,
                                     ROUND_UV(txb_origin_x) >> 1,
                                     ROUND_UV(txb_origin_y) >> 1,
@@ -3296,7 +3341,7 @@ EB_EXTERN void av1_encode_pass(SequenceControlSet *scs_ptr, PictureControlSet *p
                                 uint8_t dc_sign_level_coeff =
                                     (uint8_t)blk_ptr->quantized_dc[2][context_ptr->txb_itr];
                                 neighbor_array_unit_mode_write(
-                                    pcs_ptr->ep_cr_dc_sign_level_coeff_neighbor_array,
+                                    pcs_ptr->ep_cr_dc_sign_level_coeff_neighbor_array[tile_idx],
                                     (uint8_t *)&dc_sign_level_coeff,
                                     ROUND_UV(txb_origin_x) >> 1,
                                     ROUND_UV(txb_origin_y) >> 1,
@@ -3343,7 +3388,7 @@ EB_EXTERN void av1_encode_pass(SequenceControlSet *scs_ptr, PictureControlSet *p
                         get_txb_ctx(
                             pcs_ptr->parent_pcs_ptr->scs_ptr,
                             COMPONENT_LUMA,
-                            pcs_ptr->ep_luma_dc_sign_level_coeff_neighbor_array,
+                            pcs_ptr->ep_luma_dc_sign_level_coeff_neighbor_array[tile_idx],
                             txb_origin_x,
                             txb_origin_y,
                             context_ptr->blk_geom->bsize,
@@ -3357,7 +3402,7 @@ EB_EXTERN void av1_encode_pass(SequenceControlSet *scs_ptr, PictureControlSet *p
                             get_txb_ctx(
                                 pcs_ptr->parent_pcs_ptr->scs_ptr,
                                 COMPONENT_CHROMA,
-                                pcs_ptr->ep_cb_dc_sign_level_coeff_neighbor_array,
+                                pcs_ptr->ep_cb_dc_sign_level_coeff_neighbor_array[tile_idx],
                                 ROUND_UV(txb_origin_x) >> 1,
                                 ROUND_UV(txb_origin_y) >> 1,
                                 context_ptr->blk_geom->bsize_uv,
@@ -3370,7 +3415,7 @@ EB_EXTERN void av1_encode_pass(SequenceControlSet *scs_ptr, PictureControlSet *p
                             context_ptr->md_context->cr_dc_sign_context  = 0;
                             get_txb_ctx(pcs_ptr->parent_pcs_ptr->scs_ptr,
                                         COMPONENT_CHROMA,
-                                        pcs_ptr->ep_cr_dc_sign_level_coeff_neighbor_array,
+                                        pcs_ptr->ep_cr_dc_sign_level_coeff_neighbor_array[tile_idx],
                                         ROUND_UV(txb_origin_x) >> 1,
                                         ROUND_UV(txb_origin_y) >> 1,
                                         context_ptr->blk_geom->bsize_uv,
@@ -3502,7 +3547,7 @@ EB_EXTERN void av1_encode_pass(SequenceControlSet *scs_ptr, PictureControlSet *p
                                 (uint8_t)blk_ptr->quantized_dc[0][context_ptr->txb_itr];
 
                             neighbor_array_unit_mode_write(
-                                pcs_ptr->ep_luma_dc_sign_level_coeff_neighbor_array,
+                                pcs_ptr->ep_luma_dc_sign_level_coeff_neighbor_array[tile_idx],
                                 (uint8_t *)&dc_sign_level_coeff,
                                 txb_origin_x,
                                 txb_origin_y,
@@ -3518,7 +3563,7 @@ EB_EXTERN void av1_encode_pass(SequenceControlSet *scs_ptr, PictureControlSet *p
                             uint8_t dc_sign_level_coeff =
                                 (uint8_t)blk_ptr->quantized_dc[1][context_ptr->txb_itr];
                             neighbor_array_unit_mode_write(
-                                pcs_ptr->ep_cb_dc_sign_level_coeff_neighbor_array,
+                                pcs_ptr->ep_cb_dc_sign_level_coeff_neighbor_array[tile_idx],
                                 (uint8_t *)&dc_sign_level_coeff,
                                 ROUND_UV(txb_origin_x) >> 1,
                                 ROUND_UV(txb_origin_y) >> 1,
@@ -3534,7 +3579,7 @@ EB_EXTERN void av1_encode_pass(SequenceControlSet *scs_ptr, PictureControlSet *p
                             uint8_t dc_sign_level_coeff =
                                 (uint8_t)blk_ptr->quantized_dc[2][context_ptr->txb_itr];
                             neighbor_array_unit_mode_write(
-                                pcs_ptr->ep_cr_dc_sign_level_coeff_neighbor_array,
+                                pcs_ptr->ep_cr_dc_sign_level_coeff_neighbor_array[tile_idx],
                                 (uint8_t *)&dc_sign_level_coeff,
                                 ROUND_UV(txb_origin_x) >> 1,
                                 ROUND_UV(txb_origin_y) >> 1,
@@ -3818,13 +3863,14 @@ EB_EXTERN void av1_encode_pass(SequenceControlSet *scs_ptr, PictureControlSet *p
                     partition.above = partition_context_lookup[blk_geom->bsize].above;
                     partition.left  = partition_context_lookup[blk_geom->bsize].left;
 
-                    neighbor_array_unit_mode_write(pcs_ptr->ep_partition_context_neighbor_array,
-                                                   (uint8_t *)&partition,
-                                                   context_ptr->blk_origin_x,
-                                                   context_ptr->blk_origin_y,
-                                                   blk_geom->bwidth,
-                                                   blk_geom->bheight,
-                                                   NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
+                    neighbor_array_unit_mode_write(
+                        pcs_ptr->ep_partition_context_neighbor_array[tile_idx],
+                        (uint8_t *)&partition,
+                        context_ptr->blk_origin_x,
+                        context_ptr->blk_origin_y,
+                        blk_geom->bwidth,
+                        blk_geom->bheight,
+                        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
 
                     // Update the CDFs based on the current block
                     blk_ptr->av1xd->tile_ctx = &pcs_ptr->ec_ctx_array[sb_addr];
@@ -3882,7 +3928,7 @@ else blk_it +=
     d1_depth_offset[scs_ptr->seq_header.sb_size == BLOCK_128X128][context_ptr->blk_geom->depth];
 } // CU Loop
 // First Pass Deblocking
-if (dlf_enable_flag && pcs_ptr->parent_pcs_ptr->loop_filter_mode == 1) {
+if (sb_dlf_flag) {
     if (pcs_ptr->parent_pcs_ptr->frm_hdr.loop_filter_params.filter_level[0] ||
         pcs_ptr->parent_pcs_ptr->frm_hdr.loop_filter_params.filter_level[1]) {
         uint8_t last_col =
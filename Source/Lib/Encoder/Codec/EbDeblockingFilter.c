@@ -25,6 +25,7 @@
 #include "EbReferenceObject.h"
 #include "EbCommonUtils.h"
 #include "EbLog.h"
+#include "EbThreads.h"
 
 static const int delta_lf_id_lut[MAX_MB_PLANE][2] = {{0, 1}, {2, 2}, {3, 3}};
 
@@ -1218,6 +1219,52 @@ void loop_filter_sb(EbPictureBufferDesc *frame_buffer, //reconpicture,
     }
 }
 
+/* Row level function to trigger loop filter for each superblock of one SB row.
+   eb_av1_loop_filter_frame_init() must have been called for the frame, and
+   pcs_ptr->sb_lf_completed_in_row[] reset to -1, before the first row starts.
+   Rows of the same frame can run on different threads: each SB waits for the
+   top-right SB of the row above, which keeps the output identical to the
+   raster-order eb_av1_loop_filter_frame(). */
+void eb_av1_loop_filter_sb_row(EbPictureBufferDesc *frame_buffer, PictureControlSet *pcs_ptr,
+                               uint32_t y_sb_index, int32_t plane_start, int32_t plane_end) {
+    SequenceControlSet *scs_ptr =
+        (SequenceControlSet *)pcs_ptr->parent_pcs_ptr->scs_wrapper_ptr->object_ptr;
+    uint8_t  sb_size_log2 = (uint8_t)Log2f(scs_ptr->sb_size_pix);
+    int32_t  pic_width_in_sb =
+        (scs_ptr->seq_header.max_frame_width + scs_ptr->sb_size_pix - 1) / scs_ptr->sb_size_pix;
+    uint32_t sb_origin_y = y_sb_index << sb_size_log2;
+
+    volatile int32_t *sb_lf_completed_in_prev_row = NULL;
+    if (y_sb_index)
+        sb_lf_completed_in_prev_row =
+            (volatile int32_t *)&pcs_ptr->sb_lf_completed_in_row[y_sb_index - 1];
+    volatile int32_t *sb_lf_completed_in_row =
+        (volatile int32_t *)&pcs_ptr->sb_lf_completed_in_row[y_sb_index];
+
+    for (int32_t x_sb_index = 0; x_sb_index < pic_width_in_sb; ++x_sb_index) {
+        uint32_t sb_origin_x     = x_sb_index << sb_size_log2;
+        EbBool   end_of_row_flag = (x_sb_index == pic_width_in_sb - 1) ? EB_TRUE : EB_FALSE;
+
+        /* Top-Right Sync */
+        if (y_sb_index) {
+            int32_t spin = 0;
+            while (eb_atomic_load32(sb_lf_completed_in_prev_row) <
+                   MIN(x_sb_index + 1, pic_width_in_sb - 1))
+                eb_spin_backoff(&spin);
+        }
+        loop_filter_sb(frame_buffer,
+                       pcs_ptr,
+                       NULL,
+                       sb_origin_y >> 2,
+                       sb_origin_x >> 2,
+                       plane_start,
+                       plane_end,
+                       end_of_row_flag);
+        /* Update Top-Right Sync */
+        eb_atomic_store32(sb_lf_completed_in_row, x_sb_index);
+    }
+}
+
 void eb_av1_loop_filter_frame(EbPictureBufferDesc *frame_buffer, PictureControlSet *pcs_ptr,
                               int32_t plane_start, int32_t plane_end) {
     SequenceControlSet *scs_ptr =
@@ -15,6 +15,7 @@
 */
 
 #include <stdlib.h>
+#include <string.h>
 #include "EbEncHandle.h"
 #include "EbDlfProcess.h"
 #include "EbEncDecResults.h"
@@ -23,6 +24,7 @@
 #include "EbDefinitions.h"
 #include "EbSequenceControlSet.h"
 #include "EbPictureControlSet.h"
+#include "EbPipelineStats.h"
 
 void eb_av1_loop_restoration_save_boundary_lines(const Yv12BufferConfig *frame, Av1Common *cm,
                                                  int32_t after_cdef);
@@ -38,7 +40,7 @@ static void dlf_context_dctor(EbPtr p) {
  * Dlf Context Constructor
  ******************************************************/
 EbErrorType dlf_context_ctor(EbThreadContext *thread_context_ptr, const EbEncHandle *enc_handle_ptr,
-                             int index) {
+                             int index, int feedback_index) {
     EbErrorType               return_error = EB_ErrorNone;
     const SequenceControlSet *scs_ptr      = enc_handle_ptr->scs_instance_array[0]->scs_ptr;
     EbBool        is_16bit     = (EbBool)(scs_ptr->static_config.encoder_bit_depth > EB_8BIT);
@@ -54,6 +56,8 @@ EbErrorType dlf_context_ctor(EbThreadContext *thread_context_ptr, const EbEncHan
         eb_system_resource_get_consumer_fifo(enc_handle_ptr->enc_dec_results_resource_ptr, index);
     context_ptr->dlf_output_fifo_ptr =
         eb_system_resource_get_producer_fifo(enc_handle_ptr->dlf_results_resource_ptr, index);
+    context_ptr->dlf_feedback_fifo_ptr = eb_system_resource_get_producer_fifo(
+        enc_handle_ptr->enc_dec_results_resource_ptr, feedback_index);
 
     context_ptr->temp_lf_recon_picture16bit_ptr = (EbPictureBufferDesc *)EB_NULL;
     context_ptr->temp_lf_recon_picture_ptr      = (EbPictureBufferDesc *)EB_NULL;
@@ -85,59 +89,187 @@ EbErrorType dlf_context_ctor(EbThreadContext *thread_context_ptr, const EbEncHan
     return return_error;
 }
 
+static EbPictureBufferDesc *get_dlf_recon_buffer(PictureControlSet *pcs_ptr, EbBool is_16bit) {
+    if (pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE) {
+        EbReferenceObject *ref_obj =
+            (EbReferenceObject *)pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr;
+        return is_16bit ? ref_obj->reference_picture16bit : ref_obj->reference_picture;
+    }
+    return is_16bit ? pcs_ptr->recon_picture16bit_ptr : pcs_ptr->recon_picture_ptr;
+}
+
 /******************************************************
- * Dlf Kernel
+ * Pre-CDEF prep
+ * Only derives the CDEF search pointers, so it can run
+ * before the SB rows are deblocked.
  ******************************************************/
-void *dlf_kernel(void *input_ptr) {
+static void dlf_setup_cdef(SequenceControlSet *scs_ptr, PictureControlSet *pcs_ptr,
+                           EbBool is_16bit) {
+    Av1Common *          cm                = pcs_ptr->parent_pcs_ptr->av1_cm;
+    EbPictureBufferDesc *recon_picture_ptr = get_dlf_recon_buffer(pcs_ptr, is_16bit);
+
+    link_eb_to_aom_buffer_desc(recon_picture_ptr, cm->frame_to_show);
+
+    if (scs_ptr->seq_header.enable_cdef && pcs_ptr->parent_pcs_ptr->cdef_filter_mode) {
+        if (is_16bit) {
+            pcs_ptr->src[0] = (uint16_t *)recon_picture_ptr->buffer_y +
+                              (recon_picture_ptr->origin_x +
+                               recon_picture_ptr->origin_y * recon_picture_ptr->stride_y);
+            pcs_ptr->src[1] = (uint16_t *)recon_picture_ptr->buffer_cb +
+                              (recon_picture_ptr->origin_x / 2 +
+                               recon_picture_ptr->origin_y / 2 * recon_picture_ptr->stride_cb);
+            pcs_ptr->src[2] = (uint16_t *)recon_picture_ptr->buffer_cr +
+                              (recon_picture_ptr->origin_x / 2 +
+                               recon_picture_ptr->origin_y / 2 * recon_picture_ptr->stride_cr);
+
+            EbPictureBufferDesc *input_picture_ptr = pcs_ptr->input_frame16bit;
+            pcs_ptr->ref_coeff[0] = (uint16_t *)input_picture_ptr->buffer_y +
+                                    (input_picture_ptr->origin_x +
+                                     input_picture_ptr->origin_y * input_picture_ptr->stride_y);
+            pcs_ptr->ref_coeff[1] =
+                (uint16_t *)input_picture_ptr->buffer_cb +
+                (input_picture_ptr->origin_x / 2 +
+                 input_picture_ptr->origin_y / 2 * input_picture_ptr->stride_cb);
+            pcs_ptr->ref_coeff[2] =
+                (uint16_t *)input_picture_ptr->buffer_cr +
+                (input_picture_ptr->origin_x / 2 +
+                 input_picture_ptr->origin_y / 2 * input_picture_ptr->stride_cr);
+        } else {
+            EbByte rec_ptr = &(
+                (recon_picture_ptr->buffer_y)[recon_picture_ptr->origin_x +
+                                              recon_picture_ptr->origin_y *
+                                                  recon_picture_ptr->stride_y]);
+            EbByte rec_ptr_cb = &(
+                (recon_picture_ptr->buffer_cb)[recon_picture_ptr->origin_x / 2 +
+                                               recon_picture_ptr->origin_y / 2 *
+                                                   recon_picture_ptr->stride_cb]);
+            EbByte rec_ptr_cr = &(
+                (recon_picture_ptr->buffer_cr)[recon_picture_ptr->origin_x / 2 +
+                                               recon_picture_ptr->origin_y / 2 *
+                                                   recon_picture_ptr->stride_cr]);
+
+            EbPictureBufferDesc *input_picture_ptr =
+                (EbPictureBufferDesc *)pcs_ptr->parent_pcs_ptr->enhanced_picture_ptr;
+            EbByte enh_ptr = &(
+                (input_picture_ptr->buffer_y)[input_picture_ptr->origin_x +
+                                              input_picture_ptr->origin_y *
+                                                  input_picture_ptr->stride_y]);
+            EbByte enh_ptr_cb = &(
+                (input_picture_ptr->buffer_cb)[input_picture_ptr->origin_x / 2 +
+                                               input_picture_ptr->origin_y / 2 *
+                                                   input_picture_ptr->stride_cb]);
+            EbByte enh_ptr_cr = &(
+                (input_picture_ptr->buffer_cr)[input_picture_ptr->origin_x / 2 +
+                                               input_picture_ptr->origin_y / 2 *
+                                                   input_picture_ptr->stride_cr]);
+
+            pcs_ptr->src[0] = (uint16_t *)rec_ptr;
+            pcs_ptr->src[1] = (uint16_t *)rec_ptr_cb;
+            pcs_ptr->src[2] = (uint16_t *)rec_ptr_cr;
+
+            pcs_ptr->ref_coeff[0] = (uint16_t *)enh_ptr;
+            pcs_ptr->ref_coeff[1] = (uint16_t *)enh_ptr_cb;
+            pcs_ptr->ref_coeff[2] = (uint16_t *)enh_ptr_cr;
+        }
+    }
+
+    pcs_ptr->cdef_segments_column_count = scs_ptr->cdef_segment_column_count;
+    pcs_ptr->cdef_segments_row_count    = scs_ptr->cdef_segment_row_count;
+    pcs_ptr->cdef_segments_total_count =
+        (uint16_t)(pcs_ptr->cdef_segments_column_count * pcs_ptr->cdef_segments_row_count);
+    pcs_ptr->tot_seg_searched_cdef    = 0;
+    pcs_ptr->cdef_segment_rows_posted = 0;
+}
+
+/******************************************************
+ * Post the CDEF segments of segment rows
+ * [seg_row_start, seg_row_end) to the CDEF stage
+ ******************************************************/
+static void dlf_post_cdef_segment_rows(DlfContext *context_ptr, PictureControlSet *pcs_ptr,
+                                       EbObjectWrapper *pcs_wrapper_ptr, uint32_t seg_row_start,
+                                       uint32_t seg_row_end) {
+    EbObjectWrapper *  dlf_results_wrapper_ptr;
+    struct DlfResults *dlf_results_ptr;
+
+    for (uint32_t seg_row = seg_row_start; seg_row < seg_row_end; ++seg_row) {
+        for (uint32_t seg_col = 0; seg_col < pcs_ptr->cdef_segments_column_count; ++seg_col) {
+            // Get Empty DLF Results to Cdef
+            eb_get_empty_object(context_ptr->dlf_output_fifo_ptr, &dlf_results_wrapper_ptr);
+            dlf_results_ptr = (struct DlfResults *)dlf_results_wrapper_ptr->object_ptr;
+            dlf_results_ptr->pcs_wrapper_ptr = pcs_wrapper_ptr;
+            dlf_results_ptr->segment_index =
+                seg_row * pcs_ptr->cdef_segments_column_count + seg_col;
+            // Post DLF Results
+            eb_post_full_object(dlf_results_wrapper_ptr);
+        }
+    }
+}
+
+/******************************************************
+ * Deblocking is done for the whole picture: save the
+ * LR boundary lines and release the remaining CDEF
+ * segments. The last CDEF segment row is never posted
+ * before this point, so the CDEF application can not
+ * start while the boundary lines are being saved.
+ ******************************************************/
+static void dlf_finish_picture(DlfContext *context_ptr, SequenceControlSet *scs_ptr,
+                               PictureControlSet *pcs_ptr, EbObjectWrapper *pcs_wrapper_ptr) {
+    Av1Common *cm = pcs_ptr->parent_pcs_ptr->av1_cm;
+    uint32_t   seg_row_start;
+
+    if (scs_ptr->seq_header.enable_restoration)
+        eb_av1_loop_restoration_save_boundary_lines(cm->frame_to_show, cm, 0);
+
+    eb_block_on_mutex(pcs_ptr->dlf_row_mutex);
+    seg_row_start                     = pcs_ptr->cdef_segment_rows_posted;
+    pcs_ptr->cdef_segment_rows_posted = pcs_ptr->cdef_segments_row_count;
+    eb_release_mutex(pcs_ptr->dlf_row_mutex);
+
+    dlf_post_cdef_segment_rows(
+        context_ptr, pcs_ptr, pcs_wrapper_ptr, seg_row_start, pcs_ptr->cdef_segments_row_count);
+}
+
+/******************************************************
+ * Dlf Job
+ *   Processes one EncDec result or DLF SB row task.
+ ******************************************************/
+void dlf_job(EbThreadContext *thread_context_ptr, EbObjectWrapper *enc_dec_results_wrapper_ptr) {
     // Context & SCS & PCS
-    EbThreadContext *   thread_context_ptr = (EbThreadContext *)input_ptr;
-    DlfContext *        context_ptr        = (DlfContext *)thread_context_ptr->priv;
+    DlfContext *        context_ptr = (DlfContext *)thread_context_ptr->priv;
     PictureControlSet * pcs_ptr;
     SequenceControlSet *scs_ptr;
 
     //// Input
-    EbObjectWrapper *enc_dec_results_wrapper_ptr;
     EncDecResults *  enc_dec_results_ptr;
 
     //// Output
-    EbObjectWrapper *  dlf_results_wrapper_ptr;
-    struct DlfResults *dlf_results_ptr;
+    EbObjectWrapper *dlf_row_wrapper_ptr;
+    EncDecResults *  dlf_row_ptr;
 
     // SB Loop variables
-    for (;;) {
-        // Get EncDec Results
-        eb_get_full_object(context_ptr->dlf_input_fifo_ptr, &enc_dec_results_wrapper_ptr);
 
-        enc_dec_results_ptr = (EncDecResults *)enc_dec_results_wrapper_ptr->object_ptr;
-        pcs_ptr             = (PictureControlSet *)enc_dec_results_ptr->pcs_wrapper_ptr->object_ptr;
-        scs_ptr             = (SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr;
+    enc_dec_results_ptr = (EncDecResults *)enc_dec_results_wrapper_ptr->object_ptr;
+    pcs_ptr             = (PictureControlSet *)enc_dec_results_ptr->pcs_wrapper_ptr->object_ptr;
+    scs_ptr             = (SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr;
+    eb_pipeline_stats_set_picture(pcs_ptr->picture_number);
 
-        EbBool is_16bit = (EbBool)(scs_ptr->static_config.encoder_bit_depth > EB_8BIT);
+    EbBool   is_16bit = (EbBool)(scs_ptr->static_config.encoder_bit_depth > EB_8BIT);
+    uint32_t picture_height_in_sb =
+        (scs_ptr->seq_header.max_frame_height + scs_ptr->sb_size_pix - 1) /
+        scs_ptr->sb_size_pix;
+    EbPictureBufferDesc *recon_buffer = get_dlf_recon_buffer(pcs_ptr, is_16bit);
 
+    if (enc_dec_results_ptr->input_type == DLF_TASKS_ENCDEC_INPUT) {
         EbBool dlf_enable_flag = (EbBool)pcs_ptr->parent_pcs_ptr->loop_filter_mode;
-        if (dlf_enable_flag && pcs_ptr->parent_pcs_ptr->loop_filter_mode >= 2) {
-            EbPictureBufferDesc *recon_buffer =
-                is_16bit ? pcs_ptr->recon_picture16bit_ptr : pcs_ptr->recon_picture_ptr;
-
-            if (pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE)
-                //get the 16bit form of the input SB
-                if (is_16bit)
-                    recon_buffer =
-                        ((EbReferenceObject *)
-                             pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)
-                            ->reference_picture16bit;
-                else
-                    recon_buffer =
-                        ((EbReferenceObject *)
-                             pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)
-                            ->reference_picture;
-            else // non ref pictures
-                recon_buffer =
-                    is_16bit ? pcs_ptr->recon_picture16bit_ptr : pcs_ptr->recon_picture_ptr;
+        // Mode 1 deblocks in EncDec SB by SB, unless the tiles were separate EncDec units
+        EbBool dlf_rows_flag = pcs_ptr->parent_pcs_ptr->loop_filter_mode >= 2 ||
+            pcs_ptr->enc_dec_unit_count > 1;
+        dlf_setup_cdef(scs_ptr, pcs_ptr, is_16bit);
 
+        if (dlf_enable_flag && dlf_rows_flag) {
             eb_av1_loop_filter_init(pcs_ptr);
 
-            if (pcs_ptr->parent_pcs_ptr->loop_filter_mode == 2) {
+            if (pcs_ptr->parent_pcs_ptr->loop_filter_mode <= 2) {
                 eb_av1_pick_filter_level(
                     context_ptr,
                     (EbPictureBufferDesc *)pcs_ptr->parent_pcs_ptr->enhanced_picture_ptr,
@@ -145,11 +277,13 @@ void *dlf_kernel(void *input_ptr) {
                     LPF_PICK_FROM_Q);
             }
 
-            eb_av1_pick_filter_level(
-                context_ptr,
-                (EbPictureBufferDesc *)pcs_ptr->parent_pcs_ptr->enhanced_picture_ptr,
-                pcs_ptr,
-                LPF_PICK_FROM_FULL_IMAGE);
+            if (pcs_ptr->parent_pcs_ptr->loop_filter_mode >= 2) {
+                eb_av1_pick_filter_level(
+                    context_ptr,
+                    (EbPictureBufferDesc *)pcs_ptr->parent_pcs_ptr->enhanced_picture_ptr,
+                    pcs_ptr,
+                    LPF_PICK_FROM_FULL_IMAGE);
+            }
 
 #if NO_ENCDEC
             //NO DLF
@@ -158,123 +292,79 @@ void *dlf_kernel(void *input_ptr) {
             pcs_ptr->parent_pcs_ptr->lf.filter_level_u  = 0;
             pcs_ptr->parent_pcs_ptr->lf.filter_level_v  = 0;
 #endif
-            eb_av1_loop_filter_frame(recon_buffer, pcs_ptr, 0, 3);
-        }
-
-        //pre-cdef prep
-        {
-            Av1Common *          cm = pcs_ptr->parent_pcs_ptr->av1_cm;
-            EbPictureBufferDesc *recon_picture_ptr;
-            if (is_16bit) {
-                if (pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE)
-                    recon_picture_ptr =
-                        ((EbReferenceObject *)
-                             pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)
-                            ->reference_picture16bit;
-                else
-                    recon_picture_ptr = pcs_ptr->recon_picture16bit_ptr;
-            } else {
-                if (pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE)
-                    recon_picture_ptr =
-                        ((EbReferenceObject *)
-                             pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)
-                            ->reference_picture;
-                else
-                    recon_picture_ptr = pcs_ptr->recon_picture_ptr;
-            }
-
-            link_eb_to_aom_buffer_desc(recon_picture_ptr, cm->frame_to_show);
-
-            if (scs_ptr->seq_header.enable_restoration)
-                eb_av1_loop_restoration_save_boundary_lines(cm->frame_to_show, cm, 0);
-            if (scs_ptr->seq_header.enable_cdef && pcs_ptr->parent_pcs_ptr->cdef_filter_mode) {
-                if (is_16bit) {
-                    pcs_ptr->src[0] = (uint16_t *)recon_picture_ptr->buffer_y +
-                                      (recon_picture_ptr->origin_x +
-                                       recon_picture_ptr->origin_y * recon_picture_ptr->stride_y);
-                    pcs_ptr->src[1] =
-                        (uint16_t *)recon_picture_ptr->buffer_cb +
-                        (recon_picture_ptr->origin_x / 2 +
-                         recon_picture_ptr->origin_y / 2 * recon_picture_ptr->stride_cb);
-                    pcs_ptr->src[2] =
-                        (uint16_t *)recon_picture_ptr->buffer_cr +
-                        (recon_picture_ptr->origin_x / 2 +
-                         recon_picture_ptr->origin_y / 2 * recon_picture_ptr->stride_cr);
-
-                    EbPictureBufferDesc *input_picture_ptr = pcs_ptr->input_frame16bit;
-                    pcs_ptr->ref_coeff[0] =
-                        (uint16_t *)input_picture_ptr->buffer_y +
-                        (input_picture_ptr->origin_x +
-                         input_picture_ptr->origin_y * input_picture_ptr->stride_y);
-                    pcs_ptr->ref_coeff[1] =
-                        (uint16_t *)input_picture_ptr->buffer_cb +
-                        (input_picture_ptr->origin_x / 2 +
-                         input_picture_ptr->origin_y / 2 * input_picture_ptr->stride_cb);
-                    pcs_ptr->ref_coeff[2] =
-                        (uint16_t *)input_picture_ptr->buffer_cr +
-                        (input_picture_ptr->origin_x / 2 +
-                         input_picture_ptr->origin_y / 2 * input_picture_ptr->stride_cr);
-                } else {
-                    EbByte rec_ptr =
-                        &((recon_picture_ptr->buffer_y)[recon_picture_ptr->origin_x +
-                                                        recon_picture_ptr->origin_y *
-                                                            recon_picture_ptr->stride_y]);
-                    EbByte rec_ptr_cb =
-                        &((recon_picture_ptr->buffer_cb)[recon_picture_ptr->origin_x / 2 +
-                                                         recon_picture_ptr->origin_y / 2 *
-                                                             recon_picture_ptr->stride_cb]);
-                    EbByte rec_ptr_cr =
-                        &((recon_picture_ptr->buffer_cr)[recon_picture_ptr->origin_x / 2 +
-                                                         recon_picture_ptr->origin_y / 2 *
-                                                             recon_picture_ptr->stride_cr]);
-
-                    EbPictureBufferDesc *input_picture_ptr =
-                        (EbPictureBufferDesc *)pcs_ptr->parent_pcs_ptr->enhanced_picture_ptr;
-                    EbByte enh_ptr =
-                        &((input_picture_ptr->buffer_y)[input_picture_ptr->origin_x +
-                                                        input_picture_ptr->origin_y *
-                                                            input_picture_ptr->stride_y]);
-                    EbByte enh_ptr_cb =
-                        &((input_picture_ptr->buffer_cb)[input_picture_ptr->origin_x / 2 +
-                                                         input_picture_ptr->origin_y / 2 *
-                                                             input_picture_ptr->stride_cb]);
-                    EbByte enh_ptr_cr =
-                        &((input_picture_ptr->buffer_cr)[input_picture_ptr->origin_x / 2 +
-                                                         input_picture_ptr->origin_y / 2 *
-                                                             input_picture_ptr->stride_cr]);
-
-                    pcs_ptr->src[0] = (uint16_t *)rec_ptr;
-                    pcs_ptr->src[1] = (uint16_t *)rec_ptr_cb;
-                    pcs_ptr->src[2] = (uint16_t *)rec_ptr_cr;
-
-                    pcs_ptr->ref_coeff[0] = (uint16_t *)enh_ptr;
-                    pcs_ptr->ref_coeff[1] = (uint16_t *)enh_ptr_cb;
-                    pcs_ptr->ref_coeff[2] = (uint16_t *)enh_ptr_cr;
-                }
+            eb_av1_loop_filter_frame_init(
+                &pcs_ptr->parent_pcs_ptr->frm_hdr, &pcs_ptr->parent_pcs_ptr->lf_info, 0, 3);
+
+            memset(pcs_ptr->sb_lf_completed_in_row, -1, picture_height_in_sb * sizeof(int32_t));
+            pcs_ptr->tot_sb_rows_dlf  = 0;
+            pcs_ptr->dlf_sb_rows_done = 0;
+
+            // Hand the SB rows to the DLF thread pool
+            for (uint32_t y_sb_index = 0; y_sb_index < picture_height_in_sb; ++y_sb_index) {
+                eb_get_empty_object(context_ptr->dlf_feedback_fifo_ptr, &dlf_row_wrapper_ptr);
+                dlf_row_ptr = (EncDecResults *)dlf_row_wrapper_ptr->object_ptr;
+                dlf_row_ptr->pcs_wrapper_ptr              = enc_dec_results_ptr->pcs_wrapper_ptr;
+                dlf_row_ptr->input_type                   = DLF_TASKS_SB_ROW_INPUT;
+                dlf_row_ptr->completed_sb_row_index_start = y_sb_index;
+                dlf_row_ptr->completed_sb_row_count       = 1;
+                eb_post_full_object(dlf_row_wrapper_ptr);
             }
+        } else
+            dlf_finish_picture(
+                context_ptr, scs_ptr, pcs_ptr, enc_dec_results_ptr->pcs_wrapper_ptr);
+    } else {
+        uint32_t y_sb_index = enc_dec_results_ptr->completed_sb_row_index_start;
+        uint32_t picture_height_in_b64 = (scs_ptr->seq_header.max_frame_height + 63) >> 6;
+        uint32_t seg_row_start, seg_row_end;
+        EbBool   last_row_flag;
+
+        eb_av1_loop_filter_sb_row(recon_buffer, pcs_ptr, y_sb_index, 0, 3);
+
+        // Rows complete in raster order (top-right sync), so every row up to this one is
+        // deblocked. A CDEF segment row can be searched once the b64 row below it is
+        // deblocked too, as filtering that row's top edge modifies the segment's last lines.
+        eb_block_on_mutex(pcs_ptr->dlf_row_mutex);
+        last_row_flag = ++pcs_ptr->tot_sb_rows_dlf == picture_height_in_sb;
+        pcs_ptr->dlf_sb_rows_done = (uint16_t)MAX(pcs_ptr->dlf_sb_rows_done, y_sb_index + 1);
+        uint32_t b64_rows_done =
+            MIN(pcs_ptr->dlf_sb_rows_done * (scs_ptr->sb_size_pix >> 6), picture_height_in_b64);
+        seg_row_start = seg_row_end = pcs_ptr->cdef_segment_rows_posted;
+        while (seg_row_end < pcs_ptr->cdef_segments_row_count) {
+            uint32_t y_b64_end_idx = SEGMENT_END_IDX(
+                seg_row_end, picture_height_in_b64, pcs_ptr->cdef_segments_row_count);
+            if (y_b64_end_idx + 1 > b64_rows_done) break;
+            ++seg_row_end;
         }
+        pcs_ptr->cdef_segment_rows_posted = (uint8_t)seg_row_end;
+        eb_release_mutex(pcs_ptr->dlf_row_mutex);
+
+        dlf_post_cdef_segment_rows(context_ptr,
+                                   pcs_ptr,
+                                   enc_dec_results_ptr->pcs_wrapper_ptr,
+                                   seg_row_start,
+                                   seg_row_end);
+        if (last_row_flag)
+            dlf_finish_picture(
+                context_ptr, scs_ptr, pcs_ptr, enc_dec_results_ptr->pcs_wrapper_ptr);
+    }
 
-        pcs_ptr->cdef_segments_column_count = scs_ptr->cdef_segment_column_count;
-        pcs_ptr->cdef_segments_row_count    = scs_ptr->cdef_segment_row_count;
-        pcs_ptr->cdef_segments_total_count =
-            (uint16_t)(pcs_ptr->cdef_segments_column_count * pcs_ptr->cdef_segments_row_count);
-        pcs_ptr->tot_seg_searched_cdef = 0;
-        uint32_t segment_index;
+    // Release EncDec Results
+    eb_release_object(enc_dec_results_wrapper_ptr);
+}
 
-        for (segment_index = 0; segment_index < pcs_ptr->cdef_segments_total_count;
-             ++segment_index) {
-            // Get Empty DLF Results to Cdef
-            eb_get_empty_object(context_ptr->dlf_output_fifo_ptr, &dlf_results_wrapper_ptr);
-            dlf_results_ptr = (struct DlfResults *)dlf_results_wrapper_ptr->object_ptr;
-            dlf_results_ptr->pcs_wrapper_ptr = enc_dec_results_ptr->pcs_wrapper_ptr;
-            dlf_results_ptr->segment_index   = segment_index;
-            // Post DLF Results
-            eb_post_full_object(dlf_results_wrapper_ptr);
-        }
+/******************************************************
+ * Dlf Kernel
+ ******************************************************/
+void *dlf_kernel(void *input_ptr) {
+    EbThreadContext *thread_context_ptr = (EbThreadContext *)input_ptr;
+    DlfContext *     context_ptr        = (DlfContext *)thread_context_ptr->priv;
+    EbObjectWrapper *enc_dec_results_wrapper_ptr;
 
-        // Release EncDec Results
-        eb_release_object(enc_dec_results_wrapper_ptr);
-    }
+    for (;;) {
+        // Get EncDec Results
+        eb_get_full_object(context_ptr->dlf_input_fifo_ptr, &enc_dec_results_wrapper_ptr);
 
+        dlf_job(thread_context_ptr, enc_dec_results_wrapper_ptr);
+    }
     return EB_NULL;
 }
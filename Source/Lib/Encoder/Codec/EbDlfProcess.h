@@ -17,6 +17,7 @@
 typedef struct DlfContext {
     EbFifo *             dlf_input_fifo_ptr;
     EbFifo *             dlf_output_fifo_ptr;
+    EbFifo *             dlf_feedback_fifo_ptr;
     EbPictureBufferDesc *temp_lf_recon_picture_ptr;
     EbPictureBufferDesc *temp_lf_recon_picture16bit_ptr;
 } DlfContext;
@@ -25,8 +26,11 @@ typedef struct DlfContext {
  * Extern Function Declarations
  **************************************/
 extern EbErrorType dlf_context_ctor(EbThreadContext *  thread_context_ptr,
-                                    const EbEncHandle *enc_handle_ptr, int index);
+                                    const EbEncHandle *enc_handle_ptr, int index,
+                                    int feedback_index);
 
+extern void dlf_job(EbThreadContext *thread_context_ptr,
+                    EbObjectWrapper *enc_dec_results_wrapper_ptr);
 extern void *dlf_kernel(void *input_ptr);
 
 #endif // EbEntropyCodingProcess_h
@@ -23,6 +23,7 @@
 #include "EbSvtAv1ErrorCodes.h"
 #include "EbUtility.h"
 #include "grainSynthesis.h"
+#include "EbPipelineStats.h"
 
 #define FC_SKIP_TX_SR_TH025 125 // Fast cost skip tx search threshold.
 #define FC_SKIP_TX_SR_TH010 110 // Fast cost skip tx search threshold.
@@ -51,6 +52,7 @@ static void enc_dec_context_dctor(EbPtr p) {
     EB_DELETE(obj->inverse_quant_buffer);
     EB_DELETE(obj->input_sample16bit_buffer);
     if (obj->is_md_rate_estimation_ptr_owner) EB_FREE(obj->md_rate_estimation_ptr);
+    EB_FREE(obj->md_rate_estimation_cache);
     EB_FREE_ARRAY(obj->transform_inner_array_ptr);
     EB_FREE_ARRAY(obj);
 }
@@ -93,6 +95,8 @@ EbErrorType enc_dec_context_ctor(EbThreadContext *  thread_context_ptr,
     // MD rate Estimation tables
     EB_MALLOC(context_ptr->md_rate_estimation_ptr, sizeof(MdRateEstimationContext));
     context_ptr->is_md_rate_estimation_ptr_owner = EB_TRUE;
+    EB_MALLOC(context_ptr->md_rate_estimation_cache, sizeof(MdRateEstimationCache));
+    context_ptr->md_rate_estimation_cache->valid = EB_FALSE;
 
     // Prediction Buffer
     {
@@ -178,29 +182,46 @@ static void reset_segmentation_map(SegmentationNeighborMap *segmentation_map) {
 }
 
 /**************************************************
- * Reset Mode Decision Neighbor Arrays
+ * Reset Encode Pass Neighbor Arrays
+ *   The arrays of a tile start at its top left
+ *   corner, the chroma ones in chroma samples.
  *************************************************/
-static void reset_encode_pass_neighbor_arrays(PictureControlSet *pcs_ptr) {
-    neighbor_array_unit_reset(pcs_ptr->ep_intra_luma_mode_neighbor_array);
-    neighbor_array_unit_reset(pcs_ptr->ep_intra_chroma_mode_neighbor_array);
-    neighbor_array_unit_reset(pcs_ptr->ep_mv_neighbor_array);
-    neighbor_array_unit_reset(pcs_ptr->ep_skip_flag_neighbor_array);
-    neighbor_array_unit_reset(pcs_ptr->ep_mode_type_neighbor_array);
-    neighbor_array_unit_reset(pcs_ptr->ep_leaf_depth_neighbor_array);
-    neighbor_array_unit_reset(pcs_ptr->ep_luma_recon_neighbor_array);
-    neighbor_array_unit_reset(pcs_ptr->ep_cb_recon_neighbor_array);
-    neighbor_array_unit_reset(pcs_ptr->ep_cr_recon_neighbor_array);
-    neighbor_array_unit_reset(pcs_ptr->ep_luma_dc_sign_level_coeff_neighbor_array);
-    neighbor_array_unit_reset(pcs_ptr->ep_cb_dc_sign_level_coeff_neighbor_array);
-    neighbor_array_unit_reset(pcs_ptr->ep_cr_dc_sign_level_coeff_neighbor_array);
-    neighbor_array_unit_reset(pcs_ptr->ep_partition_context_neighbor_array);
+static void reset_tile_neighbor_array(NeighborArrayUnit *na_unit_ptr, uint32_t x, uint32_t y) {
+    neighbor_array_unit_reset(na_unit_ptr);
+    neighbor_array_unit_set_origin(na_unit_ptr, x, y);
+}
+
+static void reset_encode_pass_neighbor_arrays(PictureControlSet *pcs_ptr, uint16_t tile_idx) {
+    const TilesInfo *tiles_info = &pcs_ptr->parent_pcs_ptr->av1_cm->tiles_info;
+    const uint32_t   x = tiles_info->tile_col_start_mi[tile_idx % tiles_info->tile_cols]
+                       << MI_SIZE_LOG2;
+    const uint32_t   y = tiles_info->tile_row_start_mi[tile_idx / tiles_info->tile_cols]
+                       << MI_SIZE_LOG2;
+    reset_tile_neighbor_array(pcs_ptr->ep_intra_luma_mode_neighbor_array[tile_idx], x, y);
+    reset_tile_neighbor_array(
+        pcs_ptr->ep_intra_chroma_mode_neighbor_array[tile_idx], x >> 1, y >> 1);
+    reset_tile_neighbor_array(pcs_ptr->ep_mv_neighbor_array[tile_idx], x, y);
+    reset_tile_neighbor_array(pcs_ptr->ep_skip_flag_neighbor_array[tile_idx], x, y);
+    reset_tile_neighbor_array(pcs_ptr->ep_mode_type_neighbor_array[tile_idx], x, y);
+    reset_tile_neighbor_array(pcs_ptr->ep_leaf_depth_neighbor_array[tile_idx], x, y);
+    reset_tile_neighbor_array(pcs_ptr->ep_luma_recon_neighbor_array[tile_idx], x, y);
+    reset_tile_neighbor_array(pcs_ptr->ep_cb_recon_neighbor_array[tile_idx], x >> 1, y >> 1);
+    reset_tile_neighbor_array(pcs_ptr->ep_cr_recon_neighbor_array[tile_idx], x >> 1, y >> 1);
+    reset_tile_neighbor_array(pcs_ptr->ep_luma_dc_sign_level_coeff_neighbor_array[tile_idx], x, y);
+    reset_tile_neighbor_array(
+        pcs_ptr->ep_cb_dc_sign_level_coeff_neighbor_array[tile_idx], x >> 1, y >> 1);
+    reset_tile_neighbor_array(
+        pcs_ptr->ep_cr_dc_sign_level_coeff_neighbor_array[tile_idx], x >> 1, y >> 1);
+    reset_tile_neighbor_array(pcs_ptr->ep_partition_context_neighbor_array[tile_idx], x, y);
     // TODO(Joel): 8-bit ep_luma_recon_neighbor_array (Cb,Cr) when is_16bit==0?
     EbBool is_16bit =
         (EbBool)(pcs_ptr->parent_pcs_ptr->scs_ptr->static_config.encoder_bit_depth > EB_8BIT);
     if (is_16bit) {
-        neighbor_array_unit_reset(pcs_ptr->ep_luma_recon_neighbor_array16bit);
-        neighbor_array_unit_reset(pcs_ptr->ep_cb_recon_neighbor_array16bit);
-        neighbor_array_unit_reset(pcs_ptr->ep_cr_recon_neighbor_array16bit);
+        reset_tile_neighbor_array(pcs_ptr->ep_luma_recon_neighbor_array16bit[tile_idx], x, y);
+        reset_tile_neighbor_array(
+            pcs_ptr->ep_cb_recon_neighbor_array16bit[tile_idx], x >> 1, y >> 1);
+        reset_tile_neighbor_array(
+            pcs_ptr->ep_cr_recon_neighbor_array16bit[tile_idx], x >> 1, y >> 1);
     }
     return;
 }
@@ -209,7 +230,7 @@ static void reset_encode_pass_neighbor_arrays(PictureControlSet *pcs_ptr) {
  * Reset Coding Loop
  **************************************************/
 static void reset_enc_dec(EncDecContext *context_ptr, PictureControlSet *pcs_ptr,
-                          SequenceControlSet *scs_ptr, uint32_t segment_index) {
+                          SequenceControlSet *scs_ptr) {
     context_ptr->is_16bit = (EbBool)(scs_ptr->static_config.encoder_bit_depth > EB_8BIT);
     uint16_t picture_qp   = pcs_ptr->picture_qp;
     context_ptr->qp       = picture_qp;
@@ -238,14 +259,31 @@ static void reset_enc_dec(EncDecContext *context_ptr, PictureControlSet *pcs_ptr
         context_ptr->is_md_rate_estimation_ptr_owner = EB_FALSE;
     }
     context_ptr->md_rate_estimation_ptr = pcs_ptr->md_rate_estimation_array;
-    if (segment_index == 0) {
-        reset_encode_pass_neighbor_arrays(pcs_ptr);
-        reset_segmentation_map(pcs_ptr->segmentation_neighbor_map);
-    }
 
     return;
 }
 
+/******************************************************
+ * EncDec Start Unit
+ *   Resets the neighbor arrays of the tiles of an EncDec
+ *   work unit before its first segment: every tile for
+ *   the picture wavefront, or the tile of the unit with
+ *   tile_parallel. The segmentation map is picture-wide,
+ *   the first unit resets it.
+ ******************************************************/
+static void enc_dec_start_unit(PictureControlSet *pcs_ptr, uint16_t unit_idx) {
+    const TilesInfo *tiles_info = &pcs_ptr->parent_pcs_ptr->av1_cm->tiles_info;
+    const uint16_t   tile_start = pcs_ptr->enc_dec_unit_count > 1 ? unit_idx : 0;
+    const uint16_t   tile_end   = pcs_ptr->enc_dec_unit_count > 1
+                                      ? unit_idx + 1
+                                      : (uint16_t)(tiles_info->tile_cols * tiles_info->tile_rows);
+    for (uint16_t tile_idx = tile_start; tile_idx < tile_end; tile_idx++) {
+        reset_mode_decision_neighbor_arrays(pcs_ptr, tile_idx);
+        reset_encode_pass_neighbor_arrays(pcs_ptr, tile_idx);
+    }
+    if (unit_idx == 0) reset_segmentation_map(pcs_ptr->segmentation_neighbor_map);
+}
+
 /******************************************************
  * EncDec Configure SB
  ******************************************************/
@@ -426,7 +464,9 @@ EbBool assign_enc_dec_segments(EncDecSegments *segmentPtr, uint16_t *segmentInOu
             feedback_task_ptr                      = (EncDecTasks *)wrapper_ptr->object_ptr;
             feedback_task_ptr->input_type          = ENCDEC_TASKS_ENCDEC_INPUT;
             feedback_task_ptr->enc_dec_segment_row = feedback_row_index;
+            feedback_task_ptr->tile_index          = taskPtr->tile_index;
             feedback_task_ptr->pcs_wrapper_ptr     = taskPtr->pcs_wrapper_ptr;
+            wrapper_ptr->numa_node                 = taskPtr->pcs_wrapper_ptr->numa_node;
             eb_post_full_object(wrapper_ptr);
         }
 
@@ -603,492 +643,296 @@ void recon_output(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr) {
     eb_release_mutex(encode_context_ptr->total_number_of_recon_frame_mutex);
 }
 
-void psnr_calculations(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr) {
-    EbBool is_16bit = (scs_ptr->static_config.encoder_bit_depth > EB_8BIT);
-
-    if (!is_16bit) {
-        EbPictureBufferDesc *recon_ptr;
-
-        if (pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE)
-            recon_ptr = ((EbReferenceObject *)
-                             pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)
-                            ->reference_picture;
-        else
-            recon_ptr = pcs_ptr->recon_picture_ptr;
-
-        EbPictureBufferDesc *input_picture_ptr =
-            (EbPictureBufferDesc *)pcs_ptr->parent_pcs_ptr->enhanced_picture_ptr;
-
-        uint64_t sse_total[3] = {0};
-        uint32_t column_index;
-        uint32_t row_index           = 0;
-        uint64_t residual_distortion = 0;
-        EbByte   input_buffer;
-        EbByte   recon_coeff_buffer;
-
-        EbByte buffer_y;
-        EbByte buffer_cb;
-        EbByte buffer_cr;
-
-        // if current source picture was temporally filtered, use an alternative buffer which stores
-        // the original source picture
-        if (pcs_ptr->parent_pcs_ptr->temporal_filtering_on == EB_TRUE) {
-            buffer_y  = pcs_ptr->parent_pcs_ptr->save_enhanced_picture_ptr[0];
-            buffer_cb = pcs_ptr->parent_pcs_ptr->save_enhanced_picture_ptr[1];
-            buffer_cr = pcs_ptr->parent_pcs_ptr->save_enhanced_picture_ptr[2];
-        } else {
-            buffer_y  = input_picture_ptr->buffer_y;
-            buffer_cb = input_picture_ptr->buffer_cb;
-            buffer_cr = input_picture_ptr->buffer_cr;
-        }
-
-        recon_coeff_buffer = &(
-            (recon_ptr->buffer_y)[recon_ptr->origin_x + recon_ptr->origin_y * recon_ptr->stride_y]);
-        input_buffer = &(buffer_y[input_picture_ptr->origin_x +
-                                  input_picture_ptr->origin_y * input_picture_ptr->stride_y]);
+static uint64_t sse_rows_8bit(const uint8_t *input_buffer, uint32_t input_stride,
+                              const uint8_t *recon_buffer, uint32_t recon_stride, uint32_t width,
+                              uint32_t height) {
+    uint64_t residual_distortion = 0;
+    for (uint32_t row_index = 0; row_index < height; ++row_index) {
+        for (uint32_t column_index = 0; column_index < width; ++column_index)
+            residual_distortion +=
+                (int64_t)SQR((int64_t)(input_buffer[column_index]) - (recon_buffer[column_index]));
+        input_buffer += input_stride;
+        recon_buffer += recon_stride;
+    }
+    return residual_distortion;
+}
 
-        residual_distortion = 0;
+static uint64_t sse_rows_10bit(const uint8_t *input_buffer, uint32_t input_stride,
+                               const uint8_t *input_buffer_bit_inc, uint32_t bit_inc_stride,
+                               const uint16_t *recon_buffer, uint32_t recon_stride,
+                               uint32_t width, uint32_t height) {
+    uint64_t residual_distortion = 0;
+    for (uint32_t row_index = 0; row_index < height; ++row_index) {
+        for (uint32_t column_index = 0; column_index < width; ++column_index)
+            residual_distortion +=
+                (int64_t)SQR((int64_t)((((input_buffer[column_index]) << 2) |
+                                        ((input_buffer_bit_inc[column_index] >> 6) & 3))) -
+                             (recon_buffer[column_index]));
+        input_buffer += input_stride;
+        input_buffer_bit_inc += bit_inc_stride;
+        recon_buffer += recon_stride;
+    }
+    return residual_distortion;
+}
 
-        while (row_index < scs_ptr->seq_header.max_frame_height) {
-            column_index = 0;
-            while (column_index < scs_ptr->seq_header.max_frame_width) {
-                residual_distortion += (int64_t)SQR((int64_t)(input_buffer[column_index]) -
-                                                    (recon_coeff_buffer[column_index]));
-                ++column_index;
+// SSE of one block of a ten_bit_format == 1 input, where the 2 LSBs of each 64x64 (32x32 for
+// chroma) block are stored as packed groups of four pixels.
+static uint64_t sse_block_10bit_compressed(const uint8_t * input_buffer, uint32_t input_stride,
+                                           const uint8_t * input_buffer_bit_inc,
+                                           const uint16_t *recon_buffer, uint32_t recon_stride,
+                                           uint32_t sb_width, uint32_t sb_height) {
+    uint64_t       residual_distortion = 0;
+    const uint32_t inn_stride          = sb_width / 4;
+
+    for (uint32_t j = 0; j < sb_height; j++) {
+        for (uint32_t k = 0; k < sb_width / 4; k++) {
+            const uint8_t four_2bit_pels = input_buffer_bit_inc[k + j * inn_stride];
+            for (uint32_t p = 0; p < 4; p++) {
+                const uint8_t  n_bit_pixel = (four_2bit_pels >> (6 - 2 * p)) & 3;
+                const uint16_t out_pixel =
+                    (input_buffer[k * 4 + p + j * input_stride] << 2) | n_bit_pixel;
+                residual_distortion +=
+                    (int64_t)SQR((int64_t)out_pixel -
+                                 (int64_t)recon_buffer[k * 4 + p + j * recon_stride]);
             }
-
-            input_buffer += input_picture_ptr->stride_y;
-            recon_coeff_buffer += recon_ptr->stride_y;
-            ++row_index;
         }
+    }
+    return residual_distortion;
+}
 
-        sse_total[0] = residual_distortion;
-
-        recon_coeff_buffer =
-            &((recon_ptr->buffer_cb)[recon_ptr->origin_x / 2 +
-                                     recon_ptr->origin_y / 2 * recon_ptr->stride_cb]);
-        input_buffer = &(buffer_cb[input_picture_ptr->origin_x / 2 +
-                                   input_picture_ptr->origin_y / 2 * input_picture_ptr->stride_cb]);
-
-        residual_distortion = 0;
-        row_index           = 0;
-        while (row_index < scs_ptr->chroma_height) {
-            column_index = 0;
-            while (column_index < scs_ptr->chroma_width) {
-                residual_distortion += (int64_t)SQR((int64_t)(input_buffer[column_index]) -
-                                                    (recon_coeff_buffer[column_index]));
-                ++column_index;
-            }
+static EbPictureBufferDesc *get_psnr_recon_picture(PictureControlSet *pcs_ptr, EbBool is_16bit) {
+    if (pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE) {
+        EbReferenceObject *ref_obj =
+            (EbReferenceObject *)pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr;
+        return is_16bit ? ref_obj->reference_picture16bit : ref_obj->reference_picture;
+    }
+    return is_16bit ? pcs_ptr->recon_picture16bit_ptr : pcs_ptr->recon_picture_ptr;
+}
 
-            input_buffer += input_picture_ptr->stride_cb;
-            recon_coeff_buffer += recon_ptr->stride_cb;
-            ++row_index;
-        }
+/*
+ * Accumulate into sse_total the per-plane SSE between the source and the final recon over the
+ * luma rows [row_start, row_end) (the matching chroma rows for Cb/Cr). row_start must be a
+ * multiple of 64 and row_end either a multiple of 64 or the frame height, so disjoint bands can
+ * be computed concurrently and summed by psnr_calculations_finish().
+ */
+void psnr_calculations_rows(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr,
+                            uint32_t row_start, uint32_t row_end, uint64_t sse_total[3]) {
+    EbBool               is_16bit  = (scs_ptr->static_config.encoder_bit_depth > EB_8BIT);
+    EbPictureBufferDesc *recon_ptr = get_psnr_recon_picture(pcs_ptr, is_16bit);
+    EbPictureBufferDesc *input_picture_ptr =
+        (EbPictureBufferDesc *)pcs_ptr->parent_pcs_ptr->enhanced_picture_ptr;
+
+    const uint32_t luma_width    = scs_ptr->seq_header.max_frame_width;
+    const uint32_t chroma_width  = scs_ptr->chroma_width;
+    const uint32_t luma_height   = scs_ptr->seq_header.max_frame_height;
+    const uint32_t chroma_height = scs_ptr->chroma_height;
+
+    row_end                          = MIN(row_end, luma_height);
+    const uint32_t chroma_row_start  = row_start >> 1;
+    const uint32_t chroma_row_end    = row_end == luma_height ? chroma_height : row_end >> 1;
+    if (row_start >= row_end) return;
+
+    // if current source picture was temporally filtered, use an alternative buffer which stores
+    // the original source picture
+    const EbBool tf_source = pcs_ptr->parent_pcs_ptr->temporal_filtering_on == EB_TRUE;
+    EbByte       buffer_y  = tf_source ? pcs_ptr->parent_pcs_ptr->save_enhanced_picture_ptr[0]
+                                       : input_picture_ptr->buffer_y;
+    EbByte       buffer_cb = tf_source ? pcs_ptr->parent_pcs_ptr->save_enhanced_picture_ptr[1]
+                                       : input_picture_ptr->buffer_cb;
+    EbByte       buffer_cr = tf_source ? pcs_ptr->parent_pcs_ptr->save_enhanced_picture_ptr[2]
+                                       : input_picture_ptr->buffer_cr;
+
+    const uint32_t input_luma_offset = input_picture_ptr->origin_x +
+                                       (input_picture_ptr->origin_y + row_start) *
+                                           input_picture_ptr->stride_y;
+    const uint32_t input_cb_offset = input_picture_ptr->origin_x / 2 +
+                                     (input_picture_ptr->origin_y / 2 + chroma_row_start) *
+                                         input_picture_ptr->stride_cb;
+    const uint32_t input_cr_offset = input_picture_ptr->origin_x / 2 +
+                                     (input_picture_ptr->origin_y / 2 + chroma_row_start) *
+                                         input_picture_ptr->stride_cr;
 
-        sse_total[1] = residual_distortion;
-
-        recon_coeff_buffer =
-            &((recon_ptr->buffer_cr)[recon_ptr->origin_x / 2 +
-                                     recon_ptr->origin_y / 2 * recon_ptr->stride_cr]);
-        input_buffer        = &(buffer_cr[input_picture_ptr->origin_x / 2 +
-                                   input_picture_ptr->origin_y / 2 * input_picture_ptr->stride_cr]);
-        residual_distortion = 0;
-        row_index           = 0;
-
-        while (row_index < scs_ptr->chroma_height) {
-            column_index = 0;
-            while (column_index < scs_ptr->chroma_width) {
-                residual_distortion += (int64_t)SQR((int64_t)(input_buffer[column_index]) -
-                                                    (recon_coeff_buffer[column_index]));
-                ++column_index;
+    if (!is_16bit) {
+        sse_total[0] += sse_rows_8bit(
+            buffer_y + input_luma_offset,
+            input_picture_ptr->stride_y,
+            recon_ptr->buffer_y + recon_ptr->origin_x +
+                (recon_ptr->origin_y + row_start) * recon_ptr->stride_y,
+            recon_ptr->stride_y,
+            luma_width,
+            row_end - row_start);
+        sse_total[1] += sse_rows_8bit(
+            buffer_cb + input_cb_offset,
+            input_picture_ptr->stride_cb,
+            recon_ptr->buffer_cb + recon_ptr->origin_x / 2 +
+                (recon_ptr->origin_y / 2 + chroma_row_start) * recon_ptr->stride_cb,
+            recon_ptr->stride_cb,
+            chroma_width,
+            chroma_row_end - chroma_row_start);
+        sse_total[2] += sse_rows_8bit(
+            buffer_cr + input_cr_offset,
+            input_picture_ptr->stride_cr,
+            recon_ptr->buffer_cr + recon_ptr->origin_x / 2 +
+                (recon_ptr->origin_y / 2 + chroma_row_start) * recon_ptr->stride_cr,
+            recon_ptr->stride_cr,
+            chroma_width,
+            chroma_row_end - chroma_row_start);
+    } else if (scs_ptr->static_config.ten_bit_format == 1) {
+        const uint32_t pic_width_in_sb   = (luma_width + 64 - 1) / 64;
+        const uint32_t luma_2bit_width   = luma_width / 4;
+        const uint32_t chroma_2bit_width = luma_width / 8;
+        const uint32_t sb_row_start      = row_start / 64;
+        const uint32_t sb_row_end        = (row_end + 64 - 1) / 64;
+
+        EbByte input_buffer_org =
+            input_picture_ptr->buffer_y + input_picture_ptr->origin_x +
+            input_picture_ptr->origin_y * input_picture_ptr->stride_y;
+        EbByte input_buffer_org_u =
+            input_picture_ptr->buffer_cb + input_picture_ptr->origin_x / 2 +
+            input_picture_ptr->origin_y / 2 * input_picture_ptr->stride_cb;
+        EbByte input_buffer_org_v =
+            input_picture_ptr->buffer_cr + input_picture_ptr->origin_x / 2 +
+            input_picture_ptr->origin_y / 2 * input_picture_ptr->stride_cr;
+        uint16_t *recon_buffer_org = (uint16_t *)recon_ptr->buffer_y + recon_ptr->origin_x +
+                                     recon_ptr->origin_y * recon_ptr->stride_y;
+        uint16_t *recon_buffer_org_u = (uint16_t *)recon_ptr->buffer_cb + recon_ptr->origin_x / 2 +
+                                       recon_ptr->origin_y / 2 * recon_ptr->stride_cb;
+        uint16_t *recon_buffer_org_v = (uint16_t *)recon_ptr->buffer_cr + recon_ptr->origin_x / 2 +
+                                       recon_ptr->origin_y / 2 * recon_ptr->stride_cr;
+
+        for (uint32_t sb_num_in_height = sb_row_start; sb_num_in_height < sb_row_end;
+             ++sb_num_in_height) {
+            for (uint32_t sb_num_in_width = 0; sb_num_in_width < pic_width_in_sb;
+                 ++sb_num_in_width) {
+                uint32_t tb_origin_x = sb_num_in_width * 64;
+                uint32_t tb_origin_y = sb_num_in_height * 64;
+                uint32_t sb_width =
+                    (luma_width - tb_origin_x) < 64 ? (luma_width - tb_origin_x) : 64;
+                uint32_t sb_height =
+                    (luma_height - tb_origin_y) < 64 ? (luma_height - tb_origin_y) : 64;
+
+                sse_total[0] += sse_block_10bit_compressed(
+                    input_buffer_org + tb_origin_y * input_picture_ptr->stride_y + tb_origin_x,
+                    input_picture_ptr->stride_y,
+                    input_picture_ptr->buffer_bit_inc_y + tb_origin_y * luma_2bit_width +
+                        (tb_origin_x / 4) * sb_height,
+                    recon_buffer_org + tb_origin_y * recon_ptr->stride_y + tb_origin_x,
+                    recon_ptr->stride_y,
+                    sb_width,
+                    sb_height);
+
+                //U+V
+                tb_origin_x = sb_num_in_width * 32;
+                tb_origin_y = sb_num_in_height * 32;
+                sb_width  = (chroma_width - tb_origin_x) < 32 ? (chroma_width - tb_origin_x) : 32;
+                sb_height = (chroma_height - tb_origin_y) < 32 ? (chroma_height - tb_origin_y)
+                                                                : 32;
+
+                sse_total[1] += sse_block_10bit_compressed(
+                    input_buffer_org_u + tb_origin_y * input_picture_ptr->stride_cb + tb_origin_x,
+                    input_picture_ptr->stride_cb,
+                    input_picture_ptr->buffer_bit_inc_cb + tb_origin_y * chroma_2bit_width +
+                        (tb_origin_x / 4) * sb_height,
+                    recon_buffer_org_u + tb_origin_y * recon_ptr->stride_cb + tb_origin_x,
+                    recon_ptr->stride_cb,
+                    sb_width,
+                    sb_height);
+                sse_total[2] += sse_block_10bit_compressed(
+                    input_buffer_org_v + tb_origin_y * input_picture_ptr->stride_cr + tb_origin_x,
+                    input_picture_ptr->stride_cr,
+                    input_picture_ptr->buffer_bit_inc_cr + tb_origin_y * chroma_2bit_width +
+                        (tb_origin_x / 4) * sb_height,
+                    recon_buffer_org_v + tb_origin_y * recon_ptr->stride_cr + tb_origin_x,
+                    recon_ptr->stride_cr,
+                    sb_width,
+                    sb_height);
             }
-
-            input_buffer += input_picture_ptr->stride_cr;
-            recon_coeff_buffer += recon_ptr->stride_cr;
-            ++row_index;
-        }
-
-        sse_total[2]                      = residual_distortion;
-        pcs_ptr->parent_pcs_ptr->luma_sse = (uint32_t)sse_total[0];
-        pcs_ptr->parent_pcs_ptr->cb_sse   = (uint32_t)sse_total[1];
-        pcs_ptr->parent_pcs_ptr->cr_sse   = (uint32_t)sse_total[2];
-
-        if (pcs_ptr->parent_pcs_ptr->temporal_filtering_on == EB_TRUE) {
-            EB_FREE_ARRAY(buffer_y);
-            EB_FREE_ARRAY(buffer_cb);
-            EB_FREE_ARRAY(buffer_cr);
         }
     } else {
-        EbPictureBufferDesc *recon_ptr;
-
-        if (pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE)
-            recon_ptr = ((EbReferenceObject *)
-                             pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)
-                            ->reference_picture16bit;
-        else
-            recon_ptr = pcs_ptr->recon_picture16bit_ptr;
-        EbPictureBufferDesc *input_picture_ptr =
-            (EbPictureBufferDesc *)pcs_ptr->parent_pcs_ptr->enhanced_picture_ptr;
-
-        uint64_t  sse_total[3] = {0};
-        uint32_t  column_index;
-        uint32_t  row_index           = 0;
-        uint64_t  residual_distortion = 0;
-        EbByte    input_buffer;
-        EbByte    input_buffer_bit_inc;
-        uint16_t *recon_coeff_buffer;
-
-        if (scs_ptr->static_config.ten_bit_format == 1) {
-            const uint32_t luma_width       = scs_ptr->seq_header.max_frame_width;
-            const uint32_t luma_height      = scs_ptr->seq_header.max_frame_height;
-            const uint32_t chroma_width     = scs_ptr->chroma_width;
-            const uint32_t pic_width_in_sb  = (luma_width + 64 - 1) / 64;
-            const uint32_t pic_height_in_sb = (luma_height + 64 - 1) / 64;
-            const uint32_t luma_2bit_width  = luma_width / 4;
-            const uint32_t chroma_height    = luma_height / 2;
-            const uint32_t chroma_2bit_width  = luma_width / 8;
-            uint32_t       sb_num_in_height, sb_num_in_width;
-
-            EbByte input_buffer_org =
-                &((input_picture_ptr
-                       ->buffer_y)[input_picture_ptr->origin_x +
-                                   input_picture_ptr->origin_y * input_picture_ptr->stride_y]);
-            uint16_t *recon_buffer_org = (uint16_t *)(&(
-                (recon_ptr->buffer_y)[(recon_ptr->origin_x << is_16bit) +
-                                      (recon_ptr->origin_y << is_16bit) * recon_ptr->stride_y]));
-            ;
-
-            EbByte input_buffer_org_u = &(
-                (input_picture_ptr
-                     ->buffer_cb)[input_picture_ptr->origin_x / 2 +
-                                  input_picture_ptr->origin_y / 2 * input_picture_ptr->stride_cb]);
-            ;
-            uint16_t *recon_buffer_org_u = recon_coeff_buffer =
-                (uint16_t *)(&((recon_ptr->buffer_cb)[(recon_ptr->origin_x << is_16bit) / 2 +
-                                                      (recon_ptr->origin_y << is_16bit) / 2 *
-                                                          recon_ptr->stride_cb]));
-            ;
-
-            EbByte input_buffer_org_v = &(
-                (input_picture_ptr
-                     ->buffer_cr)[input_picture_ptr->origin_x / 2 +
-                                  input_picture_ptr->origin_y / 2 * input_picture_ptr->stride_cr]);
-            ;
-            uint16_t *recon_buffer_org_v = recon_coeff_buffer =
-                (uint16_t *)(&((recon_ptr->buffer_cr)[(recon_ptr->origin_x << is_16bit) / 2 +
-                                                      (recon_ptr->origin_y << is_16bit) / 2 *
-                                                          recon_ptr->stride_cr]));
-            ;
-
-            residual_distortion            = 0;
-            uint64_t residual_distortion_u = 0;
-            uint64_t residual_distortion_v = 0;
-
-            for (sb_num_in_height = 0; sb_num_in_height < pic_height_in_sb; ++sb_num_in_height) {
-                for (sb_num_in_width = 0; sb_num_in_width < pic_width_in_sb; ++sb_num_in_width) {
-                    uint32_t tb_origin_x = sb_num_in_width * 64;
-                    uint32_t tb_origin_y = sb_num_in_height * 64;
-                    uint32_t sb_width =
-                        (luma_width - tb_origin_x) < 64 ? (luma_width - tb_origin_x) : 64;
-                    uint32_t sb_height =
-                        (luma_height - tb_origin_y) < 64 ? (luma_height - tb_origin_y) : 64;
-
-                    input_buffer =
-                        input_buffer_org + tb_origin_y * input_picture_ptr->stride_y + tb_origin_x;
-                    input_buffer_bit_inc = input_picture_ptr->buffer_bit_inc_y +
-                                           tb_origin_y * luma_2bit_width +
-                                           (tb_origin_x / 4) * sb_height;
-                    recon_coeff_buffer =
-                        recon_buffer_org + tb_origin_y * recon_ptr->stride_y + tb_origin_x;
-
-                    uint64_t j, k;
-                    uint16_t out_pixel;
-                    uint8_t  n_bit_pixel;
-                    uint8_t  four_2bit_pels;
-                    uint32_t inn_stride = sb_width / 4;
-
-                    for (j = 0; j < sb_height; j++) {
-                        for (k = 0; k < sb_width / 4; k++) {
-                            four_2bit_pels = input_buffer_bit_inc[k + j * inn_stride];
-
-                            n_bit_pixel = (four_2bit_pels >> 6) & 3;
-                            out_pixel   = input_buffer[k * 4 + 0 + j * input_picture_ptr->stride_y]
-                                        << 2;
-                            out_pixel = out_pixel | n_bit_pixel;
-                            residual_distortion += (int64_t)SQR(
-                                (int64_t)out_pixel -
-                                (int64_t)recon_coeff_buffer[k * 4 + 0 + j * recon_ptr->stride_y]);
-
-                            n_bit_pixel = (four_2bit_pels >> 4) & 3;
-                            out_pixel   = input_buffer[k * 4 + 1 + j * input_picture_ptr->stride_y]
-                                        << 2;
-                            out_pixel = out_pixel | n_bit_pixel;
-                            residual_distortion += (int64_t)SQR(
-                                (int64_t)out_pixel -
-                                (int64_t)recon_coeff_buffer[k * 4 + 1 + j * recon_ptr->stride_y]);
-
-                            n_bit_pixel = (four_2bit_pels >> 2) & 3;
-                            out_pixel   = input_buffer[k * 4 + 2 + j * input_picture_ptr->stride_y]
-                                        << 2;
-                            out_pixel = out_pixel | n_bit_pixel;
-                            residual_distortion += (int64_t)SQR(
-                                (int64_t)out_pixel -
-                                (int64_t)recon_coeff_buffer[k * 4 + 2 + j * recon_ptr->stride_y]);
-
-                            n_bit_pixel = (four_2bit_pels >> 0) & 3;
-                            out_pixel   = input_buffer[k * 4 + 3 + j * input_picture_ptr->stride_y]
-                                        << 2;
-                            out_pixel = out_pixel | n_bit_pixel;
-                            residual_distortion += (int64_t)SQR(
-                                (int64_t)out_pixel -
-                                (int64_t)recon_coeff_buffer[k * 4 + 3 + j * recon_ptr->stride_y]);
-                        }
-                    }
-
-                    //U+V
-
-                    tb_origin_x = sb_num_in_width * 32;
-                    tb_origin_y = sb_num_in_height * 32;
-                    sb_width =
-                        (chroma_width - tb_origin_x) < 32 ? (chroma_width - tb_origin_x) : 32;
-                    sb_height =
-                        (chroma_height - tb_origin_y) < 32 ? (chroma_height - tb_origin_y) : 32;
-
-                    inn_stride = sb_width / 4;
-
-                    input_buffer = input_buffer_org_u + tb_origin_y * input_picture_ptr->stride_cb +
-                                   tb_origin_x;
-
-                    input_buffer_bit_inc = input_picture_ptr->buffer_bit_inc_cb +
-                                           tb_origin_y * chroma_2bit_width +
-                                           (tb_origin_x / 4) * sb_height;
-
-                    recon_coeff_buffer =
-                        recon_buffer_org_u + tb_origin_y * recon_ptr->stride_cb + tb_origin_x;
-
-                    for (j = 0; j < sb_height; j++) {
-                        for (k = 0; k < sb_width / 4; k++) {
-                            four_2bit_pels = input_buffer_bit_inc[k + j * inn_stride];
-
-                            n_bit_pixel = (four_2bit_pels >> 6) & 3;
-                            out_pixel   = input_buffer[k * 4 + 0 + j * input_picture_ptr->stride_cb]
-                                        << 2;
-                            out_pixel = out_pixel | n_bit_pixel;
-                            residual_distortion_u += (int64_t)SQR(
-                                (int64_t)out_pixel -
-                                (int64_t)recon_coeff_buffer[k * 4 + 0 + j * recon_ptr->stride_cb]);
-
-                            n_bit_pixel = (four_2bit_pels >> 4) & 3;
-                            out_pixel   = input_buffer[k * 4 + 1 + j * input_picture_ptr->stride_cb]
-                                        << 2;
-                            out_pixel = out_pixel | n_bit_pixel;
-                            residual_distortion_u += (int64_t)SQR(
-                                (int64_t)out_pixel -
-                                (int64_t)recon_coeff_buffer[k * 4 + 1 + j * recon_ptr->stride_cb]);
-
-                            n_bit_pixel = (four_2bit_pels >> 2) & 3;
-                            out_pixel   = input_buffer[k * 4 + 2 + j * input_picture_ptr->stride_cb]
-                                        << 2;
-                            out_pixel = out_pixel | n_bit_pixel;
-                            residual_distortion_u += (int64_t)SQR(
-                                (int64_t)out_pixel -
-                                (int64_t)recon_coeff_buffer[k * 4 + 2 + j * recon_ptr->stride_cb]);
-
-                            n_bit_pixel = (four_2bit_pels >> 0) & 3;
-                            out_pixel   = input_buffer[k * 4 + 3 + j * input_picture_ptr->stride_cb]
-                                        << 2;
-                            out_pixel = out_pixel | n_bit_pixel;
-                            residual_distortion_u += (int64_t)SQR(
-                                (int64_t)out_pixel -
-                                (int64_t)recon_coeff_buffer[k * 4 + 3 + j * recon_ptr->stride_cb]);
-                        }
-                    }
-
-                    input_buffer = input_buffer_org_v + tb_origin_y * input_picture_ptr->stride_cr +
-                                   tb_origin_x;
-                    input_buffer_bit_inc = input_picture_ptr->buffer_bit_inc_cr +
-                                           tb_origin_y * chroma_2bit_width +
-                                           (tb_origin_x / 4) * sb_height;
-                    recon_coeff_buffer =
-                        recon_buffer_org_v + tb_origin_y * recon_ptr->stride_cr + tb_origin_x;
-
-                    for (j = 0; j < sb_height; j++) {
-                        for (k = 0; k < sb_width / 4; k++) {
-                            four_2bit_pels = input_buffer_bit_inc[k + j * inn_stride];
-
-                            n_bit_pixel = (four_2bit_pels >> 6) & 3;
-                            out_pixel   = input_buffer[k * 4 + 0 + j * input_picture_ptr->stride_cr]
-                                        << 2;
-                            out_pixel = out_pixel | n_bit_pixel;
-                            residual_distortion_v += (int64_t)SQR(
-                                (int64_t)out_pixel -
-                                (int64_t)recon_coeff_buffer[k * 4 + 0 + j * recon_ptr->stride_cr]);
-
-                            n_bit_pixel = (four_2bit_pels >> 4) & 3;
-                            out_pixel   = input_buffer[k * 4 + 1 + j * input_picture_ptr->stride_cr]
-                                        << 2;
-                            out_pixel = out_pixel | n_bit_pixel;
-                            residual_distortion_v += (int64_t)SQR(
-                                (int64_t)out_pixel -
-                                (int64_t)recon_coeff_buffer[k * 4 + 1 + j * recon_ptr->stride_cr]);
-
-                            n_bit_pixel = (four_2bit_pels >> 2) & 3;
-                            out_pixel   = input_buffer[k * 4 + 2 + j * input_picture_ptr->stride_cr]
-                                        << 2;
-                            out_pixel = out_pixel | n_bit_pixel;
-                            residual_distortion_v += (int64_t)SQR(
-                                (int64_t)out_pixel -
-                                (int64_t)recon_coeff_buffer[k * 4 + 2 + j * recon_ptr->stride_cr]);
-
-                            n_bit_pixel = (four_2bit_pels >> 0) & 3;
-                            out_pixel   = input_buffer[k * 4 + 3 + j * input_picture_ptr->stride_cr]
-                                        << 2;
-                            out_pixel = out_pixel | n_bit_pixel;
-                            residual_distortion_v += (int64_t)SQR(
-                                (int64_t)out_pixel -
-                                (int64_t)recon_coeff_buffer[k * 4 + 3 + j * recon_ptr->stride_cr]);
-                        }
-                    }
-                }
-            }
-
-            sse_total[0] = residual_distortion;
-            sse_total[1] = residual_distortion_u;
-            sse_total[2] = residual_distortion_v;
-        } else {
-            recon_coeff_buffer = (uint16_t *)(&(
-                (recon_ptr->buffer_y)[(recon_ptr->origin_x << is_16bit) +
-                                      (recon_ptr->origin_y << is_16bit) * recon_ptr->stride_y]));
-
-            // if current source picture was temporally filtered, use an alternative buffer which stores
-            // the original source picture
-            EbByte buffer_y, buffer_bit_inc_y;
-            EbByte buffer_cb, buffer_bit_inc_cb;
-            EbByte buffer_cr, buffer_bit_inc_cr;
-
-            if (pcs_ptr->parent_pcs_ptr->temporal_filtering_on == EB_TRUE) {
-                buffer_y          = pcs_ptr->parent_pcs_ptr->save_enhanced_picture_ptr[0];
-                buffer_bit_inc_y  = pcs_ptr->parent_pcs_ptr->save_enhanced_picture_bit_inc_ptr[0];
-                buffer_cb         = pcs_ptr->parent_pcs_ptr->save_enhanced_picture_ptr[1];
-                buffer_bit_inc_cb = pcs_ptr->parent_pcs_ptr->save_enhanced_picture_bit_inc_ptr[1];
-                buffer_cr         = pcs_ptr->parent_pcs_ptr->save_enhanced_picture_ptr[2];
-                buffer_bit_inc_cr = pcs_ptr->parent_pcs_ptr->save_enhanced_picture_bit_inc_ptr[2];
-            } else {
-                buffer_y          = input_picture_ptr->buffer_y;
-                buffer_bit_inc_y  = input_picture_ptr->buffer_bit_inc_y;
-                buffer_cb         = input_picture_ptr->buffer_cb;
-                buffer_bit_inc_cb = input_picture_ptr->buffer_bit_inc_cb;
-                buffer_cr         = input_picture_ptr->buffer_cr;
-                buffer_bit_inc_cr = input_picture_ptr->buffer_bit_inc_cr;
-            }
-
-            input_buffer         = &((buffer_y)[input_picture_ptr->origin_x +
-                                        input_picture_ptr->origin_y * input_picture_ptr->stride_y]);
-            input_buffer_bit_inc = &((buffer_bit_inc_y)[input_picture_ptr->origin_x +
-                                                        input_picture_ptr->origin_y *
-                                                            input_picture_ptr->stride_bit_inc_y]);
-
-            residual_distortion = 0;
-
-            while (row_index < scs_ptr->seq_header.max_frame_height) {
-                column_index = 0;
-                while (column_index < scs_ptr->seq_header.max_frame_width) {
-                    residual_distortion +=
-                        (int64_t)SQR((int64_t)((((input_buffer[column_index]) << 2) |
-                                                ((input_buffer_bit_inc[column_index] >> 6) & 3))) -
-                                     (recon_coeff_buffer[column_index]));
-
-                    ++column_index;
-                }
-
-                input_buffer += input_picture_ptr->stride_y;
-                input_buffer_bit_inc += input_picture_ptr->stride_bit_inc_y;
-                recon_coeff_buffer += recon_ptr->stride_y;
-                ++row_index;
-            }
-
-            sse_total[0] = residual_distortion;
-
-            recon_coeff_buffer =
-                (uint16_t *)(&((recon_ptr->buffer_cb)[(recon_ptr->origin_x << is_16bit) / 2 +
-                                                      (recon_ptr->origin_y << is_16bit) / 2 *
-                                                          recon_ptr->stride_cb]));
-            input_buffer =
-                &((buffer_cb)[input_picture_ptr->origin_x / 2 +
-                              input_picture_ptr->origin_y / 2 * input_picture_ptr->stride_cb]);
-            input_buffer_bit_inc = &((buffer_bit_inc_cb)[input_picture_ptr->origin_x / 2 +
-                                                         input_picture_ptr->origin_y / 2 *
-                                                             input_picture_ptr->stride_bit_inc_cb]);
-
-            residual_distortion = 0;
-            row_index           = 0;
-            while (row_index < scs_ptr->chroma_height) {
-                column_index = 0;
-                while (column_index < scs_ptr->chroma_width) {
-                    residual_distortion +=
-                        (int64_t)SQR((int64_t)((((input_buffer[column_index]) << 2) |
-                                                ((input_buffer_bit_inc[column_index] >> 6) & 3))) -
-                                     (recon_coeff_buffer[column_index]));
-                    ++column_index;
-                }
-
-                input_buffer += input_picture_ptr->stride_cb;
-                input_buffer_bit_inc += input_picture_ptr->stride_bit_inc_cb;
-                recon_coeff_buffer += recon_ptr->stride_cb;
-                ++row_index;
-            }
-
-            sse_total[1] = residual_distortion;
-
-            recon_coeff_buffer =
-                (uint16_t *)(&((recon_ptr->buffer_cr)[(recon_ptr->origin_x << is_16bit) / 2 +
-                                                      (recon_ptr->origin_y << is_16bit) / 2 *
-                                                          recon_ptr->stride_cr]));
-            input_buffer =
-                &((buffer_cr)[input_picture_ptr->origin_x / 2 +
-                              input_picture_ptr->origin_y / 2 * input_picture_ptr->stride_cr]);
-            input_buffer_bit_inc = &((buffer_bit_inc_cr)[input_picture_ptr->origin_x / 2 +
-                                                         input_picture_ptr->origin_y / 2 *
-                                                             input_picture_ptr->stride_bit_inc_cr]);
-
-            residual_distortion = 0;
-            row_index           = 0;
-
-            while (row_index < scs_ptr->chroma_height) {
-                column_index = 0;
-                while (column_index < scs_ptr->chroma_width) {
-                    residual_distortion +=
-                        (int64_t)SQR((int64_t)((((input_buffer[column_index]) << 2) |
-                                                ((input_buffer_bit_inc[column_index] >> 6) & 3))) -
-                                     (recon_coeff_buffer[column_index]));
-                    ++column_index;
-                }
-
-                input_buffer += input_picture_ptr->stride_cr;
-                input_buffer_bit_inc += input_picture_ptr->stride_bit_inc_cr;
-                recon_coeff_buffer += recon_ptr->stride_cr;
-                ++row_index;
-            }
+        EbByte buffer_bit_inc_y  = tf_source
+                                      ? pcs_ptr->parent_pcs_ptr->save_enhanced_picture_bit_inc_ptr[0]
+                                      : input_picture_ptr->buffer_bit_inc_y;
+        EbByte buffer_bit_inc_cb = tf_source
+                                       ? pcs_ptr->parent_pcs_ptr->save_enhanced_picture_bit_inc_ptr[1]
+                                       : input_picture_ptr->buffer_bit_inc_cb;
+        EbByte buffer_bit_inc_cr = tf_source
+                                       ? pcs_ptr->parent_pcs_ptr->save_enhanced_picture_bit_inc_ptr[2]
+                                       : input_picture_ptr->buffer_bit_inc_cr;
+
+        sse_total[0] += sse_rows_10bit(
+            buffer_y + input_luma_offset,
+            input_picture_ptr->stride_y,
+            buffer_bit_inc_y + input_picture_ptr->origin_x +
+                (input_picture_ptr->origin_y + row_start) * input_picture_ptr->stride_bit_inc_y,
+            input_picture_ptr->stride_bit_inc_y,
+            (uint16_t *)recon_ptr->buffer_y + recon_ptr->origin_x +
+                (recon_ptr->origin_y + row_start) * recon_ptr->stride_y,
+            recon_ptr->stride_y,
+            luma_width,
+            row_end - row_start);
+        sse_total[1] += sse_rows_10bit(
+            buffer_cb + input_cb_offset,
+            input_picture_ptr->stride_cb,
+            buffer_bit_inc_cb + input_picture_ptr->origin_x / 2 +
+                (input_picture_ptr->origin_y / 2 + chroma_row_start) *
+                    input_picture_ptr->stride_bit_inc_cb,
+            input_picture_ptr->stride_bit_inc_cb,
+            (uint16_t *)recon_ptr->buffer_cb + recon_ptr->origin_x / 2 +
+                (recon_ptr->origin_y / 2 + chroma_row_start) * recon_ptr->stride_cb,
+            recon_ptr->stride_cb,
+            chroma_width,
+            chroma_row_end - chroma_row_start);
+        sse_total[2] += sse_rows_10bit(
+            buffer_cr + input_cr_offset,
+            input_picture_ptr->stride_cr,
+            buffer_bit_inc_cr + input_picture_ptr->origin_x / 2 +
+                (input_picture_ptr->origin_y / 2 + chroma_row_start) *
+                    input_picture_ptr->stride_bit_inc_cr,
+            input_picture_ptr->stride_bit_inc_cr,
+            (uint16_t *)recon_ptr->buffer_cr + recon_ptr->origin_x / 2 +
+                (recon_ptr->origin_y / 2 + chroma_row_start) * recon_ptr->stride_cr,
+            recon_ptr->stride_cr,
+            chroma_width,
+            chroma_row_end - chroma_row_start);
+    }
+}
 
-            sse_total[2] = residual_distortion;
+/*
+ * Store the frame SSE summed over all bands and release the copy of the source that was kept
+ * for temporally filtered pictures.
+ */
+void psnr_calculations_finish(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr,
+                              const uint64_t sse_total[3]) {
+    EbBool is_16bit = (scs_ptr->static_config.encoder_bit_depth > EB_8BIT);
 
-            if (pcs_ptr->parent_pcs_ptr->temporal_filtering_on == EB_TRUE) {
-                EB_FREE_ARRAY(buffer_y);
-                EB_FREE_ARRAY(buffer_cb);
-                EB_FREE_ARRAY(buffer_cr);
-                EB_FREE_ARRAY(buffer_bit_inc_y);
-                EB_FREE_ARRAY(buffer_bit_inc_cb);
-                EB_FREE_ARRAY(buffer_bit_inc_cr);
-            }
+    pcs_ptr->parent_pcs_ptr->luma_sse = (uint32_t)sse_total[0];
+    pcs_ptr->parent_pcs_ptr->cb_sse   = (uint32_t)sse_total[1];
+    pcs_ptr->parent_pcs_ptr->cr_sse   = (uint32_t)sse_total[2];
+
+    if (pcs_ptr->parent_pcs_ptr->temporal_filtering_on == EB_TRUE) {
+        if (!is_16bit) {
+            EB_FREE_ARRAY(pcs_ptr->parent_pcs_ptr->save_enhanced_picture_ptr[0]);
+            EB_FREE_ARRAY(pcs_ptr->parent_pcs_ptr->save_enhanced_picture_ptr[1]);
+            EB_FREE_ARRAY(pcs_ptr->parent_pcs_ptr->save_enhanced_picture_ptr[2]);
+        } else if (scs_ptr->static_config.ten_bit_format != 1) {
+            EB_FREE_ARRAY(pcs_ptr->parent_pcs_ptr->save_enhanced_picture_ptr[0]);
+            EB_FREE_ARRAY(pcs_ptr->parent_pcs_ptr->save_enhanced_picture_ptr[1]);
+            EB_FREE_ARRAY(pcs_ptr->parent_pcs_ptr->save_enhanced_picture_ptr[2]);
+            EB_FREE_ARRAY(pcs_ptr->parent_pcs_ptr->save_enhanced_picture_bit_inc_ptr[0]);
+            EB_FREE_ARRAY(pcs_ptr->parent_pcs_ptr->save_enhanced_picture_bit_inc_ptr[1]);
+            EB_FREE_ARRAY(pcs_ptr->parent_pcs_ptr->save_enhanced_picture_bit_inc_ptr[2]);
         }
-
-        pcs_ptr->parent_pcs_ptr->luma_sse = (uint32_t)sse_total[0];
-        pcs_ptr->parent_pcs_ptr->cb_sse   = (uint32_t)sse_total[1];
-        pcs_ptr->parent_pcs_ptr->cr_sse   = (uint32_t)sse_total[2];
     }
 }
 
-void pad_ref_and_set_flags(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr) {
+/*
+ * Pad the reference picture horizontally over the luma rows [row_start, row_end) (the matching
+ * chroma rows for Cb/Cr); for 16bit references the padded rows are also unpacked to the 8bit +
+ * 2bit planes used by MD. Disjoint bands can run concurrently; pad_ref_border() then fills the
+ * vertical padding.
+ */
+void pad_ref_rows(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr, uint32_t row_start,
+                  uint32_t row_end) {
     EbReferenceObject *reference_object =
         (EbReferenceObject *)pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr;
     EbPictureBufferDesc *ref_pic_ptr = (EbPictureBufferDesc *)reference_object->reference_picture;
@@ -1096,86 +940,195 @@ void pad_ref_and_set_flags(PictureControlSet *pcs_ptr, SequenceControlSet *scs_p
         (EbPictureBufferDesc *)reference_object->reference_picture16bit;
     EbBool is_16bit = (scs_ptr->static_config.encoder_bit_depth > EB_8BIT);
 
+    EbPictureBufferDesc *pic_ptr = is_16bit ? ref_pic_16bit_ptr : ref_pic_ptr;
+    row_end                      = MIN(row_end, pic_ptr->height);
+    if (row_start >= row_end) return;
+    const uint32_t chroma_row_start = row_start >> 1;
+    const uint32_t chroma_row_count =
+        (row_end == pic_ptr->height ? pic_ptr->height >> 1 : row_end >> 1) - chroma_row_start;
+
     if (!is_16bit) {
         // Y samples
-        generate_padding(ref_pic_ptr->buffer_y,
-                         ref_pic_ptr->stride_y,
-                         ref_pic_ptr->width,
-                         ref_pic_ptr->height,
-                         ref_pic_ptr->origin_x,
-                         ref_pic_ptr->origin_y);
+        generate_padding_rows(ref_pic_ptr->buffer_y,
+                              ref_pic_ptr->stride_y,
+                              ref_pic_ptr->width,
+                              ref_pic_ptr->origin_x,
+                              ref_pic_ptr->origin_y,
+                              row_start,
+                              row_end - row_start);
 
         // Cb samples
-        generate_padding(ref_pic_ptr->buffer_cb,
-                         ref_pic_ptr->stride_cb,
-                         ref_pic_ptr->width >> 1,
-                         ref_pic_ptr->height >> 1,
-                         ref_pic_ptr->origin_x >> 1,
-                         ref_pic_ptr->origin_y >> 1);
+        generate_padding_rows(ref_pic_ptr->buffer_cb,
+                              ref_pic_ptr->stride_cb,
+                              ref_pic_ptr->width >> 1,
+                              ref_pic_ptr->origin_x >> 1,
+                              ref_pic_ptr->origin_y >> 1,
+                              chroma_row_start,
+                              chroma_row_count);
 
         // Cr samples
-        generate_padding(ref_pic_ptr->buffer_cr,
-                         ref_pic_ptr->stride_cr,
-                         ref_pic_ptr->width >> 1,
-                         ref_pic_ptr->height >> 1,
-                         ref_pic_ptr->origin_x >> 1,
-                         ref_pic_ptr->origin_y >> 1);
-    }
-
-    //We need this for MCP
-    if (is_16bit) {
+        generate_padding_rows(ref_pic_ptr->buffer_cr,
+                              ref_pic_ptr->stride_cr,
+                              ref_pic_ptr->width >> 1,
+                              ref_pic_ptr->origin_x >> 1,
+                              ref_pic_ptr->origin_y >> 1,
+                              chroma_row_start,
+                              chroma_row_count);
+    } else {
+        //We need this for MCP
         // Y samples
-        generate_padding16_bit(ref_pic_16bit_ptr->buffer_y,
-                               ref_pic_16bit_ptr->stride_y << 1,
-                               ref_pic_16bit_ptr->width << 1,
-                               ref_pic_16bit_ptr->height,
-                               ref_pic_16bit_ptr->origin_x << 1,
-                               ref_pic_16bit_ptr->origin_y);
+        generate_padding16_bit_rows(ref_pic_16bit_ptr->buffer_y,
+                                    ref_pic_16bit_ptr->stride_y << 1,
+                                    ref_pic_16bit_ptr->width << 1,
+                                    ref_pic_16bit_ptr->origin_x << 1,
+                                    ref_pic_16bit_ptr->origin_y,
+                                    row_start,
+                                    row_end - row_start);
 
         // Cb samples
-        generate_padding16_bit(ref_pic_16bit_ptr->buffer_cb,
-                               ref_pic_16bit_ptr->stride_cb << 1,
-                               ref_pic_16bit_ptr->width,
-                               ref_pic_16bit_ptr->height >> 1,
-                               ref_pic_16bit_ptr->origin_x,
-                               ref_pic_16bit_ptr->origin_y >> 1);
+        generate_padding16_bit_rows(ref_pic_16bit_ptr->buffer_cb,
+                                    ref_pic_16bit_ptr->stride_cb << 1,
+                                    ref_pic_16bit_ptr->width,
+                                    ref_pic_16bit_ptr->origin_x,
+                                    ref_pic_16bit_ptr->origin_y >> 1,
+                                    chroma_row_start,
+                                    chroma_row_count);
 
         // Cr samples
-        generate_padding16_bit(ref_pic_16bit_ptr->buffer_cr,
-                               ref_pic_16bit_ptr->stride_cr << 1,
-                               ref_pic_16bit_ptr->width,
-                               ref_pic_16bit_ptr->height >> 1,
-                               ref_pic_16bit_ptr->origin_x,
-                               ref_pic_16bit_ptr->origin_y >> 1);
+        generate_padding16_bit_rows(ref_pic_16bit_ptr->buffer_cr,
+                                    ref_pic_16bit_ptr->stride_cr << 1,
+                                    ref_pic_16bit_ptr->width,
+                                    ref_pic_16bit_ptr->origin_x,
+                                    ref_pic_16bit_ptr->origin_y >> 1,
+                                    chroma_row_start,
+                                    chroma_row_count);
 
         // Hsan: unpack ref samples (to be used @ MD)
-        un_pack2d((uint16_t *)ref_pic_16bit_ptr->buffer_y,
+        const uint32_t luma_row   = ref_pic_16bit_ptr->origin_y + row_start;
+        const uint32_t chroma_row = (ref_pic_16bit_ptr->origin_y >> 1) + chroma_row_start;
+        un_pack2d((uint16_t *)ref_pic_16bit_ptr->buffer_y + luma_row * ref_pic_16bit_ptr->stride_y,
                   ref_pic_16bit_ptr->stride_y,
-                  ref_pic_ptr->buffer_y,
+                  ref_pic_ptr->buffer_y + luma_row * ref_pic_ptr->stride_y,
                   ref_pic_ptr->stride_y,
-                  ref_pic_ptr->buffer_bit_inc_y,
+                  ref_pic_ptr->buffer_bit_inc_y + luma_row * ref_pic_ptr->stride_bit_inc_y,
                   ref_pic_ptr->stride_bit_inc_y,
                   ref_pic_16bit_ptr->width + (ref_pic_ptr->origin_x << 1),
-                  ref_pic_16bit_ptr->height + (ref_pic_ptr->origin_y << 1));
-
-        un_pack2d((uint16_t *)ref_pic_16bit_ptr->buffer_cb,
-                  ref_pic_16bit_ptr->stride_cb,
-                  ref_pic_ptr->buffer_cb,
-                  ref_pic_ptr->stride_cb,
-                  ref_pic_ptr->buffer_bit_inc_cb,
-                  ref_pic_ptr->stride_bit_inc_cb,
-                  (ref_pic_16bit_ptr->width + (ref_pic_ptr->origin_x << 1)) >> 1,
-                  (ref_pic_16bit_ptr->height + (ref_pic_ptr->origin_y << 1)) >> 1);
-
-        un_pack2d((uint16_t *)ref_pic_16bit_ptr->buffer_cr,
-                  ref_pic_16bit_ptr->stride_cr,
-                  ref_pic_ptr->buffer_cr,
-                  ref_pic_ptr->stride_cr,
-                  ref_pic_ptr->buffer_bit_inc_cr,
-                  ref_pic_ptr->stride_bit_inc_cr,
-                  (ref_pic_16bit_ptr->width + (ref_pic_ptr->origin_x << 1)) >> 1,
-                  (ref_pic_16bit_ptr->height + (ref_pic_ptr->origin_y << 1)) >> 1);
+                  row_end - row_start);
+
+        un_pack2d(
+            (uint16_t *)ref_pic_16bit_ptr->buffer_cb + chroma_row * ref_pic_16bit_ptr->stride_cb,
+            ref_pic_16bit_ptr->stride_cb,
+            ref_pic_ptr->buffer_cb + chroma_row * ref_pic_ptr->stride_cb,
+            ref_pic_ptr->stride_cb,
+            ref_pic_ptr->buffer_bit_inc_cb + chroma_row * ref_pic_ptr->stride_bit_inc_cb,
+            ref_pic_ptr->stride_bit_inc_cb,
+            (ref_pic_16bit_ptr->width + (ref_pic_ptr->origin_x << 1)) >> 1,
+            chroma_row_count);
+
+        un_pack2d(
+            (uint16_t *)ref_pic_16bit_ptr->buffer_cr + chroma_row * ref_pic_16bit_ptr->stride_cr,
+            ref_pic_16bit_ptr->stride_cr,
+            ref_pic_ptr->buffer_cr + chroma_row * ref_pic_ptr->stride_cr,
+            ref_pic_ptr->stride_cr,
+            ref_pic_ptr->buffer_bit_inc_cr + chroma_row * ref_pic_ptr->stride_bit_inc_cr,
+            ref_pic_ptr->stride_bit_inc_cr,
+            (ref_pic_16bit_ptr->width + (ref_pic_ptr->origin_x << 1)) >> 1,
+            chroma_row_count);
+    }
+}
+
+static void pad_ref_plane_border(EbByte buffer, uint32_t stride, uint32_t height,
+                                 uint32_t padding_height, EbBool top) {
+    if (top)
+        generate_padding_top(buffer, stride, padding_height);
+    else
+        generate_padding_bottom(buffer, stride, height, padding_height);
+}
+
+/*
+ * Replicate the first (top) or the last row of the reference picture into its vertical padding,
+ * once the band holding that row went through pad_ref_rows().
+ */
+void pad_ref_border(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr, EbBool top) {
+    EbReferenceObject *reference_object =
+        (EbReferenceObject *)pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr;
+    EbPictureBufferDesc *ref_pic_ptr = (EbPictureBufferDesc *)reference_object->reference_picture;
+    EbPictureBufferDesc *ref_pic_16bit_ptr =
+        (EbPictureBufferDesc *)reference_object->reference_picture16bit;
+    EbBool is_16bit = (scs_ptr->static_config.encoder_bit_depth > EB_8BIT);
+
+    if (!is_16bit) {
+        pad_ref_plane_border(ref_pic_ptr->buffer_y,
+                             ref_pic_ptr->stride_y,
+                             ref_pic_ptr->height,
+                             ref_pic_ptr->origin_y,
+                             top);
+        pad_ref_plane_border(ref_pic_ptr->buffer_cb,
+                             ref_pic_ptr->stride_cb,
+                             ref_pic_ptr->height >> 1,
+                             ref_pic_ptr->origin_y >> 1,
+                             top);
+        pad_ref_plane_border(ref_pic_ptr->buffer_cr,
+                             ref_pic_ptr->stride_cr,
+                             ref_pic_ptr->height >> 1,
+                             ref_pic_ptr->origin_y >> 1,
+                             top);
+    } else {
+        pad_ref_plane_border(ref_pic_16bit_ptr->buffer_y,
+                             ref_pic_16bit_ptr->stride_y << 1,
+                             ref_pic_16bit_ptr->height,
+                             ref_pic_16bit_ptr->origin_y,
+                             top);
+        pad_ref_plane_border(ref_pic_16bit_ptr->buffer_cb,
+                             ref_pic_16bit_ptr->stride_cb << 1,
+                             ref_pic_16bit_ptr->height >> 1,
+                             ref_pic_16bit_ptr->origin_y >> 1,
+                             top);
+        pad_ref_plane_border(ref_pic_16bit_ptr->buffer_cr,
+                             ref_pic_16bit_ptr->stride_cr << 1,
+                             ref_pic_16bit_ptr->height >> 1,
+                             ref_pic_16bit_ptr->origin_y >> 1,
+                             top);
+
+        // the unpacked planes are padded the same way, the inner rows were done per band
+        const uint32_t luma_pad   = ref_pic_16bit_ptr->origin_y;
+        const uint32_t chroma_pad = ref_pic_16bit_ptr->origin_y >> 1;
+        pad_ref_plane_border(
+            ref_pic_ptr->buffer_y, ref_pic_ptr->stride_y, ref_pic_ptr->height, luma_pad, top);
+        pad_ref_plane_border(ref_pic_ptr->buffer_bit_inc_y,
+                             ref_pic_ptr->stride_bit_inc_y,
+                             ref_pic_ptr->height,
+                             luma_pad,
+                             top);
+        pad_ref_plane_border(ref_pic_ptr->buffer_cb,
+                             ref_pic_ptr->stride_cb,
+                             ref_pic_ptr->height >> 1,
+                             chroma_pad,
+                             top);
+        pad_ref_plane_border(ref_pic_ptr->buffer_bit_inc_cb,
+                             ref_pic_ptr->stride_bit_inc_cb,
+                             ref_pic_ptr->height >> 1,
+                             chroma_pad,
+                             top);
+        pad_ref_plane_border(ref_pic_ptr->buffer_cr,
+                             ref_pic_ptr->stride_cr,
+                             ref_pic_ptr->height >> 1,
+                             chroma_pad,
+                             top);
+        pad_ref_plane_border(ref_pic_ptr->buffer_bit_inc_cr,
+                             ref_pic_ptr->stride_bit_inc_cr,
+                             ref_pic_ptr->height >> 1,
+                             chroma_pad,
+                             top);
     }
+}
+
+/*
+ * Set the reference POC, QP and slice type read by the pictures referencing this one.
+ */
+void set_ref_flags(PictureControlSet *pcs_ptr) {
+    EbReferenceObject *reference_object =
+        (EbReferenceObject *)pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr;
     // set up the ref POC
     reference_object->ref_poc = pcs_ptr->parent_pcs_ptr->picture_number;
 
@@ -2482,17 +2435,66 @@ static void perform_pred_depth_refinement(SequenceControlSet *scs_ptr, PictureCo
 }
 
 /******************************************************
- * EncDec Kernel
+ * Set the motion bound of the SB for MD: its tile when
+ * unrestricted_motion_vector is 0 and, when the picture
+ * may start before its references are final (inter-frame
+ * wavefront without frame end CDF update, which waits for
+ * their entropy coding), REF_ROWS_MV_RANGE rows below the
+ * SB row. Once per SB row, wait until the references are
+ * final down to the rows the row may read: the motion of
+ * its blocks, the motion of the neighbours up to an SB
+ * above which OBMC reuses, and the predictive ME window.
  ******************************************************/
-void *enc_dec_kernel(void *input_ptr) {
+static void enc_dec_gate_ref_rows(SequenceControlSet *scs_ptr, PictureControlSet *pcs_ptr,
+                                  EncDecContext *context_ptr, SuperBlock *sb_ptr,
+                                  uint32_t sb_origin_y) {
+    ModeDecisionContext *md_context = context_ptr->md_context;
+    const EbBool umv0tile = (scs_ptr->static_config.unrestricted_motion_vector == 0);
+    const EbBool gated    = scs_ptr->static_config.inter_frame_wavefront &&
+                         !pcs_ptr->parent_pcs_ptr->frame_end_cdf_update_mode &&
+                         pcs_ptr->slice_type != I_SLICE;
+
+    md_context->mv_bounded    = umv0tile || gated;
+    md_context->mv_bound_tile = sb_ptr->tile_info;
+    if (!umv0tile) {
+        md_context->mv_bound_tile.mi_row_start = md_context->mv_bound_tile.mi_col_start =
+            INT16_MIN;
+        md_context->mv_bound_tile.mi_row_end = md_context->mv_bound_tile.mi_col_end = INT16_MAX;
+    }
+    if (!gated) {
+        md_context->ref_rows_bound = REF_ROWS_ALL;
+        return;
+    }
+    md_context->ref_rows_bound = (int32_t)(sb_origin_y + context_ptr->sb_sz) + REF_ROWS_MV_RANGE;
+    md_context->mv_bound_tile.mi_row_end =
+        MIN(md_context->mv_bound_tile.mi_row_end, md_context->ref_rows_bound >> MI_SIZE_LOG2);
+
+    if (sb_origin_y == context_ptr->ref_rows_sb_origin_y) return;
+    context_ptr->ref_rows_sb_origin_y = sb_origin_y;
+    const int32_t row_end = md_context->ref_rows_bound + context_ptr->sb_sz +
+        (FULL_PEL_REF_WINDOW_HEIGHT_EXTENDED >> 1) + REF_ROWS_MARGIN;
+    for (uint8_t ref_idx = 0; ref_idx < pcs_ptr->parent_pcs_ptr->ref_list0_count; ref_idx++)
+        eb_reference_object_wait_rows(
+            (EbReferenceObject *)pcs_ptr->ref_pic_ptr_array[REF_LIST_0][ref_idx]->object_ptr,
+            row_end);
+    if (pcs_ptr->slice_type == B_SLICE)
+        for (uint8_t ref_idx = 0; ref_idx < pcs_ptr->parent_pcs_ptr->ref_list1_count; ref_idx++)
+            eb_reference_object_wait_rows(
+                (EbReferenceObject *)pcs_ptr->ref_pic_ptr_array[REF_LIST_1][ref_idx]->object_ptr,
+                row_end);
+}
+
+/******************************************************
+ * EncDec Job
+ *   Processes one EncDec task.
+ ******************************************************/
+void enc_dec_job(EbThreadContext *thread_context_ptr, EbObjectWrapper *enc_dec_tasks_wrapper_ptr) {
     // Context & SCS & PCS
-    EbThreadContext *   thread_context_ptr = (EbThreadContext *)input_ptr;
-    EncDecContext *     context_ptr        = (EncDecContext *)thread_context_ptr->priv;
+    EncDecContext *     context_ptr = (EncDecContext *)thread_context_ptr->priv;
     PictureControlSet * pcs_ptr;
     SequenceControlSet *scs_ptr;
 
     // Input
-    EbObjectWrapper *enc_dec_tasks_wrapper_ptr;
     EncDecTasks *    enc_dec_tasks_ptr;
 
     // Output
@@ -2508,10 +2510,9 @@ void *enc_dec_kernel(void *input_ptr) {
     uint32_t    sb_origin_x;
     uint32_t    sb_origin_y;
     EbBool      last_sb_flag;
-    EbBool      end_of_row_flag;
-    uint32_t    sb_row_index_start;
-    uint32_t    sb_row_index_count;
+    EbBool      unit_done_flag;
     uint32_t    pic_width_in_sb;
+    uint32_t    tile_cols;
     MdcSbData * mdc_ptr;
 
     // Variables
@@ -2521,7 +2522,8 @@ void *enc_dec_kernel(void *input_ptr) {
     uint16_t        segment_index;
     uint32_t        x_sb_start_index;
     uint32_t        y_sb_start_index;
-    uint32_t        sb_start_index;
+    uint32_t        x_sb_last_index;
+    uint32_t        y_sb_last_index;
     uint32_t        sb_segment_count;
     uint32_t        sb_segment_index;
     uint32_t        segment_row_index;
@@ -2531,162 +2533,202 @@ void *enc_dec_kernel(void *input_ptr) {
 
     segment_index = 0;
 
-    for (;;) {
-        // Get Mode Decision Results
-        eb_get_full_object(context_ptr->mode_decision_input_fifo_ptr, &enc_dec_tasks_wrapper_ptr);
+    enc_dec_tasks_ptr = (EncDecTasks *)enc_dec_tasks_wrapper_ptr->object_ptr;
+    pcs_ptr           = (PictureControlSet *)enc_dec_tasks_ptr->pcs_wrapper_ptr->object_ptr;
+    scs_ptr           = (SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr;
+    segments_ptr      = pcs_ptr->enc_dec_segment_ctrl[enc_dec_tasks_ptr->tile_index];
+    last_sb_flag      = EB_FALSE;
+    context_ptr->ref_rows_sb_origin_y = (uint32_t)~0;
+    if (scs_ptr->static_config.numa_mode)
+        eb_numa_count_task(&scs_ptr->encode_context_ptr->numa_stats,
+                           enc_dec_tasks_wrapper_ptr->numa_node);
+    unit_done_flag    = EB_FALSE;
+    is_16bit          = (EbBool)(scs_ptr->static_config.encoder_bit_depth > EB_8BIT);
+    (void)is_16bit;
+    eb_pipeline_stats_set_picture(pcs_ptr->picture_number);
+
+    // SB Constants
+    sb_sz              = (uint8_t)scs_ptr->sb_size_pix;
+    sb_size_log2       = (uint8_t)Log2f(sb_sz);
+    context_ptr->sb_sz = sb_sz;
+    pic_width_in_sb    = (scs_ptr->seq_header.max_frame_width + sb_sz - 1) >> sb_size_log2;
+    tile_cols          = pcs_ptr->parent_pcs_ptr->av1_cm->tiles_info.tile_cols;
+    context_ptr->tot_intra_coded_area = 0;
+    // Last SB of the work unit, the wavefront codes it after every other SB of the unit
+    x_sb_last_index = segments_ptr->sb_x_start + segments_ptr->sb_col_count - 1;
+    y_sb_last_index = segments_ptr->sb_y_start + segments_ptr->sb_row_count - 1;
+
+    // Segment-loop
+    while (assign_enc_dec_segments(segments_ptr,
+                                   &segment_index,
+                                   enc_dec_tasks_ptr,
+                                   context_ptr->enc_dec_feedback_fifo_ptr) == EB_TRUE) {
+        // Segment positions are relative to the work unit
+        x_sb_start_index = segments_ptr->x_start_array[segment_index];
+        y_sb_start_index = segments_ptr->y_start_array[segment_index];
+        sb_segment_count = segments_ptr->valid_sb_count_array[segment_index];
+
+        segment_row_index = segment_index / segments_ptr->segment_band_count;
+        segment_band_index =
+            segment_index - segment_row_index * segments_ptr->segment_band_count;
+        segment_band_size = (segments_ptr->sb_band_count * (segment_band_index + 1) +
+                             segments_ptr->segment_band_count - 1) /
+                            segments_ptr->segment_band_count;
+
+        // Reset the neighbor arrays at the start of the work unit
+        if (segment_index == 0) enc_dec_start_unit(pcs_ptr, enc_dec_tasks_ptr->tile_index);
+
+        // Reset Coding Loop State
+        reset_mode_decision(scs_ptr, context_ptr->md_context, pcs_ptr);
+
+        // Reset EncDec Coding State
+        reset_enc_dec( // HT done
+            context_ptr,
+            pcs_ptr,
+            scs_ptr);
+
+        if (pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr != NULL)
+            ((EbReferenceObject *)
+                 pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)
+                ->average_intensity = pcs_ptr->parent_pcs_ptr->average_intensity[0];
+        for (y_sb_index = y_sb_start_index, sb_segment_index = 0;
+             sb_segment_index < sb_segment_count;
+             ++y_sb_index) {
+            for (x_sb_index = x_sb_start_index;
+                 x_sb_index < segments_ptr->sb_col_count &&
+                 (x_sb_index + y_sb_index < segment_band_size) &&
+                 sb_segment_index < sb_segment_count;
+                 ++x_sb_index, ++sb_segment_index) {
+                const uint32_t x_sb_pic_index = segments_ptr->sb_x_start + x_sb_index;
+                const uint32_t y_sb_pic_index = segments_ptr->sb_y_start + y_sb_index;
+                sb_index    = (uint16_t)(y_sb_pic_index * pic_width_in_sb + x_sb_pic_index);
+                sb_ptr      = pcs_ptr->sb_ptr_array[sb_index];
+                sb_origin_x = x_sb_pic_index << sb_size_log2;
+                sb_origin_y = y_sb_pic_index << sb_size_log2;
+                if (x_sb_pic_index == x_sb_last_index && y_sb_pic_index == y_sb_last_index)
+                    unit_done_flag = EB_TRUE;
+                mdc_ptr               = &pcs_ptr->mdc_sb_array[sb_index];
+                context_ptr->sb_index = sb_index;
+                // The tile of the SB selects its neighbor arrays
+                context_ptr->tile_idx = (uint16_t)(sb_ptr->tile_info.tile_row * tile_cols +
+                                                   sb_ptr->tile_info.tile_col);
+                context_ptr->md_context->tile_idx = context_ptr->tile_idx;
+
+                if (pcs_ptr->update_cdf) {
+                    // Use the latest available CDF for the current SB
+                    // Use the weighted average of left (3x) and top (1x) if available.
+                    int8_t up_available   = ((int32_t)(sb_origin_y >> MI_SIZE_LOG2) >
+                                           sb_ptr->tile_info.mi_row_start);
+                    int8_t left_available = ((int32_t)(sb_origin_x >> MI_SIZE_LOG2) >
+                                             sb_ptr->tile_info.mi_col_start);
+                    if (!left_available && !up_available)
+                        pcs_ptr->ec_ctx_array[sb_index] =
+                            *pcs_ptr->coeff_est_entropy_coder_ptr->fc;
+                    else if (!left_available)
+                        pcs_ptr->ec_ctx_array[sb_index] =
+                            pcs_ptr->ec_ctx_array[sb_index - pic_width_in_sb];
+                    else if (!up_available)
+                        pcs_ptr->ec_ctx_array[sb_index] = pcs_ptr->ec_ctx_array[sb_index - 1];
+                    else {
+                        pcs_ptr->ec_ctx_array[sb_index] = pcs_ptr->ec_ctx_array[sb_index - 1];
+                        avg_cdf_symbols(&pcs_ptr->ec_ctx_array[sb_index],
+                                        &pcs_ptr->ec_ctx_array[sb_index - pic_width_in_sb],
+                                        AVG_CDF_WEIGHT_LEFT,
+                                        AVG_CDF_WEIGHT_TOP);
+                    }
 
-        enc_dec_tasks_ptr = (EncDecTasks *)enc_dec_tasks_wrapper_ptr->object_ptr;
-        pcs_ptr           = (PictureControlSet *)enc_dec_tasks_ptr->pcs_wrapper_ptr->object_ptr;
-        scs_ptr           = (SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr;
-        segments_ptr      = pcs_ptr->enc_dec_segment_ctrl;
-        last_sb_flag      = EB_FALSE;
-        is_16bit          = (EbBool)(scs_ptr->static_config.encoder_bit_depth > EB_8BIT);
-        (void)is_16bit;
-        (void)end_of_row_flag;
-        // SB Constants
-        sb_sz              = (uint8_t)scs_ptr->sb_size_pix;
-        sb_size_log2       = (uint8_t)Log2f(sb_sz);
-        context_ptr->sb_sz = sb_sz;
-        pic_width_in_sb    = (scs_ptr->seq_header.max_frame_width + sb_sz - 1) >> sb_size_log2;
-        end_of_row_flag    = EB_FALSE;
-        sb_row_index_start = sb_row_index_count = 0;
-        context_ptr->tot_intra_coded_area       = 0;
-
-        // Segment-loop
-        while (assign_enc_dec_segments(segments_ptr,
-                                       &segment_index,
-                                       enc_dec_tasks_ptr,
-                                       context_ptr->enc_dec_feedback_fifo_ptr) == EB_TRUE) {
-            x_sb_start_index = segments_ptr->x_start_array[segment_index];
-            y_sb_start_index = segments_ptr->y_start_array[segment_index];
-            sb_start_index   = y_sb_start_index * pic_width_in_sb + x_sb_start_index;
-            sb_segment_count = segments_ptr->valid_sb_count_array[segment_index];
-
-            segment_row_index = segment_index / segments_ptr->segment_band_count;
-            segment_band_index =
-                segment_index - segment_row_index * segments_ptr->segment_band_count;
-            segment_band_size = (segments_ptr->sb_band_count * (segment_band_index + 1) +
-                                 segments_ptr->segment_band_count - 1) /
-                                segments_ptr->segment_band_count;
-
-            // Reset Coding Loop State
-            reset_mode_decision(scs_ptr, context_ptr->md_context, pcs_ptr, segment_index);
-
-            // Reset EncDec Coding State
-            reset_enc_dec( // HT done
-                context_ptr,
-                pcs_ptr,
-                scs_ptr,
-                segment_index);
-
-            if (pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr != NULL)
-                ((EbReferenceObject *)
-                     pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)
-                    ->average_intensity = pcs_ptr->parent_pcs_ptr->average_intensity[0];
-            for (y_sb_index = y_sb_start_index, sb_segment_index = sb_start_index;
-                 sb_segment_index < sb_start_index + sb_segment_count;
-                 ++y_sb_index) {
-                for (x_sb_index = x_sb_start_index;
-                     x_sb_index < pic_width_in_sb &&
-                     (x_sb_index + y_sb_index < segment_band_size) &&
-                     sb_segment_index < sb_start_index + sb_segment_count;
-                     ++x_sb_index, ++sb_segment_index) {
-                    sb_index        = (uint16_t)(y_sb_index * pic_width_in_sb + x_sb_index);
-                    sb_ptr          = pcs_ptr->sb_ptr_array[sb_index];
-                    sb_origin_x     = x_sb_index << sb_size_log2;
-                    sb_origin_y     = y_sb_index << sb_size_log2;
-                    last_sb_flag    = (sb_index == scs_ptr->sb_tot_cnt - 1) ? EB_TRUE : EB_FALSE;
-                    end_of_row_flag = (x_sb_index == pic_width_in_sb - 1) ? EB_TRUE : EB_FALSE;
-                    sb_row_index_start =
-                        (x_sb_index == pic_width_in_sb - 1 && sb_row_index_count == 0)
-                            ? y_sb_index
-                            : sb_row_index_start;
-                    sb_row_index_count = (x_sb_index == pic_width_in_sb - 1)
-                                             ? sb_row_index_count + 1
-                                             : sb_row_index_count;
-                    mdc_ptr               = &pcs_ptr->mdc_sb_array[sb_index];
-                    context_ptr->sb_index = sb_index;
-
-                    if (pcs_ptr->update_cdf) {
-                        pcs_ptr->rate_est_array[sb_index] = *pcs_ptr->md_rate_estimation_array;
-                        // Use the latest available CDF for the current SB
-                        // Use the weighted average of left (3x) and top (1x) if available.
-                        int8_t up_available   = ((int32_t)(sb_origin_y >> MI_SIZE_LOG2) >
-                                               sb_ptr->tile_info.mi_row_start);
-                        int8_t left_available = ((int32_t)(sb_origin_x >> MI_SIZE_LOG2) >
-                                                 sb_ptr->tile_info.mi_col_start);
-                        if (!left_available && !up_available)
-                            pcs_ptr->ec_ctx_array[sb_index] =
-                                *pcs_ptr->coeff_est_entropy_coder_ptr->fc;
-                        else if (!left_available)
-                            pcs_ptr->ec_ctx_array[sb_index] =
-                                pcs_ptr->ec_ctx_array[sb_index - pic_width_in_sb];
-                        else if (!up_available)
-                            pcs_ptr->ec_ctx_array[sb_index] = pcs_ptr->ec_ctx_array[sb_index - 1];
-                        else {
-                            pcs_ptr->ec_ctx_array[sb_index] = pcs_ptr->ec_ctx_array[sb_index - 1];
-                            avg_cdf_symbols(&pcs_ptr->ec_ctx_array[sb_index],
-                                            &pcs_ptr->ec_ctx_array[sb_index - pic_width_in_sb],
-                                            AVG_CDF_WEIGHT_LEFT,
-                                            AVG_CDF_WEIGHT_TOP);
-                        }
+                    // Rate Estimation of the syntax elements, the Motion vectors and the
+                    // coefficients: only the entries whose CDFs changed since the previous
+                    // SB of this thread are re-estimated
+                    MdRateEstimationCache *rate_cache = context_ptr->md_rate_estimation_cache;
+                    av1_update_rate_estimation_cache(
+                        rate_cache, pcs_ptr, &pcs_ptr->ec_ctx_array[sb_index]);
+
+                    //let the candidate point to the new rate table.
+                    uint32_t cand_index;
+                    for (cand_index = 0; cand_index < MODE_DECISION_CANDIDATE_MAX_COUNT;
+                         ++cand_index)
+                        context_ptr->md_context->fast_candidate_ptr_array[cand_index]
+                            ->md_rate_estimation_ptr = &rate_cache->rate_table;
+                    context_ptr->md_context->md_rate_estimation_ptr = &rate_cache->rate_table;
+                }
+                enc_dec_gate_ref_rows(scs_ptr, pcs_ptr, context_ptr, sb_ptr, sb_origin_y);
+                // Configure the SB
+                mode_decision_configure_sb(
+                    context_ptr->md_context, pcs_ptr, (uint8_t)sb_ptr->qp);
+                // Multi-Pass PD Path
+                // For each SB, all blocks are tested in PD0 (4421 blocks if 128x128 SB, and 1101 blocks if 64x64 SB).
+                // Then the PD0 predicted Partitioning Structure is refined by considering up to three refinements depths away from the predicted depth, both in the direction of smaller block sizes and in the direction of larger block sizes (up to Pred - 3 / Pred + 3 refinement). The selection of the refinement depth is performed using the cost
+                // deviation between the current depth cost and candidate depth cost. The generated blocks are used as input candidates to PD1.
+                // The PD1 predicted Partitioning Structure is also refined (up to Pred - 1 / Pred + 1 refinement) using the square (SQ) vs. non-square (NSQ) decision(s)
+                // inside the predicted depth and using coefficient information. The final set of blocks is evaluated in PD2 to output the final Partitioning Structure
+
+                if ((pcs_ptr->parent_pcs_ptr->pic_depth_mode == PIC_MULTI_PASS_PD_MODE_0 ||
+                     pcs_ptr->parent_pcs_ptr->pic_depth_mode == PIC_MULTI_PASS_PD_MODE_1 ||
+                     pcs_ptr->parent_pcs_ptr->pic_depth_mode == PIC_MULTI_PASS_PD_MODE_2 ||
+                     pcs_ptr->parent_pcs_ptr->pic_depth_mode == PIC_MULTI_PASS_PD_MODE_3) &&
+                    scs_ptr->sb_geom[sb_index].is_complete_sb) {
+                    // Save a clean copy of the neighbor arrays
+                    copy_neighbour_arrays(pcs_ptr,
+                                          context_ptr->md_context,
+                                          MD_NEIGHBOR_ARRAY_INDEX,
+                                          MULTI_STAGE_PD_NEIGHBOR_ARRAY_INDEX,
+                                          0,
+                                          sb_origin_x,
+                                          sb_origin_y);
+
+                    // [PD_PASS_0] Signal(s) derivation
+                    context_ptr->md_context->pd_pass = PD_PASS_0;
+                    signal_derivation_enc_dec_kernel_oq(
+                        scs_ptr, pcs_ptr, context_ptr->md_context);
+
+                    // [PD_PASS_0] Mode Decision - Reduce the total number of partitions to be tested in later stages.
+                    // Input : mdc_blk_ptr built @ mdc process (up to 4421)
+                    // Output: md_blk_arr_nsq reduced set of block(s)
 
-                        // Initial Rate Estimation of the syntax elements
-                        av1_estimate_syntax_rate(&pcs_ptr->rate_est_array[sb_index],
-                                                 pcs_ptr->slice_type == I_SLICE,
-                                                 &pcs_ptr->ec_ctx_array[sb_index]);
-                        // Initial Rate Estimation of the Motion vectors
-                        av1_estimate_mv_rate(pcs_ptr,
-                                             &pcs_ptr->rate_est_array[sb_index],
-                                             &pcs_ptr->ec_ctx_array[sb_index]);
-
-                        av1_estimate_coefficients_rate(&pcs_ptr->rate_est_array[sb_index],
-                                                       &pcs_ptr->ec_ctx_array[sb_index]);
-
-                        //let the candidate point to the new rate table.
-                        uint32_t cand_index;
-                        for (cand_index = 0; cand_index < MODE_DECISION_CANDIDATE_MAX_COUNT;
-                             ++cand_index)
-                            context_ptr->md_context->fast_candidate_ptr_array[cand_index]
-                                ->md_rate_estimation_ptr = &pcs_ptr->rate_est_array[sb_index];
-                        context_ptr->md_context->md_rate_estimation_ptr =
-                            &pcs_ptr->rate_est_array[sb_index];
-                    }
-                    // Configure the SB
-                    mode_decision_configure_sb(
-                        context_ptr->md_context, pcs_ptr, (uint8_t)sb_ptr->qp);
-                    // Multi-Pass PD Path
-                    // For each SB, all blocks are tested in PD0 (4421 blocks if 128x128 SB, and 1101 blocks if 64x64 SB).
-                    // Then the PD0 predicted Partitioning Structure is refined by considering up to three refinements depths away from the predicted depth, both in the direction of smaller block sizes and in the direction of larger block sizes (up to Pred - 3 / Pred + 3 refinement). The selection of the refinement depth is performed using the cost
-                    // deviation between the current depth cost and candidate depth cost. The generated blocks are used as input candidates to PD1.
-                    // The PD1 predicted Partitioning Structure is also refined (up to Pred - 1 / Pred + 1 refinement) using the square (SQ) vs. non-square (NSQ) decision(s)
-                    // inside the predicted depth and using coefficient information. The final set of blocks is evaluated in PD2 to output the final Partitioning Structure
-
-                    if ((pcs_ptr->parent_pcs_ptr->pic_depth_mode == PIC_MULTI_PASS_PD_MODE_0 ||
-                         pcs_ptr->parent_pcs_ptr->pic_depth_mode == PIC_MULTI_PASS_PD_MODE_1 ||
-                         pcs_ptr->parent_pcs_ptr->pic_depth_mode == PIC_MULTI_PASS_PD_MODE_2 ||
-                         pcs_ptr->parent_pcs_ptr->pic_depth_mode == PIC_MULTI_PASS_PD_MODE_3) &&
-                        scs_ptr->sb_geom[sb_index].is_complete_sb) {
-                        // Save a clean copy of the neighbor arrays
-                        copy_neighbour_arrays(pcs_ptr,
-                                              context_ptr->md_context,
-                                              MD_NEIGHBOR_ARRAY_INDEX,
-                                              MULTI_STAGE_PD_NEIGHBOR_ARRAY_INDEX,
-                                              0,
-                                              sb_origin_x,
-                                              sb_origin_y);
+                    // PD0 MD Tool(s) : Best ME candidate only as INTER candidate(s), DC only as INTRA candidate(s), Chroma blind, Spatial SSE,
+                    // no MVP table generation, no fast rate @ full cost derivation, Md-Stage 0 and Md-Stage 2 using count=1 (i.e. only best md-stage-0 candidate)
+                    mode_decision_sb(scs_ptr,
+                                     pcs_ptr,
+                                     mdc_ptr,
+                                     sb_ptr,
+                                     sb_origin_x,
+                                     sb_origin_y,
+                                     sb_index,
+                                     context_ptr->md_context);
 
-                        // [PD_PASS_0] Signal(s) derivation
-                        context_ptr->md_context->pd_pass = PD_PASS_0;
+                    // Perform Pred_0 depth refinement - Add blocks to be considered in the next stage(s) of PD based on depth cost.
+                    perform_pred_depth_refinement(
+                        scs_ptr, pcs_ptr, context_ptr->md_context, sb_index);
+
+                    // Re-build mdc_blk_ptr for the 2nd PD Pass [PD_PASS_1]
+                    build_cand_block_array(scs_ptr, pcs_ptr, sb_index);
+
+                    // Reset neighnor information to current SB @ position (0,0)
+                    copy_neighbour_arrays(pcs_ptr,
+                                          context_ptr->md_context,
+                                          MULTI_STAGE_PD_NEIGHBOR_ARRAY_INDEX,
+                                          MD_NEIGHBOR_ARRAY_INDEX,
+                                          0,
+                                          sb_origin_x,
+                                          sb_origin_y);
+
+                    if (pcs_ptr->parent_pcs_ptr->pic_depth_mode == PIC_MULTI_PASS_PD_MODE_1 ||
+                        pcs_ptr->parent_pcs_ptr->pic_depth_mode == PIC_MULTI_PASS_PD_MODE_2 ||
+                        pcs_ptr->parent_pcs_ptr->pic_depth_mode == PIC_MULTI_PASS_PD_MODE_3) {
+                        // [PD_PASS_1] Signal(s) derivation
+                        context_ptr->md_context->pd_pass = PD_PASS_1;
                         signal_derivation_enc_dec_kernel_oq(
                             scs_ptr, pcs_ptr, context_ptr->md_context);
 
-                        // [PD_PASS_0] Mode Decision - Reduce the total number of partitions to be tested in later stages.
-                        // Input : mdc_blk_ptr built @ mdc process (up to 4421)
+                        // [PD_PASS_1] Mode Decision - Further reduce the number of
+                        // partitions to be considered in later PD stages. This pass uses more accurate
+                        // info than PD0 to give a better PD estimate.
+                        // Input : mdc_blk_ptr built @ PD0 refinement
                         // Output: md_blk_arr_nsq reduced set of block(s)
 
-                        // PD0 MD Tool(s) : Best ME candidate only as INTER candidate(s), DC only as INTRA candidate(s), Chroma blind, Spatial SSE,
-                        // no MVP table generation, no fast rate @ full cost derivation, Md-Stage 0 and Md-Stage 2 using count=1 (i.e. only best md-stage-0 candidate)
+                        // PD1 MD Tool(s) : ME and Predictive ME only as INTER candidate(s) but MRP blind (only reference index 0 for motion compensation),
+                        // DC only as INTRA candidate(s)
                         mode_decision_sb(scs_ptr,
                                          pcs_ptr,
                                          mdc_ptr,
@@ -2696,11 +2738,11 @@ void *enc_dec_kernel(void *input_ptr) {
                                          sb_index,
                                          context_ptr->md_context);
 
-                        // Perform Pred_0 depth refinement - Add blocks to be considered in the next stage(s) of PD based on depth cost.
+                        // Perform Pred_1 depth refinement - Add blocks to be considered in the next stage(s) of PD based on depth cost.
                         perform_pred_depth_refinement(
                             scs_ptr, pcs_ptr, context_ptr->md_context, sb_index);
 
-                        // Re-build mdc_blk_ptr for the 2nd PD Pass [PD_PASS_1]
+                        // Re-build mdc_blk_ptr for the 3rd PD Pass [PD_PASS_2]
                         build_cand_block_array(scs_ptr, pcs_ptr, sb_index);
 
                         // Reset neighnor information to current SB @ position (0,0)
@@ -2711,145 +2753,124 @@ void *enc_dec_kernel(void *input_ptr) {
                                               0,
                                               sb_origin_x,
                                               sb_origin_y);
-
-                        if (pcs_ptr->parent_pcs_ptr->pic_depth_mode == PIC_MULTI_PASS_PD_MODE_1 ||
-                            pcs_ptr->parent_pcs_ptr->pic_depth_mode == PIC_MULTI_PASS_PD_MODE_2 ||
-                            pcs_ptr->parent_pcs_ptr->pic_depth_mode == PIC_MULTI_PASS_PD_MODE_3) {
-                            // [PD_PASS_1] Signal(s) derivation
-                            context_ptr->md_context->pd_pass = PD_PASS_1;
-                            signal_derivation_enc_dec_kernel_oq(
-                                scs_ptr, pcs_ptr, context_ptr->md_context);
-
-                            // [PD_PASS_1] Mode Decision - Further reduce the number of
-                            // partitions to be considered in later PD stages. This pass uses more accurate
-                            // info than PD0 to give a better PD estimate.
-                            // Input : mdc_blk_ptr built @ PD0 refinement
-                            // Output: md_blk_arr_nsq reduced set of block(s)
-
-                            // PD1 MD Tool(s) : ME and Predictive ME only as INTER candidate(s) but MRP blind (only reference index 0 for motion compensation),
-                            // DC only as INTRA candidate(s)
-                            mode_decision_sb(scs_ptr,
-                                             pcs_ptr,
-                                             mdc_ptr,
-                                             sb_ptr,
-                                             sb_origin_x,
-                                             sb_origin_y,
-                                             sb_index,
-                                             context_ptr->md_context);
-
-                            // Perform Pred_1 depth refinement - Add blocks to be considered in the next stage(s) of PD based on depth cost.
-                            perform_pred_depth_refinement(
-                                scs_ptr, pcs_ptr, context_ptr->md_context, sb_index);
-
-                            // Re-build mdc_blk_ptr for the 3rd PD Pass [PD_PASS_2]
-                            build_cand_block_array(scs_ptr, pcs_ptr, sb_index);
-
-                            // Reset neighnor information to current SB @ position (0,0)
-                            copy_neighbour_arrays(pcs_ptr,
-                                                  context_ptr->md_context,
-                                                  MULTI_STAGE_PD_NEIGHBOR_ARRAY_INDEX,
-                                                  MD_NEIGHBOR_ARRAY_INDEX,
-                                                  0,
-                                                  sb_origin_x,
-                                                  sb_origin_y);
-                        }
                     }
+                }
 
-                    // [PD_PASS_2] Signal(s) derivation
-                    context_ptr->md_context->pd_pass = PD_PASS_2;
-                    signal_derivation_enc_dec_kernel_oq(scs_ptr, pcs_ptr, context_ptr->md_context);
+                // [PD_PASS_2] Signal(s) derivation
+                context_ptr->md_context->pd_pass = PD_PASS_2;
+                signal_derivation_enc_dec_kernel_oq(scs_ptr, pcs_ptr, context_ptr->md_context);
 
-                    // [PD_PASS_2] Mode Decision - Obtain the final partitioning decision using more accurate info
-                    // than previous stages.  Reduce the total number of partitions to 1.
-                    // Input : mdc_blk_ptr built @ PD1 refinement
-                    // Output: md_blk_arr_nsq reduced set of block(s)
+                // [PD_PASS_2] Mode Decision - Obtain the final partitioning decision using more accurate info
+                // than previous stages.  Reduce the total number of partitions to 1.
+                // Input : mdc_blk_ptr built @ PD1 refinement
+                // Output: md_blk_arr_nsq reduced set of block(s)
 
-                    // PD2 MD Tool(s): default MD Tool(s)
+                // PD2 MD Tool(s): default MD Tool(s)
 
-                    mode_decision_sb(scs_ptr,
-                                     pcs_ptr,
-                                     mdc_ptr,
-                                     sb_ptr,
-                                     sb_origin_x,
-                                     sb_origin_y,
-                                     sb_index,
-                                     context_ptr->md_context);
+                mode_decision_sb(scs_ptr,
+                                 pcs_ptr,
+                                 mdc_ptr,
+                                 sb_ptr,
+                                 sb_origin_x,
+                                 sb_origin_y,
+                                 sb_index,
+                                 context_ptr->md_context);
 
-                    // Configure the SB
-                    enc_dec_configure_sb(context_ptr, sb_ptr, pcs_ptr, (uint8_t)sb_ptr->qp);
+                // Configure the SB
+                enc_dec_configure_sb(context_ptr, sb_ptr, pcs_ptr, (uint8_t)sb_ptr->qp);
 
 #if NO_ENCDEC
-                    no_enc_dec_pass(scs_ptr,
-                                    pcs_ptr,
-                                    sb_ptr,
-                                    sb_index,
-                                    sb_origin_x,
-                                    sb_origin_y,
-                                    sb_ptr->qp,
-                                    context_ptr);
+                no_enc_dec_pass(scs_ptr,
+                                pcs_ptr,
+                                sb_ptr,
+                                sb_index,
+                                sb_origin_x,
+                                sb_origin_y,
+                                sb_ptr->qp,
+                                context_ptr);
 #else
-                    // Encode Pass
-                    av1_encode_pass(
-                        scs_ptr, pcs_ptr, sb_ptr, sb_index, sb_origin_x, sb_origin_y, context_ptr);
+                // Encode Pass
+                av1_encode_pass(
+                    scs_ptr, pcs_ptr, sb_ptr, sb_index, sb_origin_x, sb_origin_y, context_ptr);
 #endif
 
-                    if (pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr != NULL)
-                        ((EbReferenceObject *)
-                             pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)
-                            ->intra_coded_area_sb[sb_index] = (uint8_t)(
-                            (100 * context_ptr->intra_coded_area_sb[sb_index]) / (64 * 64));
-                }
-                x_sb_start_index = (x_sb_start_index > 0) ? x_sb_start_index - 1 : 0;
-            }
-        }
-
-        eb_block_on_mutex(pcs_ptr->intra_mutex);
-        pcs_ptr->intra_coded_area += (uint32_t)context_ptr->tot_intra_coded_area;
-        eb_release_mutex(pcs_ptr->intra_mutex);
-
-        if (last_sb_flag) {
-            // Copy film grain data from parent picture set to the reference object for further reference
-            if (scs_ptr->seq_header.film_grain_params_present) {
-                if (pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE &&
-                    pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr) {
+                if (pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr != NULL)
                     ((EbReferenceObject *)
                          pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)
-                        ->film_grain_params = pcs_ptr->parent_pcs_ptr->frm_hdr.film_grain_params;
-                }
+                        ->intra_coded_area_sb[sb_index] = (uint8_t)(
+                        (100 * context_ptr->intra_coded_area_sb[sb_index]) / (64 * 64));
             }
-            if (pcs_ptr->parent_pcs_ptr->frame_end_cdf_update_mode &&
-                pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE &&
-                pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr)
-                for (int frame = LAST_FRAME; frame <= ALTREF_FRAME; ++frame)
-                    ((EbReferenceObject *)
-                         pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)
-                        ->global_motion[frame] = pcs_ptr->parent_pcs_ptr->global_motion[frame];
-            EB_MEMCPY(pcs_ptr->parent_pcs_ptr->av1x->sgrproj_restore_cost,
-                      context_ptr->md_rate_estimation_ptr->sgrproj_restore_fac_bits,
-                      2 * sizeof(int32_t));
-            EB_MEMCPY(pcs_ptr->parent_pcs_ptr->av1x->switchable_restore_cost,
-                      context_ptr->md_rate_estimation_ptr->switchable_restore_fac_bits,
-                      3 * sizeof(int32_t));
-            EB_MEMCPY(pcs_ptr->parent_pcs_ptr->av1x->wiener_restore_cost,
-                      context_ptr->md_rate_estimation_ptr->wiener_restore_fac_bits,
-                      2 * sizeof(int32_t));
-            pcs_ptr->parent_pcs_ptr->av1x->rdmult = context_ptr->full_lambda;
+            x_sb_start_index = (x_sb_start_index > 0) ? x_sb_start_index - 1 : 0;
         }
+    }
 
-        if (last_sb_flag) {
-            // Get Empty EncDec Results
-            eb_get_empty_object(context_ptr->enc_dec_output_fifo_ptr, &enc_dec_results_wrapper_ptr);
-            enc_dec_results_ptr = (EncDecResults *)enc_dec_results_wrapper_ptr->object_ptr;
-            enc_dec_results_ptr->pcs_wrapper_ptr = enc_dec_tasks_ptr->pcs_wrapper_ptr;
-            //CHKN these are not needed for DLF
-            enc_dec_results_ptr->completed_sb_row_index_start = 0;
-            enc_dec_results_ptr->completed_sb_row_count =
-                ((scs_ptr->seq_header.max_frame_height + scs_ptr->sb_size_pix - 1) >> sb_size_log2);
-            // Post EncDec Results
-            eb_post_full_object(enc_dec_results_wrapper_ptr);
+    eb_block_on_mutex(pcs_ptr->intra_mutex);
+    pcs_ptr->intra_coded_area += (uint32_t)context_ptr->tot_intra_coded_area;
+    // The job completing the last work unit finishes the picture
+    if (unit_done_flag)
+        last_sb_flag = (++pcs_ptr->enc_dec_units_done == pcs_ptr->enc_dec_unit_count) ? EB_TRUE
+                                                                                       : EB_FALSE;
+    eb_release_mutex(pcs_ptr->intra_mutex);
+
+    if (last_sb_flag) {
+        // Copy film grain data from parent picture set to the reference object for further reference
+        if (scs_ptr->seq_header.film_grain_params_present) {
+            if (pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE &&
+                pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr) {
+                ((EbReferenceObject *)
+                     pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)
+                    ->film_grain_params = pcs_ptr->parent_pcs_ptr->frm_hdr.film_grain_params;
+            }
         }
-        // Release Mode Decision Results
-        eb_release_object(enc_dec_tasks_wrapper_ptr);
+        if (pcs_ptr->parent_pcs_ptr->frame_end_cdf_update_mode &&
+            pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE &&
+            pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr)
+            for (int frame = LAST_FRAME; frame <= ALTREF_FRAME; ++frame)
+                ((EbReferenceObject *)
+                     pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)
+                    ->global_motion[frame] = pcs_ptr->parent_pcs_ptr->global_motion[frame];
+        EB_MEMCPY(pcs_ptr->parent_pcs_ptr->av1x->sgrproj_restore_cost,
+                  context_ptr->md_rate_estimation_ptr->sgrproj_restore_fac_bits,
+                  2 * sizeof(int32_t));
+        EB_MEMCPY(pcs_ptr->parent_pcs_ptr->av1x->switchable_restore_cost,
+                  context_ptr->md_rate_estimation_ptr->switchable_restore_fac_bits,
+                  3 * sizeof(int32_t));
+        EB_MEMCPY(pcs_ptr->parent_pcs_ptr->av1x->wiener_restore_cost,
+                  context_ptr->md_rate_estimation_ptr->wiener_restore_fac_bits,
+                  2 * sizeof(int32_t));
+        pcs_ptr->parent_pcs_ptr->av1x->rdmult = context_ptr->full_lambda;
+    }
+
+    if (last_sb_flag) {
+        // Get Empty EncDec Results
+        eb_get_empty_object(context_ptr->enc_dec_output_fifo_ptr, &enc_dec_results_wrapper_ptr);
+        enc_dec_results_ptr = (EncDecResults *)enc_dec_results_wrapper_ptr->object_ptr;
+        enc_dec_results_ptr->pcs_wrapper_ptr = enc_dec_tasks_ptr->pcs_wrapper_ptr;
+        enc_dec_results_ptr->input_type      = DLF_TASKS_ENCDEC_INPUT;
+        //CHKN these are not needed for DLF
+        enc_dec_results_ptr->completed_sb_row_index_start = 0;
+        enc_dec_results_ptr->completed_sb_row_count =
+            ((scs_ptr->seq_header.max_frame_height + scs_ptr->sb_size_pix - 1) >> sb_size_log2);
+        // Post EncDec Results
+        eb_post_full_object(enc_dec_results_wrapper_ptr);
+    }
+    // Release Mode Decision Results
+    eb_release_object(enc_dec_tasks_wrapper_ptr);
+}
+
+/******************************************************
+ * EncDec Kernel
+ ******************************************************/
+void *enc_dec_kernel(void *input_ptr) {
+    EbThreadContext *thread_context_ptr = (EbThreadContext *)input_ptr;
+    EncDecContext *  context_ptr        = (EncDecContext *)thread_context_ptr->priv;
+    EbObjectWrapper *enc_dec_tasks_wrapper_ptr;
+
+    for (;;) {
+        // Get Mode Decision Results
+        eb_get_full_object(context_ptr->mode_decision_input_fifo_ptr, &enc_dec_tasks_wrapper_ptr);
+
+        enc_dec_job(thread_context_ptr, enc_dec_tasks_wrapper_ptr);
     }
     return EB_NULL;
 }
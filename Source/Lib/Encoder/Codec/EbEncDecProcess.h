@@ -37,6 +37,7 @@ typedef struct EncDecContext {
     int16_t *                transform_inner_array_ptr;
     MdRateEstimationContext *md_rate_estimation_ptr;
     EbBool                   is_md_rate_estimation_ptr_owner;
+    MdRateEstimationCache *  md_rate_estimation_cache; // per-SB rates when update_cdf is on
     ModeDecisionContext *    md_context;
     const BlockGeom *        blk_geom;
     // MCP Context
@@ -66,6 +67,7 @@ typedef struct EncDecContext {
     uint16_t      blk_origin_y; // within the picture
     uint8_t       sb_sz;
     uint32_t      sb_index;
+    uint16_t      tile_idx; // tile of the SB, selects the neighbor arrays
     MvUnit        mv_unit;
     uint8_t       txb_itr;
     EbBool        is_16bit; //enable 10 bit encode in CL
@@ -95,6 +97,8 @@ typedef struct EncDecContext {
     EbBool
             evaluate_cfl_ep; // 0: CFL is evaluated @ mode decision, 1: CFL is evaluated @ encode pass
     uint8_t md_skip_blk;
+    // SB row whose reference rows the current task last waited for (inter-frame wavefront)
+    uint32_t ref_rows_sb_origin_y;
 } EncDecContext;
 
 /**************************************
@@ -104,6 +108,8 @@ extern EbErrorType enc_dec_context_ctor(EbThreadContext *  thread_context_ptr,
                                         const EbEncHandle *enc_handle_ptr, int index,
                                         int tasks_index, int demux_index);
 
+extern void enc_dec_job(EbThreadContext *thread_context_ptr,
+                        EbObjectWrapper *enc_dec_tasks_wrapper_ptr);
 extern void *enc_dec_kernel(void *input_ptr);
 
 #ifdef __cplusplus
@@ -12,12 +12,19 @@
 #ifdef __cplusplus
 extern "C" {
 #endif
+#define DLF_TASKS_ENCDEC_INPUT 0
+#define DLF_TASKS_SB_ROW_INPUT 1
+#define REST_TASKS_CDEF_INPUT 0
+#define REST_TASKS_LR_STRIPE_INPUT 1
+#define REST_TASKS_PAD_STRIPE_INPUT 2
+
 /**************************************
      * Process Results
      **************************************/
 typedef struct EncDecResults {
     EbDctor          dctor;
     EbObjectWrapper *pcs_wrapper_ptr;
+    uint32_t         input_type;
     uint32_t         completed_sb_row_index_start;
     uint32_t         completed_sb_row_count;
 } EncDecResults;
@@ -31,7 +38,8 @@ typedef struct DlfResults {
 typedef struct CdefResults {
     EbDctor          dctor;
     EbObjectWrapper *pcs_wrapper_ptr;
-    uint32_t         segment_index;
+    uint32_t         input_type;
+    uint32_t         segment_index; // rest segment, or stripe for the stripe jobs
 } CdefResults;
 
 typedef struct RestResults {
@@ -39,6 +47,7 @@ typedef struct RestResults {
     EbObjectWrapper *pcs_wrapper_ptr;
     uint32_t         completed_sb_row_index_start;
     uint32_t         completed_sb_row_count;
+    uint16_t         tile_index; // tile to entropy code when the picture has several
 } RestResults;
 
 typedef struct EncDecResultsInitData {
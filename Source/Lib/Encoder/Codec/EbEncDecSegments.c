@@ -7,6 +7,7 @@
 #include <string.h>
 
 #include "EbEncDecSegments.h"
+#include "EbUtility.h"
 
 static void enc_dec_segments_dctor(EbPtr p) {
     EncDecSegments *obj = (EncDecSegments *)p;
@@ -59,10 +60,18 @@ EbErrorType enc_dec_segments_ctor(EncDecSegments *segments_ptr, uint32_t segment
 }
 
 void enc_dec_segments_init(EncDecSegments *segments_ptr, uint32_t segColCount, uint32_t segRowCount,
-                           uint32_t pic_width_sb, uint32_t pic_height_sb) {
+                           uint32_t sb_x_start, uint32_t sb_y_start, uint32_t pic_width_sb,
+                           uint32_t pic_height_sb) {
     unsigned x, y, y_last;
     unsigned row_index, band_index, segment_index;
 
+    // At most one segment row / column per SB row / column of the area
+    segColCount = MIN(segColCount, pic_width_sb);
+    segRowCount = MIN(segRowCount, pic_height_sb);
+
+    segments_ptr->sb_x_start         = sb_x_start;
+    segments_ptr->sb_y_start         = sb_y_start;
+    segments_ptr->sb_col_count       = pic_width_sb;
     segments_ptr->sb_row_count       = pic_height_sb;
     segments_ptr->sb_band_count      = BAND_TOTAL_COUNT(pic_height_sb, pic_width_sb);
     segments_ptr->segment_row_count  = segRowCount;
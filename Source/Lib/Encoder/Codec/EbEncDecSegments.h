@@ -65,6 +65,10 @@ typedef struct EncDecSegments {
     uint32_t segment_ttl_count;
     uint32_t sb_band_count;
     uint32_t sb_row_count;
+    uint32_t sb_col_count;
+    // First SB of the area the segments cover, the whole picture or one tile
+    uint32_t sb_x_start;
+    uint32_t sb_y_start;
 
     uint32_t segment_max_band_count;
     uint32_t segment_max_row_count;
@@ -78,8 +82,8 @@ extern EbErrorType enc_dec_segments_ctor(EncDecSegments *segments_dbl_ptr,
                                          uint32_t segment_col_count, uint32_t segment_row_count);
 
 extern void enc_dec_segments_init(EncDecSegments *segments_ptr, uint32_t col_count,
-                                  uint32_t row_count, uint32_t pic_width_sb,
-                                  uint32_t pic_height_sb);
+                                  uint32_t row_count, uint32_t sb_x_start, uint32_t sb_y_start,
+                                  uint32_t pic_width_sb, uint32_t pic_height_sb);
 #ifdef __cplusplus
 }
 #endif
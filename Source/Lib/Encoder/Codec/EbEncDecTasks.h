@@ -24,6 +24,7 @@ typedef struct EncDecTasks {
     EbObjectWrapper *pcs_wrapper_ptr;
     uint32_t         input_type;
     int16_t          enc_dec_segment_row;
+    uint16_t         tile_index; // EncDec work unit, see PictureControlSet.enc_dec_segment_ctrl
 } EncDecTasks;
 
 typedef struct EncDecTasksInitData {
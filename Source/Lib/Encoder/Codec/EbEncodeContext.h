@@ -21,6 +21,7 @@
 #include "EbPredictionStructure.h"
 #include "EbRateControlTables.h"
 #include "EbObject.h"
+#include "EbNuma.h"
 
 // *Note - the queues are small for testing purposes.  They should be increased when they are done.
 #define PRE_ASSIGNMENT_MAX_DEPTH 128 // should be large enough to hold an entire prediction period
@@ -52,6 +53,8 @@ typedef struct EncodeContext {
     EbFifo *overlay_input_picture_pool_fifo_ptr;
     // Output Buffer Fifos
     EbFifo *stream_output_fifo_ptr;
+    // Bitstream buffers of the output stream packets
+    struct EbPacketPool *packet_pool_ptr;
     EbFifo *recon_output_fifo_ptr;
     EbFifo *statistics_output_fifo_ptr;
 
@@ -144,6 +147,10 @@ typedef struct EncodeContext {
     EbHandle         shared_reference_mutex;
     uint64_t picture_number_alt; // The picture number overlay includes all the overlay frames
     EbHandle stat_file_mutex;
+    // picture_generation - last generation given to a child PCS by PicMgr
+    uint64_t picture_generation;
+    // numa_stats - NUMA placement and EncDec task traffic of this encoder
+    EbNumaStats numa_stats;
 } EncodeContext;
 
 typedef struct EncodeContextInitData {
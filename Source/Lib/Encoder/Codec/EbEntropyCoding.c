@@ -1568,7 +1568,9 @@ static int16_t av1_mode_context_analyzer(const int16_t *const          mode_cont
 EbErrorType encode_slice_finish(EntropyCoder *entropy_coder_ptr) {
     EbErrorType return_error = EB_ErrorNone;
 
-    aom_stop_encode(&entropy_coder_ptr->ec_writer);
+    // The coded bytes did not fit in the bitstream buffer
+    if (aom_stop_encode(&entropy_coder_ptr->ec_writer) < 0)
+        return_error = EB_ErrorInsufficientResources;
 
     return return_error;
 }
@@ -4324,17 +4326,23 @@ EbErrorType write_frame_header_av1(Bitstream *bitstream_ptr, SequenceControlSet
 
     if (!show_existing) {
         // Add data from EC stream to Picture Stream.
-        int32_t              frame_size = (int32_t)(parent_pcs_ptr->av1_cm->tiles_info.tile_cols *
-                                                   parent_pcs_ptr->av1_cm->tiles_info.tile_rows ==
-                                               1
-                                           ? pcs_ptr->entropy_coder_ptr->ec_writer.pos
-                                           : pcs_ptr->entropy_coder_ptr->ec_frame_size);
-        OutputBitstreamUnit *ec_output_bitstream_ptr =
-            (OutputBitstreamUnit *)pcs_ptr->entropy_coder_ptr->ec_output_bitstream_ptr;
-        //****************************************************************//
-        // Copy from EC stream to frame stream
-        memcpy(data + curr_data_size, ec_output_bitstream_ptr->buffer_begin_av1, frame_size);
-        curr_data_size += (frame_size);
+        // The tiles are coded in their own streams; all but the last are prefixed by their size.
+        const uint16_t tile_cnt = (uint16_t)(parent_pcs_ptr->av1_cm->tiles_info.tile_cols *
+                                             parent_pcs_ptr->av1_cm->tiles_info.tile_rows);
+        for (uint16_t tile_idx = 0; tile_idx < tile_cnt; tile_idx++) {
+            EntropyCoder *       entropy_coder_ptr = pcs_ptr->ec_info[tile_idx]->entropy_coder_ptr;
+            const int32_t        tile_size         = (int32_t)entropy_coder_ptr->ec_writer.pos;
+            OutputBitstreamUnit *ec_output_bitstream_ptr =
+                (OutputBitstreamUnit *)entropy_coder_ptr->ec_output_bitstream_ptr;
+            if (tile_idx != tile_cnt - 1) {
+                mem_put_le32(data + curr_data_size, tile_size - AV1_MIN_TILE_SIZE_BYTES);
+                curr_data_size += 4;
+            }
+            //****************************************************************//
+            // Copy from EC stream to frame stream
+            memcpy(data + curr_data_size, ec_output_bitstream_ptr->buffer_begin_av1, tile_size);
+            curr_data_size += tile_size;
+        }
     }
     const uint32_t obu_payload_size  = curr_data_size - obu_header_size;
     const size_t   length_field_size = obu_mem_move(obu_header_size, obu_payload_size, data);
@@ -4417,6 +4425,7 @@ static void av1_write_delta_q_index(FRAME_CONTEXT *frame_context, int32_t delta_
     if (abs > 0) aom_write_bit(w, sign);
 }
 static void write_cdef(SequenceControlSet *seqCSetPtr, PictureControlSet *p_pcs_ptr,
+                       int32_t *cdef_preset,
                        //Av1Common *cm,
                        MacroBlockD *const xd, AomWriter *w, int32_t skip, int32_t mi_col,
                        int32_t mi_row) {
@@ -4440,8 +4449,7 @@ static void write_cdef(SequenceControlSet *seqCSetPtr, PictureControlSet *p_pcs_
     // Initialise when at top left part of the superblock
     if (!(mi_row & (seqCSetPtr->seq_header.sb_mi_size - 1)) &&
         !(mi_col & (seqCSetPtr->seq_header.sb_mi_size - 1))) { // Top left?
-        p_pcs_ptr->cdef_preset[0] = p_pcs_ptr->cdef_preset[1] = p_pcs_ptr->cdef_preset[2] =
-            p_pcs_ptr->cdef_preset[3]                         = -1;
+        cdef_preset[0] = cdef_preset[1] = cdef_preset[2] = cdef_preset[3] = -1;
     }
 
     // Emit CDEF param at first non-skip coding block
@@ -4450,16 +4458,16 @@ static void write_cdef(SequenceControlSet *seqCSetPtr, PictureControlSet *p_pcs_
                               ? !!(mi_col & mask) + 2 * !!(mi_row & mask)
                               : 0;
 
-    if (p_pcs_ptr->cdef_preset[index] == -1 && !skip) {
+    if (cdef_preset[index] == -1 && !skip) {
         aom_write_literal(w, mi->mbmi.cdef_strength, frm_hdr->cdef_params.cdef_bits);
-        p_pcs_ptr->cdef_preset[index] = mi->mbmi.cdef_strength;
+        cdef_preset[index] = mi->mbmi.cdef_strength;
     }
 }
 
-void eb_av1_reset_loop_restoration(PictureControlSet *piCSetPtr) {
+void eb_av1_reset_loop_restoration(EntropyTileInfo *tile_info) {
     for (int32_t p = 0; p < 3; ++p) {
-        set_default_wiener(piCSetPtr->wiener_info + p);
-        set_default_sgrproj(piCSetPtr->sgrproj_info + p);
+        set_default_wiener(tile_info->wiener_info + p);
+        set_default_sgrproj(tile_info->sgrproj_info + p);
     }
 }
 static void write_wiener_filter(int32_t wiener_win, const WienerInfo *wiener_info,
@@ -4536,7 +4544,7 @@ static void write_sgrproj_filter(const SgrprojInfo *sgrproj_info, SgrprojInfo *r
 
     memcpy(ref_sgrproj_info, sgrproj_info, sizeof(*sgrproj_info));
 }
-static void loop_restoration_write_sb_coeffs(PictureControlSet     *piCSetPtr, FRAME_CONTEXT           *frame_context, const Av1Common *const cm,
+static void loop_restoration_write_sb_coeffs(EntropyTileInfo       *tile_info, FRAME_CONTEXT           *frame_context, const Av1Common *const cm,
     //MacroBlockD *xd,
     const RestorationUnitInfo *rui,
     AomWriter *const w, int32_t plane/*,
@@ -4550,8 +4558,8 @@ static void loop_restoration_write_sb_coeffs(PictureControlSet     *piCSetPtr, F
     //    assert(!cm->all_lossless);
 
     const int32_t   wiener_win   = (plane > 0) ? WIENER_WIN_CHROMA : WIENER_WIN;
-    WienerInfo *    wiener_info  = piCSetPtr->wiener_info + plane;
-    SgrprojInfo *   sgrproj_info = piCSetPtr->sgrproj_info + plane;
+    WienerInfo *    wiener_info  = tile_info->wiener_info + plane;
+    SgrprojInfo *   sgrproj_info = tile_info->sgrproj_info + plane;
     RestorationType unit_rtype   = rui->restoration_type;
 
     assert(unit_rtype < CDF_SIZE(RESTORE_SWITCHABLE_TYPES));
@@ -4615,20 +4623,21 @@ EbErrorType ec_update_neighbors(PictureControlSet *pcs_ptr, EntropyCodingContext
                                 BlockSize bsize, EbPictureBufferDesc *coeff_ptr) {
     UNUSED(coeff_ptr);
     EbErrorType        return_error                     = EB_ErrorNone;
-    NeighborArrayUnit *mode_type_neighbor_array         = pcs_ptr->mode_type_neighbor_array;
-    NeighborArrayUnit *partition_context_neighbor_array = pcs_ptr->partition_context_neighbor_array;
-    NeighborArrayUnit *skip_flag_neighbor_array         = pcs_ptr->skip_flag_neighbor_array;
-    NeighborArrayUnit *skip_coeff_neighbor_array        = pcs_ptr->skip_coeff_neighbor_array;
+    EntropyTileInfo *  tile_info                        = pcs_ptr->ec_info[context_ptr->tile_idx];
+    NeighborArrayUnit *mode_type_neighbor_array         = tile_info->mode_type_neighbor_array;
+    NeighborArrayUnit *partition_context_neighbor_array = tile_info->partition_context_neighbor_array;
+    NeighborArrayUnit *skip_flag_neighbor_array         = tile_info->skip_flag_neighbor_array;
+    NeighborArrayUnit *skip_coeff_neighbor_array        = tile_info->skip_coeff_neighbor_array;
     NeighborArrayUnit *luma_dc_sign_level_coeff_neighbor_array =
-        pcs_ptr->luma_dc_sign_level_coeff_neighbor_array;
+        tile_info->luma_dc_sign_level_coeff_neighbor_array;
     NeighborArrayUnit *cr_dc_sign_level_coeff_neighbor_array =
-        pcs_ptr->cr_dc_sign_level_coeff_neighbor_array;
+        tile_info->cr_dc_sign_level_coeff_neighbor_array;
     NeighborArrayUnit *cb_dc_sign_level_coeff_neighbor_array =
-        pcs_ptr->cb_dc_sign_level_coeff_neighbor_array;
-    NeighborArrayUnit *  inter_pred_dir_neighbor_array = pcs_ptr->inter_pred_dir_neighbor_array;
-    NeighborArrayUnit *  ref_frame_type_neighbor_array = pcs_ptr->ref_frame_type_neighbor_array;
+        tile_info->cb_dc_sign_level_coeff_neighbor_array;
+    NeighborArrayUnit *  inter_pred_dir_neighbor_array = tile_info->inter_pred_dir_neighbor_array;
+    NeighborArrayUnit *  ref_frame_type_neighbor_array = tile_info->ref_frame_type_neighbor_array;
     NeighborArrayUnit32 *interpolation_type_neighbor_array =
-        pcs_ptr->interpolation_type_neighbor_array;
+        tile_info->interpolation_type_neighbor_array;
     const BlockGeom *blk_geom   = get_blk_geom_mds(blk_ptr->mds_idx);
     EbBool           skip_coeff = EB_FALSE;
     PartitionContext partition;
@@ -5259,7 +5268,7 @@ static INLINE int get_segment_id(Av1Common *cm, const uint8_t *segment_ids, Bloc
     return segment_id;
 }
 
-int get_spatial_seg_prediction(PictureControlSet *pcs_ptr, uint32_t blk_origin_x,
+int get_spatial_seg_prediction(PictureControlSet *pcs_ptr, MacroBlockD *xd, uint32_t blk_origin_x,
                                uint32_t blk_origin_y, int *cdf_index) {
     int prev_ul = -1; // top left segment_id
     int prev_l  = -1; // left segment_id
@@ -5268,8 +5277,9 @@ int get_spatial_seg_prediction(PictureControlSet *pcs_ptr, uint32_t blk_origin_x
     uint32_t mi_col = blk_origin_x >> MI_SIZE_LOG2;
     uint32_t mi_row = blk_origin_y >> MI_SIZE_LOG2;
 
-    EbBool                   left_available   = mi_col > 0 ? EB_TRUE : EB_FALSE;
-    EbBool                   up_available     = mi_row > 0 ? EB_TRUE : EB_FALSE;
+    // Tile bounds, the tiles are coded independently
+    EbBool                   left_available   = xd->left_available ? EB_TRUE : EB_FALSE;
+    EbBool                   up_available     = xd->up_available ? EB_TRUE : EB_FALSE;
     Av1Common *              cm               = pcs_ptr->parent_pcs_ptr->av1_cm;
     SegmentationNeighborMap *segmentation_map = pcs_ptr->segmentation_neighbor_map;
 
@@ -5326,9 +5336,9 @@ int eb_av1_neg_interleave(int x, int ref, int max) {
     }
 }
 
-int av1_get_pred_context_seg_id(PictureControlSet *pcs_ptr, CodingUnit *blk_ptr,
+int av1_get_pred_context_seg_id(EntropyTileInfo *tile_info, CodingUnit *blk_ptr,
                                 uint32_t blk_origin_x, uint32_t blk_origin_y) {
-    NeighborArrayUnit *seg_id_pred_neighbor_array = pcs_ptr->segmentation_id_pred_array;
+    NeighborArrayUnit *seg_id_pred_neighbor_array = tile_info->segmentation_id_pred_array;
     uint32_t top_idx = get_neighbor_array_unit_top_index(seg_id_pred_neighbor_array, blk_origin_x);
     uint32_t left_idx =
         get_neighbor_array_unit_left_index(seg_id_pred_neighbor_array, blk_origin_y);
@@ -5340,12 +5350,12 @@ int av1_get_pred_context_seg_id(PictureControlSet *pcs_ptr, CodingUnit *blk_ptr,
     return above_pred + left_pred;
 }
 
-AomCdfProb *av1_get_pred_cdf_seg_id(PictureControlSet *pcs_ptr, FRAME_CONTEXT *frame_context,
+AomCdfProb *av1_get_pred_cdf_seg_id(EntropyTileInfo *tile_info, FRAME_CONTEXT *frame_context,
                                     CodingUnit *blk_ptr, uint32_t blk_origin_x,
                                     uint32_t blk_origin_y) {
     struct segmentation_probs *segp = &frame_context->seg;
     return segp->spatial_pred_seg_cdf[av1_get_pred_context_seg_id(
-        pcs_ptr, blk_ptr, blk_origin_x, blk_origin_y)];
+        tile_info, blk_ptr, blk_origin_x, blk_origin_y)];
 }
 
 static INLINE void update_segmentation_map(PictureControlSet *pcs_ptr, BlockSize bsize,
@@ -5372,7 +5382,8 @@ void write_segment_id(PictureControlSet *pcs_ptr, FRAME_CONTEXT *frame_context,
     SegmentationParams *segmentation_params = &pcs_ptr->parent_pcs_ptr->frm_hdr.segmentation_params;
     if (!segmentation_params->segmentation_enabled) return;
     int       cdf_num;
-    const int pred = get_spatial_seg_prediction(pcs_ptr, blk_origin_x, blk_origin_y, &cdf_num);
+    const int pred =
+        get_spatial_seg_prediction(pcs_ptr, blk_ptr->av1xd, blk_origin_x, blk_origin_y, &cdf_num);
     if (skip_coeff) {
         //        SVT_LOG("BlockY = %d, BlockX = %d \n", blk_origin_y>>2, blk_origin_x>>2);
         update_segmentation_map(pcs_ptr, bsize, blk_origin_x, blk_origin_y, pred);
@@ -5480,20 +5491,21 @@ EbErrorType write_modes_b(PictureControlSet *pcs_ptr, EntropyCodingContext *cont
     SequenceControlSet *scs_ptr       = (SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr;
     FrameHeader *       frm_hdr       = &pcs_ptr->parent_pcs_ptr->frm_hdr;
 
-    NeighborArrayUnit *mode_type_neighbor_array       = pcs_ptr->mode_type_neighbor_array;
-    NeighborArrayUnit *intra_luma_mode_neighbor_array = pcs_ptr->intra_luma_mode_neighbor_array;
-    NeighborArrayUnit *skip_flag_neighbor_array       = pcs_ptr->skip_flag_neighbor_array;
-    NeighborArrayUnit *skip_coeff_neighbor_array      = pcs_ptr->skip_coeff_neighbor_array;
+    EntropyTileInfo *  tile_info                      = pcs_ptr->ec_info[context_ptr->tile_idx];
+    NeighborArrayUnit *mode_type_neighbor_array       = tile_info->mode_type_neighbor_array;
+    NeighborArrayUnit *intra_luma_mode_neighbor_array = tile_info->intra_luma_mode_neighbor_array;
+    NeighborArrayUnit *skip_flag_neighbor_array       = tile_info->skip_flag_neighbor_array;
+    NeighborArrayUnit *skip_coeff_neighbor_array      = tile_info->skip_coeff_neighbor_array;
     NeighborArrayUnit *luma_dc_sign_level_coeff_neighbor_array =
-        pcs_ptr->luma_dc_sign_level_coeff_neighbor_array;
+        tile_info->luma_dc_sign_level_coeff_neighbor_array;
     NeighborArrayUnit *cr_dc_sign_level_coeff_neighbor_array =
-        pcs_ptr->cr_dc_sign_level_coeff_neighbor_array;
+        tile_info->cr_dc_sign_level_coeff_neighbor_array;
     NeighborArrayUnit *cb_dc_sign_level_coeff_neighbor_array =
-        pcs_ptr->cb_dc_sign_level_coeff_neighbor_array;
-    NeighborArrayUnit *  ref_frame_type_neighbor_array = pcs_ptr->ref_frame_type_neighbor_array;
+        tile_info->cb_dc_sign_level_coeff_neighbor_array;
+    NeighborArrayUnit *  ref_frame_type_neighbor_array = tile_info->ref_frame_type_neighbor_array;
     NeighborArrayUnit32 *interpolation_type_neighbor_array =
-        pcs_ptr->interpolation_type_neighbor_array;
-    NeighborArrayUnit *txfm_context_array = pcs_ptr->txfm_context_array;
+        tile_info->interpolation_type_neighbor_array;
+    NeighborArrayUnit *txfm_context_array = tile_info->txfm_context_array;
     const BlockGeom *  blk_geom           = get_blk_geom_mds(blk_ptr->mds_idx);
     uint32_t           blk_origin_x       = context_ptr->sb_origin_x + blk_geom->origin_x;
     uint32_t           blk_origin_y       = context_ptr->sb_origin_y + blk_geom->origin_y;
@@ -5558,6 +5570,7 @@ EbErrorType write_modes_b(PictureControlSet *pcs_ptr, EntropyCodingContext *cont
 
         write_cdef(scs_ptr,
                    pcs_ptr,
+                   tile_info->cdef_preset,
                    blk_ptr->av1xd,
                    ec_writer,
                    skip_coeff,
@@ -5572,7 +5585,7 @@ EbErrorType write_modes_b(PictureControlSet *pcs_ptr, EntropyCodingContext *cont
                 super_block_upper_left) {
                 assert(current_q_index > 0);
                 int32_t reduced_delta_qindex =
-                    (current_q_index - pcs_ptr->parent_pcs_ptr->prev_qindex) /
+                    (current_q_index - tile_info->prev_qindex) /
                     frm_hdr->delta_q_params.delta_q_res;
 
                 //write_delta_qindex(xd, reduced_delta_qindex, w);
@@ -5582,9 +5595,9 @@ EbErrorType write_modes_b(PictureControlSet *pcs_ptr, EntropyCodingContext *cont
                 blk_origin_x,
                 blk_origin_y,
                 current_q_index,
-                pcs_ptr->parent_pcs_ptr->prev_qindex);
+                tile_info->prev_qindex);
                 }*/
-                pcs_ptr->parent_pcs_ptr->prev_qindex = current_q_index;
+                tile_info->prev_qindex = current_q_index;
             }
         }
 
@@ -5746,7 +5759,8 @@ EbErrorType write_modes_b(PictureControlSet *pcs_ptr, EntropyCodingContext *cont
                                skip_coeff,
                                0);
         write_cdef(scs_ptr,
-                   pcs_ptr, /*cm,*/
+                   pcs_ptr,
+                   tile_info->cdef_preset, /*cm,*/
                    blk_ptr->av1xd,
                    ec_writer,
                    blk_ptr->skip_flag ? 1 : skip_coeff,
@@ -5761,10 +5775,10 @@ EbErrorType write_modes_b(PictureControlSet *pcs_ptr, EntropyCodingContext *cont
                 super_block_upper_left) {
                 assert(current_q_index > 0);
                 int32_t reduced_delta_qindex =
-                    (current_q_index - pcs_ptr->parent_pcs_ptr->prev_qindex) /
+                    (current_q_index - tile_info->prev_qindex) /
                     frm_hdr->delta_q_params.delta_q_res;
                 av1_write_delta_q_index(frame_context, reduced_delta_qindex, ec_writer);
-                pcs_ptr->parent_pcs_ptr->prev_qindex = current_q_index;
+                tile_info->prev_qindex = current_q_index;
             }
         }
         if (frm_hdr->tx_mode == TX_MODE_SELECT) {
@@ -6131,7 +6145,8 @@ EB_EXTERN EbErrorType write_sb(EntropyCodingContext *context_ptr, SuperBlock *tb
     FRAME_CONTEXT *     frame_context = entropy_coder_ptr->fc;
     AomWriter *         ec_writer     = &entropy_coder_ptr->ec_writer;
     SequenceControlSet *scs_ptr       = (SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr;
-    NeighborArrayUnit *partition_context_neighbor_array = pcs_ptr->partition_context_neighbor_array;
+    EntropyTileInfo *   tile_info     = pcs_ptr->ec_info[context_ptr->tile_idx];
+    NeighborArrayUnit *partition_context_neighbor_array = tile_info->partition_context_neighbor_array;
 
     // CU Varaiables
     const BlockGeom *blk_geom;
@@ -6197,7 +6212,7 @@ EB_EXTERN EbErrorType write_sb(EntropyCodingContext *context_ptr, SuperBlock *tb
                                 const RestorationUnitInfo *rui =
                                     &cm->rst_info[plane].unit_info[runit_idx];
                                 loop_restoration_write_sb_coeffs(
-                                    pcs_ptr, frame_context, cm, /*xd,*/ rui, ec_writer, plane);
+                                    tile_info, frame_context, cm, /*xd,*/ rui, ec_writer, plane);
                             }
                         }
                     }
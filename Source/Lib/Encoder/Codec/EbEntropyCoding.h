@@ -36,6 +36,7 @@ extern "C" {
 
 #define MAX_TILE_WIDTH (4096) // Max Tile width in pixels
 #define MAX_TILE_AREA (4096 * 2304) // Maximum tile area in pixels
+#define AV1_MIN_TILE_SIZE_BYTES 1
 
 #define CHECK_BACKWARD_REFS(ref_frame) \
     (((ref_frame) >= BWDREF_FRAME) && ((ref_frame) <= ALTREF_FRAME))
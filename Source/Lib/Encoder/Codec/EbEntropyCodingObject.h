@@ -24,7 +24,6 @@ typedef struct EntropyCoder {
     FRAME_CONTEXT *fc; /* this frame entropy */
     AomWriter      ec_writer;
     EbPtr          ec_output_bitstream_ptr;
-    uint64_t       ec_frame_size;
 } EntropyCoder;
 
 extern EbErrorType bitstream_ctor(Bitstream *bitstream_ptr, uint32_t buffer_size);
@@ -23,12 +23,14 @@
 #include "EbRateControlTasks.h"
 #include "EbCabacContextModel.h"
 #include "EbLog.h"
-#define AV1_MIN_TILE_SIZE_BYTES 1
-void eb_av1_reset_loop_restoration(PictureControlSet *piCSetPtr);
+#include "EbPipelineStats.h"
+#include "EbSvtAv1ErrorCodes.h"
+void eb_av1_reset_loop_restoration(EntropyTileInfo *tile_info);
 
 static void rest_context_dctor(EbPtr p) {
     EbThreadContext *     thread_context_ptr = (EbThreadContext *)p;
     EntropyCodingContext *obj                = (EntropyCodingContext *)thread_context_ptr->priv;
+    EB_FREE_ARRAY(obj->palette_tok);
     EB_FREE_ARRAY(obj);
 }
 
@@ -46,6 +48,9 @@ EbErrorType entropy_coding_context_ctor(EbThreadContext *  thread_context_ptr,
     context_ptr->is_16bit = (EbBool)(
         enc_handle_ptr->scs_instance_array[0]->scs_ptr->static_config.encoder_bit_depth > EB_8BIT);
     ;
+    // One palette token for each pixel of the SB, there can be palettes on two planes
+    if (enc_handle_ptr->scs_instance_array[0]->scs_ptr->static_config.screen_content_mode)
+        EB_CALLOC_ARRAY(context_ptr->palette_tok, 2 * MAX_SB_SIZE * MAX_SB_SIZE);
 
     // Input/Output System Resource Manager FIFOs
     context_ptr->enc_dec_input_fifo_ptr =
@@ -61,27 +66,49 @@ EbErrorType entropy_coding_context_ctor(EbThreadContext *  thread_context_ptr,
 /***********************************************
  * Entropy Coding Reset Neighbor Arrays
  ***********************************************/
-static void entropy_coding_reset_neighbor_arrays(PictureControlSet *pcs_ptr) {
-    neighbor_array_unit_reset(pcs_ptr->mode_type_neighbor_array);
+static void entropy_coding_reset_neighbor_arrays(EntropyTileInfo *tile_info) {
+    neighbor_array_unit_reset(tile_info->mode_type_neighbor_array);
 
-    neighbor_array_unit_reset(pcs_ptr->partition_context_neighbor_array);
+    neighbor_array_unit_reset(tile_info->partition_context_neighbor_array);
 
-    neighbor_array_unit_reset(pcs_ptr->skip_flag_neighbor_array);
+    neighbor_array_unit_reset(tile_info->skip_flag_neighbor_array);
 
-    neighbor_array_unit_reset(pcs_ptr->skip_coeff_neighbor_array);
-    neighbor_array_unit_reset(pcs_ptr->luma_dc_sign_level_coeff_neighbor_array);
-    neighbor_array_unit_reset(pcs_ptr->cb_dc_sign_level_coeff_neighbor_array);
-    neighbor_array_unit_reset(pcs_ptr->cr_dc_sign_level_coeff_neighbor_array);
-    neighbor_array_unit_reset(pcs_ptr->inter_pred_dir_neighbor_array);
-    neighbor_array_unit_reset(pcs_ptr->ref_frame_type_neighbor_array);
+    neighbor_array_unit_reset(tile_info->skip_coeff_neighbor_array);
+    neighbor_array_unit_reset(tile_info->luma_dc_sign_level_coeff_neighbor_array);
+    neighbor_array_unit_reset(tile_info->cb_dc_sign_level_coeff_neighbor_array);
+    neighbor_array_unit_reset(tile_info->cr_dc_sign_level_coeff_neighbor_array);
+    neighbor_array_unit_reset(tile_info->inter_pred_dir_neighbor_array);
+    neighbor_array_unit_reset(tile_info->ref_frame_type_neighbor_array);
 
-    neighbor_array_unit_reset(pcs_ptr->intra_luma_mode_neighbor_array);
-    neighbor_array_unit_reset32(pcs_ptr->interpolation_type_neighbor_array);
-    neighbor_array_unit_reset(pcs_ptr->txfm_context_array);
-    neighbor_array_unit_reset(pcs_ptr->segmentation_id_pred_array);
+    neighbor_array_unit_reset(tile_info->intra_luma_mode_neighbor_array);
+    neighbor_array_unit_reset32(tile_info->interpolation_type_neighbor_array);
+    neighbor_array_unit_reset(tile_info->txfm_context_array);
+    neighbor_array_unit_reset(tile_info->segmentation_id_pred_array);
     return;
 }
 
+/***********************************************
+ * Entropy Coding Set Neighbor Arrays Origin
+ *   The arrays only cover the tile, the chroma
+ *   ones are in chroma samples.
+ ***********************************************/
+static void entropy_coding_set_neighbor_arrays_origin(EntropyTileInfo *tile_info, uint32_t x,
+                                                      uint32_t y) {
+    neighbor_array_unit_set_origin(tile_info->mode_type_neighbor_array, x, y);
+    neighbor_array_unit_set_origin(tile_info->partition_context_neighbor_array, x, y);
+    neighbor_array_unit_set_origin(tile_info->skip_flag_neighbor_array, x, y);
+    neighbor_array_unit_set_origin(tile_info->skip_coeff_neighbor_array, x, y);
+    neighbor_array_unit_set_origin(tile_info->luma_dc_sign_level_coeff_neighbor_array, x, y);
+    neighbor_array_unit_set_origin(tile_info->cb_dc_sign_level_coeff_neighbor_array, x >> 1, y >> 1);
+    neighbor_array_unit_set_origin(tile_info->cr_dc_sign_level_coeff_neighbor_array, x >> 1, y >> 1);
+    neighbor_array_unit_set_origin(tile_info->inter_pred_dir_neighbor_array, x, y);
+    neighbor_array_unit_set_origin(tile_info->ref_frame_type_neighbor_array, x, y);
+    neighbor_array_unit_set_origin(tile_info->intra_luma_mode_neighbor_array, x, y);
+    neighbor_array_unit_set_origin32(tile_info->interpolation_type_neighbor_array, x, y);
+    neighbor_array_unit_set_origin(tile_info->txfm_context_array, x, y);
+    neighbor_array_unit_set_origin(tile_info->segmentation_id_pred_array, x, y);
+}
+
 void av1_get_syntax_rate_from_cdf(int32_t *costs, const AomCdfProb *cdf, const int32_t *inv_map);
 
 void eb_av1_cost_tokens_from_cdf(int32_t *costs, const AomCdfProb *cdf, const int32_t *inv_map) {
@@ -164,20 +191,24 @@ void eb_av1_build_nmv_cost_table(int32_t *mvjoint, int32_t *mvcost[2], const Nmv
 }
 
 /**************************************************
- * Reset Entropy Coding Picture
+ * Reset Entropy Coding Tile
+ *   Every tile, including the only tile of a
+ *   single-tile picture, starts from the frame CDFs
+ *   with its own coder, bitstream and neighbors.
  **************************************************/
-static void reset_entropy_coding_picture(EntropyCodingContext *context_ptr,
-                                         PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr) {
-    reset_bitstream(entropy_coder_get_bitstream_ptr(pcs_ptr->entropy_coder_ptr));
+static void reset_ec_tile(EntropyCodingContext *context_ptr, PictureControlSet *pcs_ptr,
+                          SequenceControlSet *scs_ptr) {
+    EntropyTileInfo *tile_info         = pcs_ptr->ec_info[context_ptr->tile_idx];
+    EntropyCoder *   entropy_coder_ptr = tile_info->entropy_coder_ptr;
+    reset_bitstream(entropy_coder_get_bitstream_ptr(entropy_coder_ptr));
 
     uint32_t entropy_coding_qp;
 
     context_ptr->is_16bit = (EbBool)(scs_ptr->static_config.encoder_bit_depth > EB_8BIT);
     FrameHeader *frm_hdr  = &pcs_ptr->parent_pcs_ptr->frm_hdr;
     // Asuming cb and cr offset to be the same for chroma QP in both slice and pps for lambda computation
-    entropy_coding_qp = pcs_ptr->parent_pcs_ptr->frm_hdr.quantization_params.base_q_idx;
-    pcs_ptr->parent_pcs_ptr->prev_qindex =
-        pcs_ptr->parent_pcs_ptr->frm_hdr.quantization_params.base_q_idx;
+    entropy_coding_qp      = pcs_ptr->parent_pcs_ptr->frm_hdr.quantization_params.base_q_idx;
+    tile_info->prev_qindex = pcs_ptr->parent_pcs_ptr->frm_hdr.quantization_params.base_q_idx;
     if (pcs_ptr->parent_pcs_ptr->frm_hdr.allow_intrabc)
         assert(pcs_ptr->parent_pcs_ptr->frm_hdr.delta_lf_params.delta_lf_present == 0);
     if (pcs_ptr->parent_pcs_ptr->frm_hdr.delta_lf_params.delta_lf_present) {
@@ -190,78 +221,37 @@ static void reset_entropy_coding_picture(EntropyCodingContext *context_ptr,
 
     // pass the ent
     OutputBitstreamUnit *output_bitstream_ptr =
-        (OutputBitstreamUnit *)(pcs_ptr->entropy_coder_ptr->ec_output_bitstream_ptr);
+        (OutputBitstreamUnit *)(entropy_coder_ptr->ec_output_bitstream_ptr);
     //****************************************************************//
 
     uint8_t *data = output_bitstream_ptr->buffer_av1;
-    pcs_ptr->entropy_coder_ptr->ec_writer.allow_update_cdf =
-        !pcs_ptr->parent_pcs_ptr->large_scale_tile;
-    pcs_ptr->entropy_coder_ptr->ec_writer.allow_update_cdf =
-        pcs_ptr->entropy_coder_ptr->ec_writer.allow_update_cdf && !frm_hdr->disable_cdf_update;
-    aom_start_encode(&pcs_ptr->entropy_coder_ptr->ec_writer, data);
+    entropy_coder_ptr->ec_writer.allow_update_cdf = !pcs_ptr->parent_pcs_ptr->large_scale_tile;
+    entropy_coder_ptr->ec_writer.allow_update_cdf =
+        entropy_coder_ptr->ec_writer.allow_update_cdf && !frm_hdr->disable_cdf_update;
+    aom_start_encode(&entropy_coder_ptr->ec_writer,
+                     data,
+                     output_bitstream_ptr->size -
+                         (uint32_t)(data - output_bitstream_ptr->buffer_begin_av1));
 
     // ADD Reset here
     if (pcs_ptr->parent_pcs_ptr->frm_hdr.primary_ref_frame != PRIMARY_REF_NONE)
-        memcpy(pcs_ptr->entropy_coder_ptr->fc,
+        memcpy(entropy_coder_ptr->fc,
                &pcs_ptr->ref_frame_context[pcs_ptr->parent_pcs_ptr->frm_hdr.primary_ref_frame],
                sizeof(FRAME_CONTEXT));
     else
-        reset_entropy_coder(scs_ptr->encode_context_ptr,
-                            pcs_ptr->entropy_coder_ptr,
-                            entropy_coding_qp,
-                            pcs_ptr->slice_type);
-    entropy_coding_reset_neighbor_arrays(pcs_ptr);
-
-    return;
-}
-
-static void reset_ec_tile(uint32_t total_size, uint32_t is_last_tile_in_tg,
-                          EntropyCodingContext *context_ptr, PictureControlSet *pcs_ptr,
-                          SequenceControlSet *scs_ptr) {
-    reset_bitstream(entropy_coder_get_bitstream_ptr(pcs_ptr->entropy_coder_ptr));
-
-    uint32_t entropy_coding_qp;
-
-    context_ptr->is_16bit = (EbBool)(scs_ptr->static_config.encoder_bit_depth > EB_8BIT);
-    FrameHeader *frm_hdr  = &pcs_ptr->parent_pcs_ptr->frm_hdr;
-    entropy_coding_qp     = pcs_ptr->parent_pcs_ptr->frm_hdr.quantization_params.base_q_idx;
-    pcs_ptr->parent_pcs_ptr->prev_qindex =
-        pcs_ptr->parent_pcs_ptr->frm_hdr.quantization_params.base_q_idx;
-    if (pcs_ptr->parent_pcs_ptr->frm_hdr.allow_intrabc)
-        assert(pcs_ptr->parent_pcs_ptr->frm_hdr.delta_lf_params.delta_lf_present == 0);
-    if (pcs_ptr->parent_pcs_ptr->frm_hdr.delta_lf_params.delta_lf_present) {
-        pcs_ptr->parent_pcs_ptr->prev_delta_lf_from_base = 0;
-        const int32_t frame_lf_count =
-            pcs_ptr->parent_pcs_ptr->monochrome == 0 ? FRAME_LF_COUNT : FRAME_LF_COUNT - 2;
-        for (int32_t lf_id = 0; lf_id < frame_lf_count; ++lf_id)
-            pcs_ptr->parent_pcs_ptr->prev_delta_lf[lf_id] = 0;
+        reset_entropy_coder(
+            scs_ptr->encode_context_ptr, entropy_coder_ptr, entropy_coding_qp, pcs_ptr->slice_type);
+    entropy_coding_reset_neighbor_arrays(tile_info);
+    {
+        const TilesInfo *tiles_info = &pcs_ptr->parent_pcs_ptr->av1_cm->tiles_info;
+        const int        tile_row   = context_ptr->tile_idx / tiles_info->tile_cols;
+        const int        tile_col   = context_ptr->tile_idx % tiles_info->tile_cols;
+        entropy_coding_set_neighbor_arrays_origin(
+            tile_info,
+            tiles_info->tile_col_start_mi[tile_col] << MI_SIZE_LOG2,
+            tiles_info->tile_row_start_mi[tile_row] << MI_SIZE_LOG2);
     }
-    // pass the ent
-    OutputBitstreamUnit *output_bitstream_ptr =
-        (OutputBitstreamUnit *)(pcs_ptr->entropy_coder_ptr->ec_output_bitstream_ptr);
-    //****************************************************************//
-
-    uint8_t *data = output_bitstream_ptr->buffer_av1 + total_size;
-    pcs_ptr->entropy_coder_ptr->ec_writer.allow_update_cdf =
-        !pcs_ptr->parent_pcs_ptr->large_scale_tile;
-    pcs_ptr->entropy_coder_ptr->ec_writer.allow_update_cdf =
-        pcs_ptr->entropy_coder_ptr->ec_writer.allow_update_cdf && !frm_hdr->disable_cdf_update;
-
-    //if not last tile, advance buffer by 4B to leave space for tile Size
-    if (is_last_tile_in_tg == 0) data += 4;
-
-    aom_start_encode(&pcs_ptr->entropy_coder_ptr->ec_writer, data);
-    if (pcs_ptr->parent_pcs_ptr->frm_hdr.primary_ref_frame != PRIMARY_REF_NONE)
-        memcpy(pcs_ptr->entropy_coder_ptr->fc,
-               &pcs_ptr->ref_frame_context[pcs_ptr->parent_pcs_ptr->frm_hdr.primary_ref_frame],
-               sizeof(FRAME_CONTEXT));
-    else
-        //reset probabilities
-        reset_entropy_coder(scs_ptr->encode_context_ptr,
-                            pcs_ptr->entropy_coder_ptr,
-                            entropy_coding_qp,
-                            pcs_ptr->slice_type);
-    entropy_coding_reset_neighbor_arrays(pcs_ptr);
+    eb_av1_reset_loop_restoration(tile_info);
 
     return;
 }
@@ -359,22 +349,123 @@ void write_stat_to_file(SequenceControlSet *scs_ptr, StatStruct stat_struct, uin
 }
 
 /******************************************************
- * Entropy Coding Kernel
+ * Entropy Coding Finish Picture
+ *   Called once per picture, by the thread coding the
+ *   last SB-row or the last tile: releases the
+ *   references and posts the picture to packetization.
  ******************************************************/
-void *entropy_coding_kernel(void *input_ptr) {
+static void entropy_coding_finish_picture(EntropyCodingContext *context_ptr,
+                                          PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr,
+                                          EbObjectWrapper *pcs_wrapper_ptr) {
+    EbObjectWrapper *     entropy_coding_results_wrapper_ptr;
+    EntropyCodingResults *entropy_coding_results_ptr;
+    uint32_t              ref_idx;
+
+    // for Non Reference frames
+    if (scs_ptr->use_output_stat_file && !pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag)
+        write_stat_to_file(scs_ptr,
+                           *pcs_ptr->parent_pcs_ptr->stat_struct_first_pass_ptr,
+                           pcs_ptr->parent_pcs_ptr->picture_number);
+    // Release the List 0 Reference Pictures
+    for (ref_idx = 0; ref_idx < pcs_ptr->parent_pcs_ptr->ref_list0_count; ++ref_idx) {
+        if (scs_ptr->use_output_stat_file && pcs_ptr->ref_pic_ptr_array[0][ref_idx] != EB_NULL &&
+            pcs_ptr->ref_pic_ptr_array[0][ref_idx]->live_count == 1)
+            write_stat_to_file(
+                scs_ptr,
+                ((EbReferenceObject *)pcs_ptr->ref_pic_ptr_array[0][ref_idx]->object_ptr)
+                    ->stat_struct,
+                ((EbReferenceObject *)pcs_ptr->ref_pic_ptr_array[0][ref_idx]->object_ptr)
+                    ->ref_poc);
+        if (pcs_ptr->ref_pic_ptr_array[0][ref_idx] != EB_NULL) {
+            eb_release_object(pcs_ptr->ref_pic_ptr_array[0][ref_idx]);
+        }
+    }
+
+    // Release the List 1 Reference Pictures
+    for (ref_idx = 0; ref_idx < pcs_ptr->parent_pcs_ptr->ref_list1_count; ++ref_idx) {
+        if (scs_ptr->use_output_stat_file && pcs_ptr->ref_pic_ptr_array[1][ref_idx] != EB_NULL &&
+            pcs_ptr->ref_pic_ptr_array[1][ref_idx]->live_count == 1)
+            write_stat_to_file(
+                scs_ptr,
+                ((EbReferenceObject *)pcs_ptr->ref_pic_ptr_array[1][ref_idx]->object_ptr)
+                    ->stat_struct,
+                ((EbReferenceObject *)pcs_ptr->ref_pic_ptr_array[1][ref_idx]->object_ptr)
+                    ->ref_poc);
+        if (pcs_ptr->ref_pic_ptr_array[1][ref_idx] != EB_NULL)
+            eb_release_object(pcs_ptr->ref_pic_ptr_array[1][ref_idx]);
+    }
+
+    // Get Empty Entropy Coding Results
+    eb_get_empty_object(context_ptr->entropy_coding_output_fifo_ptr,
+                        &entropy_coding_results_wrapper_ptr);
+    entropy_coding_results_ptr =
+        (EntropyCodingResults *)entropy_coding_results_wrapper_ptr->object_ptr;
+    entropy_coding_results_ptr->pcs_wrapper_ptr = pcs_wrapper_ptr;
+
+    // Post EntropyCoding Results
+    eb_post_full_object(entropy_coding_results_wrapper_ptr);
+}
+
+/******************************************************
+ * Entropy Code Tile
+ *   Codes the SBs of one tile into the tile's own
+ *   bitstream. The tiles of a picture are independent
+ *   and are coded concurrently by the EC threads;
+ *   packetization concatenates them.
+ ******************************************************/
+static uint64_t entropy_code_tile(EntropyCodingContext *context_ptr, PictureControlSet *pcs_ptr,
+                                  SequenceControlSet *scs_ptr, uint32_t pic_width_in_sb) {
+    Av1Common *const cm           = pcs_ptr->parent_pcs_ptr->av1_cm;
+    const int        tile_cols    = cm->tiles_info.tile_cols;
+    const int        tile_row     = context_ptr->tile_idx / tile_cols;
+    const int        tile_col     = context_ptr->tile_idx % tile_cols;
+    const int        sb_mi_log2   = scs_ptr->seq_header.sb_size_log2;
+    const uint32_t   sb_size_log2 = Log2f(context_ptr->sb_sz);
+    EntropyCoder *   entropy_coder_ptr = pcs_ptr->ec_info[context_ptr->tile_idx]->entropy_coder_ptr;
+    uint64_t         tile_bits         = 0;
+    uint32_t         x_sb_index, y_sb_index;
+
+    reset_ec_tile(context_ptr, pcs_ptr, scs_ptr);
+    for (y_sb_index = cm->tiles_info.tile_row_start_mi[tile_row] >> sb_mi_log2;
+         y_sb_index < ((uint32_t)cm->tiles_info.tile_row_start_mi[tile_row + 1] >> sb_mi_log2);
+         y_sb_index++) {
+        for (x_sb_index = cm->tiles_info.tile_col_start_mi[tile_col] >> sb_mi_log2;
+             x_sb_index <
+             ((uint32_t)cm->tiles_info.tile_col_start_mi[tile_col + 1] >> sb_mi_log2);
+             x_sb_index++) {
+            uint16_t    sb_index = (uint16_t)(x_sb_index + y_sb_index * pic_width_in_sb);
+            SuperBlock *sb_ptr   = pcs_ptr->sb_ptr_array[sb_index];
+            context_ptr->sb_origin_x = x_sb_index << sb_size_log2;
+            context_ptr->sb_origin_y = y_sb_index << sb_size_log2;
+            context_ptr->tok         = context_ptr->palette_tok;
+            uint32_t prev_pos        = entropy_coder_ptr->ec_writer.ec.offs;
+            write_sb(context_ptr, sb_ptr, pcs_ptr, entropy_coder_ptr, sb_ptr->quantized_coeff);
+            sb_ptr->total_bits = (entropy_coder_ptr->ec_writer.ec.offs - prev_pos) << 3;
+            tile_bits += sb_ptr->total_bits;
+        }
+    }
+    CHECK_REPORT_ERROR(encode_slice_finish(entropy_coder_ptr) == EB_ErrorNone,
+                       scs_ptr->encode_context_ptr->app_callback_ptr,
+                       EB_ENC_EC_ERROR3);
+    assert(entropy_coder_ptr->ec_writer.pos >= AV1_MIN_TILE_SIZE_BYTES);
+
+    return tile_bits;
+}
+
+/******************************************************
+ * Entropy Coding Job
+ *   Processes one Rest result: SB-rows of a single-tile
+ *   picture, or one tile of a multi-tile picture.
+ ******************************************************/
+void entropy_coding_job(EbThreadContext *thread_context_ptr,
+                        EbObjectWrapper *rest_results_wrapper_ptr) {
     // Context & SCS & PCS
-    EbThreadContext *     thread_context_ptr = (EbThreadContext *)input_ptr;
-    EntropyCodingContext *context_ptr        = (EntropyCodingContext *)thread_context_ptr->priv;
+    EntropyCodingContext *context_ptr = (EntropyCodingContext *)thread_context_ptr->priv;
     PictureControlSet *   pcs_ptr;
     SequenceControlSet *  scs_ptr;
 
     // Input
-    EbObjectWrapper *enc_dec_results_wrapper_ptr;
-    EncDecResults *  enc_dec_results_ptr;
-
-    // Output
-    EbObjectWrapper *     entropy_coding_results_wrapper_ptr;
-    EntropyCodingResults *entropy_coding_results_ptr;
+    RestResults *rest_results_ptr;
 
     // SB Loop variables
     SuperBlock *sb_ptr;
@@ -388,260 +479,130 @@ void *entropy_coding_kernel(void *input_ptr) {
     uint32_t    pic_width_in_sb;
     // Variables
     EbBool initial_process_call;
-    for (;;) {
-        // Get Mode Decision Results
-        eb_get_full_object(context_ptr->enc_dec_input_fifo_ptr, &enc_dec_results_wrapper_ptr);
-        enc_dec_results_ptr = (EncDecResults *)enc_dec_results_wrapper_ptr->object_ptr;
-        pcs_ptr             = (PictureControlSet *)enc_dec_results_ptr->pcs_wrapper_ptr->object_ptr;
-        scs_ptr             = (SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr;
-        // SB Constants
-
-        sb_sz = (uint8_t)scs_ptr->sb_size_pix;
-
-        sb_size_log2       = (uint8_t)Log2f(sb_sz);
-        context_ptr->sb_sz = sb_sz;
-        pic_width_in_sb    = (scs_ptr->seq_header.max_frame_width + sb_sz - 1) >> sb_size_log2;
-        if (pcs_ptr->parent_pcs_ptr->av1_cm->tiles_info.tile_cols *
-                pcs_ptr->parent_pcs_ptr->av1_cm->tiles_info.tile_rows ==
-            1)
-
-        {
-            initial_process_call = EB_TRUE;
-            y_sb_index           = enc_dec_results_ptr->completed_sb_row_index_start;
-
-            // SB-loops
-            while (update_entropy_coding_rows(pcs_ptr,
-                                              &y_sb_index,
-                                              enc_dec_results_ptr->completed_sb_row_count,
-                                              &initial_process_call) == EB_TRUE) {
-                uint32_t row_total_bits = 0;
-
-                if (y_sb_index == 0) {
-                    reset_entropy_coding_picture(context_ptr, pcs_ptr, scs_ptr);
-                    pcs_ptr->entropy_coding_pic_done = EB_FALSE;
-                }
-
-                for (x_sb_index = 0; x_sb_index < pic_width_in_sb; ++x_sb_index) {
-                    sb_index = (uint16_t)(x_sb_index + y_sb_index * pic_width_in_sb);
-                    sb_ptr   = pcs_ptr->sb_ptr_array[sb_index];
-
-                    sb_origin_x              = x_sb_index << sb_size_log2;
-                    sb_origin_y              = y_sb_index << sb_size_log2;
-                    context_ptr->sb_origin_x = sb_origin_x;
-                    context_ptr->sb_origin_y = sb_origin_y;
-                    if (sb_index == 0) eb_av1_reset_loop_restoration(pcs_ptr);
-                    if (sb_index == 0) context_ptr->tok = pcs_ptr->tile_tok[0][0];
-                    sb_ptr->total_bits = 0;
-                    uint32_t prev_pos  = sb_index ? pcs_ptr->entropy_coder_ptr->ec_writer.ec.offs
-                                                 : 0; //residual_bc.pos
-                    EbPictureBufferDesc *coeff_picture_ptr = sb_ptr->quantized_coeff;
-                    write_sb(context_ptr,
-                             sb_ptr,
-                             pcs_ptr,
-                             pcs_ptr->entropy_coder_ptr,
-                             coeff_picture_ptr);
-                    sb_ptr->total_bits = (pcs_ptr->entropy_coder_ptr->ec_writer.ec.offs - prev_pos)
-                                         << 3;
-                    pcs_ptr->parent_pcs_ptr->quantized_coeff_num_bits += sb_ptr->total_bits;
-                    row_total_bits += sb_ptr->total_bits;
-                }
-
-                // At the end of each SB-row, send the updated bit-count to Entropy Coding
-                {
-                    EbObjectWrapper * rate_control_task_wrapper_ptr;
-                    RateControlTasks *rate_control_task_ptr;
-
-                    // Get Empty EncDec Results
-                    eb_get_empty_object(context_ptr->rate_control_output_fifo_ptr,
-                                        &rate_control_task_wrapper_ptr);
-                    rate_control_task_ptr =
-                        (RateControlTasks *)rate_control_task_wrapper_ptr->object_ptr;
-                    rate_control_task_ptr->task_type      = RC_ENTROPY_CODING_ROW_FEEDBACK_RESULT;
-                    rate_control_task_ptr->picture_number = pcs_ptr->picture_number;
-                    rate_control_task_ptr->row_number     = y_sb_index;
-                    rate_control_task_ptr->bit_count      = row_total_bits;
-
-                    rate_control_task_ptr->pcs_wrapper_ptr = 0;
-                    rate_control_task_ptr->segment_index   = ~0u;
-
-                    // Post EncDec Results
-                    eb_post_full_object(rate_control_task_wrapper_ptr);
-                }
-
-                eb_block_on_mutex(pcs_ptr->entropy_coding_mutex);
-                if (pcs_ptr->entropy_coding_pic_done == EB_FALSE) {
-                    // If the picture is complete, terminate the slice
-                    if (pcs_ptr->entropy_coding_current_row == pcs_ptr->entropy_coding_row_count) {
-                        uint32_t ref_idx;
-                        pcs_ptr->entropy_coding_pic_done = EB_TRUE;
-                        encode_slice_finish(pcs_ptr->entropy_coder_ptr);
-                        // for Non Reference frames
-                        if (scs_ptr->use_output_stat_file &&
-                            !pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag)
-                            write_stat_to_file(scs_ptr,
-                                               *pcs_ptr->parent_pcs_ptr->stat_struct_first_pass_ptr,
-                                               pcs_ptr->parent_pcs_ptr->picture_number);
-                        // Release the List 0 Reference Pictures
-                        for (ref_idx = 0; ref_idx < pcs_ptr->parent_pcs_ptr->ref_list0_count;
-                             ++ref_idx) {
-                            if (scs_ptr->use_output_stat_file &&
-                                pcs_ptr->ref_pic_ptr_array[0][ref_idx] != EB_NULL &&
-                                pcs_ptr->ref_pic_ptr_array[0][ref_idx]->live_count == 1)
-                                write_stat_to_file(
-                                    scs_ptr,
-                                    ((EbReferenceObject *)pcs_ptr->ref_pic_ptr_array[0][ref_idx]
-                                         ->object_ptr)
-                                        ->stat_struct,
-                                    ((EbReferenceObject *)pcs_ptr->ref_pic_ptr_array[0][ref_idx]
-                                         ->object_ptr)
-                                        ->ref_poc);
-                            if (pcs_ptr->ref_pic_ptr_array[0][ref_idx] != EB_NULL) {
-                                eb_release_object(pcs_ptr->ref_pic_ptr_array[0][ref_idx]);
-                            }
-                        }
-
-                        // Release the List 1 Reference Pictures
-                        for (ref_idx = 0; ref_idx < pcs_ptr->parent_pcs_ptr->ref_list1_count;
-                             ++ref_idx) {
-                            if (scs_ptr->use_output_stat_file &&
-                                pcs_ptr->ref_pic_ptr_array[1][ref_idx] != EB_NULL &&
-                                pcs_ptr->ref_pic_ptr_array[1][ref_idx]->live_count == 1)
-                                write_stat_to_file(
-                                    scs_ptr,
-                                    ((EbReferenceObject *)pcs_ptr->ref_pic_ptr_array[1][ref_idx]
-                                         ->object_ptr)
-                                        ->stat_struct,
-                                    ((EbReferenceObject *)pcs_ptr->ref_pic_ptr_array[1][ref_idx]
-                                         ->object_ptr)
-                                        ->ref_poc);
-                            if (pcs_ptr->ref_pic_ptr_array[1][ref_idx] != EB_NULL)
-                                eb_release_object(pcs_ptr->ref_pic_ptr_array[1][ref_idx]);
-                        }
-
-                        // Get Empty Entropy Coding Results
-                        eb_get_empty_object(context_ptr->entropy_coding_output_fifo_ptr,
-                                            &entropy_coding_results_wrapper_ptr);
-                        entropy_coding_results_ptr =
-                            (EntropyCodingResults *)entropy_coding_results_wrapper_ptr->object_ptr;
-                        entropy_coding_results_ptr->pcs_wrapper_ptr =
-                            enc_dec_results_ptr->pcs_wrapper_ptr;
-
-                        // Post EntropyCoding Results
-                        eb_post_full_object(entropy_coding_results_wrapper_ptr);
-                    } // End if(PictureCompleteFlag)
-                }
-                eb_release_mutex(pcs_ptr->entropy_coding_mutex);
+
+    rest_results_ptr = (RestResults *)rest_results_wrapper_ptr->object_ptr;
+    pcs_ptr          = (PictureControlSet *)rest_results_ptr->pcs_wrapper_ptr->object_ptr;
+    scs_ptr          = (SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr;
+    eb_pipeline_stats_set_picture(pcs_ptr->picture_number);
+
+    // SB Constants
+
+    sb_sz = (uint8_t)scs_ptr->sb_size_pix;
+
+    sb_size_log2       = (uint8_t)Log2f(sb_sz);
+    context_ptr->sb_sz = sb_sz;
+    pic_width_in_sb    = (scs_ptr->seq_header.max_frame_width + sb_sz - 1) >> sb_size_log2;
+    if (pcs_ptr->parent_pcs_ptr->av1_cm->tiles_info.tile_cols *
+            pcs_ptr->parent_pcs_ptr->av1_cm->tiles_info.tile_rows ==
+        1)
+
+    {
+        EntropyCoder *entropy_coder_ptr = pcs_ptr->ec_info[0]->entropy_coder_ptr;
+        context_ptr->tile_idx           = 0;
+        initial_process_call            = EB_TRUE;
+        y_sb_index                      = rest_results_ptr->completed_sb_row_index_start;
+
+        // SB-loops
+        while (update_entropy_coding_rows(pcs_ptr,
+                                          &y_sb_index,
+                                          rest_results_ptr->completed_sb_row_count,
+                                          &initial_process_call) == EB_TRUE) {
+            uint32_t row_total_bits = 0;
+
+            if (y_sb_index == 0) {
+                reset_ec_tile(context_ptr, pcs_ptr, scs_ptr);
+                pcs_ptr->entropy_coding_pic_done = EB_FALSE;
             }
-        } else {
-            struct PictureParentControlSet *ppcs_ptr   = pcs_ptr->parent_pcs_ptr;
-            Av1Common *const                cm         = ppcs_ptr->av1_cm;
-            uint32_t                        total_size = 0;
-            int                             tile_row, tile_col;
-            const int                       tile_cols = ppcs_ptr->av1_cm->tiles_info.tile_cols;
-            const int                       tile_rows = ppcs_ptr->av1_cm->tiles_info.tile_rows;
-
-            //Entropy Tile Loop
-            for (tile_row = 0; tile_row < tile_rows; tile_row++) {
-                TileInfo tile_info;
-                eb_av1_tile_set_row(&tile_info, &cm->tiles_info, cm->mi_rows, tile_row);
-
-                for (tile_col = 0; tile_col < tile_cols; tile_col++) {
-                    const int tile_idx           = tile_row * tile_cols + tile_col;
-                    uint32_t  is_last_tile_in_tg = 0;
-
-                    if (tile_idx == (tile_cols * tile_rows - 1))
-                        is_last_tile_in_tg = 1;
-                    else
-                        is_last_tile_in_tg = 0;
-                    reset_ec_tile(total_size, is_last_tile_in_tg, context_ptr, pcs_ptr, scs_ptr);
-                    context_ptr->tok = pcs_ptr->tile_tok[0][0];
-                    eb_av1_tile_set_col(&tile_info, &cm->tiles_info, cm->mi_cols, tile_col);
-                    eb_av1_reset_loop_restoration(pcs_ptr);
-                    int sb_size_log2 = scs_ptr->seq_header.sb_size_log2;
-
-                    for ((y_sb_index = cm->tiles_info.tile_row_start_mi[tile_row] >> sb_size_log2);
-                         ((uint32_t)cm->tiles_info.tile_row_start_mi[tile_row + 1] >> sb_size_log2 >
-                          y_sb_index);
-                         y_sb_index++) {
-                        for (x_sb_index =
-                                 (cm->tiles_info.tile_col_start_mi[tile_col] >> sb_size_log2);
-                             x_sb_index <
-                             ((uint32_t)cm->tiles_info.tile_col_start_mi[tile_col + 1] >>
-                              sb_size_log2);
-                             x_sb_index++) {
-                            int sb_index = (uint16_t)(x_sb_index + y_sb_index * pic_width_in_sb);
-                            sb_ptr       = pcs_ptr->sb_ptr_array[sb_index];
-                            sb_origin_x  = x_sb_index << sb_size_log2;
-                            sb_origin_y  = y_sb_index << sb_size_log2;
-                            context_ptr->sb_origin_x = sb_origin_x;
-                            context_ptr->sb_origin_y = sb_origin_y;
-                            sb_ptr->total_bits       = 0;
-                            uint32_t prev_pos        = sb_index
-                                                    ? pcs_ptr->entropy_coder_ptr->ec_writer.ec.offs
-                                                    : 0; //residual_bc.pos
-                            EbPictureBufferDesc *coeff_picture_ptr = sb_ptr->quantized_coeff;
-                            write_sb(context_ptr,
-                                     sb_ptr,
-                                     pcs_ptr,
-                                     pcs_ptr->entropy_coder_ptr,
-                                     coeff_picture_ptr);
-                            sb_ptr->total_bits =
-                                (pcs_ptr->entropy_coder_ptr->ec_writer.ec.offs - prev_pos) << 3;
-                            pcs_ptr->parent_pcs_ptr->quantized_coeff_num_bits += sb_ptr->total_bits;
-                        }
-                    }
-
-                    encode_slice_finish(pcs_ptr->entropy_coder_ptr);
-
-                    int tile_size = pcs_ptr->entropy_coder_ptr->ec_writer.pos;
-                    assert(tile_size >= AV1_MIN_TILE_SIZE_BYTES);
-
-                    if (!is_last_tile_in_tg) {
-                        OutputBitstreamUnit *output_bitstream_ptr =
-                            (OutputBitstreamUnit *)(pcs_ptr->entropy_coder_ptr
-                                                        ->ec_output_bitstream_ptr);
-                        uint8_t *buf_data = output_bitstream_ptr->buffer_av1 + total_size;
-                        mem_put_le32(buf_data, tile_size - AV1_MIN_TILE_SIZE_BYTES);
-                    }
-
-                    if (is_last_tile_in_tg == 0) total_size += 4;
-
-                    total_size += tile_size;
-                }
+
+            for (x_sb_index = 0; x_sb_index < pic_width_in_sb; ++x_sb_index) {
+                sb_index = (uint16_t)(x_sb_index + y_sb_index * pic_width_in_sb);
+                sb_ptr   = pcs_ptr->sb_ptr_array[sb_index];
+
+                sb_origin_x              = x_sb_index << sb_size_log2;
+                sb_origin_y              = y_sb_index << sb_size_log2;
+                context_ptr->sb_origin_x = sb_origin_x;
+                context_ptr->sb_origin_y = sb_origin_y;
+                context_ptr->tok         = context_ptr->palette_tok;
+                sb_ptr->total_bits       = 0;
+                uint32_t prev_pos        = sb_index ? entropy_coder_ptr->ec_writer.ec.offs
+                                             : 0; //residual_bc.pos
+                EbPictureBufferDesc *coeff_picture_ptr = sb_ptr->quantized_coeff;
+                write_sb(context_ptr, sb_ptr, pcs_ptr, entropy_coder_ptr, coeff_picture_ptr);
+                sb_ptr->total_bits = (entropy_coder_ptr->ec_writer.ec.offs - prev_pos) << 3;
+                pcs_ptr->parent_pcs_ptr->quantized_coeff_num_bits += sb_ptr->total_bits;
+                row_total_bits += sb_ptr->total_bits;
             }
 
-            //the picture is complete, terminate the slice
+            // At the end of each SB-row, send the updated bit-count to Entropy Coding
             {
-                uint32_t ref_idx;
-                pcs_ptr->entropy_coder_ptr->ec_frame_size = total_size;
-
-                // Release the List 0 Reference Pictures
-                for (ref_idx = 0; ref_idx < pcs_ptr->parent_pcs_ptr->ref_list0_count; ++ref_idx) {
-                    if (pcs_ptr->ref_pic_ptr_array[0][ref_idx] != EB_NULL)
-                        eb_release_object(pcs_ptr->ref_pic_ptr_array[0][ref_idx]);
-                }
-
-                // Release the List 1 Reference Pictures
-                for (ref_idx = 0; ref_idx < pcs_ptr->parent_pcs_ptr->ref_list1_count; ++ref_idx) {
-                    if (pcs_ptr->ref_pic_ptr_array[1][ref_idx] != EB_NULL)
-                        eb_release_object(pcs_ptr->ref_pic_ptr_array[1][ref_idx]);
-                }
-
-                // Get Empty Entropy Coding Results
-                eb_get_empty_object(context_ptr->entropy_coding_output_fifo_ptr,
-                                    &entropy_coding_results_wrapper_ptr);
-                entropy_coding_results_ptr =
-                    (EntropyCodingResults *)entropy_coding_results_wrapper_ptr->object_ptr;
-                entropy_coding_results_ptr->pcs_wrapper_ptr = enc_dec_results_ptr->pcs_wrapper_ptr;
-
-                // Post EntropyCoding Results
-                eb_post_full_object(entropy_coding_results_wrapper_ptr);
+                EbObjectWrapper * rate_control_task_wrapper_ptr;
+                RateControlTasks *rate_control_task_ptr;
+
+                // Get Empty EncDec Results
+                eb_get_empty_object(context_ptr->rate_control_output_fifo_ptr,
+                                    &rate_control_task_wrapper_ptr);
+                rate_control_task_ptr =
+                    (RateControlTasks *)rate_control_task_wrapper_ptr->object_ptr;
+                rate_control_task_ptr->task_type      = RC_ENTROPY_CODING_ROW_FEEDBACK_RESULT;
+                rate_control_task_ptr->picture_number = pcs_ptr->picture_number;
+                rate_control_task_ptr->row_number     = y_sb_index;
+                rate_control_task_ptr->bit_count      = row_total_bits;
+
+                rate_control_task_ptr->pcs_wrapper_ptr = 0;
+                rate_control_task_ptr->segment_index   = ~0u;
+
+                // Post EncDec Results
+                eb_post_full_object(rate_control_task_wrapper_ptr);
             }
-        }
 
-        // Release Mode Decision Results
-        eb_release_object(enc_dec_results_wrapper_ptr);
+            eb_block_on_mutex(pcs_ptr->entropy_coding_mutex);
+            if (pcs_ptr->entropy_coding_pic_done == EB_FALSE) {
+                // If the picture is complete, terminate the slice
+                if (pcs_ptr->entropy_coding_current_row == pcs_ptr->entropy_coding_row_count) {
+                    pcs_ptr->entropy_coding_pic_done = EB_TRUE;
+                    CHECK_REPORT_ERROR(encode_slice_finish(entropy_coder_ptr) == EB_ErrorNone,
+                                       scs_ptr->encode_context_ptr->app_callback_ptr,
+                                       EB_ENC_EC_ERROR3);
+                    entropy_coding_finish_picture(
+                        context_ptr, pcs_ptr, scs_ptr, rest_results_ptr->pcs_wrapper_ptr);
+                } // End if(PictureCompleteFlag)
+            }
+            eb_release_mutex(pcs_ptr->entropy_coding_mutex);
+        }
+    } else {
+        const uint16_t tile_count = (uint16_t)(pcs_ptr->parent_pcs_ptr->av1_cm->tiles_info.tile_cols *
+                                               pcs_ptr->parent_pcs_ptr->av1_cm->tiles_info.tile_rows);
+        assert(tile_count <= pcs_ptr->tile_count);
+        context_ptr->tile_idx = rest_results_ptr->tile_index;
+        const uint64_t tile_bits =
+            entropy_code_tile(context_ptr, pcs_ptr, scs_ptr, pic_width_in_sb);
+
+        // The last tile to complete terminates the picture
+        eb_block_on_mutex(pcs_ptr->entropy_coding_mutex);
+        pcs_ptr->parent_pcs_ptr->quantized_coeff_num_bits += tile_bits;
+        if (++pcs_ptr->entropy_coding_tiles_done == tile_count)
+            entropy_coding_finish_picture(
+                context_ptr, pcs_ptr, scs_ptr, rest_results_ptr->pcs_wrapper_ptr);
+        eb_release_mutex(pcs_ptr->entropy_coding_mutex);
     }
 
+    // Release Rest Results
+    eb_release_object(rest_results_wrapper_ptr);
+}
+
+/******************************************************
+ * Entropy Coding Kernel
+ ******************************************************/
+void *entropy_coding_kernel(void *input_ptr) {
+    EbThreadContext *     thread_context_ptr = (EbThreadContext *)input_ptr;
+    EntropyCodingContext *context_ptr        = (EntropyCodingContext *)thread_context_ptr->priv;
+    EbObjectWrapper *     rest_results_wrapper_ptr;
+
+    for (;;) {
+        // Get Rest Results
+        eb_get_full_object(context_ptr->enc_dec_input_fifo_ptr, &rest_results_wrapper_ptr);
+
+        entropy_coding_job(thread_context_ptr, rest_results_wrapper_ptr);
+    }
     return EB_NULL;
 }
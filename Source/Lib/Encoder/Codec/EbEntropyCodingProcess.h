@@ -60,6 +60,8 @@ typedef struct EntropyCodingContext {
     int32_t     coded_area_sb;
     int32_t     coded_area_sb_uv;
     TOKENEXTRA *tok;
+    TOKENEXTRA *palette_tok; // scratch of the palette color map tokens of one SB
+    uint16_t    tile_idx; // tile being coded, indexes pcs_ptr->ec_info
 } EntropyCodingContext;
 
 /**************************************
@@ -69,6 +71,8 @@ extern EbErrorType entropy_coding_context_ctor(EbThreadContext *  thread_context
                                                const EbEncHandle *enc_handle_ptr, int index,
                                                int rate_control_index);
 
+extern void entropy_coding_job(EbThreadContext *thread_context_ptr,
+                               EbObjectWrapper *rest_results_wrapper_ptr);
 extern void *entropy_coding_kernel(void *input_ptr);
 
 #endif // EbEntropyCodingProcess_h
@@ -25,22 +25,56 @@
 #include "global_motion.h"
 #include "corner_detect.h"
 
+EbBool global_motion_enabled(SequenceControlSet *scs_ptr, PictureParentControlSet *pcs_ptr) {
+    uint8_t enc_mode =
+        scs_ptr->use_output_stat_file ? pcs_ptr->snd_pass_enc_mode : pcs_ptr->enc_mode;
+    return (EbBool)(scs_ptr->static_config.enable_global_motion == EB_TRUE && enc_mode <= ENC_M1);
+}
+
+// The quarter picture of ME, the corners are detected and matched on it
+static EbPictureBufferDesc *gm_quarter_picture(SequenceControlSet * scs_ptr,
+                                               EbPaReferenceObject *pa_ref_obj) {
+    return (scs_ptr->down_sampling_method_me_search == ME_FILTERED_DOWNSAMPLED)
+               ? pa_ref_obj->quarter_filtered_picture_ptr
+               : pa_ref_obj->quarter_decimated_picture_ptr;
+}
+
+static int gm_detect_corners(EbPictureBufferDesc *quarter_pic, int *corners) {
+    return av1_fast_corner_detect(quarter_pic->buffer_y + quarter_pic->origin_x +
+                                      quarter_pic->origin_y * quarter_pic->stride_y,
+                                  quarter_pic->width,
+                                  quarter_pic->height,
+                                  quarter_pic->stride_y,
+                                  corners,
+                                  MAX_CORNERS);
+}
+
+void global_motion_detect_corners(SequenceControlSet *scs_ptr, PictureParentControlSet *pcs_ptr) {
+    EbPaReferenceObject *pa_ref_obj =
+        (EbPaReferenceObject *)pcs_ptr->pa_reference_picture_wrapper_ptr->object_ptr;
+
+    pa_ref_obj->num_gm_corners = -1;
+    if (global_motion_enabled(scs_ptr, pcs_ptr))
+        pa_ref_obj->num_gm_corners =
+            gm_detect_corners(gm_quarter_picture(scs_ptr, pa_ref_obj), pa_ref_obj->gm_corners);
+}
+
 void global_motion_estimation(PictureParentControlSet *pcs_ptr, MeContext *context_ptr,
-                              EbPictureBufferDesc *input_picture_ptr) {
-#if GLOBAL_WARPED_MOTION
-    // Get downsampled pictures with a downsampling factor of 2 in each dimension
-    EbPaReferenceObject *pa_reference_object;
-    EbPictureBufferDesc *quarter_ref_pic_ptr;
-    EbPictureBufferDesc *quarter_picture_ptr;
-    EbPictureBufferDesc *ref_picture_ptr;
+                              EbPictureBufferDesc *input_picture_ptr, uint32_t segment_index) {
     SequenceControlSet * scs_ptr = (SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr;
-    pa_reference_object =
+    EbPaReferenceObject *pa_reference_object =
         (EbPaReferenceObject *)pcs_ptr->pa_reference_picture_wrapper_ptr->object_ptr;
-    quarter_picture_ptr =
-        (scs_ptr->down_sampling_method_me_search == ME_FILTERED_DOWNSAMPLED)
-            ? (EbPictureBufferDesc *)pa_reference_object->quarter_filtered_picture_ptr
-            : (EbPictureBufferDesc *)pa_reference_object->quarter_decimated_picture_ptr;
-#endif
+    EbPictureBufferDesc *quarter_picture_ptr = gm_quarter_picture(scs_ptr, pa_reference_object);
+    int *                frm_corners         = pa_reference_object->gm_corners;
+    int                  num_frm_corners     = pa_reference_object->num_gm_corners;
+    uint32_t             job_index           = 0;
+
+    // Picture Analysis skips the overlay pictures
+    if (num_frm_corners < 0) {
+        frm_corners     = context_ptr->gm_corners;
+        num_frm_corners = gm_detect_corners(quarter_picture_ptr, frm_corners);
+    }
+
     uint32_t num_of_list_to_search =
         (pcs_ptr->slice_type == P_SLICE) ? (uint32_t)REF_LIST_0 : (uint32_t)REF_LIST_1;
 
@@ -61,6 +95,13 @@ void global_motion_estimation(PictureParentControlSet *pcs_ptr, MeContext *conte
         for (uint32_t ref_pic_index = 0; ref_pic_index < num_of_ref_pic_to_search;
              ++ref_pic_index) {
             EbPaReferenceObject *reference_object;
+            EbPictureBufferDesc *quarter_ref_pic_ptr;
+            EbPictureBufferDesc *ref_picture_ptr;
+            int *                ref_corners;
+            int                  num_ref_corners;
+
+            // The references are searched by the ME segments of the picture in turn
+            if (job_index++ % pcs_ptr->me_segments_total_count != segment_index) continue;
 
             if (context_ptr->me_alt_ref == EB_TRUE)
                 reference_object = (EbPaReferenceObject *)context_ptr->alt_ref_reference_ptr;
@@ -69,25 +110,32 @@ void global_motion_estimation(PictureParentControlSet *pcs_ptr, MeContext *conte
                     (EbPaReferenceObject *)pcs_ptr->ref_pa_pic_ptr_array[list_index][ref_pic_index]
                         ->object_ptr;
 
-#if GLOBAL_WARPED_MOTION
-            // Set the source and the reference picture to be used by the global motion search
-            // based on the input search mode
+            quarter_ref_pic_ptr = gm_quarter_picture(scs_ptr, reference_object);
+            // The corners of a reference analysed without global motion are detected here
+            if (reference_object->num_gm_corners >= 0) {
+                ref_corners     = reference_object->gm_corners;
+                num_ref_corners = reference_object->num_gm_corners;
+            } else {
+                ref_corners     = context_ptr->gm_corners + 2 * MAX_CORNERS;
+                num_ref_corners = gm_detect_corners(quarter_ref_pic_ptr, ref_corners);
+            }
+
+            // GM_DOWN refines the model on the quarter pictures too, GM_FULL on the full
+            // resolution ones
             if (pcs_ptr->gm_level == GM_DOWN) {
-                quarter_ref_pic_ptr =
-                    (scs_ptr->down_sampling_method_me_search == ME_FILTERED_DOWNSAMPLED)
-                        ? (EbPictureBufferDesc *)reference_object->quarter_filtered_picture_ptr
-                        : (EbPictureBufferDesc *)reference_object->quarter_decimated_picture_ptr;
                 ref_picture_ptr   = quarter_ref_pic_ptr;
                 input_picture_ptr = quarter_picture_ptr;
-            } else {
+            } else
                 ref_picture_ptr = (EbPictureBufferDesc *)reference_object->input_padded_picture_ptr;
-            }
-#else
-            EbPictureBufferDesc *ref_picture_ptr =
-                (EbPictureBufferDesc *)reference_object->input_padded_picture_ptr;
-#endif
 
-            compute_global_motion(input_picture_ptr,
+            compute_global_motion(context_ptr,
+                                  quarter_picture_ptr,
+                                  frm_corners,
+                                  num_frm_corners,
+                                  quarter_ref_pic_ptr,
+                                  ref_corners,
+                                  num_ref_corners,
+                                  input_picture_ptr,
                                   ref_picture_ptr,
                                   &pcs_ptr->global_motion_estimation[list_index][ref_pic_index],
                                   pcs_ptr->frm_hdr.allow_high_precision_mv);
@@ -102,14 +150,21 @@ static INLINE int convert_to_trans_prec(int allow_hp, int coor) {
         return ROUND_POWER_OF_TWO_SIGNED(coor, WARPEDMODEL_PREC_BITS - 2) * 2;
 }
 
-void compute_global_motion(EbPictureBufferDesc *input_pic, EbPictureBufferDesc *ref_pic,
-                           EbWarpedMotionParams *bestWarpedMotion, int allow_high_precision_mv) {
+void compute_global_motion(MeContext *context_ptr, EbPictureBufferDesc *quarter_input_pic,
+                           int *frm_corners, int num_frm_corners,
+                           EbPictureBufferDesc *quarter_ref_pic, int *ref_corners,
+                           int num_ref_corners, EbPictureBufferDesc *input_pic,
+                           EbPictureBufferDesc *ref_pic, EbWarpedMotionParams *bestWarpedMotion,
+                           int allow_high_precision_mv) {
     MotionModel params_by_motion[RANSAC_NUM_MOTIONS];
     for (int m = 0; m < RANSAC_NUM_MOTIONS; m++) {
         memset(&params_by_motion[m], 0, sizeof(params_by_motion[m]));
-        params_by_motion[m].inliers =
-            malloc(sizeof(*(params_by_motion[m].inliers)) * 2 * MAX_CORNERS);
+        params_by_motion[m].inliers = context_ptr->gm_inliers + m * 2 * MAX_CORNERS;
     }
+    // The model is matched on the quarter pictures and refined on input_pic, upscale it
+    // when that is the full resolution picture
+    const double trans_scale = quarter_input_pic == input_pic ? 1.0 : 2.0;
+    double       scaled_params[MAX_PARAMDIM - 1];
 
     const double *       params_this_motion;
     int                  inliers_by_motion[RANSAC_NUM_MOTIONS];
@@ -120,7 +175,10 @@ void compute_global_motion(EbPictureBufferDesc *input_pic, EbPictureBufferDesc *
     };
     // clang-format on
 
-    int            frm_corners[2 * MAX_CORNERS];
+    unsigned char *frm_quarter_buffer = quarter_input_pic->buffer_y + quarter_input_pic->origin_x +
+                                        quarter_input_pic->origin_y * quarter_input_pic->stride_y;
+    unsigned char *ref_quarter_buffer = quarter_ref_pic->buffer_y + quarter_ref_pic->origin_x +
+                                        quarter_ref_pic->origin_y * quarter_ref_pic->stride_y;
     unsigned char *frm_buffer =
         input_pic->buffer_y + input_pic->origin_x + input_pic->origin_y * input_pic->stride_y;
     unsigned char *ref_buffer =
@@ -132,14 +190,6 @@ void compute_global_motion(EbPictureBufferDesc *input_pic, EbPictureBufferDesc *
     const EbWarpedMotionParams *ref_params = &default_warp_params;
 
     {
-        // compute interest points using FAST features
-        int num_frm_corners = av1_fast_corner_detect(frm_buffer,
-                                                     input_pic->width,
-                                                     input_pic->height,
-                                                     input_pic->stride_y,
-                                                     frm_corners,
-                                                     MAX_CORNERS);
-
         TransformationType model;
 #define GLOBAL_TRANS_TYPES_ENC 3
 
@@ -154,24 +204,31 @@ void compute_global_motion(EbPictureBufferDesc *input_pic, EbPictureBufferDesc *
             }
 
             av1_compute_global_motion(model,
-                                      frm_buffer,
-                                      input_pic->width,
-                                      input_pic->height,
-                                      input_pic->stride_y,
+                                      frm_quarter_buffer,
+                                      quarter_input_pic->width,
+                                      quarter_input_pic->height,
+                                      quarter_input_pic->stride_y,
                                       frm_corners,
                                       num_frm_corners,
-                                      ref_buffer,
-                                      ref_pic->stride_y,
+                                      ref_quarter_buffer,
+                                      quarter_ref_pic->stride_y,
+                                      ref_corners,
+                                      num_ref_corners,
                                       EB_8BIT,
                                       gm_estimation_type,
                                       inliers_by_motion,
                                       params_by_motion,
-                                      RANSAC_NUM_MOTIONS);
+                                      RANSAC_NUM_MOTIONS,
+                                      context_ptr->gm_correspondences);
 
             for (unsigned i = 0; i < RANSAC_NUM_MOTIONS; ++i) {
                 if (inliers_by_motion[i] == 0) continue;
 
-                params_this_motion = params_by_motion[i].params;
+                // Only the translation scales, the models are at most affine
+                memcpy(scaled_params, params_by_motion[i].params, sizeof(scaled_params));
+                scaled_params[0] *= trans_scale;
+                scaled_params[1] *= trans_scale;
+                params_this_motion = scaled_params;
                 av1_convert_model_to_params(params_this_motion, &tmp_wm_params);
 
                 if (tmp_wm_params.wmtype != IDENTITY) {
@@ -236,6 +293,4 @@ void compute_global_motion(EbPictureBufferDesc *input_pic, EbPictureBufferDesc *
     }
 
     *bestWarpedMotion = global_motion;
-
-    for (int m = 0; m < RANSAC_NUM_MOTIONS; m++) { free(params_by_motion[m].inliers); }
 }
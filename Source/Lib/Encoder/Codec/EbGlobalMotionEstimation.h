@@ -19,10 +19,21 @@
 
 #include "EbPictureBufferDesc.h"
 #include "EbMotionEstimationContext.h"
+#include "EbSequenceControlSet.h"
 
+// EB_TRUE when ME searches the global motion of the picture
+EbBool global_motion_enabled(SequenceControlSet *scs_ptr, PictureParentControlSet *pcs_ptr);
+// Detects the corners of the picture once, in Picture Analysis, for it and for the
+// pictures using it as a reference
+void global_motion_detect_corners(SequenceControlSet *scs_ptr, PictureParentControlSet *pcs_ptr);
+// Searches the global motion of the references assigned to ME segment segment_index
 void global_motion_estimation(PictureParentControlSet *pcs_ptr, MeContext *context_ptr,
-                              EbPictureBufferDesc *input_picture_ptr);
-void compute_global_motion(EbPictureBufferDesc *input_pic, EbPictureBufferDesc *ref_pic,
-                           EbWarpedMotionParams *bestWarpedMotion, int allow_high_precision_mv);
+                              EbPictureBufferDesc *input_picture_ptr, uint32_t segment_index);
+void compute_global_motion(MeContext *context_ptr, EbPictureBufferDesc *quarter_input_pic,
+                           int *frm_corners, int num_frm_corners,
+                           EbPictureBufferDesc *quarter_ref_pic, int *ref_corners,
+                           int num_ref_corners, EbPictureBufferDesc *input_pic,
+                           EbPictureBufferDesc *ref_pic, EbWarpedMotionParams *bestWarpedMotion,
+                           int allow_high_precision_mv);
 
 #endif // EbGlobalMotionEstimation_h
@@ -11,6 +11,7 @@
 #include "EbMotionEstimationContext.h"
 #include "EbUtility.h"
 #include "EbReferenceObject.h"
+#include "EbPipelineStats.h"
 
 /**************************************
  * Context
@@ -1080,6 +1081,7 @@ void *initial_rate_control_kernel(void *input_ptr) {
 
         in_results_ptr = (MotionEstimationResults *)in_results_wrapper_ptr->object_ptr;
         pcs_ptr        = (PictureParentControlSet *)in_results_ptr->pcs_wrapper_ptr->object_ptr;
+        eb_pipeline_stats_set_picture(pcs_ptr->picture_number);
 
         segment_index = in_results_ptr->segment_index;
 
@@ -5278,18 +5278,23 @@ EbErrorType av1_inter_prediction(
 
                 if (pu_origin_y != 0)
                     memcpy(topNeighArray + 1,
-                           luma_recon_neighbor_array->top_array + pu_origin_x,
+                           luma_recon_neighbor_array->top_array +
+                               get_neighbor_array_unit_top_index(
+                                   luma_recon_neighbor_array, pu_origin_x),
                            blk_geom->bwidth * 2);
 
                 if (pu_origin_x != 0)
                     memcpy(leftNeighArray + 1,
-                           luma_recon_neighbor_array->left_array + pu_origin_y,
+                           luma_recon_neighbor_array->left_array +
+                               get_neighbor_array_unit_left_index(
+                                   luma_recon_neighbor_array, pu_origin_y),
                            blk_geom->bheight * 2);
 
                 if (pu_origin_y != 0 && pu_origin_x != 0)
                     topNeighArray[0] = leftNeighArray[0] =
                         luma_recon_neighbor_array
-                            ->top_left_array[MAX_PICTURE_HEIGHT_SIZE + pu_origin_x - pu_origin_y];
+                            ->top_left_array[get_neighbor_array_unit_top_left_index(
+                                luma_recon_neighbor_array, pu_origin_x, pu_origin_y)];
 
             }
 
@@ -5303,19 +5308,23 @@ EbErrorType av1_inter_prediction(
 
                 if (blk_originy_uv != 0)
                     memcpy(topNeighArray + 1,
-                           cb_recon_neighbor_array->top_array + blk_originx_uv,
+                           cb_recon_neighbor_array->top_array +
+                               get_neighbor_array_unit_top_index(
+                                   cb_recon_neighbor_array, blk_originx_uv),
                            blk_geom->bwidth_uv * 2);
 
                 if (blk_originx_uv != 0)
                     memcpy(leftNeighArray + 1,
-                           cb_recon_neighbor_array->left_array + blk_originy_uv,
+                           cb_recon_neighbor_array->left_array +
+                               get_neighbor_array_unit_left_index(
+                                   cb_recon_neighbor_array, blk_originy_uv),
                            blk_geom->bheight_uv * 2);
 
                 if (blk_originy_uv != 0 && blk_originx_uv != 0)
                     topNeighArray[0] = leftNeighArray[0] =
                         cb_recon_neighbor_array
-                            ->top_left_array[MAX_PICTURE_HEIGHT_SIZE / 2 + blk_originx_uv -
-                                             blk_originy_uv / 2];
+                            ->top_left_array[get_neighbor_array_unit_top_left_index(
+                                cb_recon_neighbor_array, blk_originx_uv, blk_originy_uv / 2)];
             } else {
                 dst_ptr = prediction_ptr->buffer_cr +
                           (prediction_ptr->origin_x + ((dst_origin_x >> 3) << 3)) / 2 +
@@ -5326,19 +5335,23 @@ EbErrorType av1_inter_prediction(
 
                 if (blk_originy_uv != 0)
                     memcpy(topNeighArray + 1,
-                           cr_recon_neighbor_array->top_array + blk_originx_uv,
+                           cr_recon_neighbor_array->top_array +
+                               get_neighbor_array_unit_top_index(
+                                   cr_recon_neighbor_array, blk_originx_uv),
                            blk_geom->bwidth_uv * 2);
 
                 if (blk_originx_uv != 0)
                     memcpy(leftNeighArray + 1,
-                           cr_recon_neighbor_array->left_array + blk_originy_uv,
+                           cr_recon_neighbor_array->left_array +
+                               get_neighbor_array_unit_left_index(
+                                   cr_recon_neighbor_array, blk_originy_uv),
                            blk_geom->bheight_uv * 2);
 
                 if (blk_originy_uv != 0 && blk_originx_uv != 0)
                     topNeighArray[0] = leftNeighArray[0] =
                         cr_recon_neighbor_array
-                            ->top_left_array[MAX_PICTURE_HEIGHT_SIZE / 2 + blk_originx_uv -
-                                             blk_originy_uv / 2];
+                            ->top_left_array[get_neighbor_array_unit_top_left_index(
+                                cr_recon_neighbor_array, blk_originx_uv, blk_originy_uv / 2)];
             }
             TxSize tx_size        = blk_geom->txsize[0][0]; // Nader - Intra 128x128 not supported
             TxSize tx_size_Chroma = blk_geom->txsize_uv[0][0]; //Nader - Intra 128x128 not supported
@@ -6149,18 +6162,23 @@ EbErrorType av1_inter_prediction_hbd(
 
                 if (pu_origin_y != 0)
                     memcpy(topNeighArray + 1,
-                           (uint16_t *)luma_recon_neighbor_array->top_array + pu_origin_x,
+                           (uint16_t *)luma_recon_neighbor_array->top_array +
+                               get_neighbor_array_unit_top_index(
+                                   luma_recon_neighbor_array, pu_origin_x),
                            blk_geom->bwidth * 2 * sizeof(uint16_t));
 
                 if (pu_origin_x != 0)
                     memcpy(leftNeighArray + 1,
-                           (uint16_t *)luma_recon_neighbor_array->left_array + pu_origin_y,
+                           (uint16_t *)luma_recon_neighbor_array->left_array +
+                               get_neighbor_array_unit_left_index(
+                                   luma_recon_neighbor_array, pu_origin_y),
                            blk_geom->bheight * 2 * sizeof(uint16_t));
 
                 if (pu_origin_y != 0 && pu_origin_x != 0)
                     topNeighArray[0] = leftNeighArray[0] =
-                        ((uint16_t *)luma_recon_neighbor_array
-                             ->top_left_array)[MAX_PICTURE_HEIGHT_SIZE + pu_origin_x - pu_origin_y];
+                        ((uint16_t *)(luma_recon_neighbor_array->top_left_array))
+                            [get_neighbor_array_unit_top_left_index(
+                                luma_recon_neighbor_array, pu_origin_x, pu_origin_y)];
             }
 
             else if (plane == 1) {
@@ -6173,19 +6191,23 @@ EbErrorType av1_inter_prediction_hbd(
 
                 if (blk_originy_uv != 0)
                     memcpy(topNeighArray + 1,
-                           (uint16_t *)cb_recon_neighbor_array->top_array + blk_originx_uv,
+                           (uint16_t *)cb_recon_neighbor_array->top_array +
+                               get_neighbor_array_unit_top_index(
+                                   cb_recon_neighbor_array, blk_originx_uv),
                            blk_geom->bwidth_uv * 2 * sizeof(uint16_t));
 
                 if (blk_originx_uv != 0)
                     memcpy(leftNeighArray + 1,
-                           (uint16_t *)cb_recon_neighbor_array->left_array + blk_originy_uv,
+                           (uint16_t *)cb_recon_neighbor_array->left_array +
+                               get_neighbor_array_unit_left_index(
+                                   cb_recon_neighbor_array, blk_originy_uv),
                            blk_geom->bheight_uv * 2 * sizeof(uint16_t));
 
                 if (blk_originy_uv != 0 && blk_originx_uv != 0)
                     topNeighArray[0] = leftNeighArray[0] =
-                        ((uint16_t *)cb_recon_neighbor_array
-                             ->top_left_array)[MAX_PICTURE_HEIGHT_SIZE / 2 + blk_originx_uv -
-                                               blk_originy_uv / 2];
+                        ((uint16_t *)(cb_recon_neighbor_array->top_left_array))
+                            [get_neighbor_array_unit_top_left_index(
+                                cb_recon_neighbor_array, blk_originx_uv, blk_originy_uv / 2)];
             } else {
                 dst_ptr = (uint16_t *)prediction_ptr->buffer_cr +
                           (prediction_ptr->origin_x + ((dst_origin_x >> 3) << 3)) / 2 +
@@ -6196,19 +6218,23 @@ EbErrorType av1_inter_prediction_hbd(
 
                 if (blk_originy_uv != 0)
                     memcpy(topNeighArray + 1,
-                           (uint16_t *)cr_recon_neighbor_array->top_array + blk_originx_uv,
+                           (uint16_t *)cr_recon_neighbor_array->top_array +
+                               get_neighbor_array_unit_top_index(
+                                   cr_recon_neighbor_array, blk_originx_uv),
                            blk_geom->bwidth_uv * 2 * sizeof(uint16_t));
 
                 if (blk_originx_uv != 0)
                     memcpy(leftNeighArray + 1,
-                           (uint16_t *)cr_recon_neighbor_array->left_array + blk_originy_uv,
+                           (uint16_t *)cr_recon_neighbor_array->left_array +
+                               get_neighbor_array_unit_left_index(
+                                   cr_recon_neighbor_array, blk_originy_uv),
                            blk_geom->bheight_uv * 2 * sizeof(uint16_t));
 
                 if (blk_originy_uv != 0 && blk_originx_uv != 0)
                     topNeighArray[0] = leftNeighArray[0] =
-                        ((uint16_t *)cr_recon_neighbor_array
-                             ->top_left_array)[MAX_PICTURE_HEIGHT_SIZE / 2 + blk_originx_uv -
-                                               blk_originy_uv / 2];
+                        ((uint16_t *)(cr_recon_neighbor_array->top_left_array))
+                            [get_neighbor_array_unit_top_left_index(
+                                cr_recon_neighbor_array, blk_originx_uv, blk_originy_uv / 2)];
             }
             TxSize tx_size        = blk_geom->txsize[0][0]; // Nader - Intra 128x128 not supported
             TxSize tx_size_Chroma = blk_geom->txsize_uv[0][0]; //Nader - Intra 128x128 not supported
@@ -4392,32 +4392,32 @@ EbErrorType eb_av1_intra_prediction_cl(
         for (int32_t plane = start_plane; plane < end_plane; ++plane) {
             if (plane == 0) {
                 if (md_context_ptr->blk_origin_y != 0)
-                    memcpy(top_neigh_array + 1, md_context_ptr->luma_recon_neighbor_array->top_array + md_context_ptr->blk_origin_x, md_context_ptr->blk_geom->bwidth * 2);
+                    memcpy(top_neigh_array + 1, md_context_ptr->luma_recon_neighbor_array->top_array + get_neighbor_array_unit_top_index(md_context_ptr->luma_recon_neighbor_array, md_context_ptr->blk_origin_x), md_context_ptr->blk_geom->bwidth * 2);
                 if (md_context_ptr->blk_origin_x != 0)
-                    memcpy(left_neigh_array + 1, md_context_ptr->luma_recon_neighbor_array->left_array + md_context_ptr->blk_origin_y, md_context_ptr->blk_geom->bheight * 2);
+                    memcpy(left_neigh_array + 1, md_context_ptr->luma_recon_neighbor_array->left_array + get_neighbor_array_unit_left_index(md_context_ptr->luma_recon_neighbor_array, md_context_ptr->blk_origin_y), md_context_ptr->blk_geom->bheight * 2);
                 if (md_context_ptr->blk_origin_y != 0 && md_context_ptr->blk_origin_x != 0)
-                    top_neigh_array[0] = left_neigh_array[0] = md_context_ptr->luma_recon_neighbor_array->top_left_array[MAX_PICTURE_HEIGHT_SIZE + md_context_ptr->blk_origin_x - md_context_ptr->blk_origin_y];
+                    top_neigh_array[0] = left_neigh_array[0] = md_context_ptr->luma_recon_neighbor_array->top_left_array[get_neighbor_array_unit_top_left_index(md_context_ptr->luma_recon_neighbor_array, md_context_ptr->blk_origin_x, md_context_ptr->blk_origin_y)];
             }
 
             else if (plane == 1) {
                 if (md_context_ptr->round_origin_y != 0)
-                    memcpy(top_neigh_array + 1, md_context_ptr->cb_recon_neighbor_array->top_array + md_context_ptr->round_origin_x / 2, md_context_ptr->blk_geom->bwidth_uv * 2);
+                    memcpy(top_neigh_array + 1, md_context_ptr->cb_recon_neighbor_array->top_array + get_neighbor_array_unit_top_index(md_context_ptr->cb_recon_neighbor_array, md_context_ptr->round_origin_x / 2), md_context_ptr->blk_geom->bwidth_uv * 2);
 
                 if (md_context_ptr->round_origin_x != 0)
-                    memcpy(left_neigh_array + 1, md_context_ptr->cb_recon_neighbor_array->left_array + md_context_ptr->round_origin_y / 2, md_context_ptr->blk_geom->bheight_uv * 2);
+                    memcpy(left_neigh_array + 1, md_context_ptr->cb_recon_neighbor_array->left_array + get_neighbor_array_unit_left_index(md_context_ptr->cb_recon_neighbor_array, md_context_ptr->round_origin_y / 2), md_context_ptr->blk_geom->bheight_uv * 2);
 
                 if (md_context_ptr->round_origin_y != 0 && md_context_ptr->round_origin_x != 0)
-                    top_neigh_array[0] = left_neigh_array[0] = md_context_ptr->cb_recon_neighbor_array->top_left_array[MAX_PICTURE_HEIGHT_SIZE / 2 + md_context_ptr->round_origin_x / 2 - md_context_ptr->round_origin_y / 2];
+                    top_neigh_array[0] = left_neigh_array[0] = md_context_ptr->cb_recon_neighbor_array->top_left_array[get_neighbor_array_unit_top_left_index(md_context_ptr->cb_recon_neighbor_array, md_context_ptr->round_origin_x / 2, md_context_ptr->round_origin_y / 2)];
             }
             else {
                 if (md_context_ptr->round_origin_y != 0)
-                    memcpy(top_neigh_array + 1, md_context_ptr->cr_recon_neighbor_array->top_array + md_context_ptr->round_origin_x / 2, md_context_ptr->blk_geom->bwidth_uv * 2);
+                    memcpy(top_neigh_array + 1, md_context_ptr->cr_recon_neighbor_array->top_array + get_neighbor_array_unit_top_index(md_context_ptr->cr_recon_neighbor_array, md_context_ptr->round_origin_x / 2), md_context_ptr->blk_geom->bwidth_uv * 2);
 
                 if (md_context_ptr->round_origin_x != 0)
-                    memcpy(left_neigh_array + 1, md_context_ptr->cr_recon_neighbor_array->left_array + md_context_ptr->round_origin_y / 2, md_context_ptr->blk_geom->bheight_uv * 2);
+                    memcpy(left_neigh_array + 1, md_context_ptr->cr_recon_neighbor_array->left_array + get_neighbor_array_unit_left_index(md_context_ptr->cr_recon_neighbor_array, md_context_ptr->round_origin_y / 2), md_context_ptr->blk_geom->bheight_uv * 2);
 
                 if (md_context_ptr->round_origin_y != 0 && md_context_ptr->round_origin_x != 0)
-                    top_neigh_array[0] = left_neigh_array[0] = md_context_ptr->cr_recon_neighbor_array->top_left_array[MAX_PICTURE_HEIGHT_SIZE / 2 + md_context_ptr->round_origin_x / 2 - md_context_ptr->round_origin_y / 2];
+                    top_neigh_array[0] = left_neigh_array[0] = md_context_ptr->cr_recon_neighbor_array->top_left_array[get_neighbor_array_unit_top_left_index(md_context_ptr->cr_recon_neighbor_array, md_context_ptr->round_origin_x / 2, md_context_ptr->round_origin_y / 2)];
             }
 
             if (plane)
@@ -4464,33 +4464,33 @@ EbErrorType eb_av1_intra_prediction_cl(
         for (int32_t plane = start_plane; plane < end_plane; ++plane) {
             if (plane == 0) {
                 if (md_context_ptr->blk_origin_y != 0)
-                    memcpy(top_neigh_array + 1, (uint16_t*)(md_context_ptr->luma_recon_neighbor_array16bit->top_array) + md_context_ptr->blk_origin_x, md_context_ptr->blk_geom->bwidth * 2 * sizeof(uint16_t));
+                    memcpy(top_neigh_array + 1, (uint16_t*)(md_context_ptr->luma_recon_neighbor_array16bit->top_array) + get_neighbor_array_unit_top_index(md_context_ptr->luma_recon_neighbor_array16bit, md_context_ptr->blk_origin_x), md_context_ptr->blk_geom->bwidth * 2 * sizeof(uint16_t));
 
                 if (md_context_ptr->blk_origin_x != 0)
-                    memcpy(left_neigh_array + 1, (uint16_t*)(md_context_ptr->luma_recon_neighbor_array16bit->left_array) + md_context_ptr->blk_origin_y, md_context_ptr->blk_geom->bheight * 2 * sizeof(uint16_t));
+                    memcpy(left_neigh_array + 1, (uint16_t*)(md_context_ptr->luma_recon_neighbor_array16bit->left_array) + get_neighbor_array_unit_left_index(md_context_ptr->luma_recon_neighbor_array16bit, md_context_ptr->blk_origin_y), md_context_ptr->blk_geom->bheight * 2 * sizeof(uint16_t));
 
                 if (md_context_ptr->blk_origin_y != 0 && md_context_ptr->blk_origin_x != 0)
-                    top_neigh_array[0] = left_neigh_array[0] = ((uint16_t*)(md_context_ptr->luma_recon_neighbor_array16bit->top_left_array) + MAX_PICTURE_HEIGHT_SIZE + md_context_ptr->blk_origin_x - md_context_ptr->blk_origin_y)[0];
+                    top_neigh_array[0] = left_neigh_array[0] = ((uint16_t *)(md_context_ptr->luma_recon_neighbor_array16bit->top_left_array))[get_neighbor_array_unit_top_left_index(md_context_ptr->luma_recon_neighbor_array16bit, md_context_ptr->blk_origin_x, md_context_ptr->blk_origin_y)];
             }
             else if (plane == 1) {
                 if (md_context_ptr->round_origin_y != 0)
-                    memcpy(top_neigh_array + 1, (uint16_t*)(md_context_ptr->cb_recon_neighbor_array16bit->top_array) + md_context_ptr->round_origin_x / 2, md_context_ptr->blk_geom->bwidth_uv * 2 * sizeof(uint16_t));
+                    memcpy(top_neigh_array + 1, (uint16_t*)(md_context_ptr->cb_recon_neighbor_array16bit->top_array) + get_neighbor_array_unit_top_index(md_context_ptr->cb_recon_neighbor_array16bit, md_context_ptr->round_origin_x / 2), md_context_ptr->blk_geom->bwidth_uv * 2 * sizeof(uint16_t));
 
                 if (md_context_ptr->round_origin_x != 0)
-                    memcpy(left_neigh_array + 1, (uint16_t*)(md_context_ptr->cb_recon_neighbor_array16bit->left_array) + md_context_ptr->round_origin_y / 2, md_context_ptr->blk_geom->bheight_uv * 2 * sizeof(uint16_t));
+                    memcpy(left_neigh_array + 1, (uint16_t*)(md_context_ptr->cb_recon_neighbor_array16bit->left_array) + get_neighbor_array_unit_left_index(md_context_ptr->cb_recon_neighbor_array16bit, md_context_ptr->round_origin_y / 2), md_context_ptr->blk_geom->bheight_uv * 2 * sizeof(uint16_t));
 
                 if (md_context_ptr->round_origin_y != 0 && md_context_ptr->round_origin_x != 0)
-                    top_neigh_array[0] = left_neigh_array[0] = ((uint16_t*) (md_context_ptr->cb_recon_neighbor_array16bit->top_left_array) + MAX_PICTURE_HEIGHT_SIZE / 2 + md_context_ptr->round_origin_x / 2 - md_context_ptr->round_origin_y / 2)[0];
+                    top_neigh_array[0] = left_neigh_array[0] = ((uint16_t *)(md_context_ptr->cb_recon_neighbor_array16bit->top_left_array))[get_neighbor_array_unit_top_left_index(md_context_ptr->cb_recon_neighbor_array16bit, md_context_ptr->round_origin_x / 2, md_context_ptr->round_origin_y / 2)];
             }
             else {
                 if (md_context_ptr->round_origin_y != 0)
-                    memcpy(top_neigh_array + 1, (uint16_t*)(md_context_ptr->cr_recon_neighbor_array16bit->top_array) + md_context_ptr->round_origin_x / 2, md_context_ptr->blk_geom->bwidth_uv * 2 * sizeof(uint16_t));
+                    memcpy(top_neigh_array + 1, (uint16_t*)(md_context_ptr->cr_recon_neighbor_array16bit->top_array) + get_neighbor_array_unit_top_index(md_context_ptr->cr_recon_neighbor_array16bit, md_context_ptr->round_origin_x / 2), md_context_ptr->blk_geom->bwidth_uv * 2 * sizeof(uint16_t));
 
                 if (md_context_ptr->round_origin_x != 0)
-                    memcpy(left_neigh_array + 1, (uint16_t*)(md_context_ptr->cr_recon_neighbor_array16bit->left_array) + md_context_ptr->round_origin_y / 2, md_context_ptr->blk_geom->bheight_uv * 2 * sizeof(uint16_t));
+                    memcpy(left_neigh_array + 1, (uint16_t*)(md_context_ptr->cr_recon_neighbor_array16bit->left_array) + get_neighbor_array_unit_left_index(md_context_ptr->cr_recon_neighbor_array16bit, md_context_ptr->round_origin_y / 2), md_context_ptr->blk_geom->bheight_uv * 2 * sizeof(uint16_t));
 
                 if (md_context_ptr->round_origin_y != 0 && md_context_ptr->round_origin_x != 0)
-                    top_neigh_array[0] = left_neigh_array[0] = ((uint16_t*) (md_context_ptr->cr_recon_neighbor_array16bit->top_left_array) + MAX_PICTURE_HEIGHT_SIZE / 2 + md_context_ptr->round_origin_x / 2 - md_context_ptr->round_origin_y / 2)[0];
+                    top_neigh_array[0] = left_neigh_array[0] = ((uint16_t *)(md_context_ptr->cr_recon_neighbor_array16bit->top_left_array))[get_neighbor_array_unit_top_left_index(md_context_ptr->cr_recon_neighbor_array16bit, md_context_ptr->round_origin_x / 2, md_context_ptr->round_origin_y / 2)];
             }
 
             if (plane)
@@ -4567,11 +4567,11 @@ EbErrorType  intra_luma_prediction_for_interintra(
         uint8_t    left_neigh_array[64 * 2 + 1];
 
         if (md_context_ptr->blk_origin_y != 0)
-            memcpy(top_neigh_array + 1, md_context_ptr->luma_recon_neighbor_array->top_array + md_context_ptr->blk_origin_x, md_context_ptr->blk_geom->bwidth * 2);
+            memcpy(top_neigh_array + 1, md_context_ptr->luma_recon_neighbor_array->top_array + get_neighbor_array_unit_top_index(md_context_ptr->luma_recon_neighbor_array, md_context_ptr->blk_origin_x), md_context_ptr->blk_geom->bwidth * 2);
         if (md_context_ptr->blk_origin_x != 0)
-            memcpy(left_neigh_array + 1, md_context_ptr->luma_recon_neighbor_array->left_array + md_context_ptr->blk_origin_y, md_context_ptr->blk_geom->bheight * 2);
+            memcpy(left_neigh_array + 1, md_context_ptr->luma_recon_neighbor_array->left_array + get_neighbor_array_unit_left_index(md_context_ptr->luma_recon_neighbor_array, md_context_ptr->blk_origin_y), md_context_ptr->blk_geom->bheight * 2);
         if (md_context_ptr->blk_origin_y != 0 && md_context_ptr->blk_origin_x != 0)
-            top_neigh_array[0] = left_neigh_array[0] = md_context_ptr->luma_recon_neighbor_array->top_left_array[MAX_PICTURE_HEIGHT_SIZE + md_context_ptr->blk_origin_x - md_context_ptr->blk_origin_y];
+            top_neigh_array[0] = left_neigh_array[0] = md_context_ptr->luma_recon_neighbor_array->top_left_array[get_neighbor_array_unit_top_left_index(md_context_ptr->luma_recon_neighbor_array, md_context_ptr->blk_origin_x, md_context_ptr->blk_origin_y)];
 
         eb_av1_predict_intra_block(
             &md_context_ptr->sb_ptr->tile_info,
@@ -4605,11 +4605,11 @@ EbErrorType  intra_luma_prediction_for_interintra(
         uint16_t left_neigh_array[64 * 2 + 1];
 
         if (md_context_ptr->blk_origin_y != 0)
-            memcpy(top_neigh_array + 1, (uint16_t*)(md_context_ptr->luma_recon_neighbor_array16bit->top_array) + md_context_ptr->blk_origin_x, md_context_ptr->blk_geom->bwidth * 2 * sizeof(uint16_t));
+            memcpy(top_neigh_array + 1, (uint16_t*)(md_context_ptr->luma_recon_neighbor_array16bit->top_array) + get_neighbor_array_unit_top_index(md_context_ptr->luma_recon_neighbor_array16bit, md_context_ptr->blk_origin_x), md_context_ptr->blk_geom->bwidth * 2 * sizeof(uint16_t));
         if (md_context_ptr->blk_origin_x != 0)
-            memcpy(left_neigh_array + 1, (uint16_t*)(md_context_ptr->luma_recon_neighbor_array16bit->left_array) + md_context_ptr->blk_origin_y, md_context_ptr->blk_geom->bheight * 2 * sizeof(uint16_t));
+            memcpy(left_neigh_array + 1, (uint16_t*)(md_context_ptr->luma_recon_neighbor_array16bit->left_array) + get_neighbor_array_unit_left_index(md_context_ptr->luma_recon_neighbor_array16bit, md_context_ptr->blk_origin_y), md_context_ptr->blk_geom->bheight * 2 * sizeof(uint16_t));
         if (md_context_ptr->blk_origin_y != 0 && md_context_ptr->blk_origin_x != 0)
-            top_neigh_array[0] = left_neigh_array[0] = ((uint16_t*)(md_context_ptr->luma_recon_neighbor_array16bit->top_left_array) + MAX_PICTURE_HEIGHT_SIZE + md_context_ptr->blk_origin_x - md_context_ptr->blk_origin_y)[0];
+            top_neigh_array[0] = left_neigh_array[0] = ((uint16_t *)(md_context_ptr->luma_recon_neighbor_array16bit->top_left_array))[get_neighbor_array_unit_top_left_index(md_context_ptr->luma_recon_neighbor_array16bit, md_context_ptr->blk_origin_x, md_context_ptr->blk_origin_y)];
 
         eb_av1_predict_intra_block_16bit(
             &md_context_ptr->sb_ptr->tile_info,
@@ -125,6 +125,79 @@ void generate_padding16_bit(
     return;
 }
 
+/** generate_padding_rows()
+        is used to pad rows [row_start, row_start + row_count) of the target picture horizontally.
+        Disjoint row ranges can be padded concurrently; generate_padding_top() and
+        generate_padding_bottom() complete the vertical padding once the first and last rows are
+        done.
+ */
+void generate_padding_rows(EbByte src_pic, uint32_t src_stride, uint32_t original_src_width,
+                           uint32_t padding_width, uint32_t padding_height, uint32_t row_start,
+                           uint32_t row_count) {
+    EbByte temp_src_pic0 = src_pic + padding_width + (padding_height + row_start) * src_stride;
+    while (row_count) {
+        EB_MEMSET(temp_src_pic0 - padding_width, *temp_src_pic0, padding_width);
+        EB_MEMSET(temp_src_pic0 + original_src_width,
+                  *(temp_src_pic0 + original_src_width - 1),
+                  padding_width);
+
+        temp_src_pic0 += src_stride;
+        --row_count;
+    }
+}
+
+/** generate_padding16_bit_rows()
+        is the 16 bit version of generate_padding_rows(); like generate_padding16_bit(), the stride,
+        width and padding width are given in bytes.
+ */
+void generate_padding16_bit_rows(EbByte src_pic, uint32_t src_stride, uint32_t original_src_width,
+                                 uint32_t padding_width, uint32_t padding_height,
+                                 uint32_t row_start, uint32_t row_count) {
+    EbByte temp_src_pic0 = src_pic + padding_width + (padding_height + row_start) * src_stride;
+    while (row_count) {
+        memset16bit((uint16_t *)(temp_src_pic0 - padding_width),
+                    ((uint16_t *)(temp_src_pic0))[0],
+                    padding_width >> 1);
+        memset16bit((uint16_t *)(temp_src_pic0 + original_src_width),
+                    ((uint16_t *)(temp_src_pic0 + original_src_width - 2))[0],
+                    padding_width >> 1);
+
+        temp_src_pic0 += src_stride;
+        --row_count;
+    }
+}
+
+/** generate_padding_top()
+        is used to replicate the first row of a horizontally padded picture into the top padding.
+        The stride is given in bytes so it serves both bit depths.
+ */
+void generate_padding_top(EbByte src_pic, uint32_t src_stride, uint32_t padding_height) {
+    uint32_t vertical_idx  = padding_height;
+    EbByte   temp_src_pic0 = src_pic + padding_height * src_stride;
+    EbByte   temp_src_pic1 = temp_src_pic0;
+    while (vertical_idx) {
+        temp_src_pic1 -= src_stride;
+        EB_MEMCPY(temp_src_pic1, temp_src_pic0, src_stride);
+        --vertical_idx;
+    }
+}
+
+/** generate_padding_bottom()
+        is used to replicate the last row of a horizontally padded picture into the bottom
+        padding. The top and bottom padding can be generated as soon as their source row is done.
+ */
+void generate_padding_bottom(EbByte src_pic, uint32_t src_stride, uint32_t original_src_height,
+                             uint32_t padding_height) {
+    uint32_t vertical_idx  = padding_height;
+    EbByte   temp_src_pic0 = src_pic + (padding_height + original_src_height - 1) * src_stride;
+    EbByte   temp_src_pic1 = temp_src_pic0;
+    while (vertical_idx) {
+        temp_src_pic1 += src_stride;
+        EB_MEMCPY(temp_src_pic1, temp_src_pic0, src_stride);
+        --vertical_idx;
+    }
+}
+
 /** pad_input_picture()
 is used to pad the input picture in order to get . The horizontal padding happens first and then the vertical padding.
 */
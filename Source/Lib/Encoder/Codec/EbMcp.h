@@ -57,6 +57,21 @@ extern void generate_padding16_bit(EbByte src_pic, uint32_t src_stride, uint32_t
                                    uint32_t original_src_height, uint32_t padding_width,
                                    uint32_t padding_height);
 
+extern void generate_padding_rows(EbByte src_pic, uint32_t src_stride,
+                                  uint32_t original_src_width, uint32_t padding_width,
+                                  uint32_t padding_height, uint32_t row_start,
+                                  uint32_t row_count);
+
+extern void generate_padding16_bit_rows(EbByte src_pic, uint32_t src_stride,
+                                        uint32_t original_src_width, uint32_t padding_width,
+                                        uint32_t padding_height, uint32_t row_start,
+                                        uint32_t row_count);
+
+extern void generate_padding_top(EbByte src_pic, uint32_t src_stride, uint32_t padding_height);
+
+extern void generate_padding_bottom(EbByte src_pic, uint32_t src_stride,
+                                    uint32_t original_src_height, uint32_t padding_height);
+
 extern void pad_input_picture(EbByte src_pic, uint32_t src_stride, uint32_t original_src_width,
                               uint32_t original_src_height, uint32_t pad_right,
                               uint32_t pad_bottom);
@@ -63,121 +63,157 @@ void av1_get_syntax_rate_from_cdf(int32_t *costs, const AomCdfProb *cdf, const i
 int av1_filter_intra_allowed_bsize(uint8_t enable_filter_intra, BlockSize bs);
 
 /*************************************************************
-* av1_estimate_syntax_rate()
-* Estimate the rate for each syntax elements and for
-* all scenarios based on the frame CDF
+* CDF_CHANGED
+* True when the CDF field of fc differs from the one of prev_fc
+* the rate table was last estimated from (always true without prev_fc)
 **************************************************************/
-void av1_estimate_syntax_rate(MdRateEstimationContext *md_rate_estimation_array, EbBool is_i_slice,
-                              FRAME_CONTEXT *fc) {
+#define CDF_CHANGED(field) \
+    (prev_fc == NULL || memcmp(&fc->field, &prev_fc->field, sizeof(fc->field)))
+
+/*************************************************************
+* estimate_syntax_rate()
+* Estimate the rate of the syntax elements whose CDF changed
+**************************************************************/
+static void estimate_syntax_rate(MdRateEstimationContext *md_rate_estimation_array,
+                                 EbBool is_i_slice, const FRAME_CONTEXT *fc,
+                                 const FRAME_CONTEXT *prev_fc) {
     int32_t i, j;
 
     md_rate_estimation_array->initialized = 1;
 
     for (i = 0; i < PARTITION_CONTEXTS; ++i)
-        av1_get_syntax_rate_from_cdf(
-            md_rate_estimation_array->partition_fac_bits[i], fc->partition_cdf[i], NULL);
+        if (CDF_CHANGED(partition_cdf[i]))
+            av1_get_syntax_rate_from_cdf(
+                md_rate_estimation_array->partition_fac_bits[i], fc->partition_cdf[i], NULL);
 
     //if (cm->skip_mode_flag) { // NM - Hardcoded to true
     for (i = 0; i < SKIP_CONTEXTS; ++i)
-        av1_get_syntax_rate_from_cdf(
-            md_rate_estimation_array->skip_mode_fac_bits[i], fc->skip_mode_cdfs[i], NULL);
+        if (CDF_CHANGED(skip_mode_cdfs[i]))
+            av1_get_syntax_rate_from_cdf(
+                md_rate_estimation_array->skip_mode_fac_bits[i], fc->skip_mode_cdfs[i], NULL);
     //}
 
     for (i = 0; i < SKIP_CONTEXTS; ++i)
-        av1_get_syntax_rate_from_cdf(
-            md_rate_estimation_array->skip_fac_bits[i], fc->skip_cdfs[i], NULL);
+        if (CDF_CHANGED(skip_cdfs[i]))
+            av1_get_syntax_rate_from_cdf(
+                md_rate_estimation_array->skip_fac_bits[i], fc->skip_cdfs[i], NULL);
     for (i = 0; i < KF_MODE_CONTEXTS; ++i)
         for (j = 0; j < KF_MODE_CONTEXTS; ++j)
-            av1_get_syntax_rate_from_cdf(
-                md_rate_estimation_array->y_mode_fac_bits[i][j], fc->kf_y_cdf[i][j], NULL);
+            if (CDF_CHANGED(kf_y_cdf[i][j]))
+                av1_get_syntax_rate_from_cdf(
+                    md_rate_estimation_array->y_mode_fac_bits[i][j], fc->kf_y_cdf[i][j], NULL);
 
     for (i = 0; i < BlockSize_GROUPS; ++i)
-        av1_get_syntax_rate_from_cdf(
-            md_rate_estimation_array->mb_mode_fac_bits[i], fc->y_mode_cdf[i], NULL);
+        if (CDF_CHANGED(y_mode_cdf[i]))
+            av1_get_syntax_rate_from_cdf(
+                md_rate_estimation_array->mb_mode_fac_bits[i], fc->y_mode_cdf[i], NULL);
 
     for (i = 0; i < CFL_ALLOWED_TYPES; ++i) {
         for (j = 0; j < INTRA_MODES; ++j)
-            av1_get_syntax_rate_from_cdf(md_rate_estimation_array->intra_uv_mode_fac_bits[i][j],
-                                         fc->uv_mode_cdf[i][j],
-                                         NULL);
+            if (CDF_CHANGED(uv_mode_cdf[i][j]))
+                av1_get_syntax_rate_from_cdf(
+                    md_rate_estimation_array->intra_uv_mode_fac_bits[i][j],
+                    fc->uv_mode_cdf[i][j],
+                    NULL);
     }
 
-    av1_get_syntax_rate_from_cdf(
-        md_rate_estimation_array->filter_intra_mode_fac_bits, fc->filter_intra_mode_cdf, NULL);
+    if (CDF_CHANGED(filter_intra_mode_cdf))
+        av1_get_syntax_rate_from_cdf(
+            md_rate_estimation_array->filter_intra_mode_fac_bits, fc->filter_intra_mode_cdf, NULL);
     for (i = 0; i < BlockSizeS_ALL; ++i) {
-        if (av1_filter_intra_allowed_bsize(1, i))
+        if (av1_filter_intra_allowed_bsize(1, i) && CDF_CHANGED(filter_intra_cdfs[i]))
             av1_get_syntax_rate_from_cdf(
                 md_rate_estimation_array->filter_intra_fac_bits[i], fc->filter_intra_cdfs[i], NULL);
     }
     for (i = 0; i < SWITCHABLE_FILTER_CONTEXTS; ++i)
-        av1_get_syntax_rate_from_cdf(md_rate_estimation_array->switchable_interp_fac_bitss[i],
-                                     fc->switchable_interp_cdf[i],
-                                     NULL);
+        if (CDF_CHANGED(switchable_interp_cdf[i]))
+            av1_get_syntax_rate_from_cdf(md_rate_estimation_array->switchable_interp_fac_bitss[i],
+                                         fc->switchable_interp_cdf[i],
+                                         NULL);
 
     for (i = 0; i < PALATTE_BSIZE_CTXS; ++i) {
-        av1_get_syntax_rate_from_cdf(
-            md_rate_estimation_array->palette_ysize_fac_bits[i], fc->palette_y_size_cdf[i], NULL);
-        av1_get_syntax_rate_from_cdf(md_rate_estimation_array->palette_uv_size_fac_bits[i],
-                                     fc->palette_uv_size_cdf[i],
-                                     NULL);
-        for (j = 0; j < PALETTE_Y_MODE_CONTEXTS; ++j)
-            av1_get_syntax_rate_from_cdf(md_rate_estimation_array->palette_ymode_fac_bits[i][j],
-                                         fc->palette_y_mode_cdf[i][j],
+        if (CDF_CHANGED(palette_y_size_cdf[i]))
+            av1_get_syntax_rate_from_cdf(md_rate_estimation_array->palette_ysize_fac_bits[i],
+                                         fc->palette_y_size_cdf[i],
+                                         NULL);
+        if (CDF_CHANGED(palette_uv_size_cdf[i]))
+            av1_get_syntax_rate_from_cdf(md_rate_estimation_array->palette_uv_size_fac_bits[i],
+                                         fc->palette_uv_size_cdf[i],
                                          NULL);
+        for (j = 0; j < PALETTE_Y_MODE_CONTEXTS; ++j)
+            if (CDF_CHANGED(palette_y_mode_cdf[i][j]))
+                av1_get_syntax_rate_from_cdf(
+                    md_rate_estimation_array->palette_ymode_fac_bits[i][j],
+                    fc->palette_y_mode_cdf[i][j],
+                    NULL);
     }
 
     for (i = 0; i < PALETTE_UV_MODE_CONTEXTS; ++i)
-        av1_get_syntax_rate_from_cdf(md_rate_estimation_array->palette_uv_mode_fac_bits[i],
-                                     fc->palette_uv_mode_cdf[i],
-                                     NULL);
+        if (CDF_CHANGED(palette_uv_mode_cdf[i]))
+            av1_get_syntax_rate_from_cdf(md_rate_estimation_array->palette_uv_mode_fac_bits[i],
+                                         fc->palette_uv_mode_cdf[i],
+                                         NULL);
     for (i = 0; i < PALETTE_SIZES; ++i) {
         for (j = 0; j < PALETTE_COLOR_INDEX_CONTEXTS; ++j) {
-            av1_get_syntax_rate_from_cdf(md_rate_estimation_array->palette_ycolor_fac_bitss[i][j],
-                                         fc->palette_y_color_index_cdf[i][j],
-                                         NULL);
-            av1_get_syntax_rate_from_cdf(md_rate_estimation_array->palette_uv_color_fac_bits[i][j],
-                                         fc->palette_uv_color_index_cdf[i][j],
-                                         NULL);
+            if (CDF_CHANGED(palette_y_color_index_cdf[i][j]))
+                av1_get_syntax_rate_from_cdf(
+                    md_rate_estimation_array->palette_ycolor_fac_bitss[i][j],
+                    fc->palette_y_color_index_cdf[i][j],
+                    NULL);
+            if (CDF_CHANGED(palette_uv_color_index_cdf[i][j]))
+                av1_get_syntax_rate_from_cdf(
+                    md_rate_estimation_array->palette_uv_color_fac_bits[i][j],
+                    fc->palette_uv_color_index_cdf[i][j],
+                    NULL);
         }
     }
 
-    int32_t sign_fac_bits[CFL_JOINT_SIGNS];
-    av1_get_syntax_rate_from_cdf(sign_fac_bits, fc->cfl_sign_cdf, NULL);
-    for (int32_t joint_sign = 0; joint_sign < CFL_JOINT_SIGNS; joint_sign++) {
-        int32_t *fac_bits_u = md_rate_estimation_array->cfl_alpha_fac_bits[joint_sign][CFL_PRED_U];
-        int32_t *fac_bits_v = md_rate_estimation_array->cfl_alpha_fac_bits[joint_sign][CFL_PRED_V];
-        if (CFL_SIGN_U(joint_sign) == CFL_SIGN_ZERO)
-            memset(fac_bits_u, 0, CFL_ALPHABET_SIZE * sizeof(*fac_bits_u));
-        else {
-            const AomCdfProb *cdf_u = fc->cfl_alpha_cdf[CFL_CONTEXT_U(joint_sign)];
-            av1_get_syntax_rate_from_cdf(fac_bits_u, cdf_u, NULL);
-        }
-        if (CFL_SIGN_V(joint_sign) == CFL_SIGN_ZERO)
-            memset(fac_bits_v, 0, CFL_ALPHABET_SIZE * sizeof(*fac_bits_v));
-        else {
-            int32_t cdf_index = CFL_CONTEXT_V(joint_sign);
-            if ((cdf_index < CFL_ALPHA_CONTEXTS) && (cdf_index >= 0)) {
-                const AomCdfProb *cdf_v = fc->cfl_alpha_cdf[cdf_index];
-                av1_get_syntax_rate_from_cdf(fac_bits_v, cdf_v, NULL);
+    // The alpha costs fold in the sign costs: rebuild all of them when either CDF changed
+    if (CDF_CHANGED(cfl_sign_cdf) || CDF_CHANGED(cfl_alpha_cdf)) {
+        int32_t sign_fac_bits[CFL_JOINT_SIGNS];
+        av1_get_syntax_rate_from_cdf(sign_fac_bits, fc->cfl_sign_cdf, NULL);
+        for (int32_t joint_sign = 0; joint_sign < CFL_JOINT_SIGNS; joint_sign++) {
+            int32_t *fac_bits_u =
+                md_rate_estimation_array->cfl_alpha_fac_bits[joint_sign][CFL_PRED_U];
+            int32_t *fac_bits_v =
+                md_rate_estimation_array->cfl_alpha_fac_bits[joint_sign][CFL_PRED_V];
+            if (CFL_SIGN_U(joint_sign) == CFL_SIGN_ZERO)
+                memset(fac_bits_u, 0, CFL_ALPHABET_SIZE * sizeof(*fac_bits_u));
+            else {
+                const AomCdfProb *cdf_u = fc->cfl_alpha_cdf[CFL_CONTEXT_U(joint_sign)];
+                av1_get_syntax_rate_from_cdf(fac_bits_u, cdf_u, NULL);
+            }
+            if (CFL_SIGN_V(joint_sign) == CFL_SIGN_ZERO)
+                memset(fac_bits_v, 0, CFL_ALPHABET_SIZE * sizeof(*fac_bits_v));
+            else {
+                int32_t cdf_index = CFL_CONTEXT_V(joint_sign);
+                if ((cdf_index < CFL_ALPHA_CONTEXTS) && (cdf_index >= 0)) {
+                    const AomCdfProb *cdf_v = fc->cfl_alpha_cdf[cdf_index];
+                    av1_get_syntax_rate_from_cdf(fac_bits_v, cdf_v, NULL);
+                }
             }
+            for (int32_t u = 0; u < CFL_ALPHABET_SIZE; u++)
+                fac_bits_u[u] += sign_fac_bits[joint_sign];
         }
-        for (int32_t u = 0; u < CFL_ALPHABET_SIZE; u++) fac_bits_u[u] += sign_fac_bits[joint_sign];
     }
 
     for (i = 0; i < MAX_TX_CATS; ++i)
         for (j = 0; j < TX_SIZE_CONTEXTS; ++j)
-            av1_get_syntax_rate_from_cdf(
-                md_rate_estimation_array->tx_size_fac_bits[i][j], fc->tx_size_cdf[i][j], NULL);
+            if (CDF_CHANGED(tx_size_cdf[i][j]))
+                av1_get_syntax_rate_from_cdf(
+                    md_rate_estimation_array->tx_size_fac_bits[i][j], fc->tx_size_cdf[i][j], NULL);
 
     for (i = 0; i < TXFM_PARTITION_CONTEXTS; ++i) {
-        av1_get_syntax_rate_from_cdf(
-            md_rate_estimation_array->txfm_partition_fac_bits[i], fc->txfm_partition_cdf[i], NULL);
+        if (CDF_CHANGED(txfm_partition_cdf[i]))
+            av1_get_syntax_rate_from_cdf(md_rate_estimation_array->txfm_partition_fac_bits[i],
+                                         fc->txfm_partition_cdf[i],
+                                         NULL);
     }
 
     for (i = TX_4X4; i < EXT_TX_SIZES; ++i) {
         int32_t s;
         for (s = 1; s < EXT_TX_SETS_INTER; ++s) {
-            if (use_inter_ext_tx_for_txsize[s][i])
+            if (use_inter_ext_tx_for_txsize[s][i] && CDF_CHANGED(inter_ext_tx_cdf[s][i]))
                 av1_get_syntax_rate_from_cdf(md_rate_estimation_array->inter_tx_type_fac_bits[s][i],
                                              fc->inter_ext_tx_cdf[s][i],
                                              av1_ext_tx_inv[av1_ext_tx_set_idx_to_type[1][s]]);
@@ -185,115 +221,162 @@ void av1_estimate_syntax_rate(MdRateEstimationContext *md_rate_estimation_array,
         for (s = 1; s < EXT_TX_SETS_INTRA; ++s) {
             if (use_intra_ext_tx_for_txsize[s][i]) {
                 for (j = 0; j < INTRA_MODES; ++j)
-                    av1_get_syntax_rate_from_cdf(
-                        md_rate_estimation_array->intra_tx_type_fac_bits[s][i][j],
-                        fc->intra_ext_tx_cdf[s][i][j],
-                        av1_ext_tx_inv[av1_ext_tx_set_idx_to_type[0][s]]);
+                    if (CDF_CHANGED(intra_ext_tx_cdf[s][i][j]))
+                        av1_get_syntax_rate_from_cdf(
+                            md_rate_estimation_array->intra_tx_type_fac_bits[s][i][j],
+                            fc->intra_ext_tx_cdf[s][i][j],
+                            av1_ext_tx_inv[av1_ext_tx_set_idx_to_type[0][s]]);
             }
         }
     }
     for (i = 0; i < DIRECTIONAL_MODES; ++i)
+        if (CDF_CHANGED(angle_delta_cdf[i]))
+            av1_get_syntax_rate_from_cdf(
+                md_rate_estimation_array->angle_delta_fac_bits[i], fc->angle_delta_cdf[i], NULL);
+    if (CDF_CHANGED(switchable_restore_cdf))
+        av1_get_syntax_rate_from_cdf(md_rate_estimation_array->switchable_restore_fac_bits,
+                                     fc->switchable_restore_cdf,
+                                     NULL);
+    if (CDF_CHANGED(wiener_restore_cdf))
+        av1_get_syntax_rate_from_cdf(
+            md_rate_estimation_array->wiener_restore_fac_bits, fc->wiener_restore_cdf, NULL);
+    if (CDF_CHANGED(sgrproj_restore_cdf))
+        av1_get_syntax_rate_from_cdf(
+            md_rate_estimation_array->sgrproj_restore_fac_bits, fc->sgrproj_restore_cdf, NULL);
+    if (CDF_CHANGED(intrabc_cdf))
         av1_get_syntax_rate_from_cdf(
-            md_rate_estimation_array->angle_delta_fac_bits[i], fc->angle_delta_cdf[i], NULL);
-    av1_get_syntax_rate_from_cdf(
-        md_rate_estimation_array->switchable_restore_fac_bits, fc->switchable_restore_cdf, NULL);
-    av1_get_syntax_rate_from_cdf(
-        md_rate_estimation_array->wiener_restore_fac_bits, fc->wiener_restore_cdf, NULL);
-    av1_get_syntax_rate_from_cdf(
-        md_rate_estimation_array->sgrproj_restore_fac_bits, fc->sgrproj_restore_cdf, NULL);
-    av1_get_syntax_rate_from_cdf(md_rate_estimation_array->intrabc_fac_bits, fc->intrabc_cdf, NULL);
+            md_rate_estimation_array->intrabc_fac_bits, fc->intrabc_cdf, NULL);
 
     if (!is_i_slice) { // NM - Hardcoded to true
         for (i = 0; i < COMP_INTER_CONTEXTS; ++i)
-            av1_get_syntax_rate_from_cdf(
-                md_rate_estimation_array->comp_inter_fac_bits[i], fc->comp_inter_cdf[i], NULL);
+            if (CDF_CHANGED(comp_inter_cdf[i]))
+                av1_get_syntax_rate_from_cdf(
+                    md_rate_estimation_array->comp_inter_fac_bits[i], fc->comp_inter_cdf[i], NULL);
         for (i = 0; i < REF_CONTEXTS; ++i) {
             for (j = 0; j < SINGLE_REFS - 1; ++j)
-                av1_get_syntax_rate_from_cdf(md_rate_estimation_array->single_ref_fac_bits[i][j],
-                                             fc->single_ref_cdf[i][j],
-                                             NULL);
+                if (CDF_CHANGED(single_ref_cdf[i][j]))
+                    av1_get_syntax_rate_from_cdf(
+                        md_rate_estimation_array->single_ref_fac_bits[i][j],
+                        fc->single_ref_cdf[i][j],
+                        NULL);
         }
 
         for (i = 0; i < COMP_REF_TYPE_CONTEXTS; ++i)
-            av1_get_syntax_rate_from_cdf(md_rate_estimation_array->comp_ref_type_fac_bits[i],
-                                         fc->comp_ref_type_cdf[i],
-                                         NULL);
+            if (CDF_CHANGED(comp_ref_type_cdf[i]))
+                av1_get_syntax_rate_from_cdf(md_rate_estimation_array->comp_ref_type_fac_bits[i],
+                                             fc->comp_ref_type_cdf[i],
+                                             NULL);
         for (i = 0; i < UNI_COMP_REF_CONTEXTS; ++i) {
             for (j = 0; j < UNIDIR_COMP_REFS - 1; ++j)
-                av1_get_syntax_rate_from_cdf(md_rate_estimation_array->uni_comp_ref_fac_bits[i][j],
-                                             fc->uni_comp_ref_cdf[i][j],
-                                             NULL);
+                if (CDF_CHANGED(uni_comp_ref_cdf[i][j]))
+                    av1_get_syntax_rate_from_cdf(
+                        md_rate_estimation_array->uni_comp_ref_fac_bits[i][j],
+                        fc->uni_comp_ref_cdf[i][j],
+                        NULL);
         }
 
         for (i = 0; i < REF_CONTEXTS; ++i) {
             for (j = 0; j < FWD_REFS - 1; ++j)
-                av1_get_syntax_rate_from_cdf(md_rate_estimation_array->comp_ref_fac_bits[i][j],
-                                             fc->comp_ref_cdf[i][j],
-                                             NULL);
+                if (CDF_CHANGED(comp_ref_cdf[i][j]))
+                    av1_get_syntax_rate_from_cdf(
+                        md_rate_estimation_array->comp_ref_fac_bits[i][j],
+                        fc->comp_ref_cdf[i][j],
+                        NULL);
         }
 
         for (i = 0; i < REF_CONTEXTS; ++i) {
             for (j = 0; j < BWD_REFS - 1; ++j)
-                av1_get_syntax_rate_from_cdf(md_rate_estimation_array->comp_bwd_ref_fac_bits[i][j],
-                                             fc->comp_bwdref_cdf[i][j],
-                                             NULL);
+                if (CDF_CHANGED(comp_bwdref_cdf[i][j]))
+                    av1_get_syntax_rate_from_cdf(
+                        md_rate_estimation_array->comp_bwd_ref_fac_bits[i][j],
+                        fc->comp_bwdref_cdf[i][j],
+                        NULL);
         }
 
         for (i = 0; i < INTRA_INTER_CONTEXTS; ++i)
-            av1_get_syntax_rate_from_cdf(
-                md_rate_estimation_array->intra_inter_fac_bits[i], fc->intra_inter_cdf[i], NULL);
+            if (CDF_CHANGED(intra_inter_cdf[i]))
+                av1_get_syntax_rate_from_cdf(md_rate_estimation_array->intra_inter_fac_bits[i],
+                                             fc->intra_inter_cdf[i],
+                                             NULL);
         for (i = 0; i < NEWMV_MODE_CONTEXTS; ++i)
-            av1_get_syntax_rate_from_cdf(
-                md_rate_estimation_array->new_mv_mode_fac_bits[i], fc->newmv_cdf[i], NULL);
+            if (CDF_CHANGED(newmv_cdf[i]))
+                av1_get_syntax_rate_from_cdf(
+                    md_rate_estimation_array->new_mv_mode_fac_bits[i], fc->newmv_cdf[i], NULL);
         for (i = 0; i < GLOBALMV_MODE_CONTEXTS; ++i)
-            av1_get_syntax_rate_from_cdf(
-                md_rate_estimation_array->zero_mv_mode_fac_bits[i], fc->zeromv_cdf[i], NULL);
+            if (CDF_CHANGED(zeromv_cdf[i]))
+                av1_get_syntax_rate_from_cdf(
+                    md_rate_estimation_array->zero_mv_mode_fac_bits[i], fc->zeromv_cdf[i], NULL);
         for (i = 0; i < REFMV_MODE_CONTEXTS; ++i)
-            av1_get_syntax_rate_from_cdf(
-                md_rate_estimation_array->ref_mv_mode_fac_bits[i], fc->refmv_cdf[i], NULL);
+            if (CDF_CHANGED(refmv_cdf[i]))
+                av1_get_syntax_rate_from_cdf(
+                    md_rate_estimation_array->ref_mv_mode_fac_bits[i], fc->refmv_cdf[i], NULL);
         for (i = 0; i < DRL_MODE_CONTEXTS; ++i)
-            av1_get_syntax_rate_from_cdf(
-                md_rate_estimation_array->drl_mode_fac_bits[i], fc->drl_cdf[i], NULL);
+            if (CDF_CHANGED(drl_cdf[i]))
+                av1_get_syntax_rate_from_cdf(
+                    md_rate_estimation_array->drl_mode_fac_bits[i], fc->drl_cdf[i], NULL);
         for (i = 0; i < INTER_MODE_CONTEXTS; ++i)
-            av1_get_syntax_rate_from_cdf(md_rate_estimation_array->inter_compound_mode_fac_bits[i],
-                                         fc->inter_compound_mode_cdf[i],
-                                         NULL);
+            if (CDF_CHANGED(inter_compound_mode_cdf[i]))
+                av1_get_syntax_rate_from_cdf(
+                    md_rate_estimation_array->inter_compound_mode_fac_bits[i],
+                    fc->inter_compound_mode_cdf[i],
+                    NULL);
         for (i = 0; i < BlockSizeS_ALL; ++i)
-            av1_get_syntax_rate_from_cdf(md_rate_estimation_array->compound_type_fac_bits[i],
-                                         fc->compound_type_cdf[i],
-                                         NULL);
+            if (CDF_CHANGED(compound_type_cdf[i]))
+                av1_get_syntax_rate_from_cdf(md_rate_estimation_array->compound_type_fac_bits[i],
+                                             fc->compound_type_cdf[i],
+                                             NULL);
         for (i = 0; i < BlockSizeS_ALL; ++i) {
-            if (get_interinter_wedge_bits((BlockSize)i))
+            if (get_interinter_wedge_bits((BlockSize)i) && CDF_CHANGED(wedge_idx_cdf[i]))
                 av1_get_syntax_rate_from_cdf(
                     md_rate_estimation_array->wedge_idx_fac_bits[i], fc->wedge_idx_cdf[i], NULL);
         }
         for (i = 0; i < BlockSize_GROUPS; ++i) {
-            av1_get_syntax_rate_from_cdf(
-                md_rate_estimation_array->inter_intra_fac_bits[i], fc->interintra_cdf[i], NULL);
-            av1_get_syntax_rate_from_cdf(md_rate_estimation_array->inter_intra_mode_fac_bits[i],
-                                         fc->interintra_mode_cdf[i],
-                                         NULL);
+            if (CDF_CHANGED(interintra_cdf[i]))
+                av1_get_syntax_rate_from_cdf(
+                    md_rate_estimation_array->inter_intra_fac_bits[i], fc->interintra_cdf[i], NULL);
+            if (CDF_CHANGED(interintra_mode_cdf[i]))
+                av1_get_syntax_rate_from_cdf(
+                    md_rate_estimation_array->inter_intra_mode_fac_bits[i],
+                    fc->interintra_mode_cdf[i],
+                    NULL);
         }
         for (i = 0; i < BlockSizeS_ALL; ++i)
-            av1_get_syntax_rate_from_cdf(md_rate_estimation_array->wedge_inter_intra_fac_bits[i],
-                                         fc->wedge_interintra_cdf[i],
-                                         NULL);
+            if (CDF_CHANGED(wedge_interintra_cdf[i]))
+                av1_get_syntax_rate_from_cdf(
+                    md_rate_estimation_array->wedge_inter_intra_fac_bits[i],
+                    fc->wedge_interintra_cdf[i],
+                    NULL);
         for (i = BLOCK_8X8; i < BlockSizeS_ALL; i++)
-            av1_get_syntax_rate_from_cdf(
-                md_rate_estimation_array->motion_mode_fac_bits[i], fc->motion_mode_cdf[i], NULL);
+            if (CDF_CHANGED(motion_mode_cdf[i]))
+                av1_get_syntax_rate_from_cdf(
+                    md_rate_estimation_array->motion_mode_fac_bits[i], fc->motion_mode_cdf[i], NULL);
         for (i = BLOCK_8X8; i < BlockSizeS_ALL; i++)
-            av1_get_syntax_rate_from_cdf(
-                md_rate_estimation_array->motion_mode_fac_bits1[i], fc->obmc_cdf[i], NULL);
+            if (CDF_CHANGED(obmc_cdf[i]))
+                av1_get_syntax_rate_from_cdf(
+                    md_rate_estimation_array->motion_mode_fac_bits1[i], fc->obmc_cdf[i], NULL);
         for (i = 0; i < COMP_INDEX_CONTEXTS; ++i)
-            av1_get_syntax_rate_from_cdf(
-                md_rate_estimation_array->comp_idx_fac_bits[i], fc->compound_index_cdf[i], NULL);
+            if (CDF_CHANGED(compound_index_cdf[i]))
+                av1_get_syntax_rate_from_cdf(md_rate_estimation_array->comp_idx_fac_bits[i],
+                                             fc->compound_index_cdf[i],
+                                             NULL);
         for (i = 0; i < COMP_GROUP_IDX_CONTEXTS; ++i)
-            av1_get_syntax_rate_from_cdf(md_rate_estimation_array->comp_group_idx_fac_bits[i],
-                                         fc->comp_group_idx_cdf[i],
-                                         NULL);
+            if (CDF_CHANGED(comp_group_idx_cdf[i]))
+                av1_get_syntax_rate_from_cdf(md_rate_estimation_array->comp_group_idx_fac_bits[i],
+                                             fc->comp_group_idx_cdf[i],
+                                             NULL);
     }
 }
 
+/*************************************************************
+* av1_estimate_syntax_rate()
+* Estimate the rate for each syntax elements and for
+* all scenarios based on the frame CDF
+**************************************************************/
+void av1_estimate_syntax_rate(MdRateEstimationContext *md_rate_estimation_array, EbBool is_i_slice,
+                              FRAME_CONTEXT *fc) {
+    estimate_syntax_rate(md_rate_estimation_array, is_i_slice, fc, NULL);
+}
+
 static const uint8_t log_in_base_2[] = {
     0, 0, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
     5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
@@ -346,14 +429,12 @@ void eb_av1_build_nmv_cost_table(int32_t *mvjoint, int32_t *mvcost[2], const Nmv
                                  MvSubpelPrecision precision);
 
 /**************************************************************************
-* av1_estimate_mv_rate()
-* Estimate the rate of motion vectors
-* based on the frame CDF
+* estimate_mv_rate()
+* Estimate the rate of motion vectors whose CDF changed
 ***************************************************************************/
-void av1_estimate_mv_rate(PictureControlSet *      pcs_ptr,
-                          MdRateEstimationContext *md_rate_estimation_array, FRAME_CONTEXT *fc)
-
-{
+static void estimate_mv_rate(PictureControlSet *      pcs_ptr,
+                             MdRateEstimationContext *md_rate_estimation_array,
+                             const FRAME_CONTEXT *fc, const FRAME_CONTEXT *prev_fc) {
     int32_t *    nmvcost[2];
     int32_t *    nmvcost_hp[2];
     FrameHeader *frm_hdr = &pcs_ptr->parent_pcs_ptr->frm_hdr;
@@ -363,30 +444,43 @@ void av1_estimate_mv_rate(PictureControlSet *      pcs_ptr,
     nmvcost_hp[0] = &md_rate_estimation_array->nmv_costs_hp[0][MV_MAX];
     nmvcost_hp[1] = &md_rate_estimation_array->nmv_costs_hp[1][MV_MAX];
 
-    eb_av1_build_nmv_cost_table(md_rate_estimation_array->nmv_vec_cost, //out
-                                frm_hdr->allow_high_precision_mv ? nmvcost_hp : nmvcost, //out
-                                &fc->nmvc,
-                                frm_hdr->allow_high_precision_mv);
+    if (CDF_CHANGED(nmvc))
+        eb_av1_build_nmv_cost_table(md_rate_estimation_array->nmv_vec_cost, //out
+                                    frm_hdr->allow_high_precision_mv ? nmvcost_hp : nmvcost, //out
+                                    &fc->nmvc,
+                                    frm_hdr->allow_high_precision_mv);
     md_rate_estimation_array->nmvcoststack[0] =
         frm_hdr->allow_high_precision_mv ? &md_rate_estimation_array->nmv_costs_hp[0][MV_MAX]
                                          : &md_rate_estimation_array->nmv_costs[0][MV_MAX];
     md_rate_estimation_array->nmvcoststack[1] =
         frm_hdr->allow_high_precision_mv ? &md_rate_estimation_array->nmv_costs_hp[1][MV_MAX]
                                          : &md_rate_estimation_array->nmv_costs[1][MV_MAX];
-    if (frm_hdr->allow_intrabc) {
+    if (frm_hdr->allow_intrabc && CDF_CHANGED(ndvc)) {
         int32_t *dvcost[2] = {&md_rate_estimation_array->dv_cost[0][MV_MAX],
                               &md_rate_estimation_array->dv_cost[1][MV_MAX]};
         eb_av1_build_nmv_cost_table(
             md_rate_estimation_array->dv_joint_cost, dvcost, &fc->ndvc, MV_SUBPEL_NONE);
     }
 }
+
 /**************************************************************************
-* av1_estimate_coefficients_rate()
-* Estimate the rate of the quantised coefficient
+* av1_estimate_mv_rate()
+* Estimate the rate of motion vectors
 * based on the frame CDF
 ***************************************************************************/
-void av1_estimate_coefficients_rate(MdRateEstimationContext *md_rate_estimation_array,
-                                    FRAME_CONTEXT *          fc) {
+void av1_estimate_mv_rate(PictureControlSet *      pcs_ptr,
+                          MdRateEstimationContext *md_rate_estimation_array, FRAME_CONTEXT *fc)
+
+{
+    estimate_mv_rate(pcs_ptr, md_rate_estimation_array, fc, NULL);
+}
+
+/**************************************************************************
+* estimate_coefficients_rate()
+* Estimate the rate of the quantised coefficient whose CDF changed
+***************************************************************************/
+static void estimate_coefficients_rate(MdRateEstimationContext *md_rate_estimation_array,
+                                       const FRAME_CONTEXT *fc, const FRAME_CONTEXT *prev_fc) {
     int32_t       num_planes     = 3; // NM - Hardcoded to 3
     const int32_t nplanes        = AOMMIN(num_planes, PLANE_TYPES);
     int32_t       eob_multi_size = 0;
@@ -398,18 +492,40 @@ void av1_estimate_coefficients_rate(MdRateEstimationContext *md_rate_estimation_
         for (plane = 0; plane < nplanes; ++plane) {
             LvMapEobCost *pcost = &md_rate_estimation_array->eob_frac_bits[eob_multi_size][plane];
             for (ctx = 0; ctx < 2; ++ctx) {
-                AomCdfProb *pcdf;
+                const AomCdfProb *pcdf;
+                EbBool            changed;
                 switch (eob_multi_size) {
-                case 0: pcdf = fc->eob_flag_cdf16[plane][ctx]; break;
-                case 1: pcdf = fc->eob_flag_cdf32[plane][ctx]; break;
-                case 2: pcdf = fc->eob_flag_cdf64[plane][ctx]; break;
-                case 3: pcdf = fc->eob_flag_cdf128[plane][ctx]; break;
-                case 4: pcdf = fc->eob_flag_cdf256[plane][ctx]; break;
-                case 5: pcdf = fc->eob_flag_cdf512[plane][ctx]; break;
+                case 0:
+                    pcdf    = fc->eob_flag_cdf16[plane][ctx];
+                    changed = CDF_CHANGED(eob_flag_cdf16[plane][ctx]);
+                    break;
+                case 1:
+                    pcdf    = fc->eob_flag_cdf32[plane][ctx];
+                    changed = CDF_CHANGED(eob_flag_cdf32[plane][ctx]);
+                    break;
+                case 2:
+                    pcdf    = fc->eob_flag_cdf64[plane][ctx];
+                    changed = CDF_CHANGED(eob_flag_cdf64[plane][ctx]);
+                    break;
+                case 3:
+                    pcdf    = fc->eob_flag_cdf128[plane][ctx];
+                    changed = CDF_CHANGED(eob_flag_cdf128[plane][ctx]);
+                    break;
+                case 4:
+                    pcdf    = fc->eob_flag_cdf256[plane][ctx];
+                    changed = CDF_CHANGED(eob_flag_cdf256[plane][ctx]);
+                    break;
+                case 5:
+                    pcdf    = fc->eob_flag_cdf512[plane][ctx];
+                    changed = CDF_CHANGED(eob_flag_cdf512[plane][ctx]);
+                    break;
                 case 6:
-                default: pcdf = fc->eob_flag_cdf1024[plane][ctx]; break;
+                default:
+                    pcdf    = fc->eob_flag_cdf1024[plane][ctx];
+                    changed = CDF_CHANGED(eob_flag_cdf1024[plane][ctx]);
+                    break;
                 }
-                av1_get_syntax_rate_from_cdf(pcost->eob_cost[ctx], pcdf, NULL);
+                if (changed) av1_get_syntax_rate_from_cdf(pcost->eob_cost[ctx], pcdf, NULL);
             }
         }
     }
@@ -418,16 +534,19 @@ void av1_estimate_coefficients_rate(MdRateEstimationContext *md_rate_estimation_
             LvMapCoeffCost *pcost = &md_rate_estimation_array->coeff_fac_bits[tx_size][plane];
 
             for (ctx = 0; ctx < TXB_SKIP_CONTEXTS; ++ctx)
-                av1_get_syntax_rate_from_cdf(
-                    pcost->txb_skip_cost[ctx], fc->txb_skip_cdf[tx_size][ctx], NULL);
+                if (CDF_CHANGED(txb_skip_cdf[tx_size][ctx]))
+                    av1_get_syntax_rate_from_cdf(
+                        pcost->txb_skip_cost[ctx], fc->txb_skip_cdf[tx_size][ctx], NULL);
 
             for (ctx = 0; ctx < SIG_COEF_CONTEXTS_EOB; ++ctx)
-                av1_get_syntax_rate_from_cdf(
-                    pcost->base_eob_cost[ctx], fc->coeff_base_eob_cdf[tx_size][plane][ctx], NULL);
-            for (ctx = 0; ctx < SIG_COEF_CONTEXTS; ++ctx)
+                if (CDF_CHANGED(coeff_base_eob_cdf[tx_size][plane][ctx]))
+                    av1_get_syntax_rate_from_cdf(pcost->base_eob_cost[ctx],
+                                                 fc->coeff_base_eob_cdf[tx_size][plane][ctx],
+                                                 NULL);
+            for (ctx = 0; ctx < SIG_COEF_CONTEXTS; ++ctx) {
+                if (!CDF_CHANGED(coeff_base_cdf[tx_size][plane][ctx])) continue;
                 av1_get_syntax_rate_from_cdf(
                     pcost->base_cost[ctx], fc->coeff_base_cdf[tx_size][plane][ctx], NULL);
-            for (int ctx = 0; ctx < SIG_COEF_CONTEXTS; ++ctx) {
                 pcost->base_cost[ctx][4] = 0;
                 pcost->base_cost[ctx][5] =
                     pcost->base_cost[ctx][1] + av1_cost_literal(1) - pcost->base_cost[ctx][0];
@@ -435,36 +554,29 @@ void av1_estimate_coefficients_rate(MdRateEstimationContext *md_rate_estimation_
                 pcost->base_cost[ctx][7] = pcost->base_cost[ctx][3] - pcost->base_cost[ctx][2];
             }
             for (ctx = 0; ctx < EOB_COEF_CONTEXTS; ++ctx)
-                av1_get_syntax_rate_from_cdf(
-                    pcost->eob_extra_cost[ctx], fc->eob_extra_cdf[tx_size][plane][ctx], NULL);
+                if (CDF_CHANGED(eob_extra_cdf[tx_size][plane][ctx]))
+                    av1_get_syntax_rate_from_cdf(
+                        pcost->eob_extra_cost[ctx], fc->eob_extra_cdf[tx_size][plane][ctx], NULL);
 
             for (ctx = 0; ctx < DC_SIGN_CONTEXTS; ++ctx)
-                av1_get_syntax_rate_from_cdf(
-                    pcost->dc_sign_cost[ctx], fc->dc_sign_cdf[plane][ctx], NULL);
+                if (CDF_CHANGED(dc_sign_cdf[plane][ctx]))
+                    av1_get_syntax_rate_from_cdf(
+                        pcost->dc_sign_cost[ctx], fc->dc_sign_cdf[plane][ctx], NULL);
 
             for (ctx = 0; ctx < LEVEL_CONTEXTS; ++ctx) {
                 int32_t br_rate[BR_CDF_SIZE];
                 int32_t prev_cost = 0;
                 int32_t i, j;
+                if (!CDF_CHANGED(coeff_br_cdf[tx_size][plane][ctx])) continue;
                 av1_get_syntax_rate_from_cdf(br_rate, fc->coeff_br_cdf[tx_size][plane][ctx], NULL);
-                // SVT_LOG("br_rate: ");
-                // for(j = 0; j < BR_CDF_SIZE; j++)
-                //  SVT_LOG("%4d ", br_rate[j]);
-                // SVT_LOG("\n");
                 for (i = 0; i < COEFF_BASE_RANGE; i += BR_CDF_SIZE - 1) {
                     for (j = 0; j < BR_CDF_SIZE - 1; j++)
                         pcost->lps_cost[ctx][i + j] = prev_cost + br_rate[j];
                     prev_cost += br_rate[j];
                 }
                 pcost->lps_cost[ctx][i] = prev_cost;
-                // SVT_LOG("lps_cost: %d %d %2d : ", tx_size, plane, ctx);
-                // for (i = 0; i <= COEFF_BASE_RANGE; i++)
-                //  SVT_LOG("%5d ", pcost->lps_cost[ctx][i]);
-                // SVT_LOG("\n");
-            }
-            for (int ctx = 0; ctx < LEVEL_CONTEXTS; ++ctx) {
                 pcost->lps_cost[ctx][0 + COEFF_BASE_RANGE + 1] = pcost->lps_cost[ctx][0];
-                for (int i = 1; i <= COEFF_BASE_RANGE; ++i) {
+                for (i = 1; i <= COEFF_BASE_RANGE; ++i) {
                     pcost->lps_cost[ctx][i + COEFF_BASE_RANGE + 1] =
                         pcost->lps_cost[ctx][i] - pcost->lps_cost[ctx][i - 1];
                 }
@@ -472,6 +584,50 @@ void av1_estimate_coefficients_rate(MdRateEstimationContext *md_rate_estimation_
         }
     }
 }
+
+/**************************************************************************
+* av1_estimate_coefficients_rate()
+* Estimate the rate of the quantised coefficient
+* based on the frame CDF
+***************************************************************************/
+void av1_estimate_coefficients_rate(MdRateEstimationContext *md_rate_estimation_array,
+                                    FRAME_CONTEXT *          fc) {
+    estimate_coefficients_rate(md_rate_estimation_array, fc, NULL);
+}
+
+/**************************************************************************
+* av1_update_rate_estimation_cache()
+* Bring the cached rate table in line with the CDFs fc of the next SB.
+* The first SB of a picture seen by the cache starts from the picture
+* table and is fully estimated; the following ones only re-estimate the
+* entries whose CDFs differ from the ones the table was last built from.
+* The MV costs are rebuilt in full when the MV precision or intrabc
+* differ from the ones they were built with.
+***************************************************************************/
+void av1_update_rate_estimation_cache(MdRateEstimationCache *cache, PictureControlSet *pcs_ptr,
+                                      const FRAME_CONTEXT *fc) {
+    const FrameHeader *  frm_hdr    = &pcs_ptr->parent_pcs_ptr->frm_hdr;
+    const FRAME_CONTEXT *prev_fc    = &cache->fc;
+    const FRAME_CONTEXT *prev_mv_fc = &cache->fc;
+
+    if (!cache->valid || cache->generation != pcs_ptr->generation) {
+        cache->rate_table = *pcs_ptr->md_rate_estimation_array;
+        cache->generation = pcs_ptr->generation;
+        cache->valid      = EB_TRUE;
+        prev_fc           = NULL;
+        prev_mv_fc        = NULL;
+    }
+    if (cache->allow_high_precision_mv != frm_hdr->allow_high_precision_mv ||
+        cache->allow_intrabc != frm_hdr->allow_intrabc)
+        prev_mv_fc = NULL;
+    cache->allow_high_precision_mv = frm_hdr->allow_high_precision_mv;
+    cache->allow_intrabc           = frm_hdr->allow_intrabc;
+
+    estimate_syntax_rate(&cache->rate_table, pcs_ptr->slice_type == I_SLICE, fc, prev_fc);
+    estimate_mv_rate(pcs_ptr, &cache->rate_table, fc, prev_mv_fc);
+    estimate_coefficients_rate(&cache->rate_table, fc, prev_fc);
+    cache->fc = *fc;
+}
 static INLINE int av1_get_skip_mode_context(const MacroBlockD *xd) {
     const MbModeInfo *const above_mi        = xd->above_mbmi;
     const MbModeInfo *const left_mi         = xd->left_mbmi;
@@ -1069,7 +1225,8 @@ void update_stats(PictureControlSet *pcs_ptr, CodingUnit *blk_ptr, int mi_row, i
 /*******************************************************************************
  * Updates the partition stats/CDF for the current block
  ******************************************************************************/
-void update_part_stats(PictureControlSet *pcs_ptr, CodingUnit *blk_ptr, int mi_row, int mi_col) {
+void update_part_stats(PictureControlSet *pcs_ptr, CodingUnit *blk_ptr, uint16_t tile_idx,
+                       int mi_row, int mi_col) {
     const AV1_COMMON *const cm       = pcs_ptr->parent_pcs_ptr->av1_cm;
     MacroBlockD *           xd       = blk_ptr->av1xd;
     const BlockGeom *       blk_geom = get_blk_geom_mds(blk_ptr->mds_idx);
@@ -1084,7 +1241,7 @@ void update_part_stats(PictureControlSet *pcs_ptr, CodingUnit *blk_ptr, int mi_r
         int                 ctx;
 
         NeighborArrayUnit *partition_context_neighbor_array =
-            pcs_ptr->ep_partition_context_neighbor_array;
+            pcs_ptr->ep_partition_context_neighbor_array[tile_idx];
         uint32_t partition_context_left_neighbor_index = get_neighbor_array_unit_left_index(
             partition_context_neighbor_array, (mi_row << MI_SIZE_LOG2));
         uint32_t partition_context_top_neighbor_index = get_neighbor_array_unit_top_index(
@@ -124,6 +124,24 @@ extern "C" {
         int32_t switchable_interp_fac_bitss[SWITCHABLE_FILTER_CONTEXTS][SWITCHABLE_FILTERS];
         int32_t initialized;
     } MdRateEstimationContext;
+
+    /**************************************
+     * MD Rate Estimation Cache
+     * Rate table of the SBs processed by one EncDec thread, kept
+     * with the CDFs it was last estimated from so that only the
+     * entries of the changed CDFs are rebuilt from one SB to the next
+     **************************************/
+    typedef struct MdRateEstimationCache
+    {
+        MdRateEstimationContext rate_table;
+        FRAME_CONTEXT           fc;
+        // generation - PictureControlSet generation the table was built for
+        uint64_t                generation;
+        // MV cost settings the nmv/dv tables were built with
+        uint8_t                 allow_high_precision_mv;
+        uint8_t                 allow_intrabc;
+        EbBool                  valid;
+    } MdRateEstimationCache;
     /***************************************************************************
     * AV1 Probability table
     * // round(-log2(i/256.) * (1 << AV1_PROB_COST_SHIFT)); i = 128~255.
@@ -322,6 +340,15 @@ extern void av1_estimate_mv_rate(
         struct PictureControlSet *pcs_ptr,
         MdRateEstimationContext  *md_rate_estimation_array,
         FRAME_CONTEXT            *fc);
+    /**************************************************************************
+    * av1_update_rate_estimation_cache()
+    * Update the cached rate table for the CDFs of the next SB,
+    * re-estimating only the syntax elements whose CDFs changed
+    ***************************************************************************/
+extern void av1_update_rate_estimation_cache(
+        MdRateEstimationCache    *cache,
+        struct PictureControlSet *pcs_ptr,
+        const FRAME_CONTEXT      *fc);
 #define AVG_CDF_WEIGHT_LEFT      3
 #define AVG_CDF_WEIGHT_TOP       1
 
@@ -514,6 +541,7 @@ void update_stats(
 void update_part_stats(
     struct PictureControlSet   *pcs_ptr,
     struct CodingUnit          *blk_ptr,
+    uint16_t                    tile_idx,
     int                         mi_row,
     int                         mi_col);
 
@@ -232,6 +232,25 @@ void combine_interintra(InterIntraMode mode, int8_t use_wedge_interintra, int we
                         int wedge_sign, BlockSize bsize, BlockSize plane_bsize, uint8_t *comppred,
                         int compstride, const uint8_t *interpred, int interstride,
                         const uint8_t *intrapred, int intrastride);
+/* Whether a warped (or non-translational global) prediction of the current block only reads
+ * reference rows the EncDec gate of its SB row waited for: the model is affine, so the lowest
+ * source row is at one of the block corners. Always true outside the inter-frame wavefront. */
+static EbBool warp_in_ref_rows(const ModeDecisionContext *context_ptr,
+                               const EbWarpedMotionParams *wm_params) {
+    if (context_ptr->ref_rows_bound == REF_ROWS_ALL) return EB_TRUE;
+    for (int32_t corner = 0; corner < 4; corner++) {
+        const int64_t src_x =
+            context_ptr->blk_origin_x + ((corner & 1) ? context_ptr->blk_geom->bwidth : 0);
+        const int64_t src_y =
+            context_ptr->blk_origin_y + ((corner & 2) ? context_ptr->blk_geom->bheight : 0);
+        const int64_t row = ((int64_t)wm_params->wmmat[4] * src_x +
+                             (int64_t)wm_params->wmmat[5] * src_y + wm_params->wmmat[1]) >>
+            WARPEDMODEL_PREC_BITS;
+        if (row > context_ptr->ref_rows_bound) return EB_FALSE;
+    }
+    return EB_TRUE;
+}
+
 void inter_intra_search(PictureControlSet *pcs_ptr, ModeDecisionContext *context_ptr,
                         ModeDecisionCandidate *candidate_ptr) {
     DECLARE_ALIGNED(16, uint8_t, tmp_buf[2 * MAX_INTERINTRA_SB_SQUARE]);
@@ -833,8 +852,7 @@ void unipred_3x3_candidates_injection(const SequenceControlSet *scs_ptr, Picture
     EbBool       is_compound_enabled    = (frm_hdr->reference_mode == SINGLE_REFERENCE) ? 0 : 1;
     IntMv        best_pred_mv[2]        = {{0}, {0}};
     int          inside_tile            = 1;
-    MacroBlockD *xd                     = context_ptr->blk_ptr->av1xd;
-    int          umv0tile               = (scs_ptr->static_config.unrestricted_motion_vector == 0);
+    int          mv_bounded             = context_ptr->mv_bounded;
     uint32_t     mi_row                 = context_ptr->blk_origin_y >> MI_SIZE_LOG2;
     uint32_t     mi_col                 = context_ptr->blk_origin_x >> MI_SIZE_LOG2;
 
@@ -881,8 +899,8 @@ void unipred_3x3_candidates_injection(const SequenceControlSet *scs_ptr, Picture
                     context_ptr, to_inject_ref_type, context_ptr->blk_geom->shape);
 
                 inside_tile = 1;
-                if (umv0tile)
-                    inside_tile = is_inside_tile_boundary(&(xd->tile),
+                if (mv_bounded)
+                    inside_tile = is_inside_tile_boundary(&context_ptr->mv_bound_tile,
                                                           to_inject_mv_x,
                                                           to_inject_mv_y,
                                                           mi_col,
@@ -1042,8 +1060,8 @@ void unipred_3x3_candidates_injection(const SequenceControlSet *scs_ptr, Picture
                         context_ptr, to_inject_ref_type, context_ptr->blk_geom->shape);
 
                     inside_tile = 1;
-                    if (umv0tile)
-                        inside_tile = is_inside_tile_boundary(&(xd->tile),
+                    if (mv_bounded)
+                        inside_tile = is_inside_tile_boundary(&context_ptr->mv_bound_tile,
                                                               to_inject_mv_x,
                                                               to_inject_mv_y,
                                                               mi_col,
@@ -1163,8 +1181,7 @@ void bipred_3x3_candidates_injection(const SequenceControlSet *scs_ptr, PictureC
     EbBool       is_compound_enabled    = (frm_hdr->reference_mode == SINGLE_REFERENCE) ? 0 : 1;
     IntMv        best_pred_mv[2]        = {{0}, {0}};
     int          inside_tile            = 1;
-    MacroBlockD *xd                     = context_ptr->blk_ptr->av1xd;
-    int          umv0tile               = (scs_ptr->static_config.unrestricted_motion_vector == 0);
+    int          mv_bounded             = context_ptr->mv_bounded;
     uint32_t     mi_row                 = context_ptr->blk_origin_y >> MI_SIZE_LOG2;
     uint32_t     mi_col                 = context_ptr->blk_origin_x >> MI_SIZE_LOG2;
     MD_COMP_TYPE cur_type; //BIP 3x3
@@ -1263,14 +1280,14 @@ void bipred_3x3_candidates_injection(const SequenceControlSet *scs_ptr, PictureC
                         context_ptr, to_inject_ref_type, context_ptr->blk_geom->shape);
 
                     inside_tile = 1;
-                    if (umv0tile) {
-                        inside_tile = is_inside_tile_boundary(&(xd->tile),
+                    if (mv_bounded) {
+                        inside_tile = is_inside_tile_boundary(&context_ptr->mv_bound_tile,
                                                               to_inject_mv_x_l0,
                                                               to_inject_mv_y_l0,
                                                               mi_col,
                                                               mi_row,
                                                               context_ptr->blk_geom->bsize) &&
-                                      is_inside_tile_boundary(&(xd->tile),
+                                      is_inside_tile_boundary(&context_ptr->mv_bound_tile,
                                                               to_inject_mv_x_l1,
                                                               to_inject_mv_y_l1,
                                                               mi_col,
@@ -1432,14 +1449,14 @@ void bipred_3x3_candidates_injection(const SequenceControlSet *scs_ptr, PictureC
                         context_ptr, to_inject_ref_type, context_ptr->blk_geom->shape);
 
                     inside_tile = 1;
-                    if (umv0tile) {
-                        inside_tile = is_inside_tile_boundary(&(xd->tile),
+                    if (mv_bounded) {
+                        inside_tile = is_inside_tile_boundary(&context_ptr->mv_bound_tile,
                                                               to_inject_mv_x_l0,
                                                               to_inject_mv_y_l0,
                                                               mi_col,
                                                               mi_row,
                                                               context_ptr->blk_geom->bsize) &&
-                                      is_inside_tile_boundary(&(xd->tile),
+                                      is_inside_tile_boundary(&context_ptr->mv_bound_tile,
                                                               to_inject_mv_x_l1,
                                                               to_inject_mv_y_l1,
                                                               mi_col,
@@ -1600,11 +1617,9 @@ void inject_mvp_candidates_ii(struct ModeDecisionContext *context_ptr, PictureCo
 
     MvReferenceFrame    rf[2];
     int                 inside_tile = 1;
-    SequenceControlSet *scs_ptr =
-        (SequenceControlSet *)pcs_ptr->parent_pcs_ptr->scs_wrapper_ptr->object_ptr;
-    int      umv0tile = (scs_ptr->static_config.unrestricted_motion_vector == 0);
-    uint32_t mi_row   = context_ptr->blk_origin_y >> MI_SIZE_LOG2;
-    uint32_t mi_col   = context_ptr->blk_origin_x >> MI_SIZE_LOG2;
+    int      mv_bounded = context_ptr->mv_bounded;
+    uint32_t mi_row     = context_ptr->blk_origin_y >> MI_SIZE_LOG2;
+    uint32_t mi_col     = context_ptr->blk_origin_x >> MI_SIZE_LOG2;
     av1_set_ref_frame(rf, ref_pair);
     MD_COMP_TYPE cur_type; //MVP
     BlockSize    bsize          = context_ptr->blk_geom->bsize; // bloc size
@@ -1633,8 +1648,8 @@ void inject_mvp_candidates_ii(struct ModeDecisionContext *context_ptr, PictureCo
                            mrp_is_already_injected_mv_l1(
                                context_ptr, to_inject_mv_x, to_inject_mv_y, frame_type) == EB_FALSE;
 
-        if (umv0tile)
-            inside_tile = is_inside_tile_boundary(&(xd->tile),
+        if (mv_bounded)
+            inside_tile = is_inside_tile_boundary(&context_ptr->mv_bound_tile,
                                                   to_inject_mv_x,
                                                   to_inject_mv_y,
                                                   mi_col,
@@ -1739,8 +1754,8 @@ void inject_mvp_candidates_ii(struct ModeDecisionContext *context_ptr, PictureCo
                           mrp_is_already_injected_mv_l1(
                               context_ptr, to_inject_mv_x, to_inject_mv_y, frame_type) == EB_FALSE;
 
-            if (umv0tile)
-                inside_tile = is_inside_tile_boundary(&(xd->tile),
+            if (mv_bounded)
+                inside_tile = is_inside_tile_boundary(&context_ptr->mv_bound_tile,
                                                       to_inject_mv_x,
                                                       to_inject_mv_y,
                                                       mi_col,
@@ -1859,14 +1874,14 @@ void inject_mvp_candidates_ii(struct ModeDecisionContext *context_ptr, PictureCo
                                                        to_inject_mv_y_l1,
                                                        ref_pair) == EB_FALSE;
 
-            if (umv0tile) {
-                inside_tile = is_inside_tile_boundary(&(xd->tile),
+            if (mv_bounded) {
+                inside_tile = is_inside_tile_boundary(&context_ptr->mv_bound_tile,
                                                       to_inject_mv_x_l0,
                                                       to_inject_mv_y_l0,
                                                       mi_col,
                                                       mi_row,
                                                       context_ptr->blk_geom->bsize) &&
-                              is_inside_tile_boundary(&(xd->tile),
+                              is_inside_tile_boundary(&context_ptr->mv_bound_tile,
                                                       to_inject_mv_x_l1,
                                                       to_inject_mv_y_l1,
                                                       mi_col,
@@ -1966,14 +1981,14 @@ void inject_mvp_candidates_ii(struct ModeDecisionContext *context_ptr, PictureCo
                                                            to_inject_mv_y_l1,
                                                            ref_pair) == EB_FALSE;
 
-                if (umv0tile) {
-                    inside_tile = is_inside_tile_boundary(&(xd->tile),
+                if (mv_bounded) {
+                    inside_tile = is_inside_tile_boundary(&context_ptr->mv_bound_tile,
                                                           to_inject_mv_x_l0,
                                                           to_inject_mv_y_l0,
                                                           mi_col,
                                                           mi_row,
                                                           context_ptr->blk_geom->bsize) &&
-                                  is_inside_tile_boundary(&(xd->tile),
+                                  is_inside_tile_boundary(&context_ptr->mv_bound_tile,
                                                           to_inject_mv_x_l1,
                                                           to_inject_mv_y_l1,
                                                           mi_col,
@@ -2063,7 +2078,7 @@ void inject_new_nearest_new_comb_candidates(const SequenceControlSet *  scs_ptr,
     IntMv                  nearestmv[2], nearmv[2], ref_mv[2];
     uint8_t                drli, max_drl_index;
     int                    inside_tile = 1;
-    int                    umv0tile    = (scs_ptr->static_config.unrestricted_motion_vector == 0);
+    int                    mv_bounded  = context_ptr->mv_bounded;
     uint32_t               mi_row      = context_ptr->blk_origin_y >> MI_SIZE_LOG2;
     uint32_t               mi_col      = context_ptr->blk_origin_x >> MI_SIZE_LOG2;
 
@@ -2125,14 +2140,14 @@ void inject_new_nearest_new_comb_candidates(const SequenceControlSet *  scs_ptr,
                                                            to_inject_mv_y_l1,
                                                            ref_pair) == EB_FALSE;
 
-                if (umv0tile) {
-                    inside_tile = is_inside_tile_boundary(&(xd->tile),
+                if (mv_bounded) {
+                    inside_tile = is_inside_tile_boundary(&context_ptr->mv_bound_tile,
                                                           to_inject_mv_x_l0,
                                                           to_inject_mv_y_l0,
                                                           mi_col,
                                                           mi_row,
                                                           context_ptr->blk_geom->bsize) &&
-                                  is_inside_tile_boundary(&(xd->tile),
+                                  is_inside_tile_boundary(&context_ptr->mv_bound_tile,
                                                           to_inject_mv_x_l1,
                                                           to_inject_mv_y_l1,
                                                           mi_col,
@@ -2238,14 +2253,14 @@ void inject_new_nearest_new_comb_candidates(const SequenceControlSet *  scs_ptr,
                                                            to_inject_mv_y_l1,
                                                            ref_pair) == EB_FALSE;
 
-                if (umv0tile) {
-                    inside_tile = is_inside_tile_boundary(&(xd->tile),
+                if (mv_bounded) {
+                    inside_tile = is_inside_tile_boundary(&context_ptr->mv_bound_tile,
                                                           to_inject_mv_x_l0,
                                                           to_inject_mv_y_l0,
                                                           mi_col,
                                                           mi_row,
                                                           context_ptr->blk_geom->bsize) &&
-                                  is_inside_tile_boundary(&(xd->tile),
+                                  is_inside_tile_boundary(&context_ptr->mv_bound_tile,
                                                           to_inject_mv_x_l1,
                                                           to_inject_mv_y_l1,
                                                           mi_col,
@@ -2549,15 +2564,13 @@ void inject_warped_motion_candidates(PictureControlSet *         pcs_ptr,
     IntMv                  nearestmv[2], nearmv[2], ref_mv[2];
 
     int                 inside_tile = 1;
-    SequenceControlSet *scs_ptr =
-        (SequenceControlSet *)pcs_ptr->parent_pcs_ptr->scs_wrapper_ptr->object_ptr;
-    int      umv0tile = (scs_ptr->static_config.unrestricted_motion_vector == 0);
-    uint32_t mi_row   = context_ptr->blk_origin_y >> MI_SIZE_LOG2;
-    uint32_t mi_col   = context_ptr->blk_origin_x >> MI_SIZE_LOG2;
+    int      mv_bounded = context_ptr->mv_bounded;
+    uint32_t mi_row     = context_ptr->blk_origin_y >> MI_SIZE_LOG2;
+    uint32_t mi_col     = context_ptr->blk_origin_x >> MI_SIZE_LOG2;
 
-    if (umv0tile)
+    if (mv_bounded)
         inside_tile =
-            is_inside_tile_boundary(&(xd->tile),
+            is_inside_tile_boundary(&context_ptr->mv_bound_tile,
                                     context_ptr->blk_ptr->ref_mvs[LAST_FRAME][0].as_mv.col,
                                     context_ptr->blk_ptr->ref_mvs[LAST_FRAME][0].as_mv.row,
                                     mi_col,
@@ -2607,7 +2620,9 @@ void inject_warped_motion_candidates(PictureControlSet *         pcs_ptr,
                                      &cand_array[cand_idx].wm_params_l0,
                                      &cand_array[cand_idx].num_proj_ref);
 
-        if (cand_array[cand_idx].local_warp_valid) INCRMENT_CAND_TOTAL_COUNT(cand_idx);
+        if (cand_array[cand_idx].local_warp_valid &&
+            warp_in_ref_rows(context_ptr, &cand_array[cand_idx].wm_params_l0))
+            INCRMENT_CAND_TOTAL_COUNT(cand_idx);
     }
 
     //NEAR_L0
@@ -2644,9 +2659,9 @@ void inject_warped_motion_candidates(PictureControlSet *         pcs_ptr,
         mv_0.y = cand_array[cand_idx].motion_vector_yl0;
         MvUnit mv_unit;
         mv_unit.mv[0] = mv_0;
-        if (umv0tile)
+        if (mv_bounded)
             inside_tile = is_inside_tile_boundary(
-                &(xd->tile), mv_0.x, mv_0.y, mi_col, mi_row, context_ptr->blk_geom->bsize);
+                &context_ptr->mv_bound_tile, mv_0.x, mv_0.y, mi_col, mi_row, context_ptr->blk_geom->bsize);
         if (inside_tile) {
             cand_array[cand_idx].local_warp_valid =
                 warped_motion_parameters(pcs_ptr,
@@ -2659,7 +2674,9 @@ void inject_warped_motion_candidates(PictureControlSet *         pcs_ptr,
                                          &cand_array[cand_idx].wm_params_l0,
                                          &cand_array[cand_idx].num_proj_ref);
 
-            if (cand_array[cand_idx].local_warp_valid) INCRMENT_CAND_TOTAL_COUNT(cand_idx);
+            if (cand_array[cand_idx].local_warp_valid &&
+                warp_in_ref_rows(context_ptr, &cand_array[cand_idx].wm_params_l0))
+                INCRMENT_CAND_TOTAL_COUNT(cand_idx);
         }
     }
 
@@ -2734,9 +2751,9 @@ void inject_warped_motion_candidates(PictureControlSet *         pcs_ptr,
                 mv_0.y = cand_array[cand_idx].motion_vector_yl0;
                 MvUnit mv_unit;
                 mv_unit.mv[0] = mv_0;
-                if (umv0tile)
+                if (mv_bounded)
                     inside_tile = is_inside_tile_boundary(
-                        &(xd->tile), mv_0.x, mv_0.y, mi_col, mi_row, context_ptr->blk_geom->bsize);
+                        &context_ptr->mv_bound_tile, mv_0.x, mv_0.y, mi_col, mi_row, context_ptr->blk_geom->bsize);
                 if (inside_tile) {
                     cand_array[cand_idx].local_warp_valid =
                         warped_motion_parameters(pcs_ptr,
@@ -2749,7 +2766,9 @@ void inject_warped_motion_candidates(PictureControlSet *         pcs_ptr,
                                                  &cand_array[cand_idx].wm_params_l0,
                                                  &cand_array[cand_idx].num_proj_ref);
 
-                    if (cand_array[cand_idx].local_warp_valid) INCRMENT_CAND_TOTAL_COUNT(cand_idx);
+                    if (cand_array[cand_idx].local_warp_valid &&
+                        warp_in_ref_rows(context_ptr, &cand_array[cand_idx].wm_params_l0))
+                        INCRMENT_CAND_TOTAL_COUNT(cand_idx);
                 }
             }
         }
@@ -2836,6 +2855,9 @@ static void single_motion_search(PictureControlSet *pcs, ModeDecisionContext *co
     x->mv_limits.col_min = -(((mi_col + mi_width) * MI_SIZE) + AOM_INTERP_EXTEND);
     x->mv_limits.row_max = (cm->mi_rows - mi_row) * MI_SIZE + AOM_INTERP_EXTEND;
     x->mv_limits.col_max = (cm->mi_cols - mi_col) * MI_SIZE + AOM_INTERP_EXTEND;
+    // stay within the reference rows the EncDec gate of the SB row waited for
+    x->mv_limits.row_max =
+        MIN(x->mv_limits.row_max, context_ptr->ref_rows_bound - (mi_row + mi_height) * MI_SIZE);
     //set search paramters
     x->sadperbit16 = sad_per_bit16lut_8[frm_hdr->quantization_params.base_q_idx];
     x->errorperbit = context_ptr->full_lambda >> RD_EPB_SHIFT;
@@ -2999,9 +3021,8 @@ void inject_new_candidates(const SequenceControlSet *  scs_ptr,
     const MeSbResults *me_results       = pcs_ptr->parent_pcs_ptr->me_results[me_sb_addr];
     uint8_t            total_me_cnt     = me_results->total_me_candidate_index[me_block_offset];
     const MeCandidate *me_block_results = me_results->me_candidate[me_block_offset];
-    MacroBlockD *      xd               = context_ptr->blk_ptr->av1xd;
     int                inside_tile      = 1;
-    int                umv0tile         = (scs_ptr->static_config.unrestricted_motion_vector == 0);
+    int                mv_bounded       = context_ptr->mv_bounded;
     uint32_t           mi_row           = context_ptr->blk_origin_y >> MI_SIZE_LOG2;
     uint32_t           mi_col           = context_ptr->blk_origin_x >> MI_SIZE_LOG2;
     BlockSize          bsize            = context_ptr->blk_geom->bsize; // bloc size
@@ -3036,8 +3057,8 @@ void inject_new_candidates(const SequenceControlSet *  scs_ptr,
                 check_ref_beackout(context_ptr, to_inject_ref_type, context_ptr->blk_geom->shape);
 
             inside_tile = 1;
-            if (umv0tile)
-                inside_tile = is_inside_tile_boundary(&(xd->tile),
+            if (mv_bounded)
+                inside_tile = is_inside_tile_boundary(&context_ptr->mv_bound_tile,
                                                       to_inject_mv_x,
                                                       to_inject_mv_y,
                                                       mi_col,
@@ -3175,8 +3196,8 @@ void inject_new_candidates(const SequenceControlSet *  scs_ptr,
                     context_ptr, to_inject_ref_type, context_ptr->blk_geom->shape);
 
                 inside_tile = 1;
-                if (umv0tile)
-                    inside_tile = is_inside_tile_boundary(&(xd->tile),
+                if (mv_bounded)
+                    inside_tile = is_inside_tile_boundary(&context_ptr->mv_bound_tile,
                                                           to_inject_mv_x,
                                                           to_inject_mv_y,
                                                           mi_col,
@@ -3328,14 +3349,14 @@ void inject_new_candidates(const SequenceControlSet *  scs_ptr,
                         context_ptr, to_inject_ref_type, context_ptr->blk_geom->shape);
 
                     inside_tile = 1;
-                    if (umv0tile) {
-                        inside_tile = is_inside_tile_boundary(&(xd->tile),
+                    if (mv_bounded) {
+                        inside_tile = is_inside_tile_boundary(&context_ptr->mv_bound_tile,
                                                               to_inject_mv_x_l0,
                                                               to_inject_mv_y_l0,
                                                               mi_col,
                                                               mi_row,
                                                               context_ptr->blk_geom->bsize) &&
-                                      is_inside_tile_boundary(&(xd->tile),
+                                      is_inside_tile_boundary(&context_ptr->mv_bound_tile,
                                                               to_inject_mv_x_l1,
                                                               to_inject_mv_y_l1,
                                                               mi_col,
@@ -3798,8 +3819,7 @@ void inject_inter_candidates(PictureControlSet *pcs_ptr, ModeDecisionContext *co
     uint8_t inj_mv = 1;
 #endif
     int          inside_tile = 1;
-    MacroBlockD *xd          = context_ptr->blk_ptr->av1xd;
-    int          umv0tile    = (scs_ptr->static_config.unrestricted_motion_vector == 0);
+    int          mv_bounded  = context_ptr->mv_bounded;
     MeSbResults *me_results  = pcs_ptr->parent_pcs_ptr->me_results[context_ptr->me_sb_addr];
     EbBool       allow_bipred =
         (context_ptr->blk_geom->bwidth == 4 || context_ptr->blk_geom->bheight == 4) ? EB_FALSE
@@ -3940,8 +3960,8 @@ void inject_inter_candidates(PictureControlSet *pcs_ptr, ModeDecisionContext *co
                     int16_t to_inject_mv_x_l0 = mv_l0.as_mv.col;
                     int16_t to_inject_mv_y_l0 = mv_l0.as_mv.row;
 
-                    if (umv0tile)
-                        inside_tile = is_inside_tile_boundary(&(xd->tile),
+                    if (mv_bounded)
+                        inside_tile = is_inside_tile_boundary(&context_ptr->mv_bound_tile,
                                                               to_inject_mv_x_l0,
                                                               to_inject_mv_y_l0,
                                                               mi_col,
@@ -3950,7 +3970,8 @@ void inject_inter_candidates(PictureControlSet *pcs_ptr, ModeDecisionContext *co
 
                     if (inside_tile &&
                         (((params_l0->wmtype > TRANSLATION && context_ptr->blk_geom->bwidth >= 8 &&
-                           context_ptr->blk_geom->bheight >= 8) ||
+                           context_ptr->blk_geom->bheight >= 8 &&
+                           warp_in_ref_rows(context_ptr, params_l0)) ||
                           params_l0->wmtype <= TRANSLATION))) {
                         MvReferenceFrame rf[2];
                         rf[0] = to_inject_ref_type;
@@ -4051,23 +4072,24 @@ void inject_inter_candidates(PictureControlSet *pcs_ptr, ModeDecisionContext *co
                             int16_t to_inject_mv_y_l1 = mv_l1.as_mv.row;
 
                             inside_tile = 1;
-                            if (umv0tile) {
+                            if (mv_bounded) {
                                 inside_tile =
-                                    is_inside_tile_boundary(&(xd->tile),
+                                    is_inside_tile_boundary(&context_ptr->mv_bound_tile,
                                                             to_inject_mv_x_l0,
-                                                            to_inject_mv_y_l1,
+                                                            to_inject_mv_y_l0,
                                                             mi_col,
                                                             mi_row,
                                                             context_ptr->blk_geom->bsize) &&
-                                    is_inside_tile_boundary(&(xd->tile),
-                                                            to_inject_mv_x_l0,
+                                    is_inside_tile_boundary(&context_ptr->mv_bound_tile,
+                                                            to_inject_mv_x_l1,
                                                             to_inject_mv_y_l1,
                                                             mi_col,
                                                             mi_row,
                                                             context_ptr->blk_geom->bsize);
                             }
 
-                            if (inside_tile) {
+                            if (inside_tile && warp_in_ref_rows(context_ptr, params_l0) &&
+                                warp_in_ref_rows(context_ptr, params_l1)) {
                                 MvReferenceFrame rf[2];
                                 rf[0] = svt_get_ref_frame_type(REF_LIST_0, list_ref_index_l0);
                                 rf[1] = svt_get_ref_frame_type(REF_LIST_1, list_ref_index_l1);
@@ -4155,8 +4177,8 @@ void inject_inter_candidates(PictureControlSet *pcs_ptr, ModeDecisionContext *co
                 context_ptr->injected_mv_count_l0 == 0 ||
                 mrp_is_already_injected_mv_l0(
                     context_ptr, to_inject_mv_x, to_inject_mv_y, to_inject_ref_type) == EB_FALSE;
-            if (umv0tile)
-                inside_tile = is_inside_tile_boundary(&(xd->tile),
+            if (mv_bounded)
+                inside_tile = is_inside_tile_boundary(&context_ptr->mv_bound_tile,
                                                       to_inject_mv_x,
                                                       to_inject_mv_y,
                                                       mi_col,
@@ -4256,15 +4278,15 @@ void inject_inter_candidates(PictureControlSet *pcs_ptr, ModeDecisionContext *co
                 rf[1] = svt_get_ref_frame_type(REF_LIST_1, 0 /*list1_ref_index*/);
                 uint8_t to_inject_ref_type = av1_ref_frame_type(rf);
                 inside_tile                = 1;
-                if (umv0tile) {
-                    inside_tile = is_inside_tile_boundary(&(xd->tile),
+                if (mv_bounded) {
+                    inside_tile = is_inside_tile_boundary(&context_ptr->mv_bound_tile,
                                                           to_inject_mv_x_l0,
-                                                          to_inject_mv_y_l1,
+                                                          to_inject_mv_y_l0,
                                                           mi_col,
                                                           mi_row,
                                                           context_ptr->blk_geom->bsize) &&
-                                  is_inside_tile_boundary(&(xd->tile),
-                                                          to_inject_mv_x_l0,
+                                  is_inside_tile_boundary(&context_ptr->mv_bound_tile,
+                                                          to_inject_mv_x_l1,
                                                           to_inject_mv_y_l1,
                                                           mi_col,
                                                           mi_row,
@@ -29,6 +29,7 @@
 #include "EbCommonUtils.h"
 #include "EbQMatrices.h"
 #include "EbLog.h"
+#include "EbPipelineStats.h"
 
 #define MAX_MESH_SPEED 5 // Max speed setting for mesh motion method
 static MeshPattern good_quality_mesh_patterns[MAX_MESH_SPEED + 1][MAX_MESH_STEP] = {
@@ -1643,336 +1644,355 @@ void av1_setup_motion_field(Av1Common *cm, PictureControlSet *pcs_ptr) {
     if (ref_stamp >= 0) motion_field_projection(cm, pcs_ptr, LAST2_FRAME, 2);
 }
 /******************************************************
- * Mode Decision Configuration Kernel
+ * Mode Decision Configuration Job
+ *   Processes one Rate Control result.
  ******************************************************/
-void *mode_decision_configuration_kernel(void *input_ptr) {
+void mode_decision_configuration_job(EbThreadContext *thread_context_ptr,
+                                     EbObjectWrapper *rate_control_results_wrapper_ptr) {
     // Context & SCS & PCS
-    EbThreadContext *                 thread_context_ptr = (EbThreadContext *)input_ptr;
     ModeDecisionConfigurationContext *context_ptr =
         (ModeDecisionConfigurationContext *)thread_context_ptr->priv;
     PictureControlSet * pcs_ptr;
     SequenceControlSet *scs_ptr;
     FrameHeader *       frm_hdr;
     // Input
-    EbObjectWrapper *   rate_control_results_wrapper_ptr;
     RateControlResults *rate_control_results_ptr;
 
     // Output
     EbObjectWrapper *enc_dec_tasks_wrapper_ptr;
     EncDecTasks *    enc_dec_tasks_ptr;
 
-    for (;;) {
-        // Get RateControl Results
-        eb_get_full_object(context_ptr->rate_control_input_fifo_ptr,
-                           &rate_control_results_wrapper_ptr);
-
-        rate_control_results_ptr =
-            (RateControlResults *)rate_control_results_wrapper_ptr->object_ptr;
-        pcs_ptr = (PictureControlSet *)rate_control_results_ptr->pcs_wrapper_ptr->object_ptr;
-        scs_ptr = (SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr;
-        if (pcs_ptr->parent_pcs_ptr->frm_hdr.use_ref_frame_mvs)
-            av1_setup_motion_field(pcs_ptr->parent_pcs_ptr->av1_cm, pcs_ptr);
-
-        frm_hdr = &pcs_ptr->parent_pcs_ptr->frm_hdr;
-
-        // Mode Decision Configuration Kernel Signal(s) derivation
-        signal_derivation_mode_decision_config_kernel_oq(scs_ptr, pcs_ptr, context_ptr);
-
-        context_ptr->qp = pcs_ptr->picture_qp;
+    rate_control_results_ptr =
+        (RateControlResults *)rate_control_results_wrapper_ptr->object_ptr;
+    pcs_ptr = (PictureControlSet *)rate_control_results_ptr->pcs_wrapper_ptr->object_ptr;
+    scs_ptr = (SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr;
+    if (pcs_ptr->parent_pcs_ptr->frm_hdr.use_ref_frame_mvs)
+        av1_setup_motion_field(pcs_ptr->parent_pcs_ptr->av1_cm, pcs_ptr);
+    eb_pipeline_stats_set_picture(pcs_ptr->picture_number);
+
+    frm_hdr = &pcs_ptr->parent_pcs_ptr->frm_hdr;
+
+    // Mode Decision Configuration Kernel Signal(s) derivation
+    signal_derivation_mode_decision_config_kernel_oq(scs_ptr, pcs_ptr, context_ptr);
+
+    context_ptr->qp = pcs_ptr->picture_qp;
+
+    pcs_ptr->parent_pcs_ptr->average_qp = 0;
+    pcs_ptr->intra_coded_area           = 0;
+    // Compute picture and slice level chroma QP offsets
+    set_slice_and_picture_chroma_qp_offsets( // HT done
+        pcs_ptr);
+
+    // Compute Tc, and Beta offsets for a given picture
+    // Set reference cdef strength
+    set_reference_cdef_strength(pcs_ptr);
+
+    // Set reference sg ep
+    set_reference_sg_ep(pcs_ptr);
+    set_global_motion_field(pcs_ptr);
+
+    eb_av1_qm_init(pcs_ptr->parent_pcs_ptr);
+
+    Quants *const   quants   = &pcs_ptr->parent_pcs_ptr->quants;
+    Dequants *const dequants = &pcs_ptr->parent_pcs_ptr->deq;
+
+    eb_av1_set_quantizer(pcs_ptr->parent_pcs_ptr, frm_hdr->quantization_params.base_q_idx);
+
+    eb_av1_build_quantizer((AomBitDepth)scs_ptr->static_config.encoder_bit_depth,
+                           frm_hdr->quantization_params.delta_q_dc[AOM_PLANE_Y],
+                           frm_hdr->quantization_params.delta_q_dc[AOM_PLANE_U],
+                           frm_hdr->quantization_params.delta_q_ac[AOM_PLANE_U],
+                           frm_hdr->quantization_params.delta_q_dc[AOM_PLANE_V],
+                           frm_hdr->quantization_params.delta_q_ac[AOM_PLANE_V],
+                           quants,
+                           dequants);
+
+    Quants *const   quants_md   = &pcs_ptr->parent_pcs_ptr->quants_md;
+    Dequants *const dequants_md = &pcs_ptr->parent_pcs_ptr->deq_md;
+    eb_av1_build_quantizer(pcs_ptr->hbd_mode_decision ? AOM_BITS_10 : AOM_BITS_8,
+                           frm_hdr->quantization_params.delta_q_dc[AOM_PLANE_Y],
+                           frm_hdr->quantization_params.delta_q_dc[AOM_PLANE_U],
+                           frm_hdr->quantization_params.delta_q_ac[AOM_PLANE_U],
+                           frm_hdr->quantization_params.delta_q_dc[AOM_PLANE_V],
+                           frm_hdr->quantization_params.delta_q_ac[AOM_PLANE_V],
+                           quants_md,
+                           dequants_md);
+
+    // Hsan: collapse spare code
+    MdRateEstimationContext *md_rate_estimation_array;
+    uint32_t                 entropy_coding_qp;
+
+    // QP
+    context_ptr->qp = pcs_ptr->picture_qp;
+
+    // QP Index
+    context_ptr->qp_index = (uint8_t)frm_hdr->quantization_params.base_q_idx;
+
+    // Lambda Assignement
+    uint32_t lambda_sse;
+    uint32_t lambdasad_;
+    (*av1_lambda_assignment_function_table[pcs_ptr->parent_pcs_ptr->pred_structure])(
+        &lambdasad_,
+        &lambda_sse,
+        &lambdasad_,
+        &lambda_sse,
+        (uint8_t)pcs_ptr->parent_pcs_ptr->enhanced_picture_ptr->bit_depth,
+        context_ptr->qp_index,
+        pcs_ptr->hbd_mode_decision);
+    context_ptr->lambda      = (uint64_t)lambdasad_;
+    md_rate_estimation_array = pcs_ptr->md_rate_estimation_array;
+    // Reset MD rate Estimation table to initial values by copying from md_rate_estimation_array
+    if (context_ptr->is_md_rate_estimation_ptr_owner) {
+        EB_FREE_ARRAY(context_ptr->md_rate_estimation_ptr);
+        context_ptr->is_md_rate_estimation_ptr_owner = EB_FALSE;
+    }
+    context_ptr->md_rate_estimation_ptr = md_rate_estimation_array;
 
-        pcs_ptr->parent_pcs_ptr->average_qp = 0;
-        pcs_ptr->intra_coded_area           = 0;
-        // Compute picture and slice level chroma QP offsets
-        set_slice_and_picture_chroma_qp_offsets( // HT done
+    entropy_coding_qp = frm_hdr->quantization_params.base_q_idx;
+    if (pcs_ptr->parent_pcs_ptr->frm_hdr.primary_ref_frame != PRIMARY_REF_NONE)
+        memcpy(pcs_ptr->coeff_est_entropy_coder_ptr->fc,
+               &pcs_ptr->ref_frame_context[pcs_ptr->parent_pcs_ptr->frm_hdr.primary_ref_frame],
+               sizeof(FRAME_CONTEXT));
+    else
+        reset_entropy_coder(scs_ptr->encode_context_ptr,
+                            pcs_ptr->coeff_est_entropy_coder_ptr,
+                            entropy_coding_qp,
+                            pcs_ptr->slice_type);
+
+    // Initial Rate Estimation of the syntax elements
+    av1_estimate_syntax_rate(md_rate_estimation_array,
+                             pcs_ptr->slice_type == I_SLICE ? EB_TRUE : EB_FALSE,
+                             pcs_ptr->coeff_est_entropy_coder_ptr->fc);
+    // Initial Rate Estimation of the Motion vectors
+    av1_estimate_mv_rate(
+        pcs_ptr, md_rate_estimation_array, pcs_ptr->coeff_est_entropy_coder_ptr->fc);
+    // Initial Rate Estimation of the quantized coefficients
+    av1_estimate_coefficients_rate(md_rate_estimation_array,
+                                   pcs_ptr->coeff_est_entropy_coder_ptr->fc);
+    if (pcs_ptr->parent_pcs_ptr->pic_depth_mode == PIC_SB_SWITCH_DEPTH_MODE) {
+        derive_sb_md_mode(scs_ptr, pcs_ptr, context_ptr);
+
+        for (int sb_index = 0; sb_index < pcs_ptr->sb_total_count; ++sb_index) {
+            if (pcs_ptr->parent_pcs_ptr->sb_depth_mode_array[sb_index] ==
+                SB_SQ_BLOCKS_DEPTH_MODE) {
+                sb_forward_sq_blocks_to_md(scs_ptr, pcs_ptr, sb_index);
+            } else if (pcs_ptr->parent_pcs_ptr->sb_depth_mode_array[sb_index] ==
+                       SB_SQ_NON4_BLOCKS_DEPTH_MODE) {
+                sb_forward_sq_non4_blocks_to_md(scs_ptr, pcs_ptr, sb_index);
+            } else {
+                perform_early_sb_partitionning_sb(context_ptr, scs_ptr, pcs_ptr, sb_index);
+            }
+        }
+    } else if (pcs_ptr->parent_pcs_ptr->pic_depth_mode == PIC_ALL_DEPTH_MODE ||
+               pcs_ptr->parent_pcs_ptr->pic_depth_mode == PIC_MULTI_PASS_PD_MODE_0 ||
+               pcs_ptr->parent_pcs_ptr->pic_depth_mode == PIC_MULTI_PASS_PD_MODE_1 ||
+               pcs_ptr->parent_pcs_ptr->pic_depth_mode == PIC_MULTI_PASS_PD_MODE_2 ||
+               pcs_ptr->parent_pcs_ptr->pic_depth_mode == PIC_MULTI_PASS_PD_MODE_3) {
+        forward_all_blocks_to_md(scs_ptr, pcs_ptr);
+    } else if (pcs_ptr->parent_pcs_ptr->pic_depth_mode == PIC_ALL_C_DEPTH_MODE) {
+        forward_all_c_blocks_to_md(scs_ptr, pcs_ptr);
+    } else if (pcs_ptr->parent_pcs_ptr->pic_depth_mode == PIC_SQ_DEPTH_MODE) {
+        forward_sq_blocks_to_md(scs_ptr, pcs_ptr);
+    } else if (pcs_ptr->parent_pcs_ptr->pic_depth_mode == PIC_SQ_NON4_DEPTH_MODE) {
+        forward_sq_non4_blocks_to_md(scs_ptr, pcs_ptr);
+    } else if (pcs_ptr->parent_pcs_ptr->pic_depth_mode >= PIC_OPEN_LOOP_DEPTH_MODE) {
+        // Predict the SB partitionning
+        perform_early_sb_partitionning( // HT done
+            context_ptr,
+            scs_ptr,
             pcs_ptr);
-
-        // Compute Tc, and Beta offsets for a given picture
-        // Set reference cdef strength
-        set_reference_cdef_strength(pcs_ptr);
-
-        // Set reference sg ep
-        set_reference_sg_ep(pcs_ptr);
-        set_global_motion_field(pcs_ptr);
-
-        eb_av1_qm_init(pcs_ptr->parent_pcs_ptr);
-
-        Quants *const   quants   = &pcs_ptr->parent_pcs_ptr->quants;
-        Dequants *const dequants = &pcs_ptr->parent_pcs_ptr->deq;
-
-        eb_av1_set_quantizer(pcs_ptr->parent_pcs_ptr, frm_hdr->quantization_params.base_q_idx);
-
-        eb_av1_build_quantizer((AomBitDepth)scs_ptr->static_config.encoder_bit_depth,
-                               frm_hdr->quantization_params.delta_q_dc[AOM_PLANE_Y],
-                               frm_hdr->quantization_params.delta_q_dc[AOM_PLANE_U],
-                               frm_hdr->quantization_params.delta_q_ac[AOM_PLANE_U],
-                               frm_hdr->quantization_params.delta_q_dc[AOM_PLANE_V],
-                               frm_hdr->quantization_params.delta_q_ac[AOM_PLANE_V],
-                               quants,
-                               dequants);
-
-        Quants *const   quants_md   = &pcs_ptr->parent_pcs_ptr->quants_md;
-        Dequants *const dequants_md = &pcs_ptr->parent_pcs_ptr->deq_md;
-        eb_av1_build_quantizer(pcs_ptr->hbd_mode_decision ? AOM_BITS_10 : AOM_BITS_8,
-                               frm_hdr->quantization_params.delta_q_dc[AOM_PLANE_Y],
-                               frm_hdr->quantization_params.delta_q_dc[AOM_PLANE_U],
-                               frm_hdr->quantization_params.delta_q_ac[AOM_PLANE_U],
-                               frm_hdr->quantization_params.delta_q_dc[AOM_PLANE_V],
-                               frm_hdr->quantization_params.delta_q_ac[AOM_PLANE_V],
-                               quants_md,
-                               dequants_md);
-
-        // Hsan: collapse spare code
-        MdRateEstimationContext *md_rate_estimation_array;
-        uint32_t                 entropy_coding_qp;
-
-        // QP
-        context_ptr->qp = pcs_ptr->picture_qp;
-
-        // QP Index
-        context_ptr->qp_index = (uint8_t)frm_hdr->quantization_params.base_q_idx;
-
-        // Lambda Assignement
-        uint32_t lambda_sse;
-        uint32_t lambdasad_;
-        (*av1_lambda_assignment_function_table[pcs_ptr->parent_pcs_ptr->pred_structure])(
-            &lambdasad_,
-            &lambda_sse,
-            &lambdasad_,
-            &lambda_sse,
-            (uint8_t)pcs_ptr->parent_pcs_ptr->enhanced_picture_ptr->bit_depth,
-            context_ptr->qp_index,
-            pcs_ptr->hbd_mode_decision);
-        context_ptr->lambda      = (uint64_t)lambdasad_;
-        md_rate_estimation_array = pcs_ptr->md_rate_estimation_array;
-        // Reset MD rate Estimation table to initial values by copying from md_rate_estimation_array
-        if (context_ptr->is_md_rate_estimation_ptr_owner) {
-            EB_FREE_ARRAY(context_ptr->md_rate_estimation_ptr);
-            context_ptr->is_md_rate_estimation_ptr_owner = EB_FALSE;
+    } else { // (pcs_ptr->parent_pcs_ptr->mdMode == PICT_BDP_DEPTH_MODE || pcs_ptr->parent_pcs_ptr->mdMode == PICT_LIGHT_BDP_DEPTH_MODE )
+        pcs_ptr->parent_pcs_ptr->average_qp = (uint8_t)pcs_ptr->parent_pcs_ptr->picture_qp;
+    }
+    if (frm_hdr->allow_intrabc) {
+        int            i;
+        int            speed          = 1;
+        SpeedFeatures *sf             = &pcs_ptr->sf;
+        sf->allow_exhaustive_searches = 1;
+
+        const int mesh_speed = AOMMIN(speed, MAX_MESH_SPEED);
+        //if (cpi->twopass.fr_content_type == FC_GRAPHICS_ANIMATION)
+        //    sf->exhaustive_searches_thresh = (1 << 24);
+        //else
+        sf->exhaustive_searches_thresh = (1 << 25);
+
+        sf->max_exaustive_pct = good_quality_max_mesh_pct[mesh_speed];
+        if (mesh_speed > 0)
+            sf->exhaustive_searches_thresh = sf->exhaustive_searches_thresh << 1;
+
+        for (i = 0; i < MAX_MESH_STEP; ++i) {
+            sf->mesh_patterns[i].range    = good_quality_mesh_patterns[mesh_speed][i].range;
+            sf->mesh_patterns[i].interval = good_quality_mesh_patterns[mesh_speed][i].interval;
         }
-        context_ptr->md_rate_estimation_ptr = md_rate_estimation_array;
 
-        entropy_coding_qp = frm_hdr->quantization_params.base_q_idx;
-        if (pcs_ptr->parent_pcs_ptr->frm_hdr.primary_ref_frame != PRIMARY_REF_NONE)
-            memcpy(pcs_ptr->coeff_est_entropy_coder_ptr->fc,
-                   &pcs_ptr->ref_frame_context[pcs_ptr->parent_pcs_ptr->frm_hdr.primary_ref_frame],
-                   sizeof(FRAME_CONTEXT));
-        else
-            reset_entropy_coder(scs_ptr->encode_context_ptr,
-                                pcs_ptr->coeff_est_entropy_coder_ptr,
-                                entropy_coding_qp,
-                                pcs_ptr->slice_type);
-
-        // Initial Rate Estimation of the syntax elements
-        av1_estimate_syntax_rate(md_rate_estimation_array,
-                                 pcs_ptr->slice_type == I_SLICE ? EB_TRUE : EB_FALSE,
-                                 pcs_ptr->coeff_est_entropy_coder_ptr->fc);
-        // Initial Rate Estimation of the Motion vectors
-        av1_estimate_mv_rate(
-            pcs_ptr, md_rate_estimation_array, pcs_ptr->coeff_est_entropy_coder_ptr->fc);
-        // Initial Rate Estimation of the quantized coefficients
-        av1_estimate_coefficients_rate(md_rate_estimation_array,
-                                       pcs_ptr->coeff_est_entropy_coder_ptr->fc);
-        if (pcs_ptr->parent_pcs_ptr->pic_depth_mode == PIC_SB_SWITCH_DEPTH_MODE) {
-            derive_sb_md_mode(scs_ptr, pcs_ptr, context_ptr);
-
-            for (int sb_index = 0; sb_index < pcs_ptr->sb_total_count; ++sb_index) {
-                if (pcs_ptr->parent_pcs_ptr->sb_depth_mode_array[sb_index] ==
-                    SB_SQ_BLOCKS_DEPTH_MODE) {
-                    sb_forward_sq_blocks_to_md(scs_ptr, pcs_ptr, sb_index);
-                } else if (pcs_ptr->parent_pcs_ptr->sb_depth_mode_array[sb_index] ==
-                           SB_SQ_NON4_BLOCKS_DEPTH_MODE) {
-                    sb_forward_sq_non4_blocks_to_md(scs_ptr, pcs_ptr, sb_index);
-                } else {
-                    perform_early_sb_partitionning_sb(context_ptr, scs_ptr, pcs_ptr, sb_index);
-                }
+        if (pcs_ptr->slice_type == I_SLICE) {
+            for (i = 0; i < MAX_MESH_STEP; ++i) {
+                sf->mesh_patterns[i].range    = intrabc_mesh_patterns[mesh_speed][i].range;
+                sf->mesh_patterns[i].interval = intrabc_mesh_patterns[mesh_speed][i].interval;
             }
-        } else if (pcs_ptr->parent_pcs_ptr->pic_depth_mode == PIC_ALL_DEPTH_MODE ||
-                   pcs_ptr->parent_pcs_ptr->pic_depth_mode == PIC_MULTI_PASS_PD_MODE_0 ||
-                   pcs_ptr->parent_pcs_ptr->pic_depth_mode == PIC_MULTI_PASS_PD_MODE_1 ||
-                   pcs_ptr->parent_pcs_ptr->pic_depth_mode == PIC_MULTI_PASS_PD_MODE_2 ||
-                   pcs_ptr->parent_pcs_ptr->pic_depth_mode == PIC_MULTI_PASS_PD_MODE_3) {
-            forward_all_blocks_to_md(scs_ptr, pcs_ptr);
-        } else if (pcs_ptr->parent_pcs_ptr->pic_depth_mode == PIC_ALL_C_DEPTH_MODE) {
-            forward_all_c_blocks_to_md(scs_ptr, pcs_ptr);
-        } else if (pcs_ptr->parent_pcs_ptr->pic_depth_mode == PIC_SQ_DEPTH_MODE) {
-            forward_sq_blocks_to_md(scs_ptr, pcs_ptr);
-        } else if (pcs_ptr->parent_pcs_ptr->pic_depth_mode == PIC_SQ_NON4_DEPTH_MODE) {
-            forward_sq_non4_blocks_to_md(scs_ptr, pcs_ptr);
-        } else if (pcs_ptr->parent_pcs_ptr->pic_depth_mode >= PIC_OPEN_LOOP_DEPTH_MODE) {
-            // Predict the SB partitionning
-            perform_early_sb_partitionning( // HT done
-                context_ptr,
-                scs_ptr,
-                pcs_ptr);
-        } else { // (pcs_ptr->parent_pcs_ptr->mdMode == PICT_BDP_DEPTH_MODE || pcs_ptr->parent_pcs_ptr->mdMode == PICT_LIGHT_BDP_DEPTH_MODE )
-            pcs_ptr->parent_pcs_ptr->average_qp = (uint8_t)pcs_ptr->parent_pcs_ptr->picture_qp;
+            sf->max_exaustive_pct = intrabc_max_mesh_pct[mesh_speed];
         }
-        if (frm_hdr->allow_intrabc) {
-            int            i;
-            int            speed          = 1;
-            SpeedFeatures *sf             = &pcs_ptr->sf;
-            sf->allow_exhaustive_searches = 1;
-
-            const int mesh_speed = AOMMIN(speed, MAX_MESH_SPEED);
-            //if (cpi->twopass.fr_content_type == FC_GRAPHICS_ANIMATION)
-            //    sf->exhaustive_searches_thresh = (1 << 24);
-            //else
-            sf->exhaustive_searches_thresh = (1 << 25);
-
-            sf->max_exaustive_pct = good_quality_max_mesh_pct[mesh_speed];
-            if (mesh_speed > 0)
-                sf->exhaustive_searches_thresh = sf->exhaustive_searches_thresh << 1;
 
-            for (i = 0; i < MAX_MESH_STEP; ++i) {
-                sf->mesh_patterns[i].range    = good_quality_mesh_patterns[mesh_speed][i].range;
-                sf->mesh_patterns[i].interval = good_quality_mesh_patterns[mesh_speed][i].interval;
+        {
+            // add to hash table
+            const int pic_width = pcs_ptr->parent_pcs_ptr->scs_ptr->seq_header.max_frame_width;
+            const int pic_height =
+                pcs_ptr->parent_pcs_ptr->scs_ptr->seq_header.max_frame_height;
+            uint32_t *block_hash_values[2][2];
+            int8_t *  is_block_same[2][3];
+            int       k, j;
+
+            for (k = 0; k < 2; k++) {
+                for (j = 0; j < 2; j++)
+                    block_hash_values[k][j] = malloc(sizeof(uint32_t) * pic_width * pic_height);
+                for (j = 0; j < 3; j++)
+                    is_block_same[k][j] = malloc(sizeof(int8_t) * pic_width * pic_height);
             }
 
-            if (pcs_ptr->slice_type == I_SLICE) {
-                for (i = 0; i < MAX_MESH_STEP; ++i) {
-                    sf->mesh_patterns[i].range    = intrabc_mesh_patterns[mesh_speed][i].range;
-                    sf->mesh_patterns[i].interval = intrabc_mesh_patterns[mesh_speed][i].interval;
-                }
-                sf->max_exaustive_pct = intrabc_max_mesh_pct[mesh_speed];
+            //pcs_ptr->hash_table.p_lookup_table = NULL;
+            //av1_hash_table_create(&pcs_ptr->hash_table);
+
+            Yv12BufferConfig cpi_source;
+            link_eb_to_aom_buffer_desc_8bit(pcs_ptr->parent_pcs_ptr->enhanced_picture_ptr,
+                                            &cpi_source);
+
+            av1_crc_calculator_init(&pcs_ptr->crc_calculator1, 24, 0x5D6DCB);
+            av1_crc_calculator_init(&pcs_ptr->crc_calculator2, 24, 0x864CFB);
+
+            av1_generate_block_2x2_hash_value(
+                &cpi_source, block_hash_values[0], is_block_same[0], pcs_ptr);
+            av1_generate_block_hash_value(&cpi_source,
+                                          4,
+                                          block_hash_values[0],
+                                          block_hash_values[1],
+                                          is_block_same[0],
+                                          is_block_same[1],
+                                          pcs_ptr);
+            av1_add_to_hash_map_by_row_with_precal_data(&pcs_ptr->hash_table,
+                                                        block_hash_values[1],
+                                                        is_block_same[1][2],
+                                                        pic_width,
+                                                        pic_height,
+                                                        4);
+            av1_generate_block_hash_value(&cpi_source,
+                                          8,
+                                          block_hash_values[1],
+                                          block_hash_values[0],
+                                          is_block_same[1],
+                                          is_block_same[0],
+                                          pcs_ptr);
+            av1_add_to_hash_map_by_row_with_precal_data(&pcs_ptr->hash_table,
+                                                        block_hash_values[0],
+                                                        is_block_same[0][2],
+                                                        pic_width,
+                                                        pic_height,
+                                                        8);
+            av1_generate_block_hash_value(&cpi_source,
+                                          16,
+                                          block_hash_values[0],
+                                          block_hash_values[1],
+                                          is_block_same[0],
+                                          is_block_same[1],
+                                          pcs_ptr);
+            av1_add_to_hash_map_by_row_with_precal_data(&pcs_ptr->hash_table,
+                                                        block_hash_values[1],
+                                                        is_block_same[1][2],
+                                                        pic_width,
+                                                        pic_height,
+                                                        16);
+            av1_generate_block_hash_value(&cpi_source,
+                                          32,
+                                          block_hash_values[1],
+                                          block_hash_values[0],
+                                          is_block_same[1],
+                                          is_block_same[0],
+                                          pcs_ptr);
+            av1_add_to_hash_map_by_row_with_precal_data(&pcs_ptr->hash_table,
+                                                        block_hash_values[0],
+                                                        is_block_same[0][2],
+                                                        pic_width,
+                                                        pic_height,
+                                                        32);
+            av1_generate_block_hash_value(&cpi_source,
+                                          64,
+                                          block_hash_values[0],
+                                          block_hash_values[1],
+                                          is_block_same[0],
+                                          is_block_same[1],
+                                          pcs_ptr);
+            av1_add_to_hash_map_by_row_with_precal_data(&pcs_ptr->hash_table,
+                                                        block_hash_values[1],
+                                                        is_block_same[1][2],
+                                                        pic_width,
+                                                        pic_height,
+                                                        64);
+
+            av1_generate_block_hash_value(&cpi_source,
+                                          128,
+                                          block_hash_values[1],
+                                          block_hash_values[0],
+                                          is_block_same[1],
+                                          is_block_same[0],
+                                          pcs_ptr);
+            av1_add_to_hash_map_by_row_with_precal_data(&pcs_ptr->hash_table,
+                                                        block_hash_values[0],
+                                                        is_block_same[0][2],
+                                                        pic_width,
+                                                        pic_height,
+                                                        128);
+
+            for (k = 0; k < 2; k++) {
+                for (j = 0; j < 2; j++) free(block_hash_values[k][j]);
+                for (j = 0; j < 3; j++) free(is_block_same[k][j]);
             }
-
-            {
-                // add to hash table
-                const int pic_width = pcs_ptr->parent_pcs_ptr->scs_ptr->seq_header.max_frame_width;
-                const int pic_height =
-                    pcs_ptr->parent_pcs_ptr->scs_ptr->seq_header.max_frame_height;
-                uint32_t *block_hash_values[2][2];
-                int8_t *  is_block_same[2][3];
-                int       k, j;
-
-                for (k = 0; k < 2; k++) {
-                    for (j = 0; j < 2; j++)
-                        block_hash_values[k][j] = malloc(sizeof(uint32_t) * pic_width * pic_height);
-                    for (j = 0; j < 3; j++)
-                        is_block_same[k][j] = malloc(sizeof(int8_t) * pic_width * pic_height);
-                }
-
-                //pcs_ptr->hash_table.p_lookup_table = NULL;
-                //av1_hash_table_create(&pcs_ptr->hash_table);
-
-                Yv12BufferConfig cpi_source;
-                link_eb_to_aom_buffer_desc_8bit(pcs_ptr->parent_pcs_ptr->enhanced_picture_ptr,
-                                                &cpi_source);
-
-                av1_crc_calculator_init(&pcs_ptr->crc_calculator1, 24, 0x5D6DCB);
-                av1_crc_calculator_init(&pcs_ptr->crc_calculator2, 24, 0x864CFB);
-
-                av1_generate_block_2x2_hash_value(
-                    &cpi_source, block_hash_values[0], is_block_same[0], pcs_ptr);
-                av1_generate_block_hash_value(&cpi_source,
-                                              4,
-                                              block_hash_values[0],
-                                              block_hash_values[1],
-                                              is_block_same[0],
-                                              is_block_same[1],
-                                              pcs_ptr);
-                av1_add_to_hash_map_by_row_with_precal_data(&pcs_ptr->hash_table,
-                                                            block_hash_values[1],
-                                                            is_block_same[1][2],
-                                                            pic_width,
-                                                            pic_height,
-                                                            4);
-                av1_generate_block_hash_value(&cpi_source,
-                                              8,
-                                              block_hash_values[1],
-                                              block_hash_values[0],
-                                              is_block_same[1],
-                                              is_block_same[0],
-                                              pcs_ptr);
-                av1_add_to_hash_map_by_row_with_precal_data(&pcs_ptr->hash_table,
-                                                            block_hash_values[0],
-                                                            is_block_same[0][2],
-                                                            pic_width,
-                                                            pic_height,
-                                                            8);
-                av1_generate_block_hash_value(&cpi_source,
-                                              16,
-                                              block_hash_values[0],
-                                              block_hash_values[1],
-                                              is_block_same[0],
-                                              is_block_same[1],
-                                              pcs_ptr);
-                av1_add_to_hash_map_by_row_with_precal_data(&pcs_ptr->hash_table,
-                                                            block_hash_values[1],
-                                                            is_block_same[1][2],
-                                                            pic_width,
-                                                            pic_height,
-                                                            16);
-                av1_generate_block_hash_value(&cpi_source,
-                                              32,
-                                              block_hash_values[1],
-                                              block_hash_values[0],
-                                              is_block_same[1],
-                                              is_block_same[0],
-                                              pcs_ptr);
-                av1_add_to_hash_map_by_row_with_precal_data(&pcs_ptr->hash_table,
-                                                            block_hash_values[0],
-                                                            is_block_same[0][2],
-                                                            pic_width,
-                                                            pic_height,
-                                                            32);
-                av1_generate_block_hash_value(&cpi_source,
-                                              64,
-                                              block_hash_values[0],
-                                              block_hash_values[1],
-                                              is_block_same[0],
-                                              is_block_same[1],
-                                              pcs_ptr);
-                av1_add_to_hash_map_by_row_with_precal_data(&pcs_ptr->hash_table,
-                                                            block_hash_values[1],
-                                                            is_block_same[1][2],
-                                                            pic_width,
-                                                            pic_height,
-                                                            64);
-
-                av1_generate_block_hash_value(&cpi_source,
-                                              128,
-                                              block_hash_values[1],
-                                              block_hash_values[0],
-                                              is_block_same[1],
-                                              is_block_same[0],
-                                              pcs_ptr);
-                av1_add_to_hash_map_by_row_with_precal_data(&pcs_ptr->hash_table,
-                                                            block_hash_values[0],
-                                                            is_block_same[0][2],
-                                                            pic_width,
-                                                            pic_height,
-                                                            128);
-
-                for (k = 0; k < 2; k++) {
-                    for (j = 0; j < 2; j++) free(block_hash_values[k][j]);
-                    for (j = 0; j < 3; j++) free(is_block_same[k][j]);
-                }
-            }
-
-            eb_av1_init3smotion_compensation(
-                &pcs_ptr->ss_cfg, pcs_ptr->parent_pcs_ptr->enhanced_picture_ptr->stride_y);
         }
 
-        // Derive MD parameters
-        set_md_settings( // HT Done
-            scs_ptr,
-            pcs_ptr);
+        eb_av1_init3smotion_compensation(
+            &pcs_ptr->ss_cfg, pcs_ptr->parent_pcs_ptr->enhanced_picture_ptr->stride_y);
+    }
+
+    // Derive MD parameters
+    set_md_settings( // HT Done
+        scs_ptr,
+        pcs_ptr);
 
-        // Post the results to the MD processes
+    // Post the results to the MD processes, one task per EncDec unit (tile) so that the units
+    // are coded in parallel
+    for (uint16_t unit_idx = 0; unit_idx < pcs_ptr->enc_dec_unit_count; unit_idx++) {
         eb_get_empty_object(context_ptr->mode_decision_configuration_output_fifo_ptr,
                             &enc_dec_tasks_wrapper_ptr);
 
         enc_dec_tasks_ptr                  = (EncDecTasks *)enc_dec_tasks_wrapper_ptr->object_ptr;
         enc_dec_tasks_ptr->pcs_wrapper_ptr = rate_control_results_ptr->pcs_wrapper_ptr;
         enc_dec_tasks_ptr->input_type      = ENCDEC_TASKS_MDC_INPUT;
+        enc_dec_tasks_ptr->tile_index      = unit_idx;
+        // Run on the NUMA node of the picture when possible
+        enc_dec_tasks_wrapper_ptr->numa_node =
+            rate_control_results_ptr->pcs_wrapper_ptr->numa_node;
 
         // Post the Full Results Object
         eb_post_full_object(enc_dec_tasks_wrapper_ptr);
-
-        // Release Rate Control Results
-        eb_release_object(rate_control_results_wrapper_ptr);
     }
 
+    // Release Rate Control Results
+    eb_release_object(rate_control_results_wrapper_ptr);
+}
+
+/******************************************************
+ * Mode Decision Configuration Kernel
+ ******************************************************/
+void *mode_decision_configuration_kernel(void *input_ptr) {
+    EbThreadContext *                 thread_context_ptr = (EbThreadContext *)input_ptr;
+    ModeDecisionConfigurationContext *context_ptr =
+        (ModeDecisionConfigurationContext *)thread_context_ptr->priv;
+    EbObjectWrapper *                 rate_control_results_wrapper_ptr;
+
+    for (;;) {
+        // Get RateControl Results
+        eb_get_full_object(context_ptr->rate_control_input_fifo_ptr,
+                           &rate_control_results_wrapper_ptr);
+
+        mode_decision_configuration_job(thread_context_ptr, rate_control_results_wrapper_ptr);
+    }
     return EB_NULL;
 }
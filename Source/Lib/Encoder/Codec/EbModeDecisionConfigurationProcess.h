@@ -81,6 +81,8 @@ EbErrorType mode_decision_configuration_context_ctor(EbThreadContext *  thread_c
                                                      const EbEncHandle *enc_handle_ptr,
                                                      int input_index, int output_index);
 
+extern void mode_decision_configuration_job(EbThreadContext *thread_context_ptr,
+                                            EbObjectWrapper *rate_control_results_wrapper_ptr);
 extern void *mode_decision_configuration_kernel(void *input_ptr);
 #ifdef __cplusplus
 }
@@ -244,41 +244,67 @@ EbErrorType mode_decision_context_ctor(ModeDecisionContext *context_ptr, EbColor
 
 /**************************************************
  * Reset Mode Decision Neighbor Arrays
+ *   The arrays of a tile start at its top left
+ *   corner, the chroma ones in chroma samples.
  *************************************************/
-void reset_mode_decision_neighbor_arrays(PictureControlSet *pcs_ptr) {
-    uint8_t depth;
+static void reset_tile_neighbor_array(NeighborArrayUnit *na_unit_ptr, uint32_t x, uint32_t y) {
+    neighbor_array_unit_reset(na_unit_ptr);
+    neighbor_array_unit_set_origin(na_unit_ptr, x, y);
+}
+
+void reset_mode_decision_neighbor_arrays(PictureControlSet *pcs_ptr, uint16_t tile_idx) {
+    const TilesInfo *tiles_info = &pcs_ptr->parent_pcs_ptr->av1_cm->tiles_info;
+    const uint32_t   x = tiles_info->tile_col_start_mi[tile_idx % tiles_info->tile_cols]
+                       << MI_SIZE_LOG2;
+    const uint32_t   y = tiles_info->tile_row_start_mi[tile_idx / tiles_info->tile_cols]
+                       << MI_SIZE_LOG2;
+    uint8_t          depth;
     for (depth = 0; depth < NEIGHBOR_ARRAY_TOTAL_COUNT; depth++) {
-        neighbor_array_unit_reset(pcs_ptr->md_intra_luma_mode_neighbor_array[depth]);
-        neighbor_array_unit_reset(pcs_ptr->md_intra_chroma_mode_neighbor_array[depth]);
-        neighbor_array_unit_reset(pcs_ptr->md_mv_neighbor_array[depth]);
-        neighbor_array_unit_reset(pcs_ptr->md_skip_flag_neighbor_array[depth]);
-        neighbor_array_unit_reset(pcs_ptr->md_mode_type_neighbor_array[depth]);
-        neighbor_array_unit_reset(pcs_ptr->md_leaf_depth_neighbor_array[depth]);
-        neighbor_array_unit_reset(pcs_ptr->mdleaf_partition_neighbor_array[depth]);
+        reset_tile_neighbor_array(
+            pcs_ptr->md_intra_luma_mode_neighbor_array[depth][tile_idx], x, y);
+        reset_tile_neighbor_array(
+            pcs_ptr->md_intra_chroma_mode_neighbor_array[depth][tile_idx], x >> 1, y >> 1);
+        reset_tile_neighbor_array(pcs_ptr->md_mv_neighbor_array[depth][tile_idx], x, y);
+        reset_tile_neighbor_array(pcs_ptr->md_skip_flag_neighbor_array[depth][tile_idx], x, y);
+        reset_tile_neighbor_array(pcs_ptr->md_mode_type_neighbor_array[depth][tile_idx], x, y);
+        reset_tile_neighbor_array(pcs_ptr->md_leaf_depth_neighbor_array[depth][tile_idx], x, y);
+        reset_tile_neighbor_array(pcs_ptr->mdleaf_partition_neighbor_array[depth][tile_idx], x, y);
         if (pcs_ptr->hbd_mode_decision != EB_10_BIT_MD) {
-            neighbor_array_unit_reset(pcs_ptr->md_luma_recon_neighbor_array[depth]);
-            neighbor_array_unit_reset(pcs_ptr->md_tx_depth_1_luma_recon_neighbor_array[depth]);
-            neighbor_array_unit_reset(pcs_ptr->md_cb_recon_neighbor_array[depth]);
-            neighbor_array_unit_reset(pcs_ptr->md_cr_recon_neighbor_array[depth]);
+            reset_tile_neighbor_array(pcs_ptr->md_luma_recon_neighbor_array[depth][tile_idx], x, y);
+            reset_tile_neighbor_array(
+                pcs_ptr->md_tx_depth_1_luma_recon_neighbor_array[depth][tile_idx], x, y);
+            reset_tile_neighbor_array(
+                pcs_ptr->md_cb_recon_neighbor_array[depth][tile_idx], x >> 1, y >> 1);
+            reset_tile_neighbor_array(
+                pcs_ptr->md_cr_recon_neighbor_array[depth][tile_idx], x >> 1, y >> 1);
         }
         if (pcs_ptr->hbd_mode_decision > EB_8_BIT_MD) {
-            neighbor_array_unit_reset(pcs_ptr->md_luma_recon_neighbor_array16bit[depth]);
-            neighbor_array_unit_reset(pcs_ptr->md_tx_depth_1_luma_recon_neighbor_array16bit[depth]);
-            neighbor_array_unit_reset(pcs_ptr->md_cb_recon_neighbor_array16bit[depth]);
-            neighbor_array_unit_reset(pcs_ptr->md_cr_recon_neighbor_array16bit[depth]);
+            reset_tile_neighbor_array(
+                pcs_ptr->md_luma_recon_neighbor_array16bit[depth][tile_idx], x, y);
+            reset_tile_neighbor_array(
+                pcs_ptr->md_tx_depth_1_luma_recon_neighbor_array16bit[depth][tile_idx], x, y);
+            reset_tile_neighbor_array(
+                pcs_ptr->md_cb_recon_neighbor_array16bit[depth][tile_idx], x >> 1, y >> 1);
+            reset_tile_neighbor_array(
+                pcs_ptr->md_cr_recon_neighbor_array16bit[depth][tile_idx], x >> 1, y >> 1);
         }
 
-        neighbor_array_unit_reset(pcs_ptr->md_skip_coeff_neighbor_array[depth]);
-        neighbor_array_unit_reset(pcs_ptr->md_luma_dc_sign_level_coeff_neighbor_array[depth]);
-        neighbor_array_unit_reset(
-            pcs_ptr->md_tx_depth_1_luma_dc_sign_level_coeff_neighbor_array[depth]);
-        neighbor_array_unit_reset(pcs_ptr->md_cb_dc_sign_level_coeff_neighbor_array[depth]);
-        neighbor_array_unit_reset(pcs_ptr->md_cr_dc_sign_level_coeff_neighbor_array[depth]);
-        neighbor_array_unit_reset(pcs_ptr->md_txfm_context_array[depth]);
-        neighbor_array_unit_reset(pcs_ptr->md_inter_pred_dir_neighbor_array[depth]);
-        neighbor_array_unit_reset(pcs_ptr->md_ref_frame_type_neighbor_array[depth]);
-
-        neighbor_array_unit_reset32(pcs_ptr->md_interpolation_type_neighbor_array[depth]);
+        reset_tile_neighbor_array(pcs_ptr->md_skip_coeff_neighbor_array[depth][tile_idx], x, y);
+        reset_tile_neighbor_array(
+            pcs_ptr->md_luma_dc_sign_level_coeff_neighbor_array[depth][tile_idx], x, y);
+        reset_tile_neighbor_array(
+            pcs_ptr->md_tx_depth_1_luma_dc_sign_level_coeff_neighbor_array[depth][tile_idx], x, y);
+        reset_tile_neighbor_array(
+            pcs_ptr->md_cb_dc_sign_level_coeff_neighbor_array[depth][tile_idx], x >> 1, y >> 1);
+        reset_tile_neighbor_array(
+            pcs_ptr->md_cr_dc_sign_level_coeff_neighbor_array[depth][tile_idx], x >> 1, y >> 1);
+        reset_tile_neighbor_array(pcs_ptr->md_txfm_context_array[depth][tile_idx], x, y);
+        reset_tile_neighbor_array(pcs_ptr->md_inter_pred_dir_neighbor_array[depth][tile_idx], x, y);
+        reset_tile_neighbor_array(pcs_ptr->md_ref_frame_type_neighbor_array[depth][tile_idx], x, y);
+
+        neighbor_array_unit_reset32(pcs_ptr->md_interpolation_type_neighbor_array[depth][tile_idx]);
+        neighbor_array_unit_set_origin32(
+            pcs_ptr->md_interpolation_type_neighbor_array[depth][tile_idx], x, y);
     }
 
     return;
@@ -390,7 +416,7 @@ const EbAv1LambdaAssignFunc av1_lambda_assignment_function_table[4] = {
 };
 
 void reset_mode_decision(SequenceControlSet *scs_ptr, ModeDecisionContext *context_ptr,
-                         PictureControlSet *pcs_ptr, uint32_t segment_index) {
+                         PictureControlSet *pcs_ptr) {
     FrameHeader *frm_hdr = &pcs_ptr->parent_pcs_ptr->frm_hdr;
     // QP
     uint16_t picture_qp   = pcs_ptr->parent_pcs_ptr->frm_hdr.quantization_params.base_q_idx;
@@ -420,12 +446,7 @@ void reset_mode_decision(SequenceControlSet *scs_ptr, ModeDecisionContext *conte
 
     // Reset CABAC Contexts
     context_ptr->coeff_est_entropy_coder_ptr = pcs_ptr->coeff_est_entropy_coder_ptr;
-
-    // Reset Neighbor Arrays at start of new Segment / Picture
-    if (segment_index == 0) {
-        reset_mode_decision_neighbor_arrays(pcs_ptr);
-        (void)scs_ptr;
-    }
+    (void)scs_ptr;
     return;
 }
 
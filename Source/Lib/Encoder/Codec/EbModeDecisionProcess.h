@@ -172,6 +172,7 @@ typedef struct ModeDecisionContext {
     uint8_t          sb_sz;
     uint32_t         sb_origin_x;
     uint32_t         sb_origin_y;
+    uint16_t         tile_idx; // tile of the SB, selects the neighbor arrays
     uint32_t         round_origin_x;
     uint32_t         round_origin_y;
     uint16_t         pu_origin_x;
@@ -347,6 +348,12 @@ typedef struct ModeDecisionContext {
     EbBool       md_skip_mvp_generation;
     int16_t      full_pel_ref_window_width_th;
     int16_t      full_pel_ref_window_height_th;
+    // Motion bound of the injected candidates, set per SB by EncDec: the tile when
+    // unrestricted_motion_vector is 0, and ref_rows_bound, the reference row the reads of the
+    // blocks stay above when the picture runs in the inter-frame wavefront (REF_ROWS_ALL when not)
+    EbBool       mv_bounded;
+    TileInfo     mv_bound_tile;
+    int32_t      ref_rows_bound;
 
     // Signal to control initial and final pass PD setting(s)
     PdPass pd_pass;
@@ -373,7 +380,7 @@ extern EbErrorType mode_decision_context_ctor(ModeDecisionContext *context_ptr,
                                               uint8_t enable_hbd_mode_decision,
                                               uint8_t cfg_palette);
 
-extern void reset_mode_decision_neighbor_arrays(PictureControlSet *pcs_ptr);
+extern void reset_mode_decision_neighbor_arrays(PictureControlSet *pcs_ptr, uint16_t tile_idx);
 
 extern void lambda_assign_low_delay(uint32_t *fast_lambda, uint32_t *full_lambda,
                                     uint32_t *fast_chroma_lambda, uint32_t *full_chroma_lambda,
@@ -399,7 +406,7 @@ static const uint8_t quantizer_to_qindex[] = {
     192, 196, 200, 204, 208, 212, 216, 220, 224, 228, 232, 236, 240, 244, 249, 255};
 
 extern void reset_mode_decision(SequenceControlSet *scs_ptr, ModeDecisionContext *context_ptr,
-                                PictureControlSet *pcs_ptr, uint32_t segment_index);
+                                PictureControlSet *pcs_ptr);
 
 extern void mode_decision_configure_sb(ModeDecisionContext *context_ptr, PictureControlSet *pcs_ptr,
                                        uint8_t sb_qp);
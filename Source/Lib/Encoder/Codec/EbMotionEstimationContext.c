@@ -39,6 +39,9 @@ static void me_context_dctor(EbPtr p) {
     EB_FREE_ARRAY(obj->p_eight_pos_sad16x16);
     EB_FREE_ALIGNED_ARRAY(obj->sixteenth_sb_buffer);
     EB_FREE_ALIGNED_ARRAY(obj->sb_buffer);
+    EB_FREE_ARRAY(obj->gm_corners);
+    EB_FREE_ARRAY(obj->gm_correspondences);
+    EB_FREE_ARRAY(obj->gm_inliers);
 }
 EbErrorType me_context_ctor(MeContext *object_ptr, uint16_t max_input_luma_width,
                             uint16_t max_input_luma_height, uint8_t nsq_present, uint8_t mrp_mode) {
@@ -141,6 +144,9 @@ EbErrorType me_context_ctor(MeContext *object_ptr, uint16_t max_input_luma_width
                     object_ptr->interpolated_stride * max_search_area_height);
     EB_MALLOC_ARRAY(object_ptr->p_eight_pos_sad16x16,
                     8 * 16); //16= 16 16x16 blocks in a SB.       8=8search points
+    EB_MALLOC_ARRAY(object_ptr->gm_corners, 2 * 2 * MAX_CORNERS);
+    EB_MALLOC_ARRAY(object_ptr->gm_correspondences, 4 * MAX_CORNERS);
+    EB_MALLOC_ARRAY(object_ptr->gm_inliers, RANSAC_NUM_MOTIONS * 2 * MAX_CORNERS);
 
     // Initialize Alt-Ref parameters
     object_ptr->me_alt_ref = EB_FALSE;
@@ -10,6 +10,7 @@
 #include "EbMdRateEstimation.h"
 #include "EbCodingUnit.h"
 #include "EbObject.h"
+#include "global_motion.h"
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -426,6 +427,12 @@ typedef struct MeContext {
     EbBool quarter_pel_mode;
 
     EbBool compute_global_motion;
+    // Global motion scratch: corners of the picture and of the reference when
+    // Picture Analysis did not detect them, corner correspondences and RANSAC
+    // inliers
+    int *gm_corners;
+    int *gm_correspondences;
+    int *gm_inliers;
 
     // ME
     uint16_t search_area_width;
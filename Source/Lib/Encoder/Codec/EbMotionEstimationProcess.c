@@ -20,6 +20,7 @@
 
 #include "EbTemporalFiltering.h"
 #include "EbGlobalMotionEstimation.h"
+#include "EbPipelineStats.h"
 
 /* --32x32-
 |00||01|
@@ -268,13 +269,7 @@ EbErrorType signal_derivation_me_kernel_oq(SequenceControlSet *       scs_ptr,
     else
         context_ptr->me_context_ptr->me_search_method = SUB_SAD_SEARCH;
 
-    if (scs_ptr->static_config.enable_global_motion == EB_TRUE) {
-        if (enc_mode <= ENC_M1)
-            context_ptr->me_context_ptr->compute_global_motion = EB_TRUE;
-        else
-            context_ptr->me_context_ptr->compute_global_motion = EB_FALSE;
-    } else
-        context_ptr->me_context_ptr->compute_global_motion = EB_FALSE;
+    context_ptr->me_context_ptr->compute_global_motion = global_motion_enabled(scs_ptr, pcs_ptr);
 
     return return_error;
 };
@@ -590,21 +585,21 @@ EbErrorType compute_decimated_zz_sad(MotionEstimationContext_t *context_ptr,
 }
 
 /************************************************
- * Motion Analysis Kernel
+ * Motion Analysis Job
+ *   Processes one Picture Decision result.
  * The Motion Analysis performs  Motion Estimation
  * This process has access to the current input picture as well as
  * the input pictures, which the current picture references according
  * to the prediction structure pattern.  The Motion Analysis process is multithreaded,
  * so pictures can be processed out of order as long as all inputs are available.
  ************************************************/
-void *motion_estimation_kernel(void *input_ptr) {
-    EbThreadContext *          thread_context_ptr = (EbThreadContext *)input_ptr;
+void motion_estimation_job(EbThreadContext *thread_context_ptr,
+                           EbObjectWrapper *in_results_wrapper_ptr) {
     MotionEstimationContext_t *context_ptr = (MotionEstimationContext_t *)thread_context_ptr->priv;
 
     PictureParentControlSet *pcs_ptr;
     SequenceControlSet *     scs_ptr;
 
-    EbObjectWrapper *       in_results_wrapper_ptr;
     PictureDecisionResults *in_results_ptr;
 
     EbObjectWrapper *        out_results_wrapper_ptr;
@@ -641,387 +636,399 @@ void *motion_estimation_kernel(void *input_ptr) {
 
     uint32_t intra_sad_interval_index;
 
-    for (;;) {
-        // Get Input Full Object
-        eb_get_full_object(context_ptr->picture_decision_results_input_fifo_ptr,
-                           &in_results_wrapper_ptr);
-
-        in_results_ptr = (PictureDecisionResults *)in_results_wrapper_ptr->object_ptr;
-        pcs_ptr        = (PictureParentControlSet *)in_results_ptr->pcs_wrapper_ptr->object_ptr;
-        scs_ptr        = (SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr;
-
-        pa_ref_obj_ = (EbPaReferenceObject *)pcs_ptr->pa_reference_picture_wrapper_ptr->object_ptr;
-        // Set 1/4 and 1/16 ME input buffer(s); filtered or decimated
-        quarter_picture_ptr =
-            (scs_ptr->down_sampling_method_me_search == ME_FILTERED_DOWNSAMPLED)
-                ? (EbPictureBufferDesc *)pa_ref_obj_->quarter_filtered_picture_ptr
-                : (EbPictureBufferDesc *)pa_ref_obj_->quarter_decimated_picture_ptr;
-
-        sixteenth_picture_ptr =
-            (scs_ptr->down_sampling_method_me_search == ME_FILTERED_DOWNSAMPLED)
-                ? (EbPictureBufferDesc *)pa_ref_obj_->sixteenth_filtered_picture_ptr
-                : (EbPictureBufferDesc *)pa_ref_obj_->sixteenth_decimated_picture_ptr;
-        input_padded_picture_ptr = (EbPictureBufferDesc *)pa_ref_obj_->input_padded_picture_ptr;
-
-        input_picture_ptr = pcs_ptr->enhanced_picture_ptr;
-
-        context_ptr->me_context_ptr->me_alt_ref =
-            in_results_ptr->task_type == 1 ? EB_TRUE : EB_FALSE;
-
-        // Lambda Assignement
-        if (scs_ptr->static_config.pred_structure == EB_PRED_RANDOM_ACCESS) {
-            if (pcs_ptr->temporal_layer_index == 0)
-                context_ptr->me_context_ptr->lambda =
-                    lambda_mode_decision_ra_sad[pcs_ptr->picture_qp];
-            else if (pcs_ptr->temporal_layer_index < 3)
-                context_ptr->me_context_ptr->lambda =
-                    lambda_mode_decision_ra_sad_qp_scaling_l1[pcs_ptr->picture_qp];
-            else
-                context_ptr->me_context_ptr->lambda =
-                    lambda_mode_decision_ra_sad_qp_scaling_l3[pcs_ptr->picture_qp];
-        } else {
-            if (pcs_ptr->temporal_layer_index == 0)
-                context_ptr->me_context_ptr->lambda =
-                    lambda_mode_decision_ld_sad[pcs_ptr->picture_qp];
-            else
-                context_ptr->me_context_ptr->lambda =
-                    lambda_mode_decision_ld_sad_qp_scaling[pcs_ptr->picture_qp];
-        }
-        if (in_results_ptr->task_type == 0) {
-            // ME Kernel Signal(s) derivation
-            signal_derivation_me_kernel_oq(scs_ptr, pcs_ptr, context_ptr);
+    in_results_ptr = (PictureDecisionResults *)in_results_wrapper_ptr->object_ptr;
+    pcs_ptr        = (PictureParentControlSet *)in_results_ptr->pcs_wrapper_ptr->object_ptr;
+    scs_ptr        = (SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr;
+    eb_pipeline_stats_set_picture(pcs_ptr->picture_number);
+
+    pa_ref_obj_ = (EbPaReferenceObject *)pcs_ptr->pa_reference_picture_wrapper_ptr->object_ptr;
+    // Set 1/4 and 1/16 ME input buffer(s); filtered or decimated
+    quarter_picture_ptr =
+        (scs_ptr->down_sampling_method_me_search == ME_FILTERED_DOWNSAMPLED)
+            ? (EbPictureBufferDesc *)pa_ref_obj_->quarter_filtered_picture_ptr
+            : (EbPictureBufferDesc *)pa_ref_obj_->quarter_decimated_picture_ptr;
+
+    sixteenth_picture_ptr =
+        (scs_ptr->down_sampling_method_me_search == ME_FILTERED_DOWNSAMPLED)
+            ? (EbPictureBufferDesc *)pa_ref_obj_->sixteenth_filtered_picture_ptr
+            : (EbPictureBufferDesc *)pa_ref_obj_->sixteenth_decimated_picture_ptr;
+    input_padded_picture_ptr = (EbPictureBufferDesc *)pa_ref_obj_->input_padded_picture_ptr;
+
+    input_picture_ptr = pcs_ptr->enhanced_picture_ptr;
+
+    context_ptr->me_context_ptr->me_alt_ref =
+        in_results_ptr->task_type == 1 ? EB_TRUE : EB_FALSE;
+
+    // Lambda Assignement
+    if (scs_ptr->static_config.pred_structure == EB_PRED_RANDOM_ACCESS) {
+        if (pcs_ptr->temporal_layer_index == 0)
+            context_ptr->me_context_ptr->lambda =
+                lambda_mode_decision_ra_sad[pcs_ptr->picture_qp];
+        else if (pcs_ptr->temporal_layer_index < 3)
+            context_ptr->me_context_ptr->lambda =
+                lambda_mode_decision_ra_sad_qp_scaling_l1[pcs_ptr->picture_qp];
+        else
+            context_ptr->me_context_ptr->lambda =
+                lambda_mode_decision_ra_sad_qp_scaling_l3[pcs_ptr->picture_qp];
+    } else {
+        if (pcs_ptr->temporal_layer_index == 0)
+            context_ptr->me_context_ptr->lambda =
+                lambda_mode_decision_ld_sad[pcs_ptr->picture_qp];
+        else
+            context_ptr->me_context_ptr->lambda =
+                lambda_mode_decision_ld_sad_qp_scaling[pcs_ptr->picture_qp];
+    }
+    if (in_results_ptr->task_type == 0) {
+        // ME Kernel Signal(s) derivation
+        signal_derivation_me_kernel_oq(scs_ptr, pcs_ptr, context_ptr);
 
 #if GLOBAL_WARPED_MOTION
-            // Global motion estimation
-            // Compute only for the first fragment.
-            // TODO: create an other kernel ?
+        // Global motion estimation
+        // The references are spread over the segments of the picture.
 #if GLOBAL_WARPED_MOTION
-            if (pcs_ptr->gm_level == GM_FULL || pcs_ptr->gm_level == GM_DOWN) {
+        if (pcs_ptr->gm_level == GM_FULL || pcs_ptr->gm_level == GM_DOWN) {
 #endif
-                if (context_ptr->me_context_ptr->compute_global_motion &&
-                    in_results_ptr->segment_index == 0)
-                    global_motion_estimation(
-                        pcs_ptr, context_ptr->me_context_ptr, input_picture_ptr);
+            if (context_ptr->me_context_ptr->compute_global_motion)
+                global_motion_estimation(pcs_ptr,
+                                         context_ptr->me_context_ptr,
+                                         input_picture_ptr,
+                                         in_results_ptr->segment_index);
 #if GLOBAL_WARPED_MOTION
-            }
+        }
 #endif
 #endif
 
-            // Segments
-            segment_index = in_results_ptr->segment_index;
-            pic_width_in_sb =
-                (scs_ptr->seq_header.max_frame_width + scs_ptr->sb_sz - 1) / scs_ptr->sb_sz;
-            picture_height_in_sb =
-                (scs_ptr->seq_header.max_frame_height + scs_ptr->sb_sz - 1) / scs_ptr->sb_sz;
-            SEGMENT_CONVERT_IDX_TO_XY(
-                segment_index, x_segment_index, y_segment_index, pcs_ptr->me_segments_column_count);
-            x_sb_start_index = SEGMENT_START_IDX(
-                x_segment_index, pic_width_in_sb, pcs_ptr->me_segments_column_count);
-            x_sb_end_index = SEGMENT_END_IDX(
-                x_segment_index, pic_width_in_sb, pcs_ptr->me_segments_column_count);
-            y_sb_start_index = SEGMENT_START_IDX(
-                y_segment_index, picture_height_in_sb, pcs_ptr->me_segments_row_count);
-            y_sb_end_index = SEGMENT_END_IDX(
-                y_segment_index, picture_height_in_sb, pcs_ptr->me_segments_row_count);
-            // *** MOTION ESTIMATION CODE ***
-            if (pcs_ptr->slice_type != I_SLICE) {
-                // SB Loop
-                for (y_sb_index = y_sb_start_index; y_sb_index < y_sb_end_index; ++y_sb_index) {
-                    for (x_sb_index = x_sb_start_index; x_sb_index < x_sb_end_index; ++x_sb_index) {
-                        sb_index    = (uint16_t)(x_sb_index + y_sb_index * pic_width_in_sb);
-                        sb_origin_x = x_sb_index * scs_ptr->sb_sz;
-                        sb_origin_y = y_sb_index * scs_ptr->sb_sz;
-
-                        sb_width =
-                            (scs_ptr->seq_header.max_frame_width - sb_origin_x) < BLOCK_SIZE_64
-                                ? scs_ptr->seq_header.max_frame_width - sb_origin_x
-                                : BLOCK_SIZE_64;
-                        sb_height =
-                            (scs_ptr->seq_header.max_frame_height - sb_origin_y) < BLOCK_SIZE_64
-                                ? scs_ptr->seq_header.max_frame_height - sb_origin_y
-                                : BLOCK_SIZE_64;
+        // Segments
+        segment_index = in_results_ptr->segment_index;
+        pic_width_in_sb =
+            (scs_ptr->seq_header.max_frame_width + scs_ptr->sb_sz - 1) / scs_ptr->sb_sz;
+        picture_height_in_sb =
+            (scs_ptr->seq_header.max_frame_height + scs_ptr->sb_sz - 1) / scs_ptr->sb_sz;
+        SEGMENT_CONVERT_IDX_TO_XY(
+            segment_index, x_segment_index, y_segment_index, pcs_ptr->me_segments_column_count);
+        x_sb_start_index = SEGMENT_START_IDX(
+            x_segment_index, pic_width_in_sb, pcs_ptr->me_segments_column_count);
+        x_sb_end_index = SEGMENT_END_IDX(
+            x_segment_index, pic_width_in_sb, pcs_ptr->me_segments_column_count);
+        y_sb_start_index = SEGMENT_START_IDX(
+            y_segment_index, picture_height_in_sb, pcs_ptr->me_segments_row_count);
+        y_sb_end_index = SEGMENT_END_IDX(
+            y_segment_index, picture_height_in_sb, pcs_ptr->me_segments_row_count);
+        // *** MOTION ESTIMATION CODE ***
+        if (pcs_ptr->slice_type != I_SLICE) {
+            // SB Loop
+            for (y_sb_index = y_sb_start_index; y_sb_index < y_sb_end_index; ++y_sb_index) {
+                for (x_sb_index = x_sb_start_index; x_sb_index < x_sb_end_index; ++x_sb_index) {
+                    sb_index    = (uint16_t)(x_sb_index + y_sb_index * pic_width_in_sb);
+                    sb_origin_x = x_sb_index * scs_ptr->sb_sz;
+                    sb_origin_y = y_sb_index * scs_ptr->sb_sz;
+
+                    sb_width =
+                        (scs_ptr->seq_header.max_frame_width - sb_origin_x) < BLOCK_SIZE_64
+                            ? scs_ptr->seq_header.max_frame_width - sb_origin_x
+                            : BLOCK_SIZE_64;
+                    sb_height =
+                        (scs_ptr->seq_header.max_frame_height - sb_origin_y) < BLOCK_SIZE_64
+                            ? scs_ptr->seq_header.max_frame_height - sb_origin_y
+                            : BLOCK_SIZE_64;
+
+                    // Load the SB from the input to the intermediate SB buffer
+                    buffer_index = (input_picture_ptr->origin_y + sb_origin_y) *
+                                       input_picture_ptr->stride_y +
+                                   input_picture_ptr->origin_x + sb_origin_x;
+
+                    context_ptr->me_context_ptr->hme_search_type = HME_RECTANGULAR;
+
+                    for (sb_row = 0; sb_row < BLOCK_SIZE_64; sb_row++) {
+                        EB_MEMCPY(
+                            (&(context_ptr->me_context_ptr->sb_buffer[sb_row * BLOCK_SIZE_64])),
+                            (&(input_picture_ptr
+                                   ->buffer_y[buffer_index +
+                                              sb_row * input_picture_ptr->stride_y])),
+                            BLOCK_SIZE_64 * sizeof(uint8_t));
+                    }
 
-                        // Load the SB from the input to the intermediate SB buffer
-                        buffer_index = (input_picture_ptr->origin_y + sb_origin_y) *
-                                           input_picture_ptr->stride_y +
-                                       input_picture_ptr->origin_x + sb_origin_x;
+                    {
+                        uint8_t *src_ptr = &input_padded_picture_ptr->buffer_y[buffer_index];
 
-                        context_ptr->me_context_ptr->hme_search_type = HME_RECTANGULAR;
+                        //_MM_HINT_T0     //_MM_HINT_T1    //_MM_HINT_T2//_MM_HINT_NTA
+                        uint32_t i;
+                        for (i = 0; i < sb_height; i++) {
+                            char const *p =
+                                (char const *)(src_ptr +
+                                               i * input_padded_picture_ptr->stride_y);
+                            _mm_prefetch(p, _MM_HINT_T2);
+                        }
+                    }
 
-                        for (sb_row = 0; sb_row < BLOCK_SIZE_64; sb_row++) {
+                    context_ptr->me_context_ptr->sb_src_ptr =
+                        &input_padded_picture_ptr->buffer_y[buffer_index];
+                    context_ptr->me_context_ptr->sb_src_stride =
+                        input_padded_picture_ptr->stride_y;
+                    // Load the 1/4 decimated SB from the 1/4 decimated input to the 1/4 intermediate SB buffer
+                    if (context_ptr->me_context_ptr->enable_hme_level1_flag) {
+                        buffer_index = (quarter_picture_ptr->origin_y + (sb_origin_y >> 1)) *
+                                           quarter_picture_ptr->stride_y +
+                                       quarter_picture_ptr->origin_x + (sb_origin_x >> 1);
+
+                        for (sb_row = 0; sb_row < (sb_height >> 1); sb_row++) {
                             EB_MEMCPY(
-                                (&(context_ptr->me_context_ptr->sb_buffer[sb_row * BLOCK_SIZE_64])),
-                                (&(input_picture_ptr
+                                (&(context_ptr->me_context_ptr
+                                       ->quarter_sb_buffer[sb_row *
+                                                           context_ptr->me_context_ptr
+                                                               ->quarter_sb_buffer_stride])),
+                                (&(quarter_picture_ptr
                                        ->buffer_y[buffer_index +
-                                                  sb_row * input_picture_ptr->stride_y])),
-                                BLOCK_SIZE_64 * sizeof(uint8_t));
-                        }
-
-                        {
-                            uint8_t *src_ptr = &input_padded_picture_ptr->buffer_y[buffer_index];
-
-                            //_MM_HINT_T0     //_MM_HINT_T1    //_MM_HINT_T2//_MM_HINT_NTA
-                            uint32_t i;
-                            for (i = 0; i < sb_height; i++) {
-                                char const *p =
-                                    (char const *)(src_ptr +
-                                                   i * input_padded_picture_ptr->stride_y);
-                                _mm_prefetch(p, _MM_HINT_T2);
-                            }
+                                                  sb_row * quarter_picture_ptr->stride_y])),
+                                (sb_width >> 1) * sizeof(uint8_t));
                         }
+                    }
 
-                        context_ptr->me_context_ptr->sb_src_ptr =
-                            &input_padded_picture_ptr->buffer_y[buffer_index];
-                        context_ptr->me_context_ptr->sb_src_stride =
-                            input_padded_picture_ptr->stride_y;
-                        // Load the 1/4 decimated SB from the 1/4 decimated input to the 1/4 intermediate SB buffer
-                        if (context_ptr->me_context_ptr->enable_hme_level1_flag) {
-                            buffer_index = (quarter_picture_ptr->origin_y + (sb_origin_y >> 1)) *
-                                               quarter_picture_ptr->stride_y +
-                                           quarter_picture_ptr->origin_x + (sb_origin_x >> 1);
-
-                            for (sb_row = 0; sb_row < (sb_height >> 1); sb_row++) {
-                                EB_MEMCPY(
-                                    (&(context_ptr->me_context_ptr
-                                           ->quarter_sb_buffer[sb_row *
-                                                               context_ptr->me_context_ptr
-                                                                   ->quarter_sb_buffer_stride])),
-                                    (&(quarter_picture_ptr
-                                           ->buffer_y[buffer_index +
-                                                      sb_row * quarter_picture_ptr->stride_y])),
-                                    (sb_width >> 1) * sizeof(uint8_t));
-                            }
-                        }
+                    // Load the 1/16 decimated SB from the 1/16 decimated input to the 1/16 intermediate SB buffer
+                    if (context_ptr->me_context_ptr->enable_hme_level0_flag) {
+                        buffer_index = (sixteenth_picture_ptr->origin_y + (sb_origin_y >> 2)) *
+                                           sixteenth_picture_ptr->stride_y +
+                                       sixteenth_picture_ptr->origin_x + (sb_origin_x >> 2);
 
-                        // Load the 1/16 decimated SB from the 1/16 decimated input to the 1/16 intermediate SB buffer
-                        if (context_ptr->me_context_ptr->enable_hme_level0_flag) {
-                            buffer_index = (sixteenth_picture_ptr->origin_y + (sb_origin_y >> 2)) *
-                                               sixteenth_picture_ptr->stride_y +
-                                           sixteenth_picture_ptr->origin_x + (sb_origin_x >> 2);
-
-                            {
-                                uint8_t *frame_ptr = &sixteenth_picture_ptr->buffer_y[buffer_index];
-                                uint8_t *local_ptr =
-                                    context_ptr->me_context_ptr->sixteenth_sb_buffer;
-                                if (context_ptr->me_context_ptr->hme_search_method ==
-                                    FULL_SAD_SEARCH) {
-                                    for (sb_row = 0; sb_row < (sb_height >> 2); sb_row += 1) {
-                                        EB_MEMCPY(local_ptr,
-                                                  frame_ptr,
-                                                  (sb_width >> 2) * sizeof(uint8_t));
-                                        local_ptr += 16;
-                                        frame_ptr += sixteenth_picture_ptr->stride_y;
-                                    }
-                                } else {
-                                    for (sb_row = 0; sb_row < (sb_height >> 2); sb_row += 2) {
-                                        EB_MEMCPY(local_ptr,
-                                                  frame_ptr,
-                                                  (sb_width >> 2) * sizeof(uint8_t));
-                                        local_ptr += 16;
-                                        frame_ptr += sixteenth_picture_ptr->stride_y << 1;
-                                    }
+                        {
+                            uint8_t *frame_ptr = &sixteenth_picture_ptr->buffer_y[buffer_index];
+                            uint8_t *local_ptr =
+                                context_ptr->me_context_ptr->sixteenth_sb_buffer;
+                            if (context_ptr->me_context_ptr->hme_search_method ==
+                                FULL_SAD_SEARCH) {
+                                for (sb_row = 0; sb_row < (sb_height >> 2); sb_row += 1) {
+                                    EB_MEMCPY(local_ptr,
+                                              frame_ptr,
+                                              (sb_width >> 2) * sizeof(uint8_t));
+                                    local_ptr += 16;
+                                    frame_ptr += sixteenth_picture_ptr->stride_y;
+                                }
+                            } else {
+                                for (sb_row = 0; sb_row < (sb_height >> 2); sb_row += 2) {
+                                    EB_MEMCPY(local_ptr,
+                                              frame_ptr,
+                                              (sb_width >> 2) * sizeof(uint8_t));
+                                    local_ptr += 16;
+                                    frame_ptr += sixteenth_picture_ptr->stride_y << 1;
                                 }
                             }
                         }
-                        context_ptr->me_context_ptr->me_alt_ref = EB_FALSE;
-
-                        motion_estimate_sb(pcs_ptr,
-                                           sb_index,
-                                           sb_origin_x,
-                                           sb_origin_y,
-                                           context_ptr->me_context_ptr,
-                                           input_picture_ptr);
                     }
+                    context_ptr->me_context_ptr->me_alt_ref = EB_FALSE;
+
+                    motion_estimate_sb(pcs_ptr,
+                                       sb_index,
+                                       sb_origin_x,
+                                       sb_origin_y,
+                                       context_ptr->me_context_ptr,
+                                       input_picture_ptr);
+                }
+            }
+        }
+        if (pcs_ptr->intra_pred_mode > 4)
+        // *** OPEN LOOP INTRA CANDIDATE SEARCH CODE ***
+        {
+            // SB Loop
+            for (y_sb_index = y_sb_start_index; y_sb_index < y_sb_end_index; ++y_sb_index) {
+                for (x_sb_index = x_sb_start_index; x_sb_index < x_sb_end_index; ++x_sb_index) {
+                    sb_origin_x = x_sb_index * scs_ptr->sb_sz;
+                    sb_origin_y = y_sb_index * scs_ptr->sb_sz;
+
+                    sb_index = (uint16_t)(x_sb_index + y_sb_index * pic_width_in_sb);
+
+                    open_loop_intra_search_sb(
+                        pcs_ptr, sb_index, context_ptr, input_picture_ptr);
                 }
             }
-            if (pcs_ptr->intra_pred_mode > 4)
-            // *** OPEN LOOP INTRA CANDIDATE SEARCH CODE ***
+        }
+
+        // ZZ SADs Computation
+        // 1 lookahead frame is needed to get valid (0,0) SAD
+        if (scs_ptr->static_config.look_ahead_distance != 0) {
+            // when DG is ON, the ZZ SADs are computed @ the PD process
             {
-                // SB Loop
+                // ZZ SADs Computation using decimated picture
+                if (pcs_ptr->picture_number > 0) {
+                    compute_decimated_zz_sad(
+                        context_ptr,
+                        scs_ptr,
+                        pcs_ptr,
+                        (EbPictureBufferDesc *)pa_ref_obj_
+                            ->sixteenth_decimated_picture_ptr, // Hsan: always use decimated for ZZ SAD derivation until studying the trade offs and regenerating the activity threshold
+                        x_sb_start_index,
+                        x_sb_end_index,
+                        y_sb_start_index,
+                        y_sb_end_index);
+                }
+            }
+        }
+
+        // Calculate the ME Distortion and OIS Historgrams
+
+        eb_block_on_mutex(pcs_ptr->rc_distortion_histogram_mutex);
+
+        if (scs_ptr->static_config.rate_control_mode) {
+            if (pcs_ptr->slice_type != I_SLICE) {
+                uint16_t sad_interval_index;
                 for (y_sb_index = y_sb_start_index; y_sb_index < y_sb_end_index; ++y_sb_index) {
-                    for (x_sb_index = x_sb_start_index; x_sb_index < x_sb_end_index; ++x_sb_index) {
+                    for (x_sb_index = x_sb_start_index; x_sb_index < x_sb_end_index;
+                         ++x_sb_index) {
                         sb_origin_x = x_sb_index * scs_ptr->sb_sz;
                         sb_origin_y = y_sb_index * scs_ptr->sb_sz;
+                        sb_width =
+                            (scs_ptr->seq_header.max_frame_width - sb_origin_x) < BLOCK_SIZE_64
+                                ? scs_ptr->seq_header.max_frame_width - sb_origin_x
+                                : BLOCK_SIZE_64;
+                        sb_height =
+                            (scs_ptr->seq_header.max_frame_height - sb_origin_y) < BLOCK_SIZE_64
+                                ? scs_ptr->seq_header.max_frame_height - sb_origin_y
+                                : BLOCK_SIZE_64;
 
                         sb_index = (uint16_t)(x_sb_index + y_sb_index * pic_width_in_sb);
+                        pcs_ptr->inter_sad_interval_index[sb_index] = 0;
+                        pcs_ptr->intra_sad_interval_index[sb_index] = 0;
 
-                        open_loop_intra_search_sb(
-                            pcs_ptr, sb_index, context_ptr, input_picture_ptr);
-                    }
-                }
-            }
+                        if (sb_width == BLOCK_SIZE_64 && sb_height == BLOCK_SIZE_64) {
+                            sad_interval_index = (uint16_t)(
+                                pcs_ptr->rc_me_distortion[sb_index] >>
+                                (12 - SAD_PRECISION_INTERVAL)); //change 12 to 2*log2(64)
 
-            // ZZ SADs Computation
-            // 1 lookahead frame is needed to get valid (0,0) SAD
-            if (scs_ptr->static_config.look_ahead_distance != 0) {
-                // when DG is ON, the ZZ SADs are computed @ the PD process
-                {
-                    // ZZ SADs Computation using decimated picture
-                    if (pcs_ptr->picture_number > 0) {
-                        compute_decimated_zz_sad(
-                            context_ptr,
-                            scs_ptr,
-                            pcs_ptr,
-                            (EbPictureBufferDesc *)pa_ref_obj_
-                                ->sixteenth_decimated_picture_ptr, // Hsan: always use decimated for ZZ SAD derivation until studying the trade offs and regenerating the activity threshold
-                            x_sb_start_index,
-                            x_sb_end_index,
-                            y_sb_start_index,
-                            y_sb_end_index);
-                    }
-                }
-            }
+                            // SVT_LOG("%d\n", sad_interval_index);
 
-            // Calculate the ME Distortion and OIS Historgrams
-
-            eb_block_on_mutex(pcs_ptr->rc_distortion_histogram_mutex);
-
-            if (scs_ptr->static_config.rate_control_mode) {
-                if (pcs_ptr->slice_type != I_SLICE) {
-                    uint16_t sad_interval_index;
-                    for (y_sb_index = y_sb_start_index; y_sb_index < y_sb_end_index; ++y_sb_index) {
-                        for (x_sb_index = x_sb_start_index; x_sb_index < x_sb_end_index;
-                             ++x_sb_index) {
-                            sb_origin_x = x_sb_index * scs_ptr->sb_sz;
-                            sb_origin_y = y_sb_index * scs_ptr->sb_sz;
-                            sb_width =
-                                (scs_ptr->seq_header.max_frame_width - sb_origin_x) < BLOCK_SIZE_64
-                                    ? scs_ptr->seq_header.max_frame_width - sb_origin_x
-                                    : BLOCK_SIZE_64;
-                            sb_height =
-                                (scs_ptr->seq_header.max_frame_height - sb_origin_y) < BLOCK_SIZE_64
-                                    ? scs_ptr->seq_header.max_frame_height - sb_origin_y
-                                    : BLOCK_SIZE_64;
-
-                            sb_index = (uint16_t)(x_sb_index + y_sb_index * pic_width_in_sb);
-                            pcs_ptr->inter_sad_interval_index[sb_index] = 0;
-                            pcs_ptr->intra_sad_interval_index[sb_index] = 0;
-
-                            if (sb_width == BLOCK_SIZE_64 && sb_height == BLOCK_SIZE_64) {
-                                sad_interval_index = (uint16_t)(
-                                    pcs_ptr->rc_me_distortion[sb_index] >>
-                                    (12 - SAD_PRECISION_INTERVAL)); //change 12 to 2*log2(64)
-
-                                // SVT_LOG("%d\n", sad_interval_index);
-
-                                sad_interval_index = (uint16_t)(sad_interval_index >> 2);
-                                if (sad_interval_index > (NUMBER_OF_SAD_INTERVALS >> 1) - 1) {
-                                    uint16_t sad_interval_index_temp =
-                                        sad_interval_index - ((NUMBER_OF_SAD_INTERVALS >> 1) - 1);
-
-                                    sad_interval_index = ((NUMBER_OF_SAD_INTERVALS >> 1) - 1) +
-                                                         (sad_interval_index_temp >> 3);
-                                }
-                                if (sad_interval_index >= NUMBER_OF_SAD_INTERVALS - 1)
-                                    sad_interval_index = NUMBER_OF_SAD_INTERVALS - 1;
+                            sad_interval_index = (uint16_t)(sad_interval_index >> 2);
+                            if (sad_interval_index > (NUMBER_OF_SAD_INTERVALS >> 1) - 1) {
+                                uint16_t sad_interval_index_temp =
+                                    sad_interval_index - ((NUMBER_OF_SAD_INTERVALS >> 1) - 1);
 
-                                pcs_ptr->inter_sad_interval_index[sb_index] = sad_interval_index;
+                                sad_interval_index = ((NUMBER_OF_SAD_INTERVALS >> 1) - 1) +
+                                                     (sad_interval_index_temp >> 3);
+                            }
+                            if (sad_interval_index >= NUMBER_OF_SAD_INTERVALS - 1)
+                                sad_interval_index = NUMBER_OF_SAD_INTERVALS - 1;
 
-                                pcs_ptr->me_distortion_histogram[sad_interval_index]++;
+                            pcs_ptr->inter_sad_interval_index[sb_index] = sad_interval_index;
+
+                            pcs_ptr->me_distortion_histogram[sad_interval_index]++;
+
+                            intra_sad_interval_index =
+                                pcs_ptr->variance[sb_index][ME_TIER_ZERO_PU_64x64] >> 4;
+                            intra_sad_interval_index =
+                                (uint16_t)(intra_sad_interval_index >> 2);
+                            if (intra_sad_interval_index > (NUMBER_OF_SAD_INTERVALS >> 1) - 1) {
+                                uint32_t sad_interval_index_temp =
+                                    intra_sad_interval_index -
+                                    ((NUMBER_OF_SAD_INTERVALS >> 1) - 1);
 
                                 intra_sad_interval_index =
-                                    pcs_ptr->variance[sb_index][ME_TIER_ZERO_PU_64x64] >> 4;
-                                intra_sad_interval_index =
-                                    (uint16_t)(intra_sad_interval_index >> 2);
-                                if (intra_sad_interval_index > (NUMBER_OF_SAD_INTERVALS >> 1) - 1) {
-                                    uint32_t sad_interval_index_temp =
-                                        intra_sad_interval_index -
-                                        ((NUMBER_OF_SAD_INTERVALS >> 1) - 1);
-
-                                    intra_sad_interval_index =
-                                        ((NUMBER_OF_SAD_INTERVALS >> 1) - 1) +
-                                        (sad_interval_index_temp >> 3);
-                                }
-                                if (intra_sad_interval_index >= NUMBER_OF_SAD_INTERVALS - 1)
-                                    intra_sad_interval_index = NUMBER_OF_SAD_INTERVALS - 1;
+                                    ((NUMBER_OF_SAD_INTERVALS >> 1) - 1) +
+                                    (sad_interval_index_temp >> 3);
+                            }
+                            if (intra_sad_interval_index >= NUMBER_OF_SAD_INTERVALS - 1)
+                                intra_sad_interval_index = NUMBER_OF_SAD_INTERVALS - 1;
 
-                                pcs_ptr->intra_sad_interval_index[sb_index] =
-                                    intra_sad_interval_index;
+                            pcs_ptr->intra_sad_interval_index[sb_index] =
+                                intra_sad_interval_index;
 
-                                pcs_ptr->ois_distortion_histogram[intra_sad_interval_index]++;
+                            pcs_ptr->ois_distortion_histogram[intra_sad_interval_index]++;
 
-                                ++pcs_ptr->full_sb_count;
-                            }
+                            ++pcs_ptr->full_sb_count;
                         }
                     }
-                } else {
-                    for (y_sb_index = y_sb_start_index; y_sb_index < y_sb_end_index; ++y_sb_index) {
-                        for (x_sb_index = x_sb_start_index; x_sb_index < x_sb_end_index;
-                             ++x_sb_index) {
-                            sb_origin_x = x_sb_index * scs_ptr->sb_sz;
-                            sb_origin_y = y_sb_index * scs_ptr->sb_sz;
-                            sb_width =
-                                (scs_ptr->seq_header.max_frame_width - sb_origin_x) < BLOCK_SIZE_64
-                                    ? scs_ptr->seq_header.max_frame_width - sb_origin_x
-                                    : BLOCK_SIZE_64;
-                            sb_height =
-                                (scs_ptr->seq_header.max_frame_height - sb_origin_y) < BLOCK_SIZE_64
-                                    ? scs_ptr->seq_header.max_frame_height - sb_origin_y
-                                    : BLOCK_SIZE_64;
-
-                            sb_index = (uint16_t)(x_sb_index + y_sb_index * pic_width_in_sb);
-
-                            pcs_ptr->inter_sad_interval_index[sb_index] = 0;
-                            pcs_ptr->intra_sad_interval_index[sb_index] = 0;
-
-                            if (sb_width == BLOCK_SIZE_64 && sb_height == BLOCK_SIZE_64) {
-                                intra_sad_interval_index =
-                                    pcs_ptr->variance[sb_index][ME_TIER_ZERO_PU_64x64] >> 4;
-                                intra_sad_interval_index =
-                                    (uint16_t)(intra_sad_interval_index >> 2);
-                                if (intra_sad_interval_index > (NUMBER_OF_SAD_INTERVALS >> 1) - 1) {
-                                    uint32_t sad_interval_index_temp =
-                                        intra_sad_interval_index -
-                                        ((NUMBER_OF_SAD_INTERVALS >> 1) - 1);
-
-                                    intra_sad_interval_index =
-                                        ((NUMBER_OF_SAD_INTERVALS >> 1) - 1) +
-                                        (sad_interval_index_temp >> 3);
-                                }
-                                if (intra_sad_interval_index >= NUMBER_OF_SAD_INTERVALS - 1)
-                                    intra_sad_interval_index = NUMBER_OF_SAD_INTERVALS - 1;
+                }
+            } else {
+                for (y_sb_index = y_sb_start_index; y_sb_index < y_sb_end_index; ++y_sb_index) {
+                    for (x_sb_index = x_sb_start_index; x_sb_index < x_sb_end_index;
+                         ++x_sb_index) {
+                        sb_origin_x = x_sb_index * scs_ptr->sb_sz;
+                        sb_origin_y = y_sb_index * scs_ptr->sb_sz;
+                        sb_width =
+                            (scs_ptr->seq_header.max_frame_width - sb_origin_x) < BLOCK_SIZE_64
+                                ? scs_ptr->seq_header.max_frame_width - sb_origin_x
+                                : BLOCK_SIZE_64;
+                        sb_height =
+                            (scs_ptr->seq_header.max_frame_height - sb_origin_y) < BLOCK_SIZE_64
+                                ? scs_ptr->seq_header.max_frame_height - sb_origin_y
+                                : BLOCK_SIZE_64;
+
+                        sb_index = (uint16_t)(x_sb_index + y_sb_index * pic_width_in_sb);
 
-                                pcs_ptr->intra_sad_interval_index[sb_index] =
-                                    intra_sad_interval_index;
+                        pcs_ptr->inter_sad_interval_index[sb_index] = 0;
+                        pcs_ptr->intra_sad_interval_index[sb_index] = 0;
 
-                                pcs_ptr->ois_distortion_histogram[intra_sad_interval_index]++;
+                        if (sb_width == BLOCK_SIZE_64 && sb_height == BLOCK_SIZE_64) {
+                            intra_sad_interval_index =
+                                pcs_ptr->variance[sb_index][ME_TIER_ZERO_PU_64x64] >> 4;
+                            intra_sad_interval_index =
+                                (uint16_t)(intra_sad_interval_index >> 2);
+                            if (intra_sad_interval_index > (NUMBER_OF_SAD_INTERVALS >> 1) - 1) {
+                                uint32_t sad_interval_index_temp =
+                                    intra_sad_interval_index -
+                                    ((NUMBER_OF_SAD_INTERVALS >> 1) - 1);
 
-                                ++pcs_ptr->full_sb_count;
+                                intra_sad_interval_index =
+                                    ((NUMBER_OF_SAD_INTERVALS >> 1) - 1) +
+                                    (sad_interval_index_temp >> 3);
                             }
+                            if (intra_sad_interval_index >= NUMBER_OF_SAD_INTERVALS - 1)
+                                intra_sad_interval_index = NUMBER_OF_SAD_INTERVALS - 1;
+
+                            pcs_ptr->intra_sad_interval_index[sb_index] =
+                                intra_sad_interval_index;
+
+                            pcs_ptr->ois_distortion_histogram[intra_sad_interval_index]++;
+
+                            ++pcs_ptr->full_sb_count;
                         }
                     }
                 }
             }
+        }
 
-            eb_release_mutex(pcs_ptr->rc_distortion_histogram_mutex);
+        eb_release_mutex(pcs_ptr->rc_distortion_histogram_mutex);
 
-            // Get Empty Results Object
-            eb_get_empty_object(context_ptr->motion_estimation_results_output_fifo_ptr,
-                                &out_results_wrapper_ptr);
+        // Get Empty Results Object
+        eb_get_empty_object(context_ptr->motion_estimation_results_output_fifo_ptr,
+                            &out_results_wrapper_ptr);
 
-            out_results_ptr = (MotionEstimationResults *)out_results_wrapper_ptr->object_ptr;
-            out_results_ptr->pcs_wrapper_ptr = in_results_ptr->pcs_wrapper_ptr;
-            out_results_ptr->segment_index   = segment_index;
+        out_results_ptr = (MotionEstimationResults *)out_results_wrapper_ptr->object_ptr;
+        out_results_ptr->pcs_wrapper_ptr = in_results_ptr->pcs_wrapper_ptr;
+        out_results_ptr->segment_index   = segment_index;
 
-            // Release the Input Results
-            eb_release_object(in_results_wrapper_ptr);
+        // Release the Input Results
+        eb_release_object(in_results_wrapper_ptr);
 
-            // Post the Full Results Object
-            eb_post_full_object(out_results_wrapper_ptr);
+        // Post the Full Results Object
+        eb_post_full_object(out_results_wrapper_ptr);
 
-        } else {
-            // ME Kernel Signal(s) derivation
-            tf_signal_derivation_me_kernel_oq(scs_ptr, pcs_ptr, context_ptr);
+    } else {
+        // ME Kernel Signal(s) derivation
+        tf_signal_derivation_me_kernel_oq(scs_ptr, pcs_ptr, context_ptr);
 
-            // temporal filtering start
-            context_ptr->me_context_ptr->me_alt_ref = EB_TRUE;
-            svt_av1_init_temporal_filtering(
-                pcs_ptr->temp_filt_pcs_list, pcs_ptr, context_ptr, in_results_ptr->segment_index);
+        // temporal filtering start
+        context_ptr->me_context_ptr->me_alt_ref = EB_TRUE;
+        svt_av1_init_temporal_filtering(
+            pcs_ptr->temp_filt_pcs_list, pcs_ptr, context_ptr, in_results_ptr->segment_index);
 
-            // Release the Input Results
-            eb_release_object(in_results_wrapper_ptr);
-        }
+        // Release the Input Results
+        eb_release_object(in_results_wrapper_ptr);
     }
+}
+
+/******************************************************
+ * Motion Estimation Kernel
+ ******************************************************/
+void *motion_estimation_kernel(void *input_ptr) {
+    EbThreadContext *          thread_context_ptr = (EbThreadContext *)input_ptr;
+    MotionEstimationContext_t *context_ptr =
+        (MotionEstimationContext_t *)thread_context_ptr->priv;
+    EbObjectWrapper *          in_results_wrapper_ptr;
 
+    for (;;) {
+        // Get Input Full Object
+        eb_get_full_object(context_ptr->picture_decision_results_input_fifo_ptr,
+                           &in_results_wrapper_ptr);
+
+        motion_estimation_job(thread_context_ptr, in_results_wrapper_ptr);
+    }
     return EB_NULL;
 }
@@ -28,6 +28,8 @@ typedef struct MotionEstimationContext {
 EbErrorType motion_estimation_context_ctor(EbThreadContext *  thread_context_ptr,
                                            const EbEncHandle *enc_handle_ptr, int index);
 
+extern void motion_estimation_job(EbThreadContext *thread_context_ptr,
+                                  EbObjectWrapper *in_results_wrapper_ptr);
 extern void *motion_estimation_kernel(void *input_ptr);
 
 EbErrorType signal_derivation_me_kernel_oq(SequenceControlSet *       scs_ptr,
@@ -26,6 +26,8 @@ EbErrorType neighbor_array_unit_ctor32(NeighborArrayUnit32 *na_unit_ptr, uint32_
                                        uint32_t granularity_normal, uint32_t granularity_top_left,
                                        uint32_t type_mask) {
     na_unit_ptr->dctor                     = neighbor_array_unit_dctor32;
+    na_unit_ptr->origin_x                  = 0;
+    na_unit_ptr->origin_y                  = 0;
     na_unit_ptr->unit_size                 = (uint8_t)(unit_size);
     na_unit_ptr->granularity_normal        = (uint8_t)(granularity_normal);
     na_unit_ptr->granularity_normal_log2   = (uint8_t)(Log2f(na_unit_ptr->granularity_normal));
@@ -71,6 +73,8 @@ EbErrorType neighbor_array_unit_ctor(NeighborArrayUnit *na_unit_ptr, uint32_t ma
                                      uint32_t granularity_normal, uint32_t granularity_top_left,
                                      uint32_t type_mask) {
     na_unit_ptr->dctor                     = neighbor_array_unit_dctor;
+    na_unit_ptr->origin_x                  = 0;
+    na_unit_ptr->origin_y                  = 0;
     na_unit_ptr->unit_size                 = (uint8_t)(unit_size);
     na_unit_ptr->granularity_normal        = (uint8_t)(granularity_normal);
     na_unit_ptr->granularity_normal_log2   = (uint8_t)(Log2f(na_unit_ptr->granularity_normal));
@@ -143,19 +147,36 @@ void neighbor_array_unit_reset(NeighborArrayUnit *na_unit_ptr) {
     return;
 }
 
+/*************************************************
+ * Neighbor Array Unit Set Origin
+ *************************************************/
+void neighbor_array_unit_set_origin32(NeighborArrayUnit32 *na_unit_ptr, uint32_t origin_x,
+                                      uint32_t origin_y) {
+    na_unit_ptr->origin_x = origin_x;
+    na_unit_ptr->origin_y = origin_y;
+}
+
+void neighbor_array_unit_set_origin(NeighborArrayUnit *na_unit_ptr, uint32_t origin_x,
+                                    uint32_t origin_y) {
+    na_unit_ptr->origin_x = origin_x;
+    na_unit_ptr->origin_y = origin_y;
+}
+
 /*************************************************
  * Neighbor Array Unit Get Top Index
  *************************************************/
 uint32_t get_neighbor_array_unit_top_left_index_32(NeighborArrayUnit32 *na_unit_ptr, int32_t loc_x,
                                                    int32_t loc_y) {
-    return na_unit_ptr->left_array_size + (loc_x >> na_unit_ptr->granularity_top_left_log2) -
-           (loc_y >> na_unit_ptr->granularity_top_left_log2);
+    return na_unit_ptr->left_array_size +
+           ((loc_x - (int32_t)na_unit_ptr->origin_x) >> na_unit_ptr->granularity_top_left_log2) -
+           ((loc_y - (int32_t)na_unit_ptr->origin_y) >> na_unit_ptr->granularity_top_left_log2);
 }
 
 uint32_t get_neighbor_array_unit_top_left_index(NeighborArrayUnit *na_unit_ptr, int32_t loc_x,
                                                 int32_t loc_y) {
-    return na_unit_ptr->left_array_size + (loc_x >> na_unit_ptr->granularity_top_left_log2) -
-           (loc_y >> na_unit_ptr->granularity_top_left_log2);
+    return na_unit_ptr->left_array_size +
+           ((loc_x - (int32_t)na_unit_ptr->origin_x) >> na_unit_ptr->granularity_top_left_log2) -
+           ((loc_y - (int32_t)na_unit_ptr->origin_y) >> na_unit_ptr->granularity_top_left_log2);
 }
 
 void update_recon_neighbor_array(NeighborArrayUnit *na_unit_ptr, uint8_t *src_ptr_top,
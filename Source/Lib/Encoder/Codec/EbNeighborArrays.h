@@ -52,6 +52,10 @@ typedef struct NeighborArrayUnit {
     uint8_t  granularity_normal_log2;
     uint8_t  granularity_top_left;
     uint8_t  granularity_top_left_log2;
+    // origin_x, origin_y - picture position of the first entries, the
+    //   arrays of a tile only cover the tile
+    uint32_t origin_x;
+    uint32_t origin_y;
 } NeighborArrayUnit;
 
 typedef struct NeighborArrayUnit32 {
@@ -67,6 +71,8 @@ typedef struct NeighborArrayUnit32 {
     uint8_t   granularity_normal_log2;
     uint8_t   granularity_top_left;
     uint8_t   granularity_top_left_log2;
+    uint32_t  origin_x;
+    uint32_t  origin_y;
 } NeighborArrayUnit32;
 
 extern EbErrorType neighbor_array_unit_ctor32(NeighborArrayUnit32 *na_unit_ptr,
@@ -84,17 +90,25 @@ extern void neighbor_array_unit_reset(NeighborArrayUnit *na_unit_ptr);
 
 extern void neighbor_array_unit_reset32(NeighborArrayUnit32 *na_unit_ptr);
 
+// Moves the arrays to the picture position origin_x, origin_y, e.g. to the
+//   start of the tile they are used for
+extern void neighbor_array_unit_set_origin(NeighborArrayUnit *na_unit_ptr, uint32_t origin_x,
+                                           uint32_t origin_y);
+
+extern void neighbor_array_unit_set_origin32(NeighborArrayUnit32 *na_unit_ptr, uint32_t origin_x,
+                                             uint32_t origin_y);
+
 /*************************************************
      * Neighbor Array Unit Get Left Index
      *************************************************/
 static INLINE uint32_t get_neighbor_array_unit_left_index32(NeighborArrayUnit32 *na_unit_ptr,
                                                             uint32_t             loc_y) {
-    return (loc_y >> na_unit_ptr->granularity_normal_log2);
+    return ((loc_y - na_unit_ptr->origin_y) >> na_unit_ptr->granularity_normal_log2);
 }
 
 static INLINE uint32_t get_neighbor_array_unit_left_index(NeighborArrayUnit *na_unit_ptr,
                                                           uint32_t           loc_y) {
-    return (loc_y >> na_unit_ptr->granularity_normal_log2);
+    return ((loc_y - na_unit_ptr->origin_y) >> na_unit_ptr->granularity_normal_log2);
 }
 
 /*************************************************
@@ -102,12 +116,12 @@ static INLINE uint32_t get_neighbor_array_unit_left_index(NeighborArrayUnit *na_
      *************************************************/
 static INLINE uint32_t get_neighbor_array_unit_top_index32(NeighborArrayUnit32 *na_unit_ptr,
                                                            uint32_t             loc_x) {
-    return (loc_x >> na_unit_ptr->granularity_normal_log2);
+    return ((loc_x - na_unit_ptr->origin_x) >> na_unit_ptr->granularity_normal_log2);
 }
 
 static INLINE uint32_t get_neighbor_array_unit_top_index(NeighborArrayUnit *na_unit_ptr,
                                                          uint32_t           loc_x) {
-    return (loc_x >> na_unit_ptr->granularity_normal_log2);
+    return ((loc_x - na_unit_ptr->origin_x) >> na_unit_ptr->granularity_normal_log2);
 }
 
 extern uint32_t get_neighbor_array_unit_top_left_index(NeighborArrayUnit *na_unit_ptr,
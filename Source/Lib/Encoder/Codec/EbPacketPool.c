@@ -0,0 +1,112 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <stdlib.h>
+
+#include "EbPacketPool.h"
+#include "EbThreads.h"
+
+static void eb_packet_pool_dctor(EbPtr p) {
+    EbPacketPool *obj = (EbPacketPool *)p;
+    // The buffers are allocated at run time, outside the memory map
+    for (uint32_t buffer_index = 0; buffer_index < obj->free_count; ++buffer_index)
+        free(obj->free_array[buffer_index]);
+    EB_DESTROY_MUTEX(obj->mutex);
+    EB_FREE_ARRAY(obj->free_array);
+    EB_FREE_ARRAY(obj->app_array);
+}
+
+/**************************************
+ * eb_packet_pool_ctor
+ **************************************/
+EbErrorType eb_packet_pool_ctor(EbPacketPool *pool_ptr, uint32_t buffer_size, uint32_t max_count) {
+    pool_ptr->dctor          = eb_packet_pool_dctor;
+    pool_ptr->buffer_size    = buffer_size;
+    pool_ptr->max_free_count = max_count;
+    pool_ptr->max_app_count  = max_count;
+
+    EB_MALLOC_ARRAY(pool_ptr->free_array, max_count);
+    EB_MALLOC_ARRAY(pool_ptr->app_array, max_count);
+    EB_CREATE_MUTEX(pool_ptr->mutex);
+
+    return EB_ErrorNone;
+}
+
+/**************************************
+ * eb_packet_pool_get
+ **************************************/
+EbErrorType eb_packet_pool_get(EbPacketPool *pool_ptr, EbOutputPacket *packet_ptr) {
+    uint8_t *buffer = NULL;
+
+    eb_block_on_mutex(pool_ptr->mutex);
+    if (pool_ptr->app_count) {
+        EbPacketAppBuffer *app_ptr = &pool_ptr->app_array[pool_ptr->app_head];
+        packet_ptr->header.p_buffer    = app_ptr->buffer;
+        packet_ptr->header.n_alloc_len = app_ptr->size;
+        packet_ptr->app_buffer         = EB_TRUE;
+        pool_ptr->app_head             = (pool_ptr->app_head + 1) % pool_ptr->max_app_count;
+        pool_ptr->app_count--;
+        eb_release_mutex(pool_ptr->mutex);
+        return EB_ErrorNone;
+    }
+    if (pool_ptr->free_count) buffer = pool_ptr->free_array[--pool_ptr->free_count];
+    eb_release_mutex(pool_ptr->mutex);
+
+    if (buffer == NULL) {
+        buffer = (uint8_t *)malloc(pool_ptr->buffer_size);
+        if (buffer == NULL) {
+            packet_ptr->header.p_buffer    = NULL;
+            packet_ptr->header.n_alloc_len = 0;
+            packet_ptr->app_buffer         = EB_FALSE;
+            return EB_ErrorInsufficientResources;
+        }
+    }
+    packet_ptr->header.p_buffer    = buffer;
+    packet_ptr->header.n_alloc_len = pool_ptr->buffer_size;
+    packet_ptr->app_buffer         = EB_FALSE;
+    return EB_ErrorNone;
+}
+
+/**************************************
+ * eb_packet_pool_register
+ **************************************/
+EbErrorType eb_packet_pool_register(EbPacketPool *pool_ptr, uint8_t *buffer, uint32_t size) {
+    EbErrorType return_error = EB_ErrorNone;
+
+    eb_block_on_mutex(pool_ptr->mutex);
+    if (pool_ptr->app_count < pool_ptr->max_app_count) {
+        EbPacketAppBuffer *app_ptr =
+            &pool_ptr->app_array[(pool_ptr->app_head + pool_ptr->app_count) %
+                                 pool_ptr->max_app_count];
+        app_ptr->buffer = buffer;
+        app_ptr->size   = size;
+        pool_ptr->app_count++;
+    } else
+        return_error = EB_ErrorInsufficientResources;
+    eb_release_mutex(pool_ptr->mutex);
+
+    return return_error;
+}
+
+/**************************************
+ * eb_packet_pool_release
+ **************************************/
+void eb_packet_pool_release(EbPtr hook_arg, EbObjectWrapper *wrapper_ptr) {
+    EbPacketPool *  pool_ptr   = (EbPacketPool *)hook_arg;
+    EbOutputPacket *packet_ptr = (EbOutputPacket *)wrapper_ptr->object_ptr;
+    uint8_t *       buffer     = packet_ptr->header.p_buffer;
+
+    packet_ptr->header.p_buffer = NULL;
+    // The application keeps its own buffers
+    if (buffer == NULL || packet_ptr->app_buffer) return;
+
+    eb_block_on_mutex(pool_ptr->mutex);
+    if (pool_ptr->free_count < pool_ptr->max_free_count) {
+        pool_ptr->free_array[pool_ptr->free_count++] = buffer;
+        buffer                                       = NULL;
+    }
+    eb_release_mutex(pool_ptr->mutex);
+    free(buffer);
+}
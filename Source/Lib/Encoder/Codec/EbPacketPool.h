@@ -0,0 +1,80 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifndef EbPacketPool_h
+#define EbPacketPool_h
+
+#include "EbDefinitions.h"
+#include "EbSvtAv1Enc.h"
+#include "EbSystemResourceManager.h"
+#include "EbObject.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**************************************
+     * Output Packet
+     *   The object of the output stream resource. The header comes first,
+     *   it is what the application receives.
+     **************************************/
+typedef struct EbOutputPacket {
+    EbBufferHeaderType header;
+    // app_buffer - header.p_buffer was registered by the application, it
+    //   is never freed nor recycled by the encoder
+    EbBool app_buffer;
+} EbOutputPacket;
+
+typedef struct EbPacketAppBuffer {
+    uint8_t *buffer;
+    uint32_t size;
+} EbPacketAppBuffer;
+
+/**************************************
+     * Packet Pool
+     *   Bitstream buffers of the output packets. The buffers the
+     *   application registered are used first, each for one packet and in
+     *   the order they were registered. Otherwise a buffer of buffer_size
+     *   bytes is taken from the free buffers, or allocated when there is
+     *   none. The buffer of a released packet goes back to the free
+     *   buffers, which keep at most max_free_count of them.
+     **************************************/
+typedef struct EbPacketPool {
+    EbDctor  dctor;
+    EbHandle mutex;
+    uint32_t buffer_size;
+    // free_array - stack of the free buffers, the last released on top
+    uint8_t **free_array;
+    uint32_t  free_count;
+    uint32_t  max_free_count;
+    // app_array - ring of the registered buffers not used yet
+    EbPacketAppBuffer *app_array;
+    uint32_t           app_head;
+    uint32_t           app_count;
+    uint32_t           max_app_count;
+} EbPacketPool;
+
+/**************************************
+     * Extern Function Declarations
+     **************************************/
+extern EbErrorType eb_packet_pool_ctor(EbPacketPool *pool_ptr, uint32_t buffer_size,
+                                       uint32_t max_count);
+
+// Gives packet_ptr a buffer, EB_ErrorInsufficientResources when it can
+//   not be allocated
+extern EbErrorType eb_packet_pool_get(EbPacketPool *pool_ptr, EbOutputPacket *packet_ptr);
+
+// Adds an application buffer, EB_ErrorInsufficientResources when
+//   max_count of them are waiting already
+extern EbErrorType eb_packet_pool_register(EbPacketPool *pool_ptr, uint8_t *buffer,
+                                           uint32_t size);
+
+// Release hook of the output stream resource, takes the buffer back from
+//   the released packet
+extern void eb_packet_pool_release(EbPtr hook_arg, EbObjectWrapper *wrapper_ptr);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbPacketPool_h
@@ -15,6 +15,9 @@
 #include "EbTime.h"
 #include "EbModeDecisionProcess.h"
 #include "EbPictureDemuxResults.h"
+#include "EbPipelineStats.h"
+#include "EbPacketPool.h"
+#include "EbSvtAv1ErrorCodes.h"
 #define DETAILED_FRAME_OUTPUT 0
 
 /**************************************
@@ -375,6 +378,8 @@ void *packetization_kernel(void *input_ptr) {
         scs_ptr = (SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr;
         encode_context_ptr = (EncodeContext *)scs_ptr->encode_context_ptr;
         frm_hdr            = &pcs_ptr->parent_pcs_ptr->frm_hdr;
+        eb_pipeline_stats_set_picture(pcs_ptr->picture_number);
+
         //****************************************************
         // Input Entropy Results into Reordering Queue
         //****************************************************
@@ -389,8 +394,11 @@ void *packetization_kernel(void *input_ptr) {
                             &pcs_ptr->parent_pcs_ptr->output_stream_wrapper_ptr);
         output_stream_wrapper_ptr   = pcs_ptr->parent_pcs_ptr->output_stream_wrapper_ptr;
         output_stream_ptr           = (EbBufferHeaderType *)output_stream_wrapper_ptr->object_ptr;
-        output_stream_ptr->p_buffer = (uint8_t *)malloc(output_stream_ptr->n_alloc_len);
-        assert(output_stream_ptr->p_buffer != NULL && "bit-stream memory allocation failure");
+        CHECK_REPORT_ERROR(
+            eb_packet_pool_get(encode_context_ptr->packet_pool_ptr,
+                               (EbOutputPacket *)output_stream_ptr) == EB_ErrorNone,
+            encode_context_ptr->app_callback_ptr,
+            EB_ENC_PACKETIZATION_ERROR1);
 
         output_stream_ptr->flags = 0;
         output_stream_ptr->flags |=
@@ -430,10 +438,15 @@ void *packetization_kernel(void *input_ptr) {
         if (pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE &&
             pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr) {
             if (pcs_ptr->parent_pcs_ptr->frame_end_cdf_update_mode) {
-                eb_av1_reset_cdf_symbol_counters(pcs_ptr->entropy_coder_ptr->fc);
+                // The CDFs are updated from the last tile, see write_tile_info()
+                const uint16_t tile_cnt =
+                    (uint16_t)(pcs_ptr->parent_pcs_ptr->av1_cm->tiles_info.tile_cols *
+                               pcs_ptr->parent_pcs_ptr->av1_cm->tiles_info.tile_rows);
+                EntropyCoder *entropy_coder_ptr = pcs_ptr->ec_info[tile_cnt - 1]->entropy_coder_ptr;
+                eb_av1_reset_cdf_symbol_counters(entropy_coder_ptr->fc);
                 ((EbReferenceObject *)
                      pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)
-                    ->frame_context = (*pcs_ptr->entropy_coder_ptr->fc);
+                    ->frame_context = (*entropy_coder_ptr->fc);
             }
             // Get Empty Results Object
             eb_get_empty_object(context_ptr->picture_manager_input_fifo_ptr,
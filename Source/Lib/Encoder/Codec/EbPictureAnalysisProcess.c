@@ -21,6 +21,8 @@
 #include "EbReferenceObject.h"
 #include "EbComputeMean_SSE2.h"
 #include "EbUtility.h"
+#include "EbPipelineStats.h"
+#include "EbGlobalMotionEstimation.h"
 
 #define VARIANCE_PRECISION 16
 #define SB_LOW_VAR_TH 5
@@ -43,6 +45,7 @@ typedef struct PictureAnalysisContext {
     EB_ALIGN(64) uint8_t local_cache[64];
     EbFifo *             resource_coordination_results_input_fifo_ptr;
     EbFifo *             picture_analysis_results_output_fifo_ptr;
+    EbFifo *             pa_feedback_fifo_ptr; // segment tasks posted back to the PA threads
     EbPictureBufferDesc *denoised_picture_ptr;
     EbPictureBufferDesc *noise_picture_ptr;
     double               pic_noise_variance_float;
@@ -59,7 +62,8 @@ static void picture_analysis_context_dctor(EbPtr p) {
 * Picture Analysis Context Constructor
 ************************************************/
 EbErrorType picture_analysis_context_ctor(EbThreadContext *  thread_context_ptr,
-                                          const EbEncHandle *enc_handle_ptr, int index) {
+                                          const EbEncHandle *enc_handle_ptr, int index,
+                                          int feedback_index) {
     EbBool denoise_flag = EB_TRUE;
 
     PictureAnalysisContext *context_ptr;
@@ -72,6 +76,8 @@ EbErrorType picture_analysis_context_ctor(EbThreadContext *  thread_context_ptr,
             enc_handle_ptr->resource_coordination_results_resource_ptr, index);
     context_ptr->picture_analysis_results_output_fifo_ptr = eb_system_resource_get_producer_fifo(
         enc_handle_ptr->picture_analysis_results_resource_ptr, index);
+    context_ptr->pa_feedback_fifo_ptr = eb_system_resource_get_producer_fifo(
+        enc_handle_ptr->resource_coordination_results_resource_ptr, feedback_index);
 
     if (denoise_flag == EB_TRUE) {
         EbPictureBufferDescInitData desc;
@@ -4739,6 +4745,9 @@ EbErrorType denoise_estimate_film_grain(SequenceControlSet *     scs_ptr,
     frm_hdr->film_grain_params.apply_grain = 0;
 
     if (scs_ptr->film_grain_denoise_strength) {
+        // The denoised samples replace the source, never in the planes of the application
+        if (scs_ptr->static_config.zero_copy_input)
+            eb_picture_buffer_desc_own_planes(input_picture_ptr);
         if (apply_denoise_2d(scs_ptr, pcs_ptr, input_picture_ptr) < 0) return 1;
     }
 
@@ -5733,28 +5742,26 @@ void determine_homogeneous_region_in_picture(SequenceControlSet *     scs_ptr,
     return;
 }
 /************************************************
- * compute_picture_spatial_statistics
+ * compute_segment_spatial_statistics
  ** Compute Block Variance
- ** Compute Picture Variance
- ** Compute Block Mean for all blocks in the picture
+ ** Compute Block Mean for the blocks of SBs [sb_index_start, sb_index_end)
+ ** Returns the sum of the 64x64 variances of the segment
  ************************************************/
-void compute_picture_spatial_statistics(SequenceControlSet *     scs_ptr,
-                                        PictureParentControlSet *pcs_ptr,
-                                        EbPictureBufferDesc *    input_picture_ptr,
-                                        EbPictureBufferDesc *    input_padded_picture_ptr,
-                                        uint32_t                 sb_total_count) {
+static uint64_t compute_segment_spatial_statistics(SequenceControlSet *     scs_ptr,
+                                                   PictureParentControlSet *pcs_ptr,
+                                                   EbPictureBufferDesc *    input_picture_ptr,
+                                                   EbPictureBufferDesc *    input_padded_picture_ptr,
+                                                   uint32_t                 sb_index_start,
+                                                   uint32_t                 sb_index_end) {
     uint32_t sb_index;
     uint32_t sb_origin_x; // to avoid using child PCS
     uint32_t sb_origin_y;
     uint32_t input_luma_origin_index;
     uint32_t input_cb_origin_index;
     uint32_t input_cr_origin_index;
-    uint64_t pic_tot_variance;
-
-    // Variance
-    pic_tot_variance = 0;
+    uint64_t seg_tot_variance = 0;
 
-    for (sb_index = 0; sb_index < pcs_ptr->sb_total_count; ++sb_index) {
+    for (sb_index = sb_index_start; sb_index < sb_index_end; ++sb_index) {
         SbParams *sb_params = &scs_ptr->sb_params_array[sb_index];
 
         sb_origin_x             = sb_params->origin_x;
@@ -5784,9 +5791,20 @@ void compute_picture_spatial_statistics(SequenceControlSet *     scs_ptr,
             zero_out_chroma_block_mean(pcs_ptr, sb_index);
         }
 
-        pic_tot_variance += (pcs_ptr->variance[sb_index][RASTER_SCAN_CU_INDEX_64x64]);
+        seg_tot_variance += (pcs_ptr->variance[sb_index][RASTER_SCAN_CU_INDEX_64x64]);
     }
 
+    return seg_tot_variance;
+}
+
+/************************************************
+ * finalize_picture_spatial_statistics
+ ** Compute Picture Variance once all the blocks statistics are available
+ ************************************************/
+static void finalize_picture_spatial_statistics(SequenceControlSet *     scs_ptr,
+                                                PictureParentControlSet *pcs_ptr,
+                                                uint64_t                 pic_tot_variance,
+                                                uint32_t                 sb_total_count) {
     pcs_ptr->pic_avg_variance = (uint16_t)(pic_tot_variance / sb_total_count);
 
     // Calculate the variance of variance to determine Homogeneous regions. Note: Variance calculation should be on.
@@ -5797,6 +5815,25 @@ void compute_picture_spatial_statistics(SequenceControlSet *     scs_ptr,
     return;
 }
 
+/************************************************
+ * compute_picture_spatial_statistics
+ ** Compute Block Variance
+ ** Compute Picture Variance
+ ** Compute Block Mean for all blocks in the picture
+ ************************************************/
+void compute_picture_spatial_statistics(SequenceControlSet *     scs_ptr,
+                                        PictureParentControlSet *pcs_ptr,
+                                        EbPictureBufferDesc *    input_picture_ptr,
+                                        EbPictureBufferDesc *    input_padded_picture_ptr,
+                                        uint32_t                 sb_total_count) {
+    uint64_t pic_tot_variance = compute_segment_spatial_statistics(
+        scs_ptr, pcs_ptr, input_picture_ptr, input_padded_picture_ptr, 0, pcs_ptr->sb_total_count);
+
+    finalize_picture_spatial_statistics(scs_ptr, pcs_ptr, pic_tot_variance, sb_total_count);
+
+    return;
+}
+
 void calculate_input_average_intensity(SequenceControlSet *     scs_ptr,
                                        PictureParentControlSet *pcs_ptr,
                                        EbPictureBufferDesc *    input_picture_ptr,
@@ -5859,15 +5896,14 @@ void calculate_input_average_intensity(SequenceControlSet *     scs_ptr,
 }
 
 /************************************************
- * Gathering statistics per picture
+ * Gathering histograms per picture
  ** Calculating the pixel intensity histogram bins per picture needed for SCD
- ** Computing Picture Variance
+ ** Calculating the picture average intensity
  ************************************************/
-void gathering_picture_statistics(SequenceControlSet *scs_ptr, PictureParentControlSet *pcs_ptr,
-                                  EbPictureBufferDesc *input_picture_ptr,
-                                  EbPictureBufferDesc *input_padded_picture_ptr,
-                                  EbPictureBufferDesc *sixteenth_decimated_picture_ptr,
-                                  uint32_t             sb_total_count) {
+static void gathering_picture_histograms(SequenceControlSet *     scs_ptr,
+                                         PictureParentControlSet *pcs_ptr,
+                                         EbPictureBufferDesc *    input_picture_ptr,
+                                         EbPictureBufferDesc *    sixteenth_decimated_picture_ptr) {
     uint64_t sum_avg_intensity_ttl_regions_luma = 0;
     uint64_t sum_avg_intensity_ttl_regions_cb   = 0;
     uint64_t sum_avg_intensity_ttl_regions_cr   = 0;
@@ -5894,6 +5930,21 @@ void gathering_picture_statistics(SequenceControlSet *scs_ptr, PictureParentCont
                                       sum_avg_intensity_ttl_regions_cb,
                                       sum_avg_intensity_ttl_regions_cr);
 
+    return;
+}
+
+/************************************************
+ * Gathering statistics per picture
+ ** Calculating the pixel intensity histogram bins per picture needed for SCD
+ ** Computing Picture Variance
+ ************************************************/
+void gathering_picture_statistics(SequenceControlSet *scs_ptr, PictureParentControlSet *pcs_ptr,
+                                  EbPictureBufferDesc *input_picture_ptr,
+                                  EbPictureBufferDesc *input_padded_picture_ptr,
+                                  EbPictureBufferDesc *sixteenth_decimated_picture_ptr,
+                                  uint32_t             sb_total_count) {
+    gathering_picture_histograms(scs_ptr, pcs_ptr, input_picture_ptr, sixteenth_decimated_picture_ptr);
+
     compute_picture_spatial_statistics(
         scs_ptr, pcs_ptr, input_picture_ptr, input_padded_picture_ptr, sb_total_count);
 
@@ -6110,23 +6161,19 @@ unsigned int eb_av1_get_sby_perpixel_variance(const AomVarianceFnPtr *fn_ptr, //
     return ROUND_POWER_OF_TWO(var, num_pels_log2_lookup[bs]);
 }
 
-// Estimate if the source frame is screen content, based on the portion of
-// blocks that have no more than 4 (experimentally selected) luma colors.
-static void is_screen_content(PictureParentControlSet *pcs_ptr, const uint8_t *src, int use_hbd,
-                              int stride, int width, int height) {
+// Count, over the luma rows [row_start, row_end), the blocks that have no more than 4
+// (experimentally selected) luma colors. Used to estimate if the source frame is screen content.
+static void count_screen_content_blocks(const uint8_t *src, int use_hbd, int stride, int width,
+                                        int row_start, int row_end, uint32_t *counts_1,
+                                        uint32_t *counts_2) {
     assert(src != NULL);
     const int blk_w = 16;
     const int blk_h = 16;
     // These threshold values are selected experimentally.
     const int          color_thresh = 4;
     const unsigned int var_thresh   = 0;
-    // Counts of blocks with no more than color_thresh colors.
-    int counts_1 = 0;
-    // Counts of blocks with no more than color_thresh colors and variance larger
-    // than var_thresh.
-    int counts_2 = 0;
 
-    for (int r = 0; r + blk_h <= height; r += blk_h) {
+    for (int r = row_start; r + blk_h <= row_end; r += blk_h) {
         for (int c = 0; c + blk_w <= width; c += blk_w) {
             int       count_buf[1 << 12]; // Maximum (1 << 12) color levels.
             const int n_colors =
@@ -6135,7 +6182,8 @@ static void is_screen_content(PictureParentControlSet *pcs_ptr, const uint8_t *s
                     blk_h, bd, count_buf)*/
                     : eb_av1_count_colors(src + r * stride + c, stride, blk_w, blk_h, count_buf);
             if (n_colors > 1 && n_colors <= color_thresh) {
-                ++counts_1;
+                // Counts of blocks with no more than color_thresh colors.
+                ++*counts_1;
                 //struct Buf2D buf;
                 //buf.stride = stride;
                 //buf.buf = (uint8_t *)src;
@@ -6146,13 +6194,23 @@ static void is_screen_content(PictureParentControlSet *pcs_ptr, const uint8_t *s
                 /* use_hbd
                 ? av1_high_get_sby_perpixel_variance(cpi, &buf, BLOCK_16X16, bd)
                 : */
-                if (var > var_thresh) ++counts_2;
+                // Counts of blocks with no more than color_thresh colors and variance larger
+                // than var_thresh.
+                if (var > var_thresh) ++*counts_2;
             }
         }
     }
+}
 
-    pcs_ptr->sc_content_detected = (counts_1 * blk_h * blk_w * 10 > width * height) &&
-                                   (counts_2 * blk_h * blk_w * 15 > width * height);
+// Estimate if the source frame is screen content, based on the portion of
+// blocks that have no more than 4 (experimentally selected) luma colors.
+static void is_screen_content(PictureParentControlSet *pcs_ptr, uint32_t counts_1,
+                              uint32_t counts_2, int width, int height) {
+    const int blk_w = 16;
+    const int blk_h = 16;
+
+    pcs_ptr->sc_content_detected = (counts_1 * blk_h * blk_w * 10 > (uint32_t)(width * height)) &&
+                                   (counts_2 * blk_h * blk_w * 15 > (uint32_t)(width * height));
 }
 
 /************************************************
@@ -6225,22 +6283,125 @@ void downsample_filtering_input_picture(PictureParentControlSet *pcs_ptr,
 }
 
 /************************************************
- * Picture Analysis Kernel
+ * Picture Analysis Prep
+ *   Picture-wide operations run once per picture by the prep task,
+ * before any segment task is posted: padding, denoising, chroma
+ * downsampling, decimation, global motion corners and histograms.
+ ************************************************/
+static void picture_analysis_prep(SequenceControlSet *scs_ptr, PictureParentControlSet *pcs_ptr,
+                                  uint32_t sb_total_count) {
+    EbPictureBufferDesc *input_picture_ptr = pcs_ptr->enhanced_picture_ptr;
+    EbPaReferenceObject *pa_ref_obj_ =
+        (EbPaReferenceObject *)pcs_ptr->pa_reference_picture_wrapper_ptr->object_ptr;
+    EbPictureBufferDesc *input_padded_picture_ptr =
+        (EbPictureBufferDesc *)pa_ref_obj_->input_padded_picture_ptr;
+
+    generate_padding(input_picture_ptr->buffer_y,
+                     input_picture_ptr->stride_y,
+                     input_picture_ptr->width,
+                     input_picture_ptr->height,
+                     input_picture_ptr->origin_x,
+                     input_picture_ptr->origin_y);
+    {
+        uint8_t *pa = input_padded_picture_ptr->buffer_y + input_padded_picture_ptr->origin_x +
+                      input_padded_picture_ptr->origin_y * input_padded_picture_ptr->stride_y;
+        uint8_t *in = input_picture_ptr->buffer_y + input_picture_ptr->origin_x +
+                      input_picture_ptr->origin_y * input_picture_ptr->stride_y;
+        for (uint32_t row = 0; row < input_picture_ptr->height; row++)
+            EB_MEMCPY(pa + row * input_padded_picture_ptr->stride_y,
+                      in + row * input_picture_ptr->stride_y,
+                      sizeof(uint8_t) * input_picture_ptr->width);
+    }
+
+    // Set picture parameters to account for subpicture, picture scantype, and set regions by resolutions
+    set_picture_parameters_for_statistics_gathering(scs_ptr);
+
+    // Pad pictures to multiple min cu size
+    pad_picture_to_multiple_of_min_blk_size_dimensions(scs_ptr, input_picture_ptr);
+
+    // Pre processing operations performed on the input picture
+    picture_pre_processing_operations(pcs_ptr, scs_ptr, sb_total_count);
+    if (input_picture_ptr->color_format >= EB_YUV422) {
+        // Jing: Do the conversion of 422/444=>420 here since it's multi-threaded kernel
+        //       Reuse the Y, only add cb/cr in the newly created buffer desc
+        //       NOTE: since denoise may change the src, so this part is after picture_pre_processing_operations()
+        pcs_ptr->chroma_downsampled_picture_ptr->buffer_y = input_picture_ptr->buffer_y;
+        down_sample_chroma(input_picture_ptr, pcs_ptr->chroma_downsampled_picture_ptr);
+    } else
+        pcs_ptr->chroma_downsampled_picture_ptr = input_picture_ptr;
+    // Pad input picture to complete border SBs
+    pad_picture_to_multiple_of_sb_dimensions(input_padded_picture_ptr);
+    // 1/4 & 1/16 input picture decimation
+    downsample_decimation_input_picture(
+        pcs_ptr,
+        input_padded_picture_ptr,
+        (EbPictureBufferDesc *)pa_ref_obj_->quarter_decimated_picture_ptr,
+        (EbPictureBufferDesc *)pa_ref_obj_->sixteenth_decimated_picture_ptr);
+
+    // 1/4 & 1/16 input picture downsampling through filtering
+    if (scs_ptr->down_sampling_method_me_search == ME_FILTERED_DOWNSAMPLED) {
+        downsample_filtering_input_picture(
+            pcs_ptr,
+            input_padded_picture_ptr,
+            (EbPictureBufferDesc *)pa_ref_obj_->quarter_filtered_picture_ptr,
+            (EbPictureBufferDesc *)pa_ref_obj_->sixteenth_filtered_picture_ptr);
+    }
+#if GLOBAL_WARPED_MOTION
+    // Corners of the quarter picture for the global motion search of this picture and of
+    // the pictures referencing it
+    global_motion_detect_corners(scs_ptr, pcs_ptr);
+#endif
+    // Gathering histograms of input picture
+    gathering_picture_histograms(
+        scs_ptr,
+        pcs_ptr,
+        pcs_ptr->chroma_downsampled_picture_ptr, //420 input_picture_ptr
+        (EbPictureBufferDesc *)pa_ref_obj_
+            ->sixteenth_decimated_picture_ptr); // Hsan: always use decimated until studying the trade offs
+}
+
+/************************************************
+ * Post one segment task per SB-row segment back to the PA threads.
+ ************************************************/
+static void post_picture_analysis_segments(PictureAnalysisContext *context_ptr,
+                                           EbObjectWrapper *       pcs_wrapper_ptr,
+                                           uint16_t                segment_count) {
+    EbObjectWrapper *            segment_wrapper_ptr;
+    ResourceCoordinationResults *segment_ptr;
+
+    for (uint16_t segment_index = 0; segment_index < segment_count; ++segment_index) {
+        eb_get_empty_object(context_ptr->pa_feedback_fifo_ptr, &segment_wrapper_ptr);
+        segment_ptr = (ResourceCoordinationResults *)segment_wrapper_ptr->object_ptr;
+        segment_ptr->pcs_wrapper_ptr = pcs_wrapper_ptr;
+        segment_ptr->prep_task       = EB_FALSE;
+        segment_ptr->segment_index   = segment_index;
+        eb_post_full_object(segment_wrapper_ptr);
+    }
+}
+
+/************************************************
+ * Picture Analysis Job
+ *   Processes one Resource Coordination result, i.e. the prep task or
+ * one SB-row segment of a picture.
  * The Picture Analysis Process pads & decimates the input pictures.
  * The Picture Analysis also includes creating an n-bin Histogram,
  * gathering picture 1st and 2nd moment statistics for each 8x8 block,
  * which are used to compute variance.
  * The Picture Analysis process is multithreaded, so pictures can be
- * processed out of order as long as all inputs are available.
+ * processed out of order as long as all inputs are available. Within a
+ * picture, the prep task runs the picture-wide operations and posts the
+ * segments, which then gather the block statistics of their SB rows
+ * concurrently, and the last segment to complete posts the picture to
+ * Picture Decision.
  ************************************************/
-void *picture_analysis_kernel(void *input_ptr) {
-    EbThreadContext *        thread_context_ptr = (EbThreadContext *)input_ptr;
+void picture_analysis_job(EbThreadContext *thread_context_ptr,
+                          EbObjectWrapper *in_results_wrapper_ptr) {
     PictureAnalysisContext * context_ptr = (PictureAnalysisContext *)thread_context_ptr->priv;
     PictureParentControlSet *pcs_ptr;
     SequenceControlSet *     scs_ptr;
 
-    EbObjectWrapper *            in_results_wrapper_ptr;
     ResourceCoordinationResults *in_results_ptr;
+    EbObjectWrapper *            pcs_wrapper_ptr;
     EbObjectWrapper *            out_results_wrapper_ptr;
     PictureAnalysisResults *     out_results_ptr;
     EbPaReferenceObject *        pa_ref_obj_;
@@ -6253,120 +6414,131 @@ void *picture_analysis_kernel(void *input_ptr) {
     uint32_t pic_height_in_sb;
     uint32_t sb_total_count;
 
-    for (;;) {
-        // Get Input Full Object
-        eb_get_full_object(context_ptr->resource_coordination_results_input_fifo_ptr,
-                           &in_results_wrapper_ptr);
+    // Segments
+    EbBool   prep_task;
+    uint32_t segment_index;
+    uint32_t sb_row_start;
+    uint32_t sb_row_end;
+    uint64_t seg_tot_variance;
+    uint32_t sc_count_1 = 0;
+    uint32_t sc_count_2 = 0;
+    EbBool   last_segment;
+
+    in_results_ptr  = (ResourceCoordinationResults *)in_results_wrapper_ptr->object_ptr;
+    pcs_wrapper_ptr = in_results_ptr->pcs_wrapper_ptr;
+    prep_task       = in_results_ptr->prep_task;
+    segment_index   = in_results_ptr->segment_index;
+    pcs_ptr         = (PictureParentControlSet *)pcs_wrapper_ptr->object_ptr;
+    eb_pipeline_stats_set_picture(pcs_ptr->picture_number);
+
+    // Release the Input Results
+    eb_release_object(in_results_wrapper_ptr);
+
+    // There is no need to do processing for overlay picture. Overlay and AltRef share the same results.
+    if (!pcs_ptr->is_overlay) {
+        scs_ptr           = (SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr;
+        input_picture_ptr = pcs_ptr->enhanced_picture_ptr;
+
+        pa_ref_obj_ =
+            (EbPaReferenceObject *)pcs_ptr->pa_reference_picture_wrapper_ptr->object_ptr;
+        input_padded_picture_ptr = (EbPictureBufferDesc *)pa_ref_obj_->input_padded_picture_ptr;
+        // Variance
+        pic_width_in_sb =
+            (scs_ptr->seq_header.max_frame_width + scs_ptr->sb_sz - 1) / scs_ptr->sb_sz;
+        pic_height_in_sb =
+            (scs_ptr->seq_header.max_frame_height + scs_ptr->sb_sz - 1) / scs_ptr->sb_sz;
+        sb_total_count = pic_width_in_sb * pic_height_in_sb;
+
+        // The segments are only posted once the picture-wide operations are done, so no
+        // thread waits on them
+        if (prep_task) {
+            picture_analysis_prep(scs_ptr, pcs_ptr, sb_total_count);
+            post_picture_analysis_segments(
+                context_ptr, pcs_wrapper_ptr, pcs_ptr->pa_segments_total_count);
+            return;
+        }
 
-        in_results_ptr = (ResourceCoordinationResults *)in_results_wrapper_ptr->object_ptr;
-        pcs_ptr        = (PictureParentControlSet *)in_results_ptr->pcs_wrapper_ptr->object_ptr;
-
-        // There is no need to do processing for overlay picture. Overlay and AltRef share the same results.
-        if (!pcs_ptr->is_overlay) {
-            scs_ptr           = (SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr;
-            input_picture_ptr = pcs_ptr->enhanced_picture_ptr;
-
-            pa_ref_obj_ =
-                (EbPaReferenceObject *)pcs_ptr->pa_reference_picture_wrapper_ptr->object_ptr;
-            input_padded_picture_ptr = (EbPictureBufferDesc *)pa_ref_obj_->input_padded_picture_ptr;
-            // Variance
-            pic_width_in_sb =
-                (scs_ptr->seq_header.max_frame_width + scs_ptr->sb_sz - 1) / scs_ptr->sb_sz;
-            pic_height_in_sb =
-                (scs_ptr->seq_header.max_frame_height + scs_ptr->sb_sz - 1) / scs_ptr->sb_sz;
-            sb_total_count = pic_width_in_sb * pic_height_in_sb;
-            generate_padding(input_picture_ptr->buffer_y,
-                             input_picture_ptr->stride_y,
-                             input_picture_ptr->width,
-                             input_picture_ptr->height,
-                             input_picture_ptr->origin_x,
-                             input_picture_ptr->origin_y);
-            {
-                uint8_t *pa =
-                    input_padded_picture_ptr->buffer_y + input_padded_picture_ptr->origin_x +
-                    input_padded_picture_ptr->origin_y * input_padded_picture_ptr->stride_y;
-                uint8_t *in = input_picture_ptr->buffer_y + input_picture_ptr->origin_x +
-                              input_picture_ptr->origin_y * input_picture_ptr->stride_y;
-                for (uint32_t row = 0; row < input_picture_ptr->height; row++)
-                    EB_MEMCPY(pa + row * input_padded_picture_ptr->stride_y,
-                              in + row * input_picture_ptr->stride_y,
-                              sizeof(uint8_t) * input_picture_ptr->width);
-            }
+        // Gathering statistics of the segment SB rows, including Variance Calculation
+        sb_row_start = segment_index * pic_height_in_sb / pcs_ptr->pa_segments_total_count;
+        sb_row_end   = (segment_index + 1) * pic_height_in_sb / pcs_ptr->pa_segments_total_count;
+        seg_tot_variance = compute_segment_spatial_statistics(
+            scs_ptr,
+            pcs_ptr,
+            pcs_ptr->chroma_downsampled_picture_ptr, //420 input_picture_ptr
+            input_padded_picture_ptr,
+            MIN(sb_row_start * pic_width_in_sb, pcs_ptr->sb_total_count),
+            MIN(sb_row_end * pic_width_in_sb, pcs_ptr->sb_total_count));
+
+        if (scs_ptr->static_config.screen_content_mode == 2) { // auto detect
+            count_screen_content_blocks(
+                input_picture_ptr->buffer_y + input_picture_ptr->origin_x +
+                    input_picture_ptr->origin_y * input_picture_ptr->stride_y,
+                0,
+                input_picture_ptr->stride_y,
+                scs_ptr->seq_header.max_frame_width,
+                MIN(sb_row_start * scs_ptr->sb_sz, scs_ptr->seq_header.max_frame_height),
+                MIN(sb_row_end * scs_ptr->sb_sz, scs_ptr->seq_header.max_frame_height),
+                &sc_count_1,
+                &sc_count_2);
+        }
 
-            // Set picture parameters to account for subpicture, picture scantype, and set regions by resolutions
-            set_picture_parameters_for_statistics_gathering(scs_ptr);
-
-            // Pad pictures to multiple min cu size
-            pad_picture_to_multiple_of_min_blk_size_dimensions(scs_ptr, input_picture_ptr);
-
-            // Pre processing operations performed on the input picture
-            picture_pre_processing_operations(pcs_ptr, scs_ptr, sb_total_count);
-            if (input_picture_ptr->color_format >= EB_YUV422) {
-                // Jing: Do the conversion of 422/444=>420 here since it's multi-threaded kernel
-                //       Reuse the Y, only add cb/cr in the newly created buffer desc
-                //       NOTE: since denoise may change the src, so this part is after picture_pre_processing_operations()
-                pcs_ptr->chroma_downsampled_picture_ptr->buffer_y = input_picture_ptr->buffer_y;
-                down_sample_chroma(input_picture_ptr, pcs_ptr->chroma_downsampled_picture_ptr);
-            } else
-                pcs_ptr->chroma_downsampled_picture_ptr = input_picture_ptr;
-            // Pad input picture to complete border SBs
-            pad_picture_to_multiple_of_sb_dimensions(input_padded_picture_ptr);
-            // 1/4 & 1/16 input picture decimation
-            downsample_decimation_input_picture(
-                pcs_ptr,
-                input_padded_picture_ptr,
-                (EbPictureBufferDesc *)pa_ref_obj_->quarter_decimated_picture_ptr,
-                (EbPictureBufferDesc *)pa_ref_obj_->sixteenth_decimated_picture_ptr);
-
-            // 1/4 & 1/16 input picture downsampling through filtering
-            if (scs_ptr->down_sampling_method_me_search == ME_FILTERED_DOWNSAMPLED) {
-                downsample_filtering_input_picture(
-                    pcs_ptr,
-                    input_padded_picture_ptr,
-                    (EbPictureBufferDesc *)pa_ref_obj_->quarter_filtered_picture_ptr,
-                    (EbPictureBufferDesc *)pa_ref_obj_->sixteenth_filtered_picture_ptr);
-            }
-            // Gathering statistics of input picture, including Variance Calculation, Histogram Bins
-            gathering_picture_statistics(
-                scs_ptr,
-                pcs_ptr,
-                pcs_ptr->chroma_downsampled_picture_ptr, //420 input_picture_ptr
-                input_padded_picture_ptr,
-                (EbPictureBufferDesc *)pa_ref_obj_
-                    ->sixteenth_decimated_picture_ptr, // Hsan: always use decimated until studying the trade offs
-                sb_total_count);
-
-            if (scs_ptr->static_config.screen_content_mode == 2) { // auto detect
-                is_screen_content(pcs_ptr,
-                                  input_picture_ptr->buffer_y + input_picture_ptr->origin_x +
-                                      input_picture_ptr->origin_y * input_picture_ptr->stride_y,
-                                  0,
-                                  input_picture_ptr->stride_y,
-                                  scs_ptr->seq_header.max_frame_width,
-                                  scs_ptr->seq_header.max_frame_height);
-            } else // off / on
-                pcs_ptr->sc_content_detected = scs_ptr->static_config.screen_content_mode;
-
-            // Hold the 64x64 variance and mean in the reference frame
-            uint32_t sb_index;
-            for (sb_index = 0; sb_index < pcs_ptr->sb_total_count; ++sb_index) {
-                pa_ref_obj_->variance[sb_index] =
-                    pcs_ptr->variance[sb_index][ME_TIER_ZERO_PU_64x64];
-                pa_ref_obj_->y_mean[sb_index] = pcs_ptr->y_mean[sb_index][ME_TIER_ZERO_PU_64x64];
-            }
+        // Hold the 64x64 variance and mean in the reference frame
+        uint32_t sb_index;
+        for (sb_index = MIN(sb_row_start * pic_width_in_sb, pcs_ptr->sb_total_count);
+             sb_index < MIN(sb_row_end * pic_width_in_sb, pcs_ptr->sb_total_count);
+             ++sb_index) {
+            pa_ref_obj_->variance[sb_index] =
+                pcs_ptr->variance[sb_index][ME_TIER_ZERO_PU_64x64];
+            pa_ref_obj_->y_mean[sb_index] = pcs_ptr->y_mean[sb_index][ME_TIER_ZERO_PU_64x64];
         }
-        // Get Empty Results Object
-        eb_get_empty_object(context_ptr->picture_analysis_results_output_fifo_ptr,
-                            &out_results_wrapper_ptr);
 
-        out_results_ptr = (PictureAnalysisResults *)out_results_wrapper_ptr->object_ptr;
-        out_results_ptr->pcs_wrapper_ptr = in_results_ptr->pcs_wrapper_ptr;
+        // Accumulate the segment statistics; the last segment completes the picture statistics
+        eb_block_on_mutex(pcs_ptr->pa_mutex);
+        pcs_ptr->pa_tot_variance += seg_tot_variance;
+        pcs_ptr->pa_sc_count_1 += sc_count_1;
+        pcs_ptr->pa_sc_count_2 += sc_count_2;
+        last_segment = (EbBool)(++pcs_ptr->pa_seg_acc == pcs_ptr->pa_segments_total_count);
+        eb_release_mutex(pcs_ptr->pa_mutex);
+
+        if (!last_segment) return;
+
+        finalize_picture_spatial_statistics(
+            scs_ptr, pcs_ptr, pcs_ptr->pa_tot_variance, sb_total_count);
+
+        if (scs_ptr->static_config.screen_content_mode == 2) // auto detect
+            is_screen_content(pcs_ptr,
+                              pcs_ptr->pa_sc_count_1,
+                              pcs_ptr->pa_sc_count_2,
+                              scs_ptr->seq_header.max_frame_width,
+                              scs_ptr->seq_header.max_frame_height);
+        else // off / on
+            pcs_ptr->sc_content_detected = scs_ptr->static_config.screen_content_mode;
+    }
+    // Get Empty Results Object
+    eb_get_empty_object(context_ptr->picture_analysis_results_output_fifo_ptr,
+                        &out_results_wrapper_ptr);
+
+    out_results_ptr = (PictureAnalysisResults *)out_results_wrapper_ptr->object_ptr;
+    out_results_ptr->pcs_wrapper_ptr = pcs_wrapper_ptr;
+
+    // Post the Full Results Object
+    eb_post_full_object(out_results_wrapper_ptr);
+}
+
+/******************************************************
+ * Picture Analysis Kernel
+ ******************************************************/
+void *picture_analysis_kernel(void *input_ptr) {
+    EbThreadContext *       thread_context_ptr = (EbThreadContext *)input_ptr;
+    PictureAnalysisContext *context_ptr        = (PictureAnalysisContext *)thread_context_ptr->priv;
+    EbObjectWrapper *       in_results_wrapper_ptr;
 
-        // Release the Input Results
-        eb_release_object(in_results_wrapper_ptr);
+    for (;;) {
+        // Get Input Full Object
+        eb_get_full_object(context_ptr->resource_coordination_results_input_fifo_ptr,
+                           &in_results_wrapper_ptr);
 
-        // Post the Full Results Object
-        eb_post_full_object(out_results_wrapper_ptr);
+        picture_analysis_job(thread_context_ptr, in_results_wrapper_ptr);
     }
     return EB_NULL;
 }
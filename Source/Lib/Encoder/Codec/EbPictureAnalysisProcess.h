@@ -14,8 +14,11 @@
  * Extern Function Declaration
  ***************************************/
 EbErrorType picture_analysis_context_ctor(EbThreadContext *  thread_context_ptr,
-                                          const EbEncHandle *enc_handle_ptr, int index);
+                                          const EbEncHandle *enc_handle_ptr, int index,
+                                          int feedback_index);
 
+extern void picture_analysis_job(EbThreadContext *thread_context_ptr,
+                                 EbObjectWrapper *in_results_wrapper_ptr);
 extern void *picture_analysis_kernel(void *input_ptr);
 
 void noise_extract_luma_weak_c(EbPictureBufferDesc *input_picture_ptr,
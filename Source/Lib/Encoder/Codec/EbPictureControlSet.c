@@ -19,6 +19,7 @@
 #include "EbDefinitions.h"
 #include "EbPictureControlSet.h"
 #include "EbPictureBufferDesc.h"
+#include "EbUtility.h"
 
 void *eb_aom_memalign(size_t align, size_t size);
 void  eb_aom_free(void *memblk);
@@ -118,73 +119,58 @@ void picture_control_set_dctor(EbPtr p) {
     uint8_t            depth;
     av1_hash_table_destroy(&obj->hash_table);
     EB_FREE_ALIGNED_ARRAY(obj->tpl_mvs);
-    EB_DELETE(obj->enc_dec_segment_ctrl);
-    EB_DELETE(obj->ep_intra_luma_mode_neighbor_array);
-    EB_DELETE(obj->ep_intra_chroma_mode_neighbor_array);
-    EB_DELETE(obj->ep_mv_neighbor_array);
-    EB_DELETE(obj->ep_skip_flag_neighbor_array);
-    EB_DELETE(obj->ep_mode_type_neighbor_array);
-    EB_DELETE(obj->ep_leaf_depth_neighbor_array);
-    EB_DELETE(obj->ep_luma_recon_neighbor_array);
-    EB_DELETE(obj->ep_cb_recon_neighbor_array);
-    EB_DELETE(obj->ep_cr_recon_neighbor_array);
-    EB_DELETE(obj->ep_luma_dc_sign_level_coeff_neighbor_array);
-    EB_DELETE(obj->ep_cb_dc_sign_level_coeff_neighbor_array);
-    EB_DELETE(obj->ep_cr_dc_sign_level_coeff_neighbor_array);
-    EB_DELETE(obj->ep_partition_context_neighbor_array);
-    EB_DELETE(obj->mode_type_neighbor_array);
-    EB_DELETE(obj->partition_context_neighbor_array);
-    EB_DELETE(obj->skip_flag_neighbor_array);
-    EB_DELETE(obj->skip_coeff_neighbor_array);
-    EB_DELETE(obj->luma_dc_sign_level_coeff_neighbor_array);
-    EB_DELETE(obj->cr_dc_sign_level_coeff_neighbor_array);
-    EB_DELETE(obj->cb_dc_sign_level_coeff_neighbor_array);
-    EB_DELETE(obj->inter_pred_dir_neighbor_array);
-    EB_DELETE(obj->ref_frame_type_neighbor_array);
-    EB_DELETE(obj->intra_luma_mode_neighbor_array);
-    EB_DELETE(obj->txfm_context_array);
-    EB_DELETE(obj->segmentation_id_pred_array);
+    EB_DELETE_PTR_ARRAY(obj->enc_dec_segment_ctrl, obj->enc_dec_segment_ctrl_count);
+    EB_DELETE_PTR_ARRAY(obj->ep_intra_luma_mode_neighbor_array, obj->tile_count);
+    EB_DELETE_PTR_ARRAY(obj->ep_intra_chroma_mode_neighbor_array, obj->tile_count);
+    EB_DELETE_PTR_ARRAY(obj->ep_mv_neighbor_array, obj->tile_count);
+    EB_DELETE_PTR_ARRAY(obj->ep_skip_flag_neighbor_array, obj->tile_count);
+    EB_DELETE_PTR_ARRAY(obj->ep_mode_type_neighbor_array, obj->tile_count);
+    EB_DELETE_PTR_ARRAY(obj->ep_leaf_depth_neighbor_array, obj->tile_count);
+    EB_DELETE_PTR_ARRAY(obj->ep_luma_recon_neighbor_array, obj->tile_count);
+    EB_DELETE_PTR_ARRAY(obj->ep_cb_recon_neighbor_array, obj->tile_count);
+    EB_DELETE_PTR_ARRAY(obj->ep_cr_recon_neighbor_array, obj->tile_count);
+    EB_DELETE_PTR_ARRAY(obj->ep_luma_dc_sign_level_coeff_neighbor_array, obj->tile_count);
+    EB_DELETE_PTR_ARRAY(obj->ep_cb_dc_sign_level_coeff_neighbor_array, obj->tile_count);
+    EB_DELETE_PTR_ARRAY(obj->ep_cr_dc_sign_level_coeff_neighbor_array, obj->tile_count);
+    EB_DELETE_PTR_ARRAY(obj->ep_partition_context_neighbor_array, obj->tile_count);
+    EB_DELETE_PTR_ARRAY(obj->ep_luma_recon_neighbor_array16bit, obj->tile_count);
+    EB_DELETE_PTR_ARRAY(obj->ep_cb_recon_neighbor_array16bit, obj->tile_count);
+    EB_DELETE_PTR_ARRAY(obj->ep_cr_recon_neighbor_array16bit, obj->tile_count);
     EB_DELETE(obj->segmentation_neighbor_map);
-    EB_DELETE(obj->ep_luma_recon_neighbor_array16bit);
-    EB_DELETE(obj->ep_cb_recon_neighbor_array16bit);
-    EB_DELETE(obj->ep_cr_recon_neighbor_array16bit);
-    EB_DELETE(obj->interpolation_type_neighbor_array);
 
     for (depth = 0; depth < NEIGHBOR_ARRAY_TOTAL_COUNT; depth++) {
-        EB_DELETE(obj->md_intra_luma_mode_neighbor_array[depth]);
-        EB_DELETE(obj->md_intra_chroma_mode_neighbor_array[depth]);
-        EB_DELETE(obj->md_mv_neighbor_array[depth]);
-        EB_DELETE(obj->md_skip_flag_neighbor_array[depth]);
-        EB_DELETE(obj->md_mode_type_neighbor_array[depth]);
-        EB_DELETE(obj->md_leaf_depth_neighbor_array[depth]);
-        EB_DELETE(obj->mdleaf_partition_neighbor_array[depth]);
-        if (obj->hbd_mode_decision > EB_8_BIT_MD) {
-            EB_DELETE(obj->md_luma_recon_neighbor_array16bit[depth]);
-            EB_DELETE(obj->md_tx_depth_1_luma_recon_neighbor_array16bit[depth]);
-            EB_DELETE(obj->md_cb_recon_neighbor_array16bit[depth]);
-            EB_DELETE(obj->md_cr_recon_neighbor_array16bit[depth]);
-        }
-        if (obj->hbd_mode_decision != EB_10_BIT_MD) {
-            EB_DELETE(obj->md_luma_recon_neighbor_array[depth]);
-            EB_DELETE(obj->md_tx_depth_1_luma_recon_neighbor_array[depth]);
-            EB_DELETE(obj->md_cb_recon_neighbor_array[depth]);
-            EB_DELETE(obj->md_cr_recon_neighbor_array[depth]);
-        }
-
-        EB_DELETE(obj->md_skip_coeff_neighbor_array[depth]);
-        EB_DELETE(obj->md_luma_dc_sign_level_coeff_neighbor_array[depth]);
-        EB_DELETE(obj->md_tx_depth_1_luma_dc_sign_level_coeff_neighbor_array[depth]);
-        EB_DELETE(obj->md_cr_dc_sign_level_coeff_neighbor_array[depth]);
-        EB_DELETE(obj->md_cb_dc_sign_level_coeff_neighbor_array[depth]);
-        EB_DELETE(obj->md_txfm_context_array[depth]);
-        EB_DELETE(obj->md_inter_pred_dir_neighbor_array[depth]);
-        EB_DELETE(obj->md_ref_frame_type_neighbor_array[depth]);
-        EB_DELETE(obj->md_interpolation_type_neighbor_array[depth]);
+        EB_DELETE_PTR_ARRAY(obj->md_intra_luma_mode_neighbor_array[depth], obj->tile_count);
+        EB_DELETE_PTR_ARRAY(obj->md_intra_chroma_mode_neighbor_array[depth], obj->tile_count);
+        EB_DELETE_PTR_ARRAY(obj->md_mv_neighbor_array[depth], obj->tile_count);
+        EB_DELETE_PTR_ARRAY(obj->md_skip_flag_neighbor_array[depth], obj->tile_count);
+        EB_DELETE_PTR_ARRAY(obj->md_mode_type_neighbor_array[depth], obj->tile_count);
+        EB_DELETE_PTR_ARRAY(obj->md_leaf_depth_neighbor_array[depth], obj->tile_count);
+        EB_DELETE_PTR_ARRAY(obj->mdleaf_partition_neighbor_array[depth], obj->tile_count);
+        EB_DELETE_PTR_ARRAY(obj->md_luma_recon_neighbor_array16bit[depth], obj->tile_count);
+        EB_DELETE_PTR_ARRAY(obj->md_tx_depth_1_luma_recon_neighbor_array16bit[depth],
+                            obj->tile_count);
+        EB_DELETE_PTR_ARRAY(obj->md_cb_recon_neighbor_array16bit[depth], obj->tile_count);
+        EB_DELETE_PTR_ARRAY(obj->md_cr_recon_neighbor_array16bit[depth], obj->tile_count);
+        EB_DELETE_PTR_ARRAY(obj->md_luma_recon_neighbor_array[depth], obj->tile_count);
+        EB_DELETE_PTR_ARRAY(obj->md_tx_depth_1_luma_recon_neighbor_array[depth], obj->tile_count);
+        EB_DELETE_PTR_ARRAY(obj->md_cb_recon_neighbor_array[depth], obj->tile_count);
+        EB_DELETE_PTR_ARRAY(obj->md_cr_recon_neighbor_array[depth], obj->tile_count);
+        EB_DELETE_PTR_ARRAY(obj->md_skip_coeff_neighbor_array[depth], obj->tile_count);
+        EB_DELETE_PTR_ARRAY(obj->md_luma_dc_sign_level_coeff_neighbor_array[depth],
+                            obj->tile_count);
+        EB_DELETE_PTR_ARRAY(obj->md_tx_depth_1_luma_dc_sign_level_coeff_neighbor_array[depth],
+                            obj->tile_count);
+        EB_DELETE_PTR_ARRAY(obj->md_cr_dc_sign_level_coeff_neighbor_array[depth], obj->tile_count);
+        EB_DELETE_PTR_ARRAY(obj->md_cb_dc_sign_level_coeff_neighbor_array[depth], obj->tile_count);
+        EB_DELETE_PTR_ARRAY(obj->md_txfm_context_array[depth], obj->tile_count);
+        EB_DELETE_PTR_ARRAY(obj->md_inter_pred_dir_neighbor_array[depth], obj->tile_count);
+        EB_DELETE_PTR_ARRAY(obj->md_ref_frame_type_neighbor_array[depth], obj->tile_count);
+        EB_DELETE_PTR_ARRAY(obj->md_interpolation_type_neighbor_array[depth], obj->tile_count);
     }
     EB_DELETE_PTR_ARRAY(obj->sb_ptr_array, obj->sb_total_count);
     EB_DELETE(obj->coeff_est_entropy_coder_ptr);
     EB_DELETE(obj->bitstream_ptr);
-    EB_DELETE(obj->entropy_coder_ptr);
+    EB_DELETE_PTR_ARRAY(obj->ec_info, obj->tile_count);
     EB_DELETE(obj->recon_picture32bit_ptr);
     EB_DELETE(obj->recon_picture16bit_ptr);
     EB_DELETE(obj->recon_picture_ptr);
@@ -199,31 +185,16 @@ void picture_control_set_dctor(EbPtr p) {
     EB_FREE_ARRAY(obj->mip);
     EB_FREE_ARRAY(obj->md_rate_estimation_array);
     EB_FREE_ARRAY(obj->ec_ctx_array);
-    EB_FREE_ARRAY(obj->rate_est_array);
-    if (obj->tile_tok[0][0]) EB_FREE_ARRAY(obj->tile_tok[0][0]);
     EB_FREE_ARRAY(obj->mdc_sb_array);
     EB_FREE_ARRAY(obj->qp_array);
+    EB_FREE_ARRAY(obj->sb_lf_completed_in_row);
+    EB_FREE_ARRAY(obj->rest_pad_stripe_done);
     EB_DESTROY_MUTEX(obj->entropy_coding_mutex);
     EB_DESTROY_MUTEX(obj->intra_mutex);
+    EB_DESTROY_MUTEX(obj->dlf_row_mutex);
     EB_DESTROY_MUTEX(obj->cdef_search_mutex);
     EB_DESTROY_MUTEX(obj->rest_search_mutex);
 }
-// Token buffer is only used for palette tokens.
-static INLINE unsigned int get_token_alloc(int mb_rows, int mb_cols, int sb_size_log2,
-                                           const int num_planes) {
-    // Calculate the maximum number of max superblocks in the image.
-    const int shift          = sb_size_log2 - 4;
-    const int sb_size        = 1 << sb_size_log2;
-    const int sb_size_square = sb_size * sb_size;
-    const int sb_rows        = ALIGN_POWER_OF_TWO(mb_rows, shift) >> shift;
-    const int sb_cols        = ALIGN_POWER_OF_TWO(mb_cols, shift) >> shift;
-
-    // One palette token for each pixel. There can be palettes on two planes.
-    const int sb_palette_toks = AOMMIN(2, num_planes) * sb_size_square;
-
-    return sb_rows * sb_cols * sb_palette_toks;
-}
-
 typedef struct InitData {
     NeighborArrayUnit **na_unit_dbl_ptr;
     uint32_t            max_picture_width;
@@ -249,6 +220,161 @@ EbErrorType create_neighbor_array_units(InitData *data, size_t count) {
     return EB_ErrorNone;
 }
 
+static void entropy_tile_info_dctor(EbPtr p) {
+    EntropyTileInfo *obj = (EntropyTileInfo *)p;
+    EB_DELETE(obj->entropy_coder_ptr);
+    EB_DELETE(obj->mode_type_neighbor_array);
+    EB_DELETE(obj->partition_context_neighbor_array);
+    EB_DELETE(obj->skip_flag_neighbor_array);
+    EB_DELETE(obj->skip_coeff_neighbor_array);
+    EB_DELETE(obj->luma_dc_sign_level_coeff_neighbor_array);
+    EB_DELETE(obj->cr_dc_sign_level_coeff_neighbor_array);
+    EB_DELETE(obj->cb_dc_sign_level_coeff_neighbor_array);
+    EB_DELETE(obj->inter_pred_dir_neighbor_array);
+    EB_DELETE(obj->ref_frame_type_neighbor_array);
+    EB_DELETE(obj->intra_luma_mode_neighbor_array);
+    EB_DELETE(obj->txfm_context_array);
+    EB_DELETE(obj->segmentation_id_pred_array);
+    EB_DELETE(obj->interpolation_type_neighbor_array);
+}
+
+/* The bitstream buffer and the neighbor arrays of a tile are sized by the
+ * caller for the largest tile of a picture; the arrays are moved to the tile
+ * before it is coded. */
+static EbErrorType entropy_tile_info_ctor(EntropyTileInfo *obj, uint32_t buffer_size,
+                                          uint32_t tile_width, uint32_t tile_height) {
+    EbErrorType return_error;
+    obj->dctor = entropy_tile_info_dctor;
+
+    EB_NEW(obj->entropy_coder_ptr, entropy_coder_ctor, buffer_size);
+    {
+        InitData data[] = {
+            {
+                &obj->mode_type_neighbor_array,
+                tile_width,
+                tile_height,
+                sizeof(uint8_t),
+                PU_NEIGHBOR_ARRAY_GRANULARITY,
+                PU_NEIGHBOR_ARRAY_GRANULARITY,
+                NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
+            },
+            {
+                &obj->partition_context_neighbor_array,
+                tile_width,
+                tile_height,
+                sizeof(struct PartitionContext),
+                PU_NEIGHBOR_ARRAY_GRANULARITY,
+                PU_NEIGHBOR_ARRAY_GRANULARITY,
+                NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
+            },
+            {
+                &obj->skip_flag_neighbor_array,
+                tile_width,
+                tile_height,
+                sizeof(uint8_t),
+                PU_NEIGHBOR_ARRAY_GRANULARITY,
+                PU_NEIGHBOR_ARRAY_GRANULARITY,
+                NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
+            },
+            {
+                &obj->skip_coeff_neighbor_array,
+                tile_width,
+                tile_height,
+                sizeof(uint8_t),
+                PU_NEIGHBOR_ARRAY_GRANULARITY,
+                PU_NEIGHBOR_ARRAY_GRANULARITY,
+                NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
+            },
+            // for each 4x4
+            {
+                &obj->luma_dc_sign_level_coeff_neighbor_array,
+                tile_width,
+                tile_height,
+                sizeof(uint8_t),
+                PU_NEIGHBOR_ARRAY_GRANULARITY,
+                PU_NEIGHBOR_ARRAY_GRANULARITY,
+                NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
+            },
+            // for each 4x4
+            {
+                &obj->cr_dc_sign_level_coeff_neighbor_array,
+                tile_width,
+                tile_height,
+                sizeof(uint8_t),
+                PU_NEIGHBOR_ARRAY_GRANULARITY,
+                PU_NEIGHBOR_ARRAY_GRANULARITY,
+                NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
+            },
+            // for each 4x4
+            {
+                &obj->cb_dc_sign_level_coeff_neighbor_array,
+                tile_width,
+                tile_height,
+                sizeof(uint8_t),
+                PU_NEIGHBOR_ARRAY_GRANULARITY,
+                PU_NEIGHBOR_ARRAY_GRANULARITY,
+                NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
+            },
+            {
+                &obj->inter_pred_dir_neighbor_array,
+                tile_width,
+                tile_height,
+                sizeof(uint8_t),
+                PU_NEIGHBOR_ARRAY_GRANULARITY,
+                PU_NEIGHBOR_ARRAY_GRANULARITY,
+                NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
+            },
+            {
+                &obj->ref_frame_type_neighbor_array,
+                tile_width,
+                tile_height,
+                sizeof(uint8_t),
+                PU_NEIGHBOR_ARRAY_GRANULARITY,
+                PU_NEIGHBOR_ARRAY_GRANULARITY,
+                NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
+            },
+            {
+                &obj->intra_luma_mode_neighbor_array,
+                tile_width,
+                tile_height,
+                sizeof(uint8_t),
+                PU_NEIGHBOR_ARRAY_GRANULARITY,
+                PU_NEIGHBOR_ARRAY_GRANULARITY,
+                NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
+            },
+            {
+                &obj->txfm_context_array,
+                tile_width,
+                tile_height,
+                sizeof(TXFM_CONTEXT),
+                PU_NEIGHBOR_ARRAY_GRANULARITY,
+                PU_NEIGHBOR_ARRAY_GRANULARITY,
+                NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
+            },
+            {
+                &obj->segmentation_id_pred_array,
+                tile_width,
+                tile_height,
+                sizeof(uint8_t),
+                PU_NEIGHBOR_ARRAY_GRANULARITY,
+                PU_NEIGHBOR_ARRAY_GRANULARITY,
+                NEIGHBOR_ARRAY_UNIT_FULL_MASK,
+            },
+        };
+        return_error = create_neighbor_array_units(data, DIM(data));
+        if (return_error == EB_ErrorInsufficientResources) return EB_ErrorInsufficientResources;
+    }
+    EB_NEW(obj->interpolation_type_neighbor_array,
+           neighbor_array_unit_ctor32,
+           tile_width,
+           tile_height,
+           sizeof(uint32_t),
+           PU_NEIGHBOR_ARRAY_GRANULARITY,
+           PU_NEIGHBOR_ARRAY_GRANULARITY,
+           NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
+    return EB_ErrorNone;
+}
+
 EbErrorType picture_control_set_ctor(PictureControlSet *object_ptr, EbPtr object_init_data_ptr) {
     PictureControlSetInitData *init_data_ptr = (PictureControlSetInitData *)object_init_data_ptr;
 
@@ -351,8 +477,27 @@ EbErrorType picture_control_set_ctor(PictureControlSet *object_ptr, EbPtr object
                eb_picture_buffer_desc_ctor,
                (EbPtr)&coeff_buffer_desc_init_data);
     }
-    // Entropy Coder
-    EB_NEW(object_ptr->entropy_coder_ptr, entropy_coder_ctor, SEGMENT_ENTROPY_BUFFER_SIZE);
+    // Entropy Coder, one per tile
+    object_ptr->tile_count = init_data_ptr->tile_count;
+    EB_ALLOC_PTR_ARRAY(object_ptr->ec_info, object_ptr->tile_count);
+    {
+        // The share of the picture buffer of the largest tile, with a floor for
+        // the small tiles where the coding overhead is relatively larger
+        const uint64_t picture_area = (uint64_t)(picture_sb_width * init_data_ptr->sb_sz) *
+                                      (picture_sb_height * init_data_ptr->sb_sz);
+        const uint64_t tile_area =
+            (uint64_t)init_data_ptr->tile_max_width * init_data_ptr->tile_max_height;
+        const uint32_t tile_buffer_size = (uint32_t)MIN(
+            SEGMENT_ENTROPY_BUFFER_SIZE,
+            MAX(SEGMENT_ENTROPY_BUFFER_SIZE * tile_area / picture_area,
+                TILE_ENTROPY_BUFFER_MIN_SIZE));
+        for (uint16_t tile_idx = 0; tile_idx < object_ptr->tile_count; tile_idx++)
+            EB_NEW(object_ptr->ec_info[tile_idx],
+                   entropy_tile_info_ctor,
+                   tile_buffer_size,
+                   init_data_ptr->tile_max_width,
+                   init_data_ptr->tile_max_height);
+    }
 
     // Packetization process Bitstream
     EB_NEW(object_ptr->bitstream_ptr, bitstream_ctor, PACKETIZATION_PROCESS_BUFFER_SIZE);
@@ -397,17 +542,7 @@ EbErrorType picture_control_set_ctor(PictureControlSet *object_ptr, EbPtr object
     EB_MALLOC_ARRAY(object_ptr->md_rate_estimation_array, 1);
     memset(object_ptr->md_rate_estimation_array, 0, sizeof(MdRateEstimationContext));
     EB_MALLOC_ARRAY(object_ptr->ec_ctx_array, all_sb);
-    EB_MALLOC_ARRAY(object_ptr->rate_est_array, all_sb);
-
-    if (init_data_ptr->cfg_palette) {
-        uint32_t     mi_cols = init_data_ptr->picture_width >> MI_SIZE_LOG2;
-        uint32_t     mi_rows = init_data_ptr->picture_height >> MI_SIZE_LOG2;
-        uint32_t     mb_cols = (mi_cols + 2) >> 2;
-        uint32_t     mb_rows = (mi_rows + 2) >> 2;
-        unsigned int tokens  = get_token_alloc(mb_rows, mb_cols, MAX_SB_SIZE_LOG2, 2);
-        EB_CALLOC_ARRAY(object_ptr->tile_tok[0][0], tokens);
-    } else
-        object_ptr->tile_tok[0][0] = NULL;
+
     // Mode Decision Control config
     EB_MALLOC_ARRAY(object_ptr->mdc_sb_array, object_ptr->sb_total_count);
     object_ptr->qp_array_stride =
@@ -420,530 +555,476 @@ EbErrorType picture_control_set_ctor(PictureControlSet *object_ptr, EbPtr object
     EB_MALLOC_ARRAY(object_ptr->qp_array, object_ptr->qp_array_size);
 
     object_ptr->hbd_mode_decision = init_data_ptr->hbd_mode_decision;
-    // Mode Decision Neighbor Arrays
-    uint8_t depth;
+    // Mode Decision Neighbor Arrays, one set per tile. They cover the largest tile plus an SB,
+    // as the intra edges of the blocks at the right and bottom of a tile extend past it.
+    const uint32_t tile_width  = init_data_ptr->tile_max_width + MAX_SB_SIZE;
+    const uint32_t tile_height = init_data_ptr->tile_max_height + MAX_SB_SIZE;
+    uint8_t        depth;
     for (depth = 0; depth < NEIGHBOR_ARRAY_TOTAL_COUNT; depth++) {
-        InitData data[] = {
-            {&object_ptr->md_intra_luma_mode_neighbor_array[depth],
-             MAX_PICTURE_WIDTH_SIZE,
-             MAX_PICTURE_HEIGHT_SIZE,
-             sizeof(uint8_t),
-             PU_NEIGHBOR_ARRAY_GRANULARITY,
-             PU_NEIGHBOR_ARRAY_GRANULARITY,
-             NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK},
-            {
-                &object_ptr->md_intra_chroma_mode_neighbor_array[depth],
-                MAX_PICTURE_WIDTH_SIZE >> subsampling_x,
-                MAX_PICTURE_HEIGHT_SIZE >> subsampling_y,
-                sizeof(uint8_t),
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
-            },
-            {
-                &object_ptr->md_mv_neighbor_array[depth],
-                MAX_PICTURE_WIDTH_SIZE,
-                MAX_PICTURE_HEIGHT_SIZE,
-                sizeof(MvUnit),
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                NEIGHBOR_ARRAY_UNIT_FULL_MASK,
-            },
-            {
-                &object_ptr->md_skip_flag_neighbor_array[depth],
-                MAX_PICTURE_WIDTH_SIZE,
-                MAX_PICTURE_HEIGHT_SIZE,
-                sizeof(uint8_t),
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
-            },
-            {
-                &object_ptr->md_mode_type_neighbor_array[depth],
-                MAX_PICTURE_WIDTH_SIZE,
-                MAX_PICTURE_HEIGHT_SIZE,
-                sizeof(uint8_t),
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                NEIGHBOR_ARRAY_UNIT_FULL_MASK,
-            },
-            {
-                &object_ptr->md_leaf_depth_neighbor_array[depth],
-                MAX_PICTURE_WIDTH_SIZE,
-                MAX_PICTURE_HEIGHT_SIZE,
-                sizeof(uint8_t),
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
-            },
-            {
-                &object_ptr->mdleaf_partition_neighbor_array[depth],
-                MAX_PICTURE_WIDTH_SIZE,
-                MAX_PICTURE_HEIGHT_SIZE,
-                sizeof(struct PartitionContext),
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
-            },
-            {
-                &object_ptr->md_skip_coeff_neighbor_array[depth],
-                MAX_PICTURE_WIDTH_SIZE,
-                MAX_PICTURE_HEIGHT_SIZE,
-                sizeof(uint8_t),
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
-            },
-            // for each 4x4
-            {
-                &object_ptr->md_luma_dc_sign_level_coeff_neighbor_array[depth],
-                MAX_PICTURE_WIDTH_SIZE,
-                MAX_PICTURE_HEIGHT_SIZE,
-                sizeof(uint8_t),
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
-            },
-            // for each 4x4
-            {
-                &object_ptr->md_tx_depth_1_luma_dc_sign_level_coeff_neighbor_array[depth],
-                MAX_PICTURE_WIDTH_SIZE,
-                MAX_PICTURE_HEIGHT_SIZE,
-                sizeof(uint8_t),
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
-            },
-            // for each 4x4
-            {
-                &object_ptr->md_cr_dc_sign_level_coeff_neighbor_array[depth],
-                MAX_PICTURE_WIDTH_SIZE,
-                MAX_PICTURE_HEIGHT_SIZE,
-                sizeof(uint8_t),
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
-            },
-            // for each 4x4
-            {
-                &object_ptr->md_cb_dc_sign_level_coeff_neighbor_array[depth],
-                MAX_PICTURE_WIDTH_SIZE,
-                MAX_PICTURE_HEIGHT_SIZE,
-                sizeof(uint8_t),
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
-            },
-            {
-                &object_ptr->md_txfm_context_array[depth],
-                MAX_PICTURE_WIDTH_SIZE,
-                MAX_PICTURE_HEIGHT_SIZE,
-                sizeof(TXFM_CONTEXT),
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
-            },
-            {
-                &object_ptr->md_inter_pred_dir_neighbor_array[depth],
-                MAX_PICTURE_WIDTH_SIZE,
-                MAX_PICTURE_HEIGHT_SIZE,
-                sizeof(uint8_t),
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
-            },
-            {
-                &object_ptr->md_ref_frame_type_neighbor_array[depth],
-                MAX_PICTURE_WIDTH_SIZE,
-                MAX_PICTURE_HEIGHT_SIZE,
-                sizeof(uint8_t),
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
-            }};
-        return_error = create_neighbor_array_units(data, DIM(data));
-        if (return_error == EB_ErrorInsufficientResources) return EB_ErrorInsufficientResources;
-        if (init_data_ptr->hbd_mode_decision != EB_10_BIT_MD) {
+        EB_ALLOC_PTR_ARRAY(object_ptr->md_intra_luma_mode_neighbor_array[depth],
+                           object_ptr->tile_count);
+        EB_ALLOC_PTR_ARRAY(object_ptr->md_intra_chroma_mode_neighbor_array[depth],
+                           object_ptr->tile_count);
+        EB_ALLOC_PTR_ARRAY(object_ptr->md_mv_neighbor_array[depth], object_ptr->tile_count);
+        EB_ALLOC_PTR_ARRAY(object_ptr->md_skip_flag_neighbor_array[depth], object_ptr->tile_count);
+        EB_ALLOC_PTR_ARRAY(object_ptr->md_mode_type_neighbor_array[depth], object_ptr->tile_count);
+        EB_ALLOC_PTR_ARRAY(object_ptr->md_leaf_depth_neighbor_array[depth], object_ptr->tile_count);
+        EB_ALLOC_PTR_ARRAY(object_ptr->mdleaf_partition_neighbor_array[depth],
+                           object_ptr->tile_count);
+        EB_ALLOC_PTR_ARRAY(object_ptr->md_skip_coeff_neighbor_array[depth], object_ptr->tile_count);
+        EB_ALLOC_PTR_ARRAY(object_ptr->md_luma_dc_sign_level_coeff_neighbor_array[depth],
+                           object_ptr->tile_count);
+        EB_ALLOC_PTR_ARRAY(object_ptr->md_tx_depth_1_luma_dc_sign_level_coeff_neighbor_array[depth],
+                           object_ptr->tile_count);
+        EB_ALLOC_PTR_ARRAY(object_ptr->md_cr_dc_sign_level_coeff_neighbor_array[depth],
+                           object_ptr->tile_count);
+        EB_ALLOC_PTR_ARRAY(object_ptr->md_cb_dc_sign_level_coeff_neighbor_array[depth],
+                           object_ptr->tile_count);
+        EB_ALLOC_PTR_ARRAY(object_ptr->md_txfm_context_array[depth], object_ptr->tile_count);
+        EB_ALLOC_PTR_ARRAY(object_ptr->md_inter_pred_dir_neighbor_array[depth],
+                           object_ptr->tile_count);
+        EB_ALLOC_PTR_ARRAY(object_ptr->md_ref_frame_type_neighbor_array[depth],
+                           object_ptr->tile_count);
+        EB_ALLOC_PTR_ARRAY(object_ptr->md_luma_recon_neighbor_array[depth], object_ptr->tile_count);
+        EB_ALLOC_PTR_ARRAY(object_ptr->md_tx_depth_1_luma_recon_neighbor_array[depth],
+                           object_ptr->tile_count);
+        EB_ALLOC_PTR_ARRAY(object_ptr->md_cb_recon_neighbor_array[depth], object_ptr->tile_count);
+        EB_ALLOC_PTR_ARRAY(object_ptr->md_cr_recon_neighbor_array[depth], object_ptr->tile_count);
+        EB_ALLOC_PTR_ARRAY(object_ptr->md_luma_recon_neighbor_array16bit[depth],
+                           object_ptr->tile_count);
+        EB_ALLOC_PTR_ARRAY(object_ptr->md_tx_depth_1_luma_recon_neighbor_array16bit[depth],
+                           object_ptr->tile_count);
+        EB_ALLOC_PTR_ARRAY(object_ptr->md_cb_recon_neighbor_array16bit[depth],
+                           object_ptr->tile_count);
+        EB_ALLOC_PTR_ARRAY(object_ptr->md_cr_recon_neighbor_array16bit[depth],
+                           object_ptr->tile_count);
+        EB_ALLOC_PTR_ARRAY(object_ptr->md_interpolation_type_neighbor_array[depth],
+                           object_ptr->tile_count);
+        for (uint16_t tile_idx = 0; tile_idx < object_ptr->tile_count; tile_idx++) {
             InitData data[] = {
+                {&object_ptr->md_intra_luma_mode_neighbor_array[depth][tile_idx],
+                 tile_width,
+                 tile_height,
+                 sizeof(uint8_t),
+                 PU_NEIGHBOR_ARRAY_GRANULARITY,
+                 PU_NEIGHBOR_ARRAY_GRANULARITY,
+                 NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK},
+                {
+                    &object_ptr->md_intra_chroma_mode_neighbor_array[depth][tile_idx],
+                    tile_width >> subsampling_x,
+                    tile_height >> subsampling_y,
+                    sizeof(uint8_t),
+                    PU_NEIGHBOR_ARRAY_GRANULARITY,
+                    PU_NEIGHBOR_ARRAY_GRANULARITY,
+                    NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
+                },
+                {
+                    &object_ptr->md_mv_neighbor_array[depth][tile_idx],
+                    tile_width,
+                    tile_height,
+                    sizeof(MvUnit),
+                    PU_NEIGHBOR_ARRAY_GRANULARITY,
+                    PU_NEIGHBOR_ARRAY_GRANULARITY,
+                    NEIGHBOR_ARRAY_UNIT_FULL_MASK,
+                },
+                {
+                    &object_ptr->md_skip_flag_neighbor_array[depth][tile_idx],
+                    tile_width,
+                    tile_height,
+                    sizeof(uint8_t),
+                    PU_NEIGHBOR_ARRAY_GRANULARITY,
+                    PU_NEIGHBOR_ARRAY_GRANULARITY,
+                    NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
+                },
+                {
+                    &object_ptr->md_mode_type_neighbor_array[depth][tile_idx],
+                    tile_width,
+                    tile_height,
+                    sizeof(uint8_t),
+                    PU_NEIGHBOR_ARRAY_GRANULARITY,
+                    PU_NEIGHBOR_ARRAY_GRANULARITY,
+                    NEIGHBOR_ARRAY_UNIT_FULL_MASK,
+                },
+                {
+                    &object_ptr->md_leaf_depth_neighbor_array[depth][tile_idx],
+                    tile_width,
+                    tile_height,
+                    sizeof(uint8_t),
+                    PU_NEIGHBOR_ARRAY_GRANULARITY,
+                    PU_NEIGHBOR_ARRAY_GRANULARITY,
+                    NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
+                },
+                {
+                    &object_ptr->mdleaf_partition_neighbor_array[depth][tile_idx],
+                    tile_width,
+                    tile_height,
+                    sizeof(struct PartitionContext),
+                    PU_NEIGHBOR_ARRAY_GRANULARITY,
+                    PU_NEIGHBOR_ARRAY_GRANULARITY,
+                    NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
+                },
+                {
+                    &object_ptr->md_skip_coeff_neighbor_array[depth][tile_idx],
+                    tile_width,
+                    tile_height,
+                    sizeof(uint8_t),
+                    PU_NEIGHBOR_ARRAY_GRANULARITY,
+                    PU_NEIGHBOR_ARRAY_GRANULARITY,
+                    NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
+                },
+                // for each 4x4
+                {
+                    &object_ptr->md_luma_dc_sign_level_coeff_neighbor_array[depth][tile_idx],
+                    tile_width,
+                    tile_height,
+                    sizeof(uint8_t),
+                    PU_NEIGHBOR_ARRAY_GRANULARITY,
+                    PU_NEIGHBOR_ARRAY_GRANULARITY,
+                    NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
+                },
+                // for each 4x4
+                {
+                    &object_ptr
+                         ->md_tx_depth_1_luma_dc_sign_level_coeff_neighbor_array[depth][tile_idx],
+                    tile_width,
+                    tile_height,
+                    sizeof(uint8_t),
+                    PU_NEIGHBOR_ARRAY_GRANULARITY,
+                    PU_NEIGHBOR_ARRAY_GRANULARITY,
+                    NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
+                },
+                // for each 4x4
+                {
+                    &object_ptr->md_cr_dc_sign_level_coeff_neighbor_array[depth][tile_idx],
+                    tile_width,
+                    tile_height,
+                    sizeof(uint8_t),
+                    PU_NEIGHBOR_ARRAY_GRANULARITY,
+                    PU_NEIGHBOR_ARRAY_GRANULARITY,
+                    NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
+                },
+                // for each 4x4
+                {
+                    &object_ptr->md_cb_dc_sign_level_coeff_neighbor_array[depth][tile_idx],
+                    tile_width,
+                    tile_height,
+                    sizeof(uint8_t),
+                    PU_NEIGHBOR_ARRAY_GRANULARITY,
+                    PU_NEIGHBOR_ARRAY_GRANULARITY,
+                    NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
+                },
+                {
+                    &object_ptr->md_txfm_context_array[depth][tile_idx],
+                    tile_width,
+                    tile_height,
+                    sizeof(TXFM_CONTEXT),
+                    PU_NEIGHBOR_ARRAY_GRANULARITY,
+                    PU_NEIGHBOR_ARRAY_GRANULARITY,
+                    NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
+                },
+                {
+                    &object_ptr->md_inter_pred_dir_neighbor_array[depth][tile_idx],
+                    tile_width,
+                    tile_height,
+                    sizeof(uint8_t),
+                    PU_NEIGHBOR_ARRAY_GRANULARITY,
+                    PU_NEIGHBOR_ARRAY_GRANULARITY,
+                    NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
+                },
+                {
+                    &object_ptr->md_ref_frame_type_neighbor_array[depth][tile_idx],
+                    tile_width,
+                    tile_height,
+                    sizeof(uint8_t),
+                    PU_NEIGHBOR_ARRAY_GRANULARITY,
+                    PU_NEIGHBOR_ARRAY_GRANULARITY,
+                    NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
+                }};
+            return_error = create_neighbor_array_units(data, DIM(data));
+            if (return_error == EB_ErrorInsufficientResources) return EB_ErrorInsufficientResources;
+            if (init_data_ptr->hbd_mode_decision != EB_10_BIT_MD) {
+                InitData data[] = {
+
+                    {
+                        &object_ptr->md_luma_recon_neighbor_array[depth][tile_idx],
+                        tile_width,
+                        tile_height,
+                        sizeof(uint8_t),
+                        SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
+                        SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
+                        NEIGHBOR_ARRAY_UNIT_FULL_MASK,
+                    },
+                    {
+                        &object_ptr->md_tx_depth_1_luma_recon_neighbor_array[depth][tile_idx],
+                        tile_width,
+                        tile_height,
+                        sizeof(uint8_t),
+                        SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
+                        SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
+                        NEIGHBOR_ARRAY_UNIT_FULL_MASK,
+                    },
+                    {
+                        &object_ptr->md_cb_recon_neighbor_array[depth][tile_idx],
+                        tile_width >> subsampling_x,
+                        tile_height >> subsampling_y,
+                        sizeof(uint8_t),
+                        SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
+                        SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
+                        NEIGHBOR_ARRAY_UNIT_FULL_MASK,
+                    },
+                    {
+                        &object_ptr->md_cr_recon_neighbor_array[depth][tile_idx],
+                        tile_width >> subsampling_x,
+                        tile_height >> subsampling_y,
+                        sizeof(uint8_t),
+                        SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
+                        SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
+                        NEIGHBOR_ARRAY_UNIT_FULL_MASK,
+                    }
+
+                };
+                return_error = create_neighbor_array_units(data, DIM(data));
+                if (return_error == EB_ErrorInsufficientResources)
+                    return EB_ErrorInsufficientResources;
+            }
+            if (init_data_ptr->hbd_mode_decision > EB_8_BIT_MD) {
+                InitData data[] = {
+                    {
+                        &object_ptr->md_luma_recon_neighbor_array16bit[depth][tile_idx],
+                        tile_width,
+                        tile_height,
+                        sizeof(uint16_t),
+                        SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
+                        SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
+                        NEIGHBOR_ARRAY_UNIT_FULL_MASK,
+                    },
+                    {
+                        &object_ptr->md_tx_depth_1_luma_recon_neighbor_array16bit[depth][tile_idx],
+                        tile_width,
+                        tile_height,
+                        sizeof(uint16_t),
+                        SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
+                        SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
+                        NEIGHBOR_ARRAY_UNIT_FULL_MASK,
+                    },
+                    {
+                        &object_ptr->md_cb_recon_neighbor_array16bit[depth][tile_idx],
+                        tile_width >> subsampling_x,
+                        tile_height >> subsampling_y,
+                        sizeof(uint16_t),
+                        SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
+                        SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
+                        NEIGHBOR_ARRAY_UNIT_FULL_MASK,
+                    },
+                    {
+                        &object_ptr->md_cr_recon_neighbor_array16bit[depth][tile_idx],
+                        tile_width >> subsampling_x,
+                        tile_height >> subsampling_y,
+                        sizeof(uint16_t),
+                        SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
+                        SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
+                        NEIGHBOR_ARRAY_UNIT_FULL_MASK,
+                    },
+                };
+                return_error = create_neighbor_array_units(data, DIM(data));
+                if (return_error == EB_ErrorInsufficientResources)
+                    return EB_ErrorInsufficientResources;
+            }
 
+            EB_NEW(object_ptr->md_interpolation_type_neighbor_array[depth][tile_idx],
+                   neighbor_array_unit_ctor32,
+                   tile_width,
+                   tile_height,
+                   sizeof(uint32_t),
+                   PU_NEIGHBOR_ARRAY_GRANULARITY,
+                   PU_NEIGHBOR_ARRAY_GRANULARITY,
+                   NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
+        }
+    }
+    // Encode Pass Neighbor Arrays, one set per tile as well
+    EB_ALLOC_PTR_ARRAY(object_ptr->ep_intra_luma_mode_neighbor_array, object_ptr->tile_count);
+    EB_ALLOC_PTR_ARRAY(object_ptr->ep_intra_chroma_mode_neighbor_array, object_ptr->tile_count);
+    EB_ALLOC_PTR_ARRAY(object_ptr->ep_mv_neighbor_array, object_ptr->tile_count);
+    EB_ALLOC_PTR_ARRAY(object_ptr->ep_skip_flag_neighbor_array, object_ptr->tile_count);
+    EB_ALLOC_PTR_ARRAY(object_ptr->ep_mode_type_neighbor_array, object_ptr->tile_count);
+    EB_ALLOC_PTR_ARRAY(object_ptr->ep_leaf_depth_neighbor_array, object_ptr->tile_count);
+    EB_ALLOC_PTR_ARRAY(object_ptr->ep_luma_recon_neighbor_array, object_ptr->tile_count);
+    EB_ALLOC_PTR_ARRAY(object_ptr->ep_cb_recon_neighbor_array, object_ptr->tile_count);
+    EB_ALLOC_PTR_ARRAY(object_ptr->ep_cr_recon_neighbor_array, object_ptr->tile_count);
+    EB_ALLOC_PTR_ARRAY(object_ptr->ep_luma_dc_sign_level_coeff_neighbor_array,
+                       object_ptr->tile_count);
+    EB_ALLOC_PTR_ARRAY(object_ptr->ep_cb_dc_sign_level_coeff_neighbor_array,
+                       object_ptr->tile_count);
+    EB_ALLOC_PTR_ARRAY(object_ptr->ep_cr_dc_sign_level_coeff_neighbor_array,
+                       object_ptr->tile_count);
+    EB_ALLOC_PTR_ARRAY(object_ptr->ep_partition_context_neighbor_array, object_ptr->tile_count);
+    if (is_16bit) {
+        EB_ALLOC_PTR_ARRAY(object_ptr->ep_luma_recon_neighbor_array16bit, object_ptr->tile_count);
+        EB_ALLOC_PTR_ARRAY(object_ptr->ep_cb_recon_neighbor_array16bit, object_ptr->tile_count);
+        EB_ALLOC_PTR_ARRAY(object_ptr->ep_cr_recon_neighbor_array16bit, object_ptr->tile_count);
+    }
+    for (uint16_t tile_idx = 0; tile_idx < object_ptr->tile_count; tile_idx++) {
+        {
+            InitData data[] = {
                 {
-                    &object_ptr->md_luma_recon_neighbor_array[depth],
-                    MAX_PICTURE_WIDTH_SIZE,
-                    MAX_PICTURE_HEIGHT_SIZE,
+                    &object_ptr->ep_intra_luma_mode_neighbor_array[tile_idx],
+                    tile_width,
+                    tile_height,
                     sizeof(uint8_t),
-                    SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
-                    SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
+                    PU_NEIGHBOR_ARRAY_GRANULARITY,
+                    PU_NEIGHBOR_ARRAY_GRANULARITY,
+                    NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
+                },
+                {
+                    &object_ptr->ep_intra_chroma_mode_neighbor_array[tile_idx],
+                    tile_width >> subsampling_x,
+                    tile_height >> subsampling_y,
+                    sizeof(uint8_t),
+                    PU_NEIGHBOR_ARRAY_GRANULARITY,
+                    PU_NEIGHBOR_ARRAY_GRANULARITY,
+                    NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
+                },
+                {
+                    &object_ptr->ep_mv_neighbor_array[tile_idx],
+                    tile_width,
+                    tile_height,
+                    sizeof(MvUnit),
+                    PU_NEIGHBOR_ARRAY_GRANULARITY,
+                    PU_NEIGHBOR_ARRAY_GRANULARITY,
+                    NEIGHBOR_ARRAY_UNIT_FULL_MASK,
+                },
+                {
+                    &object_ptr->ep_skip_flag_neighbor_array[tile_idx],
+                    tile_width,
+                    tile_height,
+                    sizeof(uint8_t),
+                    CU_NEIGHBOR_ARRAY_GRANULARITY,
+                    CU_NEIGHBOR_ARRAY_GRANULARITY,
+                    NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
+                },
+                {
+                    &object_ptr->ep_mode_type_neighbor_array[tile_idx],
+                    tile_width,
+                    tile_height,
+                    sizeof(uint8_t),
+                    PU_NEIGHBOR_ARRAY_GRANULARITY,
+                    PU_NEIGHBOR_ARRAY_GRANULARITY,
                     NEIGHBOR_ARRAY_UNIT_FULL_MASK,
                 },
                 {
-                    &object_ptr->md_tx_depth_1_luma_recon_neighbor_array[depth],
-                    MAX_PICTURE_WIDTH_SIZE,
-                    MAX_PICTURE_HEIGHT_SIZE,
+                    &object_ptr->ep_leaf_depth_neighbor_array[tile_idx],
+                    tile_width,
+                    tile_height,
+                    sizeof(uint8_t),
+                    PU_NEIGHBOR_ARRAY_GRANULARITY,
+                    PU_NEIGHBOR_ARRAY_GRANULARITY,
+                    NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
+                },
+                {
+                    &object_ptr->ep_luma_recon_neighbor_array[tile_idx],
+                    tile_width,
+                    tile_height,
                     sizeof(uint8_t),
                     SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
                     SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
                     NEIGHBOR_ARRAY_UNIT_FULL_MASK,
                 },
                 {
-                    &object_ptr->md_cb_recon_neighbor_array[depth],
-                    MAX_PICTURE_WIDTH_SIZE >> subsampling_x,
-                    MAX_PICTURE_HEIGHT_SIZE >> subsampling_y,
+                    &object_ptr->ep_cb_recon_neighbor_array[tile_idx],
+                    tile_width >> subsampling_x,
+                    tile_height >> subsampling_y,
                     sizeof(uint8_t),
                     SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
                     SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
                     NEIGHBOR_ARRAY_UNIT_FULL_MASK,
                 },
                 {
-                    &object_ptr->md_cr_recon_neighbor_array[depth],
-                    MAX_PICTURE_WIDTH_SIZE >> subsampling_x,
-                    MAX_PICTURE_HEIGHT_SIZE >> subsampling_y,
+                    &object_ptr->ep_cr_recon_neighbor_array[tile_idx],
+                    tile_width >> subsampling_x,
+                    tile_height >> subsampling_y,
                     sizeof(uint8_t),
                     SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
                     SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
                     NEIGHBOR_ARRAY_UNIT_FULL_MASK,
-                }
-
+                },
+                // for each 4x4
+                {
+                    &object_ptr->ep_luma_dc_sign_level_coeff_neighbor_array[tile_idx],
+                    tile_width,
+                    tile_height,
+                    sizeof(uint8_t),
+                    PU_NEIGHBOR_ARRAY_GRANULARITY,
+                    PU_NEIGHBOR_ARRAY_GRANULARITY,
+                    NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
+                },
+                // for each 4x4
+                {
+                    &object_ptr->ep_cb_dc_sign_level_coeff_neighbor_array[tile_idx],
+                    tile_width,
+                    tile_height,
+                    sizeof(uint8_t),
+                    PU_NEIGHBOR_ARRAY_GRANULARITY,
+                    PU_NEIGHBOR_ARRAY_GRANULARITY,
+                    NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
+                },
+                // for each 4x4
+                {
+                    &object_ptr->ep_cr_dc_sign_level_coeff_neighbor_array[tile_idx],
+                    tile_width,
+                    tile_height,
+                    sizeof(uint8_t),
+                    PU_NEIGHBOR_ARRAY_GRANULARITY,
+                    PU_NEIGHBOR_ARRAY_GRANULARITY,
+                    NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
+                },
+                // Encode pass partition neighbor array
+                {
+                    &object_ptr->ep_partition_context_neighbor_array[tile_idx],
+                    tile_width,
+                    tile_height,
+                    sizeof(struct PartitionContext),
+                    PU_NEIGHBOR_ARRAY_GRANULARITY,
+                    PU_NEIGHBOR_ARRAY_GRANULARITY,
+                    NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
+                },
             };
             return_error = create_neighbor_array_units(data, DIM(data));
             if (return_error == EB_ErrorInsufficientResources) return EB_ErrorInsufficientResources;
         }
-        if (init_data_ptr->hbd_mode_decision > EB_8_BIT_MD) {
-            InitData data[] = {{
-                                   &object_ptr->md_luma_recon_neighbor_array16bit[depth],
-                                   MAX_PICTURE_WIDTH_SIZE,
-                                   MAX_PICTURE_HEIGHT_SIZE,
-                                   sizeof(uint16_t),
-                                   SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
-                                   SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
-                                   NEIGHBOR_ARRAY_UNIT_FULL_MASK,
-                               },
-                               {
-                                   &object_ptr->md_tx_depth_1_luma_recon_neighbor_array16bit[depth],
-                                   MAX_PICTURE_WIDTH_SIZE,
-                                   MAX_PICTURE_HEIGHT_SIZE,
-                                   sizeof(uint16_t),
-                                   SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
-                                   SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
-                                   NEIGHBOR_ARRAY_UNIT_FULL_MASK,
-                               },
-                               {
-                                   &object_ptr->md_cb_recon_neighbor_array16bit[depth],
-                                   MAX_PICTURE_WIDTH_SIZE >> subsampling_x,
-                                   MAX_PICTURE_HEIGHT_SIZE >> subsampling_y,
-                                   sizeof(uint16_t),
-                                   SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
-                                   SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
-                                   NEIGHBOR_ARRAY_UNIT_FULL_MASK,
-                               },
-                               {
-                                   &object_ptr->md_cr_recon_neighbor_array16bit[depth],
-                                   MAX_PICTURE_WIDTH_SIZE >> subsampling_x,
-                                   MAX_PICTURE_HEIGHT_SIZE >> subsampling_y,
-                                   sizeof(uint16_t),
-                                   SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
-                                   SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
-                                   NEIGHBOR_ARRAY_UNIT_FULL_MASK,
-                               }};
-            return_error    = create_neighbor_array_units(data, DIM(data));
+        if (is_16bit) {
+            InitData data[] = {
+                {
+                    &object_ptr->ep_luma_recon_neighbor_array16bit[tile_idx],
+                    tile_width,
+                    tile_height,
+                    sizeof(uint16_t),
+                    SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
+                    SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
+                    NEIGHBOR_ARRAY_UNIT_FULL_MASK,
+                },
+                {
+                    &object_ptr->ep_cb_recon_neighbor_array16bit[tile_idx],
+                    tile_width >> subsampling_x,
+                    tile_height >> subsampling_y,
+                    sizeof(uint16_t),
+                    SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
+                    SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
+                    NEIGHBOR_ARRAY_UNIT_FULL_MASK,
+                },
+                {
+                    &object_ptr->ep_cr_recon_neighbor_array16bit[tile_idx],
+                    tile_width >> subsampling_x,
+                    tile_height >> subsampling_y,
+                    sizeof(uint16_t),
+                    SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
+                    SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
+                    NEIGHBOR_ARRAY_UNIT_FULL_MASK,
+                },
+            };
+            return_error = create_neighbor_array_units(data, DIM(data));
             if (return_error == EB_ErrorInsufficientResources) return EB_ErrorInsufficientResources;
         }
-
-        EB_NEW(object_ptr->md_interpolation_type_neighbor_array[depth],
-               neighbor_array_unit_ctor32,
-               MAX_PICTURE_WIDTH_SIZE,
-               MAX_PICTURE_HEIGHT_SIZE,
-               sizeof(uint32_t),
-               PU_NEIGHBOR_ARRAY_GRANULARITY,
-               PU_NEIGHBOR_ARRAY_GRANULARITY,
-               NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
     }
-    {
-        InitData data[] = {
-            {
-                &object_ptr->ep_intra_luma_mode_neighbor_array,
-                MAX_PICTURE_WIDTH_SIZE,
-                MAX_PICTURE_HEIGHT_SIZE,
-                sizeof(uint8_t),
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
-            },
-            // Encode Pass Neighbor Arrays
-            {
-                &object_ptr->ep_intra_chroma_mode_neighbor_array,
-                MAX_PICTURE_WIDTH_SIZE >> subsampling_x,
-                MAX_PICTURE_HEIGHT_SIZE >> subsampling_y,
-                sizeof(uint8_t),
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
-            },
-            {
-                &object_ptr->ep_mv_neighbor_array,
-                MAX_PICTURE_WIDTH_SIZE,
-                MAX_PICTURE_HEIGHT_SIZE,
-                sizeof(MvUnit),
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                NEIGHBOR_ARRAY_UNIT_FULL_MASK,
-            },
-            {
-                &object_ptr->ep_skip_flag_neighbor_array,
-                MAX_PICTURE_WIDTH_SIZE,
-                MAX_PICTURE_HEIGHT_SIZE,
-                sizeof(uint8_t),
-                CU_NEIGHBOR_ARRAY_GRANULARITY,
-                CU_NEIGHBOR_ARRAY_GRANULARITY,
-                NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
-            },
-            {
-                &object_ptr->ep_mode_type_neighbor_array,
-                MAX_PICTURE_WIDTH_SIZE,
-                MAX_PICTURE_HEIGHT_SIZE,
-                sizeof(uint8_t),
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                NEIGHBOR_ARRAY_UNIT_FULL_MASK,
-            },
-            {
-                &object_ptr->ep_leaf_depth_neighbor_array,
-                MAX_PICTURE_WIDTH_SIZE,
-                MAX_PICTURE_HEIGHT_SIZE,
-                sizeof(uint8_t),
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
-            },
-            {
-                &object_ptr->ep_luma_recon_neighbor_array,
-                MAX_PICTURE_WIDTH_SIZE,
-                MAX_PICTURE_HEIGHT_SIZE,
-                sizeof(uint8_t),
-                SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
-                SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
-                NEIGHBOR_ARRAY_UNIT_FULL_MASK,
-            },
-            {
-                &object_ptr->ep_cb_recon_neighbor_array,
-                MAX_PICTURE_WIDTH_SIZE >> subsampling_x,
-                MAX_PICTURE_HEIGHT_SIZE >> subsampling_y,
-                sizeof(uint8_t),
-                SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
-                SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
-                NEIGHBOR_ARRAY_UNIT_FULL_MASK,
-            },
-            {
-                &object_ptr->ep_cr_recon_neighbor_array,
-                MAX_PICTURE_WIDTH_SIZE >> subsampling_x,
-                MAX_PICTURE_HEIGHT_SIZE >> subsampling_y,
-                sizeof(uint8_t),
-                SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
-                SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
-                NEIGHBOR_ARRAY_UNIT_FULL_MASK,
-            },
-            // for each 4x4
-            {
-                &object_ptr->ep_luma_dc_sign_level_coeff_neighbor_array,
-                MAX_PICTURE_WIDTH_SIZE,
-                MAX_PICTURE_HEIGHT_SIZE,
-                sizeof(uint8_t),
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
-            },
-            // for each 4x4
-            {
-                &object_ptr->ep_cb_dc_sign_level_coeff_neighbor_array,
-                MAX_PICTURE_WIDTH_SIZE,
-                MAX_PICTURE_HEIGHT_SIZE,
-                sizeof(uint8_t),
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
-            },
-            // for each 4x4
-            {
-                &object_ptr->ep_cr_dc_sign_level_coeff_neighbor_array,
-                MAX_PICTURE_WIDTH_SIZE,
-                MAX_PICTURE_HEIGHT_SIZE,
-                sizeof(uint8_t),
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
-            },
-            // Encode pass partition neighbor array
-            {
-                &object_ptr->ep_partition_context_neighbor_array,
-                MAX_PICTURE_WIDTH_SIZE,
-                MAX_PICTURE_HEIGHT_SIZE,
-                sizeof(struct PartitionContext),
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
-            },
-
-            // Entropy Coding Neighbor Arrays
-            {
-                &object_ptr->mode_type_neighbor_array,
-                MAX_PICTURE_WIDTH_SIZE,
-                MAX_PICTURE_HEIGHT_SIZE,
-                sizeof(uint8_t),
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
-            },
-            {
-                &object_ptr->partition_context_neighbor_array,
-                MAX_PICTURE_WIDTH_SIZE,
-                MAX_PICTURE_HEIGHT_SIZE,
-                sizeof(struct PartitionContext),
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
-            },
-            {
-                &object_ptr->skip_flag_neighbor_array,
-                MAX_PICTURE_WIDTH_SIZE,
-                MAX_PICTURE_HEIGHT_SIZE,
-                sizeof(uint8_t),
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
-            },
-            {
-                &object_ptr->skip_coeff_neighbor_array,
-                MAX_PICTURE_WIDTH_SIZE,
-                MAX_PICTURE_HEIGHT_SIZE,
-                sizeof(uint8_t),
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
-            },
-            // for each 4x4
-            {
-                &object_ptr->luma_dc_sign_level_coeff_neighbor_array,
-                MAX_PICTURE_WIDTH_SIZE,
-                MAX_PICTURE_HEIGHT_SIZE,
-                sizeof(uint8_t),
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
-            },
-            // for each 4x4
-            {
-                &object_ptr->cr_dc_sign_level_coeff_neighbor_array,
-                MAX_PICTURE_WIDTH_SIZE,
-                MAX_PICTURE_HEIGHT_SIZE,
-                sizeof(uint8_t),
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
-            },
-            // for each 4x4
-            {
-                &object_ptr->cb_dc_sign_level_coeff_neighbor_array,
-                MAX_PICTURE_WIDTH_SIZE,
-                MAX_PICTURE_HEIGHT_SIZE,
-                sizeof(uint8_t),
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
-            },
-            {
-                &object_ptr->inter_pred_dir_neighbor_array,
-                MAX_PICTURE_WIDTH_SIZE,
-                MAX_PICTURE_HEIGHT_SIZE,
-                sizeof(uint8_t),
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
-            },
-            {
-                &object_ptr->ref_frame_type_neighbor_array,
-                MAX_PICTURE_WIDTH_SIZE,
-                MAX_PICTURE_HEIGHT_SIZE,
-                sizeof(uint8_t),
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
-            },
-            {
-                &object_ptr->intra_luma_mode_neighbor_array,
-                MAX_PICTURE_WIDTH_SIZE,
-                MAX_PICTURE_HEIGHT_SIZE,
-                sizeof(uint8_t),
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
-            },
-            {
-                &object_ptr->txfm_context_array,
-                MAX_PICTURE_WIDTH_SIZE,
-                MAX_PICTURE_HEIGHT_SIZE,
-                sizeof(TXFM_CONTEXT),
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
-            },
-            {
-                &object_ptr->segmentation_id_pred_array,
-                MAX_PICTURE_WIDTH_SIZE,
-                MAX_PICTURE_HEIGHT_SIZE,
-                sizeof(uint8_t),
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                PU_NEIGHBOR_ARRAY_GRANULARITY,
-                NEIGHBOR_ARRAY_UNIT_FULL_MASK,
-            },
-        };
-        return_error = create_neighbor_array_units(data, DIM(data));
-        if (return_error == EB_ErrorInsufficientResources) return EB_ErrorInsufficientResources;
-    }
-    if (is_16bit) {
-        InitData data[] = {
-            {
-                &object_ptr->ep_luma_recon_neighbor_array16bit,
-                MAX_PICTURE_WIDTH_SIZE,
-                MAX_PICTURE_HEIGHT_SIZE,
-                sizeof(uint16_t),
-                SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
-                SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
-                NEIGHBOR_ARRAY_UNIT_FULL_MASK,
-            },
-            {
-                &object_ptr->ep_cb_recon_neighbor_array16bit,
-                MAX_PICTURE_WIDTH_SIZE >> subsampling_x,
-                MAX_PICTURE_HEIGHT_SIZE >> subsampling_y,
-                sizeof(uint16_t),
-                SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
-                SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
-                NEIGHBOR_ARRAY_UNIT_FULL_MASK,
-            },
-            {
-                &object_ptr->ep_cr_recon_neighbor_array16bit,
-                MAX_PICTURE_WIDTH_SIZE >> subsampling_x,
-                MAX_PICTURE_HEIGHT_SIZE >> subsampling_y,
-                sizeof(uint16_t),
-                SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
-                SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
-                NEIGHBOR_ARRAY_UNIT_FULL_MASK,
-            },
-        };
-        return_error = create_neighbor_array_units(data, DIM(data));
-        if (return_error == EB_ErrorInsufficientResources) return EB_ErrorInsufficientResources;
-    } else {
-        object_ptr->ep_luma_recon_neighbor_array16bit = 0;
-        object_ptr->ep_cb_recon_neighbor_array16bit   = 0;
-        object_ptr->ep_cr_recon_neighbor_array16bit   = 0;
-    }
-    EB_NEW(object_ptr->interpolation_type_neighbor_array,
-           neighbor_array_unit_ctor32,
-           MAX_PICTURE_WIDTH_SIZE,
-           MAX_PICTURE_HEIGHT_SIZE,
-           sizeof(uint32_t),
-           PU_NEIGHBOR_ARRAY_GRANULARITY,
-           PU_NEIGHBOR_ARRAY_GRANULARITY,
-           NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
-
     //Segmentation neighbor arrays
     EB_NEW(object_ptr->segmentation_neighbor_map,
            segmentation_map_ctor,
@@ -962,15 +1043,22 @@ EbErrorType picture_control_set_ctor(PictureControlSet *object_ptr, EbPtr object
     //object_ptr->total_num_bits = 0;
 
     // Segments
-    EB_NEW(object_ptr->enc_dec_segment_ctrl,
-           enc_dec_segments_ctor,
-           init_data_ptr->enc_dec_segment_col,
-           init_data_ptr->enc_dec_segment_row);
+    object_ptr->enc_dec_segment_ctrl_count = init_data_ptr->enc_dec_unit_count;
+    EB_ALLOC_PTR_ARRAY(object_ptr->enc_dec_segment_ctrl, object_ptr->enc_dec_segment_ctrl_count);
+    for (uint16_t unit_idx = 0; unit_idx < object_ptr->enc_dec_segment_ctrl_count; unit_idx++)
+        EB_NEW(object_ptr->enc_dec_segment_ctrl[unit_idx],
+               enc_dec_segments_ctor,
+               init_data_ptr->enc_dec_segment_col,
+               init_data_ptr->enc_dec_segment_row);
     // Entropy Rows
     EB_CREATE_MUTEX(object_ptr->entropy_coding_mutex);
 
     EB_CREATE_MUTEX(object_ptr->intra_mutex);
 
+    // DLF SB rows
+    EB_MALLOC_ARRAY(object_ptr->sb_lf_completed_in_row, picture_sb_h);
+    EB_CREATE_MUTEX(object_ptr->dlf_row_mutex);
+
     EB_CREATE_MUTEX(object_ptr->cdef_search_mutex);
 
     //object_ptr->mse_seg[0] = (uint64_t(*)[64])eb_aom_malloc(sizeof(**object_ptr->mse_seg) *  picture_sb_width * picture_sb_height);
@@ -980,6 +1068,9 @@ EbErrorType picture_control_set_ctor(PictureControlSet *object_ptr, EbPtr object
     EB_MALLOC_ARRAY(object_ptr->mse_seg[1], picture_sb_width * picture_sb_height);
 
     EB_CREATE_MUTEX(object_ptr->rest_search_mutex);
+    EB_MALLOC_ARRAY(object_ptr->rest_pad_stripe_done,
+                    (init_data_ptr->picture_height + REST_PAD_STRIPE_HEIGHT - 1) /
+                        REST_PAD_STRIPE_HEIGHT);
 
     //the granularity is 4x4
     EB_MALLOC_ARRAY(object_ptr->mi_grid_base,
@@ -1098,6 +1189,7 @@ static void picture_parent_control_set_dctor(EbPtr p) {
     EB_DESTROY_MUTEX(obj->rc_distortion_histogram_mutex);
     EB_DESTROY_SEMAPHORE(obj->temp_filt_done_semaphore);
     EB_DESTROY_MUTEX(obj->temp_filt_mutex);
+    EB_DESTROY_MUTEX(obj->pa_mutex);
     EB_DESTROY_MUTEX(obj->debug_mutex);
 }
 EbErrorType picture_parent_control_set_ctor(PictureParentControlSet *object_ptr,
@@ -1218,6 +1310,7 @@ EbErrorType picture_parent_control_set_ctor(PictureParentControlSet *object_ptr,
     EB_MALLOC_ARRAY(object_ptr->sb_depth_mode_array, object_ptr->sb_total_count);
     EB_CREATE_SEMAPHORE(object_ptr->temp_filt_done_semaphore, 0, 1);
     EB_CREATE_MUTEX(object_ptr->temp_filt_mutex);
+    EB_CREATE_MUTEX(object_ptr->pa_mutex);
     EB_CREATE_MUTEX(object_ptr->debug_mutex);
     EB_MALLOC_ARRAY(object_ptr->av1_cm, 1);
 
@@ -36,12 +36,16 @@ extern "C" {
 #endif
 
 #define SEGMENT_ENTROPY_BUFFER_SIZE 40000000 // Entropy Bitstream Buffer Size
+#define TILE_ENTROPY_BUFFER_MIN_SIZE 2000000 // Floor of the Bitstream Buffer of a Tile
 #define PACKETIZATION_PROCESS_BUFFER_SIZE SEGMENT_ENTROPY_BUFFER_SIZE
 #define PACKETIZATION_PROCESS_SPS_BUFFER_SIZE 2000
 #define HISTOGRAM_NUMBER_OF_BINS 256
 #define MAX_NUMBER_OF_REGIONS_IN_WIDTH 4
 #define MAX_NUMBER_OF_REGIONS_IN_HEIGHT 4
 #define MAX_REF_QP_NUM 81
+// luma rows padded (and measured for stat_report) by one Rest stripe job; the 10bit packed source
+// stores its 2 LSBs per 64x64 block, so the stripes stay aligned on it
+#define REST_PAD_STRIPE_HEIGHT 64
 // Segment Macros
 #define SEGMENT_MAX_COUNT 64
 #define SEGMENT_COMPLETION_MASK_SET(mask, index)                \
@@ -272,6 +276,40 @@ typedef struct SpeedFeatures {
 
 } SpeedFeatures;
 
+/**************************************
+ * Entropy coding state of one tile. Every
+ * tile has its own coder, CDFs, neighbor
+ * arrays and delta coding references, so the
+ * tiles of a picture are coded as independent
+ * EC jobs and concatenated in packetization.
+ **************************************/
+typedef struct EntropyTileInfo {
+    EbDctor       dctor;
+    EntropyCoder *entropy_coder_ptr;
+    // Entropy Coding Neighbor Arrays
+    NeighborArrayUnit *mode_type_neighbor_array;
+    NeighborArrayUnit *partition_context_neighbor_array;
+    NeighborArrayUnit *intra_luma_mode_neighbor_array;
+    NeighborArrayUnit *skip_flag_neighbor_array;
+    NeighborArrayUnit *skip_coeff_neighbor_array;
+    NeighborArrayUnit *
+        luma_dc_sign_level_coeff_neighbor_array; // Stored per 4x4. 8 bit: lower 6 bits (COEFF_CONTEXT_BITS), shows if there is at least one Coef. Top 2 bit store the sign of DC as follow: 0->0,1->-1,2-> 1
+    NeighborArrayUnit *
+        cr_dc_sign_level_coeff_neighbor_array; // Stored per 4x4. 8 bit: lower 6 bits(COEFF_CONTEXT_BITS), shows if there is at least one Coef. Top 2 bit store the sign of DC as follow: 0->0,1->-1,2-> 1
+    NeighborArrayUnit *
+                         cb_dc_sign_level_coeff_neighbor_array; // Stored per 4x4. 8 bit: lower 6 bits(COEFF_CONTEXT_BITS), shows if there is at least one Coef. Top 2 bit store the sign of DC as follow: 0->0,1->-1,2-> 1
+    NeighborArrayUnit *  txfm_context_array;
+    NeighborArrayUnit *  inter_pred_dir_neighbor_array;
+    NeighborArrayUnit *  ref_frame_type_neighbor_array;
+    NeighborArrayUnit32 *interpolation_type_neighbor_array;
+    NeighborArrayUnit *  segmentation_id_pred_array;
+    // References of the delta coded syntax, reset at the start of the tile
+    WienerInfo  wiener_info[MAX_MB_PLANE];
+    SgrprojInfo sgrproj_info[MAX_MB_PLANE];
+    int32_t     cdef_preset[4];
+    int32_t     prev_qindex;
+} EntropyTileInfo;
+
 typedef struct PictureControlSet {
     EbDctor          dctor;
     EbObjectWrapper *scs_wrapper_ptr;
@@ -285,7 +323,8 @@ typedef struct PictureControlSet {
 
     struct PictureParentControlSet *parent_pcs_ptr; //The parent of this PCS.
     EbObjectWrapper *               picture_parent_control_set_wrapper_ptr;
-    EntropyCoder *                  entropy_coder_ptr;
+    EntropyTileInfo **              ec_info; // one per tile, tile 0 also codes single-tile pictures
+    uint16_t                        tile_count; // entries of ec_info and the neighbor arrays
     // Packetization (used to encode SPS, PPS, etc)
     Bitstream *bitstream_ptr;
 
@@ -299,9 +338,16 @@ typedef struct PictureControlSet {
     uint64_t ref_pic_referenced_area_avg_array[MAX_NUM_OF_REF_PIC_LIST][REF_LIST_MAX_DEPTH];
     // GOP
     uint64_t        picture_number;
+    // generation - unique per picture of the encoder, an overlay shares its
+    //   picture_number with the ALT_REF
+    uint64_t        generation;
     uint8_t         temporal_layer_index;
     EbColorFormat   color_format;
-    EncDecSegments *enc_dec_segment_ctrl;
+    // EncDec work units: one per tile with tile_parallel, else [0] covers the picture
+    EncDecSegments **enc_dec_segment_ctrl;
+    uint16_t         enc_dec_segment_ctrl_count; // entries of enc_dec_segment_ctrl
+    uint16_t         enc_dec_unit_count; // work units of the current picture
+    uint16_t         enc_dec_units_done; // protected by intra_mutex
     // Entropy Process Rows
     int8_t   entropy_coding_current_available_row;
     EbBool   entropy_coding_row_array[MAX_SB_ROWS];
@@ -310,8 +356,15 @@ typedef struct PictureControlSet {
     EbHandle entropy_coding_mutex;
     EbBool   entropy_coding_in_progress;
     EbBool   entropy_coding_pic_done;
+    uint16_t entropy_coding_tiles_done; // multi-tile pictures, each tile is one EC job
     EbHandle intra_mutex;
     uint32_t intra_coded_area;
+    // DLF SB-row jobs
+    int32_t *sb_lf_completed_in_row; // last deblocked SB in every SB row, used for top-right sync
+    uint16_t tot_sb_rows_dlf;
+    uint16_t dlf_sb_rows_done; // all SB rows above this one are deblocked
+    uint8_t  cdef_segment_rows_posted;
+    EbHandle dlf_row_mutex;
     uint32_t tot_seg_searched_cdef;
     EbHandle cdef_search_mutex;
 
@@ -329,6 +382,11 @@ typedef struct PictureControlSet {
     uint16_t rest_segments_total_count;
     uint8_t  rest_segments_column_count;
     uint8_t  rest_segments_row_count;
+    uint16_t rest_stripes_total_count; // LR / padding stripe jobs posted back to the Rest threads
+    uint16_t tot_stripes_done_rest;
+    uint64_t rest_sse[3]; // stat_report SSE summed over the padding stripes
+    EbBool * rest_pad_stripe_done; // padding stripes done, published in order as final_rows
+    uint16_t rest_pad_stripes_ready; // leading padding stripes all done
 
     // Mode Decision Config
     MdcSbData *mdc_sb_array;
@@ -351,71 +409,54 @@ typedef struct PictureControlSet {
     // EncDec Entropy Coder (for rate estimation)
     EntropyCoder *coeff_est_entropy_coder_ptr;
 
-    // Mode Decision Neighbor Arrays
-    NeighborArrayUnit *md_intra_luma_mode_neighbor_array[NEIGHBOR_ARRAY_TOTAL_COUNT];
-    NeighborArrayUnit *md_intra_chroma_mode_neighbor_array[NEIGHBOR_ARRAY_TOTAL_COUNT];
-    NeighborArrayUnit *md_mv_neighbor_array[NEIGHBOR_ARRAY_TOTAL_COUNT];
-    NeighborArrayUnit *md_skip_flag_neighbor_array[NEIGHBOR_ARRAY_TOTAL_COUNT];
-    NeighborArrayUnit *md_mode_type_neighbor_array[NEIGHBOR_ARRAY_TOTAL_COUNT];
-    NeighborArrayUnit *md_leaf_depth_neighbor_array[NEIGHBOR_ARRAY_TOTAL_COUNT];
-    NeighborArrayUnit *md_luma_recon_neighbor_array[NEIGHBOR_ARRAY_TOTAL_COUNT];
-    NeighborArrayUnit *md_tx_depth_1_luma_recon_neighbor_array[NEIGHBOR_ARRAY_TOTAL_COUNT];
-    NeighborArrayUnit *md_cb_recon_neighbor_array[NEIGHBOR_ARRAY_TOTAL_COUNT];
-    NeighborArrayUnit *md_cr_recon_neighbor_array[NEIGHBOR_ARRAY_TOTAL_COUNT];
+    // Mode Decision Neighbor Arrays, [depth][tile]: each tile has its own arrays, so the tiles
+    // can be mode decided independently
+    NeighborArrayUnit **md_intra_luma_mode_neighbor_array[NEIGHBOR_ARRAY_TOTAL_COUNT];
+    NeighborArrayUnit **md_intra_chroma_mode_neighbor_array[NEIGHBOR_ARRAY_TOTAL_COUNT];
+    NeighborArrayUnit **md_mv_neighbor_array[NEIGHBOR_ARRAY_TOTAL_COUNT];
+    NeighborArrayUnit **md_skip_flag_neighbor_array[NEIGHBOR_ARRAY_TOTAL_COUNT];
+    NeighborArrayUnit **md_mode_type_neighbor_array[NEIGHBOR_ARRAY_TOTAL_COUNT];
+    NeighborArrayUnit **md_leaf_depth_neighbor_array[NEIGHBOR_ARRAY_TOTAL_COUNT];
+    NeighborArrayUnit **md_luma_recon_neighbor_array[NEIGHBOR_ARRAY_TOTAL_COUNT];
+    NeighborArrayUnit **md_tx_depth_1_luma_recon_neighbor_array[NEIGHBOR_ARRAY_TOTAL_COUNT];
+    NeighborArrayUnit **md_cb_recon_neighbor_array[NEIGHBOR_ARRAY_TOTAL_COUNT];
+    NeighborArrayUnit **md_cr_recon_neighbor_array[NEIGHBOR_ARRAY_TOTAL_COUNT];
 
     uint8_t            hbd_mode_decision;
-    NeighborArrayUnit *md_luma_recon_neighbor_array16bit[NEIGHBOR_ARRAY_TOTAL_COUNT];
-    NeighborArrayUnit *md_tx_depth_1_luma_recon_neighbor_array16bit[NEIGHBOR_ARRAY_TOTAL_COUNT];
-    NeighborArrayUnit *md_cb_recon_neighbor_array16bit[NEIGHBOR_ARRAY_TOTAL_COUNT];
-    NeighborArrayUnit *md_cr_recon_neighbor_array16bit[NEIGHBOR_ARRAY_TOTAL_COUNT];
-    NeighborArrayUnit *md_skip_coeff_neighbor_array[NEIGHBOR_ARRAY_TOTAL_COUNT];
-    NeighborArrayUnit *md_luma_dc_sign_level_coeff_neighbor_array[NEIGHBOR_ARRAY_TOTAL_COUNT];
+    NeighborArrayUnit **md_luma_recon_neighbor_array16bit[NEIGHBOR_ARRAY_TOTAL_COUNT];
+    NeighborArrayUnit **md_tx_depth_1_luma_recon_neighbor_array16bit[NEIGHBOR_ARRAY_TOTAL_COUNT];
+    NeighborArrayUnit **md_cb_recon_neighbor_array16bit[NEIGHBOR_ARRAY_TOTAL_COUNT];
+    NeighborArrayUnit **md_cr_recon_neighbor_array16bit[NEIGHBOR_ARRAY_TOTAL_COUNT];
+    NeighborArrayUnit **md_skip_coeff_neighbor_array[NEIGHBOR_ARRAY_TOTAL_COUNT];
+    NeighborArrayUnit **md_luma_dc_sign_level_coeff_neighbor_array[NEIGHBOR_ARRAY_TOTAL_COUNT];
     NeighborArrayUnit
-        *md_tx_depth_1_luma_dc_sign_level_coeff_neighbor_array[NEIGHBOR_ARRAY_TOTAL_COUNT];
-    NeighborArrayUnit *md_cb_dc_sign_level_coeff_neighbor_array[NEIGHBOR_ARRAY_TOTAL_COUNT];
-    NeighborArrayUnit *md_cr_dc_sign_level_coeff_neighbor_array[NEIGHBOR_ARRAY_TOTAL_COUNT];
-    NeighborArrayUnit *md_txfm_context_array[NEIGHBOR_ARRAY_TOTAL_COUNT];
-    NeighborArrayUnit *md_inter_pred_dir_neighbor_array[NEIGHBOR_ARRAY_TOTAL_COUNT];
-    NeighborArrayUnit *md_ref_frame_type_neighbor_array[NEIGHBOR_ARRAY_TOTAL_COUNT];
-
-    NeighborArrayUnit32 *md_interpolation_type_neighbor_array[NEIGHBOR_ARRAY_TOTAL_COUNT];
-
-    NeighborArrayUnit *mdleaf_partition_neighbor_array[NEIGHBOR_ARRAY_TOTAL_COUNT];
-    // Encode Pass Neighbor Arrays
-    NeighborArrayUnit *ep_intra_luma_mode_neighbor_array;
-    NeighborArrayUnit *ep_intra_chroma_mode_neighbor_array;
-    NeighborArrayUnit *ep_mv_neighbor_array;
-    NeighborArrayUnit *ep_skip_flag_neighbor_array;
-    NeighborArrayUnit *ep_mode_type_neighbor_array;
-    NeighborArrayUnit *ep_leaf_depth_neighbor_array;
-    NeighborArrayUnit *ep_luma_recon_neighbor_array;
-    NeighborArrayUnit *ep_cb_recon_neighbor_array;
-    NeighborArrayUnit *ep_cr_recon_neighbor_array;
-    NeighborArrayUnit *ep_luma_recon_neighbor_array16bit;
-    NeighborArrayUnit *ep_cb_recon_neighbor_array16bit;
-    NeighborArrayUnit *ep_cr_recon_neighbor_array16bit;
-    NeighborArrayUnit *ep_luma_dc_sign_level_coeff_neighbor_array;
-    NeighborArrayUnit *ep_cr_dc_sign_level_coeff_neighbor_array;
-    NeighborArrayUnit *ep_cb_dc_sign_level_coeff_neighbor_array;
-    NeighborArrayUnit *ep_partition_context_neighbor_array;
-    // Entropy Coding Neighbor Arrays
-    NeighborArrayUnit *mode_type_neighbor_array;
-    NeighborArrayUnit *partition_context_neighbor_array;
-    NeighborArrayUnit *intra_luma_mode_neighbor_array;
-    NeighborArrayUnit *skip_flag_neighbor_array;
-    NeighborArrayUnit *skip_coeff_neighbor_array;
-    NeighborArrayUnit *
-        luma_dc_sign_level_coeff_neighbor_array; // Stored per 4x4. 8 bit: lower 6 bits (COEFF_CONTEXT_BITS), shows if there is at least one Coef. Top 2 bit store the sign of DC as follow: 0->0,1->-1,2-> 1
-    NeighborArrayUnit *
-        cr_dc_sign_level_coeff_neighbor_array; // Stored per 4x4. 8 bit: lower 6 bits(COEFF_CONTEXT_BITS), shows if there is at least one Coef. Top 2 bit store the sign of DC as follow: 0->0,1->-1,2-> 1
-    NeighborArrayUnit *
-                         cb_dc_sign_level_coeff_neighbor_array; // Stored per 4x4. 8 bit: lower 6 bits(COEFF_CONTEXT_BITS), shows if there is at least one Coef. Top 2 bit store the sign of DC as follow: 0->0,1->-1,2-> 1
-    NeighborArrayUnit *  txfm_context_array;
-    NeighborArrayUnit *  inter_pred_dir_neighbor_array;
-    NeighborArrayUnit *  ref_frame_type_neighbor_array;
-    NeighborArrayUnit32 *interpolation_type_neighbor_array;
-
-    NeighborArrayUnit *      segmentation_id_pred_array;
+        **md_tx_depth_1_luma_dc_sign_level_coeff_neighbor_array[NEIGHBOR_ARRAY_TOTAL_COUNT];
+    NeighborArrayUnit **md_cb_dc_sign_level_coeff_neighbor_array[NEIGHBOR_ARRAY_TOTAL_COUNT];
+    NeighborArrayUnit **md_cr_dc_sign_level_coeff_neighbor_array[NEIGHBOR_ARRAY_TOTAL_COUNT];
+    NeighborArrayUnit **md_txfm_context_array[NEIGHBOR_ARRAY_TOTAL_COUNT];
+    NeighborArrayUnit **md_inter_pred_dir_neighbor_array[NEIGHBOR_ARRAY_TOTAL_COUNT];
+    NeighborArrayUnit **md_ref_frame_type_neighbor_array[NEIGHBOR_ARRAY_TOTAL_COUNT];
+
+    NeighborArrayUnit32 **md_interpolation_type_neighbor_array[NEIGHBOR_ARRAY_TOTAL_COUNT];
+
+    NeighborArrayUnit **mdleaf_partition_neighbor_array[NEIGHBOR_ARRAY_TOTAL_COUNT];
+    // Encode Pass Neighbor Arrays, [tile]
+    NeighborArrayUnit **ep_intra_luma_mode_neighbor_array;
+    NeighborArrayUnit **ep_intra_chroma_mode_neighbor_array;
+    NeighborArrayUnit **ep_mv_neighbor_array;
+    NeighborArrayUnit **ep_skip_flag_neighbor_array;
+    NeighborArrayUnit **ep_mode_type_neighbor_array;
+    NeighborArrayUnit **ep_leaf_depth_neighbor_array;
+    NeighborArrayUnit **ep_luma_recon_neighbor_array;
+    NeighborArrayUnit **ep_cb_recon_neighbor_array;
+    NeighborArrayUnit **ep_cr_recon_neighbor_array;
+    NeighborArrayUnit **ep_luma_recon_neighbor_array16bit;
+    NeighborArrayUnit **ep_cb_recon_neighbor_array16bit;
+    NeighborArrayUnit **ep_cr_recon_neighbor_array16bit;
+    NeighborArrayUnit **ep_luma_dc_sign_level_coeff_neighbor_array;
+    NeighborArrayUnit **ep_cr_dc_sign_level_coeff_neighbor_array;
+    NeighborArrayUnit **ep_cb_dc_sign_level_coeff_neighbor_array;
+    NeighborArrayUnit **ep_partition_context_neighbor_array;
     SegmentationNeighborMap *segmentation_neighbor_map;
 
     ModeInfo **mi_grid_base; //2 SB Rows of mi Data are enough
@@ -437,9 +478,6 @@ typedef struct PictureControlSet {
     EbEncMode        enc_mode;
     EbBool           intra_md_open_loop_flag;
     EbBool           limit_intra;
-    int32_t          cdef_preset[4];
-    WienerInfo       wiener_info[MAX_MB_PLANE];
-    SgrprojInfo      sgrproj_info[MAX_MB_PLANE];
     SpeedFeatures    sf;
     SearchSiteConfig ss_cfg; //CHKN this might be a seq based
     HashTable        hash_table;
@@ -447,7 +485,6 @@ typedef struct PictureControlSet {
     CRC_CALCULATOR   crc_calculator2;
 
     FRAME_CONTEXT *                 ec_ctx_array;
-    struct MdRateEstimationContext *rate_est_array;
     uint8_t                         update_cdf;
     FRAME_CONTEXT                   ref_frame_context[REF_FRAMES];
     EbWarpedMotionParams            ref_global_motion[TOTAL_REFS_PER_FRAME];
@@ -455,7 +492,6 @@ typedef struct PictureControlSet {
     int8_t                          ref_frame_side[REF_FRAMES];
     TPL_MV_REF *                    tpl_mvs;
     uint8_t                         pic_filter_intra_mode;
-    TOKENEXTRA *                    tile_tok[64][64];
 } PictureControlSet;
 
 // To optimize based on the max input size
@@ -817,6 +853,13 @@ typedef struct PictureParentControlSet {
     int16_t tf_segments_total_count;
     uint8_t tf_segments_column_count;
     uint8_t tf_segments_row_count;
+    // Picture Analysis segments
+    EbHandle pa_mutex;
+    uint16_t pa_seg_acc;
+    uint16_t pa_segments_total_count;
+    uint64_t pa_tot_variance;
+    uint32_t pa_sc_count_1;
+    uint32_t pa_sc_count_2;
     uint8_t past_altref_nframes;
     uint8_t future_altref_nframes;
     EbBool  temporal_filtering_on;
@@ -862,6 +905,7 @@ typedef struct PictureControlSetInitData {
     uint32_t  compressed_ten_bit_format;
     uint16_t  enc_dec_segment_col;
     uint16_t  enc_dec_segment_row;
+    uint16_t  enc_dec_unit_count; // tiles coded as independent EncDec work units, or 1
     EbEncMode enc_mode;
     uint8_t   speed_control;
     uint8_t   hbd_mode_decision;
@@ -872,6 +916,9 @@ typedef struct PictureControlSetInitData {
     uint8_t   nsq_present;
     uint8_t   over_boundary_block_mode;
     uint8_t   mfmv;
+    uint16_t  tile_count; // upper bound of the tiles of a picture
+    uint16_t  tile_max_width; // upper bound of the tile size of a picture, in pixels
+    uint16_t  tile_max_height;
 } PictureControlSetInitData;
 
 typedef struct Av1Comp {
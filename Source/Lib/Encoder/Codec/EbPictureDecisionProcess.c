@@ -26,6 +26,7 @@
 #include "EbObject.h"
 #include "EbUtility.h"
 #include "EbLog.h"
+#include "EbPipelineStats.h"
 
 /************************************************
  * Defines
@@ -2548,6 +2549,9 @@ void perform_simple_picture_analysis_for_overlay(PictureParentControlSet     *pc
     input_picture_ptr               = pcs_ptr->enhanced_picture_ptr;
     pa_ref_obj_               = (EbPaReferenceObject*)pcs_ptr->pa_reference_picture_wrapper_ptr->object_ptr;
     input_padded_picture_ptr        = (EbPictureBufferDesc*)pa_ref_obj_->input_padded_picture_ptr;
+    // The corners left by the previous user of the object are not this picture's, global
+    // motion estimation detects them
+    pa_ref_obj_->num_gm_corners = -1;
     pic_width_in_sb = (scs_ptr->seq_header.max_frame_width + scs_ptr->sb_sz - 1) / scs_ptr->sb_sz;
     pic_height_in_sb   = (scs_ptr->seq_header.max_frame_height + scs_ptr->sb_sz - 1) / scs_ptr->sb_sz;
     sb_total_count      = pic_width_in_sb * pic_height_in_sb;
@@ -2810,6 +2814,7 @@ void* picture_decision_kernel(void *input_ptr)
         frm_hdr = &pcs_ptr->frm_hdr;
         encode_context_ptr = (EncodeContext*)scs_ptr->encode_context_ptr;
         loop_count++;
+        eb_pipeline_stats_set_picture(pcs_ptr->picture_number);
 
         // Input Picture Analysis Results into the Picture Decision Reordering Queue
         // P.S. Since the prior Picture Analysis processes stage is multithreaded, inputs to the Picture Decision Process
@@ -18,6 +18,7 @@
 #include "EbRateControlTasks.h"
 #include "EbSvtAv1ErrorCodes.h"
 #include "EbEntropyCoding.h"
+#include "EbPipelineStats.h"
 
 /***************************************
  * Context
@@ -169,6 +170,7 @@ void *picture_manager_kernel(void *input_ptr) {
                 (PictureParentControlSet *)input_picture_demux_ptr->pcs_wrapper_ptr->object_ptr;
             scs_ptr            = (SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr;
             encode_context_ptr = scs_ptr->encode_context_ptr;
+            eb_pipeline_stats_set_picture(pcs_ptr->picture_number);
 
             //SVT_LOG("\nPicture Manager Process @ %d \n ", pcs_ptr->picture_number);
 
@@ -795,6 +797,7 @@ void *picture_manager_kernel(void *input_ptr) {
                         child_pcs_ptr->scs_wrapper_ptr      = entry_pcs_ptr->scs_wrapper_ptr;
                         child_pcs_ptr->picture_qp           = entry_pcs_ptr->picture_qp;
                         child_pcs_ptr->picture_number       = entry_pcs_ptr->picture_number;
+                        child_pcs_ptr->generation = ++encode_context_ptr->picture_generation;
                         child_pcs_ptr->slice_type           = entry_pcs_ptr->slice_type;
                         child_pcs_ptr->temporal_layer_index = entry_pcs_ptr->temporal_layer_index;
 
@@ -813,15 +816,6 @@ void *picture_manager_kernel(void *input_ptr) {
                                        entry_scs_ptr->sb_size_pix - 1) /
                                       entry_scs_ptr->sb_size_pix);
 
-                        // EncDec Segments
-                        enc_dec_segments_init(child_pcs_ptr->enc_dec_segment_ctrl,
-                                              entry_scs_ptr->enc_dec_segment_col_count_array
-                                                  [entry_pcs_ptr->temporal_layer_index],
-                                              entry_scs_ptr->enc_dec_segment_row_count_array
-                                                  [entry_pcs_ptr->temporal_layer_index],
-                                              pic_width_in_sb,
-                                              picture_height_in_sb);
-
                         // Entropy Coding Rows
                         {
                             unsigned row_index;
@@ -830,6 +824,7 @@ void *picture_manager_kernel(void *input_ptr) {
                             child_pcs_ptr->entropy_coding_current_available_row = 0;
                             child_pcs_ptr->entropy_coding_row_count   = picture_height_in_sb;
                             child_pcs_ptr->entropy_coding_in_progress = EB_FALSE;
+                            child_pcs_ptr->entropy_coding_tiles_done  = 0;
 
                             for (row_index = 0; row_index < MAX_SB_ROWS; ++row_index)
                                 child_pcs_ptr->entropy_coding_row_array[row_index] = EB_FALSE;
@@ -874,6 +869,53 @@ void *picture_manager_kernel(void *input_ptr) {
                             }
                         }
                         cm->mi_stride = child_pcs_ptr->mi_stride;
+
+                        // EncDec Segments, the tiles are independent work units with tile_parallel
+                        child_pcs_ptr->enc_dec_units_done = 0;
+                        if (entry_scs_ptr->static_config.tile_parallel &&
+                            tile_cols * tile_rows > 1) {
+                            assert(tile_cols * tile_rows <=
+                                   child_pcs_ptr->enc_dec_segment_ctrl_count);
+                            child_pcs_ptr->enc_dec_unit_count = (uint16_t)(tile_cols * tile_rows);
+                            for (tile_row = 0; tile_row < tile_rows; tile_row++) {
+                                for (tile_col = 0; tile_col < tile_cols; tile_col++) {
+                                    const uint32_t sb_x_start =
+                                        cm->tiles_info.tile_col_start_mi[tile_col] >> sb_size_log2;
+                                    const uint32_t sb_y_start =
+                                        cm->tiles_info.tile_row_start_mi[tile_row] >> sb_size_log2;
+                                    const uint32_t sb_x_end = MIN(
+                                        (uint32_t)cm->tiles_info.tile_col_start_mi[tile_col + 1] >>
+                                            sb_size_log2,
+                                        pic_width_in_sb);
+                                    const uint32_t sb_y_end = MIN(
+                                        (uint32_t)cm->tiles_info.tile_row_start_mi[tile_row + 1] >>
+                                            sb_size_log2,
+                                        picture_height_in_sb);
+                                    enc_dec_segments_init(
+                                        child_pcs_ptr
+                                            ->enc_dec_segment_ctrl[tile_row * tile_cols + tile_col],
+                                        entry_scs_ptr->enc_dec_segment_col_count_array
+                                            [entry_pcs_ptr->temporal_layer_index],
+                                        entry_scs_ptr->enc_dec_segment_row_count_array
+                                            [entry_pcs_ptr->temporal_layer_index],
+                                        sb_x_start,
+                                        sb_y_start,
+                                        sb_x_end - sb_x_start,
+                                        sb_y_end - sb_y_start);
+                                }
+                            }
+                        } else {
+                            child_pcs_ptr->enc_dec_unit_count = 1;
+                            enc_dec_segments_init(child_pcs_ptr->enc_dec_segment_ctrl[0],
+                                                  entry_scs_ptr->enc_dec_segment_col_count_array
+                                                      [entry_pcs_ptr->temporal_layer_index],
+                                                  entry_scs_ptr->enc_dec_segment_row_count_array
+                                                      [entry_pcs_ptr->temporal_layer_index],
+                                                  0,
+                                                  0,
+                                                  pic_width_in_sb,
+                                                  picture_height_in_sb);
+                        }
                         // Picture edges
                         configure_picture_edges(entry_scs_ptr, child_pcs_ptr);
 
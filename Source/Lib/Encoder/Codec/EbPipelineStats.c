@@ -0,0 +1,242 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <stdlib.h>
+
+#include "EbPipelineStats.h"
+#include "EbThreads.h"
+#include "EbTime.h"
+
+// Task running on the current thread, stage_ptr is NULL when there is none
+static EB_THREAD_LOCAL EbStageTask current_task;
+// Trace thread id of the current thread, 0 until its first event
+static EB_THREAD_LOCAL uint32_t trace_thread_id;
+
+static void eb_pipeline_stats_dctor(EbPtr p) {
+    EbPipelineStats *obj = (EbPipelineStats *)p;
+    EB_FREE_ARRAY(obj->event_array);
+}
+
+/**************************************
+ * eb_pipeline_stats_ctor
+ **************************************/
+EbErrorType eb_pipeline_stats_ctor(EbPipelineStats *stats_ptr, uint32_t level) {
+    stats_ptr->dctor     = eb_pipeline_stats_dctor;
+    stats_ptr->level     = level;
+    stats_ptr->origin_ns = eb_time_ns();
+
+    if (level >= EB_PIPELINE_STATS_TRACE) {
+        stats_ptr->event_capacity = EB_PIPELINE_STATS_TRACE_EVENTS;
+        EB_MALLOC_ARRAY(stats_ptr->event_array, stats_ptr->event_capacity);
+    }
+
+    return EB_ErrorNone;
+}
+
+/**************************************
+ * eb_pipeline_stats_add_stage
+ **************************************/
+EbStageStats *eb_pipeline_stats_add_stage(EbPipelineStats * stats_ptr,
+                                          EbSystemResource *input_resource_ptr, const char *name,
+                                          uint32_t thread_count) {
+    EbStageStats *stage_ptr;
+
+    if (stats_ptr->stage_count == EB_MAX_PIPELINE_STAGES) return NULL;
+
+    stage_ptr               = &stats_ptr->stage_array[stats_ptr->stage_count];
+    stage_ptr->name         = name;
+    stage_ptr->stage_index  = stats_ptr->stage_count++;
+    stage_ptr->thread_count = thread_count;
+    stage_ptr->pipeline_ptr = stats_ptr;
+    eb_system_resource_set_stats(input_resource_ptr, stage_ptr);
+
+    return stage_ptr;
+}
+
+static uint64_t eb_stats_read(volatile int64_t *counter_ptr) {
+    return (uint64_t)eb_atomic_fetch_add64(counter_ptr, 0);
+}
+
+/**************************************
+ * eb_pipeline_stats_get
+ **************************************/
+void eb_pipeline_stats_get(EbPipelineStats *stats_ptr, EbSvtEncStats *out_ptr) {
+    int32_t event_count = eb_atomic_load32(&stats_ptr->event_count);
+
+    out_ptr->elapsed_ns  = eb_time_ns() - stats_ptr->origin_ns;
+    out_ptr->stage_count = stats_ptr->stage_count;
+    for (uint32_t stage_index = 0; stage_index < stats_ptr->stage_count; ++stage_index) {
+        EbStageStats *   stage_ptr = &stats_ptr->stage_array[stage_index];
+        EbSvtStageStats *out_stage = &out_ptr->stage[stage_index];
+
+        out_stage->name            = stage_ptr->name;
+        out_stage->thread_count    = stage_ptr->thread_count;
+        out_stage->task_count      = eb_stats_read(&stage_ptr->task_count);
+        out_stage->busy_ns         = eb_stats_read(&stage_ptr->busy_ns);
+        out_stage->blocked_ns      = eb_stats_read(&stage_ptr->blocked_ns);
+        out_stage->idle_ns         = eb_stats_read(&stage_ptr->idle_ns);
+        out_stage->max_queue_depth = (uint32_t)eb_atomic_load32(&stage_ptr->max_queue_depth);
+    }
+    out_ptr->pool_idle_ns      = eb_stats_read(&stats_ptr->pool_idle_ns);
+    out_ptr->trace_event_count = AOMMIN((uint32_t)event_count, stats_ptr->event_capacity);
+    out_ptr->trace_dropped_count = (uint32_t)event_count - out_ptr->trace_event_count;
+}
+
+/**************************************
+ * eb_pipeline_stats_dump_trace
+ *   Writes the events in the Chrome trace event format, one complete
+ *   event per task, timestamps in microseconds.
+ **************************************/
+EbErrorType eb_pipeline_stats_dump_trace(EbPipelineStats *stats_ptr, FILE *fp) {
+    uint32_t event_count =
+        AOMMIN((uint32_t)eb_atomic_load32(&stats_ptr->event_count), stats_ptr->event_capacity);
+
+    if (stats_ptr->event_array == NULL) return EB_ErrorBadParameter;
+
+    fprintf(fp, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    for (uint32_t event_index = 0; event_index < event_count; ++event_index) {
+        EbTraceEvent *event_ptr = &stats_ptr->event_array[event_index];
+
+        fprintf(fp,
+                "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f",
+                stats_ptr->stage_array[event_ptr->stage_index].name,
+                event_ptr->thread_id,
+                event_ptr->start_ns / 1000.0,
+                event_ptr->duration_ns / 1000.0);
+        if (event_ptr->picture_number != EB_PIPELINE_STATS_NO_PICTURE)
+            fprintf(fp,
+                    ",\"args\":{\"picture\":%llu}",
+                    (unsigned long long)event_ptr->picture_number);
+        fprintf(fp, "}%s\n", event_index + 1 < event_count ? "," : "");
+    }
+    fprintf(fp, "]}\n");
+
+    return EB_ErrorNone;
+}
+
+void eb_pipeline_stats_set_picture(uint64_t picture_number) {
+    current_task.picture_number = picture_number;
+}
+
+/**************************************
+ * eb_stage_stats_post
+ *   Counts an input queued for the stage.
+ **************************************/
+void eb_stage_stats_post(EbStageStats *stage_ptr) {
+    int32_t depth = eb_atomic_fetch_add32(&stage_ptr->queued_count, 1) + 1;
+    int32_t max_depth;
+
+    do {
+        max_depth = eb_atomic_load32(&stage_ptr->max_queue_depth);
+    } while (depth > max_depth && !eb_atomic_cas32(&stage_ptr->max_queue_depth, max_depth, depth));
+}
+
+static void eb_stage_stats_start(EbStageStats *stage_ptr, uint64_t now_ns) {
+    eb_atomic_fetch_add32(&stage_ptr->queued_count, -1);
+    current_task.stage_ptr      = stage_ptr;
+    current_task.start_ns       = now_ns;
+    current_task.block_start_ns = 0;
+    current_task.picture_number = EB_PIPELINE_STATS_NO_PICTURE;
+}
+
+// Adds the time the current task ran since start_ns, and its trace event
+static void eb_stage_stats_stop(uint64_t now_ns) {
+    EbStageStats *   stage_ptr    = current_task.stage_ptr;
+    EbPipelineStats *pipeline_ptr = stage_ptr->pipeline_ptr;
+
+    if (current_task.block_start_ns) {
+        eb_atomic_fetch_add64(&stage_ptr->blocked_ns,
+                              (int64_t)(now_ns - current_task.block_start_ns));
+        current_task.block_start_ns = now_ns;
+    }
+    eb_atomic_fetch_add64(&stage_ptr->busy_ns, (int64_t)(now_ns - current_task.start_ns));
+
+    if (pipeline_ptr->event_array) {
+        uint32_t event_index = (uint32_t)eb_atomic_fetch_add32(&pipeline_ptr->event_count, 1);
+        if (event_index < pipeline_ptr->event_capacity) {
+            EbTraceEvent *event_ptr = &pipeline_ptr->event_array[event_index];
+            if (trace_thread_id == 0)
+                trace_thread_id =
+                    (uint32_t)eb_atomic_fetch_add32(&pipeline_ptr->thread_count, 1) + 1;
+            event_ptr->start_ns       = current_task.start_ns - pipeline_ptr->origin_ns;
+            event_ptr->duration_ns    = now_ns - current_task.start_ns;
+            event_ptr->picture_number = current_task.picture_number;
+            event_ptr->stage_index    = stage_ptr->stage_index;
+            event_ptr->thread_id      = trace_thread_id;
+        }
+    }
+}
+
+/**************************************
+ * eb_stage_stats_task_begin
+ *   The calling thread took an input of the stage after waiting idle_ns.
+ **************************************/
+void eb_stage_stats_task_begin(EbStageStats *stage_ptr, uint64_t idle_ns) {
+    eb_atomic_fetch_add64(&stage_ptr->idle_ns, (int64_t)idle_ns);
+    eb_stage_stats_start(stage_ptr, eb_time_ns());
+}
+
+/**************************************
+ * eb_stage_stats_task_end
+ *   Ends the task of the calling thread, if any.
+ **************************************/
+void eb_stage_stats_task_end(void) {
+    if (current_task.stage_ptr == NULL) return;
+    eb_stage_stats_stop(eb_time_ns());
+    eb_atomic_fetch_add64(&current_task.stage_ptr->task_count, 1);
+    current_task.stage_ptr = NULL;
+}
+
+/**************************************
+ * eb_stage_stats_task_push
+ *   Pauses the task of the calling thread, saved in saved_task_ptr, and
+ *   begins one of stage_ptr. The pause shows in the trace as a gap.
+ **************************************/
+void eb_stage_stats_task_push(EbStageStats *stage_ptr, EbStageTask *saved_task_ptr) {
+    uint64_t now_ns = eb_time_ns();
+
+    if (current_task.stage_ptr) eb_stage_stats_stop(now_ns);
+    *saved_task_ptr = current_task;
+    current_task.stage_ptr = NULL;
+    if (stage_ptr) eb_stage_stats_start(stage_ptr, now_ns);
+}
+
+/**************************************
+ * eb_stage_stats_task_pop
+ *   Ends the current task and resumes the saved one.
+ **************************************/
+void eb_stage_stats_task_pop(EbStageTask *saved_task_ptr) {
+    uint64_t now_ns;
+
+    eb_stage_stats_task_end();
+    current_task = *saved_task_ptr;
+    if (current_task.stage_ptr) {
+        now_ns                = eb_time_ns();
+        current_task.start_ns = now_ns;
+        if (current_task.block_start_ns) current_task.block_start_ns = now_ns;
+    }
+}
+
+/**************************************
+ * eb_stage_stats_block_begin
+ *   The current task waits for an empty object; EB_FALSE when the calling
+ *   thread runs no task.
+ **************************************/
+EbBool eb_stage_stats_block_begin(void) {
+    if (current_task.stage_ptr == NULL) return EB_FALSE;
+    current_task.block_start_ns = eb_time_ns();
+    return EB_TRUE;
+}
+
+void eb_stage_stats_block_end(void) {
+    if (current_task.stage_ptr == NULL || current_task.block_start_ns == 0) return;
+    eb_atomic_fetch_add64(&current_task.stage_ptr->blocked_ns,
+                          (int64_t)(eb_time_ns() - current_task.block_start_ns));
+    current_task.block_start_ns = 0;
+}
+
+void eb_stage_stats_add_pool_idle(EbPipelineStats *stats_ptr, uint64_t idle_ns) {
+    eb_atomic_fetch_add64(&stats_ptr->pool_idle_ns, (int64_t)idle_ns);
+}
@@ -0,0 +1,113 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifndef EbPipelineStats_h
+#define EbPipelineStats_h
+
+#include <stdio.h>
+
+#include "EbDefinitions.h"
+#include "EbSvtAv1Enc.h"
+#include "EbSystemResourceManager.h"
+#include "EbObject.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define EB_PIPELINE_STATS_OFF 0
+#define EB_PIPELINE_STATS_COUNTERS 1
+#define EB_PIPELINE_STATS_TRACE 2
+
+#define EB_PIPELINE_STATS_TRACE_EVENTS (1 << 18)
+#define EB_PIPELINE_STATS_NO_PICTURE ~0ull
+
+/**************************************
+     * Stage Stats
+     *   Counters of one stage, updated by its threads with atomic adds.
+     *   A stage is identified by its input queue: the queue posts count
+     *   the queue depth, and the thread taking an input starts a task that
+     *   ends when the thread comes back for the next one.
+     **************************************/
+typedef struct EbStageStats {
+    const char *             name;
+    uint32_t                 stage_index;
+    uint32_t                 thread_count;
+    struct EbPipelineStats * pipeline_ptr;
+    volatile int64_t         task_count;
+    volatile int64_t         busy_ns;
+    volatile int64_t         blocked_ns;
+    volatile int64_t         idle_ns;
+    volatile int32_t         queued_count;
+    volatile int32_t         max_queue_depth;
+} EbStageStats;
+
+/**************************************
+     * Stage Task
+     *   The task running on a thread. A thread pool worker keeps the task
+     *   it interrupts to help with another job and resumes it after.
+     **************************************/
+typedef struct EbStageTask {
+    EbStageStats *stage_ptr;
+    uint64_t      start_ns;
+    // block_start_ns - start of the current wait for an empty object, 0
+    //   when not waiting
+    uint64_t block_start_ns;
+    uint64_t picture_number;
+} EbStageTask;
+
+typedef struct EbTraceEvent {
+    uint64_t start_ns;
+    uint64_t duration_ns;
+    uint64_t picture_number;
+    uint32_t stage_index;
+    uint32_t thread_id;
+} EbTraceEvent;
+
+typedef struct EbPipelineStats {
+    EbDctor          dctor;
+    uint32_t         level;
+    uint64_t         origin_ns;
+    uint32_t         stage_count;
+    EbStageStats     stage_array[EB_MAX_PIPELINE_STAGES];
+    volatile int64_t pool_idle_ns;
+    // Trace events, level EB_PIPELINE_STATS_TRACE only
+    EbTraceEvent *   event_array;
+    uint32_t         event_capacity;
+    volatile int32_t event_count;
+    volatile int32_t thread_count;
+} EbPipelineStats;
+
+/**************************************
+     * Extern Function Declarations
+     **************************************/
+extern EbErrorType eb_pipeline_stats_ctor(EbPipelineStats *stats_ptr, uint32_t level);
+
+// Adds the stage fed by input_resource_ptr, thread_count is 0 for a stage
+//   running on the thread pool
+extern EbStageStats *eb_pipeline_stats_add_stage(EbPipelineStats * stats_ptr,
+                                                 EbSystemResource *input_resource_ptr,
+                                                 const char *name, uint32_t thread_count);
+
+extern void eb_pipeline_stats_get(EbPipelineStats *stats_ptr, EbSvtEncStats *out_ptr);
+
+extern EbErrorType eb_pipeline_stats_dump_trace(EbPipelineStats *stats_ptr, FILE *fp);
+
+// Tags the task running on the calling thread with the picture it works on
+extern void eb_pipeline_stats_set_picture(uint64_t picture_number);
+
+// Called by the system resource manager and the thread pool
+extern void eb_stage_stats_post(EbStageStats *stage_ptr);
+extern void eb_stage_stats_task_begin(EbStageStats *stage_ptr, uint64_t idle_ns);
+extern void eb_stage_stats_task_end(void);
+extern void eb_stage_stats_task_push(EbStageStats *stage_ptr, EbStageTask *saved_task_ptr);
+extern void eb_stage_stats_task_pop(EbStageTask *saved_task_ptr);
+extern EbBool eb_stage_stats_block_begin(void);
+extern void   eb_stage_stats_block_end(void);
+extern void   eb_stage_stats_add_pool_idle(EbPipelineStats *stats_ptr, uint64_t idle_ns);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbPipelineStats_h
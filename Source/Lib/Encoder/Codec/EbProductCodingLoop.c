@@ -168,7 +168,7 @@ void mode_decision_update_neighbor_arrays(PictureControlSet *  pcs_ptr,
 
             neighbor_array_unit_mode_write(
                 pcs_ptr->md_tx_depth_1_luma_dc_sign_level_coeff_neighbor_array
-                    [MD_NEIGHBOR_ARRAY_INDEX],
+                    [MD_NEIGHBOR_ARRAY_INDEX][context_ptr->tile_idx],
                 (uint8_t *)&dc_sign_level_coeff,
                 context_ptr->sb_origin_x +
                     context_ptr->blk_geom->tx_org_x[context_ptr->blk_ptr->tx_depth][txb_itr],
@@ -276,7 +276,8 @@ void mode_decision_update_neighbor_arrays(PictureControlSet *  pcs_ptr,
                                         context_ptr->blk_geom->bheight);
             if (context_ptr->md_atb_mode) {
                 update_recon_neighbor_array(
-                    pcs_ptr->md_tx_depth_1_luma_recon_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX],
+                    pcs_ptr->md_tx_depth_1_luma_recon_neighbor_array
+                        [MD_NEIGHBOR_ARRAY_INDEX][context_ptr->tile_idx],
                     context_ptr->blk_ptr->neigh_top_recon[0],
                     context_ptr->blk_ptr->neigh_left_recon[0],
                     origin_x,
@@ -315,7 +316,8 @@ void mode_decision_update_neighbor_arrays(PictureControlSet *  pcs_ptr,
                                              context_ptr->blk_geom->bheight);
         if (context_ptr->md_atb_mode) {
             update_recon_neighbor_array16bit(
-                pcs_ptr->md_tx_depth_1_luma_recon_neighbor_array16bit[MD_NEIGHBOR_ARRAY_INDEX],
+                pcs_ptr->md_tx_depth_1_luma_recon_neighbor_array16bit
+                    [MD_NEIGHBOR_ARRAY_INDEX][context_ptr->tile_idx],
                 context_ptr->blk_ptr->neigh_top_recon_16bit[0],
                 context_ptr->blk_ptr->neigh_left_recon_16bit[0],
                 origin_x,
@@ -349,7 +351,6 @@ void mode_decision_update_neighbor_arrays(PictureControlSet *  pcs_ptr,
 void copy_neighbour_arrays(PictureControlSet *pcs_ptr, ModeDecisionContext *context_ptr,
                            uint32_t src_idx, uint32_t dst_idx, uint32_t blk_mds, uint32_t sb_org_x,
                            uint32_t sb_org_y) {
-    (void)*context_ptr;
 
     const BlockGeom *blk_geom = get_blk_geom_mds(blk_mds);
 
@@ -359,9 +360,10 @@ void copy_neighbour_arrays(PictureControlSet *pcs_ptr, ModeDecisionContext *cont
     uint32_t blk_org_y_uv = (blk_org_y >> 3 << 3) >> 1;
     uint32_t bwidth_uv    = blk_geom->bwidth_uv;
     uint32_t bheight_uv   = blk_geom->bheight_uv;
+    uint16_t tile_idx     = context_ptr->tile_idx;
 
-    copy_neigh_arr(pcs_ptr->md_intra_luma_mode_neighbor_array[src_idx],
-                   pcs_ptr->md_intra_luma_mode_neighbor_array[dst_idx],
+    copy_neigh_arr(pcs_ptr->md_intra_luma_mode_neighbor_array[src_idx][tile_idx],
+                   pcs_ptr->md_intra_luma_mode_neighbor_array[dst_idx][tile_idx],
                    blk_org_x,
                    blk_org_y,
                    blk_geom->bwidth,
@@ -369,8 +371,8 @@ void copy_neighbour_arrays(PictureControlSet *pcs_ptr, ModeDecisionContext *cont
                    NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
 
     //neighbor_array_unit_reset(pcs_ptr->md_intra_chroma_mode_neighbor_array[depth]);
-    copy_neigh_arr(pcs_ptr->md_intra_chroma_mode_neighbor_array[src_idx],
-                   pcs_ptr->md_intra_chroma_mode_neighbor_array[dst_idx],
+    copy_neigh_arr(pcs_ptr->md_intra_chroma_mode_neighbor_array[src_idx][tile_idx],
+                   pcs_ptr->md_intra_chroma_mode_neighbor_array[dst_idx][tile_idx],
                    blk_org_x_uv,
                    blk_org_y_uv,
                    bwidth_uv,
@@ -378,8 +380,8 @@ void copy_neighbour_arrays(PictureControlSet *pcs_ptr, ModeDecisionContext *cont
                    NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
 
     //neighbor_array_unit_reset(pcs_ptr->md_skip_flag_neighbor_array[depth]);
-    copy_neigh_arr(pcs_ptr->md_skip_flag_neighbor_array[src_idx],
-                   pcs_ptr->md_skip_flag_neighbor_array[dst_idx],
+    copy_neigh_arr(pcs_ptr->md_skip_flag_neighbor_array[src_idx][tile_idx],
+                   pcs_ptr->md_skip_flag_neighbor_array[dst_idx][tile_idx],
                    blk_org_x,
                    blk_org_y,
                    blk_geom->bwidth,
@@ -387,8 +389,8 @@ void copy_neighbour_arrays(PictureControlSet *pcs_ptr, ModeDecisionContext *cont
                    NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
 
     //neighbor_array_unit_reset(pcs_ptr->md_mode_type_neighbor_array[depth]);
-    copy_neigh_arr(pcs_ptr->md_mode_type_neighbor_array[src_idx],
-                   pcs_ptr->md_mode_type_neighbor_array[dst_idx],
+    copy_neigh_arr(pcs_ptr->md_mode_type_neighbor_array[src_idx][tile_idx],
+                   pcs_ptr->md_mode_type_neighbor_array[dst_idx][tile_idx],
                    blk_org_x,
                    blk_org_y,
                    blk_geom->bwidth,
@@ -396,15 +398,15 @@ void copy_neighbour_arrays(PictureControlSet *pcs_ptr, ModeDecisionContext *cont
                    NEIGHBOR_ARRAY_UNIT_FULL_MASK);
 
     //neighbor_array_unit_reset(pcs_ptr->md_leaf_depth_neighbor_array[depth]);
-    copy_neigh_arr(pcs_ptr->md_leaf_depth_neighbor_array[src_idx],
-                   pcs_ptr->md_leaf_depth_neighbor_array[dst_idx],
+    copy_neigh_arr(pcs_ptr->md_leaf_depth_neighbor_array[src_idx][tile_idx],
+                   pcs_ptr->md_leaf_depth_neighbor_array[dst_idx][tile_idx],
                    blk_org_x,
                    blk_org_y,
                    blk_geom->bwidth,
                    blk_geom->bheight,
                    NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
-    copy_neigh_arr(pcs_ptr->mdleaf_partition_neighbor_array[src_idx],
-                   pcs_ptr->mdleaf_partition_neighbor_array[dst_idx],
+    copy_neigh_arr(pcs_ptr->mdleaf_partition_neighbor_array[src_idx][tile_idx],
+                   pcs_ptr->mdleaf_partition_neighbor_array[dst_idx][tile_idx],
                    blk_org_x,
                    blk_org_y,
                    blk_geom->bwidth,
@@ -412,16 +414,16 @@ void copy_neighbour_arrays(PictureControlSet *pcs_ptr, ModeDecisionContext *cont
                    NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
 
     if (!context_ptr->hbd_mode_decision) {
-        copy_neigh_arr(pcs_ptr->md_luma_recon_neighbor_array[src_idx],
-                       pcs_ptr->md_luma_recon_neighbor_array[dst_idx],
+        copy_neigh_arr(pcs_ptr->md_luma_recon_neighbor_array[src_idx][tile_idx],
+                       pcs_ptr->md_luma_recon_neighbor_array[dst_idx][tile_idx],
                        blk_org_x,
                        blk_org_y,
                        blk_geom->bwidth,
                        blk_geom->bheight,
                        NEIGHBOR_ARRAY_UNIT_FULL_MASK);
         if (context_ptr->md_atb_mode) {
-            copy_neigh_arr(pcs_ptr->md_tx_depth_1_luma_recon_neighbor_array[src_idx],
-                           pcs_ptr->md_tx_depth_1_luma_recon_neighbor_array[dst_idx],
+            copy_neigh_arr(pcs_ptr->md_tx_depth_1_luma_recon_neighbor_array[src_idx][tile_idx],
+                           pcs_ptr->md_tx_depth_1_luma_recon_neighbor_array[dst_idx][tile_idx],
                            blk_org_x,
                            blk_org_y,
                            blk_geom->bwidth,
@@ -429,16 +431,16 @@ void copy_neighbour_arrays(PictureControlSet *pcs_ptr, ModeDecisionContext *cont
                            NEIGHBOR_ARRAY_UNIT_FULL_MASK);
         }
         if (blk_geom->has_uv && context_ptr->chroma_level <= CHROMA_MODE_1) {
-            copy_neigh_arr(pcs_ptr->md_cb_recon_neighbor_array[src_idx],
-                           pcs_ptr->md_cb_recon_neighbor_array[dst_idx],
+            copy_neigh_arr(pcs_ptr->md_cb_recon_neighbor_array[src_idx][tile_idx],
+                           pcs_ptr->md_cb_recon_neighbor_array[dst_idx][tile_idx],
                            blk_org_x_uv,
                            blk_org_y_uv,
                            bwidth_uv,
                            bheight_uv,
                            NEIGHBOR_ARRAY_UNIT_FULL_MASK);
 
-            copy_neigh_arr(pcs_ptr->md_cr_recon_neighbor_array[src_idx],
-                           pcs_ptr->md_cr_recon_neighbor_array[dst_idx],
+            copy_neigh_arr(pcs_ptr->md_cr_recon_neighbor_array[src_idx][tile_idx],
+                           pcs_ptr->md_cr_recon_neighbor_array[dst_idx][tile_idx],
                            blk_org_x_uv,
                            blk_org_y_uv,
                            bwidth_uv,
@@ -446,16 +448,16 @@ void copy_neighbour_arrays(PictureControlSet *pcs_ptr, ModeDecisionContext *cont
                            NEIGHBOR_ARRAY_UNIT_FULL_MASK);
         }
     } else {
-        copy_neigh_arr(pcs_ptr->md_luma_recon_neighbor_array16bit[src_idx],
-                       pcs_ptr->md_luma_recon_neighbor_array16bit[dst_idx],
+        copy_neigh_arr(pcs_ptr->md_luma_recon_neighbor_array16bit[src_idx][tile_idx],
+                       pcs_ptr->md_luma_recon_neighbor_array16bit[dst_idx][tile_idx],
                        blk_org_x,
                        blk_org_y,
                        blk_geom->bwidth,
                        blk_geom->bheight,
                        NEIGHBOR_ARRAY_UNIT_FULL_MASK);
         if (context_ptr->md_atb_mode) {
-            copy_neigh_arr(pcs_ptr->md_tx_depth_1_luma_recon_neighbor_array16bit[src_idx],
-                           pcs_ptr->md_tx_depth_1_luma_recon_neighbor_array16bit[dst_idx],
+            copy_neigh_arr(pcs_ptr->md_tx_depth_1_luma_recon_neighbor_array16bit[src_idx][tile_idx],
+                           pcs_ptr->md_tx_depth_1_luma_recon_neighbor_array16bit[dst_idx][tile_idx],
                            blk_org_x,
                            blk_org_y,
                            blk_geom->bwidth,
@@ -464,16 +466,16 @@ void copy_neighbour_arrays(PictureControlSet *pcs_ptr, ModeDecisionContext *cont
         }
 
         if (blk_geom->has_uv && context_ptr->chroma_level <= CHROMA_MODE_1) {
-            copy_neigh_arr(pcs_ptr->md_cb_recon_neighbor_array16bit[src_idx],
-                           pcs_ptr->md_cb_recon_neighbor_array16bit[dst_idx],
+            copy_neigh_arr(pcs_ptr->md_cb_recon_neighbor_array16bit[src_idx][tile_idx],
+                           pcs_ptr->md_cb_recon_neighbor_array16bit[dst_idx][tile_idx],
                            blk_org_x_uv,
                            blk_org_y_uv,
                            bwidth_uv,
                            bheight_uv,
                            NEIGHBOR_ARRAY_UNIT_FULL_MASK);
 
-            copy_neigh_arr(pcs_ptr->md_cr_recon_neighbor_array16bit[src_idx],
-                           pcs_ptr->md_cr_recon_neighbor_array16bit[dst_idx],
+            copy_neigh_arr(pcs_ptr->md_cr_recon_neighbor_array16bit[src_idx][tile_idx],
+                           pcs_ptr->md_cr_recon_neighbor_array16bit[dst_idx][tile_idx],
                            blk_org_x_uv,
                            blk_org_y_uv,
                            bwidth_uv,
@@ -483,33 +485,34 @@ void copy_neighbour_arrays(PictureControlSet *pcs_ptr, ModeDecisionContext *cont
     }
 
     //neighbor_array_unit_reset(pcs_ptr->md_skip_coeff_neighbor_array[depth]);
-    copy_neigh_arr(pcs_ptr->md_skip_coeff_neighbor_array[src_idx],
-                   pcs_ptr->md_skip_coeff_neighbor_array[dst_idx],
+    copy_neigh_arr(pcs_ptr->md_skip_coeff_neighbor_array[src_idx][tile_idx],
+                   pcs_ptr->md_skip_coeff_neighbor_array[dst_idx][tile_idx],
                    blk_org_x,
                    blk_org_y,
                    blk_geom->bwidth,
                    blk_geom->bheight,
                    NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
     //neighbor_array_unit_reset(pcs_ptr->md_luma_dc_sign_level_coeff_neighbor_array[depth]);
-    copy_neigh_arr(pcs_ptr->md_luma_dc_sign_level_coeff_neighbor_array[src_idx],
-                   pcs_ptr->md_luma_dc_sign_level_coeff_neighbor_array[dst_idx],
+    copy_neigh_arr(pcs_ptr->md_luma_dc_sign_level_coeff_neighbor_array[src_idx][tile_idx],
+                   pcs_ptr->md_luma_dc_sign_level_coeff_neighbor_array[dst_idx][tile_idx],
                    blk_org_x,
                    blk_org_y,
                    blk_geom->bwidth,
                    blk_geom->bheight,
                    NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
 
-    copy_neigh_arr(pcs_ptr->md_tx_depth_1_luma_dc_sign_level_coeff_neighbor_array[src_idx],
-                   pcs_ptr->md_tx_depth_1_luma_dc_sign_level_coeff_neighbor_array[dst_idx],
-                   blk_org_x,
-                   blk_org_y,
-                   blk_geom->bwidth,
-                   blk_geom->bheight,
-                   NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
+    copy_neigh_arr(
+        pcs_ptr->md_tx_depth_1_luma_dc_sign_level_coeff_neighbor_array[src_idx][tile_idx],
+        pcs_ptr->md_tx_depth_1_luma_dc_sign_level_coeff_neighbor_array[dst_idx][tile_idx],
+        blk_org_x,
+        blk_org_y,
+        blk_geom->bwidth,
+        blk_geom->bheight,
+        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
 
     if (blk_geom->has_uv && context_ptr->chroma_level <= CHROMA_MODE_1) {
-        copy_neigh_arr(pcs_ptr->md_cb_dc_sign_level_coeff_neighbor_array[src_idx],
-                       pcs_ptr->md_cb_dc_sign_level_coeff_neighbor_array[dst_idx],
+        copy_neigh_arr(pcs_ptr->md_cb_dc_sign_level_coeff_neighbor_array[src_idx][tile_idx],
+                       pcs_ptr->md_cb_dc_sign_level_coeff_neighbor_array[dst_idx][tile_idx],
                        blk_org_x_uv,
                        blk_org_y_uv,
                        bwidth_uv,
@@ -517,8 +520,8 @@ void copy_neighbour_arrays(PictureControlSet *pcs_ptr, ModeDecisionContext *cont
                        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
         //neighbor_array_unit_reset(pcs_ptr->md_cr_dc_sign_level_coeff_neighbor_array[depth]);
 
-        copy_neigh_arr(pcs_ptr->md_cr_dc_sign_level_coeff_neighbor_array[src_idx],
-                       pcs_ptr->md_cr_dc_sign_level_coeff_neighbor_array[dst_idx],
+        copy_neigh_arr(pcs_ptr->md_cr_dc_sign_level_coeff_neighbor_array[src_idx][tile_idx],
+                       pcs_ptr->md_cr_dc_sign_level_coeff_neighbor_array[dst_idx][tile_idx],
                        blk_org_x_uv,
                        blk_org_y_uv,
                        bwidth_uv,
@@ -527,32 +530,32 @@ void copy_neighbour_arrays(PictureControlSet *pcs_ptr, ModeDecisionContext *cont
     }
 
     //neighbor_array_unit_reset(pcs_ptr->md_txfm_context_array[depth]);
-    copy_neigh_arr(pcs_ptr->md_txfm_context_array[src_idx],
-                   pcs_ptr->md_txfm_context_array[dst_idx],
+    copy_neigh_arr(pcs_ptr->md_txfm_context_array[src_idx][tile_idx],
+                   pcs_ptr->md_txfm_context_array[dst_idx][tile_idx],
                    blk_org_x,
                    blk_org_y,
                    blk_geom->bwidth,
                    blk_geom->bheight,
                    NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
     //neighbor_array_unit_reset(pcs_ptr->md_inter_pred_dir_neighbor_array[depth]);
-    copy_neigh_arr(pcs_ptr->md_inter_pred_dir_neighbor_array[src_idx],
-                   pcs_ptr->md_inter_pred_dir_neighbor_array[dst_idx],
+    copy_neigh_arr(pcs_ptr->md_inter_pred_dir_neighbor_array[src_idx][tile_idx],
+                   pcs_ptr->md_inter_pred_dir_neighbor_array[dst_idx][tile_idx],
                    blk_org_x,
                    blk_org_y,
                    blk_geom->bwidth,
                    blk_geom->bheight,
                    NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
     //neighbor_array_unit_reset(pcs_ptr->md_ref_frame_type_neighbor_array[depth]);
-    copy_neigh_arr(pcs_ptr->md_ref_frame_type_neighbor_array[src_idx],
-                   pcs_ptr->md_ref_frame_type_neighbor_array[dst_idx],
+    copy_neigh_arr(pcs_ptr->md_ref_frame_type_neighbor_array[src_idx][tile_idx],
+                   pcs_ptr->md_ref_frame_type_neighbor_array[dst_idx][tile_idx],
                    blk_org_x,
                    blk_org_y,
                    blk_geom->bwidth,
                    blk_geom->bheight,
                    NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
 
-    copy_neigh_arr_32(pcs_ptr->md_interpolation_type_neighbor_array[src_idx],
-                      pcs_ptr->md_interpolation_type_neighbor_array[dst_idx],
+    copy_neigh_arr_32(pcs_ptr->md_interpolation_type_neighbor_array[src_idx][tile_idx],
+                      pcs_ptr->md_interpolation_type_neighbor_array[dst_idx][tile_idx],
                       blk_org_x,
                       blk_org_y,
                       blk_geom->bwidth,
@@ -2091,6 +2094,12 @@ void predictive_me_sub_pel_search(PictureControlSet *pcs_ptr, ModeDecisionContex
     }
 }
 
+/* Whether the current block displaced by mv_y (1/8 pel) only reads reference rows above the
+ * bound the EncDec gate of its SB row waited for (inter-frame wavefront). */
+static INLINE EbBool pme_in_ref_rows(const ModeDecisionContext *context_ptr, int16_t mv_y) {
+    return (int32_t)context_ptr->blk_origin_y + context_ptr->blk_geom->bheight + (mv_y >> 3) <=
+        context_ptr->ref_rows_bound;
+}
 void    av1_set_ref_frame(MvReferenceFrame *rf, int8_t ref_frame_type);
 uint8_t get_max_drl_index(uint8_t refmvCnt, PredictionMode mode);
 void    predictive_me_search(PictureControlSet *pcs_ptr, ModeDecisionContext *context_ptr,
@@ -2162,6 +2171,7 @@ void    predictive_me_search(PictureControlSet *pcs_ptr, ModeDecisionContext *co
             // Round-up to the closest integer the ME MV
             me_mv_x = (me_mv_x + 4) & ~0x07;
             me_mv_y = (me_mv_y + 4) & ~0x07;
+            if (!pme_in_ref_rows(context_ptr, me_mv_y)) continue;
 
             uint32_t           pa_me_distortion;
             EbReferenceObject *ref_obj = pcs_ptr->ref_pic_ptr_array[list_idx][ref_idx]->object_ptr;
@@ -2243,6 +2253,7 @@ void    predictive_me_search(PictureControlSet *pcs_ptr, ModeDecisionContext *co
                 int16_t best_mvp_y = 0;
 
                 for (int8_t mvp_index = 0; mvp_index < mvp_count; mvp_index++) {
+                    if (!pme_in_ref_rows(context_ptr, mvp_y_array[mvp_index])) continue;
                     // MVP Distortion
                     EbReferenceObject *ref_obj =
                         pcs_ptr->ref_pic_ptr_array[list_idx][ref_idx]->object_ptr;
@@ -2472,7 +2483,8 @@ void    predictive_me_search(PictureControlSet *pcs_ptr, ModeDecisionContext *co
                     }
                     context_ptr->best_spatial_pred_mv[list_idx][ref_idx][0] = best_search_mvx;
                     context_ptr->best_spatial_pred_mv[list_idx][ref_idx][1] = best_search_mvy;
-                    context_ptr->valid_refined_mv[list_idx][ref_idx]        = 1;
+                    context_ptr->valid_refined_mv[list_idx][ref_idx] =
+                        pme_in_ref_rows(context_ptr, best_search_mvy);
                 }
             }
         }
@@ -3244,21 +3256,25 @@ EbErrorType av1_intra_luma_prediction(ModeDecisionContext *        md_context_pt
 
     PredictionMode mode;
     if (!md_context_ptr->hbd_mode_decision) {
-        uint8_t top_neigh_array[64 * 2 + 1];
-        uint8_t left_neigh_array[64 * 2 + 1];
+        uint8_t            top_neigh_array[64 * 2 + 1];
+        uint8_t            left_neigh_array[64 * 2 + 1];
+        NeighborArrayUnit *recon_neighbor_array =
+            md_context_ptr->tx_search_luma_recon_neighbor_array;
 
         if (txb_origin_y != 0)
             memcpy(top_neigh_array + 1,
-                   md_context_ptr->tx_search_luma_recon_neighbor_array->top_array + txb_origin_x,
+                   recon_neighbor_array->top_array +
+                       get_neighbor_array_unit_top_index(recon_neighbor_array, txb_origin_x),
                    tx_width * 2);
         if (txb_origin_x != 0)
             memcpy(left_neigh_array + 1,
-                   md_context_ptr->tx_search_luma_recon_neighbor_array->left_array + txb_origin_y,
+                   recon_neighbor_array->left_array +
+                       get_neighbor_array_unit_left_index(recon_neighbor_array, txb_origin_y),
                    tx_height * 2);
         if (txb_origin_y != 0 && txb_origin_x != 0)
             top_neigh_array[0] = left_neigh_array[0] =
-                md_context_ptr->tx_search_luma_recon_neighbor_array
-                    ->top_left_array[MAX_PICTURE_HEIGHT_SIZE + txb_origin_x - txb_origin_y];
+                recon_neighbor_array->top_left_array[get_neighbor_array_unit_top_left_index(
+                    recon_neighbor_array, txb_origin_x, txb_origin_y)];
 
         mode = candidate_buffer_ptr->candidate_ptr->pred_mode;
         eb_av1_predict_intra_block(
@@ -3297,26 +3313,26 @@ EbErrorType av1_intra_luma_prediction(ModeDecisionContext *        md_context_pt
                           [md_context_ptr->txb_itr] //uint32_t cuOrgY used only for prediction Ptr
         );
     } else {
-        uint16_t top_neigh_array[64 * 2 + 1];
-        uint16_t left_neigh_array[64 * 2 + 1];
+        uint16_t           top_neigh_array[64 * 2 + 1];
+        uint16_t           left_neigh_array[64 * 2 + 1];
+        NeighborArrayUnit *recon_neighbor_array =
+            md_context_ptr->tx_search_luma_recon_neighbor_array16bit;
 
         if (txb_origin_y != 0)
-            memcpy(
-                top_neigh_array + 1,
-                (uint16_t *)(md_context_ptr->tx_search_luma_recon_neighbor_array16bit->top_array) +
-                    txb_origin_x,
-                sizeof(uint16_t) * tx_width * 2);
+            memcpy(top_neigh_array + 1,
+                   (uint16_t *)(recon_neighbor_array->top_array) +
+                       get_neighbor_array_unit_top_index(recon_neighbor_array, txb_origin_x),
+                   sizeof(uint16_t) * tx_width * 2);
         if (txb_origin_x != 0)
-            memcpy(
-                left_neigh_array + 1,
-                (uint16_t *)(md_context_ptr->tx_search_luma_recon_neighbor_array16bit->left_array) +
-                    txb_origin_y,
-                sizeof(uint16_t) * tx_height * 2);
+            memcpy(left_neigh_array + 1,
+                   (uint16_t *)(recon_neighbor_array->left_array) +
+                       get_neighbor_array_unit_left_index(recon_neighbor_array, txb_origin_y),
+                   sizeof(uint16_t) * tx_height * 2);
         if (txb_origin_y != 0 && txb_origin_x != 0)
             top_neigh_array[0] = left_neigh_array[0] =
-                ((uint16_t *)(md_context_ptr->tx_search_luma_recon_neighbor_array16bit
-                                  ->top_left_array) +
-                 MAX_PICTURE_HEIGHT_SIZE + txb_origin_x - txb_origin_y)[0];
+                ((uint16_t *)(recon_neighbor_array->top_left_array))
+                    [get_neighbor_array_unit_top_left_index(
+                        recon_neighbor_array, txb_origin_x, txb_origin_y)];
 
         mode = candidate_buffer_ptr->candidate_ptr->pred_mode;
         eb_av1_predict_intra_block_16bit(
@@ -3413,20 +3429,25 @@ void tx_initialize_neighbor_arrays(PictureControlSet *pcs_ptr, ModeDecisionConte
         if (context_ptr->hbd_mode_decision)
             context_ptr->tx_search_luma_recon_neighbor_array16bit =
                 (context_ptr->tx_depth)
-                    ? pcs_ptr->md_tx_depth_1_luma_recon_neighbor_array16bit[MD_NEIGHBOR_ARRAY_INDEX]
-                    : pcs_ptr->md_luma_recon_neighbor_array16bit[MD_NEIGHBOR_ARRAY_INDEX];
+                    ? pcs_ptr->md_tx_depth_1_luma_recon_neighbor_array16bit
+                          [MD_NEIGHBOR_ARRAY_INDEX][context_ptr->tile_idx]
+                    : pcs_ptr->md_luma_recon_neighbor_array16bit
+                          [MD_NEIGHBOR_ARRAY_INDEX][context_ptr->tile_idx];
         else
             context_ptr->tx_search_luma_recon_neighbor_array =
                 (context_ptr->tx_depth)
-                    ? pcs_ptr->md_tx_depth_1_luma_recon_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX]
-                    : pcs_ptr->md_luma_recon_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX];
+                    ? pcs_ptr->md_tx_depth_1_luma_recon_neighbor_array
+                          [MD_NEIGHBOR_ARRAY_INDEX][context_ptr->tile_idx]
+                    : pcs_ptr->md_luma_recon_neighbor_array
+                          [MD_NEIGHBOR_ARRAY_INDEX][context_ptr->tile_idx];
     }
     // Set luma dc sign level coeff
     context_ptr->full_loop_luma_dc_sign_level_coeff_neighbor_array =
         (context_ptr->tx_depth == 1)
-            ? pcs_ptr
-                  ->md_tx_depth_1_luma_dc_sign_level_coeff_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX]
-            : pcs_ptr->md_luma_dc_sign_level_coeff_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX];
+            ? pcs_ptr->md_tx_depth_1_luma_dc_sign_level_coeff_neighbor_array
+                  [MD_NEIGHBOR_ARRAY_INDEX][context_ptr->tile_idx]
+            : pcs_ptr->md_luma_dc_sign_level_coeff_neighbor_array
+                  [MD_NEIGHBOR_ARRAY_INDEX][context_ptr->tile_idx];
 }
 
 void tx_update_neighbor_arrays(PictureControlSet *pcs_ptr, ModeDecisionContext *context_ptr,
@@ -3451,7 +3472,8 @@ void tx_update_neighbor_arrays(PictureControlSet *pcs_ptr, ModeDecisionContext *
         int8_t dc_sign_level_coeff =
             candidate_buffer->candidate_ptr->quantized_dc[0][context_ptr->txb_itr];
         neighbor_array_unit_mode_write(
-            pcs_ptr->md_tx_depth_1_luma_dc_sign_level_coeff_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX],
+            pcs_ptr->md_tx_depth_1_luma_dc_sign_level_coeff_neighbor_array
+                [MD_NEIGHBOR_ARRAY_INDEX][context_ptr->tile_idx],
             (uint8_t *)&dc_sign_level_coeff,
             context_ptr->sb_origin_x +
                 context_ptr->blk_geom->tx_org_x[context_ptr->tx_depth][context_ptr->txb_itr],
@@ -3469,16 +3491,20 @@ void tx_reset_neighbor_arrays(PictureControlSet *pcs_ptr, ModeDecisionContext *c
         if (!is_inter) {
             if (context_ptr->hbd_mode_decision) {
                 copy_neigh_arr(
-                    pcs_ptr->md_luma_recon_neighbor_array16bit[MD_NEIGHBOR_ARRAY_INDEX],
-                    pcs_ptr->md_tx_depth_1_luma_recon_neighbor_array16bit[MD_NEIGHBOR_ARRAY_INDEX],
+                    pcs_ptr->md_luma_recon_neighbor_array16bit
+                        [MD_NEIGHBOR_ARRAY_INDEX][context_ptr->tile_idx],
+                    pcs_ptr->md_tx_depth_1_luma_recon_neighbor_array16bit
+                        [MD_NEIGHBOR_ARRAY_INDEX][context_ptr->tile_idx],
                     context_ptr->sb_origin_x + context_ptr->blk_geom->origin_x,
                     context_ptr->sb_origin_y + context_ptr->blk_geom->origin_y,
                     context_ptr->blk_geom->bwidth,
                     context_ptr->blk_geom->bheight,
                     NEIGHBOR_ARRAY_UNIT_TOPLEFT_MASK);
                 copy_neigh_arr(
-                    pcs_ptr->md_luma_recon_neighbor_array16bit[MD_NEIGHBOR_ARRAY_INDEX],
-                    pcs_ptr->md_tx_depth_1_luma_recon_neighbor_array16bit[MD_NEIGHBOR_ARRAY_INDEX],
+                    pcs_ptr->md_luma_recon_neighbor_array16bit
+                        [MD_NEIGHBOR_ARRAY_INDEX][context_ptr->tile_idx],
+                    pcs_ptr->md_tx_depth_1_luma_recon_neighbor_array16bit
+                        [MD_NEIGHBOR_ARRAY_INDEX][context_ptr->tile_idx],
                     context_ptr->sb_origin_x + context_ptr->blk_geom->origin_x,
                     context_ptr->sb_origin_y + context_ptr->blk_geom->origin_y,
                     context_ptr->blk_geom->bwidth * 2,
@@ -3488,8 +3514,10 @@ void tx_reset_neighbor_arrays(PictureControlSet *pcs_ptr, ModeDecisionContext *c
 
             else {
                 copy_neigh_arr(
-                    pcs_ptr->md_luma_recon_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX],
-                    pcs_ptr->md_tx_depth_1_luma_recon_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX],
+                    pcs_ptr->md_luma_recon_neighbor_array
+                        [MD_NEIGHBOR_ARRAY_INDEX][context_ptr->tile_idx],
+                    pcs_ptr->md_tx_depth_1_luma_recon_neighbor_array
+                        [MD_NEIGHBOR_ARRAY_INDEX][context_ptr->tile_idx],
                     context_ptr->sb_origin_x + context_ptr->blk_geom->origin_x,
                     context_ptr->sb_origin_y + context_ptr->blk_geom->origin_y,
                     context_ptr->blk_geom->bwidth,
@@ -3497,8 +3525,10 @@ void tx_reset_neighbor_arrays(PictureControlSet *pcs_ptr, ModeDecisionContext *c
                     NEIGHBOR_ARRAY_UNIT_TOPLEFT_MASK);
 
                 copy_neigh_arr(
-                    pcs_ptr->md_luma_recon_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX],
-                    pcs_ptr->md_tx_depth_1_luma_recon_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX],
+                    pcs_ptr->md_luma_recon_neighbor_array
+                        [MD_NEIGHBOR_ARRAY_INDEX][context_ptr->tile_idx],
+                    pcs_ptr->md_tx_depth_1_luma_recon_neighbor_array
+                        [MD_NEIGHBOR_ARRAY_INDEX][context_ptr->tile_idx],
                     context_ptr->sb_origin_x + context_ptr->blk_geom->origin_x,
                     context_ptr->sb_origin_y + context_ptr->blk_geom->origin_y,
                     context_ptr->blk_geom->bwidth * 2,
@@ -3508,8 +3538,10 @@ void tx_reset_neighbor_arrays(PictureControlSet *pcs_ptr, ModeDecisionContext *c
         }
 
         copy_neigh_arr(
-            pcs_ptr->md_luma_dc_sign_level_coeff_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX],
-            pcs_ptr->md_tx_depth_1_luma_dc_sign_level_coeff_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX],
+            pcs_ptr->md_luma_dc_sign_level_coeff_neighbor_array
+                [MD_NEIGHBOR_ARRAY_INDEX][context_ptr->tile_idx],
+            pcs_ptr->md_tx_depth_1_luma_dc_sign_level_coeff_neighbor_array
+                [MD_NEIGHBOR_ARRAY_INDEX][context_ptr->tile_idx],
             context_ptr->sb_origin_x + context_ptr->blk_geom->origin_x,
             context_ptr->sb_origin_y + context_ptr->blk_geom->origin_y,
             context_ptr->blk_geom->bwidth,
@@ -6280,7 +6312,12 @@ void av1_get_max_min_partition_features(SequenceControlSet *scs_ptr, PictureCont
             const uint8_t      inter_direction      = me_block_results_ptr->direction;
             const uint8_t      list0_ref_index      = me_block_results_ptr->ref_idx_l0;
 
-            if (inter_direction == 0 && list0_ref_index == 0) {
+            // in the inter-frame wavefront, a motion reading below the gated reference rows
+            // counts as no motion
+            if (inter_direction == 0 && list0_ref_index == 0 &&
+                (int32_t)blk_origin_y + blk_geom->bheight +
+                        ((me_results->me_mv_array[me_block_offset][0].y_mv << 1) >> 3) <=
+                    context_ptr->ref_rows_bound) {
                 ModeDecisionCandidateBuffer *candidate_buffer =
                     &(context_ptr->candidate_buffer_ptr_array[0][0]);
                 candidate_buffer->candidate_ptr     = &(context_ptr->fast_candidate_array[0]);
@@ -6492,51 +6529,54 @@ EB_EXTERN EbErrorType mode_decision_sb(SequenceControlSet *scs_ptr, PictureContr
     } else {
         init_sq_non4_block(scs_ptr, context_ptr);
     }
-    // Mode Decision Neighbor Arrays
+    // Mode Decision Neighbor Arrays of the tile of the SB
+    uint16_t tile_idx = context_ptr->tile_idx;
     context_ptr->intra_luma_mode_neighbor_array =
-        pcs_ptr->md_intra_luma_mode_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX];
+        pcs_ptr->md_intra_luma_mode_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX][tile_idx];
     context_ptr->intra_chroma_mode_neighbor_array =
-        pcs_ptr->md_intra_chroma_mode_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX];
-    context_ptr->mv_neighbor_array = pcs_ptr->md_mv_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX];
+        pcs_ptr->md_intra_chroma_mode_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX][tile_idx];
+    context_ptr->mv_neighbor_array =
+        pcs_ptr->md_mv_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX][tile_idx];
     context_ptr->skip_flag_neighbor_array =
-        pcs_ptr->md_skip_flag_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX];
+        pcs_ptr->md_skip_flag_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX][tile_idx];
     context_ptr->mode_type_neighbor_array =
-        pcs_ptr->md_mode_type_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX];
+        pcs_ptr->md_mode_type_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX][tile_idx];
     context_ptr->leaf_depth_neighbor_array =
-        pcs_ptr->md_leaf_depth_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX];
+        pcs_ptr->md_leaf_depth_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX][tile_idx];
     context_ptr->leaf_partition_neighbor_array =
-        pcs_ptr->mdleaf_partition_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX];
+        pcs_ptr->mdleaf_partition_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX][tile_idx];
 
     if (!context_ptr->hbd_mode_decision) {
         context_ptr->luma_recon_neighbor_array =
-            pcs_ptr->md_luma_recon_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX];
+            pcs_ptr->md_luma_recon_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX][tile_idx];
         context_ptr->cb_recon_neighbor_array =
-            pcs_ptr->md_cb_recon_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX];
+            pcs_ptr->md_cb_recon_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX][tile_idx];
         context_ptr->cr_recon_neighbor_array =
-            pcs_ptr->md_cr_recon_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX];
+            pcs_ptr->md_cr_recon_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX][tile_idx];
     } else {
         context_ptr->luma_recon_neighbor_array16bit =
-            pcs_ptr->md_luma_recon_neighbor_array16bit[MD_NEIGHBOR_ARRAY_INDEX];
+            pcs_ptr->md_luma_recon_neighbor_array16bit[MD_NEIGHBOR_ARRAY_INDEX][tile_idx];
         context_ptr->cb_recon_neighbor_array16bit =
-            pcs_ptr->md_cb_recon_neighbor_array16bit[MD_NEIGHBOR_ARRAY_INDEX];
+            pcs_ptr->md_cb_recon_neighbor_array16bit[MD_NEIGHBOR_ARRAY_INDEX][tile_idx];
         context_ptr->cr_recon_neighbor_array16bit =
-            pcs_ptr->md_cr_recon_neighbor_array16bit[MD_NEIGHBOR_ARRAY_INDEX];
+            pcs_ptr->md_cr_recon_neighbor_array16bit[MD_NEIGHBOR_ARRAY_INDEX][tile_idx];
     }
     context_ptr->skip_coeff_neighbor_array =
-        pcs_ptr->md_skip_coeff_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX];
+        pcs_ptr->md_skip_coeff_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX][tile_idx];
     context_ptr->luma_dc_sign_level_coeff_neighbor_array =
-        pcs_ptr->md_luma_dc_sign_level_coeff_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX];
+        pcs_ptr->md_luma_dc_sign_level_coeff_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX][tile_idx];
     context_ptr->cb_dc_sign_level_coeff_neighbor_array =
-        pcs_ptr->md_cb_dc_sign_level_coeff_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX];
+        pcs_ptr->md_cb_dc_sign_level_coeff_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX][tile_idx];
     context_ptr->cr_dc_sign_level_coeff_neighbor_array =
-        pcs_ptr->md_cr_dc_sign_level_coeff_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX];
-    context_ptr->txfm_context_array = pcs_ptr->md_txfm_context_array[MD_NEIGHBOR_ARRAY_INDEX];
+        pcs_ptr->md_cr_dc_sign_level_coeff_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX][tile_idx];
+    context_ptr->txfm_context_array =
+        pcs_ptr->md_txfm_context_array[MD_NEIGHBOR_ARRAY_INDEX][tile_idx];
     context_ptr->inter_pred_dir_neighbor_array =
-        pcs_ptr->md_inter_pred_dir_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX];
+        pcs_ptr->md_inter_pred_dir_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX][tile_idx];
     context_ptr->ref_frame_type_neighbor_array =
-        pcs_ptr->md_ref_frame_type_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX];
+        pcs_ptr->md_ref_frame_type_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX][tile_idx];
     context_ptr->interpolation_type_neighbor_array =
-        pcs_ptr->md_interpolation_type_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX];
+        pcs_ptr->md_interpolation_type_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX][tile_idx];
     uint32_t             d1_block_itr      = 0;
     uint32_t             d1_first_block    = 1;
     EbPictureBufferDesc *input_picture_ptr = pcs_ptr->parent_pcs_ptr->enhanced_picture_ptr;
@@ -29,6 +29,7 @@
 
 #include "EbSegmentation.h"
 #include "EbLog.h"
+#include "EbPipelineStats.h"
 
 static const uint32_t rate_percentage_layer_array[EB_MAX_TEMPORAL_LAYERS][EB_MAX_TEMPORAL_LAYERS] =
     {{100, 0, 0, 0, 0, 0},
@@ -5015,6 +5016,7 @@ void *rate_control_kernel(void *input_ptr) {
             pcs_ptr = (PictureControlSet *)rate_control_tasks_ptr->pcs_wrapper_ptr->object_ptr;
             scs_ptr = (SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr;
             FrameHeader *frm_hdr = &pcs_ptr->parent_pcs_ptr->frm_hdr;
+            eb_pipeline_stats_set_picture(pcs_ptr->picture_number);
 
             if (pcs_ptr->picture_number == 0) {
                 //init rate control parameters
@@ -10,6 +10,9 @@
 #include "EbReferenceObject.h"
 #include "EbPictureBufferDesc.h"
 
+// spins on the row progress before yielding the core to the Rest threads producing it
+#define REF_ROWS_YIELD_COUNT 64
+
 void initialize_samples_neighboring_reference_picture16_bit(EbByte   recon_samples_buffer_ptr,
                                                             uint16_t stride, uint16_t recon_width,
                                                             uint16_t recon_height,
@@ -183,9 +186,30 @@ EbErrorType eb_reference_object_ctor(EbReferenceObject *reference_object,
     }
     memset(&reference_object->film_grain_params, 0, sizeof(reference_object->film_grain_params));
     EB_CREATE_MUTEX(reference_object->referenced_area_mutex);
+    reference_object->final_rows = REF_ROWS_ALL;
     return EB_ErrorNone;
 }
 
+/*****************************************
+ * eb_reference_object_wait_rows
+ *  Waits until the luma rows above row_end
+ *  (and the matching chroma rows) of the
+ *  reference are final. Rows at or past the
+ *  bottom of the picture also need the
+ *  bottom padding, so they wait for the
+ *  whole picture.
+ *****************************************/
+void eb_reference_object_wait_rows(EbReferenceObject *reference_object, int32_t row_end) {
+    if (row_end >= (int32_t)reference_object->reference_picture->height) row_end = REF_ROWS_ALL;
+    int32_t spin = 0;
+    while (eb_atomic_load32(&reference_object->final_rows) < row_end) {
+        if (++spin < REF_ROWS_YIELD_COUNT)
+            eb_cpu_pause();
+        else
+            eb_yield_thread();
+    }
+}
+
 EbErrorType eb_reference_object_creator(EbPtr *object_dbl_ptr, EbPtr object_init_data_ptr) {
     EbReferenceObject *obj;
 
@@ -216,7 +240,8 @@ EbErrorType eb_pa_reference_object_ctor(EbPaReferenceObject *pa_ref_obj_,
     EbPictureBufferDescInitData *picture_buffer_desc_init_data_ptr =
         (EbPictureBufferDescInitData *)object_init_data_ptr;
 
-    pa_ref_obj_->dctor = eb_pa_reference_object_dctor;
+    pa_ref_obj_->dctor          = eb_pa_reference_object_dctor;
+    pa_ref_obj_->num_gm_corners = -1;
 
     // Reference picture constructor
     EB_NEW(pa_ref_obj_->input_padded_picture_ptr,
@@ -10,6 +10,17 @@
 #include "EbObject.h"
 #include "EbCabacContextModel.h"
 #include "EbCodingUnit.h"
+#include "global_motion.h"
+
+// luma rows below a referenced block that a prediction may still read: the interpolation taps,
+// the 8x8 warp sub-blocks, the sub-8x8 chroma predictions and the sub-pel refinement steps
+#define REF_ROWS_MARGIN 16
+// final_rows value of a reference whose padded picture is complete
+#define REF_ROWS_ALL INT32_MAX
+// luma rows below its SB row the motion of a block may reach when its picture starts before its
+// references are final (inter-frame wavefront), which bounds the reference rows EncDec waits for
+// per SB row; close to the vertical reach of the HME and ME searches, so that few candidates drop
+#define REF_ROWS_MV_RANGE 256
 
 typedef struct EbReferenceObject {
     EbDctor              dctor;
@@ -39,6 +50,9 @@ typedef struct EbReferenceObject {
     StatStruct           stat_struct;
     EbHandle             referenced_area_mutex;
     uint64_t             referenced_area_avg;
+    // luma rows, from the top, whose samples and horizontal padding are final (REF_ROWS_ALL once
+    // the vertical padding is done too); published by Rest, see eb_reference_object_wait_rows()
+    volatile int32_t final_rows;
 } EbReferenceObject;
 
 typedef struct EbReferenceObjectDescInitData {
@@ -56,7 +70,10 @@ typedef struct EbPaReferenceObject {
     uint8_t              y_mean[MAX_NUMBER_OF_TREEBLOCKS_PER_PICTURE];
     EB_SLICE             slice_type;
     uint32_t             dependent_pictures_count; //number of pic using this reference frame
-
+    // FAST corners of the quarter picture for the global motion search, detected
+    // once by Picture Analysis. num_gm_corners is -1 when they were not detected
+    int32_t num_gm_corners;
+    int     gm_corners[2 * MAX_CORNERS];
 } EbPaReferenceObject;
 
 typedef struct EbPaReferenceObjectDescInitData {
@@ -73,4 +90,6 @@ extern EbErrorType eb_reference_object_creator(EbPtr *object_dbl_ptr, EbPtr obje
 extern EbErrorType eb_pa_reference_object_creator(EbPtr *object_dbl_ptr,
                                                   EbPtr  object_init_data_ptr);
 
+extern void eb_reference_object_wait_rows(EbReferenceObject *reference_object, int32_t row_end);
+
 #endif //EbReferenceObject_h
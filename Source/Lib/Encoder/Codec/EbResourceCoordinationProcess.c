@@ -660,6 +660,38 @@ static void read_stat_from_file(PictureParentControlSet *pcs_ptr, SequenceContro
     eb_release_mutex(scs_ptr->encode_context_ptr->stat_file_mutex);
 }
 
+/***************************************
+ * Posts the Picture Analysis prep task of the picture, which posts one
+ * task per segment once the picture-wide operations are done
+ ***************************************/
+static void post_picture_analysis_tasks(ResourceCoordinationContext *context_ptr,
+                                        EbObjectWrapper *            pcs_wrapper_ptr) {
+    PictureParentControlSet *    pcs_ptr = (PictureParentControlSet *)pcs_wrapper_ptr->object_ptr;
+    EbObjectWrapper *            output_wrapper_ptr;
+    ResourceCoordinationResults *out_results_ptr;
+
+    // Overlay pictures reuse the alt ref analysis, so they go through as one segment
+    pcs_ptr->pa_segments_total_count =
+        pcs_ptr->is_overlay
+            ? 1
+            : (uint16_t)((SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr)
+                  ->pa_segment_row_count;
+    pcs_ptr->pa_seg_acc      = 0;
+    pcs_ptr->pa_tot_variance = 0;
+    pcs_ptr->pa_sc_count_1   = 0;
+    pcs_ptr->pa_sc_count_2   = 0;
+
+    eb_get_empty_object(context_ptr->resource_coordination_results_output_fifo_ptr,
+                        &output_wrapper_ptr);
+    out_results_ptr = (ResourceCoordinationResults *)output_wrapper_ptr->object_ptr;
+    out_results_ptr->pcs_wrapper_ptr = pcs_wrapper_ptr;
+    // Overlay pictures have nothing to prepare
+    out_results_ptr->prep_task     = (EbBool)!pcs_ptr->is_overlay;
+    out_results_ptr->segment_index = 0;
+    // Post the finished Results Object
+    eb_post_full_object(output_wrapper_ptr);
+}
+
 /***************************************
  * ResourceCoordination Kernel
  ***************************************/
@@ -674,10 +706,8 @@ void *resource_coordination_kernel(void *input_ptr) {
     EbObjectWrapper *   prev_scs_wrapper_ptr;
     SequenceControlSet *scs_ptr;
 
-    EbObjectWrapper *            eb_input_wrapper_ptr;
-    EbBufferHeaderType *         eb_input_ptr;
-    EbObjectWrapper *            output_wrapper_ptr;
-    ResourceCoordinationResults *out_results_ptr;
+    EbObjectWrapper *   eb_input_wrapper_ptr;
+    EbBufferHeaderType *eb_input_ptr;
 
     EbObjectWrapper *input_picture_wrapper_ptr;
     EbObjectWrapper *reference_picture_wrapper_ptr;
@@ -1044,21 +1074,22 @@ void *resource_coordination_kernel(void *input_ptr) {
                 }
             }
 
+            // Low latency: the picture goes through right away, the end of sequence is signalled
+            // by the API once the packets of every picture are out
+            if (scs_ptr->static_config.low_latency) {
+                post_picture_analysis_tasks(context_ptr, pcs_wrapper_ptr);
+                continue;
+            }
             // Get Empty Output Results Object
             if (pcs_ptr->picture_number > 0 && (prev_pcs_wrapper_ptr != NULL)) {
-                ((PictureParentControlSet *)prev_pcs_wrapper_ptr->object_ptr)
-                    ->end_of_sequence_flag = end_of_sequence_flag;
-                eb_get_empty_object(context_ptr->resource_coordination_results_output_fifo_ptr,
-                                    &output_wrapper_ptr);
-                out_results_ptr = (ResourceCoordinationResults *)output_wrapper_ptr->object_ptr;
-                out_results_ptr->pcs_wrapper_ptr = prev_pcs_wrapper_ptr;
+                PictureParentControlSet *prev_pcs_ptr =
+                    (PictureParentControlSet *)prev_pcs_wrapper_ptr->object_ptr;
+                prev_pcs_ptr->end_of_sequence_flag = end_of_sequence_flag;
                 // since overlay frame has the end of sequence set properly, set the end of sequence to true in the alt ref picture
-                if (((PictureParentControlSet *)prev_pcs_wrapper_ptr->object_ptr)->is_overlay &&
-                    end_of_sequence_flag)
-                    ((PictureParentControlSet *)prev_pcs_wrapper_ptr->object_ptr)
-                        ->alt_ref_ppcs_ptr->end_of_sequence_flag = EB_TRUE;
-                // Post the finished Results Object
-                eb_post_full_object(output_wrapper_ptr);
+                if (prev_pcs_ptr->is_overlay && end_of_sequence_flag)
+                    prev_pcs_ptr->alt_ref_ppcs_ptr->end_of_sequence_flag = EB_TRUE;
+
+                post_picture_analysis_tasks(context_ptr, prev_pcs_wrapper_ptr);
             }
             prev_pcs_wrapper_ptr = pcs_wrapper_ptr;
         }
@@ -18,6 +18,9 @@ extern "C" {
 typedef struct ResourceCoordinationResults {
     EbDctor          dctor;
     EbObjectWrapper *pcs_wrapper_ptr;
+    // prep_task - the picture-wide operations, which post the segment tasks once done
+    EbBool   prep_task;
+    uint32_t segment_index;
 } ResourceCoordinationResults;
 
 typedef struct ResourceCoordinationResultInitData {
@@ -24,6 +24,7 @@
 #include "EbPsnr.h"
 #include "EbReferenceObject.h"
 #include "EbPictureControlSet.h"
+#include "EbPipelineStats.h"
 
 /**************************************
  * Rest Context
@@ -33,6 +34,7 @@ typedef struct RestContext {
     EbFifo *rest_input_fifo_ptr;
     EbFifo *rest_output_fifo_ptr;
     EbFifo *picture_demux_fifo_ptr;
+    EbFifo *rest_feedback_fifo_ptr; // stripe jobs posted back to the Rest threads
 
     EbPictureBufferDesc *trial_frame_rst;
 
@@ -44,18 +46,26 @@ typedef struct RestContext {
         // many threads doing the above will result in race condition.
         // each thread will hence have his own copy of recon to work on.
         // later we can have a search version that does not need the exact right recon
+        // the stripe jobs of the LR application use it the same way.
     int32_t *rst_tmpbuf;
 } RestContext;
 
 void recon_output(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr);
-void eb_av1_loop_restoration_filter_frame(Yv12BufferConfig *frame, Av1Common *cm,
-                                          int32_t optimized_lr);
+int32_t eb_av1_loop_restoration_filter_frame_init(Yv12BufferConfig *frame, Av1Common *cm,
+                                                  int32_t optimized_lr);
+void    eb_av1_loop_restoration_filter_frame_stripe(Yv12BufferConfig *frame,
+                                                    Yv12BufferConfig *frame_copy, Av1Common *cm,
+                                                    int32_t *tmpbuf, int32_t stripe_index,
+                                                    int32_t stripe_count);
 void copy_statistics_to_ref_obj_ect(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr);
-void psnr_calculations(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr);
-void pad_ref_and_set_flags(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr);
-void generate_padding(EbByte src_pic, uint32_t src_stride, uint32_t original_src_width,
-                      uint32_t original_src_height, uint32_t padding_width,
-                      uint32_t padding_height);
+void psnr_calculations_rows(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr,
+                            uint32_t row_start, uint32_t row_end, uint64_t sse_total[3]);
+void psnr_calculations_finish(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr,
+                              const uint64_t sse_total[3]);
+void pad_ref_rows(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr, uint32_t row_start,
+                  uint32_t row_end);
+void pad_ref_border(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr, EbBool top);
+void set_ref_flags(PictureControlSet *pcs_ptr);
 void restoration_seg_search(int32_t *rst_tmpbuf, Yv12BufferConfig *org_fts,
                             const Yv12BufferConfig *src, Yv12BufferConfig *trial_frame_rst,
                             PictureControlSet *pcs_ptr, uint32_t segment_index);
@@ -76,7 +86,8 @@ static void rest_context_dctor(EbPtr p) {
  * Rest Context Constructor
  ******************************************************/
 EbErrorType rest_context_ctor(EbThreadContext *  thread_context_ptr,
-                              const EbEncHandle *enc_handle_ptr, int index, int demux_index) {
+                              const EbEncHandle *enc_handle_ptr, int index, int demux_index,
+                              int feedback_index) {
     const SequenceControlSet *      scs_ptr      = enc_handle_ptr->scs_instance_array[0]->scs_ptr;
     const EbSvtAv1EncConfiguration *config       = &scs_ptr->static_config;
     EbBool                          is_16bit     = (EbBool)(config->encoder_bit_depth > EB_8BIT);
@@ -94,6 +105,8 @@ EbErrorType rest_context_ctor(EbThreadContext *  thread_context_ptr,
         eb_system_resource_get_producer_fifo(enc_handle_ptr->rest_results_resource_ptr, index);
     context_ptr->picture_demux_fifo_ptr = eb_system_resource_get_producer_fifo(
         enc_handle_ptr->picture_demux_results_resource_ptr, demux_index);
+    context_ptr->rest_feedback_fifo_ptr = eb_system_resource_get_producer_fifo(
+        enc_handle_ptr->cdef_results_resource_ptr, feedback_index);
 
     {
         EbPictureBufferDescInitData init_data;
@@ -231,45 +244,251 @@ void get_own_recon(SequenceControlSet *scs_ptr, PictureControlSet *pcs_ptr,
 }
 
 /******************************************************
- * Rest Kernel
+ * Rest Actions
+ *   What a job decided under rest_search_mutex and runs
+ *   once it is released, as getting an empty object
+ *   blocks until a consumer frees one.
  ******************************************************/
-void *rest_kernel(void *input_ptr) {
+typedef struct RestActions {
+    EbBool   post_reference;
+    uint32_t stripe_input_type;
+    uint16_t stripe_count; // stripe jobs to post, 0 for none
+    EbBool   finish_picture;
+} RestActions;
+
+/******************************************************
+ * Reset the stripe counters of the picture for
+ * stripe_count stripe jobs and queue their posting.
+ * Called under rest_search_mutex, which guards the
+ * counters.
+ ******************************************************/
+static void rest_set_stripes(PictureControlSet *pcs_ptr, RestActions *actions,
+                             uint32_t input_type, uint16_t stripe_count) {
+    pcs_ptr->rest_stripes_total_count = stripe_count;
+    pcs_ptr->tot_stripes_done_rest    = 0;
+    actions->stripe_input_type        = input_type;
+    actions->stripe_count             = stripe_count;
+}
+
+/******************************************************
+ * Post one stripe job per stripe back to the Rest threads.
+ ******************************************************/
+static void rest_post_stripes(RestContext *context_ptr, EbObjectWrapper *pcs_wrapper_ptr,
+                              uint32_t input_type, uint16_t stripe_count) {
+    EbObjectWrapper *stripe_wrapper_ptr;
+    CdefResults *    stripe_ptr;
+
+    for (uint16_t stripe_index = 0; stripe_index < stripe_count; ++stripe_index) {
+        eb_get_empty_object(context_ptr->rest_feedback_fifo_ptr, &stripe_wrapper_ptr);
+        stripe_ptr                  = (CdefResults *)stripe_wrapper_ptr->object_ptr;
+        stripe_ptr->pcs_wrapper_ptr = pcs_wrapper_ptr;
+        stripe_ptr->input_type      = input_type;
+        stripe_ptr->segment_index   = stripe_index;
+        eb_post_full_object(stripe_wrapper_ptr);
+    }
+}
+
+/******************************************************
+ * Post the reference picture to PicMgr, which starts
+ * the pictures waiting on it.
+ ******************************************************/
+static void rest_post_reference(RestContext *context_ptr, PictureControlSet *pcs_ptr) {
+    EbObjectWrapper *    picture_demux_results_wrapper_ptr;
+    PictureDemuxResults *picture_demux_results_rtr;
+
+    // Get Empty PicMgr Results
+    eb_get_empty_object(context_ptr->picture_demux_fifo_ptr, &picture_demux_results_wrapper_ptr);
+
+    picture_demux_results_rtr = (PictureDemuxResults *)picture_demux_results_wrapper_ptr->object_ptr;
+    picture_demux_results_rtr->reference_picture_wrapper_ptr =
+        pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr;
+    picture_demux_results_rtr->scs_wrapper_ptr = pcs_ptr->scs_wrapper_ptr;
+    picture_demux_results_rtr->picture_number  = pcs_ptr->picture_number;
+    picture_demux_results_rtr->picture_type    = EB_PIC_REFERENCE;
+
+    // Post Reference Picture
+    eb_post_full_object(picture_demux_results_wrapper_ptr);
+}
+
+/******************************************************
+ * Last step of the picture, once every stripe is padded:
+ * PSNR, vertical padding, recon output and the results
+ * to PicMgr and EC. With inter_frame_wavefront the
+ * reference went to PicMgr when its search was done.
+ * No other job touches the picture by then, so it runs
+ * outside rest_search_mutex.
+ ******************************************************/
+static void rest_finish_picture(RestContext *context_ptr, PictureControlSet *pcs_ptr,
+                                SequenceControlSet *scs_ptr, EbObjectWrapper *pcs_wrapper_ptr) {
+    EbObjectWrapper *rest_results_wrapper_ptr;
+    RestResults *    rest_results_ptr;
+    uint8_t          sb_size_log2 = (uint8_t)Log2f(scs_ptr->sb_size_pix);
+
+    // PSNR Calculation
+    if (scs_ptr->static_config.stat_report)
+        psnr_calculations_finish(pcs_ptr, scs_ptr, pcs_ptr->rest_sse);
+
+    // Pad the reference picture and set ref POC
+    if (pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE) {
+        EbReferenceObject *ref_obj =
+            (EbReferenceObject *)pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr;
+        pad_ref_border(pcs_ptr, scs_ptr, EB_FALSE);
+        eb_atomic_store32(&ref_obj->final_rows, REF_ROWS_ALL);
+        if (!scs_ptr->static_config.inter_frame_wavefront) set_ref_flags(pcs_ptr);
+    }
+    if (scs_ptr->static_config.recon_enabled) { recon_output(pcs_ptr, scs_ptr); }
+
+    if (pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag &&
+        !scs_ptr->static_config.inter_frame_wavefront)
+        rest_post_reference(context_ptr, pcs_ptr);
+
+    // Get Empty rest Results to EC, one per tile so the tiles are entropy coded in parallel
+    const uint16_t tile_count =
+        (uint16_t)(pcs_ptr->parent_pcs_ptr->av1_cm->tiles_info.tile_cols *
+                   pcs_ptr->parent_pcs_ptr->av1_cm->tiles_info.tile_rows);
+    for (uint16_t tile_idx = 0; tile_idx < tile_count; tile_idx++) {
+        eb_get_empty_object(context_ptr->rest_output_fifo_ptr, &rest_results_wrapper_ptr);
+        rest_results_ptr = (struct RestResults *)rest_results_wrapper_ptr->object_ptr;
+        rest_results_ptr->pcs_wrapper_ptr              = pcs_wrapper_ptr;
+        rest_results_ptr->completed_sb_row_index_start = 0;
+        rest_results_ptr->completed_sb_row_count =
+            ((scs_ptr->seq_header.max_frame_height + scs_ptr->sb_size_pix - 1) >> sb_size_log2);
+        rest_results_ptr->tile_index = tile_idx;
+        // Post Rest Results
+        eb_post_full_object(rest_results_wrapper_ptr);
+    }
+}
+
+/******************************************************
+ * Mark one padding stripe of a reference as done and
+ * publish the rows of the leading done stripes, which
+ * the pictures referencing it may read from now on.
+ * Called under rest_search_mutex.
+ ******************************************************/
+static void rest_publish_pad_stripe(PictureControlSet *pcs_ptr, uint16_t stripe_index) {
+    EbReferenceObject *ref_obj =
+        (EbReferenceObject *)pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr;
+    const int32_t height = (int32_t)ref_obj->reference_picture->height;
+
+    pcs_ptr->rest_pad_stripe_done[stripe_index] = EB_TRUE;
+    if (stripe_index != pcs_ptr->rest_pad_stripes_ready) return;
+    while (pcs_ptr->rest_pad_stripes_ready < pcs_ptr->rest_stripes_total_count &&
+           pcs_ptr->rest_pad_stripe_done[pcs_ptr->rest_pad_stripes_ready])
+        pcs_ptr->rest_pad_stripes_ready++;
+    eb_atomic_store32(&ref_obj->final_rows,
+                      MIN(pcs_ptr->rest_pad_stripes_ready * REST_PAD_STRIPE_HEIGHT, height));
+}
+
+/******************************************************
+ * Once the filtered recon is final, pad it and compute
+ * its PSNR in REST_PAD_STRIPE_HEIGHT stripes, or finish
+ * the picture right away when there is nothing to do.
+ * Called under rest_search_mutex.
+ ******************************************************/
+static void rest_set_pad_stripes(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr,
+                                 RestActions *actions) {
+    const uint16_t stripe_count =
+        (uint16_t)((scs_ptr->seq_header.max_frame_height + REST_PAD_STRIPE_HEIGHT - 1) /
+                   REST_PAD_STRIPE_HEIGHT);
+
+    pcs_ptr->rest_sse[0] = pcs_ptr->rest_sse[1] = pcs_ptr->rest_sse[2] = 0;
+    if (pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE) {
+        pcs_ptr->rest_pad_stripes_ready = 0;
+        EB_MEMSET(pcs_ptr->rest_pad_stripe_done,
+                  EB_FALSE,
+                  sizeof(*pcs_ptr->rest_pad_stripe_done) * stripe_count);
+    }
+    if (scs_ptr->static_config.stat_report ||
+        pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE)
+        rest_set_stripes(pcs_ptr, actions, REST_TASKS_PAD_STRIPE_INPUT, stripe_count);
+    else
+        actions->finish_picture = EB_TRUE;
+}
+
+/******************************************************
+ * Run the actions a job decided under rest_search_mutex,
+ * after releasing it.
+ ******************************************************/
+static void rest_run_actions(RestContext *context_ptr, PictureControlSet *pcs_ptr,
+                             SequenceControlSet *scs_ptr, EbObjectWrapper *pcs_wrapper_ptr,
+                             const RestActions *actions) {
+    if (actions->post_reference) rest_post_reference(context_ptr, pcs_ptr);
+    if (actions->stripe_count)
+        rest_post_stripes(
+            context_ptr, pcs_wrapper_ptr, actions->stripe_input_type, actions->stripe_count);
+    if (actions->finish_picture)
+        rest_finish_picture(context_ptr, pcs_ptr, scs_ptr, pcs_wrapper_ptr);
+}
+
+/******************************************************
+ * Rest Job
+ *   Processes one CDEF result or Rest stripe task.
+ ******************************************************/
+void rest_job(EbThreadContext *thread_context_ptr, EbObjectWrapper *cdef_results_wrapper_ptr) {
     // Context & SCS & PCS
-    EbThreadContext *   thread_context_ptr = (EbThreadContext *)input_ptr;
-    RestContext *       context_ptr        = (RestContext *)thread_context_ptr->priv;
+    RestContext *       context_ptr = (RestContext *)thread_context_ptr->priv;
     PictureControlSet * pcs_ptr;
     SequenceControlSet *scs_ptr;
     FrameHeader *       frm_hdr;
 
     //// Input
-    EbObjectWrapper *cdef_results_wrapper_ptr;
     CdefResults *    cdef_results_ptr;
 
-    //// Output
-    EbObjectWrapper *    rest_results_wrapper_ptr;
-    RestResults *        rest_results_ptr;
-    EbObjectWrapper *    picture_demux_results_wrapper_ptr;
-    PictureDemuxResults *picture_demux_results_rtr;
-    // SB Loop variables
-
-    for (;;) {
-        // Get Cdef Results
-        eb_get_full_object(context_ptr->rest_input_fifo_ptr, &cdef_results_wrapper_ptr);
+    cdef_results_ptr = (CdefResults *)cdef_results_wrapper_ptr->object_ptr;
+    pcs_ptr          = (PictureControlSet *)cdef_results_ptr->pcs_wrapper_ptr->object_ptr;
+    scs_ptr          = (SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr;
+    frm_hdr          = &pcs_ptr->parent_pcs_ptr->frm_hdr;
+    EbBool     is_16bit = (EbBool)(scs_ptr->static_config.encoder_bit_depth > EB_8BIT);
+    Av1Common *cm       = pcs_ptr->parent_pcs_ptr->av1_cm;
+    RestActions actions = {EB_FALSE, 0, 0, EB_FALSE};
+    eb_pipeline_stats_set_picture(pcs_ptr->picture_number);
+
+    if (cdef_results_ptr->input_type == REST_TASKS_LR_STRIPE_INPUT) {
+        // Apply the selected filters to one stripe, from this thread's copy of the recon
+        Yv12BufferConfig frame_copy;
+        link_eb_to_aom_buffer_desc(context_ptr->org_rec_frame, &frame_copy);
+        eb_av1_loop_restoration_filter_frame_stripe(cm->frame_to_show,
+                                                    &frame_copy,
+                                                    cm,
+                                                    context_ptr->rst_tmpbuf,
+                                                    cdef_results_ptr->segment_index,
+                                                    pcs_ptr->rest_stripes_total_count);
 
-        cdef_results_ptr = (CdefResults *)cdef_results_wrapper_ptr->object_ptr;
-        pcs_ptr          = (PictureControlSet *)cdef_results_ptr->pcs_wrapper_ptr->object_ptr;
-        scs_ptr          = (SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr;
-        frm_hdr          = &pcs_ptr->parent_pcs_ptr->frm_hdr;
-        uint8_t    sb_size_log2 = (uint8_t)Log2f(scs_ptr->sb_size_pix);
-        EbBool     is_16bit     = (EbBool)(scs_ptr->static_config.encoder_bit_depth > EB_8BIT);
-        Av1Common *cm           = pcs_ptr->parent_pcs_ptr->av1_cm;
+        eb_block_on_mutex(pcs_ptr->rest_search_mutex);
+        pcs_ptr->tot_stripes_done_rest++;
+        if (pcs_ptr->tot_stripes_done_rest == pcs_ptr->rest_stripes_total_count)
+            rest_set_pad_stripes(pcs_ptr, scs_ptr, &actions);
+        eb_release_mutex(pcs_ptr->rest_search_mutex);
+    } else if (cdef_results_ptr->input_type == REST_TASKS_PAD_STRIPE_INPUT) {
+        uint64_t sse_total[3] = {0};
+        uint32_t row_start    = cdef_results_ptr->segment_index * REST_PAD_STRIPE_HEIGHT;
+        uint32_t row_end      = row_start + REST_PAD_STRIPE_HEIGHT;
+
+        if (scs_ptr->static_config.stat_report)
+            psnr_calculations_rows(pcs_ptr, scs_ptr, row_start, row_end, sse_total);
+        if (pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE) {
+            pad_ref_rows(pcs_ptr, scs_ptr, row_start, row_end);
+            if (cdef_results_ptr->segment_index == 0) pad_ref_border(pcs_ptr, scs_ptr, EB_TRUE);
+        }
 
+        eb_block_on_mutex(pcs_ptr->rest_search_mutex);
+        pcs_ptr->rest_sse[0] += sse_total[0];
+        pcs_ptr->rest_sse[1] += sse_total[1];
+        pcs_ptr->rest_sse[2] += sse_total[2];
+        if (pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE)
+            rest_publish_pad_stripe(pcs_ptr, cdef_results_ptr->segment_index);
+        pcs_ptr->tot_stripes_done_rest++;
+        if (pcs_ptr->tot_stripes_done_rest == pcs_ptr->rest_stripes_total_count)
+            actions.finish_picture = EB_TRUE;
+        eb_release_mutex(pcs_ptr->rest_search_mutex);
+    } else {
         if (scs_ptr->seq_header.enable_restoration && frm_hdr->allow_intrabc == 0) {
             get_own_recon(scs_ptr, pcs_ptr, context_ptr, is_16bit);
 
             Yv12BufferConfig cpi_source;
-            link_eb_to_aom_buffer_desc(is_16bit ? pcs_ptr->input_frame16bit
-                                                : pcs_ptr->parent_pcs_ptr->enhanced_picture_ptr,
+            link_eb_to_aom_buffer_desc(is_16bit
+                                           ? pcs_ptr->input_frame16bit
+                                           : pcs_ptr->parent_pcs_ptr->enhanced_picture_ptr,
                                        &cpi_source);
 
             Yv12BufferConfig trial_frame_rst;
@@ -286,18 +505,21 @@ void *rest_kernel(void *input_ptr) {
                                    cdef_results_ptr->segment_index);
         }
 
-        //all seg based search is done. update total processed segments. if all done, finish the search and perfrom application.
+        //all seg based search is done. update total processed segments. if all done, finish the search and post the application stripes.
         eb_block_on_mutex(pcs_ptr->rest_search_mutex);
 
         pcs_ptr->tot_seg_searched_rest++;
         if (pcs_ptr->tot_seg_searched_rest == pcs_ptr->rest_segments_total_count) {
+            int32_t lr_stripe_count = 0;
             if (scs_ptr->seq_header.enable_restoration && frm_hdr->allow_intrabc == 0) {
-                rest_finish_search(pcs_ptr->parent_pcs_ptr->av1x, pcs_ptr->parent_pcs_ptr->av1_cm);
+                rest_finish_search(pcs_ptr->parent_pcs_ptr->av1x,
+                                   pcs_ptr->parent_pcs_ptr->av1_cm);
 
                 if (cm->rst_info[0].frame_restoration_type != RESTORE_NONE ||
                     cm->rst_info[1].frame_restoration_type != RESTORE_NONE ||
                     cm->rst_info[2].frame_restoration_type != RESTORE_NONE) {
-                    eb_av1_loop_restoration_filter_frame(cm->frame_to_show, cm, 0);
+                    lr_stripe_count =
+                        eb_av1_loop_restoration_filter_frame_init(cm->frame_to_show, cm, 0);
                 }
             } else {
                 cm->rst_info[0].frame_restoration_type = RESTORE_NONE;
@@ -320,46 +542,47 @@ void *rest_kernel(void *input_ptr) {
                 copy_statistics_to_ref_obj_ect(pcs_ptr, scs_ptr);
             }
 
-            // PSNR Calculation
-            if (scs_ptr->static_config.stat_report) psnr_calculations(pcs_ptr, scs_ptr);
-
-            // Pad the reference picture and set ref POC
-            if (pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE)
-                pad_ref_and_set_flags(pcs_ptr, scs_ptr);
-            if (scs_ptr->static_config.recon_enabled) { recon_output(pcs_ptr, scs_ptr); }
-
-            if (pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag) {
-                // Get Empty PicMgr Results
-                eb_get_empty_object(context_ptr->picture_demux_fifo_ptr,
-                                    &picture_demux_results_wrapper_ptr);
-
-                picture_demux_results_rtr =
-                    (PictureDemuxResults *)picture_demux_results_wrapper_ptr->object_ptr;
-                picture_demux_results_rtr->reference_picture_wrapper_ptr =
-                    pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr;
-                picture_demux_results_rtr->scs_wrapper_ptr = pcs_ptr->scs_wrapper_ptr;
-                picture_demux_results_rtr->picture_number  = pcs_ptr->picture_number;
-                picture_demux_results_rtr->picture_type    = EB_PIC_REFERENCE;
-
-                // Post Reference Picture
-                eb_post_full_object(picture_demux_results_wrapper_ptr);
+            if (pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE) {
+                EbReferenceObject *ref_obj = (EbReferenceObject *)pcs_ptr->parent_pcs_ptr
+                                                 ->reference_picture_wrapper_ptr->object_ptr;
+                eb_atomic_store32(&ref_obj->final_rows, 0);
+                // every filter decision is made: the pictures referencing this one may start
+                // their MD, each SB row of EncDec waiting on final_rows as the stripes below
+                // complete it
+                if (scs_ptr->static_config.inter_frame_wavefront) {
+                    set_ref_flags(pcs_ptr);
+                    actions.post_reference = EB_TRUE;
+                }
             }
 
-            // Get Empty rest Results to EC
-            eb_get_empty_object(context_ptr->rest_output_fifo_ptr, &rest_results_wrapper_ptr);
-            rest_results_ptr = (struct RestResults *)rest_results_wrapper_ptr->object_ptr;
-            rest_results_ptr->pcs_wrapper_ptr              = cdef_results_ptr->pcs_wrapper_ptr;
-            rest_results_ptr->completed_sb_row_index_start = 0;
-            rest_results_ptr->completed_sb_row_count =
-                ((scs_ptr->seq_header.max_frame_height + scs_ptr->sb_size_pix - 1) >> sb_size_log2);
-            // Post Rest Results
-            eb_post_full_object(rest_results_wrapper_ptr);
+            if (lr_stripe_count)
+                rest_set_stripes(
+                    pcs_ptr, &actions, REST_TASKS_LR_STRIPE_INPUT, (uint16_t)lr_stripe_count);
+            else
+                rest_set_pad_stripes(pcs_ptr, scs_ptr, &actions);
         }
         eb_release_mutex(pcs_ptr->rest_search_mutex);
-
-        // Release input Results
-        eb_release_object(cdef_results_wrapper_ptr);
     }
 
+    rest_run_actions(context_ptr, pcs_ptr, scs_ptr, cdef_results_ptr->pcs_wrapper_ptr, &actions);
+
+    // Release input Results
+    eb_release_object(cdef_results_wrapper_ptr);
+}
+
+/******************************************************
+ * Rest Kernel
+ ******************************************************/
+void *rest_kernel(void *input_ptr) {
+    EbThreadContext *thread_context_ptr = (EbThreadContext *)input_ptr;
+    RestContext *    context_ptr        = (RestContext *)thread_context_ptr->priv;
+    EbObjectWrapper *cdef_results_wrapper_ptr;
+
+    for (;;) {
+        // Get Cdef Results
+        eb_get_full_object(context_ptr->rest_input_fifo_ptr, &cdef_results_wrapper_ptr);
+
+        rest_job(thread_context_ptr, cdef_results_wrapper_ptr);
+    }
     return EB_NULL;
 }
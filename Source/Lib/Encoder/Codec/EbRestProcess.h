@@ -12,8 +12,11 @@
  * Extern Function Declarations
  **************************************/
 extern EbErrorType rest_context_ctor(EbThreadContext *  thread_context_ptr,
-                                     const EbEncHandle *enc_handle_ptr, int index, int demux_index);
+                                     const EbEncHandle *enc_handle_ptr, int index, int demux_index,
+                                     int feedback_index);
 
+extern void rest_job(EbThreadContext *thread_context_ptr,
+                     EbObjectWrapper *cdef_results_wrapper_ptr);
 extern void *rest_kernel(void *input_ptr);
 
 #endif
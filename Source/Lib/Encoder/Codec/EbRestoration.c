@@ -1540,6 +1540,150 @@ void av1_foreach_rest_unit_in_frame_seg(Av1Common *cm, int32_t plane, RestTileSt
                                   segment_index);
 }
 
+// Visit the units of rows [unit_row_start, unit_row_end) of a plane, using the same unit
+// limits as foreach_rest_unit_in_tile.
+static void foreach_rest_unit_in_rows(const Av1PixelRect *tile_rect, int32_t hunits_per_tile,
+                                      int32_t unit_size, int32_t ss_y, int32_t unit_row_start,
+                                      int32_t unit_row_end, RestUnitVisitor on_rest_unit,
+                                      void *priv) {
+    const int32_t tile_w   = tile_rect->right - tile_rect->left;
+    const int32_t tile_h   = tile_rect->bottom - tile_rect->top;
+    const int32_t ext_size = unit_size * 3 / 2;
+    const int32_t voffset  = RESTORATION_UNIT_OFFSET >> ss_y;
+
+    int32_t y0 = unit_row_start * unit_size, i = unit_row_start;
+    while (y0 < tile_h && i < unit_row_end) {
+        int32_t remaining_h = tile_h - y0;
+        int32_t h           = (remaining_h < ext_size) ? remaining_h : unit_size;
+
+        RestorationTileLimits limits;
+        limits.v_start = AOMMAX(tile_rect->top, tile_rect->top + y0 - voffset);
+        limits.v_end   = tile_rect->top + y0 + h;
+        if (limits.v_end < tile_rect->bottom) limits.v_end -= voffset;
+
+        int32_t x0 = 0, j = 0;
+        while (x0 < tile_w) {
+            int32_t remaining_w = tile_w - x0;
+            int32_t w           = (remaining_w < ext_size) ? remaining_w : unit_size;
+
+            limits.h_start = tile_rect->left + x0;
+            limits.h_end   = tile_rect->left + x0 + w;
+
+            on_rest_unit(&limits, tile_rect, i * hunits_per_tile + j, priv);
+
+            x0 += w;
+            ++j;
+        }
+
+        y0 += h;
+        ++i;
+    }
+}
+
+// Prepare the frame for eb_av1_loop_restoration_filter_frame_stripe() and return the number
+// of stripes it can be split into (the unit rows of the plane with the most of them).
+int32_t eb_av1_loop_restoration_filter_frame_init(Yv12BufferConfig *frame, Av1Common *cm,
+                                                  int32_t optimized_lr) {
+    const int32_t num_planes   = 3; // av1_num_planes(cm);
+    int32_t       stripe_count = 0;
+
+    for (int32_t plane = 0; plane < num_planes; ++plane) {
+        RestorationInfo *rsi = &cm->rst_info[plane];
+        rsi->optimized_lr    = optimized_lr;
+        if (rsi->frame_restoration_type == RESTORE_NONE) continue;
+
+        const int32_t is_uv = plane > 0;
+        eb_extend_frame(frame->buffers[plane],
+                        frame->crop_widths[is_uv],
+                        frame->crop_heights[is_uv],
+                        frame->strides[is_uv],
+                        RESTORATION_BORDER,
+                        RESTORATION_BORDER,
+                        cm->use_highbitdepth);
+        stripe_count = AOMMAX(stripe_count, rsi->vert_units_per_tile);
+    }
+    return stripe_count;
+}
+
+// Apply the selected filters to one horizontal stripe of the frame: stripe_index out of
+// stripe_count splits the unit rows of every plane evenly, so concurrent stripes never write
+// the same rows. setup_processing_stripe_boundary() temporarily overwrites the rows around
+// each processing stripe of its source, so the stripe is first copied to the caller-owned
+// frame_copy (same geometry as frame) and filtered from there straight back into frame.
+void eb_av1_loop_restoration_filter_frame_stripe(Yv12BufferConfig *frame,
+                                                 Yv12BufferConfig *frame_copy, Av1Common *cm,
+                                                 int32_t *tmpbuf, int32_t stripe_index,
+                                                 int32_t stripe_count) {
+    const int32_t num_planes = 3; // av1_num_planes(cm);
+    const int32_t bit_depth  = cm->bit_depth;
+    const int32_t highbd     = cm->use_highbitdepth;
+
+    RestorationLineBuffers rlbs;
+
+    for (int32_t plane = 0; plane < num_planes; ++plane) {
+        const RestorationInfo *rsi = &cm->rst_info[plane];
+        if (rsi->frame_restoration_type == RESTORE_NONE) continue;
+
+        const int32_t unit_row_start =
+            SEGMENT_START_IDX(stripe_index, rsi->vert_units_per_tile, stripe_count);
+        const int32_t unit_row_end =
+            SEGMENT_END_IDX(stripe_index, rsi->vert_units_per_tile, stripe_count);
+        if (unit_row_start == unit_row_end) continue;
+
+        const int32_t      is_uv     = plane > 0;
+        const int32_t      ss_y      = is_uv && cm->subsampling_y;
+        const int32_t      unit_size = rsi->restoration_unit_size;
+        const int32_t      voffset   = RESTORATION_UNIT_OFFSET >> ss_y;
+        const Av1PixelRect tile_rect =
+            whole_frame_rect(&cm->frm_size, cm->subsampling_x, cm->subsampling_y, is_uv);
+
+        // Rows owned by the stripe, plus the frame extension at the top and bottom of the frame;
+        // every other row around the stripe is replaced from the saved stripe boundaries.
+        int32_t row_start = AOMMAX(tile_rect.top, unit_row_start * unit_size - voffset);
+        int32_t row_end   = (unit_row_end == rsi->vert_units_per_tile)
+                              ? tile_rect.bottom
+                              : unit_row_end * unit_size - voffset;
+        if (row_start == tile_rect.top) row_start -= RESTORATION_BORDER;
+        if (row_end == tile_rect.bottom) row_end += RESTORATION_BORDER;
+
+        uint8_t *     data8       = frame_copy->buffers[plane];
+        uint8_t *     dst8        = frame->buffers[plane];
+        const int32_t data_stride = frame_copy->strides[is_uv];
+        const int32_t dst_stride  = frame->strides[is_uv];
+        const int32_t line_size =
+            (tile_rect.right - tile_rect.left + 2 * RESTORATION_EXTRA_HORZ) << highbd;
+
+        for (int32_t row = row_start; row < row_end; ++row)
+            memcpy(REAL_PTR(highbd, data8 + row * data_stride - RESTORATION_EXTRA_HORZ),
+                   REAL_PTR(highbd, dst8 + row * dst_stride - RESTORATION_EXTRA_HORZ),
+                   line_size);
+
+        FilterFrameCtxt ctxt;
+        ctxt.rsi         = rsi;
+        ctxt.rlbs        = &rlbs;
+        ctxt.cm          = cm;
+        ctxt.ss_x        = is_uv && cm->subsampling_x;
+        ctxt.ss_y        = ss_y;
+        ctxt.highbd      = highbd;
+        ctxt.bit_depth   = bit_depth;
+        ctxt.data8       = data8;
+        ctxt.dst8        = dst8;
+        ctxt.data_stride = data_stride;
+        ctxt.dst_stride  = dst_stride;
+        ctxt.tmpbuf      = tmpbuf;
+
+        filter_frame_on_tile(0, 0, &ctxt);
+        foreach_rest_unit_in_rows(&tile_rect,
+                                  rsi->horz_units_per_tile,
+                                  unit_size,
+                                  ss_y,
+                                  unit_row_start,
+                                  unit_row_end,
+                                  filter_frame_on_unit,
+                                  &ctxt);
+    }
+}
+
 int32_t eb_av1_loop_restoration_corners_in_sb(Av1Common *cm, int32_t plane, int32_t mi_row,
                                               int32_t mi_col, BlockSize bsize, int32_t *rcol0,
                                               int32_t *rcol1, int32_t *rrow0, int32_t *rrow1,
@@ -288,6 +288,14 @@ EbErrorType copy_sequence_control_set(SequenceControlSet *dst, SequenceControlSe
     write_count += sizeof(int32_t);
     dst->reference_picture_buffer_init_count = src->reference_picture_buffer_init_count;
     write_count += sizeof(int32_t);
+    dst->picture_control_set_pool_min_count = src->picture_control_set_pool_min_count;
+    write_count += sizeof(int32_t);
+    dst->picture_control_set_pool_min_count_child = src->picture_control_set_pool_min_count_child;
+    write_count += sizeof(int32_t);
+    dst->pa_reference_picture_buffer_min_count = src->pa_reference_picture_buffer_min_count;
+    write_count += sizeof(int32_t);
+    dst->reference_picture_buffer_min_count = src->reference_picture_buffer_min_count;
+    write_count += sizeof(int32_t);
     dst->input_buffer_fifo_init_count = src->input_buffer_fifo_init_count;
     write_count += sizeof(int32_t);
     dst->overlay_input_picture_buffer_init_count = src->overlay_input_picture_buffer_init_count;
@@ -364,6 +372,7 @@ EbErrorType copy_sequence_control_set(SequenceControlSet *dst, SequenceControlSe
     dst->down_sampling_method_me_search = src->down_sampling_method_me_search;
     dst->tf_segment_column_count        = src->tf_segment_column_count;
     dst->tf_segment_row_count           = src->tf_segment_row_count;
+    dst->pa_segment_row_count           = src->pa_segment_row_count;
     dst->over_boundary_block_mode       = src->over_boundary_block_mode;
     dst->mfmv_enabled                   = src->mfmv_enabled;
     dst->use_input_stat_file            = src->use_input_stat_file;
@@ -112,6 +112,7 @@ typedef struct SequenceControlSet {
     uint32_t rest_segment_row_count;
     uint32_t tf_segment_column_count;
     uint32_t tf_segment_row_count;
+    uint32_t pa_segment_row_count;
     EbBool   enable_altrefs;
     uint32_t
         scd_delay; //Number of delay frames needed to implement future window for algorithms such as SceneChange or TemporalFiltering
@@ -120,6 +121,11 @@ typedef struct SequenceControlSet {
     uint32_t picture_control_set_pool_init_count_child;
     uint32_t pa_reference_picture_buffer_init_count;
     uint32_t reference_picture_buffer_init_count;
+    // Objects the pools above start with when they grow on demand
+    uint32_t picture_control_set_pool_min_count;
+    uint32_t picture_control_set_pool_min_count_child;
+    uint32_t pa_reference_picture_buffer_min_count;
+    uint32_t reference_picture_buffer_min_count;
     uint32_t input_buffer_fifo_init_count;
     uint32_t overlay_input_picture_buffer_init_count;
     uint32_t output_stream_buffer_fifo_init_count;
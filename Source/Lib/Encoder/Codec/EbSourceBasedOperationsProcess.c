@@ -12,6 +12,7 @@
 #include "emmintrin.h"
 #include "EbEncHandle.h"
 #include "EbUtility.h"
+#include "EbPipelineStats.h"
 
 /**************************************
  * Context
@@ -99,69 +100,82 @@ void derive_picture_activity_statistics(SequenceControlSet *     scs_ptr,
 }
 
 /************************************************
- * Source Based Operations Kernel
+ * Source Based Operations Job
+ *   Processes one Initial Rate Control result.
  ************************************************/
-void *source_based_operations_kernel(void *input_ptr) {
-    EbThreadContext *             thread_context_ptr = (EbThreadContext *)input_ptr;
+void source_based_operations_job(EbThreadContext *thread_context_ptr,
+                                 EbObjectWrapper *in_results_wrapper_ptr) {
     SourceBasedOperationsContext *context_ptr =
         (SourceBasedOperationsContext *)thread_context_ptr->priv;
     PictureParentControlSet *  pcs_ptr;
     SequenceControlSet *       scs_ptr;
-    EbObjectWrapper *          in_results_wrapper_ptr;
     InitialRateControlResults *in_results_ptr;
     EbObjectWrapper *          out_results_wrapper_ptr;
     PictureDemuxResults *      out_results_ptr;
 
-    for (;;) {
-        // Get Input Full Object
-        eb_get_full_object(context_ptr->initial_rate_control_results_input_fifo_ptr,
-                           &in_results_wrapper_ptr);
+    in_results_ptr = (InitialRateControlResults *)in_results_wrapper_ptr->object_ptr;
+    pcs_ptr        = (PictureParentControlSet *)in_results_ptr->pcs_wrapper_ptr->object_ptr;
+    scs_ptr        = (SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr;
+    pcs_ptr->dark_back_groundlight_fore_ground = EB_FALSE;
+    context_ptr->complete_sb_count             = 0;
+    uint32_t sb_total_count                    = pcs_ptr->sb_total_count;
+    uint32_t sb_index;
+    eb_pipeline_stats_set_picture(pcs_ptr->picture_number);
 
-        in_results_ptr = (InitialRateControlResults *)in_results_wrapper_ptr->object_ptr;
-        pcs_ptr        = (PictureParentControlSet *)in_results_ptr->pcs_wrapper_ptr->object_ptr;
-        scs_ptr        = (SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr;
-        pcs_ptr->dark_back_groundlight_fore_ground = EB_FALSE;
-        context_ptr->complete_sb_count             = 0;
-        uint32_t sb_total_count                    = pcs_ptr->sb_total_count;
-        uint32_t sb_index;
+    /***********************************************SB-based operations************************************************************/
+    for (sb_index = 0; sb_index < sb_total_count; ++sb_index) {
+        SbParams *sb_params      = &scs_ptr->sb_params_array[sb_index];
+        EbBool    is_complete_sb = sb_params->is_complete_sb;
+        uint8_t * y_mean_ptr     = pcs_ptr->y_mean[sb_index];
 
-        /***********************************************SB-based operations************************************************************/
-        for (sb_index = 0; sb_index < sb_total_count; ++sb_index) {
-            SbParams *sb_params      = &scs_ptr->sb_params_array[sb_index];
-            EbBool    is_complete_sb = sb_params->is_complete_sb;
-            uint8_t * y_mean_ptr     = pcs_ptr->y_mean[sb_index];
+        _mm_prefetch((const char *)y_mean_ptr, _MM_HINT_T0);
+        uint8_t *cr_mean_ptr = pcs_ptr->cr_mean[sb_index];
+        uint8_t *cb_mean_ptr = pcs_ptr->cb_mean[sb_index];
 
-            _mm_prefetch((const char *)y_mean_ptr, _MM_HINT_T0);
-            uint8_t *cr_mean_ptr = pcs_ptr->cr_mean[sb_index];
-            uint8_t *cb_mean_ptr = pcs_ptr->cb_mean[sb_index];
+        _mm_prefetch((const char *)cr_mean_ptr, _MM_HINT_T0);
+        _mm_prefetch((const char *)cb_mean_ptr, _MM_HINT_T0);
 
-            _mm_prefetch((const char *)cr_mean_ptr, _MM_HINT_T0);
-            _mm_prefetch((const char *)cb_mean_ptr, _MM_HINT_T0);
+        context_ptr->y_mean_ptr  = y_mean_ptr;
+        context_ptr->cr_mean_ptr = cr_mean_ptr;
+        context_ptr->cb_mean_ptr = cb_mean_ptr;
 
-            context_ptr->y_mean_ptr  = y_mean_ptr;
-            context_ptr->cr_mean_ptr = cr_mean_ptr;
-            context_ptr->cb_mean_ptr = cb_mean_ptr;
+        if (is_complete_sb) { context_ptr->complete_sb_count++; }
+    }
+    /*********************************************Picture-based operations**********************************************************/
 
-            if (is_complete_sb) { context_ptr->complete_sb_count++; }
-        }
-        /*********************************************Picture-based operations**********************************************************/
+    // Activity statistics derivation
+    derive_picture_activity_statistics(scs_ptr, pcs_ptr);
 
-        // Activity statistics derivation
-        derive_picture_activity_statistics(scs_ptr, pcs_ptr);
+    // Get Empty Results Object
+    eb_get_empty_object(context_ptr->picture_demux_results_output_fifo_ptr,
+                        &out_results_wrapper_ptr);
 
-        // Get Empty Results Object
-        eb_get_empty_object(context_ptr->picture_demux_results_output_fifo_ptr,
-                            &out_results_wrapper_ptr);
+    out_results_ptr = (PictureDemuxResults *)out_results_wrapper_ptr->object_ptr;
+    out_results_ptr->pcs_wrapper_ptr = in_results_ptr->pcs_wrapper_ptr;
+    out_results_ptr->picture_type    = EB_PIC_INPUT;
 
-        out_results_ptr = (PictureDemuxResults *)out_results_wrapper_ptr->object_ptr;
-        out_results_ptr->pcs_wrapper_ptr = in_results_ptr->pcs_wrapper_ptr;
-        out_results_ptr->picture_type    = EB_PIC_INPUT;
+    // Release the Input Results
+    eb_release_object(in_results_wrapper_ptr);
 
-        // Release the Input Results
-        eb_release_object(in_results_wrapper_ptr);
+    // Post the Full Results Object
+    eb_post_full_object(out_results_wrapper_ptr);
+}
+
+/******************************************************
+ * Source Based Operations Kernel
+ ******************************************************/
+void *source_based_operations_kernel(void *input_ptr) {
+    EbThreadContext *             thread_context_ptr = (EbThreadContext *)input_ptr;
+    SourceBasedOperationsContext *context_ptr =
+        (SourceBasedOperationsContext *)thread_context_ptr->priv;
+    EbObjectWrapper *             in_results_wrapper_ptr;
+
+    for (;;) {
+        // Get Input Full Object
+        eb_get_full_object(context_ptr->initial_rate_control_results_input_fifo_ptr,
+                           &in_results_wrapper_ptr);
 
-        // Post the Full Results Object
-        eb_post_full_object(out_results_wrapper_ptr);
+        source_based_operations_job(thread_context_ptr, in_results_wrapper_ptr);
     }
     return EB_NULL;
 }
@@ -26,6 +26,8 @@
 EbErrorType source_based_operations_context_ctor(EbThreadContext *  thread_context_ptr,
                                                  const EbEncHandle *enc_handle_ptr, int index);
 
+extern void source_based_operations_job(EbThreadContext *thread_context_ptr,
+                                        EbObjectWrapper *in_results_wrapper_ptr);
 extern void *source_based_operations_kernel(void *input_ptr);
 
 #endif // EbSourceBasedOperations_h
@@ -7,7 +7,11 @@
 
 #include "EbSystemResourceManager.h"
 #include "EbDefinitions.h"
+#include "EbUtility.h"
 #include "EbThreads.h"
+#include "EbThreadPool.h"
+#include "EbPipelineStats.h"
+#include "EbTime.h"
 
 void eb_fifo_dctor(EbPtr p) {
     EbFifo *obj = (EbFifo *)p;
@@ -33,6 +37,7 @@ static EbErrorType eb_fifo_ctor(EbFifo *fifoPtr, uint32_t initial_count, uint32_
 
     // Copy the Muxing Queue ptr this Fifo belongs to
     fifoPtr->queue_ptr = queue_ptr;
+    fifoPtr->numa_node = EB_NUMA_NODE_ANY;
 
     return EB_ErrorNone;
 }
@@ -165,11 +170,218 @@ static EbErrorType eb_circular_buffer_push_front(EbCircularBuffer *bufferPtr, Eb
     return return_error;
 }
 
+/**************************************
+ * eb_circular_buffer_remove_at
+ *   Removes the object offset entries past the head, the objects before
+ *   it move up by one
+ **************************************/
+static void eb_circular_buffer_remove_at(EbCircularBuffer *bufferPtr, uint32_t offset) {
+    uint32_t index = (bufferPtr->head_index + offset) % bufferPtr->buffer_total_count;
+
+    while (index != bufferPtr->head_index) {
+        uint32_t prev_index = index ? index - 1 : bufferPtr->buffer_total_count - 1;
+        bufferPtr->array_ptr[index] = bufferPtr->array_ptr[prev_index];
+        index                       = prev_index;
+    }
+    bufferPtr->array_ptr[bufferPtr->head_index] = EB_NULL;
+    bufferPtr->head_index = (bufferPtr->head_index == bufferPtr->buffer_total_count - 1)
+                                ? 0
+                                : bufferPtr->head_index + 1;
+    --bufferPtr->current_count;
+}
+
+/**************************************
+ * eb_muxing_queue_pop_process
+ *   Takes the first waiting process of the node of the object, or the
+ *   first waiting process when none is
+ **************************************/
+static EbFifo *eb_muxing_queue_pop_process(EbMuxingQueue *queue_ptr, int32_t numa_node) {
+    EbCircularBuffer *process_queue = queue_ptr->process_queue;
+    EbFifo *          process_fifo_ptr;
+
+    if (numa_node != EB_NUMA_NODE_ANY) {
+        for (uint32_t offset = 0; offset < process_queue->current_count; offset++) {
+            process_fifo_ptr = (EbFifo *)process_queue->array_ptr[
+                (process_queue->head_index + offset) % process_queue->buffer_total_count];
+            if (process_fifo_ptr->numa_node == numa_node) {
+                eb_circular_buffer_remove_at(process_queue, offset);
+                return process_fifo_ptr;
+            }
+        }
+    }
+    eb_circular_buffer_pop_front(process_queue, (void **)&process_fifo_ptr);
+    return process_fifo_ptr;
+}
+
+/**************************************
+ * Lock-free ring
+ **************************************/
+// The queue kind and the NUMA spread are settings of the thread constructing the
+// SystemResources, each resource keeps the queues and placement it was constructed with
+#ifdef EB_LOCKFREE_QUEUE
+static EB_THREAD_LOCAL EbBool lockfree_queue = EB_TRUE;
+#else
+static EB_THREAD_LOCAL EbBool lockfree_queue = EB_FALSE;
+#endif
+
+// Spin iterations before a waiter blocks on the OS semaphore
+#define EB_LOCKFREE_SPIN_COUNT 2000
+// Spin iterations before yielding to a thread that is mid push/pop
+#define EB_LOCKFREE_YIELD_COUNT 64
+#define EB_LOCKFREE_MAX_WAITERS 0x7FFFFFFF
+// Ring positions wrap around, step them in unsigned arithmetic
+#define EB_LOCKFREE_NEXT(pos, step) ((int32_t)((uint32_t)(pos) + (uint32_t)(step)))
+
+void eb_system_resource_set_lockfree(EbBool enable) { lockfree_queue = enable; }
+
+EbBool eb_system_resource_get_lockfree(void) { return lockfree_queue; }
+
+static EB_THREAD_LOCAL EbBool numa_spread = EB_FALSE;
+
+void eb_system_resource_set_numa_spread(EbBool enable) { numa_spread = enable; }
+
+static void eb_lockfree_ring_dctor(EbPtr p) {
+    EbLockFreeRing *obj = (EbLockFreeRing *)p;
+    EB_DESTROY_SEMAPHORE(obj->os_semaphore);
+    EB_FREE(obj->cell_array);
+}
+
+/**************************************
+ * eb_lockfree_ring_ctor
+ **************************************/
+static EbErrorType eb_lockfree_ring_ctor(EbLockFreeRing *ring_ptr, uint32_t object_total_count) {
+    int32_t cell_count = 1;
+
+    ring_ptr->dctor = eb_lockfree_ring_dctor;
+
+    // Power of two cells, at least one per object so push never waits on
+    //   a full ring
+    while ((uint32_t)cell_count < object_total_count) cell_count <<= 1;
+    EB_CALLOC(ring_ptr->cell_array, cell_count, sizeof(EbLockFreeCell));
+    for (int32_t cell_index = 0; cell_index < cell_count; ++cell_index)
+        ring_ptr->cell_array[cell_index].sequence = cell_index;
+    ring_ptr->mask = cell_count - 1;
+    // Spinning only pays off when the other side runs concurrently
+    ring_ptr->spin_count = eb_get_num_online_processors() > 1 ? EB_LOCKFREE_SPIN_COUNT : 0;
+
+    EB_CREATE_SEMAPHORE(ring_ptr->os_semaphore, 0, EB_LOCKFREE_MAX_WAITERS);
+
+    return EB_ErrorNone;
+}
+
+/**************************************
+ * eb_lockfree_ring_push_back
+ *   Claims the enqueue position with a CAS, then publishes the
+ *   object by advancing the cell sequence, and signals one waiter.
+ **************************************/
+static void eb_lockfree_ring_push_back(EbLockFreeRing *ring_ptr, EbObjectWrapper *wrapper_ptr) {
+    EbLockFreeCell *cell_ptr;
+    int32_t         pos  = eb_atomic_load32(&ring_ptr->enqueue_pos);
+    int32_t         spin = 0;
+
+    while (1) {
+        cell_ptr     = &ring_ptr->cell_array[pos & ring_ptr->mask];
+        int32_t diff = (int32_t)((uint32_t)eb_atomic_load32(&cell_ptr->sequence) - (uint32_t)pos);
+        if (diff == 0) {
+            if (eb_atomic_cas32(&ring_ptr->enqueue_pos, pos, EB_LOCKFREE_NEXT(pos, 1))) break;
+        } else if (++spin < EB_LOCKFREE_YIELD_COUNT)
+            eb_cpu_pause();
+        else
+            eb_yield_thread();
+        pos = eb_atomic_load32(&ring_ptr->enqueue_pos);
+    }
+
+    cell_ptr->wrapper_ptr = wrapper_ptr;
+    eb_atomic_store32(&cell_ptr->sequence, EB_LOCKFREE_NEXT(pos, 1));
+
+    // Wake a blocked waiter if there is one
+    if (eb_atomic_fetch_add32(&ring_ptr->available_count, 1) < 0)
+        eb_post_semaphore(ring_ptr->os_semaphore);
+    else if (eb_atomic_load32(&ring_ptr->pool_waiter_count) > 0)
+        eb_thread_pool_wake(ring_ptr->waiter_pool, ring_ptr);
+}
+
+/**************************************
+ * eb_lockfree_ring_pop_front
+ *   Must follow a successful wait, so an object is guaranteed; the
+ *   cell may still be in the middle of being published by a producer
+ *   that claimed an earlier position.
+ **************************************/
+static EbObjectWrapper *eb_lockfree_ring_pop_front(EbLockFreeRing *ring_ptr) {
+    EbLockFreeCell * cell_ptr;
+    EbObjectWrapper *wrapper_ptr;
+    int32_t          pos  = eb_atomic_load32(&ring_ptr->dequeue_pos);
+    int32_t          spin = 0;
+
+    while (1) {
+        cell_ptr     = &ring_ptr->cell_array[pos & ring_ptr->mask];
+        int32_t diff = (int32_t)((uint32_t)eb_atomic_load32(&cell_ptr->sequence) -
+                                 (uint32_t)EB_LOCKFREE_NEXT(pos, 1));
+        if (diff == 0) {
+            if (eb_atomic_cas32(&ring_ptr->dequeue_pos, pos, EB_LOCKFREE_NEXT(pos, 1))) break;
+        } else if (++spin < EB_LOCKFREE_YIELD_COUNT)
+            eb_cpu_pause();
+        else
+            eb_yield_thread();
+        pos = eb_atomic_load32(&ring_ptr->dequeue_pos);
+    }
+
+    wrapper_ptr = cell_ptr->wrapper_ptr;
+    eb_atomic_store32(&cell_ptr->sequence, EB_LOCKFREE_NEXT(pos, ring_ptr->mask + 1));
+
+    return wrapper_ptr;
+}
+
+/**************************************
+ * eb_lockfree_ring_try_wait
+ *   Takes one object from available_count if there is one.
+ **************************************/
+static EbBool eb_lockfree_ring_try_wait(EbLockFreeRing *ring_ptr) {
+    int32_t count = eb_atomic_load32(&ring_ptr->available_count);
+    while (count > 0) {
+        if (eb_atomic_cas32(&ring_ptr->available_count, count, count - 1)) return EB_TRUE;
+        count = eb_atomic_load32(&ring_ptr->available_count);
+    }
+    return EB_FALSE;
+}
+
+static EbBool eb_lockfree_ring_ready(EbPtr ready_arg) {
+    return eb_lockfree_ring_try_wait((EbLockFreeRing *)ready_arg);
+}
+
+/**************************************
+ * eb_lockfree_ring_wait
+ *   Spins for an object, then registers as a waiter and blocks on
+ *   the OS semaphore until a push hands one over.
+ *   A thread pool worker does not take a turn on the OS semaphore:
+ *   the object may only come back once a job queued behind it has run,
+ *   so the worker runs the pending jobs itself and blocks in
+ *   eb_thread_pool_wait() when there are none. Pushes wake it while
+ *   pool_waiter_count is set, and so do the jobs posted to the pool.
+ **************************************/
+static void eb_lockfree_ring_wait(EbLockFreeRing *ring_ptr) {
+    for (int32_t spin = 0; spin < ring_ptr->spin_count; ++spin) {
+        if (eb_lockfree_ring_try_wait(ring_ptr)) return;
+        eb_cpu_pause();
+    }
+    if (eb_thread_pool_is_worker()) {
+        // Every worker waiting on a ring belongs to the pool of its encoder
+        ring_ptr->waiter_pool = eb_thread_pool_current();
+        eb_atomic_fetch_add32(&ring_ptr->pool_waiter_count, 1);
+        eb_thread_pool_wait(eb_lockfree_ring_ready, ring_ptr);
+        eb_atomic_fetch_add32(&ring_ptr->pool_waiter_count, -1);
+        return;
+    }
+    if (eb_atomic_fetch_add32(&ring_ptr->available_count, -1) <= 0)
+        eb_block_on_semaphore(ring_ptr->os_semaphore);
+}
+
 void eb_muxing_queue_dctor(EbPtr p) {
     EbMuxingQueue *obj = (EbMuxingQueue *)p;
     EB_DELETE_PTR_ARRAY(obj->process_fifo_ptr_array, obj->process_total_count);
     EB_DELETE(obj->object_queue);
     EB_DELETE(obj->process_queue);
+    EB_DELETE(obj->object_ring);
     EB_DESTROY_MUTEX(obj->lockout_mutex);
 }
 
@@ -187,10 +399,16 @@ static EbErrorType eb_muxing_queue_ctor(EbMuxingQueue *queue_ptr, uint32_t objec
     // Lockout Mutex
     EB_CREATE_MUTEX(queue_ptr->lockout_mutex);
 
-    // Construct Object Circular Buffer
-    EB_NEW(queue_ptr->object_queue, eb_circular_buffer_ctor, object_total_count);
-    // Construct Process Circular Buffer
-    EB_NEW(queue_ptr->process_queue, eb_circular_buffer_ctor, queue_ptr->process_total_count);
+    if (lockfree_queue) {
+        // Construct the Object Ring
+        EB_NEW(queue_ptr->object_ring, eb_lockfree_ring_ctor, object_total_count);
+    } else {
+        // Construct Object Circular Buffer
+        EB_NEW(queue_ptr->object_queue, eb_circular_buffer_ctor, object_total_count);
+        // Construct Process Circular Buffer
+        EB_NEW(
+            queue_ptr->process_queue, eb_circular_buffer_ctor, queue_ptr->process_total_count);
+    }
     // Construct the Process Fifos
     EB_ALLOC_PTR_ARRAY(queue_ptr->process_fifo_ptr_array, queue_ptr->process_total_count);
 
@@ -218,12 +436,12 @@ static EbErrorType eb_muxing_queue_assignation(EbMuxingQueue *queue_ptr) {
     // while loop
     while ((eb_circular_buffer_empty_check(queue_ptr->object_queue) == EB_FALSE) &&
            (eb_circular_buffer_empty_check(queue_ptr->process_queue) == EB_FALSE)) {
-        // Get the next process
-        eb_circular_buffer_pop_front(queue_ptr->process_queue, (void **)&process_fifo_ptr);
-
         // Get the next object
         eb_circular_buffer_pop_front(queue_ptr->object_queue, (void **)&wrapper_ptr);
 
+        // Get the next process, of the node of the object if possible
+        process_fifo_ptr = eb_muxing_queue_pop_process(queue_ptr, wrapper_ptr->numa_node);
+
         // Block on the Process Fifo's Mutex
         eb_block_on_mutex(process_fifo_ptr->lockout_mutex);
 
@@ -248,12 +466,12 @@ static EbErrorType eb_muxing_queue_assignation_non_blocking(EbMuxingQueue *queue
     // while loop
     while ((eb_circular_buffer_empty_check(queue_ptr->object_queue) == EB_FALSE) &&
            (eb_circular_buffer_empty_check(queue_ptr->process_queue) == EB_FALSE)) {
-        // Get the next process
-        eb_circular_buffer_pop_front(queue_ptr->process_queue, (void **)&process_fifo_ptr);
-
         // Get the next object
         eb_circular_buffer_pop_front(queue_ptr->object_queue, (void **)&wrapper_ptr);
 
+        // Get the next process, of the node of the object if possible
+        process_fifo_ptr = eb_muxing_queue_pop_process(queue_ptr, wrapper_ptr->numa_node);
+
         // Put the object on the fifo
         eb_fifo_push_back(process_fifo_ptr, wrapper_ptr);
 
@@ -271,6 +489,11 @@ static EbErrorType eb_muxing_queue_object_push_back(EbMuxingQueue *  queue_ptr,
                                                     EbObjectWrapper *object_ptr) {
     EbErrorType return_error = EB_ErrorNone;
 
+    if (queue_ptr->object_ring) {
+        eb_lockfree_ring_push_back(queue_ptr->object_ring, object_ptr);
+        return return_error;
+    }
+
     eb_circular_buffer_push_back(queue_ptr->object_queue, object_ptr);
 
     eb_muxing_queue_assignation(queue_ptr);
@@ -285,6 +508,11 @@ static EbErrorType eb_muxing_queue_object_push_front(EbMuxingQueue *  queue_ptr,
                                                      EbObjectWrapper *object_ptr) {
     EbErrorType return_error = EB_ErrorNone;
 
+    if (queue_ptr->object_ring) {
+        eb_lockfree_ring_push_back(queue_ptr->object_ring, object_ptr);
+        return return_error;
+    }
+
     eb_circular_buffer_push_front(queue_ptr->object_queue, object_ptr);
 
     eb_muxing_queue_assignation(queue_ptr);
@@ -314,6 +542,11 @@ static EbFifo *eb_muxing_queue_get_fifo(EbMuxingQueue *queue_ptr, uint32_t index
 EbErrorType eb_object_release_enable(EbObjectWrapper *wrapper_ptr) {
     EbErrorType return_error = EB_ErrorNone;
 
+    if (wrapper_ptr->system_resource_ptr->empty_queue->object_ring) {
+        eb_atomic_store32((volatile int32_t *)&wrapper_ptr->release_enable, EB_TRUE);
+        return return_error;
+    }
+
     eb_block_on_mutex(wrapper_ptr->system_resource_ptr->empty_queue->lockout_mutex);
 
     wrapper_ptr->release_enable = EB_TRUE;
@@ -340,6 +573,11 @@ EbErrorType eb_object_release_enable(EbObjectWrapper *wrapper_ptr) {
 EbErrorType eb_object_release_disable(EbObjectWrapper *wrapper_ptr) {
     EbErrorType return_error = EB_ErrorNone;
 
+    if (wrapper_ptr->system_resource_ptr->empty_queue->object_ring) {
+        eb_atomic_store32((volatile int32_t *)&wrapper_ptr->release_enable, EB_FALSE);
+        return return_error;
+    }
+
     eb_block_on_mutex(wrapper_ptr->system_resource_ptr->empty_queue->lockout_mutex);
 
     wrapper_ptr->release_enable = EB_FALSE;
@@ -366,6 +604,12 @@ EbErrorType eb_object_release_disable(EbObjectWrapper *wrapper_ptr) {
 EbErrorType eb_object_inc_live_count(EbObjectWrapper *wrapper_ptr, uint32_t increment_number) {
     EbErrorType return_error = EB_ErrorNone;
 
+    if (wrapper_ptr->system_resource_ptr->empty_queue->object_ring) {
+        eb_atomic_fetch_add32((volatile int32_t *)&wrapper_ptr->live_count,
+                              (int32_t)increment_number);
+        return return_error;
+    }
+
     eb_block_on_mutex(wrapper_ptr->system_resource_ptr->empty_queue->lockout_mutex);
 
     wrapper_ptr->live_count += increment_number;
@@ -380,8 +624,7 @@ typedef struct DctorAble {
     EbDctor dctor;
 } DctorAble;
 
-void eb_object_wrapper_dctor(EbPtr p) {
-    EbObjectWrapper *wrapper = (EbObjectWrapper *)p;
+static void eb_object_wrapper_destroy_object(EbObjectWrapper *wrapper) {
     if (wrapper->object_destroyer) {
         //customized destoryer
         if (wrapper->object_ptr) wrapper->object_destroyer(wrapper->object_ptr);
@@ -390,6 +633,11 @@ void eb_object_wrapper_dctor(EbPtr p) {
         DctorAble *obj = (DctorAble *)wrapper->object_ptr;
         EB_DELETE(obj);
     }
+    wrapper->object_ptr = NULL;
+}
+
+void eb_object_wrapper_dctor(EbPtr p) {
+    eb_object_wrapper_destroy_object((EbObjectWrapper *)p);
 }
 
 static EbErrorType eb_object_wrapper_ctor(EbObjectWrapper *wrapper, EbSystemResource *resource,
@@ -398,19 +646,132 @@ static EbErrorType eb_object_wrapper_ctor(EbObjectWrapper *wrapper, EbSystemReso
     EbErrorType ret;
 
     wrapper->dctor = eb_object_wrapper_dctor;
-    ret            = object_creator(&wrapper->object_ptr, object_init_data_ptr);
-    if (ret != EB_ErrorNone) return ret;
+    // Spare wrappers of growable SystemResources get their object later
+    if (object_creator) {
+        ret = object_creator(&wrapper->object_ptr, object_init_data_ptr);
+        if (ret != EB_ErrorNone) return ret;
+    }
     wrapper->release_enable      = EB_TRUE;
     wrapper->system_resource_ptr = resource;
+    wrapper->numa_node           = eb_numa_get_alloc_node();
     wrapper->object_destroyer    = object_destroyer;
     return EB_ErrorNone;
 }
 
+static void eb_memory_budget_dctor(EbPtr p) {
+    EbMemoryBudget *obj = (EbMemoryBudget *)p;
+    EB_DESTROY_MUTEX(obj->lockout_mutex);
+}
+
+EbErrorType eb_memory_budget_ctor(EbMemoryBudget *budget_ptr, uint64_t limit_bytes) {
+    budget_ptr->dctor       = eb_memory_budget_dctor;
+    budget_ptr->limit_bytes = limit_bytes;
+
+    EB_CREATE_MUTEX(budget_ptr->lockout_mutex);
+
+    return EB_ErrorNone;
+}
+
+/**************************************
+ * eb_memory_budget_reserve
+ *   Accounts size bytes, past the limit only when force is set
+ **************************************/
+static EbBool eb_memory_budget_reserve(EbMemoryBudget *budget_ptr, uint64_t size, EbBool force) {
+    EbBool reserved;
+
+    if (budget_ptr == NULL) return EB_TRUE;
+    eb_block_on_mutex(budget_ptr->lockout_mutex);
+    reserved = force || budget_ptr->limit_bytes == 0 ||
+               budget_ptr->used_bytes + size <= budget_ptr->limit_bytes;
+    if (reserved) {
+        budget_ptr->used_bytes += size;
+        budget_ptr->peak_bytes = MAX(budget_ptr->peak_bytes, budget_ptr->used_bytes);
+    }
+    eb_release_mutex(budget_ptr->lockout_mutex);
+
+    return reserved;
+}
+
+static void eb_memory_budget_free(EbMemoryBudget *budget_ptr, uint64_t size) {
+    if (budget_ptr == NULL) return;
+    eb_block_on_mutex(budget_ptr->lockout_mutex);
+    budget_ptr->used_bytes -= MIN(size, budget_ptr->used_bytes);
+    eb_release_mutex(budget_ptr->lockout_mutex);
+}
+
 static void eb_system_resource_dctor(EbPtr p) {
     EbSystemResource *obj = (EbSystemResource *)p;
     EB_DELETE(obj->full_queue);
     EB_DELETE(obj->empty_queue);
     EB_DELETE_PTR_ARRAY(obj->wrapper_ptr_pool, obj->object_total_count);
+    EB_FREE_ARRAY(obj->spare_wrapper_array);
+    EB_FREE(obj->object_init_data_copy);
+    EB_DESTROY_MUTEX(obj->grow_mutex);
+}
+
+/*********************************************************************
+ * eb_system_resource_init
+ *   Constructs the wrappers and queues of a SystemResource, with an
+ *   object in the first object_init_count wrappers only. Those are the
+ *   ones queued as empty. object_size is set to the largest number of
+ *   bytes one of the objects allocated.
+ *********************************************************************/
+static EbErrorType eb_system_resource_init(EbSystemResource *resource_ptr,
+                                           uint32_t          object_init_count,
+                                           uint32_t          object_total_count,
+                                           uint32_t          producer_process_total_count,
+                                           uint32_t          consumer_process_total_count,
+                                           EbCreator object_creator, EbPtr object_init_data_ptr,
+                                           EbDctor object_destroyer) {
+    uint32_t wrapper_index;
+
+    resource_ptr->object_total_count = object_total_count;
+    resource_ptr->huge_pages         = eb_huge_page_get_enabled();
+    resource_ptr->numa_stats_ptr     = eb_numa_get_alloc_stats();
+
+    // Allocate array for wrapper pointers
+    EB_ALLOC_PTR_ARRAY(resource_ptr->wrapper_ptr_pool, resource_ptr->object_total_count);
+
+    // Initialize each wrapper
+    const int32_t  alloc_node = eb_numa_get_alloc_node();
+    const uint32_t numa_nodes = numa_spread ? eb_numa_node_count() : 1;
+    for (wrapper_index = 0; wrapper_index < resource_ptr->object_total_count; ++wrapper_index) {
+        size_t meter_start = eb_mem_meter_read();
+        if (numa_nodes > 1) eb_numa_set_alloc_node((int32_t)(wrapper_index % numa_nodes));
+        EB_NEW(resource_ptr->wrapper_ptr_pool[wrapper_index],
+               eb_object_wrapper_ctor,
+               resource_ptr,
+               wrapper_index < object_init_count ? object_creator : NULL,
+               object_init_data_ptr,
+               object_destroyer);
+        if (wrapper_index < object_init_count)
+            resource_ptr->object_size =
+                MAX(resource_ptr->object_size, eb_mem_meter_read() - meter_start);
+    }
+    eb_numa_set_alloc_node(alloc_node);
+
+    // Initialize the Empty Queue
+    EB_NEW(resource_ptr->empty_queue,
+           eb_muxing_queue_ctor,
+           resource_ptr->object_total_count,
+           producer_process_total_count);
+    // Fill the Empty Fifo with every constructed ObjectWrapper
+    for (wrapper_index = 0; wrapper_index < object_init_count; ++wrapper_index) {
+        eb_muxing_queue_object_push_back(resource_ptr->empty_queue,
+                                         resource_ptr->wrapper_ptr_pool[wrapper_index]);
+    }
+
+    // Initialize the Full Queue
+    if (consumer_process_total_count) {
+        EB_NEW(resource_ptr->full_queue,
+               eb_muxing_queue_ctor,
+               resource_ptr->object_total_count,
+               consumer_process_total_count);
+    } else {
+        resource_ptr->full_queue = (EbMuxingQueue *)EB_NULL;
+    }
+
+    return EB_ErrorNone;
 }
 
 /*********************************************************************
@@ -442,47 +803,159 @@ EbErrorType eb_system_resource_ctor(EbSystemResource *resource_ptr, uint32_t obj
                                     uint32_t producer_process_total_count,
                                     uint32_t consumer_process_total_count, EbCreator object_creator,
                                     EbPtr object_init_data_ptr, EbDctor object_destroyer) {
+    resource_ptr->dctor = eb_system_resource_dctor;
+
+    return eb_system_resource_init(resource_ptr,
+                                   object_total_count,
+                                   object_total_count,
+                                   producer_process_total_count,
+                                   consumer_process_total_count,
+                                   object_creator,
+                                   object_init_data_ptr,
+                                   object_destroyer);
+}
+
+/*********************************************************************
+ * eb_system_resource_growable_ctor
+ *   Constructor for a SystemResource whose pool grows on demand, see
+ *   EbSystemResourceManager.h.
+ *********************************************************************/
+EbErrorType eb_system_resource_growable_ctor(
+    EbSystemResource *resource_ptr, uint32_t object_min_count, uint32_t object_total_count,
+    uint32_t producer_process_total_count, uint32_t consumer_process_total_count,
+    EbCreator object_creator, EbPtr object_init_data_ptr, size_t object_init_data_size,
+    EbDctor object_destroyer, EbMemoryBudget *budget_ptr) {
+    EbErrorType return_error;
     uint32_t    wrapper_index;
-    EbErrorType return_error = EB_ErrorNone;
-    resource_ptr->dctor      = eb_system_resource_dctor;
 
-    resource_ptr->object_total_count = object_total_count;
+    resource_ptr->dctor = eb_system_resource_dctor;
 
-    // Allocate array for wrapper pointers
-    EB_ALLOC_PTR_ARRAY(resource_ptr->wrapper_ptr_pool, resource_ptr->object_total_count);
+    object_min_count = CLIP3(1, object_total_count, object_min_count);
 
-    // Initialize each wrapper
-    for (wrapper_index = 0; wrapper_index < resource_ptr->object_total_count; ++wrapper_index) {
-        EB_NEW(resource_ptr->wrapper_ptr_pool[wrapper_index],
-               eb_object_wrapper_ctor,
-               resource_ptr,
-               object_creator,
-               object_init_data_ptr,
-               object_destroyer);
+    // The objects constructed later outlive the caller's init data
+    if (object_init_data_size) {
+        EB_MALLOC(resource_ptr->object_init_data_copy, object_init_data_size);
+        EB_MEMCPY(resource_ptr->object_init_data_copy, object_init_data_ptr, object_init_data_size);
+        object_init_data_ptr = resource_ptr->object_init_data_copy;
+    }
+    resource_ptr->object_creator       = object_creator;
+    resource_ptr->object_init_data_ptr = object_init_data_ptr;
+    resource_ptr->object_destroyer     = object_destroyer;
+    resource_ptr->budget_ptr           = budget_ptr;
+    EB_CREATE_MUTEX(resource_ptr->grow_mutex);
+
+    return_error = eb_system_resource_init(resource_ptr,
+                                           object_min_count,
+                                           object_total_count,
+                                           producer_process_total_count,
+                                           consumer_process_total_count,
+                                           object_creator,
+                                           object_init_data_ptr,
+                                           object_destroyer);
+    if (return_error != EB_ErrorNone) return return_error;
+
+    // The wrappers past object_min_count wait for an object
+    EB_MALLOC_ARRAY(resource_ptr->spare_wrapper_array, object_total_count);
+    for (wrapper_index = object_total_count; wrapper_index > object_min_count; --wrapper_index) {
+        resource_ptr->spare_wrapper_array[resource_ptr->spare_count++] =
+            resource_ptr->wrapper_ptr_pool[wrapper_index - 1];
     }
+    resource_ptr->object_min_count  = object_min_count;
+    resource_ptr->constructed_count = object_min_count;
+    resource_ptr->growable          = EB_TRUE;
+    resource_ptr->empty_queue->grow_resource_ptr = resource_ptr;
 
-    // Initialize the Empty Queue
-    EB_NEW(resource_ptr->empty_queue,
-           eb_muxing_queue_ctor,
-           resource_ptr->object_total_count,
-           producer_process_total_count);
-    // Fill the Empty Fifo with every ObjectWrapper
-    for (wrapper_index = 0; wrapper_index < resource_ptr->object_total_count; ++wrapper_index) {
-        eb_muxing_queue_object_push_back(resource_ptr->empty_queue,
-                                         resource_ptr->wrapper_ptr_pool[wrapper_index]);
+    eb_memory_budget_reserve(budget_ptr, resource_ptr->object_size * object_min_count, EB_TRUE);
+
+    return EB_ErrorNone;
+}
+
+/*********************************************************************
+ * eb_system_resource_grow
+ *   Constructs one more object of a growable SystemResource when more
+ *   objects are requested than constructed and the budget allows it.
+ *   Returns its wrapper, or NULL if none was constructed.
+ *********************************************************************/
+static EbObjectWrapper *eb_system_resource_grow(EbSystemResource *resource_ptr) {
+    EbObjectWrapper *wrapper_ptr = (EbObjectWrapper *)EB_NULL;
+
+    eb_block_on_mutex(resource_ptr->grow_mutex);
+
+    if (resource_ptr->spare_count &&
+        (uint32_t)eb_atomic_load32(&resource_ptr->in_use_count) > resource_ptr->constructed_count &&
+        eb_memory_budget_reserve(resource_ptr->budget_ptr, resource_ptr->object_size, EB_FALSE)) {
+        size_t        meter_start = eb_mem_meter_read();
+        const int32_t alloc_node  = eb_numa_get_alloc_node();
+        EbNumaStats * numa_stats  = eb_numa_get_alloc_stats();
+        const EbBool  huge_pages  = eb_huge_page_get_enabled();
+        EbErrorType   return_error;
+
+        wrapper_ptr = resource_ptr->spare_wrapper_array[--resource_ptr->spare_count];
+        // The object goes on the node its wrapper was given at construction
+        eb_numa_set_alloc_node(wrapper_ptr->numa_node);
+        eb_numa_set_alloc_stats(resource_ptr->numa_stats_ptr);
+        eb_huge_page_set_enabled(resource_ptr->huge_pages);
+        return_error = resource_ptr->object_creator(&wrapper_ptr->object_ptr,
+                                                    resource_ptr->object_init_data_ptr);
+        eb_huge_page_set_enabled(huge_pages);
+        eb_numa_set_alloc_stats(numa_stats);
+        eb_numa_set_alloc_node(alloc_node);
+        if (return_error == EB_ErrorNone) {
+            uint64_t object_size = eb_mem_meter_read() - meter_start;
+            // Account what the object allocated past the estimate
+            if (object_size > resource_ptr->object_size) {
+                eb_memory_budget_reserve(
+                    resource_ptr->budget_ptr, object_size - resource_ptr->object_size, EB_TRUE);
+                resource_ptr->object_size = object_size;
+            }
+            resource_ptr->constructed_count++;
+            resource_ptr->idle_release_count = 0;
+        } else {
+            eb_memory_budget_free(resource_ptr->budget_ptr, resource_ptr->object_size);
+            resource_ptr->spare_wrapper_array[resource_ptr->spare_count++] = wrapper_ptr;
+            wrapper_ptr = (EbObjectWrapper *)EB_NULL;
+        }
     }
 
-    // Initialize the Full Queue
-    if (consumer_process_total_count) {
-        EB_NEW(resource_ptr->full_queue,
-               eb_muxing_queue_ctor,
-               resource_ptr->object_total_count,
-               consumer_process_total_count);
-    } else {
-        resource_ptr->full_queue = (EbMuxingQueue *)EB_NULL;
+    eb_release_mutex(resource_ptr->grow_mutex);
+
+    return wrapper_ptr;
+}
+
+/*********************************************************************
+ * eb_system_resource_shrink
+ *   Called on the last release of an object of a growable
+ *   SystemResource. Destructs the object when the pool kept another
+ *   object idle during a whole cycle of its objects. Returns EB_TRUE
+ *   if so, the wrapper then went back to the spares and must not be
+ *   queued.
+ *********************************************************************/
+static EbBool eb_system_resource_shrink(EbSystemResource *resource_ptr,
+                                        EbObjectWrapper * wrapper_ptr) {
+    EbBool   shrunk = EB_FALSE;
+    uint32_t in_use_count =
+        (uint32_t)(eb_atomic_fetch_add32(&resource_ptr->in_use_count, -1) - 1);
+
+    eb_block_on_mutex(resource_ptr->grow_mutex);
+
+    if (resource_ptr->constructed_count > in_use_count + 1)
+        resource_ptr->idle_release_count++;
+    else
+        resource_ptr->idle_release_count = 0;
+
+    if (resource_ptr->idle_release_count >= resource_ptr->constructed_count &&
+        resource_ptr->constructed_count > resource_ptr->object_min_count) {
+        eb_object_wrapper_destroy_object(wrapper_ptr);
+        resource_ptr->spare_wrapper_array[resource_ptr->spare_count++] = wrapper_ptr;
+        resource_ptr->constructed_count--;
+        resource_ptr->idle_release_count = 0;
+        eb_memory_budget_free(resource_ptr->budget_ptr, resource_ptr->object_size);
+        shrunk = EB_TRUE;
     }
 
-    return return_error;
+    eb_release_mutex(resource_ptr->grow_mutex);
+
+    return shrunk;
 }
 
 EbFifo *eb_system_resource_get_producer_fifo(const EbSystemResource *resource_ptr, uint32_t index) {
@@ -493,6 +966,27 @@ EbFifo *eb_system_resource_get_consumer_fifo(const EbSystemResource *resource_pt
     return eb_muxing_queue_get_fifo(resource_ptr->full_queue, index);
 }
 
+void eb_system_resource_set_full_notify(EbSystemResource *resource_ptr, EbQueueNotify notify,
+                                        EbPtr notify_arg) {
+    resource_ptr->full_queue->notify     = notify;
+    resource_ptr->full_queue->notify_arg = notify_arg;
+}
+
+void eb_system_resource_set_consumer_node(EbSystemResource *resource_ptr, uint32_t index,
+                                          int32_t numa_node) {
+    eb_muxing_queue_get_fifo(resource_ptr->full_queue, index)->numa_node = numa_node;
+}
+
+void eb_system_resource_set_stats(EbSystemResource *resource_ptr, EbStageStats *stats_ptr) {
+    resource_ptr->full_queue->stats_ptr = stats_ptr;
+}
+
+void eb_system_resource_set_release_hook(EbSystemResource *resource_ptr, EbReleaseHook hook,
+                                         EbPtr hook_arg) {
+    resource_ptr->empty_queue->release_hook     = hook;
+    resource_ptr->empty_queue->release_hook_arg = hook_arg;
+}
+
 /*********************************************************************
  * EbSystemResourceReleaseProcess
  *********************************************************************/
@@ -541,6 +1035,16 @@ static EbErrorType eb_release_process_non_blocking(EbFifo *process_fifo_ptr) {
 EbErrorType eb_post_full_object(EbObjectWrapper *object_ptr) {
     EbErrorType return_error = EB_ErrorNone;
 
+    if (object_ptr->system_resource_ptr->full_queue->stats_ptr)
+        eb_stage_stats_post(object_ptr->system_resource_ptr->full_queue->stats_ptr);
+
+    if (object_ptr->system_resource_ptr->full_queue->object_ring) {
+        EbMuxingQueue *queue_ptr = object_ptr->system_resource_ptr->full_queue;
+        eb_lockfree_ring_push_back(queue_ptr->object_ring, object_ptr);
+        if (queue_ptr->notify) queue_ptr->notify(queue_ptr->notify_arg);
+        return return_error;
+    }
+
     eb_block_on_mutex(object_ptr->system_resource_ptr->full_queue->lockout_mutex);
 
     eb_muxing_queue_object_push_back(object_ptr->system_resource_ptr->full_queue, object_ptr);
@@ -560,9 +1064,36 @@ EbErrorType eb_post_full_object(EbObjectWrapper *object_ptr) {
  *   object_ptr
  *      pointer to EbObjectWrapper to be released.
  *********************************************************************/
+static void eb_lockfree_release_object(EbObjectWrapper *object_ptr) {
+    volatile int32_t *live_count = (volatile int32_t *)&object_ptr->live_count;
+    int32_t           count;
+
+    // Decrement live_count, the last reference returns the object
+    do {
+        count = eb_atomic_load32(live_count);
+        if (count == 0) break;
+    } while (!eb_atomic_cas32(live_count, count, count - 1));
+
+    if (count <= 1 && eb_atomic_load32((volatile int32_t *)&object_ptr->release_enable) &&
+        eb_atomic_cas32(live_count, 0, (int32_t)EB_ObjectWrapperReleasedValue)) {
+        EbMuxingQueue *queue_ptr = object_ptr->system_resource_ptr->empty_queue;
+        if (queue_ptr->release_hook)
+            queue_ptr->release_hook(queue_ptr->release_hook_arg, object_ptr);
+        if (queue_ptr->grow_resource_ptr &&
+            eb_system_resource_shrink(queue_ptr->grow_resource_ptr, object_ptr))
+            return;
+        eb_lockfree_ring_push_back(queue_ptr->object_ring, object_ptr);
+    }
+}
+
 EbErrorType eb_release_object(EbObjectWrapper *object_ptr) {
     EbErrorType return_error = EB_ErrorNone;
 
+    if (object_ptr->system_resource_ptr->empty_queue->object_ring) {
+        eb_lockfree_release_object(object_ptr);
+        return return_error;
+    }
+
     eb_block_on_mutex(object_ptr->system_resource_ptr->empty_queue->lockout_mutex);
 
     // Decrement live_count
@@ -570,10 +1101,25 @@ EbErrorType eb_release_object(EbObjectWrapper *object_ptr) {
         (object_ptr->live_count == 0) ? object_ptr->live_count : object_ptr->live_count - 1;
 
     if ((object_ptr->release_enable == EB_TRUE) && (object_ptr->live_count == 0)) {
+        EbMuxingQueue *queue_ptr = object_ptr->system_resource_ptr->empty_queue;
+        EbBool         shrunk    = EB_FALSE;
+
         // Set live_count to EB_ObjectWrapperReleasedValue
         object_ptr->live_count = EB_ObjectWrapperReleasedValue;
 
-        eb_muxing_queue_object_push_front(object_ptr->system_resource_ptr->empty_queue, object_ptr);
+        // The released object is not queued yet, no other thread touches it
+        if (queue_ptr->release_hook || queue_ptr->grow_resource_ptr) {
+            eb_release_mutex(queue_ptr->lockout_mutex);
+            if (queue_ptr->release_hook)
+                queue_ptr->release_hook(queue_ptr->release_hook_arg, object_ptr);
+            if (queue_ptr->grow_resource_ptr)
+                shrunk = eb_system_resource_shrink(queue_ptr->grow_resource_ptr, object_ptr);
+            eb_block_on_mutex(queue_ptr->lockout_mutex);
+        }
+
+        if (!shrunk)
+            eb_muxing_queue_object_push_front(object_ptr->system_resource_ptr->empty_queue,
+                                              object_ptr);
     }
 
     eb_release_mutex(object_ptr->system_resource_ptr->empty_queue->lockout_mutex);
@@ -597,13 +1143,39 @@ EbErrorType eb_release_object(EbObjectWrapper *object_ptr) {
  *      EbObjectWrapper pointer.
  *********************************************************************/
 EbErrorType eb_get_empty_object(EbFifo *empty_fifo_ptr, EbObjectWrapper **wrapper_dbl_ptr) {
-    EbErrorType return_error = EB_ErrorNone;
+    EbErrorType       return_error      = EB_ErrorNone;
+    EbSystemResource *grow_resource_ptr = empty_fifo_ptr->queue_ptr->grow_resource_ptr;
+    EbBool            blocked;
+
+    // A growable pool constructs a new object rather than wait when all are in use
+    if (grow_resource_ptr) {
+        eb_atomic_fetch_add32(&grow_resource_ptr->in_use_count, 1);
+        *wrapper_dbl_ptr = eb_system_resource_grow(grow_resource_ptr);
+        if (*wrapper_dbl_ptr) {
+            (*wrapper_dbl_ptr)->live_count     = 0;
+            (*wrapper_dbl_ptr)->release_enable = EB_TRUE;
+            return return_error;
+        }
+    }
+
+    // Time waiting here is backpressure on the stage of the calling thread
+    blocked = eb_stage_stats_block_begin();
+
+    if (empty_fifo_ptr->queue_ptr->object_ring) {
+        eb_lockfree_ring_wait(empty_fifo_ptr->queue_ptr->object_ring);
+        if (blocked) eb_stage_stats_block_end();
+        *wrapper_dbl_ptr = eb_lockfree_ring_pop_front(empty_fifo_ptr->queue_ptr->object_ring);
+        (*wrapper_dbl_ptr)->live_count     = 0;
+        (*wrapper_dbl_ptr)->release_enable = EB_TRUE;
+        return return_error;
+    }
 
     // Queue the Fifo requesting the empty fifo
     eb_release_process(empty_fifo_ptr);
 
     // Block on the counting Semaphore until an empty buffer is available
     eb_block_on_semaphore(empty_fifo_ptr->counting_semaphore);
+    if (blocked) eb_stage_stats_block_end();
 
     // Acquire lockout Mutex
     eb_block_on_mutex(empty_fifo_ptr->lockout_mutex);
@@ -638,9 +1210,16 @@ EbErrorType eb_get_empty_object(EbFifo *empty_fifo_ptr, EbObjectWrapper **wrappe
  *      Double pointer used to pass the pointer to the full
  *      EbObjectWrapper pointer.
  *********************************************************************/
-EbErrorType eb_get_full_object(EbFifo *full_fifo_ptr, EbObjectWrapper **wrapper_dbl_ptr) {
+static EbErrorType eb_get_full_object_wait(EbFifo *          full_fifo_ptr,
+                                           EbObjectWrapper **wrapper_dbl_ptr) {
     EbErrorType return_error = EB_ErrorNone;
 
+    if (full_fifo_ptr->queue_ptr->object_ring) {
+        eb_lockfree_ring_wait(full_fifo_ptr->queue_ptr->object_ring);
+        *wrapper_dbl_ptr = eb_lockfree_ring_pop_front(full_fifo_ptr->queue_ptr->object_ring);
+        return return_error;
+    }
+
     // Queue the Fifo requesting the full fifo
     eb_release_process(full_fifo_ptr);
 
@@ -658,10 +1237,37 @@ EbErrorType eb_get_full_object(EbFifo *full_fifo_ptr, EbObjectWrapper **wrapper_
     return return_error;
 }
 
+/*********************************************************************
+ * eb_get_full_object
+ *   eb_get_full_object_wait, timed when the queue has stage stats.
+ *********************************************************************/
+EbErrorType eb_get_full_object(EbFifo *full_fifo_ptr, EbObjectWrapper **wrapper_dbl_ptr) {
+    EbStageStats *stats_ptr = full_fifo_ptr->queue_ptr->stats_ptr;
+    EbErrorType   return_error;
+    uint64_t      wait_start_ns;
+
+    if (stats_ptr == NULL) return eb_get_full_object_wait(full_fifo_ptr, wrapper_dbl_ptr);
+
+    // A stage thread comes back for its next input when done with the last
+    eb_stage_stats_task_end();
+    wait_start_ns = eb_time_ns();
+    return_error  = eb_get_full_object_wait(full_fifo_ptr, wrapper_dbl_ptr);
+    eb_stage_stats_task_begin(stats_ptr, eb_time_ns() - wait_start_ns);
+
+    return return_error;
+}
+
 EbErrorType eb_get_non_blocking_full_object(EbFifo *          full_fifo_ptr,
                                             EbObjectWrapper **wrapper_dbl_ptr) {
     EbErrorType return_error = EB_ErrorNone;
 
+    if (full_fifo_ptr->queue_ptr->object_ring) {
+        EbLockFreeRing *ring_ptr = full_fifo_ptr->queue_ptr->object_ring;
+        *wrapper_dbl_ptr =
+            eb_lockfree_ring_try_wait(ring_ptr) ? eb_lockfree_ring_pop_front(ring_ptr) : NULL;
+        return return_error;
+    }
+
     // Queue the Fifo requesting the full fifo
     eb_release_process_non_blocking(full_fifo_ptr);
 
@@ -689,6 +1295,10 @@ EbErrorType eb_dec_get_full_object_non_blocking(EbFifo *          full_fifo_ptr,
                                                 EbObjectWrapper **wrapper_dbl_ptr) {
     EbErrorType return_error = EB_ErrorNone;
     EbBool      fifo_empty;
+
+    if (full_fifo_ptr->queue_ptr->object_ring)
+        return eb_get_non_blocking_full_object(full_fifo_ptr, wrapper_dbl_ptr);
+
     // Queue the Fifo requesting the full fifo
     eb_release_process_non_blocking(full_fifo_ptr);
 
@@ -708,10 +1318,18 @@ EbErrorType eb_dec_get_full_object_non_blocking(EbFifo *          full_fifo_ptr,
     return return_error;
 }
 
+EbBool eb_full_object_pending(EbFifo *full_fifo_ptr) {
+    return eb_atomic_load32(&full_fifo_ptr->queue_ptr->object_ring->available_count) > 0;
+}
+
 EbErrorType eb_get_full_object_non_blocking(EbFifo *          full_fifo_ptr,
                                             EbObjectWrapper **wrapper_dbl_ptr) {
     EbErrorType return_error = EB_ErrorNone;
     EbBool      fifo_empty;
+
+    if (full_fifo_ptr->queue_ptr->object_ring)
+        return eb_get_non_blocking_full_object(full_fifo_ptr, wrapper_dbl_ptr);
+
     // Queue the Fifo requesting the full fifo
     eb_release_process(full_fifo_ptr);
 
@@ -724,7 +1342,7 @@ EbErrorType eb_get_full_object_non_blocking(EbFifo *          full_fifo_ptr,
     eb_release_mutex(full_fifo_ptr->lockout_mutex);
 
     if (fifo_empty == EB_FALSE)
-        eb_get_full_object(full_fifo_ptr, wrapper_dbl_ptr);
+        eb_get_full_object_wait(full_fifo_ptr, wrapper_dbl_ptr);
     else
         *wrapper_dbl_ptr = (EbObjectWrapper *)EB_NULL;
 
@@ -45,6 +45,11 @@ typedef struct EbObjectWrapper {
     // next_ptr - a pointer to a different EbObjectWrapper.  Used
     //   only in the implemenation of a single-linked Fifo.
     struct EbObjectWrapper *next_ptr;
+
+    // numa_node - node the object is placed on, or the node of the data
+    //   a task works on. Full queues hand the object to a process fifo
+    //   of the same node when one is waiting. EB_NUMA_NODE_ANY for none.
+    int32_t numa_node;
 } EbObjectWrapper;
 
 /*********************************************************************
@@ -75,6 +80,10 @@ typedef struct EbFifo {
     // queue_ptr - pointer to MuxingQueue that the EbFifo is
     //   associated with.
     struct EbMuxingQueue *queue_ptr;
+
+    // numa_node - node the process of the fifo runs on, EB_NUMA_NODE_ANY
+    //   when it takes objects of any node
+    int32_t numa_node;
 } EbFifo;
 
 /*********************************************************************
@@ -89,9 +98,50 @@ typedef struct EbCircularBuffer {
     uint32_t current_count;
 } EbCircularBuffer;
 
+/*********************************************************************
+     * LockFreeRing
+     *   Bounded multi-producer multi-consumer ring of EbObjectWrapper
+     *   pointers. Each cell carries a sequence number telling producers
+     *   and consumers whose turn it is, so push and pop only take a CAS
+     *   on their own position. The ring has its own counting semaphore:
+     *   available_count is the number of objects in the ring, or minus
+     *   the number of threads blocked on os_semaphore. Waiters spin on
+     *   available_count before blocking, so the OS semaphore is only
+     *   touched when a process really goes idle.
+     *********************************************************************/
+typedef struct EbLockFreeCell {
+    volatile int32_t sequence;
+    EbObjectWrapper *wrapper_ptr;
+} EbLockFreeCell;
+
+typedef struct EbLockFreeRing {
+    EbDctor         dctor;
+    EbLockFreeCell *cell_array;
+    int32_t         mask;
+    int32_t         spin_count;
+    EbHandle        os_semaphore;
+    // waiter_pool - thread pool of the workers waiting on the ring, they
+    //   do not count in available_count and are woken through the pool
+    //   while pool_waiter_count is not 0
+    struct EbThreadPool *volatile waiter_pool;
+    // The positions and count are written by different threads, keep
+    //   them on separate cache lines
+    int8_t           pad0[64];
+    volatile int32_t enqueue_pos;
+    int8_t           pad1[64];
+    volatile int32_t dequeue_pos;
+    int8_t           pad2[64];
+    volatile int32_t available_count;
+    volatile int32_t pool_waiter_count;
+    int8_t           pad3[64];
+} EbLockFreeRing;
+
 /*********************************************************************
      * MuxingQueue
      *********************************************************************/
+typedef void (*EbQueueNotify)(EbPtr notify_arg);
+typedef void (*EbReleaseHook)(EbPtr hook_arg, EbObjectWrapper *wrapper_ptr);
+
 typedef struct EbMuxingQueue {
     EbDctor           dctor;
     EbHandle          lockout_mutex;
@@ -99,8 +149,45 @@ typedef struct EbMuxingQueue {
     EbCircularBuffer *process_queue;
     uint32_t          process_total_count;
     EbFifo **         process_fifo_ptr_array;
+    // object_ring - lock-free queue, NULL when the mutex based one is used.
+    //   It is shared by all the process fifos of the queue and replaces
+    //   the object/process circular buffers and the per-fifo semaphores:
+    //   any idle process takes the next object.
+    EbLockFreeRing *object_ring;
+    // notify - called with notify_arg after each object is queued, lock-free
+    //   mode only. Lets a thread pool know there is work without any of its
+    //   threads blocking on the queue.
+    EbQueueNotify notify;
+    EbPtr         notify_arg;
+    // stats_ptr - counters of the stage consuming the queue, full queues
+    //   only, NULL when the pipeline statistics are off
+    struct EbStageStats *stats_ptr;
+    // release_hook - called with release_hook_arg on each object released
+    //   to the empty queue, before it can be taken again. Runs outside the
+    //   queue lock. Empty queues only.
+    EbReleaseHook release_hook;
+    EbPtr         release_hook_arg;
+    // grow_resource_ptr - SystemResource to construct more objects in when
+    //   the queue runs dry. Empty queues of growable SystemResources only.
+    struct EbSystemResource *grow_resource_ptr;
 } EbMuxingQueue;
 
+/*********************************************************************
+     * MemoryBudget
+     *   Byte budget shared by the growable SystemResources of an
+     *   encoder. A pool only constructs a new object when its size still
+     *   fits in limit_bytes; the objects every pool starts with are
+     *   always counted, even past the limit.
+     *********************************************************************/
+typedef struct EbMemoryBudget {
+    EbDctor  dctor;
+    EbHandle lockout_mutex;
+    // limit_bytes - 0 for no limit
+    uint64_t limit_bytes;
+    uint64_t used_bytes;
+    uint64_t peak_bytes;
+} EbMemoryBudget;
+
 /*********************************************************************
      * SystemResource
      *   Defines a complete solution for managing objects in the encoder
@@ -125,6 +212,34 @@ typedef struct EbSystemResource {
 
     // The full FIFO contains a queue of completed buffers
     EbMuxingQueue *full_queue;
+
+    // Growable SystemResources only, see eb_system_resource_growable_ctor.
+    //   object_total_count wrappers exist, constructed_count of them hold
+    //   an object; the others are kept in spare_wrapper_array.
+    EbBool            growable;
+    uint32_t          object_min_count;
+    uint32_t          constructed_count;
+    volatile int32_t  in_use_count;
+    // idle_release_count - consecutive releases that found another object
+    //   idle in the pool
+    uint32_t          idle_release_count;
+    // object_size - bytes allocated by the largest object constructed
+    uint64_t          object_size;
+    EbObjectWrapper **spare_wrapper_array;
+    uint32_t          spare_count;
+    EbCreator         object_creator;
+    EbPtr             object_init_data_ptr;
+    // object_init_data_copy - copy of the init data owned by the
+    //   SystemResource, NULL when the pointer is kept
+    EbPtr             object_init_data_copy;
+    EbDctor           object_destroyer;
+    EbHandle          grow_mutex;
+    EbMemoryBudget *  budget_ptr;
+    // huge_pages - the objects constructed later allocate their picture
+    //   buffers on huge pages, as the ones constructed by the ctor
+    EbBool            huge_pages;
+    // numa_stats_ptr - statistics the placement of the objects is accounted in
+    struct EbNumaStats *numa_stats_ptr;
 } EbSystemResource;
 
 /*********************************************************************
@@ -208,6 +323,136 @@ extern EbErrorType eb_system_resource_ctor(EbSystemResource *resource_ptr,
                                            EbCreator object_ctor, EbPtr object_init_data_ptr,
                                            EbDctor object_destroyer);
 
+/*********************************************************************
+     * eb_system_resource_growable_ctor
+     *   Constructor for a SystemResource whose pool grows on demand.
+     *   Only object_min_count objects are constructed up front. When a
+     *   producer finds every object in use, one more is constructed, up
+     *   to object_total_count and as long as it fits in the budget;
+     *   otherwise the producer waits for a release as usual. An object
+     *   released while another one stayed idle for a whole cycle of the
+     *   pool is destructed, down to object_min_count.
+     *
+     *   object_min_count
+     *     Number of objects constructed by the ctor, enough to sustain
+     *     the flow of the pipeline.
+     *
+     *   object_init_data_size
+     *     Size of the data block at object_init_data_ptr, which is copied
+     *     for the objects constructed later. 0 keeps the pointer, the
+     *     data must then outlive the SystemResource.
+     *
+     *   budget_ptr
+     *     MemoryBudget the objects are accounted in, NULL for no limit.
+     *
+     *   The other arguments are the ones of eb_system_resource_ctor.
+     *********************************************************************/
+extern EbErrorType eb_system_resource_growable_ctor(
+    EbSystemResource *resource_ptr, uint32_t object_min_count, uint32_t object_total_count,
+    uint32_t producer_process_total_count, uint32_t consumer_process_total_count,
+    EbCreator object_ctor, EbPtr object_init_data_ptr, size_t object_init_data_size,
+    EbDctor object_destroyer, EbMemoryBudget *budget_ptr);
+
+/*********************************************************************
+     * eb_memory_budget_ctor
+     *   Constructor for EbMemoryBudget.
+     *
+     *   limit_bytes
+     *     bytes the growable SystemResources may use, 0 for no limit
+     *********************************************************************/
+extern EbErrorType eb_memory_budget_ctor(EbMemoryBudget *budget_ptr, uint64_t limit_bytes);
+
+/*********************************************************************
+     * eb_system_resource_set_lockfree
+     *   Selects the queue implementation of the SystemResources the
+     *   calling thread constructs afterwards: lock-free rings when enable
+     *   is EB_TRUE, mutex and semaphore protected fifos otherwise. Each
+     *   resource keeps its queues, so encoders constructed concurrently do
+     *   not see each other's setting. The default is set by the
+     *   EB_LOCKFREE_QUEUE build option.
+     *********************************************************************/
+extern void eb_system_resource_set_lockfree(EbBool enable);
+
+extern EbBool eb_system_resource_get_lockfree(void);
+
+/*********************************************************************
+     * eb_system_resource_set_numa_spread
+     *   When enable is EB_TRUE, the SystemResources the calling thread
+     *   constructs afterwards place their objects round robin on the NUMA
+     *   nodes: object i is allocated on node i % node count and its wrapper
+     *   numa_node is set accordingly. Off by default.
+     *********************************************************************/
+extern void eb_system_resource_set_numa_spread(EbBool enable);
+
+/*********************************************************************
+     * eb_system_resource_set_consumer_node
+     *   Sets the NUMA node of a consumer process. The mutex protected
+     *   full queue hands an object to a waiting process of the node in
+     *   the object wrapper numa_node before any other; lock-free queues
+     *   ignore the nodes.
+     *
+     *   resource_ptr
+     *     pointer to SystemResource
+     *
+     *   index
+     *     index to the consumer fifo
+     *
+     *   numa_node
+     *     node, EB_NUMA_NODE_ANY to take objects of any node
+     *********************************************************************/
+extern void eb_system_resource_set_consumer_node(EbSystemResource *resource_ptr, uint32_t index,
+                                                 int32_t numa_node);
+
+/*********************************************************************
+     * eb_system_resource_set_full_notify
+     *   Installs a callback run each time an object is posted to the
+     *   full queue of a lock-free SystemResource.
+     *
+     *   resource_ptr
+     *     pointer to SystemResource
+     *
+     *   notify
+     *     callback, NULL to remove it
+     *
+     *   notify_arg
+     *     argument passed to notify
+     *********************************************************************/
+extern void eb_system_resource_set_full_notify(EbSystemResource *resource_ptr,
+                                               EbQueueNotify notify, EbPtr notify_arg);
+
+/*********************************************************************
+     * eb_system_resource_set_stats
+     *   Attaches the counters of the stage consuming the full queue: each
+     *   post counts toward its queue depth, and each eb_get_full_object
+     *   ends the task of the calling thread and begins the next one.
+     *
+     *   resource_ptr
+     *     pointer to SystemResource
+     *
+     *   stats_ptr
+     *     stage counters, NULL to detach them
+     *********************************************************************/
+extern void eb_system_resource_set_stats(EbSystemResource *   resource_ptr,
+                                         struct EbStageStats *stats_ptr);
+
+/*********************************************************************
+     * eb_system_resource_set_release_hook
+     *   Installs a callback run each time the last reference of an
+     *   object is released, before the object goes back to the empty
+     *   queue.
+     *
+     *   resource_ptr
+     *     pointer to SystemResource
+     *
+     *   hook
+     *     callback, NULL to remove it
+     *
+     *   hook_arg
+     *     argument passed to hook
+     *********************************************************************/
+extern void eb_system_resource_set_release_hook(EbSystemResource *resource_ptr,
+                                                EbReleaseHook hook, EbPtr hook_arg);
+
 /*********************************************************************
      * eb_system_resource_get_producer_fifo
      *   get producer fifo
@@ -289,6 +534,9 @@ extern EbErrorType eb_get_full_object_non_blocking(EbFifo *          full_fifo_p
 extern EbErrorType eb_dec_get_full_object_non_blocking(EbFifo *          full_fifo_ptr,
                                                        EbObjectWrapper **wrapper_dbl_ptr);
 
+// EB_TRUE when a full object is queued and not yet taken, lock-free queues only
+extern EbBool eb_full_object_pending(EbFifo *full_fifo_ptr);
+
 /*********************************************************************
      * EbSystemResourceReleaseObject
      *   Queues an empty EbObjectWrapper to the SystemResource. This
@@ -2170,6 +2170,10 @@ EbErrorType svt_av1_init_temporal_filtering(
     if (picture_control_set_ptr_central->temp_filt_prep_done == 0) {
         picture_control_set_ptr_central->temp_filt_prep_done = 1;
 
+        // The filtered samples replace the source, never in the planes of the application
+        if (picture_control_set_ptr_central->scs_ptr->static_config.zero_copy_input)
+            eb_picture_buffer_desc_own_planes(central_picture_ptr);
+
         // allocate 16 bit buffer
         if (is_highbd) {
             EB_MALLOC_ARRAY(picture_control_set_ptr_central->altref_buffer_highbd[C_Y],
@@ -0,0 +1,221 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <stdlib.h>
+
+#include "EbThreadPool.h"
+#include "EbThreads.h"
+#include "EbPipelineStats.h"
+#include "EbTime.h"
+
+#define EB_THREAD_POOL_MAX_JOBS 0x7FFFFFFF
+
+// Worker running on the current thread, NULL outside the pool
+static EB_THREAD_LOCAL EbThreadPoolWorker *current_worker;
+
+static void eb_thread_pool_dctor(EbPtr p) {
+    EbThreadPool *obj = (EbThreadPool *)p;
+    EB_DESTROY_THREAD_ARRAY(obj->thread_handle_array, obj->worker_count);
+    EB_DESTROY_SEMAPHORE(obj->job_semaphore);
+    if (obj->worker_array) {
+        for (uint32_t worker_index = 0; worker_index < obj->worker_count; ++worker_index)
+            EB_DESTROY_SEMAPHORE(obj->worker_array[worker_index].wake_semaphore);
+    }
+    EB_FREE_ARRAY(obj->worker_array);
+}
+
+/**************************************
+ * eb_thread_pool_ctor
+ **************************************/
+EbErrorType eb_thread_pool_ctor(EbThreadPool *pool_ptr, uint32_t worker_count) {
+    pool_ptr->dctor        = eb_thread_pool_dctor;
+    pool_ptr->worker_count = worker_count;
+
+    EB_CALLOC_ARRAY(pool_ptr->worker_array, worker_count);
+    for (uint32_t worker_index = 0; worker_index < worker_count; ++worker_index) {
+        pool_ptr->worker_array[worker_index].pool_ptr = pool_ptr;
+        pool_ptr->worker_array[worker_index].index    = worker_index;
+        EB_CREATE_SEMAPHORE(pool_ptr->worker_array[worker_index].wake_semaphore, 0, 1);
+    }
+    EB_CREATE_SEMAPHORE(pool_ptr->job_semaphore, 0, EB_THREAD_POOL_MAX_JOBS);
+
+    return EB_ErrorNone;
+}
+
+/**************************************
+ * eb_thread_pool_notify
+ *   A job posted while no worker is idle may be what the blocked
+ *   workers wait for, wake them to run it.
+ **************************************/
+static void eb_thread_pool_notify(EbPtr notify_arg) {
+    EbThreadPool *pool_ptr = (EbThreadPool *)notify_arg;
+    eb_post_semaphore(pool_ptr->job_semaphore);
+    if (eb_atomic_load32(&pool_ptr->idle_count) == 0) eb_thread_pool_wake(pool_ptr, NULL);
+}
+
+/**************************************
+ * eb_thread_pool_add_stage
+ **************************************/
+EbErrorType eb_thread_pool_add_stage(EbThreadPool *pool_ptr, EbSystemResource *input_resource_ptr,
+                                     EbThreadContext **context_ptr_array, EbPoolJob job) {
+    EbThreadPoolStage *stage_ptr;
+
+    if (pool_ptr->stage_count == EB_THREAD_POOL_MAX_STAGES ||
+        input_resource_ptr->full_queue->object_ring == NULL)
+        return EB_ErrorBadParameter;
+
+    stage_ptr = &pool_ptr->stage_array[pool_ptr->stage_count++];
+    // Every consumer fifo of a lock-free queue takes from the same ring
+    stage_ptr->input_fifo_ptr    = eb_system_resource_get_consumer_fifo(input_resource_ptr, 0);
+    stage_ptr->context_ptr_array = context_ptr_array;
+    stage_ptr->job               = job;
+    eb_system_resource_set_full_notify(input_resource_ptr, eb_thread_pool_notify, pool_ptr);
+
+    return EB_ErrorNone;
+}
+
+/**************************************
+ * eb_thread_pool_run_job
+ *   Takes the first pending job, downstream stages first, of the
+ *   stages not on the worker's stack and runs it.
+ **************************************/
+static EbBool eb_thread_pool_run_job(EbThreadPoolWorker *worker_ptr) {
+    EbThreadPool *   pool_ptr = worker_ptr->pool_ptr;
+    EbObjectWrapper *wrapper_ptr;
+
+    for (int32_t stage_index = pool_ptr->stage_count - 1; stage_index >= 0; --stage_index) {
+        EbThreadPoolStage *stage_ptr  = &pool_ptr->stage_array[stage_index];
+        uint32_t           stage_mask = 1 << stage_index;
+        EbStageStats *     stats_ptr;
+        EbStageTask        saved_task;
+
+        if (worker_ptr->busy_mask & stage_mask) continue;
+        eb_get_full_object_non_blocking(stage_ptr->input_fifo_ptr, &wrapper_ptr);
+        if (wrapper_ptr == NULL) continue;
+
+        // A helping worker pauses the task it was running
+        stats_ptr = stage_ptr->input_fifo_ptr->queue_ptr->stats_ptr;
+        if (stats_ptr) eb_stage_stats_task_push(stats_ptr, &saved_task);
+        worker_ptr->busy_mask |= stage_mask;
+        stage_ptr->job(stage_ptr->context_ptr_array[worker_ptr->index], wrapper_ptr);
+        worker_ptr->busy_mask &= ~stage_mask;
+        if (stats_ptr) eb_stage_stats_task_pop(&saved_task);
+        return EB_TRUE;
+    }
+    return EB_FALSE;
+}
+
+/**************************************
+ * eb_thread_pool_job_pending
+ *   EB_TRUE when a stage not on the worker's stack has a job queued.
+ **************************************/
+static EbBool eb_thread_pool_job_pending(EbThreadPoolWorker *worker_ptr) {
+    EbThreadPool *pool_ptr = worker_ptr->pool_ptr;
+
+    for (uint32_t stage_index = 0; stage_index < pool_ptr->stage_count; ++stage_index) {
+        if (worker_ptr->busy_mask & (1 << stage_index)) continue;
+        if (eb_full_object_pending(pool_ptr->stage_array[stage_index].input_fifo_ptr))
+            return EB_TRUE;
+    }
+    return EB_FALSE;
+}
+
+/**************************************
+ * eb_thread_pool_kernel
+ *   Each post to a stage queue posts job_semaphore once. Jobs taken by
+ *   helping workers leave their post behind, so a wake up may find
+ *   nothing to do, but a queued job always has a post pending.
+ **************************************/
+static void *eb_thread_pool_kernel(void *input_ptr) {
+    EbThreadPoolWorker *worker_ptr = (EbThreadPoolWorker *)input_ptr;
+    EbThreadPool *      pool_ptr   = worker_ptr->pool_ptr;
+    uint64_t            wait_start_ns;
+
+    current_worker = worker_ptr;
+    for (;;) {
+        eb_atomic_fetch_add32(&pool_ptr->idle_count, 1);
+        if (pool_ptr->stats_ptr) {
+            wait_start_ns = eb_time_ns();
+            eb_block_on_semaphore(pool_ptr->job_semaphore);
+            eb_stage_stats_add_pool_idle(pool_ptr->stats_ptr, eb_time_ns() - wait_start_ns);
+        } else
+            eb_block_on_semaphore(pool_ptr->job_semaphore);
+        eb_atomic_fetch_add32(&pool_ptr->idle_count, -1);
+        while (eb_thread_pool_run_job(worker_ptr)) {}
+    }
+    return EB_NULL;
+}
+
+/**************************************
+ * eb_thread_pool_start
+ **************************************/
+EbErrorType eb_thread_pool_start(EbThreadPool *pool_ptr) {
+    EB_ALLOC_PTR_ARRAY(pool_ptr->thread_handle_array, pool_ptr->worker_count);
+    for (uint32_t worker_index = 0; worker_index < pool_ptr->worker_count; ++worker_index)
+        EB_CREATE_THREAD(pool_ptr->thread_handle_array[worker_index],
+                         eb_thread_pool_kernel,
+                         &pool_ptr->worker_array[worker_index]);
+    return EB_ErrorNone;
+}
+
+EbBool eb_thread_pool_is_worker(void) { return current_worker ? EB_TRUE : EB_FALSE; }
+
+EbThreadPool *eb_thread_pool_current(void) {
+    return current_worker ? current_worker->pool_ptr : NULL;
+}
+
+/**************************************
+ * eb_thread_pool_wait
+ *   The worker marks itself blocked before checking ready and the
+ *   queues one last time, so a push or a post after the check sees
+ *   the mark and wakes it.
+ **************************************/
+void eb_thread_pool_wait(EbPoolReady ready, EbPtr ready_arg) {
+    EbThreadPoolWorker *worker_ptr = current_worker;
+    EbThreadPool *      pool_ptr   = worker_ptr->pool_ptr;
+
+    while (!ready(ready_arg)) {
+        if (eb_thread_pool_help()) continue;
+
+        worker_ptr->wait_arg = ready_arg;
+        eb_atomic_fetch_add32(&pool_ptr->blocked_count, 1);
+        eb_atomic_fetch_add32(&worker_ptr->blocked, 1);
+        if (ready(ready_arg)) {
+            // Holds what it waited for, still has to undo the mark
+            if (eb_atomic_cas32(&worker_ptr->blocked, 1, 0))
+                eb_atomic_fetch_add32(&pool_ptr->blocked_count, -1);
+            else
+                eb_block_on_semaphore(worker_ptr->wake_semaphore);
+            return;
+        }
+        if (eb_thread_pool_job_pending(worker_ptr) && eb_mutex_held_count() == 0 &&
+            eb_atomic_cas32(&worker_ptr->blocked, 1, 0)) {
+            eb_atomic_fetch_add32(&pool_ptr->blocked_count, -1);
+            continue;
+        }
+        // Woken by whoever cleared the mark
+        eb_block_on_semaphore(worker_ptr->wake_semaphore);
+    }
+}
+
+void eb_thread_pool_wake(EbThreadPool *pool_ptr, EbPtr ready_arg) {
+    if (eb_atomic_load32(&pool_ptr->blocked_count) == 0) return;
+    for (uint32_t worker_index = 0; worker_index < pool_ptr->worker_count; ++worker_index) {
+        EbThreadPoolWorker *worker_ptr = &pool_ptr->worker_array[worker_index];
+        if (eb_atomic_load32(&worker_ptr->blocked) == 0) continue;
+        if (ready_arg && worker_ptr->wait_arg != ready_arg) continue;
+        if (eb_atomic_cas32(&worker_ptr->blocked, 1, 0)) {
+            eb_atomic_fetch_add32(&pool_ptr->blocked_count, -1);
+            eb_post_semaphore(worker_ptr->wake_semaphore);
+        }
+    }
+}
+
+EbBool eb_thread_pool_help(void) {
+    // A job run under a mutex of the caller would hold it for the job's duration, or
+    // deadlock taking it again
+    if (current_worker == NULL || eb_mutex_held_count()) return EB_FALSE;
+    return eb_thread_pool_run_job(current_worker);
+}
@@ -0,0 +1,120 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifndef EbThreadPool_h
+#define EbThreadPool_h
+
+#include "EbDefinitions.h"
+#include "EbSystemResourceManager.h"
+#include "EbObject.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define EB_THREAD_POOL_MAX_STAGES 16
+
+/**************************************
+     * Pool Job
+     *   Processes one object taken from the stage input queue with the
+     *   stage context of the calling worker, and releases the object.
+     **************************************/
+typedef void (*EbPoolJob)(EbThreadContext *thread_context_ptr, EbObjectWrapper *wrapper_ptr);
+
+// Takes what a blocked worker waits for, EB_FALSE when it is not there yet
+typedef EbBool (*EbPoolReady)(EbPtr ready_arg);
+
+typedef struct EbThreadPoolStage {
+    EbPoolJob         job;
+    EbFifo *          input_fifo_ptr;
+    EbThreadContext **context_ptr_array;
+} EbThreadPoolStage;
+
+typedef struct EbThreadPoolWorker {
+    struct EbThreadPool *pool_ptr;
+    uint32_t             index;
+    // busy_mask - stages with a job on this worker's stack, their context
+    //   is in use so the worker can not start a second job of theirs
+    uint32_t busy_mask;
+    // wake_semaphore - the worker blocks on it in eb_thread_pool_wait().
+    //   blocked is 1 while it does; the thread setting it back to 0 posts
+    //   wake_semaphore, so there is at most one post pending.
+    EbHandle         wake_semaphore;
+    volatile int32_t blocked;
+    // wait_arg - ready_arg of the wait the worker is blocked in
+    EbPtr volatile wait_arg;
+} EbThreadPoolWorker;
+
+/**************************************
+     * Thread Pool
+     *   One set of worker threads shared by the multi-threaded stages.
+     *   Worker i runs the jobs of every stage with context i of that
+     *   stage, so a stage needs one context per worker. There is no
+     *   per-worker queue nor work stealing: the stage input queues are
+     *   the one central queue, and posting to any of them posts the
+     *   shared job_semaphore. An idle worker wakes up and runs whatever
+     *   job is pending, the stages registered last first so the pictures
+     *   already in flight drain before new ones enter the pipeline.
+     *   The input queues are polled, which needs the lock-free queues.
+     *   A worker waiting for an empty object runs jobs meanwhile, unless
+     *   it holds a mutex, see eb_thread_pool_help(). When there are none
+     *   it blocks in eb_thread_pool_wait() until the object is pushed, or
+     *   until a job is posted while no worker is idle: the object may only
+     *   come back once that job has run.
+     **************************************/
+typedef struct EbThreadPool {
+    EbDctor             dctor;
+    uint32_t            worker_count;
+    EbThreadPoolWorker *worker_array;
+    EbHandle *          thread_handle_array;
+    EbHandle            job_semaphore;
+    // idle_count - workers blocked on job_semaphore
+    // blocked_count - workers blocked in eb_thread_pool_wait()
+    volatile int32_t    idle_count;
+    volatile int32_t    blocked_count;
+    uint32_t            stage_count;
+    EbThreadPoolStage   stage_array[EB_THREAD_POOL_MAX_STAGES];
+    // stats_ptr - pipeline statistics counting the worker idle time, NULL
+    //   when they are off
+    struct EbPipelineStats *stats_ptr;
+} EbThreadPool;
+
+/**************************************
+     * Extern Function Declarations
+     **************************************/
+extern EbErrorType eb_thread_pool_ctor(EbThreadPool *pool_ptr, uint32_t worker_count);
+
+// Adds a stage: the jobs of input_resource_ptr run job with
+//   context_ptr_array[worker index]
+extern EbErrorType eb_thread_pool_add_stage(EbThreadPool *    pool_ptr,
+                                            EbSystemResource *input_resource_ptr,
+                                            EbThreadContext **context_ptr_array, EbPoolJob job);
+
+// Creates the worker threads, once all the stages are added
+extern EbErrorType eb_thread_pool_start(EbThreadPool *pool_ptr);
+
+// EB_TRUE when called from a thread pool worker
+extern EbBool eb_thread_pool_is_worker(void);
+
+// Pool of the calling worker, NULL outside the pool
+extern EbThreadPool *eb_thread_pool_current(void);
+
+// Called from a worker: runs the pending jobs until ready(ready_arg) takes
+//   what the worker waits for, and blocks when there are none. Whatever
+//   makes ready succeed must be followed by eb_thread_pool_wake() with
+//   the same ready_arg.
+extern void eb_thread_pool_wait(EbPoolReady ready, EbPtr ready_arg);
+
+// Wakes the workers blocked in eb_thread_pool_wait() on ready_arg
+extern void eb_thread_pool_wake(EbThreadPool *pool_ptr, EbPtr ready_arg);
+
+// Runs one pending job of a stage that is not already on the calling
+//   worker's stack; EB_FALSE when there was none, the caller is not a
+//   worker or it holds a mutex
+extern EbBool eb_thread_pool_help(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbThreadPool_h
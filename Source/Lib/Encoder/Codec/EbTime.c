@@ -94,6 +94,22 @@ void eb_sleep_ms(uint64_t milli_seconds) {
     }
 }
 
+uint64_t eb_time_ns(void) {
+#ifdef _WIN32
+    static LARGE_INTEGER counter_freq;
+    LARGE_INTEGER        now_count;
+    if (counter_freq.QuadPart == 0) QueryPerformanceFrequency(&counter_freq);
+    QueryPerformanceCounter(&now_count);
+    return (uint64_t)(now_count.QuadPart / counter_freq.QuadPart) * NANOSECS_PER_SEC +
+           (uint64_t)(now_count.QuadPart % counter_freq.QuadPart) * NANOSECS_PER_SEC /
+               counter_freq.QuadPart;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * NANOSECS_PER_SEC + (uint64_t)now.tv_nsec;
+#endif
+}
+
 void eb_injector(uint64_t processed_frame_count, uint32_t injector_frame_rate) {
 #ifdef _WIN32
     static LARGE_INTEGER start_count; // this is the start time
@@ -24,6 +24,8 @@ void eb_compute_overall_elapsed_time_ms(uint64_t start_seconds, uint64_t start_u
                                         double *duration);
 void eb_injector(uint64_t processed_frame_count, uint32_t injector_frame_rate);
 void eb_sleep_ms(uint64_t milli_seconds);
+// Monotonic clock in nanoseconds, for measuring intervals only
+uint64_t eb_time_ns(void);
 
 #ifdef __cplusplus
 }
@@ -16,7 +16,6 @@
 
 #include "global_motion.h"
 #include "EbUtility.h"
-#include "corner_detect.h"
 #include "corner_match.h"
 #include "ransac.h"
 
@@ -259,40 +258,32 @@ int64_t av1_refine_integerized_param(EbWarpedMotionParams *wm, TransformationTyp
     return best_error;
 }
 
+// In place, the pair of inlier i only overwrites the indices from i on, read
+// first going backwards
 static void get_inliers_from_indices(MotionModel *params, int *correspondences) {
-    int *inliers_tmp = (int *)eb_aom_malloc(2 * MAX_CORNERS * sizeof(*inliers_tmp));
-    memset(inliers_tmp, 0, 2 * MAX_CORNERS * sizeof(*inliers_tmp));
-
-    for (int i = 0; i < params->num_inliers; i++) {
-        int index              = params->inliers[i];
-        inliers_tmp[2 * i]     = correspondences[4 * index];
-        inliers_tmp[2 * i + 1] = correspondences[4 * index + 1];
+    for (int i = params->num_inliers - 1; i >= 0; i--) {
+        int index                  = params->inliers[i];
+        params->inliers[2 * i]     = correspondences[4 * index];
+        params->inliers[2 * i + 1] = correspondences[4 * index + 1];
     }
-    memcpy(params->inliers, inliers_tmp, sizeof(*inliers_tmp) * 2 * MAX_CORNERS);
-    eb_aom_free(inliers_tmp);
 }
 
 static int compute_global_motion_feature_based(TransformationType type, unsigned char *frm_buffer,
                                                int frm_width, int frm_height, int frm_stride,
                                                int *frm_corners, int num_frm_corners, uint8_t *ref,
-                                               int ref_stride, int bit_depth,
+                                               int ref_stride, int *ref_corners,
+                                               int num_ref_corners, int bit_depth,
                                                int *        num_inliers_by_motion,
-                                               MotionModel *params_by_motion, int num_motions) {
+                                               MotionModel *params_by_motion, int num_motions,
+                                               int *correspondences) {
     (void)bit_depth;
     assert(bit_depth == EB_8BIT);
     int            i;
-    int            num_ref_corners;
     int            num_correspondences;
-    int *          correspondences;
-    int            ref_corners[2 * MAX_CORNERS];
     unsigned char *ref_buffer = ref;
     RansacFunc     ransac     = av1_get_ransac_type(type);
 
-    num_ref_corners = av1_fast_corner_detect(
-        ref_buffer, frm_width, frm_height, ref_stride, ref_corners, MAX_CORNERS);
-
     // find correspondences between the two images
-    correspondences     = (int *)malloc(num_frm_corners * 4 * sizeof(*correspondences));
     num_correspondences = av1_determine_correspondence(frm_buffer,
                                                        (int *)frm_corners,
                                                        num_frm_corners,
@@ -318,8 +309,6 @@ static int compute_global_motion_feature_based(TransformationType type, unsigned
         }
     }
 
-    free(correspondences);
-
     // Return true if any one of the motions has inliers.
     for (i = 0; i < num_motions; ++i) {
         if (num_inliers_by_motion[i] > 0) return 1;
@@ -329,10 +318,10 @@ static int compute_global_motion_feature_based(TransformationType type, unsigned
 
 int av1_compute_global_motion(TransformationType type, unsigned char *frm_buffer, int frm_width,
                               int frm_height, int frm_stride, int *frm_corners, int num_frm_corners,
-                              uint8_t *ref, int ref_stride, int bit_depth,
-                              GlobalMotionEstimationType gm_estimation_type,
+                              uint8_t *ref, int ref_stride, int *ref_corners, int num_ref_corners,
+                              int bit_depth, GlobalMotionEstimationType gm_estimation_type,
                               int *num_inliers_by_motion, MotionModel *params_by_motion,
-                              int num_motions) {
+                              int num_motions, int *correspondences) {
     switch (gm_estimation_type) {
     case GLOBAL_MOTION_FEATURE_BASED:
         return compute_global_motion_feature_based(type,
@@ -344,10 +333,13 @@ int av1_compute_global_motion(TransformationType type, unsigned char *frm_buffer
                                                    num_frm_corners,
                                                    ref,
                                                    ref_stride,
+                                                   ref_corners,
+                                                   num_ref_corners,
                                                    bit_depth,
                                                    num_inliers_by_motion,
                                                    params_by_motion,
-                                                   num_motions);
+                                                   num_motions,
+                                                   correspondences);
     default: assert(0 && "Unknown global motion estimation type");
     }
     return 0;
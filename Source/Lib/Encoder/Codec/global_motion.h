@@ -80,13 +80,17 @@ int64_t av1_refine_integerized_param(EbWarpedMotionParams *wm, TransformationTyp
   "num_inliers" should be length "num_motions", and will be populated with the
   number of inlier feature points for each motion. Params for which the
   num_inliers entry is 0 should be ignored by the caller.
+
+  The corners of both frames are given, see av1_fast_corner_detect().
+  "correspondences" is scratch for 4 * "num_frm_corners" values, and the
+  inliers of each motion must hold 2 * "num_frm_corners" values.
 */
 int av1_compute_global_motion(TransformationType type, unsigned char *frm_buffer, int frm_width,
                               int frm_height, int frm_stride, int *frm_corners, int num_frm_corners,
-                              uint8_t *ref, int ref_stride, int bit_depth,
-                              GlobalMotionEstimationType gm_estimation_type,
+                              uint8_t *ref, int ref_stride, int *ref_corners, int num_ref_corners,
+                              int bit_depth, GlobalMotionEstimationType gm_estimation_type,
                               int *num_inliers_by_motion, MotionModel *params_by_motion,
-                              int num_motions);
+                              int num_motions, int *correspondences);
 #ifdef __cplusplus
 } // extern "C"
 #endif
@@ -32,6 +32,7 @@
 #include "EbModeDecisionConfigurationProcess.h"
 #include "EbEncDecProcess.h"
 #include "EbEntropyCodingProcess.h"
+#include "EbEntropyCoding.h"
 #include "EbPacketizationProcess.h"
 #include "EbResourceCoordinationResults.h"
 #include "EbPictureAnalysisResults.h"
@@ -50,6 +51,8 @@
 #include "EbRateControlResults.h"
 
 #include "EbLog.h"
+#include "EbTime.h"
+#include "EbNuma.h"
 
 #ifdef _WIN32
 #include <windows.h>
@@ -374,6 +377,8 @@ int32_t set_parent_pcs(EbSvtAv1EncConfiguration*   config, uint32_t core_count,
         return -1;
     }
 }
+static uint16_t get_max_tile_count(SequenceControlSet *scs_ptr, uint32_t sb_size);
+
 EbErrorType load_default_buffer_configuration_settings(
     SequenceControlSet       *scs_ptr){
     EbErrorType           return_error = EB_ErrorNone;
@@ -383,6 +388,9 @@ EbErrorType load_default_buffer_configuration_settings(
     uint32_t enc_dec_seg_w = (scs_ptr->static_config.super_block_size == 128) ?
         ((scs_ptr->max_input_luma_width + 64) / 128) :
         ((scs_ptr->max_input_luma_width + 32) / 64);
+    // with tile_parallel each tile is its own EncDec unit
+    uint32_t enc_dec_unit_count = scs_ptr->static_config.tile_parallel ?
+        get_max_tile_count(scs_ptr, scs_ptr->static_config.super_block_size) : 1;
     uint32_t me_seg_h     = (((scs_ptr->max_input_luma_height + 32) / BLOCK_SIZE_64) < 6) ? 1 : 6;
     uint32_t me_seg_w     = (((scs_ptr->max_input_luma_width + 32) / BLOCK_SIZE_64) < 10) ? 1 : 10;
 
@@ -490,13 +498,15 @@ EbErrorType load_default_buffer_configuration_settings(
     {
         /*Look-Ahead. Picture-Decision outputs pictures by group of mini-gops so
           the needed pictures for a certain look-ahead distance (LAD) should be rounded up to the next multiple of MiniGopSize.*/
-        uint32_t mg_size = 1 << scs_ptr->static_config.hierarchical_levels;
+        uint32_t mg_size = scs_ptr->static_config.low_latency ?
+            1 : 1 << scs_ptr->static_config.hierarchical_levels;
         uint32_t needed_lad_pictures = ((scs_ptr->static_config.look_ahead_distance + mg_size - 1) / mg_size) * mg_size;
 
         /*To accomodate FFMPEG EOS, 1 frame delay is needed in Resource coordination.
            note that we have the option to not add 1 frame delay of Resource Coordination. In this case we have wait for first I frame
-           to be released back to be able to start first base(16). Anyway poc16 needs to wait for poc0 to finish.*/
-        uint32_t eos_delay = 1;
+           to be released back to be able to start first base(16). Anyway poc16 needs to wait for poc0 to finish.
+           In low latency mode Resource coordination does not hold the picture.*/
+        uint32_t eos_delay = scs_ptr->static_config.low_latency ? 0 : 1;
 
         //Minimum input pictures needed in the pipeline
         return_ppcs = (mg_size + 1) + eos_delay + scs_ptr->scd_delay + needed_lad_pictures;
@@ -528,7 +538,7 @@ EbErrorType load_default_buffer_configuration_settings(
               mg_size + eos_delay + scs_ptr->scd_delay : 1;
     }
 
-    if (core_count == SINGLE_CORE_COUNT) {
+    if (core_count == SINGLE_CORE_COUNT || scs_ptr->static_config.low_latency) {
         scs_ptr->input_buffer_fifo_init_count                  = min_input;
         scs_ptr->picture_control_set_pool_init_count           = min_parent;
         scs_ptr->pa_reference_picture_buffer_init_count        = min_paref;
@@ -537,6 +547,9 @@ EbErrorType load_default_buffer_configuration_settings(
         scs_ptr->overlay_input_picture_buffer_init_count       = min_overlay;
 
         scs_ptr->output_recon_buffer_fifo_init_count = scs_ptr->reference_picture_buffer_init_count;
+        // Low latency: the two pictures in flight can be coded at the same time
+        if (scs_ptr->static_config.low_latency)
+            scs_ptr->picture_control_set_pool_init_count_child = MIN(min_input, MAX(core_count / 2, 1));
     }
     else {
         scs_ptr->input_buffer_fifo_init_count              = MAX(min_input, scs_ptr->input_buffer_fifo_init_count);
@@ -546,21 +559,32 @@ EbErrorType load_default_buffer_configuration_settings(
         scs_ptr->picture_control_set_pool_init_count_child = MAX(min_child, scs_ptr->picture_control_set_pool_init_count_child);
         scs_ptr->overlay_input_picture_buffer_init_count   = MAX(min_overlay, scs_ptr->overlay_input_picture_buffer_init_count);
     }
+    scs_ptr->picture_control_set_pool_min_count       = min_parent;
+    scs_ptr->picture_control_set_pool_min_count_child = min_child;
+    scs_ptr->pa_reference_picture_buffer_min_count    = min_paref;
+    scs_ptr->reference_picture_buffer_min_count       = min_ref;
 
     //#====================== Inter process Fifos ======================
-    scs_ptr->resource_coordination_fifo_init_count       = 300;
     scs_ptr->picture_analysis_fifo_init_count            = 300;
     scs_ptr->picture_decision_fifo_init_count            = 300;
     scs_ptr->initial_rate_control_fifo_init_count        = 300;
     scs_ptr->picture_demux_fifo_init_count               = 300;
     scs_ptr->rate_control_tasks_fifo_init_count          = 300;
     scs_ptr->rate_control_fifo_init_count                = 301;
-    scs_ptr->mode_decision_configuration_fifo_init_count = 300;
+    // the EncDec tasks fifo carries a task per EncDec unit (tile with tile_parallel) and the
+    // segment row jobs of each unit, of every child PCS in flight
+    scs_ptr->mode_decision_configuration_fifo_init_count = MAX(300,
+        scs_ptr->picture_control_set_pool_init_count_child * enc_dec_unit_count * (1 + enc_dec_seg_h));
     scs_ptr->motion_estimation_fifo_init_count           = 300;
     scs_ptr->entropy_coding_fifo_init_count              = 300;
-    scs_ptr->enc_dec_fifo_init_count                     = 300;
+    // the EncDec results fifo also carries the DLF SB-row jobs of every child PCS in flight
+    scs_ptr->enc_dec_fifo_init_count                     = MAX(300,
+        scs_ptr->picture_control_set_pool_init_count_child * (1 + (scs_ptr->max_input_luma_height + 63) / 64));
     scs_ptr->dlf_fifo_init_count                         = 300;
-    scs_ptr->cdef_fifo_init_count                        = 300;
+    // the CDEF results fifo also carries the Rest stripe jobs of every child PCS in flight
+    scs_ptr->cdef_fifo_init_count                        = MAX(300,
+        scs_ptr->picture_control_set_pool_init_count_child * (scs_ptr->rest_segment_column_count * scs_ptr->rest_segment_row_count +
+        (scs_ptr->max_input_luma_height + 63) / 64));
     scs_ptr->rest_fifo_init_count                        = 300;
     //#====================== Processes number ======================
     scs_ptr->total_process_init_count                    = 0;
@@ -586,8 +610,34 @@ EbErrorType load_default_buffer_configuration_settings(
         scs_ptr->total_process_init_count += (scs_ptr->rest_process_init_count                        = 1);
     }
 
+    if (scs_ptr->static_config.thread_pool) {
+        // One pool worker per core, each with its own context of every multi-threaded stage
+        scs_ptr->picture_analysis_process_init_count            = core_count;
+        scs_ptr->motion_estimation_process_init_count           = core_count;
+        scs_ptr->source_based_operations_process_init_count     = core_count;
+        scs_ptr->mode_decision_configuration_process_init_count = core_count;
+        scs_ptr->enc_dec_process_init_count                     = core_count;
+        scs_ptr->entropy_coding_process_init_count              = core_count;
+        scs_ptr->dlf_process_init_count                         = core_count;
+        scs_ptr->cdef_process_init_count                        = core_count;
+        scs_ptr->rest_process_init_count                        = core_count;
+        scs_ptr->total_process_init_count                       = core_count;
+    }
+
     scs_ptr->total_process_init_count += 6; // single processes count
+
+    // Picture Analysis segments: split each picture into SB rows so that the PA threads can work
+    // on one picture concurrently (one segment per PA thread, at most one per 64x64 row)
+    scs_ptr->pa_segment_row_count = (me_seg_h == 1) ? 1 :
+        MIN(scs_ptr->picture_analysis_process_init_count, (scs_ptr->max_input_luma_height + 32) / BLOCK_SIZE_64);
+    scs_ptr->pa_segment_row_count = MAX(scs_ptr->pa_segment_row_count, 1);
+    // The resource coordination results also carry the PA segment tasks, posted by the PA threads
+    // themselves: each parent PCS in flight holds at most its prep task and one task per segment
+    scs_ptr->resource_coordination_fifo_init_count = MAX(300,
+        scs_ptr->picture_control_set_pool_init_count * (1 + scs_ptr->pa_segment_row_count));
     SVT_LOG("Number of logical cores available: %u\nNumber of PPCS %u\n", core_count, scs_ptr->picture_control_set_pool_init_count);
+    if (scs_ptr->static_config.pool_memory_budget)
+        SVT_LOG("Picture pools grow from %u PPCS within %u MB\n", scs_ptr->picture_control_set_pool_min_count, scs_ptr->static_config.pool_memory_budget);
 
     /******************************************************************
     * Platform detection, limit cpu flags to hardware available CPU
@@ -674,6 +724,9 @@ void lib_svt_encoder_send_error_exit(
 static void eb_enc_handle_stop_threads(EbEncHandle *enc_handle_ptr)
 {
     SequenceControlSet*  control_set_ptr = enc_handle_ptr->scs_instance_array[0]->scs_ptr;
+    // Thread Pool
+    EB_DELETE(enc_handle_ptr->thread_pool_ptr);
+
     // Resource Coordination
     EB_DESTROY_THREAD(enc_handle_ptr->resource_coordination_thread_handle);
     EB_DESTROY_THREAD_ARRAY(enc_handle_ptr->picture_analysis_thread_handle_array,control_set_ptr->picture_analysis_process_init_count);
@@ -725,6 +778,11 @@ static void eb_enc_handle_dctor(EbPtr p)
     EbEncHandle *enc_handle_ptr = (EbEncHandle *)p;
 
     eb_enc_handle_stop_threads(enc_handle_ptr);
+    if (enc_handle_ptr->scs_instance_array[0]->scs_ptr->static_config.numa_mode)
+        eb_numa_print_stats(&enc_handle_ptr->scs_instance_array[0]->encode_context_ptr->numa_stats);
+    // Before the pools are freed, once the pictures have been touched
+    if (enc_handle_ptr->scs_instance_array[0]->scs_ptr->static_config.huge_pages)
+        eb_print_huge_page_usage();
     EB_FREE_PTR_ARRAY(enc_handle_ptr->app_callback_ptr_array, enc_handle_ptr->encode_instance_total_count);
     EB_DELETE(enc_handle_ptr->scs_pool_ptr);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->picture_parent_control_set_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
@@ -732,8 +790,10 @@ static void eb_enc_handle_dctor(EbPtr p)
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->picture_control_set_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->pa_reference_picture_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->overlay_input_picture_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
+    EB_DELETE(enc_handle_ptr->pool_memory_budget_ptr);
     EB_DELETE(enc_handle_ptr->input_buffer_resource_ptr);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->output_stream_buffer_resource_ptr_array, enc_handle_ptr->encode_instance_total_count);
+    EB_DELETE_PTR_ARRAY(enc_handle_ptr->packet_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->output_recon_buffer_resource_ptr_array, enc_handle_ptr->encode_instance_total_count);
     EB_DELETE(enc_handle_ptr->resource_coordination_results_resource_ptr);
     EB_DELETE(enc_handle_ptr->picture_analysis_results_resource_ptr);
@@ -767,6 +827,7 @@ static void eb_enc_handle_dctor(EbPtr p)
     EB_DELETE(enc_handle_ptr->rate_control_context_ptr);
     EB_DELETE(enc_handle_ptr->packetization_context_ptr);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->reference_picture_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
+    EB_DELETE(enc_handle_ptr->pipeline_stats_ptr);
 
 }
 
@@ -806,6 +867,14 @@ EbErrorType eb_input_buffer_header_creator(
     EbPtr *object_dbl_ptr,
     EbPtr  object_init_data_ptr);
 
+EbErrorType eb_zero_copy_input_buffer_header_creator(
+    EbPtr *object_dbl_ptr,
+    EbPtr  object_init_data_ptr);
+
+static void release_zero_copy_input(
+    EbPtr                   hook_arg,
+    EbObjectWrapper        *wrapper_ptr);
+
 EbErrorType eb_output_recon_buffer_header_creator(
     EbPtr *object_dbl_ptr,
     EbPtr  object_init_data_ptr);
@@ -888,6 +957,48 @@ EbErrorType rest_results_creator(
     return EB_ErrorNone;
 }
 
+/*
+ * Upper bound of the tile count of a picture, which sizes the per-tile entropy
+ * coding state of the child PCS. Mirrors set_tile_info(): the configured log2
+ * counts are raised to the minimums set by MAX_TILE_WIDTH and MAX_TILE_AREA and
+ * clipped to the SB counts.
+ */
+static uint16_t get_max_tile_count(SequenceControlSet *scs_ptr, uint32_t sb_size) {
+    const int32_t sb_cols = (scs_ptr->max_input_luma_width + sb_size - 1) / sb_size;
+    const int32_t sb_rows = (scs_ptr->max_input_luma_height + sb_size - 1) / sb_size;
+    const int32_t min_log2_tile_cols = tile_log2(MAX_TILE_WIDTH / sb_size, sb_cols);
+    const int32_t max_log2_tile_cols = tile_log2(1, MIN(sb_cols, MAX_TILE_COLS));
+    const int32_t max_log2_tile_rows = tile_log2(1, MIN(sb_rows, MAX_TILE_ROWS));
+    const int32_t min_log2_tiles     = MAX(
+        tile_log2(MAX_TILE_AREA / (sb_size * sb_size), sb_cols * sb_rows), min_log2_tile_cols);
+    const int32_t log2_tile_cols = MIN(
+        MAX(scs_ptr->static_config.tile_columns, min_log2_tile_cols), max_log2_tile_cols);
+    const int32_t log2_tile_rows = MIN(
+        MAX(scs_ptr->static_config.tile_rows, MAX(min_log2_tiles - log2_tile_cols, 0)),
+        max_log2_tile_rows);
+
+    return (uint16_t)(MIN(1 << log2_tile_cols, sb_cols) * MIN(1 << log2_tile_rows, sb_rows));
+}
+
+/*
+ * Upper bound of the tile size of a picture, in pixels, which sizes the per-tile
+ * entropy coding state of the child PCS. The fewest tiles are the configured
+ * ones, clipped to the SB counts; a raise to the minimums or a smaller picture
+ * only makes the tiles smaller.
+ */
+static void get_max_tile_size(SequenceControlSet *scs_ptr, uint32_t sb_size, uint16_t *width,
+                              uint16_t *height) {
+    const int32_t sb_cols = (scs_ptr->max_input_luma_width + sb_size - 1) / sb_size;
+    const int32_t sb_rows = (scs_ptr->max_input_luma_height + sb_size - 1) / sb_size;
+    const int32_t log2_tile_cols =
+        MIN(scs_ptr->static_config.tile_columns, tile_log2(1, MIN(sb_cols, MAX_TILE_COLS)));
+    const int32_t log2_tile_rows =
+        MIN(scs_ptr->static_config.tile_rows, tile_log2(1, MIN(sb_rows, MAX_TILE_ROWS)));
+
+    *width  = (uint16_t)(((sb_cols + (1 << log2_tile_cols) - 1) >> log2_tile_cols) * sb_size);
+    *height = (uint16_t)(((sb_rows + (1 << log2_tile_rows) - 1) >> log2_tile_rows) * sb_size);
+}
+
 void init_fn_ptr(void);
 extern void av1_init_wedge_masks(void);
 /**********************************
@@ -925,6 +1036,30 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
     eb_av1_init_me_luts();
     init_fn_ptr();
     av1_init_wedge_masks();
+
+    // The thread pool polls the stage queues, which the lock-free ones support
+    EbBool lockfree_queue = eb_system_resource_get_lockfree();
+    if (enc_handle_ptr->scs_instance_array[0]->scs_ptr->static_config.thread_pool)
+        eb_system_resource_set_lockfree(EB_TRUE);
+
+    // NUMA mode spreads the picture pools, the EncDec contexts and the stage threads over the nodes
+    EbBool numa_mode = EB_FALSE;
+    if (enc_handle_ptr->scs_instance_array[0]->scs_ptr->static_config.numa_mode) {
+        numa_mode = eb_numa_init() > 1;
+        if (!numa_mode)
+            SVT_WARN("numa_mode is ignored, a single NUMA node was found\n");
+    }
+    // The placements of this encoder are accounted in its own statistics
+    if (numa_mode)
+        eb_numa_set_alloc_stats(&enc_handle_ptr->scs_instance_array[0]->encode_context_ptr->numa_stats);
+
+    // The picture buffers of the pools go on huge pages
+    const EbBool huge_pages = enc_handle_ptr->scs_instance_array[0]->scs_ptr->static_config.huge_pages &&
+        eb_huge_page_supported();
+    if (enc_handle_ptr->scs_instance_array[0]->scs_ptr->static_config.huge_pages && !huge_pages)
+        SVT_WARN("huge_pages is ignored, huge pages are only supported on Linux\n");
+    eb_huge_page_set_enabled(huge_pages);
+
     /************************************
     * Sequence Control Set
     ************************************/
@@ -937,9 +1072,16 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
         &scs_init,
         NULL);
 
+    // The picture pools grow on demand within the budget, when one is set
+    if (enc_handle_ptr->scs_instance_array[0]->scs_ptr->static_config.pool_memory_budget)
+        EB_NEW(enc_handle_ptr->pool_memory_budget_ptr,
+            eb_memory_budget_ctor,
+            (uint64_t)enc_handle_ptr->scs_instance_array[0]->scs_ptr->static_config.pool_memory_budget << 20);
+
     /************************************
     * Picture Control Set: Parent
     ************************************/
+    eb_system_resource_set_numa_spread(numa_mode);
     EB_ALLOC_PTR_ARRAY(enc_handle_ptr->picture_parent_control_set_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
 
     for (instance_index = 0; instance_index < enc_handle_ptr->encode_instance_total_count; ++instance_index) {
@@ -966,15 +1108,29 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
         input_data.ext_block_flag = (uint8_t)enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->static_config.ext_block_flag;
         input_data.mrp_mode = enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->mrp_mode;
         input_data.nsq_present = enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->nsq_present;
-        EB_NEW(
-            enc_handle_ptr->picture_parent_control_set_pool_ptr_array[instance_index],
-            eb_system_resource_ctor,
-            enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->picture_control_set_pool_init_count,//enc_handle_ptr->pcs_pool_total_count,
-            1,
-            0,
-            picture_parent_control_set_creator,
-            &input_data,
-            NULL);
+        if (enc_handle_ptr->pool_memory_budget_ptr)
+            EB_NEW(
+                enc_handle_ptr->picture_parent_control_set_pool_ptr_array[instance_index],
+                eb_system_resource_growable_ctor,
+                enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->picture_control_set_pool_min_count,
+                enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->picture_control_set_pool_init_count,
+                1,
+                0,
+                picture_parent_control_set_creator,
+                &input_data,
+                sizeof(input_data),
+                NULL,
+                enc_handle_ptr->pool_memory_budget_ptr);
+        else
+            EB_NEW(
+                enc_handle_ptr->picture_parent_control_set_pool_ptr_array[instance_index],
+                eb_system_resource_ctor,
+                enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->picture_control_set_pool_init_count,//enc_handle_ptr->pcs_pool_total_count,
+                1,
+                0,
+                picture_parent_control_set_creator,
+                &input_data,
+                NULL);
     }
 
     /************************************
@@ -1009,20 +1165,39 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
         input_data.color_format = color_format;
         input_data.sb_sz = enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->sb_sz;
         input_data.sb_size_pix = scs_init.sb_size;
+        input_data.tile_count = get_max_tile_count(enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr, scs_init.sb_size);
+        get_max_tile_size(enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr, scs_init.sb_size,
+            &input_data.tile_max_width, &input_data.tile_max_height);
+        input_data.enc_dec_unit_count = enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->static_config.tile_parallel ?
+            input_data.tile_count : 1;
         input_data.max_depth = enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->max_sb_depth;
         input_data.hbd_mode_decision = enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->static_config.enable_hbd_mode_decision;
         input_data.cdf_mode = enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->cdf_mode;
         input_data.mfmv = enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->mfmv_enabled;
         input_data.cfg_palette = enc_handle_ptr->scs_instance_array[0]->scs_ptr->static_config.screen_content_mode;
-        EB_NEW(
-            enc_handle_ptr->picture_control_set_pool_ptr_array[instance_index],
-            eb_system_resource_ctor,
-            enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->picture_control_set_pool_init_count_child, //EB_PictureControlSetPoolInitCountChild,
-            1,
-            0,
-            picture_control_set_creator,
-            &input_data,
-            NULL);
+        if (enc_handle_ptr->pool_memory_budget_ptr)
+            EB_NEW(
+                enc_handle_ptr->picture_control_set_pool_ptr_array[instance_index],
+                eb_system_resource_growable_ctor,
+                enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->picture_control_set_pool_min_count_child,
+                enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->picture_control_set_pool_init_count_child,
+                1,
+                0,
+                picture_control_set_creator,
+                &input_data,
+                sizeof(input_data),
+                NULL,
+                enc_handle_ptr->pool_memory_budget_ptr);
+        else
+            EB_NEW(
+                enc_handle_ptr->picture_control_set_pool_ptr_array[instance_index],
+                eb_system_resource_ctor,
+                enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->picture_control_set_pool_init_count_child, //EB_PictureControlSetPoolInitCountChild,
+                1,
+                0,
+                picture_control_set_creator,
+                &input_data,
+                NULL);
     }
 
     /************************************
@@ -1070,15 +1245,29 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
         eb_ref_obj_ect_desc_init_data_structure.reference_picture_desc_init_data = ref_pic_buf_desc_init_data;
 
         // Reference Picture Buffers
-        EB_NEW(
-            enc_handle_ptr->reference_picture_pool_ptr_array[instance_index],
-            eb_system_resource_ctor,
-            enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->reference_picture_buffer_init_count,//enc_handle_ptr->ref_pic_pool_total_count,
-            EB_PictureManagerProcessInitCount,
-            0,
-            eb_reference_object_creator,
-            &(eb_ref_obj_ect_desc_init_data_structure),
-            NULL);
+        if (enc_handle_ptr->pool_memory_budget_ptr)
+            EB_NEW(
+                enc_handle_ptr->reference_picture_pool_ptr_array[instance_index],
+                eb_system_resource_growable_ctor,
+                enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->reference_picture_buffer_min_count,
+                enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->reference_picture_buffer_init_count,
+                EB_PictureManagerProcessInitCount,
+                0,
+                eb_reference_object_creator,
+                &(eb_ref_obj_ect_desc_init_data_structure),
+                sizeof(eb_ref_obj_ect_desc_init_data_structure),
+                NULL,
+                enc_handle_ptr->pool_memory_budget_ptr);
+        else
+            EB_NEW(
+                enc_handle_ptr->reference_picture_pool_ptr_array[instance_index],
+                eb_system_resource_ctor,
+                enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->reference_picture_buffer_init_count,//enc_handle_ptr->ref_pic_pool_total_count,
+                EB_PictureManagerProcessInitCount,
+                0,
+                eb_reference_object_creator,
+                &(eb_ref_obj_ect_desc_init_data_structure),
+                NULL);
 
         // PA Reference Picture Buffers
         // Currently, only Luma samples are needed in the PA
@@ -1120,14 +1309,27 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
         eb_pa_ref_obj_ect_desc_init_data_structure.quarter_picture_desc_init_data = quart_pic_buf_desc_init_data;
         eb_pa_ref_obj_ect_desc_init_data_structure.sixteenth_picture_desc_init_data = sixteenth_pic_buf_desc_init_data;
         // Reference Picture Buffers
-        EB_NEW(enc_handle_ptr->pa_reference_picture_pool_ptr_array[instance_index],
-            eb_system_resource_ctor,
-            enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->pa_reference_picture_buffer_init_count,
-            EB_PictureDecisionProcessInitCount,
-            0,
-            eb_pa_reference_object_creator,
-            &(eb_pa_ref_obj_ect_desc_init_data_structure),
-            NULL);
+        if (enc_handle_ptr->pool_memory_budget_ptr)
+            EB_NEW(enc_handle_ptr->pa_reference_picture_pool_ptr_array[instance_index],
+                eb_system_resource_growable_ctor,
+                enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->pa_reference_picture_buffer_min_count,
+                enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->pa_reference_picture_buffer_init_count,
+                EB_PictureDecisionProcessInitCount,
+                0,
+                eb_pa_reference_object_creator,
+                &(eb_pa_ref_obj_ect_desc_init_data_structure),
+                sizeof(eb_pa_ref_obj_ect_desc_init_data_structure),
+                NULL,
+                enc_handle_ptr->pool_memory_budget_ptr);
+        else
+            EB_NEW(enc_handle_ptr->pa_reference_picture_pool_ptr_array[instance_index],
+                eb_system_resource_ctor,
+                enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->pa_reference_picture_buffer_init_count,
+                EB_PictureDecisionProcessInitCount,
+                0,
+                eb_pa_reference_object_creator,
+                &(eb_pa_ref_obj_ect_desc_init_data_structure),
+                NULL);
         // Set the SequenceControlSet Picture Pool Fifo Ptrs
         enc_handle_ptr->scs_instance_array[instance_index]->encode_context_ptr->reference_picture_pool_fifo_ptr = eb_system_resource_get_producer_fifo(enc_handle_ptr->reference_picture_pool_ptr_array[instance_index], 0);
         enc_handle_ptr->scs_instance_array[instance_index]->encode_context_ptr->pa_reference_picture_pool_fifo_ptr = eb_system_resource_get_producer_fifo(enc_handle_ptr->pa_reference_picture_pool_ptr_array[instance_index], 0);
@@ -1147,6 +1349,7 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
             enc_handle_ptr->scs_instance_array[instance_index]->encode_context_ptr->overlay_input_picture_pool_fifo_ptr = eb_system_resource_get_producer_fifo(enc_handle_ptr->overlay_input_picture_pool_ptr_array[instance_index], 0);
         }
     }
+    eb_system_resource_set_numa_spread(EB_FALSE);
 
     /************************************
     * System Resource Managers & Fifos
@@ -1159,11 +1362,18 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
         enc_handle_ptr->scs_instance_array[0]->scs_ptr->input_buffer_fifo_init_count,
         1,
         EB_ResourceCoordinationProcessInitCount,
-        eb_input_buffer_header_creator,
+        enc_handle_ptr->scs_instance_array[0]->scs_ptr->static_config.zero_copy_input ?
+            eb_zero_copy_input_buffer_header_creator : eb_input_buffer_header_creator,
         enc_handle_ptr->scs_instance_array[0]->scs_ptr,
         eb_input_buffer_header_destroyer);
 
     enc_handle_ptr->input_buffer_producer_fifo_ptr = eb_system_resource_get_producer_fifo(enc_handle_ptr->input_buffer_resource_ptr, 0);
+    // Zero-copy input pictures go back to the application with their wrapper
+    if (enc_handle_ptr->scs_instance_array[0]->scs_ptr->static_config.zero_copy_input)
+        eb_system_resource_set_release_hook(
+            enc_handle_ptr->input_buffer_resource_ptr,
+            release_zero_copy_input,
+            &enc_handle_ptr->scs_instance_array[0]->scs_ptr->static_config);
 
 
     // EbBufferHeaderType Output Stream
@@ -1180,6 +1390,21 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
             &enc_handle_ptr->scs_instance_array[0]->scs_ptr->static_config,
             eb_output_buffer_header_destroyer);
     }
+    // Bitstream buffers of the packets, recycled as the packets are released
+    EB_ALLOC_PTR_ARRAY(enc_handle_ptr->packet_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
+
+    for (instance_index = 0; instance_index < enc_handle_ptr->encode_instance_total_count; ++instance_index) {
+        EbSvtAv1EncConfiguration *config = &enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->static_config;
+        EB_NEW(
+            enc_handle_ptr->packet_pool_ptr_array[instance_index],
+            eb_packet_pool_ctor,
+            (uint32_t)(EB_OUTPUTSTREAMBUFFERSIZE_MACRO(config->source_width * config->source_height)),
+            enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->output_stream_buffer_fifo_init_count);
+        eb_system_resource_set_release_hook(
+            enc_handle_ptr->output_stream_buffer_resource_ptr_array[instance_index],
+            eb_packet_pool_release,
+            enc_handle_ptr->packet_pool_ptr_array[instance_index]);
+    }
     enc_handle_ptr->output_stream_buffer_consumer_fifo_ptr = eb_system_resource_get_consumer_fifo(enc_handle_ptr->output_stream_buffer_resource_ptr_array[0], 0);
     if (enc_handle_ptr->scs_instance_array[0]->scs_ptr->static_config.recon_enabled) {
         // EbBufferHeaderType Output Recon
@@ -1207,7 +1432,8 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
             enc_handle_ptr->resource_coordination_results_resource_ptr,
             eb_system_resource_ctor,
             enc_handle_ptr->scs_instance_array[0]->scs_ptr->resource_coordination_fifo_init_count,
-            EB_ResourceCoordinationProcessInitCount,
+            EB_ResourceCoordinationProcessInitCount +
+                enc_handle_ptr->scs_instance_array[0]->scs_ptr->picture_analysis_process_init_count,
             enc_handle_ptr->scs_instance_array[0]->scs_ptr->picture_analysis_process_init_count,
             resource_coordination_result_creator,
             &resource_coordination_result_init_data,
@@ -1350,7 +1576,8 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
             enc_handle_ptr->enc_dec_results_resource_ptr,
             eb_system_resource_ctor,
             enc_handle_ptr->scs_instance_array[0]->scs_ptr->enc_dec_fifo_init_count,
-            enc_handle_ptr->scs_instance_array[0]->scs_ptr->enc_dec_process_init_count,
+            enc_handle_ptr->scs_instance_array[0]->scs_ptr->enc_dec_process_init_count +
+                enc_handle_ptr->scs_instance_array[0]->scs_ptr->dlf_process_init_count,
             enc_handle_ptr->scs_instance_array[0]->scs_ptr->dlf_process_init_count,
             enc_dec_results_creator,
             &enc_dec_result_init_data,
@@ -1379,7 +1606,8 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
             enc_handle_ptr->cdef_results_resource_ptr,
             eb_system_resource_ctor,
             enc_handle_ptr->scs_instance_array[0]->scs_ptr->cdef_fifo_init_count,
-            enc_handle_ptr->scs_instance_array[0]->scs_ptr->cdef_process_init_count,
+            enc_handle_ptr->scs_instance_array[0]->scs_ptr->cdef_process_init_count +
+                enc_handle_ptr->scs_instance_array[0]->scs_ptr->rest_process_init_count,
             enc_handle_ptr->scs_instance_array[0]->scs_ptr->rest_process_init_count,
             cdef_results_creator,
             &cdef_result_init_data,
@@ -1415,6 +1643,9 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
             NULL);
     }
 
+    eb_system_resource_set_lockfree(lockfree_queue);
+    eb_huge_page_set_enabled(EB_FALSE);
+
     /************************************
     * App Callbacks
     ************************************/
@@ -1423,6 +1654,7 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
     // svt Output Buffer Fifo Ptrs
     for (instance_index = 0; instance_index < enc_handle_ptr->encode_instance_total_count; ++instance_index) {
         enc_handle_ptr->scs_instance_array[instance_index]->encode_context_ptr->stream_output_fifo_ptr     = eb_system_resource_get_producer_fifo(enc_handle_ptr->output_stream_buffer_resource_ptr_array[instance_index], 0);
+        enc_handle_ptr->scs_instance_array[instance_index]->encode_context_ptr->packet_pool_ptr            = enc_handle_ptr->packet_pool_ptr_array[instance_index];
         if (enc_handle_ptr->scs_instance_array[0]->scs_ptr->static_config.recon_enabled)
             enc_handle_ptr->scs_instance_array[instance_index]->encode_context_ptr->recon_output_fifo_ptr  = eb_system_resource_get_producer_fifo(enc_handle_ptr->output_recon_buffer_resource_ptr_array[instance_index], 0);
     }
@@ -1446,7 +1678,8 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
             enc_handle_ptr->picture_analysis_context_ptr_array[process_index],
             picture_analysis_context_ctor,
             enc_handle_ptr,
-            process_index);
+            process_index,
+            EB_ResourceCoordinationProcessInitCount + process_index);
    }
 
     // Picture Decision Context
@@ -1524,6 +1757,9 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
     // EncDec Contexts
     EB_ALLOC_PTR_ARRAY(enc_handle_ptr->enc_dec_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs_ptr->enc_dec_process_init_count);
     for (process_index = 0; process_index < enc_handle_ptr->scs_instance_array[0]->scs_ptr->enc_dec_process_init_count; ++process_index) {
+        // On the node the thread of the context is bound to
+        if (numa_mode)
+            eb_numa_set_alloc_node(eb_numa_spread_node(process_index, enc_handle_ptr->scs_instance_array[0]->scs_ptr->enc_dec_process_init_count));
         EB_NEW(
             enc_handle_ptr->enc_dec_context_ptr_array[process_index],
             enc_dec_context_ctor,
@@ -1532,6 +1768,8 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
             enc_dec_port_lookup(ENCDEC_INPUT_PORT_ENCDEC, process_index),
             enc_handle_ptr->scs_instance_array[0]->scs_ptr->source_based_operations_process_init_count + process_index);
     }
+    eb_numa_set_alloc_node(EB_NUMA_NODE_ANY);
+    eb_numa_set_alloc_stats(NULL);
 
     // Dlf Contexts
     EB_ALLOC_PTR_ARRAY(enc_handle_ptr->dlf_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs_ptr->dlf_process_init_count);
@@ -1541,7 +1779,8 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
             enc_handle_ptr->dlf_context_ptr_array[process_index],
             dlf_context_ctor,
             enc_handle_ptr,
-            process_index);
+            process_index,
+            enc_handle_ptr->scs_instance_array[0]->scs_ptr->enc_dec_process_init_count + process_index);
     }
 
     //CDEF Contexts
@@ -1563,7 +1802,8 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
             rest_context_ctor,
             enc_handle_ptr,
             process_index,
-            1 + process_index);
+            1 + process_index,
+            enc_handle_ptr->scs_instance_array[0]->scs_ptr->cdef_process_init_count + process_index);
     }
 
     // Entropy Coding Contexts
@@ -1596,64 +1836,162 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
 
     control_set_ptr = enc_handle_ptr->scs_instance_array[0]->scs_ptr;
 
+    if (config_ptr->pipeline_stats) {
+        // Every stage, by the queue feeding it; the pooled stages have no threads of their own
+        const uint32_t dedicated = config_ptr->thread_pool ? 0 : 1;
+        const struct {
+            EbSystemResource *input_resource_ptr;
+            const char       *name;
+            uint32_t          thread_count;
+        } stats_stages[] = {
+            {enc_handle_ptr->input_buffer_resource_ptr, "ResourceCoordination", 1},
+            {enc_handle_ptr->resource_coordination_results_resource_ptr, "PictureAnalysis", dedicated * control_set_ptr->picture_analysis_process_init_count},
+            {enc_handle_ptr->picture_analysis_results_resource_ptr, "PictureDecision", 1},
+            {enc_handle_ptr->picture_decision_results_resource_ptr, "MotionEstimation", dedicated * control_set_ptr->motion_estimation_process_init_count},
+            {enc_handle_ptr->motion_estimation_results_resource_ptr, "InitialRateControl", 1},
+            {enc_handle_ptr->initial_rate_control_results_resource_ptr, "SourceBasedOperations", dedicated * control_set_ptr->source_based_operations_process_init_count},
+            {enc_handle_ptr->picture_demux_results_resource_ptr, "PictureManager", 1},
+            {enc_handle_ptr->rate_control_tasks_resource_ptr, "RateControl", 1},
+            {enc_handle_ptr->rate_control_results_resource_ptr, "ModeDecisionConfiguration", dedicated * control_set_ptr->mode_decision_configuration_process_init_count},
+            {enc_handle_ptr->enc_dec_tasks_resource_ptr, "EncDec", dedicated * control_set_ptr->enc_dec_process_init_count},
+            {enc_handle_ptr->enc_dec_results_resource_ptr, "Dlf", dedicated * control_set_ptr->dlf_process_init_count},
+            {enc_handle_ptr->dlf_results_resource_ptr, "Cdef", dedicated * control_set_ptr->cdef_process_init_count},
+            {enc_handle_ptr->cdef_results_resource_ptr, "Rest", dedicated * control_set_ptr->rest_process_init_count},
+            {enc_handle_ptr->rest_results_resource_ptr, "EntropyCoding", dedicated * control_set_ptr->entropy_coding_process_init_count},
+            {enc_handle_ptr->entropy_coding_results_resource_ptr, "Packetization", 1}};
+
+        EB_NEW(enc_handle_ptr->pipeline_stats_ptr, eb_pipeline_stats_ctor, config_ptr->pipeline_stats);
+        for (uint32_t stage_index = 0; stage_index < sizeof(stats_stages) / sizeof(stats_stages[0]); ++stage_index) {
+            eb_pipeline_stats_add_stage(enc_handle_ptr->pipeline_stats_ptr,
+                stats_stages[stage_index].input_resource_ptr,
+                stats_stages[stage_index].name,
+                stats_stages[stage_index].thread_count);
+        }
+    }
+
+    if (config_ptr->thread_pool) {
+        // Multi-threaded stages, in pipeline order: the pool runs the last ones first
+        const struct {
+            EbSystemResource *input_resource_ptr;
+            EbThreadContext **context_ptr_array;
+            EbPoolJob         job;
+        } pool_stages[] = {
+            {enc_handle_ptr->resource_coordination_results_resource_ptr, enc_handle_ptr->picture_analysis_context_ptr_array, picture_analysis_job},
+            {enc_handle_ptr->picture_decision_results_resource_ptr, enc_handle_ptr->motion_estimation_context_ptr_array, motion_estimation_job},
+            {enc_handle_ptr->initial_rate_control_results_resource_ptr, enc_handle_ptr->source_based_operations_context_ptr_array, source_based_operations_job},
+            {enc_handle_ptr->rate_control_results_resource_ptr, enc_handle_ptr->mode_decision_configuration_context_ptr_array, mode_decision_configuration_job},
+            {enc_handle_ptr->enc_dec_tasks_resource_ptr, enc_handle_ptr->enc_dec_context_ptr_array, enc_dec_job},
+            {enc_handle_ptr->enc_dec_results_resource_ptr, enc_handle_ptr->dlf_context_ptr_array, dlf_job},
+            {enc_handle_ptr->dlf_results_resource_ptr, enc_handle_ptr->cdef_context_ptr_array, cdef_job},
+            {enc_handle_ptr->cdef_results_resource_ptr, enc_handle_ptr->rest_context_ptr_array, rest_job},
+            {enc_handle_ptr->rest_results_resource_ptr, enc_handle_ptr->entropy_coding_context_ptr_array, entropy_coding_job}};
+
+        EB_NEW(enc_handle_ptr->thread_pool_ptr, eb_thread_pool_ctor, control_set_ptr->enc_dec_process_init_count);
+        for (uint32_t stage_index = 0; stage_index < sizeof(pool_stages) / sizeof(pool_stages[0]); ++stage_index) {
+            return_error = eb_thread_pool_add_stage(enc_handle_ptr->thread_pool_ptr,
+                pool_stages[stage_index].input_resource_ptr,
+                pool_stages[stage_index].context_ptr_array,
+                pool_stages[stage_index].job);
+            if (return_error != EB_ErrorNone)
+                return return_error;
+        }
+        enc_handle_ptr->thread_pool_ptr->stats_ptr = enc_handle_ptr->pipeline_stats_ptr;
+        return_error = eb_thread_pool_start(enc_handle_ptr->thread_pool_ptr);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+    }
+
     // Resource Coordination
     EB_CREATE_THREAD(enc_handle_ptr->resource_coordination_thread_handle, resource_coordination_kernel, enc_handle_ptr->resource_coordination_context_ptr);
-    EB_CREATE_THREAD_ARRAY(enc_handle_ptr->picture_analysis_thread_handle_array,control_set_ptr->picture_analysis_process_init_count,
-        picture_analysis_kernel,
-        enc_handle_ptr->picture_analysis_context_ptr_array);
 
     // Picture Decision
     EB_CREATE_THREAD(enc_handle_ptr->picture_decision_thread_handle, picture_decision_kernel, enc_handle_ptr->picture_decision_context_ptr);
 
-    // Motion Estimation
-    EB_CREATE_THREAD_ARRAY(enc_handle_ptr->motion_estimation_thread_handle_array, control_set_ptr->motion_estimation_process_init_count,
-        motion_estimation_kernel,
-        enc_handle_ptr->motion_estimation_context_ptr_array);
-
     // Initial Rate Control
     EB_CREATE_THREAD(enc_handle_ptr->initial_rate_control_thread_handle, initial_rate_control_kernel, enc_handle_ptr->initial_rate_control_context_ptr);
 
-    // Source Based Oprations
-    EB_CREATE_THREAD_ARRAY(enc_handle_ptr->source_based_operations_thread_handle_array, control_set_ptr->source_based_operations_process_init_count,
-        source_based_operations_kernel,
-        enc_handle_ptr->source_based_operations_context_ptr_array);
-
     // Picture Manager
     EB_CREATE_THREAD(enc_handle_ptr->picture_manager_thread_handle, picture_manager_kernel, enc_handle_ptr->picture_manager_context_ptr);
 
     // Rate Control
     EB_CREATE_THREAD(enc_handle_ptr->rate_control_thread_handle, rate_control_kernel, enc_handle_ptr->rate_control_context_ptr);
 
-    // Mode Decision Configuration Process
-    EB_CREATE_THREAD_ARRAY(enc_handle_ptr->mode_decision_configuration_thread_handle_array, control_set_ptr->mode_decision_configuration_process_init_count,
-        mode_decision_configuration_kernel,
-        enc_handle_ptr->mode_decision_configuration_context_ptr_array);
-
-
-    // EncDec Process
-    EB_CREATE_THREAD_ARRAY(enc_handle_ptr->enc_dec_thread_handle_array, control_set_ptr->enc_dec_process_init_count,
-        enc_dec_kernel,
-        enc_handle_ptr->enc_dec_context_ptr_array);
-
-    // Dlf Process
-    EB_CREATE_THREAD_ARRAY(enc_handle_ptr->dlf_thread_handle_array, control_set_ptr->dlf_process_init_count,
-        dlf_kernel,
-        enc_handle_ptr->dlf_context_ptr_array);
-
-    // Cdef Process
-    EB_CREATE_THREAD_ARRAY(enc_handle_ptr->cdef_thread_handle_array, control_set_ptr->cdef_process_init_count,
-        cdef_kernel,
-        enc_handle_ptr->cdef_context_ptr_array);
-
-    // Rest Process
-    EB_CREATE_THREAD_ARRAY(enc_handle_ptr->rest_thread_handle_array, control_set_ptr->rest_process_init_count,
-        rest_kernel,
-        enc_handle_ptr->rest_context_ptr_array);
-
-    // Entropy Coding Process
-    EB_CREATE_THREAD_ARRAY(enc_handle_ptr->entropy_coding_thread_handle_array, control_set_ptr->entropy_coding_process_init_count,
-        entropy_coding_kernel,
-        enc_handle_ptr->entropy_coding_context_ptr_array);
+    if (enc_handle_ptr->thread_pool_ptr == NULL) {
+        // Picture Analysis
+        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->picture_analysis_thread_handle_array, control_set_ptr->picture_analysis_process_init_count,
+            picture_analysis_kernel,
+            enc_handle_ptr->picture_analysis_context_ptr_array);
+
+        // Motion Estimation
+        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->motion_estimation_thread_handle_array, control_set_ptr->motion_estimation_process_init_count,
+            motion_estimation_kernel,
+            enc_handle_ptr->motion_estimation_context_ptr_array);
+
+        // Source Based Oprations
+        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->source_based_operations_thread_handle_array, control_set_ptr->source_based_operations_process_init_count,
+            source_based_operations_kernel,
+            enc_handle_ptr->source_based_operations_context_ptr_array);
+
+        // Mode Decision Configuration Process
+        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->mode_decision_configuration_thread_handle_array, control_set_ptr->mode_decision_configuration_process_init_count,
+            mode_decision_configuration_kernel,
+            enc_handle_ptr->mode_decision_configuration_context_ptr_array);
+
+        // EncDec Process
+        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->enc_dec_thread_handle_array, control_set_ptr->enc_dec_process_init_count,
+            enc_dec_kernel,
+            enc_handle_ptr->enc_dec_context_ptr_array);
+
+        // Dlf Process
+        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->dlf_thread_handle_array, control_set_ptr->dlf_process_init_count,
+            dlf_kernel,
+            enc_handle_ptr->dlf_context_ptr_array);
+
+        // Cdef Process
+        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->cdef_thread_handle_array, control_set_ptr->cdef_process_init_count,
+            cdef_kernel,
+            enc_handle_ptr->cdef_context_ptr_array);
+
+        // Rest Process
+        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->rest_thread_handle_array, control_set_ptr->rest_process_init_count,
+            rest_kernel,
+            enc_handle_ptr->rest_context_ptr_array);
+
+        // Entropy Coding Process
+        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->entropy_coding_thread_handle_array, control_set_ptr->entropy_coding_process_init_count,
+            entropy_coding_kernel,
+            enc_handle_ptr->entropy_coding_context_ptr_array);
+
+        if (numa_mode) {
+            // The threads of each stage are bound to the nodes in equal shares
+            const struct {
+                EbHandle *thread_handle_array;
+                uint32_t  thread_count;
+            } numa_stages[] = {
+                {enc_handle_ptr->picture_analysis_thread_handle_array, control_set_ptr->picture_analysis_process_init_count},
+                {enc_handle_ptr->motion_estimation_thread_handle_array, control_set_ptr->motion_estimation_process_init_count},
+                {enc_handle_ptr->source_based_operations_thread_handle_array, control_set_ptr->source_based_operations_process_init_count},
+                {enc_handle_ptr->mode_decision_configuration_thread_handle_array, control_set_ptr->mode_decision_configuration_process_init_count},
+                {enc_handle_ptr->enc_dec_thread_handle_array, control_set_ptr->enc_dec_process_init_count},
+                {enc_handle_ptr->dlf_thread_handle_array, control_set_ptr->dlf_process_init_count},
+                {enc_handle_ptr->cdef_thread_handle_array, control_set_ptr->cdef_process_init_count},
+                {enc_handle_ptr->rest_thread_handle_array, control_set_ptr->rest_process_init_count},
+                {enc_handle_ptr->entropy_coding_thread_handle_array, control_set_ptr->entropy_coding_process_init_count}};
+
+            for (uint32_t stage_index = 0; stage_index < sizeof(numa_stages) / sizeof(numa_stages[0]); ++stage_index) {
+                for (uint32_t thread_index = 0; thread_index < numa_stages[stage_index].thread_count; ++thread_index)
+                    eb_numa_bind_thread(numa_stages[stage_index].thread_handle_array[thread_index],
+                        eb_numa_spread_node(thread_index, numa_stages[stage_index].thread_count));
+            }
+            // EncDec tasks go to a waiting thread of the node of their picture, when every node has one
+            if (control_set_ptr->enc_dec_process_init_count >= eb_numa_node_count()) {
+                for (process_index = 0; process_index < control_set_ptr->enc_dec_process_init_count; ++process_index)
+                    eb_system_resource_set_consumer_node(enc_handle_ptr->enc_dec_tasks_resource_ptr, process_index,
+                        eb_numa_spread_node(process_index, control_set_ptr->enc_dec_process_init_count));
+            }
+            eb_numa_reset_stats(&enc_handle_ptr->scs_instance_array[0]->encode_context_ptr->numa_stats);
+        }
+    }
 
     // Packetization
     EB_CREATE_THREAD(enc_handle_ptr->packetization_thread_handle, packetization_kernel, enc_handle_ptr->packetization_context_ptr);
@@ -2107,6 +2445,7 @@ void copy_api_from_app(
     // Adaptive Loop Filter
     scs_ptr->static_config.tile_rows = ((EbSvtAv1EncConfiguration*)config_struct)->tile_rows;
     scs_ptr->static_config.tile_columns = ((EbSvtAv1EncConfiguration*)config_struct)->tile_columns;
+    scs_ptr->static_config.tile_parallel = ((EbSvtAv1EncConfiguration*)config_struct)->tile_parallel;
     scs_ptr->static_config.unrestricted_motion_vector = ((EbSvtAv1EncConfiguration*)config_struct)->unrestricted_motion_vector;
 
     // Rate Control
@@ -2169,6 +2508,17 @@ void copy_api_from_app(
     scs_ptr->static_config.logical_processors = ((EbSvtAv1EncConfiguration*)config_struct)->logical_processors;
     scs_ptr->static_config.unpin_lp1 = ((EbSvtAv1EncConfiguration*)config_struct)->unpin_lp1;
     scs_ptr->static_config.target_socket = ((EbSvtAv1EncConfiguration*)config_struct)->target_socket;
+    scs_ptr->static_config.thread_pool = ((EbSvtAv1EncConfiguration*)config_struct)->thread_pool;
+    scs_ptr->static_config.numa_mode = ((EbSvtAv1EncConfiguration*)config_struct)->numa_mode;
+    scs_ptr->static_config.huge_pages = ((EbSvtAv1EncConfiguration*)config_struct)->huge_pages;
+    scs_ptr->static_config.pipeline_stats = ((EbSvtAv1EncConfiguration*)config_struct)->pipeline_stats;
+    scs_ptr->static_config.zero_copy_input = ((EbSvtAv1EncConfiguration*)config_struct)->zero_copy_input;
+    scs_ptr->static_config.input_release_callback = ((EbSvtAv1EncConfiguration*)config_struct)->input_release_callback;
+    scs_ptr->static_config.input_release_data = ((EbSvtAv1EncConfiguration*)config_struct)->input_release_data;
+    scs_ptr->static_config.pool_memory_budget = ((EbSvtAv1EncConfiguration*)config_struct)->pool_memory_budget;
+    scs_ptr->static_config.low_latency = ((EbSvtAv1EncConfiguration*)config_struct)->low_latency;
+    scs_ptr->static_config.latency_budget = ((EbSvtAv1EncConfiguration*)config_struct)->latency_budget;
+    scs_ptr->static_config.inter_frame_wavefront = ((EbSvtAv1EncConfiguration*)config_struct)->inter_frame_wavefront;
     scs_ptr->static_config.qp = ((EbSvtAv1EncConfiguration*)config_struct)->qp;
     scs_ptr->static_config.recon_enabled = ((EbSvtAv1EncConfiguration*)config_struct)->recon_enabled;
 
@@ -2196,6 +2546,15 @@ void copy_api_from_app(
     scs_ptr->static_config.md_stage_2_cand_prune_th = config_struct->md_stage_2_cand_prune_th;
     scs_ptr->static_config.md_stage_2_class_prune_th = config_struct->md_stage_2_class_prune_th;
 
+    // Real-time mode: pictures are coded in input order with no future frames
+    if (scs_ptr->static_config.low_latency) {
+        scs_ptr->static_config.pred_structure = EB_PRED_LOW_DELAY_P;
+        scs_ptr->static_config.look_ahead_distance = 0;
+        scs_ptr->static_config.enable_altrefs = EB_FALSE;
+        scs_ptr->static_config.enable_overlays = EB_FALSE;
+        scs_ptr->static_config.scene_change_detection = 0;
+    }
+
     return;
 }
 
@@ -2264,7 +2623,7 @@ static EbErrorType verify_settings(
         return_error = EB_ErrorBadParameter;
     }
 
-    if (config->pred_structure != 2) {
+    if (config->pred_structure != 2 && !config->low_latency) {
         SVT_LOG("Error instance %u: Pred Structure must be [2]\n", channel_number + 1);
         return_error = EB_ErrorBadParameter;
     }
@@ -2429,6 +2788,10 @@ static EbErrorType verify_settings(
         SVT_LOG("Error Instance %u: Log2Tile rows/cols must be [0 - 6] \n", channel_number + 1);
         return_error = EB_ErrorBadParameter;
     }
+    if (config->tile_parallel > 1) {
+        SVT_LOG("Error Instance %u: Invalid TileParallel flag [0 - 1] \n", channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
     if (config->unrestricted_motion_vector > 1) {
         SVT_LOG("Error Instance %u : Invalid Unrestricted Motion Vector flag [0 - 1]\n", channel_number + 1);
         return_error = EB_ErrorBadParameter;
@@ -2519,6 +2882,71 @@ static EbErrorType verify_settings(
         return_error = EB_ErrorBadParameter;
     }
 
+    if (config->thread_pool > 1) {
+        SVT_LOG("Error instance %u: Invalid thread_pool. thread_pool must be [0 - 1] \n", channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->numa_mode > 1) {
+        SVT_LOG("Error instance %u: Invalid numa_mode. numa_mode must be [0 - 1] \n", channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->numa_mode && config->thread_pool) {
+        SVT_LOG("Error instance %u: numa_mode is not supported with thread_pool \n", channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->numa_mode && config->target_socket != -1) {
+        SVT_LOG("Error instance %u: numa_mode is not supported with target_socket \n", channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->huge_pages > 1) {
+        SVT_LOG("Error instance %u: Invalid huge_pages. huge_pages must be [0 - 1] \n", channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->pipeline_stats > EB_PIPELINE_STATS_TRACE) {
+        SVT_LOG("Error instance %u: Invalid pipeline_stats. pipeline_stats must be [0 - 2] \n", channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->low_latency > 1) {
+        SVT_LOG("Error instance %u: Invalid low_latency. low_latency must be [0 - 1] \n", channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->low_latency && config->rate_control_mode > 1) {
+        SVT_LOG("Error instance %u: low_latency is not supported with rate control modes 2 and 3 \n", channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->inter_frame_wavefront > 1) {
+        SVT_LOG("Error instance %u: Invalid inter_frame_wavefront. inter_frame_wavefront must be [0 - 1] \n", channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->inter_frame_wavefront && config->thread_pool) {
+        SVT_LOG("Error instance %u: inter_frame_wavefront is not supported with thread_pool \n", channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->zero_copy_input > 1) {
+        SVT_LOG("Error instance %u: Invalid zero_copy_input. zero_copy_input must be [0 - 1] \n", channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->zero_copy_input && config->encoder_bit_depth != EB_8BIT) {
+        SVT_LOG("Error instance %u: zero_copy_input is only supported for 8-bit input \n", channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->zero_copy_input && config->input_release_callback == NULL) {
+        SVT_LOG("Error instance %u: zero_copy_input requires an input_release_callback \n", channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
     // alt-ref frames related
     if (config->altref_strength > ALTREF_MAX_STRENGTH ) {
         SVT_LOG("Error instance %u: invalid altref-strength, should be in the range [0 - %d] \n", channel_number + 1, ALTREF_MAX_STRENGTH);
@@ -2716,6 +3144,7 @@ EbErrorType eb_svt_enc_init_parameter(
     config_ptr->stat_report = 0;
     config_ptr->tile_rows = 0;
     config_ptr->tile_columns = 0;
+    config_ptr->tile_parallel = 0;
 
     config_ptr->qp = 50;
     config_ptr->use_qp_file = EB_FALSE;
@@ -2817,6 +3246,17 @@ EbErrorType eb_svt_enc_init_parameter(
     config_ptr->logical_processors = 0;
     config_ptr->unpin_lp1 = 1;
     config_ptr->target_socket = -1;
+    config_ptr->thread_pool = 0;
+    config_ptr->numa_mode = 0;
+    config_ptr->huge_pages = 0;
+    config_ptr->pipeline_stats = 0;
+    config_ptr->zero_copy_input = 0;
+    config_ptr->input_release_callback = NULL;
+    config_ptr->input_release_data = NULL;
+    config_ptr->pool_memory_budget = 0;
+    config_ptr->low_latency = 0;
+    config_ptr->latency_budget = 0;
+    config_ptr->inter_frame_wavefront = 0;
     config_ptr->channel_id = 0;
     config_ptr->active_channel_count = 1;
 
@@ -2884,6 +3324,8 @@ static void print_lib_params(
     else
         SVT_LOG("\nSVT [config]: BRC Mode / QP  / LookaheadDistance / SceneChange\t\t\t: CQP / %d / %d / %d ", scs->static_config.qp, config->look_ahead_distance, config->scene_change_detection);
 #ifdef DEBUG_BUFFERS
+    if (config->low_latency)
+        SVT_LOG("\nSVT [config]: LowLatency / LatencyBudget (ms) \t\t\t\t\t: %d / %d", config->low_latency, config->latency_budget);
     SVT_LOG("\nSVT [config]: INPUT / OUTPUT \t\t\t\t\t\t\t: %d / %d", scs->input_buffer_fifo_init_count, scs->output_stream_buffer_fifo_init_count);
     SVT_LOG("\nSVT [config]: CPCS / PAREF / REF \t\t\t\t\t\t: %d / %d / %d", scs->picture_control_set_pool_init_count_child, scs->pa_reference_picture_buffer_init_count, scs->reference_picture_buffer_init_count);
     SVT_LOG("\nSVT [config]: ME_SEG_W0 / ME_SEG_W1 / ME_SEG_W2 / ME_SEG_W3 \t\t\t: %d / %d / %d / %d ",
@@ -3244,6 +3686,86 @@ static void copy_input_buffer(
         copy_frame_buffer(sequenceControlSet, dst->p_buffer, src->p_buffer);
 }
 
+
+/**********************************
+* Zero-Copy Input
+*   The picture descriptor of the input wrapper points at the
+*   application planes from eb_svt_enc_send_picture() until the
+*   wrapper is released, then the planes are handed back.
+**********************************/
+static EbBool zero_copy_input_is_valid(
+    SequenceControlSet      *scs_ptr,
+    EbSvtIOFormat           *input_ptr)
+{
+    const uint32_t luma_offset = input_ptr->y_stride * scs_ptr->top_padding + scs_ptr->left_padding;
+    const uint32_t chroma_offset = input_ptr->cb_stride * (scs_ptr->top_padding >> 1) + (scs_ptr->left_padding >> 1);
+    const uint32_t y_stride = scs_ptr->max_input_luma_width + scs_ptr->left_padding + scs_ptr->right_padding;
+    const uint32_t chroma_stride = y_stride >> scs_ptr->subsampling_x;
+
+    if (input_ptr->y_stride != y_stride || input_ptr->cb_stride != chroma_stride ||
+        input_ptr->cr_stride != chroma_stride)
+        return EB_FALSE;
+    // The padded planes keep the alignment of the library allocations
+    if (((uintptr_t)(input_ptr->luma - luma_offset) & (ALVALUE - 1)) ||
+        ((uintptr_t)(input_ptr->cb - chroma_offset) & (ALVALUE - 1)) ||
+        ((uintptr_t)(input_ptr->cr - chroma_offset) & (ALVALUE - 1)))
+        return EB_FALSE;
+    return EB_TRUE;
+}
+
+static void attach_input_buffer(
+    SequenceControlSet     *scs_ptr,
+    EbBufferHeaderType     *dst,
+    EbBufferHeaderType     *src)
+{
+    EbPictureBufferDesc    *input_picture_ptr = (EbPictureBufferDesc*)dst->p_buffer;
+    EbSvtIOFormat          *input_ptr = (EbSvtIOFormat*)src->p_buffer;
+
+    dst->n_alloc_len = src->n_alloc_len;
+    dst->n_filled_len = src->n_filled_len;
+    dst->flags = src->flags;
+    dst->pts = src->pts;
+    dst->n_tick_count = src->n_tick_count;
+    dst->size = src->size;
+    dst->qp = src->qp;
+    dst->pic_type = src->pic_type;
+    // Handed back to the application with the planes
+    dst->p_app_private = src->p_app_private;
+
+    if (input_ptr == NULL)
+        return;
+    input_picture_ptr->buffer_y = input_ptr->luma -
+        (input_picture_ptr->stride_y * scs_ptr->top_padding + scs_ptr->left_padding);
+    input_picture_ptr->buffer_cb = input_ptr->cb -
+        (input_picture_ptr->stride_cb * (scs_ptr->top_padding >> 1) + (scs_ptr->left_padding >> 1));
+    input_picture_ptr->buffer_cr = input_ptr->cr -
+        (input_picture_ptr->stride_cr * (scs_ptr->top_padding >> 1) + (scs_ptr->left_padding >> 1));
+}
+
+static void release_zero_copy_input(
+    EbPtr                   hook_arg,
+    EbObjectWrapper        *wrapper_ptr)
+{
+    EbSvtAv1EncConfiguration *config = (EbSvtAv1EncConfiguration*)hook_arg;
+    EbBufferHeaderType       *input_buffer = (EbBufferHeaderType*)wrapper_ptr->object_ptr;
+    EbPictureBufferDesc      *input_picture_ptr = (EbPictureBufferDesc*)input_buffer->p_buffer;
+
+    // End of stream buffers carry no picture
+    if (input_picture_ptr->buffer_y == NULL)
+        return;
+    // Copy of the planes made to filter the picture, the application planes are already unused
+    if (input_picture_ptr->buffer_enable_mask) {
+        EB_FREE_PICTURE_ARRAY(input_picture_ptr->buffer_y);
+        EB_FREE_PICTURE_ARRAY(input_picture_ptr->buffer_cb);
+        EB_FREE_PICTURE_ARRAY(input_picture_ptr->buffer_cr);
+        input_picture_ptr->buffer_enable_mask = 0;
+    }
+    input_picture_ptr->buffer_y = NULL;
+    input_picture_ptr->buffer_cb = NULL;
+    input_picture_ptr->buffer_cr = NULL;
+    config->input_release_callback(config->input_release_data, input_buffer->p_app_private);
+}
+
 /**********************************
 * Empty This Buffer
 **********************************/
@@ -3255,18 +3777,38 @@ EB_API EbErrorType eb_svt_enc_send_picture(
     EbBufferHeaderType   *p_buffer)
 {
     EbEncHandle          *enc_handle_ptr = (EbEncHandle*)svt_enc_component->p_component_private;
+    SequenceControlSet   *scs_ptr = enc_handle_ptr->scs_instance_array[0]->scs_ptr;
     EbObjectWrapper      *eb_wrapper_ptr;
 
+    if (scs_ptr->static_config.zero_copy_input && p_buffer != NULL && p_buffer->p_buffer != NULL &&
+        !zero_copy_input_is_valid(scs_ptr, (EbSvtIOFormat*)p_buffer->p_buffer))
+        return EB_ErrorBadParameter;
+
+    // Low latency: the end of sequence is signalled by the API, see eb_svt_get_packet()
+    if (scs_ptr->static_config.low_latency && p_buffer != NULL &&
+        (p_buffer->flags & EB_BUFFERFLAG_EOS)) {
+        // Released after the counting of the last picture sent
+        eb_atomic_store32(&enc_handle_ptr->eos_received, EB_TRUE);
+        return EB_ErrorNone;
+    }
+
     // Take the buffer and put it into our internal queue structure
     eb_get_empty_object(
         enc_handle_ptr->input_buffer_producer_fifo_ptr,
         &eb_wrapper_ptr);
+    eb_atomic_fetch_add64(&enc_handle_ptr->pictures_sent, 1);
 
     if (p_buffer != NULL) {
-        copy_input_buffer(
-            enc_handle_ptr->scs_instance_array[0]->scs_ptr,
-            (EbBufferHeaderType*)eb_wrapper_ptr->object_ptr,
-            p_buffer);
+        if (scs_ptr->static_config.zero_copy_input)
+            attach_input_buffer(
+                scs_ptr,
+                (EbBufferHeaderType*)eb_wrapper_ptr->object_ptr,
+                p_buffer);
+        else
+            copy_input_buffer(
+                scs_ptr,
+                (EbBufferHeaderType*)eb_wrapper_ptr->object_ptr,
+                p_buffer);
     }
 
     eb_post_full_object(eb_wrapper_ptr);
@@ -3294,6 +3836,32 @@ static void copy_output_recon_buffer(
     return;
 }
 
+/**********************************
+* Low latency output: waits up to latency_budget ms for a full object,
+* blocking once the end of sequence was sent. latency_budget only
+* applies in low_latency mode, otherwise eb_svt_get_packet() does not
+* come here
+**********************************/
+static void get_low_latency_output(
+    EbEncHandle          *enc_handle,
+    EbFifo               *fifo_ptr,
+    EbObjectWrapper     **wrapper_dbl_ptr)
+{
+    const uint64_t latency_budget =
+        enc_handle->scs_instance_array[0]->scs_ptr->static_config.latency_budget;
+    const uint64_t deadline = eb_time_ns() + latency_budget * 1000000;
+
+    if (eb_atomic_load32(&enc_handle->eos_received)) {
+        eb_get_full_object(fifo_ptr, wrapper_dbl_ptr);
+        return;
+    }
+    eb_get_full_object_non_blocking(fifo_ptr, wrapper_dbl_ptr);
+    while (*wrapper_dbl_ptr == NULL && eb_time_ns() < deadline) {
+        eb_sleep_ms(1);
+        eb_get_full_object_non_blocking(fifo_ptr, wrapper_dbl_ptr);
+    }
+}
+
 /**********************************
 * eb_svt_get_packet sends out packet
 **********************************/
@@ -3309,7 +3877,27 @@ EB_API EbErrorType eb_svt_get_packet(
     EbEncHandle          *enc_handle = (EbEncHandle*)svt_enc_component->p_component_private;
     EbObjectWrapper      *eb_wrapper_ptr = NULL;
     EbBufferHeaderType    *packet;
-    if (pic_send_done)
+    if (enc_handle->scs_instance_array[0]->scs_ptr->static_config.low_latency) {
+        // All the pictures are out, return the end of sequence packet
+        if (eb_atomic_load32(&enc_handle->eos_received) &&
+            eb_atomic_load64(&enc_handle->packets_out) ==
+                eb_atomic_load64(&enc_handle->pictures_sent)) {
+            packet = &enc_handle->eos_packet;
+            EB_MEMSET(packet, 0, sizeof(EbBufferHeaderType));
+            packet->size = sizeof(EbBufferHeaderType);
+            packet->flags = EB_BUFFERFLAG_EOS;
+            *p_buffer = packet;
+            return return_error;
+        }
+        get_low_latency_output(
+            enc_handle,
+            enc_handle->output_stream_buffer_consumer_fifo_ptr,
+            &eb_wrapper_ptr);
+        if (eb_wrapper_ptr &&
+            !(((EbBufferHeaderType*)eb_wrapper_ptr->object_ptr)->flags & EB_BUFFERFLAG_IS_ALT_REF))
+            eb_atomic_fetch_add64(&enc_handle->packets_out, 1);
+    }
+    else if (pic_send_done)
         eb_get_full_object(
             enc_handle->output_stream_buffer_consumer_fifo_ptr,
             &eb_wrapper_ptr);
@@ -3339,16 +3927,30 @@ __attribute__((visibility("default")))
 EB_API void eb_svt_release_out_buffer(
     EbBufferHeaderType  **p_buffer)
 {
+    // Release out put buffer back into the pool, its bitstream buffer
+    // is recycled by the release hook, see eb_packet_pool_release()
     if (p_buffer && (*p_buffer)->wrapper_ptr)
-    {
-        if((*p_buffer)->p_buffer)
-           free((*p_buffer)->p_buffer);
-        // Release out put buffer back into the pool
         eb_release_object((EbObjectWrapper  *)(*p_buffer)->wrapper_ptr);
-     }
     return;
 }
 
+#ifdef __GNUC__
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType eb_svt_enc_register_out_buffer(
+    EbComponentType      *svt_enc_component,
+    uint8_t              *buffer,
+    uint32_t              size)
+{
+    if (svt_enc_component == NULL || buffer == NULL || size == 0)
+        return EB_ErrorBadParameter;
+
+    EbEncHandle *enc_handle = (EbEncHandle*)svt_enc_component->p_component_private;
+    if (enc_handle->packet_pool_ptr_array == NULL)
+        return EB_ErrorBadParameter;
+    return eb_packet_pool_register(enc_handle->packet_pool_ptr_array[0], buffer, size);
+}
+
 /**********************************
 * Fill This Buffer
 **********************************/
@@ -3364,6 +3966,16 @@ EB_API EbErrorType eb_svt_get_recon(
     EbObjectWrapper      *eb_wrapper_ptr = NULL;
 
     if (enc_handle->scs_instance_array[0]->scs_ptr->static_config.recon_enabled) {
+        // Low latency: all the pictures are out, return an empty end of sequence buffer
+        if (enc_handle->scs_instance_array[0]->scs_ptr->static_config.low_latency &&
+            eb_atomic_load32(&enc_handle->eos_received) &&
+            eb_atomic_load64(&enc_handle->recons_out) ==
+                eb_atomic_load64(&enc_handle->pictures_sent)) {
+            p_buffer->n_filled_len = 0;
+            p_buffer->pts = 0;
+            p_buffer->flags = EB_BUFFERFLAG_EOS;
+            return return_error;
+        }
         eb_get_full_object_non_blocking(
             enc_handle->output_recon_buffer_consumer_fifo_ptr,
             &eb_wrapper_ptr);
@@ -3373,6 +3985,7 @@ EB_API EbErrorType eb_svt_get_recon(
             copy_output_recon_buffer(
                 p_buffer,
                 obj_ptr);
+            eb_atomic_fetch_add64(&enc_handle->recons_out, 1);
 
             if (p_buffer->flags != EB_BUFFERFLAG_EOS && p_buffer->flags != 0)
                 return_error = EB_ErrorMax;
@@ -3389,6 +4002,84 @@ EB_API EbErrorType eb_svt_get_recon(
     return return_error;
 }
 
+/**********************************
+* eb_svt_enc_get_stats
+**********************************/
+#ifdef __GNUC__
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType eb_svt_enc_get_stats(
+    EbComponentType      *svt_enc_component,
+    EbSvtEncStats        *stats)
+{
+    EbEncHandle          *enc_handle;
+
+    if (svt_enc_component == NULL || stats == NULL)
+        return EB_ErrorBadParameter;
+    enc_handle = (EbEncHandle*)svt_enc_component->p_component_private;
+    if (enc_handle->pipeline_stats_ptr == NULL)
+        return EB_ErrorBadParameter;
+
+    eb_pipeline_stats_get(enc_handle->pipeline_stats_ptr, stats);
+    return EB_ErrorNone;
+}
+
+/**********************************
+* eb_svt_enc_dump_trace
+**********************************/
+#ifdef __GNUC__
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType eb_svt_enc_dump_trace(
+    EbComponentType      *svt_enc_component,
+    const char           *file_name)
+{
+    EbErrorType           return_error;
+    EbEncHandle          *enc_handle;
+    FILE                 *fp;
+
+    if (svt_enc_component == NULL || file_name == NULL)
+        return EB_ErrorBadParameter;
+    enc_handle = (EbEncHandle*)svt_enc_component->p_component_private;
+    if (enc_handle->pipeline_stats_ptr == NULL || enc_handle->pipeline_stats_ptr->event_array == NULL)
+        return EB_ErrorBadParameter;
+
+    FOPEN(fp, file_name, "w");
+    if (fp == NULL)
+        return EB_ErrorBadParameter;
+    return_error = eb_pipeline_stats_dump_trace(enc_handle->pipeline_stats_ptr, fp);
+    fclose(fp);
+    return return_error;
+}
+
+/**********************************
+* eb_svt_enc_get_input_layout
+**********************************/
+#ifdef __GNUC__
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType eb_svt_enc_get_input_layout(
+    EbComponentType      *svt_enc_component,
+    EbSvtInputLayout     *layout)
+{
+    SequenceControlSet   *scs_ptr;
+
+    if (svt_enc_component == NULL || layout == NULL)
+        return EB_ErrorBadParameter;
+    scs_ptr = ((EbEncHandle*)svt_enc_component->p_component_private)->scs_instance_array[0]->scs_ptr;
+
+    // The picture is padded up to a multiple of MIN_BLOCK_SIZE first
+    layout->left_padding = scs_ptr->left_padding;
+    layout->right_padding = scs_ptr->max_input_pad_right + scs_ptr->right_padding;
+    layout->top_padding = scs_ptr->top_padding;
+    layout->bottom_padding = scs_ptr->max_input_pad_bottom + scs_ptr->bot_padding;
+    layout->y_stride = scs_ptr->max_input_luma_width + scs_ptr->left_padding + scs_ptr->right_padding;
+    layout->cb_stride = layout->y_stride >> scs_ptr->subsampling_x;
+    layout->cr_stride = layout->cb_stride;
+    layout->alignment = ALVALUE;
+    return EB_ErrorNone;
+}
+
 /**********************************
 * Encoder Error Handling
 **********************************/
@@ -3449,7 +4140,8 @@ EbErrorType init_svt_av1_encoder_handle(
 }
 static EbErrorType allocate_frame_buffer(
     SequenceControlSet       *scs_ptr,
-    EbBufferHeaderType        *input_buffer)
+    EbBufferHeaderType        *input_buffer,
+    EbBool                     allocate_planes)
 {
     EbErrorType   return_error = EB_ErrorNone;
     EbPictureBufferDescInitData input_pic_buf_desc_init_data;
@@ -3473,7 +4165,8 @@ static EbErrorType allocate_frame_buffer(
 
     input_pic_buf_desc_init_data.split_mode = is_16bit ? EB_TRUE : EB_FALSE;
 
-    input_pic_buf_desc_init_data.buffer_enable_mask = PICTURE_BUFFER_DESC_FULL_MASK;
+    // Zero-copy input pictures get their planes from the application
+    input_pic_buf_desc_init_data.buffer_enable_mask = allocate_planes ? PICTURE_BUFFER_DESC_FULL_MASK : 0;
 
     if (is_16bit && config->compressed_ten_bit_format == 1)
         //do special allocation for 2bit data down below.
@@ -3503,15 +4196,12 @@ static EbErrorType allocate_frame_buffer(
 
     return return_error;
 }
-/**************************************
-* EbBufferHeaderType Constructor
-**************************************/
-EbErrorType eb_input_buffer_header_creator(
-    EbPtr *object_dbl_ptr,
-    EbPtr  object_init_data_ptr)
+static EbErrorType create_input_buffer_header(
+    EbPtr                    *object_dbl_ptr,
+    SequenceControlSet       *scs_ptr,
+    EbBool                    allocate_planes)
 {
     EbBufferHeaderType* input_buffer;
-    SequenceControlSet        *scs_ptr = (SequenceControlSet*)object_init_data_ptr;
 
     *object_dbl_ptr = NULL;
     EB_CALLOC(input_buffer, 1, sizeof(EbBufferHeaderType));
@@ -3521,20 +4211,47 @@ EbErrorType eb_input_buffer_header_creator(
 
     allocate_frame_buffer(
         scs_ptr,
-        input_buffer);
+        input_buffer,
+        allocate_planes);
 
     input_buffer->p_app_private = NULL;
 
     return EB_ErrorNone;
 }
 
+/**************************************
+* EbBufferHeaderType Constructor
+**************************************/
+EbErrorType eb_input_buffer_header_creator(
+    EbPtr *object_dbl_ptr,
+    EbPtr  object_init_data_ptr)
+{
+    return create_input_buffer_header(
+        object_dbl_ptr,
+        (SequenceControlSet*)object_init_data_ptr,
+        EB_TRUE);
+}
+
+/**************************************
+* EbBufferHeaderType Constructor, zero-copy input
+**************************************/
+EbErrorType eb_zero_copy_input_buffer_header_creator(
+    EbPtr *object_dbl_ptr,
+    EbPtr  object_init_data_ptr)
+{
+    return create_input_buffer_header(
+        object_dbl_ptr,
+        (SequenceControlSet*)object_init_data_ptr,
+        EB_FALSE);
+}
+
 void eb_input_buffer_header_destroyer(    EbPtr p)
 {
     EbBufferHeaderType *obj = (EbBufferHeaderType*)p;
     EbPictureBufferDesc* buf = (EbPictureBufferDesc*)obj->p_buffer;
-    EB_FREE_ALIGNED_ARRAY(buf->buffer_bit_inc_y);
-    EB_FREE_ALIGNED_ARRAY(buf->buffer_bit_inc_cb);
-    EB_FREE_ALIGNED_ARRAY(buf->buffer_bit_inc_cr);
+    EB_FREE_PICTURE_ARRAY(buf->buffer_bit_inc_y);
+    EB_FREE_PICTURE_ARRAY(buf->buffer_bit_inc_cb);
+    EB_FREE_PICTURE_ARRAY(buf->buffer_bit_inc_cr);
 
     EB_DELETE(buf);
     EB_FREE(obj);
@@ -3547,18 +4264,17 @@ EbErrorType eb_output_buffer_header_creator(
     EbPtr *object_dbl_ptr,
     EbPtr object_init_data_ptr)
 {
-    EbSvtAv1EncConfiguration   * config = (EbSvtAv1EncConfiguration*)object_init_data_ptr;
-    uint32_t n_stride =
-        (uint32_t)(EB_OUTPUTSTREAMBUFFERSIZE_MACRO(config->source_width * config->source_height));
+    EbOutputPacket* out_packet_ptr;
     EbBufferHeaderType* out_buf_ptr;
 
     *object_dbl_ptr = NULL;
-    EB_CALLOC(out_buf_ptr, 1, sizeof(EbBufferHeaderType));
-    *object_dbl_ptr = (EbPtr)out_buf_ptr;
+    EB_CALLOC(out_packet_ptr, 1, sizeof(EbOutputPacket));
+    *object_dbl_ptr = (EbPtr)out_packet_ptr;
 
-    // Initialize Header
+    // Initialize Header, the bitstream buffer comes from the packet pool
+    out_buf_ptr = &out_packet_ptr->header;
     out_buf_ptr->size = sizeof(EbBufferHeaderType);
-    out_buf_ptr->n_alloc_len = n_stride;
+    out_buf_ptr->n_alloc_len = 0;
     out_buf_ptr->p_app_private = NULL;
 
     (void)object_init_data_ptr;
@@ -3568,7 +4284,10 @@ EbErrorType eb_output_buffer_header_creator(
 
 void eb_output_buffer_header_destroyer(    EbPtr p)
 {
-    EbBufferHeaderType* obj = (EbBufferHeaderType*)p;
+    EbOutputPacket* obj = (EbOutputPacket*)p;
+    // A packet never released still holds its buffer
+    if (!obj->app_buffer)
+        free(obj->header.p_buffer);
     EB_FREE(obj);
 }
 
@@ -10,6 +10,9 @@
 #include "EbSvtAv1Enc.h"
 #include "EbPictureBufferDesc.h"
 #include "EbSystemResourceManager.h"
+#include "EbThreadPool.h"
+#include "EbPipelineStats.h"
+#include "EbPacketPool.h"
 #include "EbSequenceControlSet.h"
 #include "EbObject.h"
 
@@ -52,6 +55,10 @@ struct _EbEncHandle {
     // Overlay input picture
     EbSystemResource **overlay_input_picture_pool_ptr_array;
 
+    // Budget of the picture pools above but the overlay one, which then grow
+    //   on demand. NULL when static_config.pool_memory_budget is 0
+    EbMemoryBudget *pool_memory_budget_ptr;
+
     // Thread Handles
     EbHandle  resource_coordination_thread_handle;
     EbHandle *picture_analysis_thread_handle_array;
@@ -70,6 +77,13 @@ struct _EbEncHandle {
 
     EbHandle packetization_thread_handle;
 
+    // Thread Pool, runs the multi-threaded stages instead of their
+    //   thread arrays when static_config.thread_pool is set
+    EbThreadPool *thread_pool_ptr;
+
+    // Pipeline Statistics, NULL when static_config.pipeline_stats is off
+    EbPipelineStats *pipeline_stats_ptr;
+
     // Contexts
     EbThreadContext * resource_coordination_context_ptr;
     EbThreadContext **picture_analysis_context_ptr_array;
@@ -90,6 +104,7 @@ struct _EbEncHandle {
     // System Resource Managers
     EbSystemResource * input_buffer_resource_ptr;
     EbSystemResource **output_stream_buffer_resource_ptr_array;
+    EbPacketPool **    packet_pool_ptr_array;
     EbSystemResource **output_recon_buffer_resource_ptr_array;
     EbSystemResource **output_statistics_buffer_resource_ptr_array;
     EbSystemResource * resource_coordination_results_resource_ptr;
@@ -113,6 +128,18 @@ struct _EbEncHandle {
     EbFifo *input_buffer_producer_fifo_ptr;
     EbFifo *output_stream_buffer_consumer_fifo_ptr;
     EbFifo *output_recon_buffer_consumer_fifo_ptr;
+
+    // Low latency end of sequence, see static_config.low_latency. The end of
+    //   sequence buffer is not sent down the pipeline: the API returns
+    //   eos_packet once as many packets as pictures sent are out. The
+    //   counters are shared by the send and get threads of the
+    //   application, they are only accessed through the eb_atomic_*
+    //   functions
+    volatile int32_t   eos_received;
+    volatile int64_t   pictures_sent;
+    volatile int64_t   packets_out;
+    volatile int64_t   recons_out;
+    EbBufferHeaderType eos_packet;
 };
 
 #endif // EbEncHandle_h
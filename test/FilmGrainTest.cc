@@ -31,6 +31,7 @@
 #include "acm_random.h"
 #include "noise_model.h"
 #include "aom_dsp_rtcd.h"
+#include "common_dsp_rtcd.h"
 
 static AomFilmGrain film_grain_test_vectors[3] = {
     /* Test 1 */
@@ -271,6 +272,144 @@ TEST_F(AddFilmGrainTest, MatchTest) {
     }
 }
 
+// Stripes run in reverse order and spread over several slots, so that each
+// one rebuilds the overlap rows of the stripe above. The context is reused
+// across the vectors.
+TEST_F(AddFilmGrainTest, StripeOrderTest) {
+    const uint32_t num_slots = 3;
+    FilmGrainCtxt *ctxt = eb_av1_film_grain_ctxt_alloc(num_slots);
+    ASSERT_NE(ctxt, nullptr);
+    for (int i = 0; i < 3; ++i) {
+        init_data();
+        ASSERT_EQ(eb_av1_film_grain_prepare(ctxt,
+                                            film_grain_test_vectors + i,
+                                            kWidth,
+                                            kHeight,
+                                            kWidth,     /* luma stride */
+                                            kWidth / 2, /* chroma stride */
+                                            0,
+                                            1,
+                                            1),
+                  EB_ErrorNone);
+        const int num_stripes = eb_av1_film_grain_stripe_count(ctxt);
+        for (int stripe = num_stripes - 1; stripe >= 0; --stripe)
+            eb_av1_add_film_grain_stripe(
+                ctxt, stripe % num_slots, stripe, luma_, cb_, cr_);
+        check_output(i);
+        EXPECT_FALSE(HasFailure());
+    }
+    eb_av1_film_grain_ctxt_free(ctxt);
+}
+
+// Blends random samples with the AVX2 kernels and compares with C
+class FilmGrainBlendTest : public ::testing::Test {
+  public:
+    static const int kMaxWidth = 64;
+    static const int kHeight = 8;
+    static const int kStride = 2 * kMaxWidth + 8;
+
+    FilmGrainBlendTest() : rnd_(0) {
+    }
+
+  protected:
+    void init_params(int bit_depth, int subsamp_x, int subsamp_y) {
+        for (int i = 0; i < 256; ++i)
+            lut_[i] = rnd_.Rand8();
+        params_.scaling_lut = lut_;
+        params_.scaling_shift = 8 + rnd_.PseudoUniform(4);
+        params_.bit_depth = bit_depth;
+        params_.min_value = rnd_.PseudoUniform(2) ? 16 << (bit_depth - 8) : 0;
+        params_.max_value = rnd_.PseudoUniform(2) ? 235 << (bit_depth - 8)
+                                                  : (256 << (bit_depth - 8)) - 1;
+        params_.luma_mult = rnd_.PseudoUniform(256) - 128;
+        params_.mult = rnd_.PseudoUniform(256) - 128;
+        params_.offset =
+            (rnd_.PseudoUniform(512) << (bit_depth - 8)) - (1 << bit_depth);
+        params_.subsamp_x = subsamp_x;
+        params_.subsamp_y = subsamp_y;
+        const int grain_max = (128 << (bit_depth - 8)) - 1;
+        for (int i = 0; i < kHeight * kStride; ++i) {
+            grain_[i] = rnd_.PseudoUniform(2 * grain_max + 2) - grain_max - 1;
+            dst_ref_[i] = dst_tst_[i] = rnd_.Rand16() & ((1 << bit_depth) - 1);
+            dst8_ref_[i] = dst8_tst_[i] = (uint8_t)dst_ref_[i];
+        }
+        for (int i = 0; i < (kHeight << 1) * kStride; ++i) {
+            luma_[i] = rnd_.Rand16() & ((1 << bit_depth) - 1);
+            luma8_[i] = (uint8_t)luma_[i];
+        }
+    }
+
+    void run_luma_test(int bit_depth) {
+        for (int width = 1; width <= kMaxWidth; ++width) {
+            init_params(bit_depth, 0, 0);
+            if (bit_depth == 8) {
+                eb_fgn_blend_luma_c(
+                    dst8_ref_, kStride, grain_, kStride, width, kHeight, &params_);
+                eb_fgn_blend_luma_avx2(
+                    dst8_tst_, kStride, grain_, kStride, width, kHeight, &params_);
+                ASSERT_EQ(0, memcmp(dst8_ref_, dst8_tst_, sizeof(dst8_ref_)))
+                    << "width " << width;
+            } else {
+                eb_fgn_blend_luma_hbd_c(
+                    dst_ref_, kStride, grain_, kStride, width, kHeight, &params_);
+                eb_fgn_blend_luma_hbd_avx2(
+                    dst_tst_, kStride, grain_, kStride, width, kHeight, &params_);
+                ASSERT_EQ(0, memcmp(dst_ref_, dst_tst_, sizeof(dst_ref_)))
+                    << "width " << width << " bit depth " << bit_depth;
+            }
+        }
+    }
+
+    void run_chroma_test(int bit_depth) {
+        for (int sub = 0; sub < 3; ++sub) {
+            const int subsamp_x = sub > 0, subsamp_y = sub > 1;
+            for (int width = 1; width <= kMaxWidth; ++width) {
+                init_params(bit_depth, subsamp_x, subsamp_y);
+                if (bit_depth == 8) {
+                    eb_fgn_blend_chroma_c(dst8_ref_, kStride, luma8_, kStride,
+                                          grain_, kStride, width, kHeight, &params_);
+                    eb_fgn_blend_chroma_avx2(dst8_tst_, kStride, luma8_, kStride,
+                                             grain_, kStride, width, kHeight, &params_);
+                    ASSERT_EQ(0,
+                              memcmp(dst8_ref_, dst8_tst_, sizeof(dst8_ref_)))
+                        << "width " << width << " subsampling " << sub;
+                } else {
+                    eb_fgn_blend_chroma_hbd_c(dst_ref_, kStride, luma_, kStride,
+                                              grain_, kStride, width, kHeight, &params_);
+                    eb_fgn_blend_chroma_hbd_avx2(dst_tst_, kStride, luma_, kStride,
+                                                 grain_, kStride, width, kHeight, &params_);
+                    ASSERT_EQ(0, memcmp(dst_ref_, dst_tst_, sizeof(dst_ref_)))
+                        << "width " << width << " subsampling " << sub
+                        << " bit depth " << bit_depth;
+                }
+            }
+        }
+    }
+
+    libaom_test::ACMRandom rnd_;
+    FgnBlendParams params_;
+    int32_t lut_[256];
+    int32_t grain_[kHeight * kStride];
+    uint16_t luma_[(kHeight << 1) * kStride];
+    uint8_t luma8_[(kHeight << 1) * kStride];
+    uint16_t dst_ref_[kHeight * kStride];
+    uint16_t dst_tst_[kHeight * kStride];
+    uint8_t dst8_ref_[kHeight * kStride];
+    uint8_t dst8_tst_[kHeight * kStride];
+};
+
+TEST_F(FilmGrainBlendTest, LumaMatchTest) {
+    run_luma_test(8);
+    run_luma_test(10);
+    run_luma_test(12);
+}
+
+TEST_F(FilmGrainBlendTest, ChromaMatchTest) {
+    run_chroma_test(8);
+    run_chroma_test(10);
+    run_chroma_test(12);
+}
+
 extern "C" {
 #include "EbPictureControlSet.h"
 #include "EbPictureBufferDesc.h"
@@ -0,0 +1,139 @@
+/*
+ * Copyright(c) 2019 Intel Corporation
+ * SPDX - License - Identifier: BSD - 2 - Clause - Patent
+ */
+
+/******************************************************************************
+ * @file PacketPoolTest.cc
+ *
+ * @brief Unit test of the bitstream buffers of the output packets:
+ * - eb_packet_pool_get
+ * - eb_packet_pool_register
+ * - eb_packet_pool_release
+ *
+ ******************************************************************************/
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+#include "gtest/gtest.h"
+// workaround to eliminate the compiling warning on linux
+// The macro will conflict with definition in gtest.h
+#ifdef __USE_GNU
+#undef __USE_GNU  // defined in EbThreads.h
+#endif
+#ifdef _GNU_SOURCE
+#undef _GNU_SOURCE  // defined in EbThreads.h
+#endif
+#include "EbPacketPool.h"
+#include "EbMalloc.h"
+
+namespace {
+
+const uint32_t pool_buffer_size = 1024;
+const uint32_t pool_max_count = 4;
+
+class PacketPoolTest : public ::testing::Test {
+  public:
+    PacketPoolTest() : pool_(NULL) {
+    }
+
+    void SetUp() override {
+        EB_NO_THROW_NEW(
+            pool_, eb_packet_pool_ctor, pool_buffer_size, pool_max_count);
+        ASSERT_NE(pool_, nullptr);
+    }
+
+    void TearDown() override {
+        EB_DELETE(pool_);
+    }
+
+  protected:
+    void get(EbOutputPacket *packet) {
+        memset(packet, 0, sizeof(*packet));
+        ASSERT_EQ(eb_packet_pool_get(pool_, packet), EB_ErrorNone);
+        ASSERT_NE(packet->header.p_buffer, nullptr);
+    }
+
+    // release the packet as the output stream resource does, through the
+    // release hook of its wrapper
+    void release(EbOutputPacket *packet) {
+        EbObjectWrapper wrapper;
+        memset(&wrapper, 0, sizeof(wrapper));
+        wrapper.object_ptr = packet;
+        eb_packet_pool_release(pool_, &wrapper);
+        EXPECT_EQ(packet->header.p_buffer, nullptr);
+    }
+
+    EbPacketPool *pool_;
+};
+
+TEST_F(PacketPoolTest, RegisteredBufferIsWrittenAndKept) {
+    std::vector<uint8_t> buffers[2] = {std::vector<uint8_t>(100, 0),
+                                       std::vector<uint8_t>(200, 0)};
+    for (auto &buffer : buffers)
+        ASSERT_EQ(eb_packet_pool_register(
+                      pool_, buffer.data(), (uint32_t)buffer.size()),
+                  EB_ErrorNone);
+
+    // the registered buffers come first, in the order they were registered
+    EbOutputPacket packets[2];
+    for (int i = 0; i < 2; i++) {
+        get(&packets[i]);
+        EXPECT_EQ(packets[i].header.p_buffer, buffers[i].data());
+        EXPECT_EQ(packets[i].header.n_alloc_len, buffers[i].size());
+        EXPECT_TRUE(packets[i].app_buffer);
+        memset(packets[i].header.p_buffer, 0x10 + i, 16);
+    }
+
+    // the application keeps its buffers: they are neither freed nor
+    // recycled, and still hold the packet
+    for (int i = 0; i < 2; i++) release(&packets[i]);
+    EXPECT_EQ(pool_->free_count, 0u);
+    for (int i = 0; i < 2; i++) {
+        for (int j = 0; j < 16; j++) EXPECT_EQ(buffers[i][j], 0x10 + i);
+    }
+
+    // then the pool buffers
+    EbOutputPacket packet;
+    get(&packet);
+    EXPECT_FALSE(packet.app_buffer);
+    EXPECT_EQ(packet.header.n_alloc_len, pool_buffer_size);
+    for (auto &buffer : buffers)
+        EXPECT_NE(packet.header.p_buffer, buffer.data());
+    release(&packet);
+}
+
+TEST_F(PacketPoolTest, PoolBufferIsRecycled) {
+    EbOutputPacket packet;
+    get(&packet);
+    uint8_t *buffer = packet.header.p_buffer;
+    EXPECT_FALSE(packet.app_buffer);
+    release(&packet);
+    EXPECT_EQ(pool_->free_count, 1u);
+
+    get(&packet);
+    EXPECT_EQ(packet.header.p_buffer, buffer);
+    EXPECT_EQ(pool_->free_count, 0u);
+    release(&packet);
+}
+
+TEST_F(PacketPoolTest, RegisterLimit) {
+    std::vector<uint8_t> buffer(100, 0);
+    for (uint32_t i = 0; i < pool_max_count; i++)
+        EXPECT_EQ(eb_packet_pool_register(
+                      pool_, buffer.data(), (uint32_t)buffer.size()),
+                  EB_ErrorNone);
+    EXPECT_EQ(
+        eb_packet_pool_register(pool_, buffer.data(), (uint32_t)buffer.size()),
+        EB_ErrorInsufficientResources);
+
+    // a used buffer makes room for another one
+    EbOutputPacket packet;
+    get(&packet);
+    EXPECT_EQ(
+        eb_packet_pool_register(pool_, buffer.data(), (uint32_t)buffer.size()),
+        EB_ErrorNone);
+    release(&packet);
+}
+
+}  // namespace
@@ -0,0 +1,177 @@
+/*
+ * Copyright(c) 2019 Intel Corporation
+ * SPDX - License - Identifier: BSD - 2 - Clause - Patent
+ */
+
+/******************************************************************************
+ * @file PipelineStatsTest.cc
+ *
+ * @brief Unit test of the pipeline statistics, with a producer and a stage
+ * thread on a queue with stage stats attached:
+ * - eb_pipeline_stats_add_stage
+ * - eb_pipeline_stats_set_picture
+ * - eb_pipeline_stats_get
+ * - eb_pipeline_stats_dump_trace
+ *
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdlib.h>
+#include <string>
+#include <thread>
+#include "gtest/gtest.h"
+// workaround to eliminate the compiling warning on linux
+// The macro will conflict with definition in gtest.h
+#ifdef __USE_GNU
+#undef __USE_GNU  // defined in EbThreads.h
+#endif
+#ifdef _GNU_SOURCE
+#undef _GNU_SOURCE  // defined in EbThreads.h
+#endif
+#include "EbPipelineStats.h"
+
+namespace {
+
+#ifdef EB_LOCKFREE_QUEUE
+const EbBool lockfree_default = EB_TRUE;
+#else
+const EbBool lockfree_default = EB_FALSE;
+#endif
+
+const uint32_t end_of_stream = ~0u;
+const uint32_t object_count = 8;
+
+typedef struct TestObject {
+    uint32_t payload;
+} TestObject;
+
+static EbErrorType test_object_creator(EbPtr *object_dbl_ptr,
+                                       EbPtr object_init_data_ptr) {
+    (void)object_init_data_ptr;
+    *object_dbl_ptr = calloc(1, sizeof(TestObject));
+    return *object_dbl_ptr ? EB_ErrorNone : EB_ErrorInsufficientResources;
+}
+
+static void test_object_destroyer(EbPtr p) {
+    free(p);
+}
+
+// <lock-free, stats level>
+typedef std::tuple<bool, uint32_t> PipelineStatsParam;
+
+class PipelineStatsTest : public ::testing::TestWithParam<PipelineStatsParam> {
+  public:
+    PipelineStatsTest()
+        : lockfree_(std::get<0>(GetParam())),
+          level_(std::get<1>(GetParam())),
+          resource_(NULL),
+          stats_(NULL) {
+    }
+
+    void SetUp() override {
+        eb_system_resource_set_lockfree(lockfree_ ? EB_TRUE : EB_FALSE);
+        EB_NO_THROW_NEW(resource_,
+                        eb_system_resource_ctor,
+                        object_count,
+                        1,
+                        1,
+                        test_object_creator,
+                        NULL,
+                        test_object_destroyer);
+        ASSERT_NE(resource_, nullptr);
+        EB_NO_THROW_NEW(stats_, eb_pipeline_stats_ctor, level_);
+        ASSERT_NE(stats_, nullptr);
+        ASSERT_NE(eb_pipeline_stats_add_stage(stats_, resource_, "Stage", 1),
+                  nullptr);
+    }
+
+    void TearDown() override {
+        EB_DELETE(resource_);
+        EB_DELETE(stats_);
+        eb_system_resource_set_lockfree(lockfree_default);
+    }
+
+  protected:
+    void post(uint32_t payload) {
+        EbObjectWrapper *wrapper_ptr;
+        eb_get_empty_object(eb_system_resource_get_producer_fifo(resource_, 0),
+                            &wrapper_ptr);
+        ((TestObject *)wrapper_ptr->object_ptr)->payload = payload;
+        eb_post_full_object(wrapper_ptr);
+    }
+
+    void run_count_test() {
+        const uint32_t num_posts = 100;
+        EbSvtEncStats stats;
+
+        // Fill the queue before the stage starts
+        for (uint32_t i = 0; i < object_count; i++)
+            post(i);
+        std::thread stage([this]() {
+            EbFifo *fifo = eb_system_resource_get_consumer_fifo(resource_, 0);
+            while (1) {
+                EbObjectWrapper *wrapper_ptr;
+                eb_get_full_object(fifo, &wrapper_ptr);
+                uint32_t payload =
+                    ((TestObject *)wrapper_ptr->object_ptr)->payload;
+                eb_pipeline_stats_set_picture(payload);
+                eb_release_object(wrapper_ptr);
+                if (payload == end_of_stream)
+                    break;
+            }
+            // Ends the last task
+            eb_stage_stats_task_end();
+        });
+        for (uint32_t i = object_count; i < num_posts; i++)
+            post(i);
+        post(end_of_stream);
+        stage.join();
+
+        eb_pipeline_stats_get(stats_, &stats);
+        ASSERT_EQ(stats.stage_count, 1u);
+        ASSERT_STREQ(stats.stage[0].name, "Stage");
+        ASSERT_EQ(stats.stage[0].thread_count, 1u);
+        ASSERT_EQ(stats.stage[0].task_count, num_posts + 1);
+        ASSERT_EQ(stats.stage[0].max_queue_depth, object_count);
+        ASSERT_LE(stats.stage[0].busy_ns + stats.stage[0].idle_ns,
+                  stats.elapsed_ns);
+        ASSERT_EQ(stats.stage[0].blocked_ns, 0u);
+
+        if (level_ < EB_PIPELINE_STATS_TRACE) {
+            ASSERT_EQ(stats.trace_event_count, 0u);
+            return;
+        }
+        ASSERT_EQ(stats.trace_event_count, num_posts + 1);
+        ASSERT_EQ(stats.trace_dropped_count, 0u);
+
+        FILE *fp = tmpfile();
+        ASSERT_NE(fp, nullptr);
+        ASSERT_EQ(eb_pipeline_stats_dump_trace(stats_, fp), EB_ErrorNone);
+        std::string trace;
+        char buf[4096];
+        rewind(fp);
+        size_t size;
+        while ((size = fread(buf, 1, sizeof(buf), fp)) > 0)
+            trace.append(buf, size);
+        fclose(fp);
+        ASSERT_EQ(trace.find("{\"displayTimeUnit\""), 0u);
+        ASSERT_NE(trace.find("\"picture\":99}"), std::string::npos);
+        ASSERT_EQ(trace.substr(trace.size() - 3), "]}\n");
+    }
+
+    bool lockfree_;
+    uint32_t level_;
+    EbSystemResource *resource_;
+    EbPipelineStats *stats_;
+};
+
+TEST_P(PipelineStatsTest, CountTest) {
+    run_count_test();
+}
+
+INSTANTIATE_TEST_CASE_P(
+    PipelineStats, PipelineStatsTest,
+    ::testing::Combine(::testing::Bool(),
+                       ::testing::Values((uint32_t)EB_PIPELINE_STATS_COUNTERS,
+                                         (uint32_t)EB_PIPELINE_STATS_TRACE)));
+
+}  // namespace
@@ -0,0 +1,362 @@
+/*
+ * Copyright(c) 2019 Intel Corporation
+ * SPDX - License - Identifier: BSD - 2 - Clause - Patent
+ */
+
+/******************************************************************************
+ * @file SystemResourceTest.cc
+ *
+ * @brief Unit test of the pipeline object queues, for both the mutex and
+ * semaphore based fifos and the lock-free rings:
+ * - eb_get_empty_object
+ * - eb_post_full_object
+ * - eb_get_full_object
+ * - eb_get_full_object_non_blocking
+ * - eb_release_object
+ * and the growth and shrinking of the pools made by
+ * eb_system_resource_growable_ctor within a memory budget.
+ *
+ * The DISABLED_Speed test is the microbenchmark comparing the two, run it
+ * with --gtest_also_run_disabled_tests.
+ *
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdlib.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+// workaround to eliminate the compiling warning on linux
+// The macro will conflict with definition in gtest.h
+#ifdef __USE_GNU
+#undef __USE_GNU  // defined in EbThreads.h
+#endif
+#ifdef _GNU_SOURCE
+#undef _GNU_SOURCE  // defined in EbThreads.h
+#endif
+#include "EbSystemResourceManager.h"
+#include "EbMalloc.h"
+
+namespace {
+
+#ifdef EB_LOCKFREE_QUEUE
+const EbBool lockfree_default = EB_TRUE;
+#else
+const EbBool lockfree_default = EB_FALSE;
+#endif
+
+const uint32_t end_of_stream = ~0u;
+
+typedef struct TestObject {
+    uint32_t payload;
+} TestObject;
+
+static EbErrorType test_object_creator(EbPtr *object_dbl_ptr,
+                                       EbPtr object_init_data_ptr) {
+    (void)object_init_data_ptr;
+    *object_dbl_ptr = calloc(1, sizeof(TestObject));
+    return *object_dbl_ptr ? EB_ErrorNone : EB_ErrorInsufficientResources;
+}
+
+static void test_object_destroyer(EbPtr p) {
+    free(p);
+}
+
+// <lock-free, producers, consumers, objects>
+typedef std::tuple<bool, uint32_t, uint32_t, uint32_t> SystemResourceParam;
+
+class SystemResourceTest
+    : public ::testing::TestWithParam<SystemResourceParam> {
+  public:
+    SystemResourceTest()
+        : lockfree_(std::get<0>(GetParam())),
+          producer_count_(std::get<1>(GetParam())),
+          consumer_count_(std::get<2>(GetParam())),
+          object_count_(std::get<3>(GetParam())),
+          resource_(NULL) {
+    }
+
+    void SetUp() override {
+        eb_system_resource_set_lockfree(lockfree_ ? EB_TRUE : EB_FALSE);
+        EB_NO_THROW_NEW(resource_,
+                        eb_system_resource_ctor,
+                        object_count_,
+                        producer_count_,
+                        consumer_count_,
+                        test_object_creator,
+                        NULL,
+                        test_object_destroyer);
+        ASSERT_NE(resource_, nullptr);
+    }
+
+    void TearDown() override {
+        EB_DELETE(resource_);
+        eb_system_resource_set_lockfree(lockfree_default);
+    }
+
+  protected:
+    void post(uint32_t producer, uint32_t payload) {
+        EbObjectWrapper *wrapper_ptr;
+        eb_get_empty_object(
+            eb_system_resource_get_producer_fifo(resource_, producer),
+            &wrapper_ptr);
+        ((TestObject *)wrapper_ptr->object_ptr)->payload = payload;
+        eb_post_full_object(wrapper_ptr);
+    }
+
+    // Runs every producer and consumer on its own thread, each producer
+    // posts num_posts objects; returns the elapsed seconds.
+    double run_pipeline(uint32_t num_posts, uint64_t *sum, uint64_t *count) {
+        std::vector<std::thread> threads;
+        std::vector<uint64_t> sums(consumer_count_, 0);
+        std::vector<uint64_t> counts(consumer_count_, 0);
+
+        auto start = std::chrono::high_resolution_clock::now();
+        for (uint32_t c = 0; c < consumer_count_; c++) {
+            threads.emplace_back([this, c, &sums, &counts]() {
+                EbFifo *fifo = eb_system_resource_get_consumer_fifo(resource_, c);
+                while (1) {
+                    EbObjectWrapper *wrapper_ptr;
+                    eb_get_full_object(fifo, &wrapper_ptr);
+                    uint32_t payload =
+                        ((TestObject *)wrapper_ptr->object_ptr)->payload;
+                    eb_release_object(wrapper_ptr);
+                    if (payload == end_of_stream)
+                        break;
+                    sums[c] += payload;
+                    counts[c]++;
+                }
+            });
+        }
+        std::vector<std::thread> producers;
+        for (uint32_t p = 0; p < producer_count_; p++) {
+            producers.emplace_back([this, p, num_posts]() {
+                for (uint32_t i = 0; i < num_posts; i++)
+                    post(p, p * num_posts + i);
+            });
+        }
+        for (auto &t : producers)
+            t.join();
+        for (uint32_t c = 0; c < consumer_count_; c++)
+            post(0, end_of_stream);
+        for (auto &t : threads)
+            t.join();
+        auto finish = std::chrono::high_resolution_clock::now();
+
+        *sum = *count = 0;
+        for (uint32_t c = 0; c < consumer_count_; c++) {
+            *sum += sums[c];
+            *count += counts[c];
+        }
+        return std::chrono::duration<double>(finish - start).count();
+    }
+
+    void run_match_test() {
+        const uint32_t num_posts = 5000;
+        const uint64_t total = (uint64_t)producer_count_ * num_posts;
+        uint64_t sum, count;
+
+        run_pipeline(num_posts, &sum, &count);
+
+        ASSERT_EQ(count, total);
+        ASSERT_EQ(sum, total * (total - 1) / 2);
+
+        // Every object went back to the empty queue
+        std::vector<EbObjectWrapper *> wrappers;
+        for (uint32_t i = 0; i < object_count_; i++) {
+            EbObjectWrapper *wrapper_ptr;
+            eb_get_empty_object(
+                eb_system_resource_get_producer_fifo(resource_, 0),
+                &wrapper_ptr);
+            wrappers.push_back(wrapper_ptr);
+        }
+        for (auto wrapper_ptr : wrappers)
+            eb_release_object(wrapper_ptr);
+    }
+
+    void run_live_count_test() {
+        EbObjectWrapper *wrapper_ptr, *full_ptr;
+        EbFifo *consumer = eb_system_resource_get_consumer_fifo(resource_, 0);
+
+        eb_get_full_object_non_blocking(consumer, &full_ptr);
+        ASSERT_EQ(full_ptr, nullptr);
+
+        eb_get_empty_object(eb_system_resource_get_producer_fifo(resource_, 0),
+                            &wrapper_ptr);
+        eb_object_inc_live_count(wrapper_ptr, 2);
+        eb_post_full_object(wrapper_ptr);
+        eb_get_full_object(consumer, &full_ptr);
+        ASSERT_EQ(full_ptr, wrapper_ptr);
+
+        // Held by the second reference, then released by the last one
+        eb_release_object(full_ptr);
+        ASSERT_EQ(wrapper_ptr->live_count, 1u);
+        eb_release_object(full_ptr);
+        ASSERT_EQ(wrapper_ptr->live_count, EB_ObjectWrapperReleasedValue);
+    }
+
+    void run_speed_test() {
+        const uint32_t num_posts = 200000;
+        uint64_t sum, count;
+
+        double time = run_pipeline(num_posts, &sum, &count);
+        printf("%s %u producers %u consumers %u objects: %8.1f ns/object\n",
+               lockfree_ ? "lock-free  " : "mutex+sema ",
+               producer_count_,
+               consumer_count_,
+               object_count_,
+               time * 1e9 / count);
+    }
+
+    bool lockfree_;
+    uint32_t producer_count_, consumer_count_, object_count_;
+    EbSystemResource *resource_;
+};
+
+TEST_P(SystemResourceTest, MatchTest) {
+    run_match_test();
+}
+
+TEST_P(SystemResourceTest, LiveCountTest) {
+    run_live_count_test();
+}
+
+TEST_P(SystemResourceTest, DISABLED_Speed) {
+    run_speed_test();
+}
+
+INSTANTIATE_TEST_CASE_P(
+    SystemResource, SystemResourceTest,
+    ::testing::Combine(::testing::Bool(), ::testing::Values(1u, 4u),
+                       ::testing::Values(1u, 4u), ::testing::Values(1u, 16u)));
+
+// Allocated with EB_MALLOC so that the pool can measure it
+typedef struct LargeTestObject {
+    uint32_t payload;
+    uint8_t data[4096];
+} LargeTestObject;
+
+static EbErrorType large_test_object_creator(EbPtr *object_dbl_ptr,
+                                             EbPtr object_init_data_ptr) {
+    LargeTestObject *obj;
+    (void)object_init_data_ptr;
+    *object_dbl_ptr = NULL;
+    EB_MALLOC(obj, sizeof(*obj));
+    *object_dbl_ptr = obj;
+    return EB_ErrorNone;
+}
+
+static void large_test_object_destroyer(EbPtr p) {
+    EB_FREE(p);
+}
+
+const uint32_t min_count = 2;
+const uint32_t total_count = 8;
+
+// <lock-free>
+class GrowableSystemResourceTest : public ::testing::TestWithParam<bool> {
+  public:
+    GrowableSystemResourceTest()
+        : lockfree_(GetParam()), budget_(NULL), resource_(NULL) {
+    }
+
+    void SetUp() override {
+        eb_system_resource_set_lockfree(lockfree_ ? EB_TRUE : EB_FALSE);
+        EB_NO_THROW_NEW(budget_, eb_memory_budget_ctor, 0);
+        ASSERT_NE(budget_, nullptr);
+        EB_NO_THROW_NEW(resource_,
+                        eb_system_resource_growable_ctor,
+                        min_count,
+                        total_count,
+                        1,
+                        1,
+                        large_test_object_creator,
+                        NULL,
+                        0,
+                        large_test_object_destroyer,
+                        budget_);
+        ASSERT_NE(resource_, nullptr);
+    }
+
+    void TearDown() override {
+        EB_DELETE(resource_);
+        EB_DELETE(budget_);
+        eb_system_resource_set_lockfree(lockfree_default);
+    }
+
+  protected:
+    EbObjectWrapper *get() {
+        EbObjectWrapper *wrapper_ptr;
+        eb_get_empty_object(
+            eb_system_resource_get_producer_fifo(resource_, 0), &wrapper_ptr);
+        return wrapper_ptr;
+    }
+
+    bool lockfree_;
+    EbMemoryBudget *budget_;
+    EbSystemResource *resource_;
+};
+
+TEST_P(GrowableSystemResourceTest, GrowWithinBudget) {
+    std::vector<EbObjectWrapper *> wrappers;
+
+    ASSERT_EQ(resource_->constructed_count, min_count);
+    ASSERT_GE(resource_->object_size, sizeof(LargeTestObject));
+    ASSERT_EQ(budget_->used_bytes, min_count * resource_->object_size);
+
+    // Room for one more object than the pool starts with
+    budget_->limit_bytes = budget_->used_bytes + resource_->object_size;
+    for (uint32_t i = 0; i <= min_count; i++) {
+        wrappers.push_back(get());
+        ASSERT_NE(wrappers.back()->object_ptr, nullptr);
+    }
+    EXPECT_EQ(resource_->constructed_count, min_count + 1);
+    EXPECT_EQ(budget_->used_bytes, budget_->limit_bytes);
+
+    // Past the budget, the producer waits for a release
+    EbObjectWrapper *waited_ptr = NULL;
+    std::thread producer([this, &waited_ptr]() { waited_ptr = get(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(waited_ptr, nullptr);
+    EXPECT_EQ(resource_->constructed_count, min_count + 1);
+    eb_release_object(wrappers[0]);
+    producer.join();
+    EXPECT_EQ(waited_ptr, wrappers[0]);
+
+    wrappers[0] = waited_ptr;
+    for (auto wrapper_ptr : wrappers)
+        eb_release_object(wrapper_ptr);
+}
+
+TEST_P(GrowableSystemResourceTest, ShrinkWhenIdle) {
+    std::vector<EbObjectWrapper *> wrappers;
+
+    // Without limit the pool grows up to its total count
+    for (uint32_t i = 0; i < total_count; i++)
+        wrappers.push_back(get());
+    EXPECT_EQ(resource_->constructed_count, total_count);
+    EXPECT_EQ(resource_->spare_count, 0u);
+    for (auto wrapper_ptr : wrappers)
+        eb_release_object(wrapper_ptr);
+
+    // One object in use at a time leaves the others idle
+    for (uint32_t i = 0; i < total_count * total_count; i++)
+        eb_release_object(get());
+    EXPECT_EQ(resource_->constructed_count, min_count);
+    EXPECT_EQ(resource_->spare_count, total_count - min_count);
+    EXPECT_EQ(budget_->used_bytes, min_count * resource_->object_size);
+    EXPECT_EQ(budget_->peak_bytes, total_count * resource_->object_size);
+
+    // And it grows again on demand
+    wrappers.clear();
+    for (uint32_t i = 0; i < total_count; i++)
+        wrappers.push_back(get());
+    EXPECT_EQ(resource_->constructed_count, total_count);
+    for (auto wrapper_ptr : wrappers)
+        eb_release_object(wrapper_ptr);
+}
+
+INSTANTIATE_TEST_CASE_P(SystemResource, GrowableSystemResourceTest,
+                        ::testing::Bool());
+
+}  // namespace
@@ -0,0 +1,245 @@
+/*
+ * Copyright(c) 2019 Intel Corporation
+ * SPDX - License - Identifier: BSD - 2 - Clause - Patent
+ */
+
+/******************************************************************************
+ * @file ThreadPoolTest.cc
+ *
+ * @brief Unit test of the encoder thread pool: two chained stages run as
+ * jobs on the pool workers,
+ * - eb_thread_pool_add_stage
+ * - eb_thread_pool_start
+ * - eb_thread_pool_help, with the second stage queue smaller than the
+ *   first so the workers of the first stage wait for empty objects
+ * - eb_thread_pool_wait, with the empty objects of the second stage held
+ *   outside the pool so the workers block until they are released
+ *
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdlib.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+// workaround to eliminate the compiling warning on linux
+// The macro will conflict with definition in gtest.h
+#ifdef __USE_GNU
+#undef __USE_GNU  // defined in EbThreads.h
+#endif
+#ifdef _GNU_SOURCE
+#undef _GNU_SOURCE  // defined in EbThreads.h
+#endif
+#include "EbThreadPool.h"
+#include "EbEncHandle.h"
+
+namespace {
+
+#ifdef EB_LOCKFREE_QUEUE
+const EbBool lockfree_default = EB_TRUE;
+#else
+const EbBool lockfree_default = EB_FALSE;
+#endif
+
+typedef struct TestObject {
+    uint32_t payload;
+} TestObject;
+
+static EbErrorType test_object_creator(EbPtr *object_dbl_ptr,
+                                       EbPtr object_init_data_ptr) {
+    (void)object_init_data_ptr;
+    *object_dbl_ptr = calloc(1, sizeof(TestObject));
+    return *object_dbl_ptr ? EB_ErrorNone : EB_ErrorInsufficientResources;
+}
+
+static void test_object_destroyer(EbPtr p) {
+    free(p);
+}
+
+class ThreadPoolTest;
+
+// Stage context of one worker
+typedef struct StageContext {
+    ThreadPoolTest *test;
+    uint32_t index;
+} StageContext;
+
+// <workers, objects of the second stage>
+typedef std::tuple<uint32_t, uint32_t> ThreadPoolParam;
+
+class ThreadPoolTest : public ::testing::TestWithParam<ThreadPoolParam> {
+  public:
+    ThreadPoolTest()
+        : worker_count_(std::get<0>(GetParam())),
+          second_object_count_(std::get<1>(GetParam())),
+          first_resource_(NULL),
+          second_resource_(NULL),
+          pool_(NULL),
+          sum_(0),
+          count_(0) {
+    }
+
+    void SetUp() override {
+        eb_system_resource_set_lockfree(EB_TRUE);
+        EB_NO_THROW_NEW(first_resource_,
+                        eb_system_resource_ctor,
+                        first_object_count,
+                        1,
+                        worker_count_,
+                        test_object_creator,
+                        NULL,
+                        test_object_destroyer);
+        ASSERT_NE(first_resource_, nullptr);
+        EB_NO_THROW_NEW(second_resource_,
+                        eb_system_resource_ctor,
+                        second_object_count_,
+                        worker_count_,
+                        worker_count_,
+                        test_object_creator,
+                        NULL,
+                        test_object_destroyer);
+        ASSERT_NE(second_resource_, nullptr);
+
+        contexts_.resize(worker_count_);
+        for (uint32_t i = 0; i < worker_count_; i++) {
+            contexts_[i].test = this;
+            contexts_[i].index = i;
+            thread_contexts_.push_back({NULL, &contexts_[i]});
+        }
+        for (uint32_t i = 0; i < worker_count_; i++)
+            thread_context_ptrs_.push_back(&thread_contexts_[i]);
+
+        EB_NO_THROW_NEW(pool_, eb_thread_pool_ctor, worker_count_);
+        ASSERT_NE(pool_, nullptr);
+        ASSERT_EQ(eb_thread_pool_add_stage(pool_,
+                                           first_resource_,
+                                           thread_context_ptrs_.data(),
+                                           first_job),
+                  EB_ErrorNone);
+        ASSERT_EQ(eb_thread_pool_add_stage(pool_,
+                                           second_resource_,
+                                           thread_context_ptrs_.data(),
+                                           second_job),
+                  EB_ErrorNone);
+        ASSERT_EQ(eb_thread_pool_start(pool_), EB_ErrorNone);
+    }
+
+    void TearDown() override {
+        EB_DELETE(pool_);
+        EB_DELETE(second_resource_);
+        EB_DELETE(first_resource_);
+        eb_system_resource_set_lockfree(lockfree_default);
+    }
+
+  protected:
+    // Forwards the payload to the second stage
+    static void first_job(EbThreadContext *thread_context_ptr,
+                          EbObjectWrapper *input_wrapper_ptr) {
+        StageContext *context_ptr = (StageContext *)thread_context_ptr->priv;
+        EbObjectWrapper *output_wrapper_ptr;
+        uint32_t payload =
+            ((TestObject *)input_wrapper_ptr->object_ptr)->payload;
+
+        eb_release_object(input_wrapper_ptr);
+        eb_get_empty_object(
+            eb_system_resource_get_producer_fifo(
+                context_ptr->test->second_resource_, context_ptr->index),
+            &output_wrapper_ptr);
+        ((TestObject *)output_wrapper_ptr->object_ptr)->payload = payload;
+        eb_post_full_object(output_wrapper_ptr);
+    }
+
+    // Accumulates the payload
+    static void second_job(EbThreadContext *thread_context_ptr,
+                           EbObjectWrapper *input_wrapper_ptr) {
+        StageContext *context_ptr = (StageContext *)thread_context_ptr->priv;
+        uint32_t payload =
+            ((TestObject *)input_wrapper_ptr->object_ptr)->payload;
+
+        eb_release_object(input_wrapper_ptr);
+        context_ptr->test->sum_ += payload;
+        context_ptr->test->count_++;
+    }
+
+    void run_match_test() {
+        const uint32_t num_posts = 20000;
+        EbFifo *producer =
+            eb_system_resource_get_producer_fifo(first_resource_, 0);
+
+        for (uint32_t i = 0; i < num_posts; i++) {
+            EbObjectWrapper *wrapper_ptr;
+            eb_get_empty_object(producer, &wrapper_ptr);
+            ((TestObject *)wrapper_ptr->object_ptr)->payload = i;
+            eb_post_full_object(wrapper_ptr);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        while (count_ < num_posts &&
+               std::chrono::steady_clock::now() - start <
+                   std::chrono::seconds(60))
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+        ASSERT_EQ(count_, num_posts);
+        ASSERT_EQ(sum_, (uint64_t)num_posts * (num_posts - 1) / 2);
+    }
+
+    // Holds every empty object of the second stage while the jobs of the
+    // first stage are posted, then releases them
+    void run_blocked_test() {
+        const uint32_t num_posts = first_object_count;
+        EbFifo *producer =
+            eb_system_resource_get_producer_fifo(first_resource_, 0);
+        std::vector<EbObjectWrapper *> held(second_object_count_);
+
+        for (auto &wrapper_ptr : held)
+            eb_get_empty_object(
+                eb_system_resource_get_producer_fifo(second_resource_, 0),
+                &wrapper_ptr);
+        for (uint32_t i = 0; i < num_posts; i++) {
+            EbObjectWrapper *wrapper_ptr;
+            eb_get_empty_object(producer, &wrapper_ptr);
+            ((TestObject *)wrapper_ptr->object_ptr)->payload = i;
+            eb_post_full_object(wrapper_ptr);
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        ASSERT_EQ(count_, 0u);
+
+        // The pushes to the ring wake the blocked workers
+        for (auto wrapper_ptr : held) eb_release_object(wrapper_ptr);
+        auto start = std::chrono::steady_clock::now();
+        while (count_ < num_posts &&
+               std::chrono::steady_clock::now() - start <
+                   std::chrono::seconds(60))
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+        ASSERT_EQ(count_, num_posts);
+        ASSERT_EQ(sum_, (uint64_t)num_posts * (num_posts - 1) / 2);
+    }
+
+    static const uint32_t first_object_count = 16;
+
+    uint32_t worker_count_, second_object_count_;
+    EbSystemResource *first_resource_, *second_resource_;
+    EbThreadPool *pool_;
+    std::vector<StageContext> contexts_;
+    std::vector<EbThreadContext> thread_contexts_;
+    std::vector<EbThreadContext *> thread_context_ptrs_;
+    std::atomic<uint64_t> sum_;
+    std::atomic<uint32_t> count_;
+};
+
+TEST_P(ThreadPoolTest, MatchTest) {
+    run_match_test();
+}
+
+TEST_P(ThreadPoolTest, BlockedWorkerWakeTest) {
+    run_blocked_test();
+}
+
+INSTANTIATE_TEST_CASE_P(ThreadPool, ThreadPoolTest,
+                        ::testing::Combine(::testing::Values(1u, 2u, 8u),
+                                           ::testing::Values(1u, 4u, 32u)));
+
+}  // namespace
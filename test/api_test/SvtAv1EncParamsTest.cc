@@ -394,6 +394,42 @@ PARAM_TEST(EncParamLogicalProcessorsTest);
 DEFINE_PARAM_TEST_CLASS(EncParamTargetSocketTest, target_socket);
 PARAM_TEST(EncParamTargetSocketTest);
 
+/** Test case for thread_pool*/
+DEFINE_PARAM_TEST_CLASS(EncParamThreadPoolTest, thread_pool);
+PARAM_TEST(EncParamThreadPoolTest);
+
+/** Test case for numa_mode*/
+DEFINE_PARAM_TEST_CLASS(EncParamNumaModeTest, numa_mode);
+PARAM_TEST(EncParamNumaModeTest);
+
+/** Test case for huge_pages*/
+DEFINE_PARAM_TEST_CLASS(EncParamHugePagesTest, huge_pages);
+PARAM_TEST(EncParamHugePagesTest);
+
+/** Test case for pipeline_stats*/
+DEFINE_PARAM_TEST_CLASS(EncParamPipelineStatsTest, pipeline_stats);
+PARAM_TEST(EncParamPipelineStatsTest);
+
+/** Test case for zero_copy_input*/
+DEFINE_PARAM_TEST_CLASS(EncParamZeroCopyInputTest, zero_copy_input);
+PARAM_TEST(EncParamZeroCopyInputTest);
+
+/** Test case for pool_memory_budget*/
+DEFINE_PARAM_TEST_CLASS(EncParamPoolMemoryBudgetTest, pool_memory_budget);
+PARAM_TEST(EncParamPoolMemoryBudgetTest);
+
+/** Test case for low_latency*/
+DEFINE_PARAM_TEST_CLASS(EncParamLowLatencyTest, low_latency);
+PARAM_TEST(EncParamLowLatencyTest);
+
+/** Test case for latency_budget*/
+DEFINE_PARAM_TEST_CLASS(EncParamLatencyBudgetTest, latency_budget);
+PARAM_TEST(EncParamLatencyBudgetTest);
+
+/** Test case for inter_frame_wavefront*/
+DEFINE_PARAM_TEST_CLASS(EncParamInterFrameWavefrontTest, inter_frame_wavefront);
+PARAM_TEST(EncParamInterFrameWavefrontTest);
+
 /** Test case for recon_enabled*/
 DEFINE_PARAM_TEST_CLASS(EncParamReconEnabledTest, recon_enabled);
 PARAM_TEST(EncParamReconEnabledTest);
@@ -406,6 +442,10 @@ PARAM_TEST(EncParamTileColsTest);
 /** Test case for tile_rows*/
 DEFINE_PARAM_TEST_CLASS(EncParamTileRowsTest, tile_rows);
 PARAM_TEST(EncParamTileRowsTest);
+
+/** Test case for tile_parallel*/
+DEFINE_PARAM_TEST_CLASS(EncParamTileParallelTest, tile_parallel);
+PARAM_TEST(EncParamTileParallelTest);
 #endif
 
 /** Test case for screen_content_mode*/
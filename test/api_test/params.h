@@ -980,6 +980,167 @@ static const vector<int32_t> invalid_target_socket = {
     2,
 };
 
+/* Run the multi-threaded encoder stages as jobs on one pool of
+ * logical_processors worker threads.
+ *
+ * 0 = OFF.
+ * 1 = ON.
+ *
+ * Default is 0. */
+static const vector<uint32_t> default_thread_pool = {
+    0,
+};
+static const vector<uint32_t> valid_thread_pool = {
+    0,
+    1,
+};
+static const vector<uint32_t> invalid_thread_pool = {
+    2,
+};
+
+/* Spread the encoder over the NUMA nodes of the system.
+ *
+ * 0 = OFF.
+ * 1 = ON.
+ *
+ * Default is 0. */
+static const vector<uint32_t> default_numa_mode = {
+    0,
+};
+static const vector<uint32_t> valid_numa_mode = {
+    0,
+    1,
+};
+static const vector<uint32_t> invalid_numa_mode = {
+    2,
+};
+
+/* Allocate the picture buffers on huge pages.
+ *
+ * 0 = OFF.
+ * 1 = ON.
+ *
+ * Default is 0. */
+static const vector<uint32_t> default_huge_pages = {
+    0,
+};
+static const vector<uint32_t> valid_huge_pages = {
+    0,
+    1,
+};
+static const vector<uint32_t> invalid_huge_pages = {
+    2,
+};
+
+/* Collect per-stage pipeline statistics.
+ *
+ * 0 = OFF.
+ * 1 = Counters.
+ * 2 = Counters and trace events.
+ *
+ * Default is 0. */
+static const vector<uint32_t> default_pipeline_stats = {
+    0,
+};
+static const vector<uint32_t> valid_pipeline_stats = {
+    0,
+    1,
+    2,
+};
+static const vector<uint32_t> invalid_pipeline_stats = {
+    3,
+};
+
+/* Encode the input pictures in place instead of copying them, requires an
+ * input_release_callback.
+ *
+ * 0 = OFF.
+ * 1 = ON.
+ *
+ * Default is 0. */
+static const vector<uint32_t> default_zero_copy_input = {
+    0,
+};
+static const vector<uint32_t> valid_zero_copy_input = {
+    0,
+};
+static const vector<uint32_t> invalid_zero_copy_input = {
+    1,  // no input_release_callback
+    2,
+};
+
+/* Memory budget in MB of the picture pools, which then grow on demand.
+ *
+ * 0 = No budget, the pools are fully allocated at init.
+ *
+ * Default is 0. */
+static const vector<uint32_t> default_pool_memory_budget = {
+    0,
+};
+static const vector<uint32_t> valid_pool_memory_budget = {
+    0,
+    1,
+    256,
+    4096,
+};
+static const vector<uint32_t> invalid_pool_memory_budget = {
+    // ...
+};
+
+/* Real-time mode, pictures are coded in input order with two of them in
+ * flight.
+ *
+ * 0 = OFF.
+ * 1 = ON.
+ *
+ * Default is 0. */
+static const vector<uint32_t> default_low_latency = {
+    0,
+};
+static const vector<uint32_t> valid_low_latency = {
+    0,
+    1,
+};
+static const vector<uint32_t> invalid_low_latency = {
+    2,
+};
+
+/* Time in ms eb_svt_get_packet() waits for a packet.
+ *
+ * 0 = No wait.
+ *
+ * Default is 0. */
+static const vector<uint32_t> default_latency_budget = {
+    0,
+};
+static const vector<uint32_t> valid_latency_budget = {
+    0,
+    1,
+    33,
+    1000,
+};
+static const vector<uint32_t> invalid_latency_budget = {
+    // ...
+};
+
+/* Start the MD of a picture once the filter decisions of its references are
+ * made, waiting per block for the reference rows it reads.
+ *
+ * 0 = OFF.
+ * 1 = ON.
+ *
+ * Default is 0. */
+static const vector<uint32_t> default_inter_frame_wavefront = {
+    0,
+};
+static const vector<uint32_t> valid_inter_frame_wavefront = {
+    0,
+    1,
+};
+static const vector<uint32_t> invalid_inter_frame_wavefront = {
+    2,
+};
+
 // Debug tools
 
 /* Output reconstructed yuv used for debug purposes. The value is set through
@@ -1026,6 +1187,17 @@ static const vector<int32_t> invalid_tile_rows = {
     -1,
     7,
 };
+
+static const vector<uint32_t> default_tile_parallel = {
+    0,
+};
+static const vector<uint32_t> valid_tile_parallel = {
+    0,
+    1,
+};
+static const vector<uint32_t> invalid_tile_parallel = {
+    2,
+};
 #endif
 
 /* Flag to signal the content being a screen sharing content type
@@ -0,0 +1,580 @@
+/*
+ * Copyright(c) 2019 Netflix, Inc.
+ * SPDX - License - Identifier: BSD - 2 - Clause - Patent
+ */
+
+/******************************************************************************
+ * @file KernelBenchmark.cc
+ *
+ * @brief Benchmark of the run time dispatched DSP kernels
+ * - for every ISA level the CPU supports, setup_rtcd_internal() selects the
+ *   kernels and every kernel of the table below is timed at each of its block
+ *   sizes and bit depths. A level whose kernel is the same function as the
+ *   level below is skipped unless --all-levels is given.
+ * - reports ns/call, Mpixel/s and, when perf_event_open is allowed, cycles,
+ *   IPC and cache misses per call, as CSV or JSON lines on stdout.
+ *
+ * Adding a kernel: add a row to kernel_table with the address of its rtcd
+ * pointer and a run function of the matching signature.
+ *
+ ******************************************************************************/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "aom_dsp_rtcd.h"
+#include "EbDefinitions.h"
+#include "EbTime.h"
+#include "convolve.h"
+#include "filter.h"
+#include "random.h"
+#include "PerfCounters.h"
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+using svt_av1_benchmark::PerfCounters;
+using svt_av1_benchmark::PerfSample;
+using svt_av1_test_tool::SVTRandom;
+
+namespace {
+
+/**************************************
+ * Buffers
+ **************************************/
+// Large enough for a 128x128 block plus the 8-tap convolve borders
+#define BENCH_STRIDE (MAX_SB_SIZE * 2)
+#define BENCH_ROWS (MAX_SB_SIZE + 16)
+#define BENCH_ALIGN 64
+
+typedef struct BenchBuffers {
+    uint8_t *src8;
+    uint8_t *ref8;
+    uint8_t *dst8;
+    uint16_t *src16;
+    uint16_t *ref16;
+    uint16_t *dst16;
+    int16_t *residual;
+    int32_t *coeff;
+    uint32_t stride;
+} BenchBuffers;
+
+static std::vector<void *> allocations;
+
+template <typename T>
+static T *alloc_buffer(size_t count) {
+    uint8_t *raw = (uint8_t *)malloc(count * sizeof(T) + BENCH_ALIGN);
+    if (raw == NULL) {
+        fprintf(stderr, "out of memory\n");
+        exit(1);
+    }
+    allocations.push_back(raw);
+    return (T *)(((uintptr_t)raw + BENCH_ALIGN - 1) & ~(uintptr_t)(BENCH_ALIGN - 1));
+}
+
+static void init_buffers(BenchBuffers *bufs) {
+    const size_t count = BENCH_STRIDE * BENCH_ROWS;
+    SVTRandom rnd8(8, false);
+    SVTRandom rnd10(10, false);
+    SVTRandom rnd_coeff(-64, 64);
+    bufs->stride = BENCH_STRIDE;
+    bufs->src8 = alloc_buffer<uint8_t>(count);
+    bufs->ref8 = alloc_buffer<uint8_t>(count);
+    bufs->dst8 = alloc_buffer<uint8_t>(count);
+    bufs->src16 = alloc_buffer<uint16_t>(count);
+    bufs->ref16 = alloc_buffer<uint16_t>(count);
+    bufs->dst16 = alloc_buffer<uint16_t>(count);
+    bufs->residual = alloc_buffer<int16_t>(count);
+    bufs->coeff = alloc_buffer<int32_t>(count);
+    for (size_t i = 0; i < count; i++) {
+        bufs->src8[i] = (uint8_t)rnd8.random();
+        bufs->ref8[i] = (uint8_t)rnd8.random();
+        bufs->dst8[i] = (uint8_t)rnd8.random();
+        bufs->src16[i] = (uint16_t)rnd10.random();
+        bufs->ref16[i] = (uint16_t)rnd10.random();
+        bufs->dst16[i] = (uint16_t)rnd10.random();
+        bufs->residual[i] = (int16_t)(bufs->src16[i] - bufs->ref16[i]);
+        bufs->coeff[i] = rnd_coeff.random();
+    }
+}
+
+static void free_buffers() {
+    for (size_t i = 0; i < allocations.size(); i++)
+        free(allocations[i]);
+    allocations.clear();
+}
+
+/**************************************
+ * Kernel table
+ **************************************/
+typedef void (*GenericFunc)(void);
+struct KernelBench;
+typedef void (*RunFunc)(const KernelBench &kernel, const BenchBuffers &bufs,
+                        uint64_t iterations);
+
+struct KernelBench {
+    const char *family;
+    const char *name;  // the rtcd pointer
+    GenericFunc *rtcd_ptr;
+    uint32_t width;
+    uint32_t height;
+    uint32_t bit_depth;
+    RunFunc run;
+};
+
+// Results feed this so that the calls are not optimized away
+static volatile uint64_t bench_sink;
+
+typedef uint32_t (*SadFunc)(const uint8_t *src_ptr, int src_stride,
+                            const uint8_t *ref_ptr, int ref_stride);
+typedef unsigned int (*VarianceFunc)(const uint8_t *src_ptr, int source_stride,
+                                     const uint8_t *ref_ptr, int ref_stride,
+                                     unsigned int *sse);
+typedef int64_t (*SseFunc)(const uint8_t *a, int a_stride, const uint8_t *b,
+                           int b_stride, int width, int height);
+typedef void (*FwdTxfmFunc)(int16_t *input, int32_t *output,
+                            uint32_t input_stride, TxType transform_type,
+                            uint8_t bit_depth);
+typedef void (*InvTxfmFunc)(const int32_t *input, uint16_t *output_r,
+                            int32_t stride_r, uint16_t *output_w,
+                            int32_t stride_w, TxType tx_type, int32_t bd);
+
+template <typename F>
+static F current_func(const KernelBench &kernel) {
+    return reinterpret_cast<F>(*kernel.rtcd_ptr);
+}
+
+static void run_sad(const KernelBench &kernel, const BenchBuffers &bufs,
+                    uint64_t iterations) {
+    SadFunc func = current_func<SadFunc>(kernel);
+    uint64_t sum = 0;
+    for (uint64_t i = 0; i < iterations; i++)
+        sum += func(bufs.src8, bufs.stride, bufs.ref8, bufs.stride);
+    bench_sink += sum;
+}
+
+static void run_variance(const KernelBench &kernel, const BenchBuffers &bufs,
+                         uint64_t iterations) {
+    VarianceFunc func = current_func<VarianceFunc>(kernel);
+    uint64_t sum = 0;
+    unsigned int sse;
+    for (uint64_t i = 0; i < iterations; i++)
+        sum += func(bufs.src8, bufs.stride, bufs.ref8, bufs.stride, &sse);
+    bench_sink += sum + sse;
+}
+
+static void run_sse(const KernelBench &kernel, const BenchBuffers &bufs,
+                    uint64_t iterations) {
+    SseFunc func = current_func<SseFunc>(kernel);
+    const bool hbd = kernel.bit_depth > 8;
+    const uint8_t *a = hbd ? (const uint8_t *)bufs.src16 : bufs.src8;
+    const uint8_t *b = hbd ? (const uint8_t *)bufs.ref16 : bufs.ref8;
+    int64_t sum = 0;
+    for (uint64_t i = 0; i < iterations; i++)
+        sum += func(a, bufs.stride, b, bufs.stride, kernel.width,
+                    kernel.height);
+    bench_sink += (uint64_t)sum;
+}
+
+static void run_subtract(const KernelBench &kernel, const BenchBuffers &bufs,
+                         uint64_t iterations) {
+    if (kernel.bit_depth > 8) {
+        for (uint64_t i = 0; i < iterations; i++)
+            aom_highbd_subtract_block(kernel.height, kernel.width,
+                                      bufs.residual, bufs.stride,
+                                      (const uint8_t *)bufs.src16, bufs.stride,
+                                      (const uint8_t *)bufs.ref16, bufs.stride,
+                                      kernel.bit_depth);
+    } else {
+        for (uint64_t i = 0; i < iterations; i++)
+            aom_subtract_block(kernel.height, kernel.width, bufs.residual,
+                               bufs.stride, bufs.src8, bufs.stride, bufs.ref8,
+                               bufs.stride);
+    }
+    bench_sink += (uint64_t)bufs.residual[0];
+}
+
+static void run_residual(const KernelBench &kernel, const BenchBuffers &bufs,
+                         uint64_t iterations) {
+    for (uint64_t i = 0; i < iterations; i++)
+        residual_kernel8bit(bufs.src8, bufs.stride, bufs.ref8, bufs.stride,
+                            bufs.residual, bufs.stride, kernel.width,
+                            kernel.height);
+    bench_sink += (uint64_t)bufs.residual[0];
+}
+
+static void run_distortion(const KernelBench &kernel, const BenchBuffers &bufs,
+                           uint64_t iterations) {
+    uint64_t sum = 0;
+    for (uint64_t i = 0; i < iterations; i++)
+        sum += spatial_full_distortion_kernel(bufs.src8, 0, bufs.stride,
+                                              bufs.ref8, 0, bufs.stride,
+                                              kernel.width, kernel.height);
+    bench_sink += sum;
+}
+
+static void run_fwd_txfm(const KernelBench &kernel, const BenchBuffers &bufs,
+                         uint64_t iterations) {
+    FwdTxfmFunc func = current_func<FwdTxfmFunc>(kernel);
+    for (uint64_t i = 0; i < iterations; i++)
+        func(bufs.residual, bufs.coeff, bufs.stride, DCT_DCT,
+             (uint8_t)kernel.bit_depth);
+    bench_sink += (uint64_t)bufs.coeff[0];
+}
+
+static void run_inv_txfm(const KernelBench &kernel, const BenchBuffers &bufs,
+                         uint64_t iterations) {
+    InvTxfmFunc func = current_func<InvTxfmFunc>(kernel);
+    for (uint64_t i = 0; i < iterations; i++)
+        func(bufs.coeff, bufs.dst16, bufs.stride, bufs.dst16, bufs.stride,
+             DCT_DCT, kernel.bit_depth);
+    bench_sink += bufs.dst16[0];
+}
+
+static void run_convolve(const KernelBench &kernel, const BenchBuffers &bufs,
+                         uint64_t iterations) {
+    DECLARE_ALIGNED(32, ConvBufType, conv_buf[MAX_SB_SIZE * MAX_SB_SIZE]);
+    InterpFilterParams filter_x = av1_get_interp_filter_params_with_block_size(
+        EIGHTTAP_REGULAR, kernel.width);
+    InterpFilterParams filter_y = av1_get_interp_filter_params_with_block_size(
+        EIGHTTAP_REGULAR, kernel.height);
+    ConvolveParams conv_params = get_conv_params_no_round(
+        0, 0, 0, conv_buf, MAX_SB_SIZE, 0, kernel.bit_depth);
+    // half-pel in both directions, the source starts 3 rows and columns in
+    const uint32_t offset = 3 * bufs.stride + 3;
+    if (kernel.bit_depth > 8) {
+        for (uint64_t i = 0; i < iterations; i++)
+            eb_av1_highbd_convolve_2d_sr(bufs.src16 + offset, bufs.stride,
+                                         bufs.dst16, bufs.stride, kernel.width,
+                                         kernel.height, &filter_x, &filter_y,
+                                         8, 8, &conv_params, kernel.bit_depth);
+        bench_sink += bufs.dst16[0];
+    } else {
+        for (uint64_t i = 0; i < iterations; i++)
+            eb_av1_convolve_2d_sr(bufs.src8 + offset, bufs.stride, bufs.dst8,
+                                  bufs.stride, kernel.width, kernel.height,
+                                  &filter_x, &filter_y, 8, 8, &conv_params);
+        bench_sink += bufs.dst8[0];
+    }
+}
+
+#define RTCD(ptr) #ptr, (GenericFunc *)&ptr
+#define SQUARE_SIZES(family, ptr, bd, run)                                     \
+    {family, RTCD(ptr), 4, 4, bd, run}, {family, RTCD(ptr), 8, 8, bd, run},    \
+        {family, RTCD(ptr), 16, 16, bd, run},                                  \
+        {family, RTCD(ptr), 32, 32, bd, run},                                  \
+        {family, RTCD(ptr), 64, 64, bd, run},                                  \
+        {family, RTCD(ptr), 128, 128, bd, run}
+
+static const KernelBench kernel_table[] = {
+    {"sad", RTCD(eb_aom_sad4x4), 4, 4, 8, run_sad},
+    {"sad", RTCD(eb_aom_sad8x8), 8, 8, 8, run_sad},
+    {"sad", RTCD(eb_aom_sad16x16), 16, 16, 8, run_sad},
+    {"sad", RTCD(eb_aom_sad32x32), 32, 32, 8, run_sad},
+    {"sad", RTCD(eb_aom_sad64x64), 64, 64, 8, run_sad},
+    {"sad", RTCD(eb_aom_sad128x128), 128, 128, 8, run_sad},
+    {"variance", RTCD(eb_aom_variance4x4), 4, 4, 8, run_variance},
+    {"variance", RTCD(eb_aom_variance8x8), 8, 8, 8, run_variance},
+    {"variance", RTCD(eb_aom_variance16x16), 16, 16, 8, run_variance},
+    {"variance", RTCD(eb_aom_variance32x32), 32, 32, 8, run_variance},
+    {"variance", RTCD(eb_aom_variance64x64), 64, 64, 8, run_variance},
+    {"variance", RTCD(eb_aom_variance128x128), 128, 128, 8, run_variance},
+    SQUARE_SIZES("sse", aom_sse, 8, run_sse),
+    SQUARE_SIZES("sse", aom_highbd_sse, 10, run_sse),
+    SQUARE_SIZES("subtract", aom_subtract_block, 8, run_subtract),
+    SQUARE_SIZES("subtract", aom_highbd_subtract_block, 10, run_subtract),
+    SQUARE_SIZES("residual", residual_kernel8bit, 8, run_residual),
+    SQUARE_SIZES("distortion", spatial_full_distortion_kernel, 8,
+                 run_distortion),
+    {"fwd_txfm", RTCD(eb_av1_fwd_txfm2d_4x4), 4, 4, 8, run_fwd_txfm},
+    {"fwd_txfm", RTCD(eb_av1_fwd_txfm2d_8x8), 8, 8, 8, run_fwd_txfm},
+    {"fwd_txfm", RTCD(eb_av1_fwd_txfm2d_16x16), 16, 16, 8, run_fwd_txfm},
+    {"fwd_txfm", RTCD(eb_av1_fwd_txfm2d_32x32), 32, 32, 8, run_fwd_txfm},
+    {"fwd_txfm", RTCD(eb_av1_fwd_txfm2d_64x64), 64, 64, 8, run_fwd_txfm},
+    {"fwd_txfm", RTCD(eb_av1_fwd_txfm2d_4x4), 4, 4, 10, run_fwd_txfm},
+    {"fwd_txfm", RTCD(eb_av1_fwd_txfm2d_8x8), 8, 8, 10, run_fwd_txfm},
+    {"fwd_txfm", RTCD(eb_av1_fwd_txfm2d_16x16), 16, 16, 10, run_fwd_txfm},
+    {"fwd_txfm", RTCD(eb_av1_fwd_txfm2d_32x32), 32, 32, 10, run_fwd_txfm},
+    {"fwd_txfm", RTCD(eb_av1_fwd_txfm2d_64x64), 64, 64, 10, run_fwd_txfm},
+    {"inv_txfm", RTCD(eb_av1_inv_txfm2d_add_4x4), 4, 4, 8, run_inv_txfm},
+    {"inv_txfm", RTCD(eb_av1_inv_txfm2d_add_8x8), 8, 8, 8, run_inv_txfm},
+    {"inv_txfm", RTCD(eb_av1_inv_txfm2d_add_16x16), 16, 16, 8, run_inv_txfm},
+    {"inv_txfm", RTCD(eb_av1_inv_txfm2d_add_32x32), 32, 32, 8, run_inv_txfm},
+    {"inv_txfm", RTCD(eb_av1_inv_txfm2d_add_64x64), 64, 64, 8, run_inv_txfm},
+    {"inv_txfm", RTCD(eb_av1_inv_txfm2d_add_4x4), 4, 4, 10, run_inv_txfm},
+    {"inv_txfm", RTCD(eb_av1_inv_txfm2d_add_8x8), 8, 8, 10, run_inv_txfm},
+    {"inv_txfm", RTCD(eb_av1_inv_txfm2d_add_16x16), 16, 16, 10, run_inv_txfm},
+    {"inv_txfm", RTCD(eb_av1_inv_txfm2d_add_32x32), 32, 32, 10, run_inv_txfm},
+    {"inv_txfm", RTCD(eb_av1_inv_txfm2d_add_64x64), 64, 64, 10, run_inv_txfm},
+    SQUARE_SIZES("convolve_2d_sr", eb_av1_convolve_2d_sr, 8, run_convolve),
+    SQUARE_SIZES("convolve_2d_sr", eb_av1_highbd_convolve_2d_sr, 10,
+                 run_convolve),
+};
+
+#define KERNEL_COUNT (sizeof(kernel_table) / sizeof(kernel_table[0]))
+
+/**************************************
+ * ISA levels
+ **************************************/
+typedef struct IsaLevel {
+    const char *name;
+    CPU_FLAGS flags;  // the level and everything below it
+} IsaLevel;
+
+#define LEVEL_SSE2 (CPU_FLAGS_MMX | CPU_FLAGS_SSE | CPU_FLAGS_SSE2)
+#define LEVEL_SSSE3 (LEVEL_SSE2 | CPU_FLAGS_SSE3 | CPU_FLAGS_SSSE3)
+#define LEVEL_SSE4_1 (LEVEL_SSSE3 | CPU_FLAGS_SSE4_1 | CPU_FLAGS_SSE4_2)
+#define LEVEL_AVX2 (LEVEL_SSE4_1 | CPU_FLAGS_AVX | CPU_FLAGS_AVX2)
+#define LEVEL_AVX512                                                      \
+    (LEVEL_AVX2 | CPU_FLAGS_AVX512F | CPU_FLAGS_AVX512DQ |                \
+     CPU_FLAGS_AVX512CD | CPU_FLAGS_AVX512BW | CPU_FLAGS_AVX512VL)
+
+static const IsaLevel isa_levels[] = {
+    {"c", 0},
+    {"sse2", LEVEL_SSE2},
+    {"ssse3", LEVEL_SSSE3},
+    {"sse4_1", LEVEL_SSE4_1},
+    {"avx2", LEVEL_AVX2},
+    {"avx512", LEVEL_AVX512},
+};
+
+#define ISA_LEVEL_COUNT (sizeof(isa_levels) / sizeof(isa_levels[0]))
+
+/**************************************
+ * Measurement
+ **************************************/
+typedef struct BenchOptions {
+    const char *filter;  // substring of family or kernel name
+    const char *isa;     // comma separated level names, NULL for all
+    uint32_t min_time_ms;
+    uint32_t repeat;
+    bool json;
+    bool all_levels;
+    int cpu;
+} BenchOptions;
+
+typedef struct BenchResult {
+    uint64_t iterations;
+    double ns_per_call;
+    bool has_counters;
+    PerfSample counters;
+} BenchResult;
+
+static uint64_t time_run(const KernelBench &kernel, const BenchBuffers &bufs,
+                         uint64_t iterations) {
+    const uint64_t start = eb_time_ns();
+    kernel.run(kernel, bufs, iterations);
+    return eb_time_ns() - start;
+}
+
+static void measure(const KernelBench &kernel, const BenchBuffers &bufs,
+                    PerfCounters *counters, const BenchOptions &opt,
+                    BenchResult *result) {
+    const uint64_t target_ns = (uint64_t)opt.min_time_ms * 1000000;
+    // Calibrate, doubling the count until a run takes an eighth of the
+    // target, which also warms up the caches and the branch predictors
+    uint64_t iterations = 1;
+    uint64_t elapsed = time_run(kernel, bufs, iterations);
+    while (elapsed < target_ns / 8 && iterations < (1ull << 40)) {
+        iterations *= 2;
+        elapsed = time_run(kernel, bufs, iterations);
+    }
+    if (elapsed < target_ns && elapsed > 0)
+        iterations = iterations * target_ns / elapsed;
+
+    // Keep the fastest of the repeats, the others were disturbed
+    result->iterations = iterations;
+    result->ns_per_call = 0;
+    result->has_counters = false;
+    for (uint32_t r = 0; r < opt.repeat; r++) {
+        PerfSample sample;
+        counters->start();
+        elapsed = time_run(kernel, bufs, iterations);
+        const bool has_counters = counters->stop(&sample);
+        const double ns_per_call = (double)elapsed / (double)iterations;
+        if (r == 0 || ns_per_call < result->ns_per_call) {
+            result->ns_per_call = ns_per_call;
+            result->has_counters = has_counters;
+            result->counters = sample;
+        }
+    }
+}
+
+static void print_header(const BenchOptions &opt, bool has_counters) {
+    if (opt.json)
+        return;
+    printf("family,kernel,isa,width,height,bit_depth,iterations,ns_per_call,"
+           "mpixel_per_s");
+    if (has_counters)
+        printf(",cycles_per_call,ipc,cache_references_per_call,"
+               "cache_misses_per_call");
+    printf("\n");
+}
+
+static void print_result(const KernelBench &kernel, const IsaLevel &level,
+                         const BenchResult &res, const BenchOptions &opt,
+                         bool has_counters) {
+    const double mpixel_per_s =
+        res.ns_per_call > 0
+            ? kernel.width * kernel.height * 1000.0 / res.ns_per_call
+            : 0;
+    const double calls = (double)res.iterations;
+    const PerfSample &c = res.counters;
+    if (opt.json) {
+        printf("{\"family\":\"%s\",\"kernel\":\"%s\",\"isa\":\"%s\","
+               "\"width\":%u,\"height\":%u,\"bit_depth\":%u,"
+               "\"iterations\":%llu,\"ns_per_call\":%.3f,"
+               "\"mpixel_per_s\":%.2f",
+               kernel.family, kernel.name, level.name, kernel.width,
+               kernel.height, kernel.bit_depth,
+               (unsigned long long)res.iterations, res.ns_per_call,
+               mpixel_per_s);
+        if (res.has_counters)
+            printf(",\"cycles_per_call\":%.2f,\"ipc\":%.3f,"
+                   "\"cache_references_per_call\":%.4f,"
+                   "\"cache_misses_per_call\":%.4f}\n",
+                   c.cycles / calls,
+                   c.cycles ? (double)c.instructions / c.cycles : 0,
+                   c.cache_references / calls, c.cache_misses / calls);
+        else
+            printf(",\"cycles_per_call\":null,\"ipc\":null,"
+                   "\"cache_references_per_call\":null,"
+                   "\"cache_misses_per_call\":null}\n");
+    } else {
+        printf("%s,%s,%s,%u,%u,%u,%llu,%.3f,%.2f", kernel.family, kernel.name,
+               level.name, kernel.width, kernel.height, kernel.bit_depth,
+               (unsigned long long)res.iterations, res.ns_per_call,
+               mpixel_per_s);
+        if (has_counters) {
+            if (res.has_counters)
+                printf(",%.2f,%.3f,%.4f,%.4f", c.cycles / calls,
+                       c.cycles ? (double)c.instructions / c.cycles : 0,
+                       c.cache_references / calls, c.cache_misses / calls);
+            else
+                printf(",,,,");
+        }
+        printf("\n");
+    }
+    fflush(stdout);
+}
+
+static bool level_selected(const IsaLevel &level, const BenchOptions &opt) {
+    if (opt.isa == NULL)
+        return true;
+    const std::string list = std::string(",") + opt.isa + ",";
+    return list.find(std::string(",") + level.name + ",") != std::string::npos;
+}
+
+static bool kernel_selected(const KernelBench &kernel,
+                            const BenchOptions &opt) {
+    return opt.filter == NULL || strstr(kernel.family, opt.filter) ||
+           strstr(kernel.name, opt.filter);
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  --filter=<text>      only kernels whose family or name "
+            "contains text\n"
+            "  --isa=<list>         comma separated levels among c, sse2, "
+            "ssse3, sse4_1, avx2, avx512\n"
+            "  --min-time-ms=<n>    time of one measured run, default 100\n"
+            "  --repeat=<n>         measured runs per kernel, the fastest is "
+            "reported, default 3\n"
+            "  --format=<csv|json>  output format, default csv\n"
+            "  --all-levels         also time levels that fall back to the "
+            "kernel of a lower level\n"
+            "  --cpu=<n>            pin the benchmark to cpu n (Linux)\n",
+            prog);
+}
+
+static bool parse_options(int argc, char **argv, BenchOptions *opt) {
+    opt->filter = NULL;
+    opt->isa = NULL;
+    opt->min_time_ms = 100;
+    opt->repeat = 3;
+    opt->json = false;
+    opt->all_levels = false;
+    opt->cpu = -1;
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        if (!strncmp(arg, "--filter=", 9))
+            opt->filter = arg + 9;
+        else if (!strncmp(arg, "--isa=", 6))
+            opt->isa = arg + 6;
+        else if (!strncmp(arg, "--min-time-ms=", 14))
+            opt->min_time_ms = (uint32_t)strtoul(arg + 14, NULL, 0);
+        else if (!strncmp(arg, "--repeat=", 9))
+            opt->repeat = (uint32_t)strtoul(arg + 9, NULL, 0);
+        else if (!strcmp(arg, "--format=json"))
+            opt->json = true;
+        else if (!strcmp(arg, "--format=csv"))
+            opt->json = false;
+        else if (!strcmp(arg, "--all-levels"))
+            opt->all_levels = true;
+        else if (!strncmp(arg, "--cpu=", 6))
+            opt->cpu = atoi(arg + 6);
+        else
+            return false;
+    }
+    if (opt->min_time_ms == 0)
+        opt->min_time_ms = 1;
+    if (opt->repeat == 0)
+        opt->repeat = 1;
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    BenchOptions opt;
+    if (!parse_options(argc, argv, &opt)) {
+        usage(argv[0]);
+        return 1;
+    }
+#ifdef __linux__
+    if (opt.cpu >= 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(opt.cpu, &set);
+        if (sched_setaffinity(0, sizeof(set), &set))
+            fprintf(stderr, "could not pin to cpu %d\n", opt.cpu);
+    }
+#endif
+
+    BenchBuffers bufs;
+    init_buffers(&bufs);
+    PerfCounters counters;
+    if (!counters.valid())
+        fprintf(stderr,
+                "hardware counters unavailable, reporting timings only\n");
+    print_header(opt, counters.valid());
+
+    const CPU_FLAGS cpu_flags = get_cpu_flags_to_use();
+    // kernel each rtcd pointer had at the last level timed, to skip fallbacks
+    std::vector<GenericFunc> last_func(KERNEL_COUNT, (GenericFunc)NULL);
+    for (size_t l = 0; l < ISA_LEVEL_COUNT; l++) {
+        const IsaLevel &level = isa_levels[l];
+        if ((level.flags & cpu_flags) != level.flags)
+            break;
+        setup_rtcd_internal(level.flags);
+        for (size_t k = 0; k < KERNEL_COUNT; k++) {
+            const KernelBench &kernel = kernel_table[k];
+            const GenericFunc func = *kernel.rtcd_ptr;
+            const bool fallback = func == last_func[k];
+            last_func[k] = func;
+            if (!kernel_selected(kernel, opt) || !level_selected(level, opt) ||
+                (fallback && !opt.all_levels))
+                continue;
+            BenchResult res;
+            measure(kernel, bufs, &counters, opt, &res);
+            print_result(kernel, level, res, opt, counters.valid());
+        }
+    }
+    free_buffers();
+    return 0;
+}
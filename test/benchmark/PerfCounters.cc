@@ -0,0 +1,107 @@
+/*
+ * Copyright(c) 2019 Netflix, Inc.
+ * SPDX - License - Identifier: BSD - 2 - Clause - Patent
+ */
+
+/******************************************************************************
+ * @file PerfCounters.cc
+ *
+ * @brief perf_event_open backed hardware counters, see PerfCounters.h
+ *
+ ******************************************************************************/
+
+#include <string.h>
+#include "PerfCounters.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace svt_av1_benchmark {
+
+#ifdef __linux__
+static int open_counter(uint64_t config, int group_fd) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.disabled = group_fd < 0;  // the leader enables the whole group
+    // user space only, so that perf_event_paranoid 2 still allows it
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                       PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return (int)syscall(__NR_perf_event_open, &attr, 0, -1, group_fd, 0);
+}
+#endif
+
+PerfCounters::PerfCounters() : group_fd_(-1) {
+    for (int i = 0; i < COUNTER_COUNT; i++)
+        fds_[i] = -1;
+#ifdef __linux__
+    static const uint64_t configs[COUNTER_COUNT] = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_REFERENCES,
+        PERF_COUNT_HW_CACHE_MISSES};
+    for (int i = 0; i < COUNTER_COUNT; i++) {
+        fds_[i] = open_counter(configs[i], fds_[0]);
+        if (fds_[i] < 0) {
+            // all or nothing, a partial group would mix intervals
+            for (int j = 0; j < i; j++) {
+                close(fds_[j]);
+                fds_[j] = -1;
+            }
+            return;
+        }
+    }
+    group_fd_ = fds_[0];
+#endif
+}
+
+PerfCounters::~PerfCounters() {
+#ifdef __linux__
+    for (int i = 0; i < COUNTER_COUNT; i++)
+        if (fds_[i] >= 0)
+            close(fds_[i]);
+#endif
+}
+
+void PerfCounters::start() {
+#ifdef __linux__
+    if (!valid())
+        return;
+    ioctl(group_fd_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(group_fd_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+}
+
+bool PerfCounters::stop(PerfSample *sample) {
+    memset(sample, 0, sizeof(*sample));
+#ifdef __linux__
+    if (!valid())
+        return false;
+    ioctl(group_fd_, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+    // nr, time_enabled, time_running, then one value per counter
+    uint64_t data[3 + COUNTER_COUNT];
+    if (read(group_fd_, data, sizeof(data)) != (ssize_t)sizeof(data) ||
+        data[0] != COUNTER_COUNT || data[2] == 0)
+        return false;
+    // the group was only scheduled for time_running out of time_enabled
+    const double scale = (double)data[1] / (double)data[2];
+    sample->cycles = (uint64_t)(data[3] * scale);
+    sample->instructions = (uint64_t)(data[4] * scale);
+    sample->cache_references = (uint64_t)(data[5] * scale);
+    sample->cache_misses = (uint64_t)(data[6] * scale);
+    return true;
+#else
+    return false;
+#endif
+}
+
+}  // namespace svt_av1_benchmark
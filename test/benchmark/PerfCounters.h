@@ -0,0 +1,56 @@
+/*
+ * Copyright(c) 2019 Netflix, Inc.
+ * SPDX - License - Identifier: BSD - 2 - Clause - Patent
+ */
+
+/******************************************************************************
+ * @file PerfCounters.h
+ *
+ * @brief Hardware performance counters of the calling thread
+ * - cycles, retired instructions, cache references and cache misses, read as
+ *   one perf_event_open group so that they cover the same interval.
+ * - available on Linux only; elsewhere, or when the kernel refuses the events
+ *   (perf_event_paranoid, containers, VMs), valid() is false and the
+ *   benchmark reports timings only.
+ *
+ ******************************************************************************/
+
+#ifndef _TEST_PERF_COUNTERS_H_
+#define _TEST_PERF_COUNTERS_H_
+
+#include <stdint.h>
+
+namespace svt_av1_benchmark {
+
+/** Counter values of one measured interval, scaled for multiplexing */
+typedef struct PerfSample {
+    uint64_t cycles;
+    uint64_t instructions;
+    uint64_t cache_references;
+    uint64_t cache_misses;
+} PerfSample;
+
+class PerfCounters {
+  public:
+    PerfCounters();
+    ~PerfCounters();
+
+    /** true when the counter group is open and counting */
+    bool valid() const {
+        return group_fd_ >= 0;
+    }
+    /** reset and enable the counters */
+    void start();
+    /** disable the counters and read them into sample, returns false when the
+     * group could not be read */
+    bool stop(PerfSample *sample);
+
+  private:
+    enum { COUNTER_COUNT = 4 };
+    int group_fd_;
+    int fds_[COUNTER_COUNT];
+};
+
+}  // namespace svt_av1_benchmark
+
+#endif  // _TEST_PERF_COUNTERS_H_
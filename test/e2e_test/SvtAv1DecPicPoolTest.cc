@@ -0,0 +1,531 @@
+/*
+ * Copyright(c) 2019 Netflix, Inc.
+ * SPDX - License - Identifier: BSD - 2 - Clause - Patent
+ */
+
+/******************************************************************************
+ * @file SvtAv1DecPicPoolTest.cc
+ *
+ * @brief Impelmentation of SVT-AV1 decoder picture pool test on bitstreams
+ * encoded by SVT-AV1 encoder
+ *
+ ******************************************************************************/
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "EbSvtAv1Enc.h"
+#include "EbSvtAv1Dec.h"
+#include "gtest/gtest.h"
+#include "SvtAv1E2EFramework.h"
+#include "EbDecHandle.h"
+
+using namespace svt_av1_e2e_test;
+using namespace svt_av1_e2e_test_vector;
+
+namespace {
+
+/** FrameBufferPool is the frame buffer allocator given to the decoder, it
+ * keeps track of the buffers the decoder holds */
+class FrameBufferPool {
+  public:
+    ~FrameBufferPool() {
+        for (auto &x : buffers_) delete[] x.first;
+    }
+
+    static int alloc(EbExtFrameBuf *fb, uint32_t min_size, void *priv_data) {
+        FrameBufferPool *pool = (FrameBufferPool *)priv_data;
+        fb->buffer = new uint8_t[min_size];
+        fb->buffer_size = min_size;
+        fb->private_data = nullptr;
+        std::lock_guard<std::mutex> lock(pool->mutex_);
+        pool->buffers_[fb->buffer] = min_size;
+        return 0;
+    }
+
+    static int release(EbExtFrameBuf *fb, void *priv_data) {
+        FrameBufferPool *pool = (FrameBufferPool *)priv_data;
+        std::lock_guard<std::mutex> lock(pool->mutex_);
+        if (pool->buffers_.erase(fb->buffer) == 0)
+            return -1;
+        delete[] fb->buffer;
+        return 0;
+    }
+
+    /** check if the address is in a buffer held by the decoder */
+    bool owns(const uint8_t *addr) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = buffers_.upper_bound((uint8_t *)addr);
+        if (it == buffers_.begin())
+            return false;
+        --it;
+        return addr < it->first + it->second;
+    }
+
+    size_t count() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return buffers_.size();
+    }
+
+  private:
+    std::mutex mutex_;
+    std::map<uint8_t *, uint32_t> buffers_;
+};
+
+/** OutputPicture is a picture returned by the decoder, held until it is
+ * released */
+typedef struct OutputPicture {
+    EbBufferHeaderType header;
+    EbSvtIOFormat img;
+    OutputPicture() {
+        memset(&header, 0, sizeof(header));
+        memset(&img, 0, sizeof(img));
+        header.size = sizeof(header);
+        header.p_buffer = (uint8_t *)&img;
+    }
+} OutputPicture;
+
+}  // namespace
+
+/**
+ * @brief SVT-AV1 decoder test of the picture output without copy, when the
+ * application supplies the frame buffers.
+ *
+ * Test strategy:
+ * Encode the test vector with SVT-AV1 encoder, and decode it temporal unit
+ * by temporal unit with SVT-AV1 decoder set up with frame buffer callbacks.
+ * Hold the output pictures and release them later, from the decoding thread
+ * or from another thread. Decode the test vectors one after the other as a
+ * single stream and check the pool size with eb_dec_get_pic_pool_stats().
+ * Decode the stream with frames in parallel and flush the decoder at the end.
+ *
+ * Expected result:
+ * The output pictures point into the frame buffers of the application. At
+ * most DEC_MAX_OUT_PIC_REFS pictures are handed out at the same time, and
+ * decoding goes on while they are held. When the stream changes resolution,
+ * the pool gives back the pictures of the previous size. All frame buffers
+ * are given back when the decoder is deinitialized. Frame parallel decoding
+ * outputs the same pictures as serial decoding. A frame shown again by a
+ * frame header showing an existing frame is output like any other.
+ *
+ * Test coverage:
+ * Test vectors of 640*480 and 64*64 */
+class DecPicPoolTest : public SvtAv1E2ETestFramework {
+  protected:
+    DecPicPoolTest() : dec_handle_(nullptr) {
+    }
+
+    virtual ~DecPicPoolTest() {
+        deinit_decoder();
+    }
+
+    void encode(TestVideoVector &test_vector, std::vector<uint8_t> &output) {
+        output_collect_ = &output;
+        init_test(test_vector);
+        run_encode_process();
+        deinit_test();
+        output_collect_ = nullptr;
+        ASSERT_FALSE(output.empty());
+    }
+
+    void init_decoder(uint32_t num_p_frames = 1) {
+        EbSvtAv1DecConfiguration config;
+        ASSERT_EQ(eb_dec_init_handle(&dec_handle_, nullptr, &config),
+                  EB_ErrorNone);
+        config.num_p_frames = num_p_frames;
+        ASSERT_EQ(eb_dec_set_frame_buffer_callbacks(dec_handle_,
+                                                    FrameBufferPool::alloc,
+                                                    FrameBufferPool::release,
+                                                    &fb_pool_),
+                  EB_ErrorNone);
+        ASSERT_EQ(eb_svt_dec_set_parameter(dec_handle_, &config),
+                  EB_ErrorNone);
+        ASSERT_EQ(eb_init_decoder(dec_handle_), EB_ErrorNone);
+    }
+
+    void deinit_decoder() {
+        if (dec_handle_ == nullptr)
+            return;
+        EXPECT_EQ(eb_deinit_decoder(dec_handle_), EB_ErrorNone);
+        EXPECT_EQ(eb_dec_deinit_handle(dec_handle_), EB_ErrorNone);
+        dec_handle_ = nullptr;
+    }
+
+    /** parse the header of the OBU at pos in the low overhead bitstream,
+     * returns the offset of the next OBU */
+    static size_t parse_obu(const std::vector<uint8_t> &stream, size_t pos,
+                            int *obu_type, size_t *payload_pos) {
+        const uint8_t obu_header = stream[pos];
+        *obu_type = (obu_header >> 3) & 0xf;
+        EXPECT_TRUE(obu_header & 2) << "OBU without size field";
+        size_t size_pos = pos + 1 + ((obu_header >> 2) & 1);
+        uint64_t obu_size = 0;
+        for (int i = 0; size_pos < stream.size(); i++) {
+            const uint8_t byte = stream[size_pos++];
+            obu_size |= (uint64_t)(byte & 0x7f) << (7 * i);
+            if (!(byte & 0x80))
+                break;
+        }
+        *payload_pos = size_pos;
+        return size_pos + obu_size;
+    }
+
+    /** split the low overhead bitstream into temporal units, returns the
+     * offset of each unit and the size of the stream */
+    static std::vector<size_t> split_temporal_units(
+        const std::vector<uint8_t> &stream) {
+        std::vector<size_t> offsets;
+        size_t pos = 0;
+        while (pos < stream.size()) {
+            int obu_type;
+            size_t payload_pos;
+            size_t next_pos = parse_obu(stream, pos, &obu_type, &payload_pos);
+            if (offsets.empty() || obu_type == OBU_TEMPORAL_DELIMITER)
+                offsets.push_back(pos);
+            pos = next_pos;
+        }
+        offsets.push_back(stream.size());
+        return offsets;
+    }
+
+    /** count the frame headers of the stream showing an existing frame, the
+     * first bit of the header when the sequence header is not reduced */
+    static uint32_t count_show_existing_frames(
+        const std::vector<uint8_t> &stream) {
+        uint32_t count = 0;
+        size_t pos = 0;
+        while (pos < stream.size()) {
+            int obu_type;
+            size_t payload_pos;
+            pos = parse_obu(stream, pos, &obu_type, &payload_pos);
+            if (obu_type == OBU_FRAME_HEADER && payload_pos < pos &&
+                (stream[payload_pos] & 0x80))
+                count++;
+        }
+        return count;
+    }
+
+    /** decode one temporal unit of the stream */
+    void decode(const std::vector<uint8_t> &stream,
+                const std::vector<size_t> &units, size_t index) {
+        ASSERT_EQ(eb_svt_decode_frame(dec_handle_,
+                                      stream.data() + units[index],
+                                      units[index + 1] - units[index],
+                                      0),
+                  EB_ErrorNone);
+    }
+
+    /** get the output picture, and check it is not a copy */
+    EbErrorType get_picture(OutputPicture *pic) {
+        EbErrorType ret = eb_svt_dec_get_picture(
+            dec_handle_, &pic->header, nullptr, nullptr);
+        if (ret == EB_ErrorNone) {
+            EXPECT_NE(pic->header.wrapper_ptr, nullptr);
+            EXPECT_TRUE(fb_pool_.owns(pic->img.luma))
+                << "output picture is not in a frame buffer of the pool";
+        }
+        return ret;
+    }
+
+    /** decode the temporal units of the stream, releasing every output
+     * picture right away */
+    void decode_all(const std::vector<uint8_t> &stream) {
+        std::vector<size_t> units = split_temporal_units(stream);
+        for (size_t i = 0; i + 1 < units.size(); i++) {
+            ASSERT_NO_FATAL_FAILURE(decode(stream, units, i));
+            OutputPicture pic;
+            EbErrorType ret = get_picture(&pic);
+            if (ret == EB_DecNoOutputPicture)
+                continue;
+            ASSERT_EQ(ret, EB_ErrorNone);
+            release_picture(&pic);
+        }
+    }
+
+    /** decode the temporal units of the stream and flush the decoder,
+     * returns the luma plane of every output picture */
+    void decode_luma(const std::vector<uint8_t> &stream,
+                     std::vector<std::vector<uint8_t>> &lumas) {
+        std::vector<size_t> units = split_temporal_units(stream);
+        for (size_t i = 0; i < units.size(); i++) {
+            if (i + 1 < units.size())
+                ASSERT_NO_FATAL_FAILURE(decode(stream, units, i));
+            else
+                ASSERT_EQ(eb_dec_flush(dec_handle_), EB_ErrorNone);
+            OutputPicture pic;
+            EbErrorType ret;
+            while ((ret = get_picture(&pic)) == EB_ErrorNone) {
+                std::vector<uint8_t> luma;
+                for (uint32_t y = 0; y < pic.img.height; y++)
+                    luma.insert(luma.end(),
+                                pic.img.luma + y * pic.img.y_stride,
+                                pic.img.luma + y * pic.img.y_stride +
+                                    pic.img.width);
+                lumas.push_back(luma);
+                release_picture(&pic);
+            }
+            ASSERT_EQ(ret, EB_DecNoOutputPicture);
+        }
+    }
+
+    EbDecPicPoolStats get_pool_stats() {
+        EbDecPicPoolStats stats;
+        EXPECT_EQ(eb_dec_get_pic_pool_stats(dec_handle_, &stats),
+                  EB_ErrorNone);
+        return stats;
+    }
+
+    void release_picture(OutputPicture *pic) {
+        EXPECT_EQ(eb_svt_dec_release_picture(dec_handle_, &pic->header),
+                  EB_ErrorNone);
+        EXPECT_EQ(pic->header.wrapper_ptr, nullptr);
+    }
+
+  protected:
+    EbComponentType *dec_handle_; /**< SVT-AV1 decoder handle */
+    FrameBufferPool fb_pool_;     /**< frame buffers given to the decoder */
+};
+
+TEST_P(DecPicPoolTest, ZeroCopyOutput) {
+    for (auto test_vector : enc_setting.test_vectors) {
+        std::vector<uint8_t> stream;
+        ASSERT_NO_FATAL_FAILURE(encode(test_vector, stream));
+        std::vector<size_t> units = split_temporal_units(stream);
+
+        ASSERT_NO_FATAL_FAILURE(init_decoder());
+        uint32_t num_pics = 0;
+        for (size_t i = 0; i + 1 < units.size(); i++) {
+            ASSERT_NO_FATAL_FAILURE(decode(stream, units, i));
+            OutputPicture pic;
+            EbErrorType ret = get_picture(&pic);
+            if (ret == EB_DecNoOutputPicture)
+                continue;
+            ASSERT_EQ(ret, EB_ErrorNone);
+            EXPECT_EQ(pic.img.width, std::get<3>(test_vector));
+            EXPECT_EQ(pic.img.height, std::get<4>(test_vector));
+            release_picture(&pic);
+            num_pics++;
+        }
+        EXPECT_GT(num_pics, 0u);
+        deinit_decoder();
+        EXPECT_EQ(fb_pool_.count(), 0u)
+            << "frame buffers not released at deinit";
+    }
+}
+
+TEST_P(DecPicPoolTest, ReleaseFromAnotherThread) {
+    for (auto test_vector : enc_setting.test_vectors) {
+        std::vector<uint8_t> stream;
+        ASSERT_NO_FATAL_FAILURE(encode(test_vector, stream));
+        std::vector<size_t> units = split_temporal_units(stream);
+
+        ASSERT_NO_FATAL_FAILURE(init_decoder());
+        std::mutex mutex;
+        std::condition_variable cond;
+        std::deque<std::unique_ptr<OutputPicture>> queue;
+        size_t num_held = 0;
+        bool done = false;
+        // the pictures are released by this thread while decoding goes on
+        std::thread releaser([&]() {
+            std::unique_lock<std::mutex> lock(mutex);
+            for (;;) {
+                cond.wait(lock, [&]() { return done || !queue.empty(); });
+                if (queue.empty())
+                    break;
+                std::unique_ptr<OutputPicture> pic(std::move(queue.front()));
+                queue.pop_front();
+                lock.unlock();
+                release_picture(pic.get());
+                pic.reset();
+                lock.lock();
+                num_held--;
+                cond.notify_all();
+            }
+        });
+
+        uint32_t num_pics = 0;
+        for (size_t i = 0; i + 1 < units.size(); i++) {
+            decode(stream, units, i);
+            if (HasFatalFailure())
+                break;
+            std::unique_ptr<OutputPicture> pic(new OutputPicture);
+            EbErrorType ret;
+            while ((ret = get_picture(pic.get())) ==
+                   EB_ErrorInsufficientResources) {
+                // all output pictures are held, wait for the releaser
+                std::unique_lock<std::mutex> lock(mutex);
+                cond.wait(lock, [&]() {
+                    return num_held < DEC_MAX_OUT_PIC_REFS;
+                });
+            }
+            if (ret == EB_DecNoOutputPicture)
+                continue;
+            EXPECT_EQ(ret, EB_ErrorNone);
+            std::lock_guard<std::mutex> lock(mutex);
+            queue.push_back(std::move(pic));
+            num_held++;
+            cond.notify_all();
+            num_pics++;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            done = true;
+            cond.notify_all();
+        }
+        releaser.join();
+        ASSERT_FALSE(HasFatalFailure());
+        EXPECT_GT(num_pics, 0u);
+        deinit_decoder();
+        EXPECT_EQ(fb_pool_.count(), 0u)
+            << "frame buffers not released at deinit";
+    }
+}
+
+TEST_P(DecPicPoolTest, OutputReferenceLimit) {
+    for (auto test_vector : enc_setting.test_vectors) {
+        std::vector<uint8_t> stream;
+        ASSERT_NO_FATAL_FAILURE(encode(test_vector, stream));
+        std::vector<size_t> units = split_temporal_units(stream);
+
+        ASSERT_NO_FATAL_FAILURE(init_decoder());
+        std::vector<std::unique_ptr<OutputPicture>> held;
+        uint32_t num_refused = 0;
+        size_t i = 0;
+        for (; i + 1 < units.size(); i++) {
+            ASSERT_NO_FATAL_FAILURE(decode(stream, units, i));
+            std::unique_ptr<OutputPicture> pic(new OutputPicture);
+            EbErrorType ret = get_picture(pic.get());
+            if (ret == EB_DecNoOutputPicture)
+                continue;
+            if (held.size() < DEC_MAX_OUT_PIC_REFS) {
+                ASSERT_EQ(ret, EB_ErrorNone);
+                held.push_back(std::move(pic));
+                continue;
+            }
+            // decoding goes on with all output pictures held, but no more
+            // of them are handed out
+            ASSERT_EQ(ret, EB_ErrorInsufficientResources);
+            EXPECT_EQ(pic->header.wrapper_ptr, nullptr);
+            if (++num_refused == DEC_MAX_OUT_PIC_REFS)
+                break;
+        }
+        ASSERT_EQ(held.size(), (size_t)DEC_MAX_OUT_PIC_REFS)
+            << "test vector too short";
+        ASSERT_EQ(num_refused, (uint32_t)DEC_MAX_OUT_PIC_REFS);
+        for (auto &x : held)
+            EXPECT_TRUE(fb_pool_.owns(x->img.luma));
+
+        // a released picture makes room for the last decoded one
+        release_picture(held.front().get());
+        held.erase(held.begin());
+        std::unique_ptr<OutputPicture> pic(new OutputPicture);
+        ASSERT_EQ(get_picture(pic.get()), EB_ErrorNone);
+        held.push_back(std::move(pic));
+
+        for (auto &x : held) release_picture(x.get());
+        held.clear();
+        deinit_decoder();
+        EXPECT_EQ(fb_pool_.count(), 0u)
+            << "frame buffers not released at deinit";
+    }
+}
+
+TEST_P(DecPicPoolTest, ResolutionChange) {
+    // the test vectors are encoded one after the other into a single stream,
+    // from the largest to the smallest
+    std::vector<std::vector<uint8_t>> streams;
+    for (auto test_vector : enc_setting.test_vectors) {
+        streams.push_back(std::vector<uint8_t>());
+        ASSERT_NO_FATAL_FAILURE(encode(test_vector, streams.back()));
+    }
+    ASSERT_GE(streams.size(), 2u);
+
+    // pool of the smallest size alone
+    ASSERT_NO_FATAL_FAILURE(init_decoder());
+    ASSERT_NO_FATAL_FAILURE(decode_all(streams.back()));
+    const EbDecPicPoolStats last_stats = get_pool_stats();
+    deinit_decoder();
+
+    ASSERT_NO_FATAL_FAILURE(init_decoder());
+    uint64_t prev_pool_bytes = 0;
+    for (auto &stream : streams) {
+        ASSERT_NO_FATAL_FAILURE(decode_all(stream));
+        const EbDecPicPoolStats stats = get_pool_stats();
+        EXPECT_GT(stats.pool_bytes, 0u);
+        EXPECT_LE(stats.pool_bytes, stats.max_pool_bytes);
+        if (prev_pool_bytes) {
+            // the pictures of the previous size are reclaimed once it is
+            // no longer decoded
+            EXPECT_LT(stats.pool_bytes, prev_pool_bytes);
+            EXPECT_GE(stats.max_pool_bytes, prev_pool_bytes);
+        }
+        prev_pool_bytes = stats.pool_bytes;
+    }
+    const EbDecPicPoolStats stats = get_pool_stats();
+    EXPECT_LE(stats.pool_bytes, last_stats.max_pool_bytes)
+        << "pictures of a previous size still held";
+    EXPECT_LE(stats.num_pics, last_stats.max_num_pics);
+    deinit_decoder();
+    EXPECT_EQ(fb_pool_.count(), 0u) << "frame buffers not released at deinit";
+}
+
+TEST_P(DecPicPoolTest, FrameParallelOutput) {
+    for (auto test_vector : enc_setting.test_vectors) {
+        std::vector<uint8_t> stream;
+        ASSERT_NO_FATAL_FAILURE(encode(test_vector, stream));
+
+        std::vector<std::vector<uint8_t>> serial, parallel;
+        ASSERT_NO_FATAL_FAILURE(init_decoder());
+        ASSERT_NO_FATAL_FAILURE(decode_luma(stream, serial));
+        deinit_decoder();
+        EXPECT_GT(serial.size(), 0u);
+
+        // the pictures decoded in parallel are output in the same order, the
+        // last ones after the flush
+        ASSERT_NO_FATAL_FAILURE(init_decoder(DEC_MAX_NUM_FRM_PRLL));
+        ASSERT_NO_FATAL_FAILURE(decode_luma(stream, parallel));
+        deinit_decoder();
+        ASSERT_EQ(parallel.size(), serial.size());
+        for (size_t i = 0; i < serial.size(); i++)
+            EXPECT_TRUE(parallel[i] == serial[i]) << "picture " << i;
+        EXPECT_EQ(fb_pool_.count(), 0u)
+            << "frame buffers not released at deinit";
+    }
+}
+
+TEST_P(DecPicPoolTest, ShowExistingFrameOutput) {
+    for (auto test_vector : enc_setting.test_vectors) {
+        std::vector<uint8_t> stream;
+        ASSERT_NO_FATAL_FAILURE(encode(test_vector, stream));
+        // the hidden frames of the hierarchical prediction structure are
+        // shown later by a frame header showing an existing frame
+        EXPECT_GT(count_show_existing_frames(stream), 0u);
+
+        // every frame is output, including the ones shown again, from the
+        // frame buffer of the reference
+        std::vector<std::vector<uint8_t>> lumas;
+        ASSERT_NO_FATAL_FAILURE(init_decoder());
+        ASSERT_NO_FATAL_FAILURE(decode_luma(stream, lumas));
+        deinit_decoder();
+        EXPECT_EQ(lumas.size(), std::get<8>(test_vector));
+        EXPECT_EQ(fb_pool_.count(), 0u)
+            << "frame buffers not released at deinit";
+    }
+}
+
+static const std::vector<TestVideoVector> dec_pic_pool_test_vectors = {
+    std::make_tuple("colorbar_480p_8_420", DUMMY_SOURCE, IMG_FMT_420, 640, 480,
+                    8, 0, 0, 30),
+    std::make_tuple("colorbar_64x64_8_420", DUMMY_SOURCE, IMG_FMT_420, 64, 64,
+                    8, 0, 0, 30),
+};
+
+static const std::vector<EncTestSetting> dec_pic_pool_settings = {
+    {"DecPicPoolTest1", {}, dec_pic_pool_test_vectors}};
+
+INSTANTIATE_TEST_CASE_P(SvtAv1, DecPicPoolTest,
+                        ::testing::ValuesIn(dec_pic_pool_settings),
+                        EncTestSetting::GetSettingName);
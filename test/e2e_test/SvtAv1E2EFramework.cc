@@ -95,6 +95,8 @@ SvtAv1E2ETestFramework::SvtAv1E2ETestFramework() : enc_setting(GetParam()) {
     obu_frame_header_size_ = 0;
     collect_ = nullptr;
     ref_compare_ = nullptr;
+    output_collect_ = nullptr;
+    packet_collect_ = nullptr;
     collect_ = new PerformanceCollect(typeid(this).name());
     use_ext_qp_ = false;
     enable_recon = false;
@@ -675,6 +677,13 @@ void SvtAv1E2ETestFramework::write_compress_data(
 void SvtAv1E2ETestFramework::process_compress_data(
     const EbBufferHeaderType *data) {
     ASSERT_NE(data, nullptr);
+    if (output_collect_)
+        output_collect_->insert(output_collect_->end(),
+                                data->p_buffer,
+                                data->p_buffer + data->n_filled_len);
+    if (packet_collect_)
+        packet_collect_->push_back(
+            std::make_pair(data->p_buffer, data->n_filled_len));
     if (refer_dec_ == nullptr) {
         if (output_file_)
             write_compress_data(data);
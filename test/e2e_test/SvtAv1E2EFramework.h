@@ -15,6 +15,8 @@
 #ifndef _SVT_AV1_E2E_FRAMEWORK_H_
 #define _SVT_AV1_E2E_FRAMEWORK_H_
 
+#include <utility>
+#include <vector>
 #include "E2eTestVectors.h"
 #include "FrameQueue.h"
 #include "PerformanceCollect.h"
@@ -172,6 +174,11 @@ class SvtAv1E2ETestFramework : public ::testing::TestWithParam<EncTestSetting> {
     VideoSource *psnr_src_;         /**< video source context for psnr */
     ICompareQueue *ref_compare_; /**< sink of reference to compare with recon*/
     PsnrStatistics pnsr_statistics_; /**< psnr statistics recorder.*/
+    std::vector<uint8_t>
+        *output_collect_; /**< sink of the compressed data, if not null */
+    std::vector<std::pair<const uint8_t *, uint32_t>>
+        *packet_collect_; /**< sink of the buffer and size of each packet,
+                             if not null */
     bool use_ext_qp_; /**< flag of use external qp from video source or not*/
     EncTestSetting enc_setting;
     /* test configuration */
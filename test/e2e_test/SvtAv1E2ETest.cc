@@ -15,6 +15,7 @@
 #include "EbSvtAv1Enc.h"
 #include "gtest/gtest.h"
 #include "SvtAv1E2EFramework.h"
+#include "ConfigEncoder.h"
 
 using namespace svt_av1_e2e_test;
 using namespace svt_av1_e2e_test_vector;
@@ -264,3 +265,206 @@ static const std::vector<EncTestSetting> tile_settings = {
 INSTANTIATE_TEST_CASE_P(TILETEST, TileIndependenceTest,
                         ::testing::ValuesIn(tile_settings),
                         EncTestSetting::GetSettingName);
+
+/**
+ * @brief SVT-AV1 encoder E2E test with comparing the output of a tiled encode
+ * on one logical processor with the output of the same encode on all of them,
+ * with the tiles coded as one EncDec unit and as independent ones.
+ *
+ * Test strategy:
+ * Setup SVT-AV1 encoder with different tile parameter, and encode the input YUV
+ * data frames with a single logical processor and with all of them, each with
+ * TileParallel off and on. Collect the compressed data of the encodes.
+ *
+ * Expected result:
+ * The compressed data of all encodes are the same, the tiles coded by
+ * concurrent threads, as a picture or tile by tile, give the output of the
+ * serial path.
+ *
+ * Test coverage:
+ * All test vectors of 640*480 */
+
+class TileDeterminismTest : public SvtAv1E2ETestFramework {
+  protected:
+    void config_test() override {
+        enable_config = true;
+        SvtAv1E2ETestFramework::config_test();
+    }
+
+    void encode(TestVideoVector &test_vector, const char *logical_processors,
+                const char *tile_parallel, std::vector<uint8_t> &output) {
+        set_enc_config(enc_config_, "LogicalProcessors", logical_processors);
+        set_enc_config(enc_config_, "TileParallel", tile_parallel);
+        output_collect_ = &output;
+        init_test(test_vector);
+        run_encode_process();
+        deinit_test();
+        output_collect_ = nullptr;
+    }
+};
+
+TEST_P(TileDeterminismTest, TileTest) {
+    config_test();
+    // {LogicalProcessors, TileParallel} of the encodes compared with the
+    // serial one
+    static const char *const runs[][2] = {{"0", "0"}, {"1", "1"}, {"0", "1"}};
+    for (auto test_vector : enc_setting.test_vectors) {
+        std::vector<uint8_t> serial_output;
+        ASSERT_NO_FATAL_FAILURE(encode(test_vector, "1", "0", serial_output));
+        ASSERT_FALSE(serial_output.empty());
+        for (auto &run : runs) {
+            std::vector<uint8_t> output;
+            ASSERT_NO_FATAL_FAILURE(
+                encode(test_vector, run[0], run[1], output));
+            EXPECT_TRUE(serial_output == output)
+                << "output depends on the thread count (" << run[0]
+                << ") or the tile parallel mode (" << run[1] << ") on "
+                << enc_setting.to_string(std::get<0>(test_vector));
+        }
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(TILETEST, TileDeterminismTest,
+                        ::testing::ValuesIn(tile_settings),
+                        EncTestSetting::GetSettingName);
+
+/**
+ * @brief SVT-AV1 encoder E2E test of the global motion search on the
+ * overlay pictures.
+ *
+ * Test strategy:
+ * Setup SVT-AV1 encoder with global motion and overlay pictures, and encode
+ * the input YUV data frames twice, with a single logical processor and with
+ * all of them. Collect the compressed data of both encodes. The overlay
+ * pictures skip Picture Analysis, their corners are detected by global
+ * motion estimation, never taken over from the picture that used the same
+ * analysis buffers before.
+ *
+ * Expected result:
+ * The compressed data of both encodes are the same, the global motion of
+ * the overlay pictures does not depend on which buffers the thread timing
+ * gave them.
+ *
+ * Test coverage:
+ * All test vectors of 640*480 */
+class GlobalMotionOverlayTest : public SvtAv1E2ETestFramework {
+  protected:
+    void config_test() override {
+        enable_config = true;
+        SvtAv1E2ETestFramework::config_test();
+    }
+
+    void encode(TestVideoVector &test_vector, const char *logical_processors,
+                std::vector<uint8_t> &output) {
+        set_enc_config(enc_config_, "LogicalProcessors", logical_processors);
+        output_collect_ = &output;
+        init_test(test_vector);
+        run_encode_process();
+        deinit_test();
+        output_collect_ = nullptr;
+    }
+};
+
+TEST_P(GlobalMotionOverlayTest, OverlayTest) {
+    config_test();
+    for (auto test_vector : enc_setting.test_vectors) {
+        std::vector<uint8_t> serial_output, parallel_output;
+        ASSERT_NO_FATAL_FAILURE(encode(test_vector, "1", serial_output));
+        ASSERT_NO_FATAL_FAILURE(encode(test_vector, "0", parallel_output));
+        ASSERT_FALSE(serial_output.empty());
+        EXPECT_TRUE(serial_output == parallel_output)
+            << "output depends on the thread count on "
+            << enc_setting.to_string(std::get<0>(test_vector));
+    }
+}
+
+// global motion is searched up to M1
+static const std::vector<EncTestSetting> gm_overlay_settings = {
+    {"GmOverlayTest1",
+     {{"GlobalMotion", "1"}, {"EnableOverlays", "1"}, {"EncoderMode", "0"}},
+     default_test_vectors},
+    {"GmOverlayTest2",
+     {{"GlobalMotion", "1"}, {"EnableOverlays", "1"}, {"EncoderMode", "1"}},
+     default_test_vectors}};
+
+INSTANTIATE_TEST_CASE_P(SvtAv1, GlobalMotionOverlayTest,
+                        ::testing::ValuesIn(gm_overlay_settings),
+                        EncTestSetting::GetSettingName);
+
+/**
+ * @brief SVT-AV1 encoder E2E test of the output packets written into the
+ * buffers registered by the application.
+ *
+ * Test strategy:
+ * Register a few packet buffers with eb_svt_enc_register_out_buffer once the
+ * encoder is initialized, and encode the input YUV data frames. Collect the
+ * buffer of each packet and the compressed data.
+ *
+ * Expected result:
+ * The first packets are written into the registered buffers, in the order
+ * they were registered, and the following ones into the encoder's own
+ * buffers. The registered buffers still hold their packet once the packets
+ * are released and the encoder is deinitialized, they are not freed by the
+ * encoder.
+ *
+ * Test coverage:
+ * Test vectors of 640*480 */
+class RegisteredOutBufferTest : public SvtAv1E2ETestFramework {};
+
+TEST_P(RegisteredOutBufferTest, PacketBufferTest) {
+    const size_t num_buffers = 4;
+    const size_t buffer_size = EB_OUTPUTSTREAMBUFFERSIZE_MACRO(640 * 480);
+    config_test();
+    for (auto test_vector : enc_setting.test_vectors) {
+        std::vector<uint8_t> output;
+        std::vector<std::pair<const uint8_t *, uint32_t>> packets;
+        // freed by the test, a buffer freed by the encoder is a double free
+        std::vector<std::vector<uint8_t>> buffers(
+            num_buffers, std::vector<uint8_t>(buffer_size, 0));
+
+        output_collect_ = &output;
+        packet_collect_ = &packets;
+        ASSERT_NO_FATAL_FAILURE(init_test(test_vector));
+        for (auto &buffer : buffers)
+            ASSERT_EQ(eb_svt_enc_register_out_buffer(av1enc_ctx_.enc_handle,
+                                                     buffer.data(),
+                                                     (uint32_t)buffer.size()),
+                      EB_ErrorNone);
+        run_encode_process();
+        deinit_test();
+        output_collect_ = nullptr;
+        packet_collect_ = nullptr;
+
+        ASSERT_GT(packets.size(), num_buffers);
+        size_t offset = 0;
+        for (size_t i = 0; i < packets.size(); i++) {
+            const uint8_t *packet = packets[i].first;
+            const uint32_t size = packets[i].second;
+            if (i < num_buffers) {
+                EXPECT_EQ(packet, buffers[i].data())
+                    << "packet " << i << " not in the registered buffer";
+                ASSERT_LE(size, buffer_size);
+                EXPECT_EQ(memcmp(buffers[i].data(), &output[offset], size), 0)
+                    << "registered buffer " << i << " changed after release";
+            } else {
+                for (auto &buffer : buffers)
+                    EXPECT_FALSE(packet >= buffer.data() &&
+                                 packet < buffer.data() + buffer.size())
+                        << "registered buffer used for packet " << i;
+            }
+            offset += size;
+        }
+    }
+}
+
+static const std::vector<TestVideoVector> out_buffer_test_vectors = {
+    std::make_tuple("colorbar_480p_8_420", DUMMY_SOURCE, IMG_FMT_420, 640, 480,
+                    8, 0, 0, 30),
+};
+
+static const std::vector<EncTestSetting> out_buffer_settings = {
+    {"OutBufferTest1", {}, out_buffer_test_vectors}};
+
+INSTANTIATE_TEST_CASE_P(SvtAv1, RegisteredOutBufferTest,
+                        ::testing::ValuesIn(out_buffer_settings),
+                        EncTestSetting::GetSettingName);